@@ -10,74 +10,60 @@
 #include <Utils\DebugUtils.h>
 
 namespace {
-	void CreateResourceAndRenderTargetView(
-		const D3D12_RESOURCE_STATES resourceinitialState,
-		const wchar_t* resourceName,
-		Microsoft::WRL::ComPtr<ID3D12Resource>& resource,
+	void CreateRenderTargetView(
+		ID3D12Resource& resource,
 		D3D12_CPU_DESCRIPTOR_HANDLE& resourceRenderTargetView) noexcept 
-	{		
-		// Set shared buffers properties
-		D3D12_RESOURCE_DESC resourceDescriptor = {};
-		resourceDescriptor.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
-		resourceDescriptor.Alignment = 0U;
-		resourceDescriptor.Width = SettingsManager::sWindowWidth;
-		resourceDescriptor.Height = SettingsManager::sWindowHeight;
-		resourceDescriptor.DepthOrArraySize = 1U;
-		resourceDescriptor.MipLevels = 0U;
-		resourceDescriptor.SampleDesc.Count = 1U;
-		resourceDescriptor.SampleDesc.Quality = 0U;
-		resourceDescriptor.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
-		resourceDescriptor.Flags = D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET;
-		resourceDescriptor.Format = DXGI_FORMAT_R16_UNORM;
-
-		D3D12_CLEAR_VALUE clearValue{ resourceDescriptor.Format, 0.0f, 0.0f, 0.0f, 0.0f };
-		resource.Reset();
-		
-		CD3DX12_HEAP_PROPERTIES heapProperties{ D3D12_HEAP_TYPE_DEFAULT };
-
-		// Create buffer resource
-		ID3D12Resource* resourcePtr = &ResourceManager::CreateCommittedResource(
-			heapProperties, 
-			D3D12_HEAP_FLAG_NONE, 
-			resourceDescriptor, 
-			resourceinitialState,
-			&clearValue,
-			resourceName);
-		resource = Microsoft::WRL::ComPtr<ID3D12Resource>(resourcePtr);
-		
-		// Create render target view	
+	{
 		D3D12_RENDER_TARGET_VIEW_DESC rtvDescriptor{};
 		rtvDescriptor.ViewDimension = D3D12_RTV_DIMENSION_TEXTURE2D;
-		rtvDescriptor.Format = resourceDescriptor.Format;
-		RenderTargetDescriptorManager::CreateRenderTargetView(*resource.Get(), rtvDescriptor, &resourceRenderTargetView);
+		rtvDescriptor.Format = resource.GetDesc().Format;
+		RenderTargetDescriptorManager::CreateRenderTargetView(resource, rtvDescriptor, &resourceRenderTargetView);
 	}
 }
 
+void AmbientLightPass::GetBufferDescriptor(
+	D3D12_RESOURCE_DESC& resourceDescriptor,
+	D3D12_CLEAR_VALUE& clearValue) noexcept
+{
+	resourceDescriptor = {};
+	resourceDescriptor.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
+	resourceDescriptor.Alignment = 0U;
+	resourceDescriptor.Width = SettingsManager::sWindowWidth;
+	resourceDescriptor.Height = SettingsManager::sWindowHeight;
+	resourceDescriptor.DepthOrArraySize = 1U;
+	resourceDescriptor.MipLevels = 0U;
+	resourceDescriptor.SampleDesc.Count = 1U;
+	resourceDescriptor.SampleDesc.Quality = 0U;
+	resourceDescriptor.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
+	resourceDescriptor.Flags = D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET;
+	resourceDescriptor.Format = DXGI_FORMAT_R16_UNORM;
+
+	clearValue = D3D12_CLEAR_VALUE{ resourceDescriptor.Format, 0.0f, 0.0f, 0.0f, 0.0f };
+}
+
 void AmbientLightPass::Init(
 	ID3D12Resource& baseColorMetalMaskBuffer,
 	ID3D12Resource& normalSmoothnessBuffer,
 	ID3D12Resource& depthBuffer,
+	ID3D12Resource& ambientAccessibilityBuffer,
+	ID3D12Resource& blurBuffer,
 	const D3D12_CPU_DESCRIPTOR_HANDLE& renderTargetView) noexcept
 {
 	ASSERT(ValidateData() == false);
+	ASSERT(ResourceStateManager::GetResourceState(ambientAccessibilityBuffer) == D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+	ASSERT(ResourceStateManager::GetResourceState(blurBuffer) == D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
 
 	AmbientLightCmdListRecorder::InitSharedPSOAndRootSignature();
 	AmbientOcclusionCmdListRecorder::InitSharedPSOAndRootSignature();
 	BlurCmdListRecorder::InitSharedPSOAndRootSignature();
 
-	// Create ambient accessibility buffer and blur buffer
-	CreateResourceAndRenderTargetView(
-		D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE,
-		L"Ambient Accessibility Buffer",
-		mAmbientAccessibilityBuffer, 
-		mAmbientAccessibilityBufferRenderTargetView);
+	// Create ambient accessibility buffer and blur buffer render target views
+	mAmbientAccessibilityBuffer = Microsoft::WRL::ComPtr<ID3D12Resource>(&ambientAccessibilityBuffer);
+	CreateRenderTargetView(*mAmbientAccessibilityBuffer.Get(), mAmbientAccessibilityBufferRenderTargetView);
 
+	mBlurBuffer = Microsoft::WRL::ComPtr<ID3D12Resource>(&blurBuffer);
 	D3D12_CPU_DESCRIPTOR_HANDLE blurBufferRenderTargetView;
-	CreateResourceAndRenderTargetView(
-		D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE,
-		L"Blur Buffer",
-		mBlurBuffer, 
-		blurBufferRenderTargetView);
+	CreateRenderTargetView(*mBlurBuffer.Get(), blurBufferRenderTargetView);
 	
 	// Initialize ambient occlusion recorder
 	mAmbientOcclusionRecorder.reset(new AmbientOcclusionCmdListRecorder());
@@ -102,14 +88,11 @@ void AmbientLightPass::Init(
 	ASSERT(ValidateData());
 }
 
-void AmbientLightPass::Execute(const FrameCBuffer& frameCBuffer) noexcept {
+std::uint32_t AmbientLightPass::Execute(const D3D12_GPU_VIRTUAL_ADDRESS frameCBufferGpuAddress) noexcept {
 	ASSERT(ValidateData());
 
-	const std::uint32_t taskCount{ 5U };
-	CommandListExecutor::Get().ResetExecutedCommandListCount();
-
 	ExecuteBeginTask();
-	mAmbientOcclusionRecorder->RecordAndPushCommandLists(frameCBuffer);
+	mAmbientOcclusionRecorder->RecordAndPushCommandLists(frameCBufferGpuAddress);
 
 	ExecuteMiddleTask();
 	mBlurRecorder->RecordAndPushCommandLists();
@@ -117,10 +100,8 @@ void AmbientLightPass::Execute(const FrameCBuffer& frameCBuffer) noexcept {
 	ExecuteFinalTask();
 	mAmbientLightRecorder->RecordAndPushCommandLists();
 
-	// Wait until all previous tasks command lists are executed
-	while (CommandListExecutor::Get().GetExecutedCommandListCount() < taskCount) {
-		Sleep(0U);
-	}
+	// 3 tasks command lists + 3 recorders command lists
+	return 6U;
 }
 
 bool AmbientLightPass::ValidateData() const noexcept {
@@ -144,15 +125,8 @@ void AmbientLightPass::ExecuteBeginTask() noexcept {
 
 	ID3D12GraphicsCommandList& commandList = mBeginCommandListPerFrame.ResetWithNextCommandAllocator(nullptr);
 
-	CD3DX12_RESOURCE_BARRIER barriers[]
-	{
-		ResourceStateManager::ChangeResourceStateAndGetBarrier(
-			*mAmbientAccessibilityBuffer.Get(),
-			D3D12_RESOURCE_STATE_RENDER_TARGET),
-	};
-	const std::uint32_t barrierCount = _countof(barriers);
-	ASSERT(barrierCount == 1UL);
-	commandList.ResourceBarrier(barrierCount, barriers);
+	mBarrierBatch.Transition(mAmbientAccessibilityBuffer.Get(), D3D12_RESOURCE_STATE_RENDER_TARGET);
+	ResourceStateManager::FlushBarrierBatch(mBarrierBatch, commandList);
 
 	float clearColor[] = { 0.0f, 0.0f, 0.0f, 0.0f };
 	commandList.ClearRenderTargetView(mAmbientAccessibilityBufferRenderTargetView, clearColor, 0U, nullptr);
@@ -172,19 +146,9 @@ void AmbientLightPass::ExecuteMiddleTask() noexcept {
 
 	ID3D12GraphicsCommandList& commandList = mMiddleCommandListPerFrame.ResetWithNextCommandAllocator(nullptr);
 
-	CD3DX12_RESOURCE_BARRIER barriers[]
-	{
-		ResourceStateManager::ChangeResourceStateAndGetBarrier(
-			*mAmbientAccessibilityBuffer.Get(), 
-			D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE),
-
-		ResourceStateManager::ChangeResourceStateAndGetBarrier(
-			*mBlurBuffer.Get(), 
-			D3D12_RESOURCE_STATE_RENDER_TARGET),
-	};
-	const std::uint32_t barrierCount = _countof(barriers);
-	ASSERT(barrierCount == 2UL);
-	commandList.ResourceBarrier(barrierCount, barriers);
+	mBarrierBatch.Transition(mAmbientAccessibilityBuffer.Get(), D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+	mBarrierBatch.Transition(mBlurBuffer.Get(), D3D12_RESOURCE_STATE_RENDER_TARGET);
+	ResourceStateManager::FlushBarrierBatch(mBarrierBatch, commandList);
 
 	CHECK_HR(commandList.Close());
 	CommandListExecutor::Get().AddCommandList(commandList);
@@ -201,13 +165,8 @@ void AmbientLightPass::ExecuteFinalTask() noexcept {
 
 	ID3D12GraphicsCommandList& commandList = mFinalCommandListPerFrame.ResetWithNextCommandAllocator(nullptr);
 	
-	CD3DX12_RESOURCE_BARRIER barriers[]
-	{
-		ResourceStateManager::ChangeResourceStateAndGetBarrier(*mBlurBuffer.Get(), D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE),
-	};
-	const std::uint32_t barrierCount = _countof(barriers);
-	ASSERT(barrierCount == 1UL);
-	commandList.ResourceBarrier(barrierCount, barriers);
+	mBarrierBatch.Transition(mBlurBuffer.Get(), D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+	ResourceStateManager::FlushBarrierBatch(mBarrierBatch, commandList);
 
 	CHECK_HR(commandList.Close());
 	CommandListExecutor::Get().AddCommandList(commandList);
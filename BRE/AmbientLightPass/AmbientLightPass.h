@@ -7,8 +7,11 @@
 #include <AmbientLightPass\AmbientOcclusionCmdListRecorder.h>
 #include <AmbientLightPass\BlurCmdListRecorder.h>
 #include <CommandManager\CommandListPerFrame.h>
+#include <ResourceStateManager\ResourceBarrierBatch.h>
 
+struct D3D12_CLEAR_VALUE;
 struct D3D12_CPU_DESCRIPTOR_HANDLE;
+struct D3D12_RESOURCE_DESC;
 struct ID3D12Resource;
 
 // Pass responsible to apply ambient lighting and ambient occlusion
@@ -21,15 +24,29 @@ public:
 	AmbientLightPass(AmbientLightPass&&) = delete;
 	AmbientLightPass& operator=(AmbientLightPass&&) = delete;
 
+	// Descriptor and clear value that must be used to create
+	// ambient accessibility and blur buffers.
+	static void GetBufferDescriptor(
+		D3D12_RESOURCE_DESC& resourceDescriptor,
+		D3D12_CLEAR_VALUE& clearValue) noexcept;
+
+	// Ambient accessibility and blur buffers are created by the caller (using GetBufferDescriptor()),
+	// as they are transient resources that can share memory with other resources.
+	// Preconditions:
+	// - "ambientAccessibilityBuffer" and "blurBuffer" must be in pixel shader resource state
 	void Init(
 		ID3D12Resource& baseColorMetalMaskBuffer,
 		ID3D12Resource& normalSmoothnessBuffer,		
 		ID3D12Resource& depthBuffer,
+		ID3D12Resource& ambientAccessibilityBuffer,
+		ID3D12Resource& blurBuffer,
 		const D3D12_CPU_DESCRIPTOR_HANDLE& renderTargetView) noexcept;
 
+	// Returns the number of command lists pushed to CommandListExecutor.
+	// It does not wait for them to be executed.
 	// Preconditions:
 	// - Init() must be called first
-	void Execute(const FrameCBuffer& frameCBuffer) noexcept;
+	std::uint32_t Execute(const D3D12_GPU_VIRTUAL_ADDRESS frameCBufferGpuAddress) noexcept;
 
 private:
 	bool ValidateData() const noexcept;
@@ -42,6 +59,9 @@ private:
 	CommandListPerFrame mMiddleCommandListPerFrame;
 	CommandListPerFrame mFinalCommandListPerFrame;
 
+	// Tasks are executed sequentially, so they can share it
+	ResourceBarrierBatch mBarrierBatch;
+
 	Microsoft::WRL::ComPtr<ID3D12Resource> mAmbientAccessibilityBuffer;
 	D3D12_CPU_DESCRIPTOR_HANDLE mAmbientAccessibilityBufferRenderTargetView{ 0UL };
 
@@ -143,17 +143,13 @@ void AmbientOcclusionCmdListRecorder::Init(
 	ASSERT(ValidateData());
 }
 
-void AmbientOcclusionCmdListRecorder::RecordAndPushCommandLists(const FrameCBuffer& frameCBuffer) noexcept {
+void AmbientOcclusionCmdListRecorder::RecordAndPushCommandLists(const D3D12_GPU_VIRTUAL_ADDRESS frameCBufferGpuAddress) noexcept {
 	ASSERT(ValidateData());
 	ASSERT(sPSO != nullptr);
 	ASSERT(sRootSignature != nullptr);
 	
 	ID3D12GraphicsCommandList& commandList = mCommandListPerFrame.ResetWithNextCommandAllocator(sPSO);
 
-	// Update frame constants
-	UploadBuffer& uploadFrameCBuffer(mFrameUploadCBufferPerFrame.GetNextFrameCBuffer());
-	uploadFrameCBuffer.CopyData(0U, &frameCBuffer, sizeof(frameCBuffer));
-
 	commandList.RSSetViewports(1U, &SettingsManager::sScreenViewport);
 	commandList.RSSetScissorRects(1U, &SettingsManager::sScissorRect);
 	commandList.OMSetRenderTargets(1U, &mRenderTargetView, false, nullptr);
@@ -162,9 +158,8 @@ void AmbientOcclusionCmdListRecorder::RecordAndPushCommandLists(const FrameCBuff
 	commandList.SetDescriptorHeaps(_countof(heaps), heaps);
 
 	commandList.SetGraphicsRootSignature(sRootSignature);	
-	const D3D12_GPU_VIRTUAL_ADDRESS frameCBufferGpuVAddress(uploadFrameCBuffer.GetResource()->GetGPUVirtualAddress());
-	commandList.SetGraphicsRootConstantBufferView(0U, frameCBufferGpuVAddress);
-	commandList.SetGraphicsRootConstantBufferView(1U, frameCBufferGpuVAddress);
+	commandList.SetGraphicsRootConstantBufferView(0U, frameCBufferGpuAddress);
+	commandList.SetGraphicsRootConstantBufferView(1U, frameCBufferGpuAddress);
 	commandList.SetGraphicsRootDescriptorTable(2U, mStartPixelShaderResourceView);
 
 	commandList.IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
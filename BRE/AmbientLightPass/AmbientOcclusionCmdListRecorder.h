@@ -1,10 +1,9 @@
 #pragma once
 
 #include <CommandManager\CommandListPerFrame.h>
-#include <ResourceManager\FrameUploadCBufferPerFrame.h>
+#include <ResourceManager\UploadBuffer.h>
 
 struct D3D12_CPU_DESCRIPTOR_HANDLE;
-struct FrameCBuffer;
 struct ID3D12Resource;
 
 // Responsible of command lists recording to be executed by CommandListExecutor.
@@ -29,7 +28,7 @@ public:
 
 	// Preconditions:
 	// - Init() must be called first
-	void RecordAndPushCommandLists(const FrameCBuffer& frameCBuffer) noexcept;
+	void RecordAndPushCommandLists(const D3D12_GPU_VIRTUAL_ADDRESS frameCBufferGpuAddress) noexcept;
 
 	bool ValidateData() const noexcept;
 
@@ -44,8 +43,6 @@ private:
 	
 	CommandListPerFrame mCommandListPerFrame;
 
-	FrameUploadCBufferPerFrame mFrameUploadCBufferPerFrame;
-
 	UploadBuffer* mSampleKernelUploadBuffer{ nullptr };
 
 	D3D12_CPU_DESCRIPTOR_HANDLE mRenderTargetView{ 0UL };
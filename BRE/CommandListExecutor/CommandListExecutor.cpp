@@ -45,23 +45,22 @@ tbb::task* CommandListExecutor::execute() {
 	ASSERT(mMaxNumberOfCommandListsToExecute > 0);
 
 	ID3D12CommandList* *pendingCommandLists{ new ID3D12CommandList*[mMaxNumberOfCommandListsToExecute] };
-	while (mTerminate == false) {
-		// Pop at most mMaxNumberOfCommandListsToExecute from command list queue
-		while (mPendingCommandListCount < mMaxNumberOfCommandListsToExecute && 
-			   mCommandListsToExecute.try_pop(pendingCommandLists[mPendingCommandListCount])) 
-		{
-			++mPendingCommandListCount;
+	for (;;) {
+		// Sleep until there are command lists to execute, and then pop 
+		// at most mMaxNumberOfCommandListsToExecute from command list queue.
+		// Zero command lists means the queue was closed by Terminate()
+		const std::uint32_t commandListCount{ 
+			mCommandListsToExecute.WaitAndPop(pendingCommandLists, mMaxNumberOfCommandListsToExecute) };
+		if (commandListCount == 0U) {
+			break;
 		}
 
-		// Execute command lists (if any)
-		if (mPendingCommandListCount != 0U) {
-			mCommandQueue->ExecuteCommandLists(mPendingCommandListCount, pendingCommandLists);
-			mExecutedCommandListCount += mPendingCommandListCount;
-			mPendingCommandListCount = 0U;
-		}
-		else {
-			Sleep(0U);
-		}
+		mPendingCommandListCount = commandListCount;
+		mCommandQueue->ExecuteCommandLists(commandListCount, pendingCommandLists);
+		mPendingCommandListCount = 0U;
+
+		// Wake up threads waiting for command lists execution
+		mExecutedCommandListLatch.Increment(commandListCount);
 	}
 
 	delete[] pendingCommandLists;
@@ -92,17 +91,26 @@ void CommandListExecutor::SignalFenceAndWaitForCompletion(
 }
 
 void CommandListExecutor::ExecuteCommandListAndWaitForCompletion(ID3D12CommandList& cmdList) noexcept {
+	ID3D12CommandList* commandLists[1U]{ &cmdList };
+	ExecuteCommandListsAndWaitForCompletion(commandLists, _countof(commandLists));
+}
+
+void CommandListExecutor::ExecuteCommandListsAndWaitForCompletion(
+	ID3D12CommandList* const* cmdLists,
+	const std::uint32_t cmdListCount) noexcept 
+{
 	ASSERT(mCommandQueue != nullptr);
 	ASSERT(mFence != nullptr);
+	ASSERT(cmdLists != nullptr);
+	ASSERT(cmdListCount > 0U);
 
-	ID3D12CommandList* commandLists[1U]{ &cmdList };
-	mCommandQueue->ExecuteCommandLists(_countof(commandLists), commandLists);
+	mCommandQueue->ExecuteCommandLists(cmdListCount, cmdLists);
 
 	const std::uint64_t valueToSignal = mFence->GetCompletedValue() + 1UL;
 	SignalFenceAndWaitForCompletion(*mFence, valueToSignal, valueToSignal);
 }
 
 void CommandListExecutor::Terminate() noexcept {
-	mTerminate = true;
+	mCommandListsToExecute.Close();
 	parent()->wait_for_all();
 }
\ No newline at end of file
@@ -2,16 +2,18 @@
 
 #include <atomic>
 #include <d3d12.h>
-#include <tbb/concurrent_queue.h>
 #include <tbb/task.h>
 
+#include <Utils\BlockingQueue.h>
+#include <Utils\CompletionLatch.h>
 #include <Utils\DebugUtils.h>
 
 // To check for new command lists and execute them.
 // Steps:
 // - Use CommandListExecutor::Create() to create and spawn an instance.
 // - When you spawn it, execute() method is automatically called. You should fill the queue with
-//   command lists. You can use CommandListExecutor::GetCommandListQueue() to get it.
+//   command lists. You can use CommandListExecutor::AddCommandList() to do it.
+//   The executor sleeps while the queue is empty.
 // - When you want to terminate this task, you should call CommandListExecutor::Terminate() 
 class CommandListExecutor : public tbb::task {
 public:
@@ -34,18 +36,21 @@ public:
 
 	// As I did not discover yet, why it is not thread safe, then I only use it for debugging purposes.
 	__forceinline bool AreTherePendingCommandListsToExecute() const noexcept { 
-		return mCommandListsToExecute.empty() && mPendingCommandListCount == 0; 
+		return mCommandListsToExecute.IsEmpty() && mPendingCommandListCount == 0; 
 	}
 
 	// A thread safe way to know if CommandListExecutor finished processing and executing all the command lists.
 	// If you are going to execute N command lists, then you should:
 	// - Call ResetExecutedCommandListCount()
-	// - Fill queue through GetCommandListQueue()
-	// - Check if GetExecutedCommandListCount() is equal to N, to be sure all was executed properly (sent to GPU)
-	__forceinline void ResetExecutedCommandListCount() noexcept { mExecutedCommandListCount = 0U; }
-	__forceinline std::uint32_t GetExecutedCommandListCount() const noexcept { return mExecutedCommandListCount; }
+	// - Fill queue through AddCommandList()
+	// - Call WaitForExecutedCommandLists(N) to sleep until all of them were executed (sent to GPU)
+	__forceinline void ResetExecutedCommandListCount() noexcept { mExecutedCommandListLatch.Reset(); }
+	__forceinline std::uint32_t GetExecutedCommandListCount() const noexcept { return mExecutedCommandListLatch.GetCount(); }
+	__forceinline void WaitForExecutedCommandLists(const std::uint32_t commandListCount) const noexcept { 
+		mExecutedCommandListLatch.Wait(commandListCount); 
+	}
 	
-	__forceinline void AddCommandList(ID3D12CommandList& commandList) noexcept { mCommandListsToExecute.push(&commandList); }
+	__forceinline void AddCommandList(ID3D12CommandList& commandList) noexcept { mCommandListsToExecute.Push(&commandList); }
 
 	__forceinline ID3D12CommandQueue& GetCommandQueue() noexcept {
 		ASSERT(mCommandQueue != nullptr);
@@ -58,6 +63,13 @@ public:
 		const std::uint64_t valueToWaitFor) noexcept;
 
 	void ExecuteCommandListAndWaitForCompletion(ID3D12CommandList& cmdList) noexcept;
+
+	// Preconditions:
+	// - "cmdLists" must not be nullptr
+	// - "cmdListCount" must be greater than zero
+	void ExecuteCommandListsAndWaitForCompletion(
+		ID3D12CommandList* const* cmdLists,
+		const std::uint32_t cmdListCount) noexcept;
 		
 	void Terminate() noexcept;	
 
@@ -69,13 +81,11 @@ private:
 
 	static CommandListExecutor* sExecutor;
 
-	bool mTerminate{ false };
-
-	std::uint32_t mExecutedCommandListCount{ 0U };
+	CompletionLatch mExecutedCommandListLatch;
 	std::atomic<std::uint32_t> mPendingCommandListCount{ 0U };
 	std::uint32_t mMaxNumberOfCommandListsToExecute{ 1U };
 
 	ID3D12CommandQueue* mCommandQueue{ nullptr };
-	tbb::concurrent_queue<ID3D12CommandList*> mCommandListsToExecute;
+	BlockingQueue<ID3D12CommandList*> mCommandListsToExecute;
 	ID3D12Fence* mFence{ nullptr };
 };
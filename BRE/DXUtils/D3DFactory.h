@@ -30,5 +30,9 @@ namespace D3DFactory {
 	
 	std::vector<D3D12_INPUT_ELEMENT_DESC> GetPosInputLayout() noexcept;
 	std::vector<D3D12_INPUT_ELEMENT_DESC> GetPosNormalTangentTexCoordInputLayout() noexcept;
+
+	// Layout of VertexCompressor::PackedVertex: 16 bits unsigned normalized position (w = 1.0f),
+	// octahedral encoded normal and tangent (16 bits signed normalized) and half float UV.
+	std::vector<D3D12_INPUT_ELEMENT_DESC> GetPackedPosNormalTangentTexCoordInputLayout() noexcept;
 	std::vector<D3D12_INPUT_ELEMENT_DESC> GetPosTexCoordInputLayout() noexcept;
 }
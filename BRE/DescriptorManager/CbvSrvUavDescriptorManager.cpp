@@ -1,48 +1,47 @@
 #include "CbvSrvUavDescriptorManager.h"
 
-#include <memory>
-
 #include <DirectXManager\DirectXManager.h>
 #include <DXUtils/d3dx12.h>
 #include <SettingsManager\SettingsManager.h>
 
+namespace {
+	const std::uint32_t sDescriptorCount{ 3000U };
+}
+
 Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> CbvSrvUavDescriptorManager::mCbvSrvUavDescriptorHeap;
-D3D12_GPU_DESCRIPTOR_HANDLE CbvSrvUavDescriptorManager::mCurrentCbvSrvUavGpuDescriptorHandle{ 0UL };
-D3D12_CPU_DESCRIPTOR_HANDLE CbvSrvUavDescriptorManager::mCurrentCbvSrvUavCpuDescriptorHandle{ 0UL };
-std::mutex CbvSrvUavDescriptorManager::mMutex;
+D3D12_GPU_DESCRIPTOR_HANDLE CbvSrvUavDescriptorManager::mCbvSrvUavGpuDescriptorHandleHeapStart{ 0UL };
+D3D12_CPU_DESCRIPTOR_HANDLE CbvSrvUavDescriptorManager::mCbvSrvUavCpuDescriptorHandleHeapStart{ 0UL };
+std::uint32_t CbvSrvUavDescriptorManager::mDescriptorHandleIncrementSize{ 0U };
+std::unique_ptr<DescriptorAllocator> CbvSrvUavDescriptorManager::mDescriptorAllocator;
+std::atomic<std::uint64_t> CbvSrvUavDescriptorManager::mFrameFenceValue{ 1UL };
 
 void CbvSrvUavDescriptorManager::Init() noexcept {
+	ASSERT(mCbvSrvUavDescriptorHeap.Get() == nullptr);
+
 	D3D12_DESCRIPTOR_HEAP_DESC cbvSrvUavDescriptorHeapDescriptor{};
 	cbvSrvUavDescriptorHeapDescriptor.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
 	cbvSrvUavDescriptorHeapDescriptor.NodeMask = 0U;
-	cbvSrvUavDescriptorHeapDescriptor.NumDescriptors = 3000U;
+	cbvSrvUavDescriptorHeapDescriptor.NumDescriptors = sDescriptorCount;
 	cbvSrvUavDescriptorHeapDescriptor.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
 
-	mMutex.lock();
 	CHECK_HR(DirectXManager::GetDevice().CreateDescriptorHeap(
 		&cbvSrvUavDescriptorHeapDescriptor,
 		IID_PPV_ARGS(mCbvSrvUavDescriptorHeap.GetAddressOf())));
-	mMutex.unlock();
 
-	mCurrentCbvSrvUavGpuDescriptorHandle = mCbvSrvUavDescriptorHeap->GetGPUDescriptorHandleForHeapStart();
-	mCurrentCbvSrvUavCpuDescriptorHandle = mCbvSrvUavDescriptorHeap->GetCPUDescriptorHandleForHeapStart();
+	mCbvSrvUavGpuDescriptorHandleHeapStart = mCbvSrvUavDescriptorHeap->GetGPUDescriptorHandleForHeapStart();
+	mCbvSrvUavCpuDescriptorHandleHeapStart = mCbvSrvUavDescriptorHeap->GetCPUDescriptorHandleForHeapStart();
+	mDescriptorHandleIncrementSize = DirectXManager::GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+
+	mDescriptorAllocator.reset(new DescriptorAllocator(sDescriptorCount));
 }
 
 D3D12_GPU_DESCRIPTOR_HANDLE CbvSrvUavDescriptorManager::CreateConstantBufferView(
 	const D3D12_CONSTANT_BUFFER_VIEW_DESC& descriptor) noexcept 
 {
-	D3D12_GPU_DESCRIPTOR_HANDLE gpuDescriptorHandle{};
+	const std::uint32_t descriptorIndex{ AllocateDescriptors(1U) };
+	DirectXManager::GetDevice().CreateConstantBufferView(&descriptor, GetCpuDescriptorHandle(descriptorIndex));
 
-	mMutex.lock();
-	gpuDescriptorHandle = mCurrentCbvSrvUavGpuDescriptorHandle;
-
-	DirectXManager::GetDevice().CreateConstantBufferView(&descriptor, mCurrentCbvSrvUavCpuDescriptorHandle);
-
-	mCurrentCbvSrvUavGpuDescriptorHandle.ptr += DirectXManager::GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-	mCurrentCbvSrvUavCpuDescriptorHandle.ptr += DirectXManager::GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-	mMutex.unlock();
-
-	return gpuDescriptorHandle;
+	return GetGpuDescriptorHandle(descriptorIndex);
 }
 
 D3D12_GPU_DESCRIPTOR_HANDLE CbvSrvUavDescriptorManager::CreateConstantBufferViews(
@@ -52,39 +51,22 @@ D3D12_GPU_DESCRIPTOR_HANDLE CbvSrvUavDescriptorManager::CreateConstantBufferView
 	ASSERT(descriptors != nullptr);
 	ASSERT(descriptorCount > 0U);
 
-	D3D12_GPU_DESCRIPTOR_HANDLE gpuDescriptorHandle{};
-
-	mMutex.lock();
-	gpuDescriptorHandle = mCurrentCbvSrvUavGpuDescriptorHandle;
-
+	const std::uint32_t firstDescriptorIndex{ AllocateDescriptors(descriptorCount) };
 	for (std::uint32_t i = 0U; i < descriptorCount; ++i) {
-		DirectXManager::GetDevice().CreateConstantBufferView(&descriptors[i], mCurrentCbvSrvUavCpuDescriptorHandle);
-		mCurrentCbvSrvUavCpuDescriptorHandle.ptr += DirectXManager::GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+		DirectXManager::GetDevice().CreateConstantBufferView(&descriptors[i], GetCpuDescriptorHandle(firstDescriptorIndex + i));
 	}
 
-	mCurrentCbvSrvUavGpuDescriptorHandle.ptr += descriptorCount * DirectXManager::GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-
-	mMutex.unlock();
-
-	return gpuDescriptorHandle;
+	return GetGpuDescriptorHandle(firstDescriptorIndex);
 }
 
 D3D12_GPU_DESCRIPTOR_HANDLE CbvSrvUavDescriptorManager::CreateShaderResourceView(
 	ID3D12Resource& resource,
 	const D3D12_SHADER_RESOURCE_VIEW_DESC& descriptor) noexcept
 {
-	D3D12_GPU_DESCRIPTOR_HANDLE gpuDescriptorHandle{};
-
-	mMutex.lock();
-	gpuDescriptorHandle = mCurrentCbvSrvUavGpuDescriptorHandle;
-
-	DirectXManager::GetDevice().CreateShaderResourceView(&resource, &descriptor, mCurrentCbvSrvUavCpuDescriptorHandle);
-
-	mCurrentCbvSrvUavGpuDescriptorHandle.ptr += DirectXManager::GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-	mCurrentCbvSrvUavCpuDescriptorHandle.ptr += DirectXManager::GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-	mMutex.unlock();
+	const std::uint32_t descriptorIndex{ AllocateDescriptors(1U) };
+	DirectXManager::GetDevice().CreateShaderResourceView(&resource, &descriptor, GetCpuDescriptorHandle(descriptorIndex));
 
-	return gpuDescriptorHandle;
+	return GetGpuDescriptorHandle(descriptorIndex);
 }
 
 D3D12_GPU_DESCRIPTOR_HANDLE CbvSrvUavDescriptorManager::CreateShaderResourceViews(
@@ -96,40 +78,32 @@ D3D12_GPU_DESCRIPTOR_HANDLE CbvSrvUavDescriptorManager::CreateShaderResourceView
 	ASSERT(descriptors != nullptr);
 	ASSERT(descriptorCount > 0U);
 
-	D3D12_GPU_DESCRIPTOR_HANDLE gpuDescriptorHandle{};
-
-	mMutex.lock();
-	gpuDescriptorHandle = mCurrentCbvSrvUavGpuDescriptorHandle;
-
+	const std::uint32_t firstDescriptorIndex{ AllocateDescriptors(descriptorCount) };
 	for (std::uint32_t i = 0U; i < descriptorCount; ++i) {
 		ASSERT(resources[i] != nullptr);
-		DirectXManager::GetDevice().CreateShaderResourceView(resources[i], &descriptors[i], mCurrentCbvSrvUavCpuDescriptorHandle);
-		mCurrentCbvSrvUavCpuDescriptorHandle.ptr += DirectXManager::GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+		DirectXManager::GetDevice().CreateShaderResourceView(resources[i], &descriptors[i], GetCpuDescriptorHandle(firstDescriptorIndex + i));
 	}
 
-	mCurrentCbvSrvUavGpuDescriptorHandle.ptr += descriptorCount * DirectXManager::GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-
-	mMutex.unlock();
+	return GetGpuDescriptorHandle(firstDescriptorIndex);
+}
 
-	return gpuDescriptorHandle;
+void CbvSrvUavDescriptorManager::UpdateShaderResourceView(
+	const D3D12_GPU_DESCRIPTOR_HANDLE gpuDescriptorHandle,
+	ID3D12Resource& resource,
+	const D3D12_SHADER_RESOURCE_VIEW_DESC& descriptor) noexcept
+{
+	const std::uint32_t descriptorIndex{ GetDescriptorIndex(gpuDescriptorHandle) };
+	DirectXManager::GetDevice().CreateShaderResourceView(&resource, &descriptor, GetCpuDescriptorHandle(descriptorIndex));
 }
 
 D3D12_GPU_DESCRIPTOR_HANDLE CbvSrvUavDescriptorManager::CreateUnorderedAccessView(
 	ID3D12Resource& resource,
 	const D3D12_UNORDERED_ACCESS_VIEW_DESC& descriptor) noexcept
 {
-	D3D12_GPU_DESCRIPTOR_HANDLE gpuDescriptorHandle{};
-
-	mMutex.lock();
-	gpuDescriptorHandle = mCurrentCbvSrvUavGpuDescriptorHandle;
-
-	DirectXManager::GetDevice().CreateUnorderedAccessView(&resource, nullptr, &descriptor, mCurrentCbvSrvUavCpuDescriptorHandle);
-
-	mCurrentCbvSrvUavGpuDescriptorHandle.ptr += DirectXManager::GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-	mCurrentCbvSrvUavCpuDescriptorHandle.ptr += DirectXManager::GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-	mMutex.unlock();
+	const std::uint32_t descriptorIndex{ AllocateDescriptors(1U) };
+	DirectXManager::GetDevice().CreateUnorderedAccessView(&resource, nullptr, &descriptor, GetCpuDescriptorHandle(descriptorIndex));
 
-	return gpuDescriptorHandle;
+	return GetGpuDescriptorHandle(descriptorIndex);
 }
 
 D3D12_GPU_DESCRIPTOR_HANDLE CbvSrvUavDescriptorManager::CreateUnorderedAccessViews(
@@ -141,20 +115,93 @@ D3D12_GPU_DESCRIPTOR_HANDLE CbvSrvUavDescriptorManager::CreateUnorderedAccessVie
 	ASSERT(descriptors != nullptr);
 	ASSERT(descriptorCount > 0U);
 
-	D3D12_GPU_DESCRIPTOR_HANDLE gpuDescriptorHandle{};
-
-	mMutex.lock();
-	gpuDescriptorHandle = mCurrentCbvSrvUavGpuDescriptorHandle;
-
+	const std::uint32_t firstDescriptorIndex{ AllocateDescriptors(descriptorCount) };
 	for (std::uint32_t i = 0U; i < descriptorCount; ++i) {
 		ASSERT(resources[i] != nullptr);
-		DirectXManager::GetDevice().CreateUnorderedAccessView(resources[i], nullptr, &descriptors[i], mCurrentCbvSrvUavCpuDescriptorHandle);
-		mCurrentCbvSrvUavCpuDescriptorHandle.ptr += DirectXManager::GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+		DirectXManager::GetDevice().CreateUnorderedAccessView(resources[i], nullptr, &descriptors[i], GetCpuDescriptorHandle(firstDescriptorIndex + i));
 	}
 
-	mCurrentCbvSrvUavGpuDescriptorHandle.ptr += descriptorCount * DirectXManager::GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+	return GetGpuDescriptorHandle(firstDescriptorIndex);
+}
+
+void CbvSrvUavDescriptorManager::DestroyView(
+	const D3D12_GPU_DESCRIPTOR_HANDLE gpuDescriptorHandle,
+	const std::uint64_t fenceValue) noexcept
+{
+	FreeDescriptors(GetDescriptorIndex(gpuDescriptorHandle), 1U, fenceValue);
+}
+
+void CbvSrvUavDescriptorManager::DestroyViews(
+	const D3D12_GPU_DESCRIPTOR_HANDLE firstGpuDescriptorHandle,
+	const std::uint32_t descriptorCount,
+	const std::uint64_t fenceValue) noexcept
+{
+	FreeDescriptors(GetDescriptorIndex(firstGpuDescriptorHandle), descriptorCount, fenceValue);
+}
+
+void CbvSrvUavDescriptorManager::ReleaseCompletedDescriptors(const std::uint64_t completedFenceValue) noexcept {
+	GetDescriptorAllocator().ReleaseCompletedFrees(completedFenceValue);
+}
+
+void CbvSrvUavDescriptorManager::SetFrameFenceValue(const std::uint64_t fenceValue) noexcept {
+	mFrameFenceValue.store(fenceValue, std::memory_order_relaxed);
+}
+
+std::uint64_t CbvSrvUavDescriptorManager::GetFrameFenceValue() noexcept {
+	return mFrameFenceValue.load(std::memory_order_relaxed);
+}
+
+std::uint32_t CbvSrvUavDescriptorManager::GetDescriptorIndex(const D3D12_GPU_DESCRIPTOR_HANDLE gpuDescriptorHandle) noexcept {
+	ASSERT(gpuDescriptorHandle.ptr >= mCbvSrvUavGpuDescriptorHandleHeapStart.ptr);
+	const std::uint64_t offset{ gpuDescriptorHandle.ptr - mCbvSrvUavGpuDescriptorHandleHeapStart.ptr };
+	ASSERT(offset % mDescriptorHandleIncrementSize == 0UL);
+
+	const std::uint32_t descriptorIndex{ static_cast<std::uint32_t>(offset / mDescriptorHandleIncrementSize) };
+	ASSERT(descriptorIndex < sDescriptorCount);
+
+	return descriptorIndex;
+}
+
+D3D12_GPU_DESCRIPTOR_HANDLE CbvSrvUavDescriptorManager::GetGpuDescriptorHandle(const std::uint32_t descriptorIndex) noexcept {
+	ASSERT(descriptorIndex < sDescriptorCount);
 
-	mMutex.unlock();
+	D3D12_GPU_DESCRIPTOR_HANDLE gpuDescriptorHandle{ mCbvSrvUavGpuDescriptorHandleHeapStart };
+	gpuDescriptorHandle.ptr += static_cast<std::uint64_t>(descriptorIndex) * mDescriptorHandleIncrementSize;
 
 	return gpuDescriptorHandle;
-}
\ No newline at end of file
+}
+
+std::uint32_t CbvSrvUavDescriptorManager::AllocateDescriptors(const std::uint32_t descriptorCount) noexcept {
+	ASSERT(descriptorCount > 0U);
+
+	const std::uint32_t firstDescriptorIndex{ 
+		descriptorCount == 1U ? GetDescriptorAllocator().Allocate() : GetDescriptorAllocator().AllocateRange(descriptorCount) };
+	ASSERT(firstDescriptorIndex != DescriptorAllocator::sInvalidIndex);
+
+	return firstDescriptorIndex;
+}
+
+void CbvSrvUavDescriptorManager::FreeDescriptors(
+	const std::uint32_t firstDescriptorIndex,
+	const std::uint32_t descriptorCount,
+	const std::uint64_t fenceValue) noexcept
+{
+	ASSERT(descriptorCount > 0U);
+
+	// Same pools than AllocateDescriptors(): a single view comes from the free list
+	// even if it was created by a method that creates several views.
+	if (descriptorCount == 1U) {
+		GetDescriptorAllocator().Free(firstDescriptorIndex, fenceValue);
+	} else {
+		GetDescriptorAllocator().FreeRange(firstDescriptorIndex, descriptorCount, fenceValue);
+	}
+}
+
+D3D12_CPU_DESCRIPTOR_HANDLE CbvSrvUavDescriptorManager::GetCpuDescriptorHandle(const std::uint32_t descriptorIndex) noexcept {
+	ASSERT(descriptorIndex < sDescriptorCount);
+
+	D3D12_CPU_DESCRIPTOR_HANDLE cpuDescriptorHandle{ mCbvSrvUavCpuDescriptorHandleHeapStart };
+	cpuDescriptorHandle.ptr += static_cast<std::size_t>(descriptorIndex) * mDescriptorHandleIncrementSize;
+
+	return cpuDescriptorHandle;
+}
@@ -1,13 +1,20 @@
 #pragma once
 
+#include <atomic>
 #include <d3d12.h>
-#include <mutex>
+#include <memory>
 #include <wrl.h>
 
+#include <DescriptorManager\DescriptorAllocator.h>
 #include <Utils/DebugUtils.h>
 
 // To create Constant Buffer / Shader GetResource / Unordered Access Views descriptor heaps
 // To create Constant Buffer / Shader GetResource / Unordered Access descriptors
+//
+// All the descriptors live in a single shader visible heap, and their positions (indices)
+// never change while they are alive, so shaders can index the heap directly (bindless).
+// Descriptors can be destroyed, but they are reused only after the GPU completes
+// the frame that destroyed them (see ReleaseCompletedDescriptors()).
 class CbvSrvUavDescriptorManager {
 public:
 	CbvSrvUavDescriptorManager() = delete;
@@ -26,6 +33,9 @@ public:
 	// to the first element. As we guarantee all the other views are contiguous, then
 	// you can easily build GPU desc handle for other view.
 	//
+	// Methods that create a single view do not lock (unless the descriptors free list
+	// must be refilled), and views created by different calls are not contiguous.
+	//
 
 	static D3D12_GPU_DESCRIPTOR_HANDLE CreateConstantBufferView(
 		const D3D12_CONSTANT_BUFFER_VIEW_DESC& cBufferViewDescriptor) noexcept;
@@ -50,6 +60,16 @@ public:
 		const D3D12_SHADER_RESOURCE_VIEW_DESC* descriptors,
 		const std::uint32_t descriptorCount) noexcept;
 
+	// Replaces the view "gpuDescriptorHandle" with a new view, in the same position,
+	// so shaders and descriptor tables that use it see the new view.
+	// Preconditions:
+	// - "gpuDescriptorHandle" must belong to the descriptor heap
+	// - GPU must not be using the view
+	static void UpdateShaderResourceView(
+		const D3D12_GPU_DESCRIPTOR_HANDLE gpuDescriptorHandle,
+		ID3D12Resource& resource,
+		const D3D12_SHADER_RESOURCE_VIEW_DESC& shaderResourceViewDescriptor) noexcept;
+
 	static D3D12_GPU_DESCRIPTOR_HANDLE CreateUnorderedAccessView(
 		ID3D12Resource& resource,
 		const D3D12_UNORDERED_ACCESS_VIEW_DESC& descriptor) noexcept;
@@ -63,16 +83,73 @@ public:
 		const D3D12_UNORDERED_ACCESS_VIEW_DESC* descriptors,
 		const std::uint32_t descriptorCount) noexcept;
 
+	//
+	// Destroy methods make the views available again once the frame with "fenceValue"
+	// is completed by the GPU (usually GetFrameFenceValue(), the frame being recorded).
+	// Views must not be used by command lists of later frames. Views are returned to
+	// the pool they were allocated from (see AllocateDescriptors()).
+	//
+
+	// Preconditions:
+	// - "gpuDescriptorHandle" must have been returned by a method that creates a single view
+	static void DestroyView(
+		const D3D12_GPU_DESCRIPTOR_HANDLE gpuDescriptorHandle,
+		const std::uint64_t fenceValue) noexcept;
+
+	// Preconditions:
+	// - "firstGpuDescriptorHandle" must have been returned by a method that creates several views
+	// - "descriptorCount" must be the number of views it created
+	static void DestroyViews(
+		const D3D12_GPU_DESCRIPTOR_HANDLE firstGpuDescriptorHandle,
+		const std::uint32_t descriptorCount,
+		const std::uint64_t fenceValue) noexcept;
+
+	// Reuses views destroyed in frames whose fence value is less or equal than "completedFenceValue".
+	// It must be called from a single thread (for example, once per frame after waiting the fence).
+	static void ReleaseCompletedDescriptors(const std::uint64_t completedFenceValue) noexcept;
+
+	// Fence value that the frame being recorded signals when the GPU completes it.
+	// RenderManager sets it after presenting each frame.
+	static void SetFrameFenceValue(const std::uint64_t fenceValue) noexcept;
+	static std::uint64_t GetFrameFenceValue() noexcept;
+
+	// Index of the view in the descriptor heap, that shaders can use to index it.
+	// Preconditions:
+	// - "gpuDescriptorHandle" must belong to the descriptor heap
+	static std::uint32_t GetDescriptorIndex(const D3D12_GPU_DESCRIPTOR_HANDLE gpuDescriptorHandle) noexcept;
+
+	static D3D12_GPU_DESCRIPTOR_HANDLE GetGpuDescriptorHandle(const std::uint32_t descriptorIndex) noexcept;
+
 	static ID3D12DescriptorHeap& GetDescriptorHeap() noexcept {
 		ASSERT(mCbvSrvUavDescriptorHeap.Get() != nullptr);
 		return *mCbvSrvUavDescriptorHeap.Get();
 	}
 
+	static DescriptorAllocator& GetDescriptorAllocator() noexcept {
+		ASSERT(mDescriptorAllocator.get() != nullptr);
+		return *mDescriptorAllocator.get();
+	}
+
 private:
+	// Returns the index of the first view of "descriptorCount" contiguous views.
+	// If "descriptorCount" is 1, then it uses the lock-free free list.
+	static std::uint32_t AllocateDescriptors(const std::uint32_t descriptorCount) noexcept;
+
+	// Frees views returned by AllocateDescriptors() to the same pool
+	static void FreeDescriptors(
+		const std::uint32_t firstDescriptorIndex,
+		const std::uint32_t descriptorCount,
+		const std::uint64_t fenceValue) noexcept;
+
+	static D3D12_CPU_DESCRIPTOR_HANDLE GetCpuDescriptorHandle(const std::uint32_t descriptorIndex) noexcept;
+
 	static Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> mCbvSrvUavDescriptorHeap;
 
-	static D3D12_GPU_DESCRIPTOR_HANDLE mCurrentCbvSrvUavGpuDescriptorHandle;
-	static D3D12_CPU_DESCRIPTOR_HANDLE mCurrentCbvSrvUavCpuDescriptorHandle;
+	static D3D12_GPU_DESCRIPTOR_HANDLE mCbvSrvUavGpuDescriptorHandleHeapStart;
+	static D3D12_CPU_DESCRIPTOR_HANDLE mCbvSrvUavCpuDescriptorHandleHeapStart;
+	static std::uint32_t mDescriptorHandleIncrementSize;
+
+	static std::unique_ptr<DescriptorAllocator> mDescriptorAllocator;
 
-	static std::mutex mMutex;
+	static std::atomic<std::uint64_t> mFrameFenceValue;
 };
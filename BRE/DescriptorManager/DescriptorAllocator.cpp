@@ -0,0 +1,293 @@
+#include "DescriptorAllocator.h"
+
+#include <algorithm>
+
+#include <Utils/DebugUtils.h>
+
+const std::uint32_t DescriptorAllocator::sInvalidIndex;
+const std::uint32_t DescriptorAllocator::sFreeListChunkSize;
+const std::uint32_t DescriptorAllocator::sMaxFreeListSize;
+
+DescriptorAllocator::DescriptorAllocator(const std::uint32_t capacity)
+	: mCapacity(capacity)
+	, mNextIndices(new std::atomic<std::uint32_t>[capacity])
+	, mFreeFenceValues(new std::uint64_t[capacity])
+	, mFreeListHead(sInvalidIndex)
+	, mPendingFreeListHead(sInvalidIndex)
+{
+	ASSERT(capacity > 0U);
+	ASSERT(capacity < sInvalidIndex);
+
+	for (std::uint32_t i = 0U; i < capacity; ++i) {
+		mNextIndices[i].store(sInvalidIndex, std::memory_order_relaxed);
+		mFreeFenceValues[i] = 0UL;
+	}
+
+	Range range;
+	range.mFirst = 0U;
+	range.mCount = capacity;
+	mFreeRanges.push_back(range);
+}
+
+std::uint32_t DescriptorAllocator::Allocate() noexcept {
+	for (;;) {
+		const std::uint32_t descriptorIndex{ Pop(mFreeListHead) };
+		if (descriptorIndex != sInvalidIndex) {
+			mFreeListSize.fetch_sub(1U, std::memory_order_relaxed);
+			return descriptorIndex;
+		}
+
+		// Free list is empty, so we refill it with a chunk of a free range.
+		// We keep the first descriptor of the chunk for us.
+		std::lock_guard<std::mutex> lock(mMutex);
+		if (GetHeadIndex(mFreeListHead.load(std::memory_order_acquire)) != sInvalidIndex) {
+			// Another thread refilled it
+			continue;
+		}
+
+		std::uint32_t chunkSize{ sFreeListChunkSize };
+		std::uint32_t firstIndex{ sInvalidIndex };
+		while (chunkSize > 0U && (firstIndex = AllocateRangeLocked(chunkSize)) == sInvalidIndex) {
+			chunkSize /= 2U;
+		}
+		if (firstIndex == sInvalidIndex) {
+			return sInvalidIndex;
+		}
+
+		mFreeListSize.fetch_add(chunkSize - 1U, std::memory_order_relaxed);
+		for (std::uint32_t i = 1U; i < chunkSize; ++i) {
+			Push(mFreeListHead, firstIndex + i);
+		}
+
+		return firstIndex;
+	}
+}
+
+std::uint32_t DescriptorAllocator::AllocateRange(const std::uint32_t descriptorCount) noexcept {
+	ASSERT(descriptorCount > 0U);
+
+	std::lock_guard<std::mutex> lock(mMutex);
+	const std::uint32_t firstIndex{ AllocateRangeLocked(descriptorCount) };
+	if (firstIndex != sInvalidIndex) {
+		return firstIndex;
+	}
+
+	// Descriptors in the free list can fill the holes between free ranges.
+	// Other threads can still pop from the free list, but not refill it (it needs mMutex).
+	mDrainedIndices.clear();
+	std::uint32_t descriptorIndex{ sInvalidIndex };
+	while ((descriptorIndex = Pop(mFreeListHead)) != sInvalidIndex) {
+		mFreeListSize.fetch_sub(1U, std::memory_order_relaxed);
+		mDrainedIndices.push_back(descriptorIndex);
+	}
+	if (mDrainedIndices.empty()) {
+		return sInvalidIndex;
+	}
+
+	std::sort(mDrainedIndices.begin(), mDrainedIndices.end());
+	AddFreeDescriptorsLocked(mDrainedIndices);
+
+	return AllocateRangeLocked(descriptorCount);
+}
+
+void DescriptorAllocator::Free(const std::uint32_t descriptorIndex, const std::uint64_t fenceValue) noexcept {
+	ASSERT(descriptorIndex < mCapacity);
+
+	// Push() publishes it with release semantics
+	mFreeFenceValues[descriptorIndex] = fenceValue;
+	Push(mPendingFreeListHead, descriptorIndex);
+}
+
+void DescriptorAllocator::FreeRange(
+	const std::uint32_t firstDescriptorIndex,
+	const std::uint32_t descriptorCount,
+	const std::uint64_t fenceValue) noexcept
+{
+	ASSERT(descriptorCount > 0U);
+	ASSERT(firstDescriptorIndex < mCapacity);
+	ASSERT(descriptorCount <= mCapacity - firstDescriptorIndex);
+
+	PendingRange pendingRange;
+	pendingRange.mRange.mFirst = firstDescriptorIndex;
+	pendingRange.mRange.mCount = descriptorCount;
+	pendingRange.mFenceValue = fenceValue;
+
+	std::lock_guard<std::mutex> lock(mMutex);
+	mPendingFreeRanges.push_back(pendingRange);
+}
+
+void DescriptorAllocator::ReleaseCompletedFrees(const std::uint64_t completedFenceValue) noexcept {
+	// Take all the pending descriptors. The ones whose frame is not completed go back to the pending list.
+	std::uint64_t pendingHead{ mPendingFreeListHead.load(std::memory_order_relaxed) };
+	while (mPendingFreeListHead.compare_exchange_weak(
+		pendingHead,
+		MakeHead(sInvalidIndex, pendingHead),
+		std::memory_order_acquire,
+		std::memory_order_relaxed) == false)
+	{
+	}
+
+	// Completed descriptors that do not fit in the free list are merged with the free ranges
+	mReleasedIndices.clear();
+	std::uint32_t descriptorIndex{ GetHeadIndex(pendingHead) };
+	while (descriptorIndex != sInvalidIndex) {
+		const std::uint32_t nextIndex{ mNextIndices[descriptorIndex].load(std::memory_order_relaxed) };
+		if (mFreeFenceValues[descriptorIndex] > completedFenceValue) {
+			Push(mPendingFreeListHead, descriptorIndex);
+		} else if (mFreeListSize.load(std::memory_order_relaxed) < sMaxFreeListSize) {
+			mFreeListSize.fetch_add(1U, std::memory_order_relaxed);
+			Push(mFreeListHead, descriptorIndex);
+		} else {
+			mReleasedIndices.push_back(descriptorIndex);
+		}
+		descriptorIndex = nextIndex;
+	}
+	std::sort(mReleasedIndices.begin(), mReleasedIndices.end());
+
+	std::lock_guard<std::mutex> lock(mMutex);
+	AddFreeDescriptorsLocked(mReleasedIndices);
+
+	std::size_t pendingRangeCount{ mPendingFreeRanges.size() };
+	for (std::size_t i = 0UL; i < pendingRangeCount;) {
+		if (mPendingFreeRanges[i].mFenceValue <= completedFenceValue) {
+			AddFreeRangeLocked(mPendingFreeRanges[i].mRange);
+			mPendingFreeRanges[i] = mPendingFreeRanges[pendingRangeCount - 1UL];
+			--pendingRangeCount;
+		} else {
+			++i;
+		}
+	}
+	mPendingFreeRanges.resize(pendingRangeCount);
+}
+
+std::uint32_t DescriptorAllocator::GetFreeRangeCount() const noexcept {
+	std::lock_guard<std::mutex> lock(mMutex);
+	return static_cast<std::uint32_t>(mFreeRanges.size());
+}
+
+std::uint32_t DescriptorAllocator::GetLargestFreeRangeSize() const noexcept {
+	std::lock_guard<std::mutex> lock(mMutex);
+	std::uint32_t largestSize{ 0U };
+	for (const Range& range : mFreeRanges) {
+		largestSize = std::max<std::uint32_t>(largestSize, range.mCount);
+	}
+
+	return largestSize;
+}
+
+std::uint32_t DescriptorAllocator::GetFreeListSize() const noexcept {
+	return mFreeListSize.load(std::memory_order_relaxed);
+}
+
+std::uint64_t DescriptorAllocator::MakeHead(const std::uint32_t index, const std::uint64_t oldHead) noexcept {
+	const std::uint64_t counter{ (oldHead >> 32UL) + 1UL };
+	return (counter << 32UL) | index;
+}
+
+std::uint32_t DescriptorAllocator::GetHeadIndex(const std::uint64_t head) noexcept {
+	return static_cast<std::uint32_t>(head & 0xFFFFFFFFUL);
+}
+
+void DescriptorAllocator::Push(std::atomic<std::uint64_t>& head, const std::uint32_t descriptorIndex) noexcept {
+	ASSERT(descriptorIndex < mCapacity);
+
+	std::uint64_t oldHead{ head.load(std::memory_order_relaxed) };
+	do {
+		mNextIndices[descriptorIndex].store(GetHeadIndex(oldHead), std::memory_order_relaxed);
+	} while (head.compare_exchange_weak(
+		oldHead,
+		MakeHead(descriptorIndex, oldHead),
+		std::memory_order_release,
+		std::memory_order_relaxed) == false);
+}
+
+std::uint32_t DescriptorAllocator::Pop(std::atomic<std::uint64_t>& head) noexcept {
+	std::uint64_t oldHead{ head.load(std::memory_order_acquire) };
+	for (;;) {
+		const std::uint32_t descriptorIndex{ GetHeadIndex(oldHead) };
+		if (descriptorIndex == sInvalidIndex) {
+			return sInvalidIndex;
+		}
+
+		// If another thread pops it first, the counter changes and the exchange fails
+		const std::uint32_t nextIndex{ mNextIndices[descriptorIndex].load(std::memory_order_relaxed) };
+		if (head.compare_exchange_weak(
+			oldHead,
+			MakeHead(nextIndex, oldHead),
+			std::memory_order_acquire,
+			std::memory_order_acquire))
+		{
+			return descriptorIndex;
+		}
+	}
+}
+
+std::uint32_t DescriptorAllocator::AllocateRangeLocked(const std::uint32_t descriptorCount) noexcept {
+	ASSERT(descriptorCount > 0U);
+
+	const std::size_t freeRangeCount{ mFreeRanges.size() };
+	for (std::size_t i = 0UL; i < freeRangeCount; ++i) {
+		Range& range = mFreeRanges[i];
+		if (range.mCount >= descriptorCount) {
+			const std::uint32_t firstIndex{ range.mFirst };
+			range.mFirst += descriptorCount;
+			range.mCount -= descriptorCount;
+			if (range.mCount == 0U) {
+				mFreeRanges.erase(mFreeRanges.begin() + i);
+			}
+
+			return firstIndex;
+		}
+	}
+
+	return sInvalidIndex;
+}
+
+void DescriptorAllocator::AddFreeDescriptorsLocked(const std::vector<std::uint32_t>& descriptorIndices) noexcept {
+	const std::size_t descriptorCount{ descriptorIndices.size() };
+	std::size_t i{ 0UL };
+	while (i < descriptorCount) {
+		Range range;
+		range.mFirst = descriptorIndices[i];
+		range.mCount = 1U;
+		while (i + range.mCount < descriptorCount && descriptorIndices[i + range.mCount] == range.mFirst + range.mCount) {
+			++range.mCount;
+		}
+
+		AddFreeRangeLocked(range);
+		i += range.mCount;
+	}
+}
+
+void DescriptorAllocator::AddFreeRangeLocked(const Range& range) noexcept {
+	ASSERT(range.mCount > 0U);
+
+	// Keep them sorted and merge with previous and next ranges if they are adjacent
+	std::vector<Range>::iterator nextIt = std::lower_bound(
+		mFreeRanges.begin(),
+		mFreeRanges.end(),
+		range,
+		[](const Range& range1, const Range& range2) { return range1.mFirst < range2.mFirst; });
+	ASSERT(nextIt == mFreeRanges.end() || range.mFirst + range.mCount <= nextIt->mFirst);
+
+	if (nextIt != mFreeRanges.begin()) {
+		std::vector<Range>::iterator previousIt = nextIt - 1;
+		ASSERT(previousIt->mFirst + previousIt->mCount <= range.mFirst);
+		if (previousIt->mFirst + previousIt->mCount == range.mFirst) {
+			previousIt->mCount += range.mCount;
+			if (nextIt != mFreeRanges.end() && previousIt->mFirst + previousIt->mCount == nextIt->mFirst) {
+				previousIt->mCount += nextIt->mCount;
+				mFreeRanges.erase(nextIt);
+			}
+			return;
+		}
+	}
+
+	if (nextIt != mFreeRanges.end() && range.mFirst + range.mCount == nextIt->mFirst) {
+		nextIt->mFirst = range.mFirst;
+		nextIt->mCount += range.mCount;
+		return;
+	}
+
+	mFreeRanges.insert(nextIt, range);
+}
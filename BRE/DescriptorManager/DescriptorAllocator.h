@@ -0,0 +1,129 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// To allocate descriptor indices of a descriptor heap with "capacity" descriptors.
+// Indices are stable (they do not change while they are allocated), so shaders 
+// can index the heap directly with them (bindless).
+// - Single descriptors are taken from a lock-free free list. When it is empty,
+//   it is refilled with a chunk of contiguous descriptors. Freed descriptors go back to
+//   the free list while it has less than sMaxFreeListSize descriptors, and to the free ranges
+//   (where they are merged) otherwise, so single frees do not fragment the heap forever.
+// - Contiguous ranges (descriptor tables) are allocated first-fit from a list of 
+//   free ranges that is protected by a mutex (ranges are usually allocated on load).
+//   Freed ranges are merged with their neighbors.
+// - Frees are deferred until the GPU completes the frame that freed them.
+// Steps:
+// - Allocate(), AllocateRange(), Free() and FreeRange() from any thread
+// - Call ReleaseCompletedFrees() with the last completed fence value to reuse freed descriptors
+class DescriptorAllocator {
+public:
+	static const std::uint32_t sInvalidIndex{ 0xFFFFFFFFU };
+
+	// Number of descriptors we move from free ranges to the free list when it is empty
+	static const std::uint32_t sFreeListChunkSize{ 64U };
+
+	// Maximum number of freed descriptors that ReleaseCompletedFrees() returns to the free list
+	static const std::uint32_t sMaxFreeListSize{ 2U * sFreeListChunkSize };
+
+	// Preconditions:
+	// - "capacity" must be greater than zero and less than sInvalidIndex
+	explicit DescriptorAllocator(const std::uint32_t capacity);
+
+	~DescriptorAllocator() = default;
+	DescriptorAllocator(const DescriptorAllocator&) = delete;
+	const DescriptorAllocator& operator=(const DescriptorAllocator&) = delete;
+	DescriptorAllocator(DescriptorAllocator&&) = delete;
+	DescriptorAllocator& operator=(DescriptorAllocator&&) = delete;
+
+	// Returns the index of a descriptor or sInvalidIndex if there is no free descriptor.
+	// It is thread safe, and lock-free unless the free list needs to be refilled.
+	std::uint32_t Allocate() noexcept;
+
+	// Returns the index of the first descriptor of "descriptorCount" contiguous descriptors,
+	// or sInvalidIndex if there is no free range big enough. If no free range is big enough,
+	// the free list is returned to the free ranges before giving up. It is thread safe.
+	// Preconditions:
+	// - "descriptorCount" must be greater than zero
+	std::uint32_t AllocateRange(const std::uint32_t descriptorCount) noexcept;
+
+	// Frees a descriptor returned by Allocate(). It can be reused once the frame with
+	// "fenceValue" is completed (see ReleaseCompletedFrees()). It is thread safe and lock-free.
+	// Preconditions:
+	// - "descriptorIndex" must have been returned by Allocate() and not freed
+	void Free(const std::uint32_t descriptorIndex, const std::uint64_t fenceValue) noexcept;
+
+	// Frees a range returned by AllocateRange(). It can be reused once the frame with 
+	// "fenceValue" is completed (see ReleaseCompletedFrees()). It is thread safe.
+	// Preconditions:
+	// - Range must have been returned by AllocateRange() and not freed
+	void FreeRange(
+		const std::uint32_t firstDescriptorIndex,
+		const std::uint32_t descriptorCount,
+		const std::uint64_t fenceValue) noexcept;
+
+	// Makes descriptors freed in frames whose fence value is less or
+	// equal than "completedFenceValue" available again.
+	// It must not be called at the same time than itself.
+	void ReleaseCompletedFrees(const std::uint64_t completedFenceValue) noexcept;
+
+	__forceinline std::uint32_t GetCapacity() const noexcept { return mCapacity; }
+
+	// Fragmentation statistics of the free ranges (they do not include the free list).
+	// They are thread safe.
+	std::uint32_t GetFreeRangeCount() const noexcept;
+	std::uint32_t GetLargestFreeRangeSize() const noexcept;
+
+	// Number of descriptors in the free list. It is approximate if other threads use the allocator.
+	std::uint32_t GetFreeListSize() const noexcept;
+
+private:
+	struct Range {
+		std::uint32_t mFirst{ 0U };
+		std::uint32_t mCount{ 0U };
+	};
+
+	struct PendingRange {
+		Range mRange;
+		std::uint64_t mFenceValue{ 0UL };
+	};
+
+	// Lock-free stacks of descriptor indices linked through mNextIndices.
+	// Head stores the top index in the low 32 bits and a counter in the high 32 bits 
+	// that changes in every update, to avoid the ABA problem.
+	static std::uint64_t MakeHead(const std::uint32_t index, const std::uint64_t oldHead) noexcept;
+	static std::uint32_t GetHeadIndex(const std::uint64_t head) noexcept;
+	void Push(std::atomic<std::uint64_t>& head, const std::uint32_t descriptorIndex) noexcept;
+	std::uint32_t Pop(std::atomic<std::uint64_t>& head) noexcept;
+
+	// Preconditions:
+	// - mMutex must be locked
+	std::uint32_t AllocateRangeLocked(const std::uint32_t descriptorCount) noexcept;
+	void AddFreeRangeLocked(const Range& range) noexcept;
+
+	// Adds the sorted "descriptorIndices" to the free ranges, a range per run of contiguous indices.
+	// Preconditions:
+	// - mMutex must be locked
+	void AddFreeDescriptorsLocked(const std::vector<std::uint32_t>& descriptorIndices) noexcept;
+
+	std::uint32_t mCapacity{ 0U };
+
+	std::unique_ptr<std::atomic<std::uint32_t>[]> mNextIndices;
+	std::unique_ptr<std::uint64_t[]> mFreeFenceValues;
+	std::atomic<std::uint64_t> mFreeListHead;
+	std::atomic<std::uint64_t> mPendingFreeListHead;
+	std::atomic<std::uint32_t> mFreeListSize{ 0U };
+
+	// Free ranges sorted by first index, and ranges waiting for their frame to complete
+	mutable std::mutex mMutex;
+	std::vector<Range> mFreeRanges;
+	std::vector<PendingRange> mPendingFreeRanges;
+
+	// Scratch storage of ReleaseCompletedFrees() and AllocateRange()
+	std::vector<std::uint32_t> mReleasedIndices;
+	std::vector<std::uint32_t> mDrainedIndices;
+};
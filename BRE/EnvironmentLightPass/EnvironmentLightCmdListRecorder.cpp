@@ -5,6 +5,7 @@
 #include <CommandListExecutor\CommandListExecutor.h>
 #include <DescriptorManager\CbvSrvUavDescriptorManager.h>
 #include <PSOManager/PSOManager.h>
+#include <ResourceManager/ResourceManager.h>
 #include <ResourceManager/UploadBufferManager.h>
 #include <RootSignatureManager\RootSignatureManager.h>
 #include <ShaderManager\ShaderManager.h>
@@ -69,18 +70,18 @@ void EnvironmentLightCmdListRecorder::Init(
 		diffuseIrradianceCubeMap, 
 		specularPreConvolvedCubeMap);
 
+	// They are not marked as used every frame
+	ID3D12Resource* cubeMaps[]{ &diffuseIrradianceCubeMap, &specularPreConvolvedCubeMap };
+	ResourceManager::KeepResourcesResident(cubeMaps, _countof(cubeMaps));
+
 	ASSERT(ValidateData());
 }
 
-void EnvironmentLightCmdListRecorder::RecordAndPushCommandLists(const FrameCBuffer& frameCBuffer) noexcept {
+void EnvironmentLightCmdListRecorder::RecordAndPushCommandLists(const D3D12_GPU_VIRTUAL_ADDRESS frameCBufferGpuAddress) noexcept {
 	ASSERT(ValidateData());
 	ASSERT(sPSO != nullptr);
 	ASSERT(sRootSignature != nullptr);
 
-	// Update frame constants
-	UploadBuffer& uploadFrameCBuffer(mFrameUploadCBufferPerFrame.GetNextFrameCBuffer());
-	uploadFrameCBuffer.CopyData(0U, &frameCBuffer, sizeof(frameCBuffer));
-	
 	ID3D12GraphicsCommandList& commandList = mCommandListPerFrame.ResetWithNextCommandAllocator(sPSO);
 
 	commandList.RSSetViewports(1U, &SettingsManager::sScreenViewport);
@@ -91,9 +92,8 @@ void EnvironmentLightCmdListRecorder::RecordAndPushCommandLists(const FrameCBuff
 	commandList.SetDescriptorHeaps(_countof(heaps), heaps);
 
 	commandList.SetGraphicsRootSignature(sRootSignature);	
-	const D3D12_GPU_VIRTUAL_ADDRESS frameCBufferGpuVAddress(uploadFrameCBuffer.GetResource()->GetGPUVirtualAddress());
-	commandList.SetGraphicsRootConstantBufferView(0U, frameCBufferGpuVAddress);
-	commandList.SetGraphicsRootConstantBufferView(1U, frameCBufferGpuVAddress);
+	commandList.SetGraphicsRootConstantBufferView(0U, frameCBufferGpuAddress);
+	commandList.SetGraphicsRootConstantBufferView(1U, frameCBufferGpuAddress);
 	commandList.SetGraphicsRootDescriptorTable(2U, mStartPixelShaderResourceView);
 
 	commandList.IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
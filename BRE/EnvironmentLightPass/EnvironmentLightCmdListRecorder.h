@@ -1,12 +1,11 @@
 #pragma once
 
+#include <d3d12.h>
 #include <wrl.h>
 
 #include <CommandManager\CommandListPerFrame.h>
-#include <ResourceManager\FrameUploadCBufferPerFrame.h>
 
 struct D3D12_CPU_DESCRIPTOR_HANDLE;
-struct FrameCBuffer;
 struct ID3D12Resource;
 
 // Responsible of command lists recording to be executed by CommandListExecutor.
@@ -34,7 +33,7 @@ public:
 
 	// Preconditions:
 	// - Init() must be called first
-	void RecordAndPushCommandLists(const FrameCBuffer& frameCBuffer) noexcept;
+	void RecordAndPushCommandLists(const D3D12_GPU_VIRTUAL_ADDRESS frameCBufferGpuAddress) noexcept;
 
 	bool ValidateData() const noexcept;
 
@@ -48,8 +47,6 @@ private:
 		
 	CommandListPerFrame mCommandListPerFrame;
 
-	FrameUploadCBufferPerFrame mFrameUploadCBufferPerFrame;
-
 	D3D12_CPU_DESCRIPTOR_HANDLE mRenderTargetView{ 0UL };
 
 	D3D12_GPU_DESCRIPTOR_HANDLE mStartPixelShaderResourceView{ 0UL };
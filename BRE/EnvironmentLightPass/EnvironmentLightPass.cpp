@@ -29,10 +29,12 @@ void EnvironmentLightPass::Init(
 	ASSERT(ValidateData());
 }
 
-void EnvironmentLightPass::Execute(const FrameCBuffer& frameCBuffer) const noexcept {
+std::uint32_t EnvironmentLightPass::Execute(const D3D12_GPU_VIRTUAL_ADDRESS frameCBufferGpuAddress) const noexcept {
 	ASSERT(ValidateData());
 
-	mCommandListRecorder->RecordAndPushCommandLists(frameCBuffer);
+	mCommandListRecorder->RecordAndPushCommandLists(frameCBufferGpuAddress);
+
+	return 1U;
 }
 
 bool EnvironmentLightPass::ValidateData() const noexcept {
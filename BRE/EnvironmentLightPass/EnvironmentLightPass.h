@@ -5,7 +5,6 @@
 #include <EnvironmentLightPass\EnvironmentLightCmdListRecorder.h>
 
 struct D3D12_CPU_DESCRIPTOR_HANDLE;
-struct FrameCBuffer;
 struct ID3D12Resource;
 
 // Pass responsible to apply diffuse irradiance & specular pre-convolved environment cube maps
@@ -26,9 +25,11 @@ public:
 		ID3D12Resource& specularPreConvolvedCubeMap,
 		const D3D12_CPU_DESCRIPTOR_HANDLE& outputColorBufferCpuDesc) noexcept;
 
+	// Returns the number of command lists pushed to CommandListExecutor.
+	// It does not wait for them to be executed.
 	// Preconditions:
 	// - Init() must be called first
-	void Execute(const FrameCBuffer& frameCBuffer) const noexcept;
+	std::uint32_t Execute(const D3D12_GPU_VIRTUAL_ADDRESS frameCBufferGpuAddress) const noexcept;
 
 private:
 	// Method used internally for validation purposes
@@ -112,6 +112,10 @@ namespace {
 			const Mesh& mesh{ meshes[i] };
 			geomData.mVertexBufferData = mesh.GetVertexBufferData();
 			geomData.mIndexBufferData = mesh.GetIndexBufferData();
+			geomData.mBoundingBox = mesh.GetBoundingBox();
+			geomData.mLods = mesh.GetLods();
+			geomData.mPositionQuantization = mesh.GetPositionQuantization();
+			geomData.mMeshlets = mesh.GetMeshlets();
 			geomData.mWorldMatrices.reserve(numMaterials);
 		}
 
@@ -183,6 +187,10 @@ namespace {
 
 			geomData.mVertexBufferData = mesh.GetVertexBufferData();
 			geomData.mIndexBufferData = mesh.GetIndexBufferData();
+			geomData.mBoundingBox = mesh.GetBoundingBox();
+			geomData.mLods = mesh.GetLods();
+			geomData.mPositionQuantization = mesh.GetPositionQuantization();
+			geomData.mMeshlets = mesh.GetMeshlets();
 
 			geomData.mWorldMatrices.push_back(w);
 		}
@@ -206,10 +214,10 @@ void AmbientOcclussionScene::Init() noexcept {
 	Scene::Init();
 
 	// Load textures
-	sResourceContainer.LoadTextures(sTexFiles, *mCommandAllocator, *mCommandList);
+	sResourceContainer.LoadTextures(sTexFiles);
 
 	// Load models
-	sResourceContainer.LoadModels(sModelFiles, *mCommandAllocator, *mCommandList);
+	sResourceContainer.LoadModels(sModelFiles);
 }
 
 void AmbientOcclussionScene::CreateGeometryPassRecorders(
@@ -218,6 +226,8 @@ void AmbientOcclussionScene::CreateGeometryPassRecorders(
 	ASSERT(tasks.empty());
 	ASSERT(IsDataValid());
 
+	sResourceContainer.WaitForLoading();
+
 	const std::vector<ID3D12Resource*>& textures = sResourceContainer.GetTextures();
 	ASSERT(textures.empty() == false);
 	const Model& model = sResourceContainer.GetModel(UNREAL);
@@ -467,6 +477,8 @@ void AmbientOcclussionScene::CreateIndirectLightingResources(
 	ID3D12Resource* &diffuseIrradianceCubeMap,
 	ID3D12Resource* &specularPreConvolvedCubeMap) noexcept
 {
+	sResourceContainer.WaitForLoading();
+
 	skyBoxCubeMap = &sResourceContainer.GetTexture(SKY_BOX);
 	diffuseIrradianceCubeMap = &sResourceContainer.GetTexture(DIFFUSE_CUBE_MAP);
 	specularPreConvolvedCubeMap = &sResourceContainer.GetTexture(SPECULAR_CUBE_MAP);
@@ -138,6 +138,10 @@ namespace {
 			const Mesh& mesh{ meshes[i] };
 			geomData.mVertexBufferData = mesh.GetVertexBufferData();
 			geomData.mIndexBufferData = mesh.GetIndexBufferData();
+			geomData.mBoundingBox = mesh.GetBoundingBox();
+			geomData.mLods = mesh.GetLods();
+			geomData.mPositionQuantization = mesh.GetPositionQuantization();
+			geomData.mMeshlets = mesh.GetMeshlets();
 			geomData.mWorldMatrices.reserve(numMaterials);
 		}
 
@@ -186,10 +190,10 @@ void ColorHeightScene::Init() noexcept {
 	Scene::Init();
 
 	// Load textures
-	sResourceContainer.LoadTextures(sTexFiles, *mCommandAllocator, *mCommandList);
+	sResourceContainer.LoadTextures(sTexFiles);
 
 	// Load models
-	sResourceContainer.LoadModels(sModelFiles, *mCommandAllocator, *mCommandList);
+	sResourceContainer.LoadModels(sModelFiles);
 }
 
 void ColorHeightScene::CreateGeometryPassRecorders(
@@ -198,6 +202,8 @@ void ColorHeightScene::CreateGeometryPassRecorders(
 	ASSERT(tasks.empty());
 	ASSERT(IsDataValid());
 
+	sResourceContainer.WaitForLoading();
+
 	const std::vector<ID3D12Resource*>& textures = sResourceContainer.GetTextures();
 	ASSERT(textures.empty() == false);
 
@@ -275,6 +281,8 @@ void ColorHeightScene::CreateIndirectLightingResources(
 	ID3D12Resource* &diffuseIrradianceCubeMap,
 	ID3D12Resource* &specularPreConvolvedCubeMap) noexcept
 {
+	sResourceContainer.WaitForLoading();
+
 	skyBoxCubeMap = &sResourceContainer.GetTexture(SKY_BOX);
 	diffuseIrradianceCubeMap = &sResourceContainer.GetTexture(DIFFUSE_CUBE_MAP);
 	specularPreConvolvedCubeMap = &sResourceContainer.GetTexture(SPECULAR_CUBE_MAP);
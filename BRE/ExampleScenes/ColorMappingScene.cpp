@@ -99,6 +99,10 @@ namespace {
 			const Mesh& mesh{ meshes[i] };
 			geomData.mVertexBufferData = mesh.GetVertexBufferData();
 			geomData.mIndexBufferData = mesh.GetIndexBufferData();
+			geomData.mBoundingBox = mesh.GetBoundingBox();
+			geomData.mLods = mesh.GetLods();
+			geomData.mPositionQuantization = mesh.GetPositionQuantization();
+			geomData.mMeshlets = mesh.GetMeshlets();
 			geomData.mWorldMatrices.reserve(numMaterials);
 		}
 
@@ -135,10 +139,10 @@ void ColorMappingScene::Init() noexcept {
 	Scene::Init();
 
 	// Load textures
-	sResourceContainer.LoadTextures(sTexFiles, *mCommandAllocator, *mCommandList);
+	sResourceContainer.LoadTextures(sTexFiles);
 
 	// Load models
-	sResourceContainer.LoadModels(sModelFiles, *mCommandAllocator, *mCommandList);
+	sResourceContainer.LoadModels(sModelFiles);
 }
 
 void ColorMappingScene::CreateGeometryPassRecorders(
@@ -147,6 +151,8 @@ void ColorMappingScene::CreateGeometryPassRecorders(
 	ASSERT(tasks.empty());
 	ASSERT(IsDataValid());
 
+	sResourceContainer.WaitForLoading();
+
 	const Model& model = sResourceContainer.GetModel(BUNNY);
 
 	ColorCmdListRecorder* recorder{ nullptr };
@@ -182,6 +188,8 @@ void ColorMappingScene::CreateIndirectLightingResources(
 	ID3D12Resource* &diffuseIrradianceCubeMap,
 	ID3D12Resource* &specularPreConvolvedCubeMap) noexcept 
 {
+	sResourceContainer.WaitForLoading();
+
 	skyBoxCubeMap = &sResourceContainer.GetTexture(SKY_BOX);
 	diffuseIrradianceCubeMap = &sResourceContainer.GetTexture(DIFFUSE_CUBE_MAP);
 	specularPreConvolvedCubeMap = &sResourceContainer.GetTexture(SPECULAR_CUBE_MAP);
@@ -120,6 +120,10 @@ namespace {
 			const Mesh& mesh{ meshes[i] };
 			geomData.mVertexBufferData = mesh.GetVertexBufferData();
 			geomData.mIndexBufferData = mesh.GetIndexBufferData();
+			geomData.mBoundingBox = mesh.GetBoundingBox();
+			geomData.mLods = mesh.GetLods();
+			geomData.mPositionQuantization = mesh.GetPositionQuantization();
+			geomData.mMeshlets = mesh.GetMeshlets();
 			geomData.mWorldMatrices.reserve(numMaterials);
 		}
 
@@ -165,10 +169,10 @@ void ColorNormalScene::Init() noexcept {
 	Scene::Init();
 
 	// Load textures
-	sResourceContainer.LoadTextures(sTexFiles, *mCommandAllocator, *mCommandList);
+	sResourceContainer.LoadTextures(sTexFiles);
 
 	// Load models
-	sResourceContainer.LoadModels(sModelFiles, *mCommandAllocator, *mCommandList);
+	sResourceContainer.LoadModels(sModelFiles);
 }
 
 void ColorNormalScene::CreateGeometryPassRecorders(
@@ -177,6 +181,8 @@ void ColorNormalScene::CreateGeometryPassRecorders(
 	ASSERT(tasks.empty());
 	ASSERT(IsDataValid());
 
+	sResourceContainer.WaitForLoading();
+
 	const std::vector<ID3D12Resource*>& textures = sResourceContainer.GetTextures();
 	ASSERT(textures.empty() == false);
 
@@ -235,6 +241,8 @@ void ColorNormalScene::CreateIndirectLightingResources(
 	ID3D12Resource* &diffuseIrradianceCubeMap,
 	ID3D12Resource* &specularPreConvolvedCubeMap) noexcept
 {
+	sResourceContainer.WaitForLoading();
+
 	skyBoxCubeMap = &sResourceContainer.GetTexture(SKY_BOX);
 	diffuseIrradianceCubeMap = &sResourceContainer.GetTexture(DIFFUSE_CUBE_MAP);
 	specularPreConvolvedCubeMap = &sResourceContainer.GetTexture(SPECULAR_CUBE_MAP);
@@ -155,6 +155,10 @@ namespace {
 			const Mesh& mesh{ meshes[i] };
 			geomData.mVertexBufferData = mesh.GetVertexBufferData();
 			geomData.mIndexBufferData = mesh.GetIndexBufferData();
+			geomData.mBoundingBox = mesh.GetBoundingBox();
+			geomData.mLods = mesh.GetLods();
+			geomData.mPositionQuantization = mesh.GetPositionQuantization();
+			geomData.mMeshlets = mesh.GetMeshlets();
 			geomData.mWorldMatrices.reserve(numMaterials);
 		}
 
@@ -208,10 +212,10 @@ void HeightScene::Init() noexcept {
 	Scene::Init();
 
 	// Load textures
-	sResourceContainer.LoadTextures(sTexFiles, *mCommandAllocator, *mCommandList);
+	sResourceContainer.LoadTextures(sTexFiles);
 
 	// Load models
-	sResourceContainer.LoadModels(sModelFiles, *mCommandAllocator, *mCommandList);
+	sResourceContainer.LoadModels(sModelFiles);
 }		
 
 void HeightScene::CreateGeometryPassRecorders(
@@ -220,6 +224,8 @@ void HeightScene::CreateGeometryPassRecorders(
 	ASSERT(tasks.empty());
 	ASSERT(IsDataValid());
 
+	sResourceContainer.WaitForLoading();
+
 	const std::vector<ID3D12Resource*>& textures = sResourceContainer.GetTextures();
 	ASSERT(textures.empty() == false);
 
@@ -307,6 +313,8 @@ void HeightScene::CreateIndirectLightingResources(
 	ID3D12Resource* &diffuseIrradianceCubeMap,
 	ID3D12Resource* &specularPreConvolvedCubeMap) noexcept
 {
+	sResourceContainer.WaitForLoading();
+
 	skyBoxCubeMap = &sResourceContainer.GetTexture(SKY_BOX);
 	diffuseIrradianceCubeMap = &sResourceContainer.GetTexture(DIFFUSE_CUBE_MAP);
 	specularPreConvolvedCubeMap = &sResourceContainer.GetTexture(SPECULAR_CUBE_MAP);
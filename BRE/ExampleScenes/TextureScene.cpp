@@ -56,10 +56,10 @@ void TextureScene::Init() noexcept {
 	Scene::Init();
 
 	// Load textures
-	sResourceContainer.LoadTextures(sTexFiles, *mCommandAllocator, *mCommandList);
+	sResourceContainer.LoadTextures(sTexFiles);
 
 	// Load models
-	sResourceContainer.LoadModels(sModelFiles, *mCommandAllocator, *mCommandList);
+	sResourceContainer.LoadModels(sModelFiles);
 }
 
 void TextureScene::CreateGeometryPassRecorders(
@@ -67,6 +67,8 @@ void TextureScene::CreateGeometryPassRecorders(
 	ASSERT(tasks.empty());
 	ASSERT(IsDataValid());
 
+	sResourceContainer.WaitForLoading();
+
 	const std::vector<ID3D12Resource*>& textures = sResourceContainer.GetTextures();
 	ASSERT(textures.empty() == false);
 
@@ -83,6 +85,10 @@ void TextureScene::CreateGeometryPassRecorders(
 	for (GeometryPassCmdListRecorder::GeometryData& geomData : geomDataVec) {
 		geomData.mVertexBufferData = mesh.GetVertexBufferData();
 		geomData.mIndexBufferData = mesh.GetIndexBufferData();
+		geomData.mBoundingBox = mesh.GetBoundingBox();
+		geomData.mLods = mesh.GetLods();
+		geomData.mPositionQuantization = mesh.GetPositionQuantization();
+		geomData.mMeshlets = mesh.GetMeshlets();
 		geomData.mWorldMatrices.reserve(numGeometry);
 	}
 
@@ -181,6 +187,8 @@ void TextureScene::CreateIndirectLightingResources(
 	ID3D12Resource* &diffuseIrradianceCubeMap,
 	ID3D12Resource* &specularPreConvolvedCubeMap) noexcept
 {
+	sResourceContainer.WaitForLoading();
+
 	skyBoxCubeMap = &sResourceContainer.GetTexture(SKY_BOX);
 	diffuseIrradianceCubeMap = &sResourceContainer.GetTexture(DIFFUSE_CUBE_MAP);
 	specularPreConvolvedCubeMap = &sResourceContainer.GetTexture(SPECULAR_CUBE_MAP);
@@ -31,69 +31,73 @@ namespace {
 		DXGI_FORMAT_UNKNOWN
 	};
 
-	void CreateGeometryBuffersAndRenderTargetViews(
+	void CreateGeometryBufferRenderTargetViews(
+		ID3D12Resource* const* geometryBuffers,
 		Microsoft::WRL::ComPtr<ID3D12Resource> buffers[GeometryPass::BUFFERS_COUNT],
 		D3D12_CPU_DESCRIPTOR_HANDLE bufferRenderTargetViews[GeometryPass::BUFFERS_COUNT]) noexcept 
 	{
-		// Set shared buffers properties
-		D3D12_RESOURCE_DESC resourceDescriptor = {};
-		resourceDescriptor.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
-		resourceDescriptor.Alignment = 0U;
-		resourceDescriptor.Width = SettingsManager::sWindowWidth;
-		resourceDescriptor.Height = SettingsManager::sWindowHeight;
-		resourceDescriptor.DepthOrArraySize = 1U;
-		resourceDescriptor.MipLevels = 0U;
-		resourceDescriptor.SampleDesc.Count = 1U;
-		resourceDescriptor.SampleDesc.Quality = 0U;
-		resourceDescriptor.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
-		resourceDescriptor.Flags = D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET;
-
-		D3D12_CLEAR_VALUE clearValue[]
-		{
-			{ DXGI_FORMAT_UNKNOWN, 0.0f, 0.0f, 0.0f, 1.0f },
-			{ DXGI_FORMAT_UNKNOWN, 0.0f, 0.0f, 0.0f, 0.0f },
-		};
-		ASSERT(_countof(clearValue) == GeometryPass::BUFFERS_COUNT);
-
-		buffers[GeometryPass::NORMAL_SMOOTHNESS].Reset();
-		buffers[GeometryPass::BASECOLOR_METALMASK].Reset();
-
-		CD3DX12_HEAP_PROPERTIES heapProps{ D3D12_HEAP_TYPE_DEFAULT };
-		
-		// Create and store render target views
-		const wchar_t* resourceNames[GeometryPass::BUFFERS_COUNT] =
-		{
-			L"Normal_SmoothnessTexture Buffer",
-			L"BaseColor_MetalMaskTexture Buffer"
-		};
-		for (std::uint32_t i = 0U; i < GeometryPass::BUFFERS_COUNT; ++i) {
-			resourceDescriptor.Format = sGeometryBufferFormats[i];
+		ASSERT(geometryBuffers != nullptr);
 
-			clearValue[i].Format = resourceDescriptor.Format;
+		for (std::uint32_t i = 0U; i < GeometryPass::BUFFERS_COUNT; ++i) {
+			ASSERT(geometryBuffers[i] != nullptr);
+			ASSERT(ResourceStateManager::GetResourceState(*geometryBuffers[i]) == D3D12_RESOURCE_STATE_RENDER_TARGET);
 
 			D3D12_RENDER_TARGET_VIEW_DESC rtvDescriptor{};
 			rtvDescriptor.ViewDimension = D3D12_RTV_DIMENSION_TEXTURE2D;
-			rtvDescriptor.Format = resourceDescriptor.Format;
-			ID3D12Resource* resource = &ResourceManager::CreateCommittedResource(
-				heapProps, 
-				D3D12_HEAP_FLAG_NONE, 
-				resourceDescriptor, 
-				D3D12_RESOURCE_STATE_RENDER_TARGET, 
-				&clearValue[i],
-				resourceNames[i]);
-
-			buffers[i] = Microsoft::WRL::ComPtr<ID3D12Resource>(resource);
+			rtvDescriptor.Format = sGeometryBufferFormats[i];
+
+			buffers[i] = Microsoft::WRL::ComPtr<ID3D12Resource>(geometryBuffers[i]);
 			RenderTargetDescriptorManager::CreateRenderTargetView(*buffers[i].Get(), rtvDescriptor, &bufferRenderTargetViews[i]);
 		}
 	}
 }
 
-void GeometryPass::Init(const D3D12_CPU_DESCRIPTOR_HANDLE& depthBufferView) noexcept {
+void GeometryPass::GetBufferDescriptors(
+	D3D12_RESOURCE_DESC* resourceDescriptors,
+	D3D12_CLEAR_VALUE* clearValues) noexcept
+{
+	ASSERT(resourceDescriptors != nullptr);
+	ASSERT(clearValues != nullptr);
+
+	// Set shared buffers properties
+	D3D12_RESOURCE_DESC resourceDescriptor = {};
+	resourceDescriptor.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
+	resourceDescriptor.Alignment = 0U;
+	resourceDescriptor.Width = SettingsManager::sWindowWidth;
+	resourceDescriptor.Height = SettingsManager::sWindowHeight;
+	resourceDescriptor.DepthOrArraySize = 1U;
+	resourceDescriptor.MipLevels = 0U;
+	resourceDescriptor.SampleDesc.Count = 1U;
+	resourceDescriptor.SampleDesc.Quality = 0U;
+	resourceDescriptor.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
+	resourceDescriptor.Flags = D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET;
+
+	const D3D12_CLEAR_VALUE clearValue[]
+	{
+		{ DXGI_FORMAT_UNKNOWN, 0.0f, 0.0f, 0.0f, 1.0f },
+		{ DXGI_FORMAT_UNKNOWN, 0.0f, 0.0f, 0.0f, 0.0f },
+	};
+	ASSERT(_countof(clearValue) == BUFFERS_COUNT);
+
+	for (std::uint32_t i = 0U; i < BUFFERS_COUNT; ++i) {
+		resourceDescriptors[i] = resourceDescriptor;
+		resourceDescriptors[i].Format = sGeometryBufferFormats[i];
+
+		clearValues[i] = clearValue[i];
+		clearValues[i].Format = sGeometryBufferFormats[i];
+	}
+}
+
+void GeometryPass::Init(
+	ID3D12Resource* const* geometryBuffers,
+	const D3D12_CPU_DESCRIPTOR_HANDLE& depthBufferView,
+	UploadRingBuffer& uploadRingBuffer) noexcept 
+{
 	ASSERT(IsDataValid() == false);
 	
 	ASSERT(mCommandListRecorders.empty() == false);
 
-	CreateGeometryBuffersAndRenderTargetViews(mGeometryBuffers, mGeometryBufferRenderTargetViews);
+	CreateGeometryBufferRenderTargetViews(geometryBuffers, mGeometryBuffers, mGeometryBufferRenderTargetViews);
 
 	mDepthBufferView = depthBufferView;
 
@@ -107,33 +111,53 @@ void GeometryPass::Init(const D3D12_CPU_DESCRIPTOR_HANDLE& depthBufferView) noex
 	// Init geometry command list recorders
 	for (CommandListRecorders::value_type& recorder : mCommandListRecorders) {
 		ASSERT(recorder.get() != nullptr);
-		recorder->Init(mGeometryBufferRenderTargetViews, BUFFERS_COUNT, mDepthBufferView);
+		recorder->Init(mGeometryBufferRenderTargetViews, BUFFERS_COUNT, mDepthBufferView, uploadRingBuffer);
 	}
 
 	ASSERT(IsDataValid());
 }
 
-void GeometryPass::Execute(const FrameCBuffer& frameCBuffer) noexcept {
+std::size_t GeometryPass::GetMaxUploadSizePerFrame() const noexcept {
+	ASSERT(mCommandListRecorders.empty() == false);
+
+	std::size_t size{ 0UL };
+	for (const CommandListRecorders::value_type& recorder : mCommandListRecorders) {
+		ASSERT(recorder.get() != nullptr);
+		size += recorder->GetMaxUploadSizePerFrame();
+	}
+
+	return size;
+}
+
+std::uint32_t GeometryPass::Execute(
+	const FrameCBuffer& frameCBuffer,
+	const D3D12_GPU_VIRTUAL_ADDRESS frameCBufferGpuAddress) noexcept 
+{
 	ASSERT(IsDataValid());
 
 	ExecuteBeginTask();
 
 	const std::uint32_t taskCount{ static_cast<std::uint32_t>(mCommandListRecorders.size()) };
-	CommandListExecutor::Get().ResetExecutedCommandListCount();
 
 	// Execute tasks
 	std::uint32_t grainSize{ max(1U, (taskCount) / SettingsManager::sCpuProcessorCount) };
 	tbb::parallel_for(tbb::blocked_range<std::size_t>(0, taskCount, grainSize),
 		[&](const tbb::blocked_range<size_t>& r) {
 		for (size_t i = r.begin(); i != r.end(); ++i)
-			mCommandListRecorders[i]->RecordAndPushCommandLists(frameCBuffer);
+			mCommandListRecorders[i]->RecordAndPushCommandLists(frameCBuffer, frameCBufferGpuAddress);
 	}
 	);
 
-	// Wait until all previous tasks command lists are executed
-	while (CommandListExecutor::Get().GetExecutedCommandListCount() < taskCount) {
-		Sleep(0U);
+	// Update culling statistics
+	mDrawnInstanceCount = 0U;
+	mCulledInstanceCount = 0U;
+	for (const CommandListRecorders::value_type& recorder : mCommandListRecorders) {
+		mDrawnInstanceCount += recorder->GetDrawnInstanceCount();
+		mCulledInstanceCount += recorder->GetCulledInstanceCount();
 	}
+
+	// Begin task command list + 1 command list per recorder
+	return taskCount + 1U;
 }
 
 bool GeometryPass::IsDataValid() const noexcept {
@@ -179,5 +203,5 @@ void GeometryPass::ExecuteBeginTask() noexcept {
 	commandList.ClearDepthStencilView(mDepthBufferView, D3D12_CLEAR_FLAG_DEPTH, 1.0f, 0U, 0U, nullptr);
 
 	CHECK_HR(commandList.Close());
-	CommandListExecutor::Get().ExecuteCommandListAndWaitForCompletion(commandList);
+	CommandListExecutor::Get().AddCommandList(commandList);
 }
\ No newline at end of file
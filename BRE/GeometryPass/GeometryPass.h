@@ -6,7 +6,9 @@
 #include <CommandManager\CommandListPerFrame.h>
 #include <GeometryPass\GeometryPassCmdListRecorder.h>
 
+struct D3D12_CLEAR_VALUE;
 struct D3D12_CPU_DESCRIPTOR_HANDLE;
+struct D3D12_RESOURCE_DESC;
 struct FrameCBuffer;
 struct ID3D12Resource;
 
@@ -32,15 +34,44 @@ public:
 	// You should get recorders and fill them, before calling Init()
 	__forceinline CommandListRecorders& GetCommandListRecorders() noexcept { return mCommandListRecorders; }
 
+	// Fills the descriptors and clear values (BUFFERS_COUNT elements each)
+	// that must be used to create geometry buffers.
+	// Preconditions:
+	// - "resourceDescriptors" must not be nullptr
+	// - "clearValues" must not be nullptr
+	static void GetBufferDescriptors(
+		D3D12_RESOURCE_DESC* resourceDescriptors,
+		D3D12_CLEAR_VALUE* clearValues) noexcept;
+
+	// Geometry buffers are created by the caller (using GetBufferDescriptors()),
+	// as they are transient resources that can share memory with other resources.
 	// Preconditions:
 	// - You should fill recorders with GetCommandListRecorders() before
-	void Init(const D3D12_CPU_DESCRIPTOR_HANDLE& depthBufferView) noexcept;
+	// - "geometryBuffers" must have BUFFERS_COUNT elements in render target state
+	// - "uploadRingBuffer" must have at least GetMaxUploadSizePerFrame() bytes per queued frame
+	void Init(
+		ID3D12Resource* const* geometryBuffers,
+		const D3D12_CPU_DESCRIPTOR_HANDLE& depthBufferView,
+		UploadRingBuffer& uploadRingBuffer) noexcept;
+
+	// Maximum number of bytes that recorders allocate from the upload ring buffer in Execute()
+	// Preconditions:
+	// - You should fill recorders with GetCommandListRecorders() before
+	std::size_t GetMaxUploadSizePerFrame() const noexcept;
 	
 	__forceinline Microsoft::WRL::ComPtr<ID3D12Resource>* GetGeometryBuffers() noexcept { return mGeometryBuffers; }
 	
+	// Returns the number of command lists pushed to CommandListExecutor.
+	// It does not wait for them to be executed.
 	// Preconditions:
 	// - Init() must be called first
-	void Execute(const FrameCBuffer& frameCBuffer) noexcept;
+	std::uint32_t Execute(
+		const FrameCBuffer& frameCBuffer,
+		const D3D12_GPU_VIRTUAL_ADDRESS frameCBufferGpuAddress) noexcept;
+
+	// Number of instances drawn or culled by all the recorders in the last Execute() call
+	__forceinline std::uint32_t GetDrawnInstanceCount() const noexcept { return mDrawnInstanceCount; }
+	__forceinline std::uint32_t GetCulledInstanceCount() const noexcept { return mCulledInstanceCount; }
 
 private:
 	// Method used internally for validation purposes
@@ -57,4 +88,7 @@ private:
 	D3D12_CPU_DESCRIPTOR_HANDLE mDepthBufferView{ 0UL };
 		
 	CommandListRecorders mCommandListRecorders;
+
+	std::uint32_t mDrawnInstanceCount{ 0U };
+	std::uint32_t mCulledInstanceCount{ 0U };
 };
@@ -1,29 +1,92 @@
 #include "GeometryPassCmdListRecorder.h"
 
+#include <algorithm>
+
+#include <DescriptorManager\CbvSrvUavDescriptorManager.h>
+#include <GeometryPass/LodSelector.h>
+#include <GeometryPass/MeshletCuller.h>
+#include <MaterialManager/Material.h>
+#include <MathUtils/FrustumCulling.h>
+#include <MathUtils/MathUtils.h>
+#include <ResourceManager/ResourceManager.h>
+#include <ResourceManager/UploadBufferManager.h>
 #include <ShaderUtils\CBuffers.h>
 #include <Utils/DebugUtils.h>
 
+using namespace DirectX;
+
+namespace {
+	// Batches whose visible meshlets need more index ranges than this draw their
+	// whole level of detail, as the cost of the draw calls exceeds the saved triangles.
+	const std::uint32_t sMaxMeshletDrawCallCount{ 16U };
+
+	// Meshlets are culled in object space, so instances whose
+	// world matrix has non uniform scale cannot cull them.
+	bool HasUniformScale(const XMMATRIX& worldMatrix) noexcept {
+		const float scaleX{ XMVectorGetX(XMVector3Length(worldMatrix.r[0U])) };
+		const float scaleY{ XMVectorGetX(XMVector3Length(worldMatrix.r[1U])) };
+		const float scaleZ{ XMVectorGetX(XMVector3Length(worldMatrix.r[2U])) };
+		const float maxScale{ std::max<float>(std::max<float>(scaleX, scaleY), scaleZ) };
+		const float minScale{ std::min<float>(std::min<float>(scaleX, scaleY), scaleZ) };
+
+		return minScale > 0.0f && maxScale <= minScale * 1.001f;
+	}
+}
+
 bool GeometryPassCmdListRecorder::IsDataValid() const noexcept {
 	const std::size_t geometryDataCount{ mGeometryDataVec.size() };
 	for (std::size_t i = 0UL; i < geometryDataCount; ++i) {
 		const std::size_t numMatrices{ mGeometryDataVec[i].mWorldMatrices.size() };
-		if (numMatrices == 0UL) {
+		if (numMatrices == 0UL || mGeometryDataVec[i].mLods.size() > sMaxMeshLodCount) {
 			return false;
 		}
 	}
 
 	return
-		mObjectUploadCBuffers != nullptr &&
-		mStartObjectCBufferView.ptr != 0UL &&
+		mWorldBoundingSpheres.empty() == false &&
+		mWorldBoundingSpheres.size() == mInstanceVisibilityFlags.size() &&
+		mWorldBoundingSpheres.size() == mInstanceLodIndices.size() &&
+		mWorldBoundingSpheres.size() == mInstanceFirstIndexRanges.size() &&
+		mWorldBoundingSpheres.size() == mInstanceIndexRangeCounts.size() &&
+		mMeshletBoundsPerGeometryData.size() == geometryDataCount &&
+		mInstances.size() == mWorldBoundingSpheres.size() &&
+		mPackedInstances.size() == mInstances.size() &&
+		mPackedInstanceIndices.size() == mInstances.size() &&
+		mInstanceCountPerGeometryData.size() == geometryDataCount &&
 		geometryDataCount != 0UL &&
-		mMaterialUploadCBuffers != nullptr &&
-		mStartMaterialCBufferView.ptr != 0UL;
+		mMaterialUploadBuffer != nullptr;
+}
+
+GeometryPassCmdListRecorder::~GeometryPassCmdListRecorder() {
+	if (mTextureDescriptorTables.empty()) {
+		return;
+	}
+
+	// Streamed textures must not update the views once they are reused
+	const std::uint32_t instanceCount{
+		static_cast<std::uint32_t>(mInstanceStreamedTextureIds.size() / mTextureDescriptorTables.size()) };
+	const std::uint64_t fenceValue{ CbvSrvUavDescriptorManager::GetFrameFenceValue() };
+	for (std::size_t i = 0UL; i < mTextureDescriptorTables.size(); ++i) {
+		const std::uint32_t firstTextureViewIndex{
+			CbvSrvUavDescriptorManager::GetDescriptorIndex(mTextureDescriptorTables[i]) };
+		for (std::uint32_t j = 0U; j < instanceCount; ++j) {
+			const std::uint32_t textureId{ mInstanceStreamedTextureIds[i * instanceCount + j] };
+			if (textureId != TextureStreamer::sInvalidTextureId) {
+				TextureStreamer::RemoveShaderResourceView(
+					textureId,
+					CbvSrvUavDescriptorManager::GetGpuDescriptorHandle(firstTextureViewIndex + j));
+			}
+		}
+
+		CbvSrvUavDescriptorManager::DestroyViews(mTextureDescriptorTables[i], instanceCount, fenceValue);
+	}
 }
 
 void GeometryPassCmdListRecorder::Init(
 	const D3D12_CPU_DESCRIPTOR_HANDLE* geometryBufferRenderTargetViews,
 	const std::uint32_t geometryBufferRenderTargetViewCount,
-	const D3D12_CPU_DESCRIPTOR_HANDLE& depthBufferView) noexcept
+	const D3D12_CPU_DESCRIPTOR_HANDLE& depthBufferView,
+	UploadRingBuffer& uploadRingBuffer) noexcept
 {
 	ASSERT(geometryBufferRenderTargetViews != nullptr);
 	ASSERT(geometryBufferRenderTargetViewCount != 0U);
@@ -32,4 +95,385 @@ void GeometryPassCmdListRecorder::Init(
 	mGeometryBufferRenderTargetViews = geometryBufferRenderTargetViews;
 	mGeometryBufferRenderTargetViewCount = geometryBufferRenderTargetViewCount;
 	mDepthBufferView = depthBufferView;
+	mUploadRingBuffer = &uploadRingBuffer;
+}
+
+std::size_t GeometryPassCmdListRecorder::GetMaxUploadSizePerFrame() const noexcept {
+	// All the instances are visible in the worst case
+	return RingBufferAllocator::GetAlignedSize(sizeof(InstanceData) * mInstances.size());
+}
+
+void GeometryPassCmdListRecorder::InitWorldBoundingSpheres() noexcept {
+	ASSERT(mGeometryDataVec.empty() == false);
+	ASSERT(mWorldBoundingSpheres.empty());
+
+	const std::size_t geometryDataCount{ mGeometryDataVec.size() };
+	for (std::size_t i = 0UL; i < geometryDataCount; ++i) {
+		const GeometryData& geometryData{ mGeometryDataVec[i] };
+		BoundingSphere objectSpaceSphere;
+		BoundingSphere::CreateFromBoundingBox(objectSpaceSphere, geometryData.mBoundingBox);
+
+		mMeshletBoundsPerGeometryData.emplace_back();
+		MeshletCuller::InitMeshletBounds(
+			geometryData.mMeshlets.data(), 
+			geometryData.mMeshlets.size(), 
+			mMeshletBoundsPerGeometryData.back());
+
+		const std::size_t worldMatrixCount{ geometryData.mWorldMatrices.size() };
+		for (std::size_t j = 0UL; j < worldMatrixCount; ++j) {
+			BoundingSphere worldSpaceSphere;
+			objectSpaceSphere.Transform(worldSpaceSphere, XMLoadFloat4x4(&geometryData.mWorldMatrices[j]));
+			mWorldBoundingSpheres.push_back(worldSpaceSphere);
+		}
+	}
+
+	// All instances are visible until the first culling
+	mInstanceVisibilityFlags.resize(mWorldBoundingSpheres.size(), 1U);
+	mInstanceLodIndices.resize(mWorldBoundingSpheres.size(), 0U);
+	mInstanceFirstIndexRanges.resize(mWorldBoundingSpheres.size(), 0U);
+	mInstanceIndexRangeCounts.resize(mWorldBoundingSpheres.size(), 0U);
+}
+
+void GeometryPassCmdListRecorder::UpdateInstanceVisibility(const FrameCBuffer& frameCBuffer) noexcept {
+	ASSERT(mWorldBoundingSpheres.empty() == false);
+	ASSERT(mWorldBoundingSpheres.size() == mInstanceVisibilityFlags.size());
+
+	// Frame constant buffer matrices are transposed to be used in shaders
+	XMFLOAT4X4 viewMatrix;
+	XMStoreFloat4x4(&viewMatrix, MathUtils::GetTransposeMatrix(frameCBuffer.mViewMatrix));
+	XMFLOAT4X4 projectionMatrix;
+	XMStoreFloat4x4(&projectionMatrix, MathUtils::GetTransposeMatrix(frameCBuffer.mProjectionMatrix));
+
+	FrustumCulling::FrustumPlanes frustumPlanes;
+	FrustumCulling::ExtractFrustumPlanes(viewMatrix, projectionMatrix, frustumPlanes);
+
+	const std::uint32_t instanceCount{ static_cast<std::uint32_t>(mWorldBoundingSpheres.size()) };
+	mDrawnInstanceCount = FrustumCulling::CullSpheres(
+		frustumPlanes,
+		mWorldBoundingSpheres.data(),
+		instanceCount,
+		mInstanceVisibilityFlags.data());
+	mCulledInstanceCount = instanceCount - mDrawnInstanceCount;
+
+	// Select the level of detail of visible instances, and request their streamed textures
+	const XMFLOAT3 eyePosition{ 
+		frameCBuffer.mEyeWorldPosition.x, 
+		frameCBuffer.mEyeWorldPosition.y, 
+		frameCBuffer.mEyeWorldPosition.z };
+	const float screenHeight{ static_cast<float>(SettingsManager::sWindowHeight) };
+	const float screenPixelCount{ static_cast<float>(SettingsManager::sWindowWidth) * screenHeight };
+	mStreamedTextureRequests.clear();
+	std::uint32_t instanceIndex{ 0U };
+	const std::size_t geometryDataCount{ mGeometryDataVec.size() };
+	for (std::size_t i = 0UL; i < geometryDataCount; ++i) {
+		const GeometryData& geometryData{ mGeometryDataVec[i] };
+		const std::uint32_t lodCount{ static_cast<std::uint32_t>(geometryData.mLods.size()) };
+		const std::uint32_t worldMatrixCount{ static_cast<std::uint32_t>(geometryData.mWorldMatrices.size()) };
+		for (std::uint32_t j = 0U; j < worldMatrixCount; ++j, ++instanceIndex) {
+			mInstanceLodIndices[instanceIndex] = 0U;
+			if ((lodCount < 2U && mHasStreamedTextures == false) || mInstanceVisibilityFlags[instanceIndex] == 0U) {
+				continue;
+			}
+
+			const BoundingSphere& sphere{ mWorldBoundingSpheres[instanceIndex] };
+			const float projectedSphereRadius{ 
+				LodSelector::ComputeProjectedSphereRadius(
+					sphere.Center, 
+					sphere.Radius, 
+					eyePosition, 
+					projectionMatrix(1, 1), 
+					screenHeight) };
+			if (lodCount >= 2U) {
+				mInstanceLodIndices[instanceIndex] = static_cast<std::uint8_t>(
+					LodSelector::SelectLod(geometryData.mLods.data(), lodCount, projectedSphereRadius));
+			}
+
+			if (mHasStreamedTextures) {
+				// Textures are expected to cover the geometry once, so they cover the projected bounding sphere
+				const float coveredPixelCount{ 
+					std::min<float>(MathUtils::Pi * projectedSphereRadius * projectedSphereRadius, screenPixelCount) };
+				for (std::size_t k = instanceIndex; k < mInstanceStreamedTextureIds.size(); k += instanceCount) {
+					if (mInstanceStreamedTextureIds[k] != TextureStreamer::sInvalidTextureId) {
+						TextureStreamer::Request request;
+						request.mTextureId = mInstanceStreamedTextureIds[k];
+						request.mCoveredPixelCount = coveredPixelCount;
+						mStreamedTextureRequests.push_back(request);
+					}
+				}
+			}
+		}
+	}
+
+	if (mStreamedTextureRequests.empty() == false) {
+		TextureStreamer::RequestTextures(
+			mStreamedTextureRequests.data(), 
+			static_cast<std::uint32_t>(mStreamedTextureRequests.size()));
+	}
+
+	// Textures of instances that are not visible are not used, so they can be evicted
+	mUsedTextures.clear();
+	const std::size_t instanceTextureCount{ mInstanceTextures.size() };
+	for (std::size_t k = 0UL; k < instanceTextureCount; ++k) {
+		if (mInstanceTextures[k] != nullptr && mInstanceVisibilityFlags[k % instanceCount] != 0U) {
+			mUsedTextures.push_back(mInstanceTextures[k]);
+		}
+	}
+
+	if (mUsedTextures.empty() == false) {
+		ResourceManager::MarkResourcesUsed(
+			mUsedTextures.data(), 
+			static_cast<std::uint32_t>(mUsedTextures.size()));
+	}
+
+	UpdateInstanceIndexRanges(frustumPlanes, eyePosition);
+}
+
+void GeometryPassCmdListRecorder::UpdateInstanceIndexRanges(
+	const FrustumCulling::FrustumPlanes& frustumPlanes,
+	const XMFLOAT3& eyePosition) noexcept
+{
+	mInstanceIndexRanges.clear();
+
+	const XMVECTOR worldEyePosition = XMLoadFloat3(&eyePosition);
+	std::uint32_t instanceIndex{ 0U };
+	const std::size_t geometryDataCount{ mGeometryDataVec.size() };
+	for (std::size_t i = 0UL; i < geometryDataCount; ++i) {
+		const GeometryData& geometryData{ mGeometryDataVec[i] };
+		const MeshletCuller::MeshletBounds& meshletBounds{ mMeshletBoundsPerGeometryData[i] };
+		const std::uint32_t worldMatrixCount{ static_cast<std::uint32_t>(geometryData.mWorldMatrices.size()) };
+		if (geometryData.mMeshlets.empty()) {
+			std::fill_n(mInstanceIndexRangeCounts.begin() + instanceIndex, worldMatrixCount, 0U);
+			instanceIndex += worldMatrixCount;
+			continue;
+		}
+
+		mMeshletVisibilityFlags.resize(geometryData.mMeshlets.size());
+		for (std::uint32_t j = 0U; j < worldMatrixCount; ++j, ++instanceIndex) {
+			mInstanceFirstIndexRanges[instanceIndex] = static_cast<std::uint32_t>(mInstanceIndexRanges.size());
+			mInstanceIndexRangeCounts[instanceIndex] = 0U;
+
+			const XMMATRIX worldMatrix = XMLoadFloat4x4(&geometryData.mWorldMatrices[j]);
+			if (mInstanceVisibilityFlags[instanceIndex] == 0U ||
+				mInstanceLodIndices[instanceIndex] != 0U ||
+				HasUniformScale(worldMatrix) == false) {
+				continue;
+			}
+
+			// Transform frustum planes and eye position to object space. Planes are 
+			// transformed by the inverse transpose of the inverse world matrix.
+			const XMMATRIX transposedWorldMatrix = XMMatrixTranspose(worldMatrix);
+			XMFLOAT4 objectSpacePlanes[FrustumCulling::PLANES_COUNT];
+			for (std::uint32_t k = 0U; k < FrustumCulling::PLANES_COUNT; ++k) {
+				const XMVECTOR plane = XMPlaneTransform(XMLoadFloat4(&frustumPlanes.mPlanes[k]), transposedWorldMatrix);
+				XMStoreFloat4(&objectSpacePlanes[k], XMPlaneNormalize(plane));
+			}
+
+			const XMMATRIX inverseWorldMatrix = XMMatrixInverse(nullptr, worldMatrix);
+			XMFLOAT3 objectSpaceEyePosition;
+			XMStoreFloat3(&objectSpaceEyePosition, XMVector3TransformCoord(worldEyePosition, inverseWorldMatrix));
+
+			const std::uint32_t visibleMeshletCount = MeshletCuller::CullMeshlets(
+				meshletBounds,
+				objectSpacePlanes,
+				objectSpaceEyePosition,
+				mMeshletVisibilityFlags.data());
+			if (visibleMeshletCount == 0U) {
+				mInstanceVisibilityFlags[instanceIndex] = 0U;
+				--mDrawnInstanceCount;
+				++mCulledInstanceCount;
+				continue;
+			}
+
+			mInstanceIndexRangeCounts[instanceIndex] = MeshletCuller::AppendIndexRanges(
+				meshletBounds,
+				mMeshletVisibilityFlags.data(),
+				mInstanceIndexRanges);
+		}
+	}
+}
+
+void GeometryPassCmdListRecorder::RegisterStreamedTextures(
+	ID3D12Resource* const* textures,
+	const std::uint32_t textureCount,
+	const D3D12_GPU_DESCRIPTOR_HANDLE firstTextureView) noexcept
+{
+	ASSERT(mGeometryDataVec.empty() == false);
+	ASSERT(textures != nullptr);
+
+	std::uint32_t instanceCount{ 0U };
+	for (const GeometryData& geometryData : mGeometryDataVec) {
+		instanceCount += static_cast<std::uint32_t>(geometryData.mWorldMatrices.size());
+	}
+	ASSERT(textureCount == instanceCount);
+
+	const std::uint32_t firstTextureViewIndex{ CbvSrvUavDescriptorManager::GetDescriptorIndex(firstTextureView) };
+	for (std::uint32_t i = 0U; i < textureCount; ++i) {
+		ASSERT(textures[i] != nullptr);
+		const std::uint32_t textureId{ TextureStreamer::GetTextureId(*textures[i]) };
+		if (textureId != TextureStreamer::sInvalidTextureId) {
+			TextureStreamer::AddShaderResourceView(
+				textureId, 
+				CbvSrvUavDescriptorManager::GetGpuDescriptorHandle(firstTextureViewIndex + i));
+			mHasStreamedTextures = true;
+		}
+		mInstanceStreamedTextureIds.push_back(textureId);
+		mInstanceTextures.push_back(textureId == TextureStreamer::sInvalidTextureId ? textures[i] : nullptr);
+	}
+	mTextureDescriptorTables.push_back(firstTextureView);
+}
+
+void GeometryPassCmdListRecorder::InitInstanceAndMaterialBuffers(const Material* materials, const std::uint32_t materialCount) noexcept {
+	ASSERT(mGeometryDataVec.empty() == false);
+	ASSERT(materials != nullptr);
+	ASSERT(materialCount != 0U);
+	ASSERT(mInstances.empty());
+	ASSERT(mMaterialUploadBuffer == nullptr);
+
+	// Build instance data. World matrices are concatenated to the positions dequantization
+	// and transposed to be used in shaders, and each instance uses the material (and textures) with its same index.
+	mInstances.reserve(materialCount);
+	const std::size_t geometryDataCount{ mGeometryDataVec.size() };
+	mInstanceCountPerGeometryData.reserve(geometryDataCount);
+	InstanceData instanceData;
+	for (std::size_t i = 0UL; i < geometryDataCount; ++i) {
+		const GeometryData& geometryData{ mGeometryDataVec[i] };
+		const VertexCompressor::PositionQuantization& positionQuantization = geometryData.mPositionQuantization;
+		const XMMATRIX dequantizationMatrix = 
+			XMMatrixScaling(positionQuantization.mScale, positionQuantization.mScale, positionQuantization.mScale) *
+			XMMatrixTranslation(positionQuantization.mOffset.x, positionQuantization.mOffset.y, positionQuantization.mOffset.z);
+		const std::uint32_t worldMatrixCount{ static_cast<std::uint32_t>(geometryData.mWorldMatrices.size()) };
+		for (std::uint32_t j = 0U; j < worldMatrixCount; ++j) {
+			const XMMATRIX worldMatrix = 
+				XMMatrixTranspose(dequantizationMatrix * XMLoadFloat4x4(&geometryData.mWorldMatrices[j]));
+			XMStoreFloat4x4(&instanceData.mWorldMatrix, worldMatrix);
+			instanceData.mMaterialIndex = static_cast<std::uint32_t>(mInstances.size());
+			mInstances.push_back(instanceData);
+		}
+
+		mInstanceCountPerGeometryData.push_back(worldMatrixCount);
+	}
+	ASSERT(mInstances.size() == materialCount);
+	mPackedInstances.resize(mInstances.size());
+	mPackedInstanceIndices.resize(mInstances.size());
+
+	// Materials do not change, so a single structured buffer is enough
+	mMaterialUploadBuffer = &UploadBufferManager::CreateUploadBuffer(sizeof(Material), materialCount);
+	for (std::uint32_t i = 0U; i < materialCount; ++i) {
+		mMaterialUploadBuffer->CopyData(i, &materials[i], sizeof(Material));
+	}
+}
+
+void GeometryPassCmdListRecorder::RecordInstancedDrawCalls(
+	ID3D12GraphicsCommandList& commandList,
+	const std::uint32_t instanceBufferRootParameterIndex) noexcept
+{
+	ASSERT(mInstances.empty() == false);
+	ASSERT(mInstances.size() == mInstanceVisibilityFlags.size());
+	ASSERT(mUploadRingBuffer != nullptr);
+
+	const std::uint32_t packedInstanceCount = InstanceBatchBuilder::PackVisibleInstances(
+		mInstanceVisibilityFlags.data(),
+		mInstanceLodIndices.data(),
+		mInstanceCountPerGeometryData.data(),
+		static_cast<std::uint32_t>(mInstanceCountPerGeometryData.size()),
+		mPackedInstanceIndices.data(),
+		mInstanceBatches);
+	if (packedInstanceCount == 0U) {
+		return;
+	}
+
+	for (std::uint32_t i = 0U; i < packedInstanceCount; ++i) {
+		mPackedInstances[i] = mInstances[mPackedInstanceIndices[i]];
+	}
+
+	// SV_InstanceID does not include the start instance location,
+	// so we offset the instance buffer address of each batch instead.
+	const D3D12_GPU_VIRTUAL_ADDRESS instanceBufferGpuAddress{ 
+		mUploadRingBuffer->CopyData(mPackedInstances.data(), sizeof(InstanceData) * packedInstanceCount) };
+	// Geometry of the same vertex and index buffer pools is drawn without binding buffers again
+	D3D12_GPU_VIRTUAL_ADDRESS boundVertexBufferLocation{ 0UL };
+	D3D12_GPU_VIRTUAL_ADDRESS boundIndexBufferLocation{ 0UL };
+	const std::size_t batchCount{ mInstanceBatches.size() };
+	for (std::size_t i = 0UL; i < batchCount; ++i) {
+		const InstanceBatchBuilder::InstanceBatch& batch{ mInstanceBatches[i] };
+		GeometryData& geomData{ mGeometryDataVec[batch.mGeometryDataIndex] };
+		if (geomData.mVertexBufferData.mBufferView.BufferLocation != boundVertexBufferLocation) {
+			commandList.IASetVertexBuffers(0U, 1U, &geomData.mVertexBufferData.mBufferView);
+			boundVertexBufferLocation = geomData.mVertexBufferData.mBufferView.BufferLocation;
+		}
+		if (geomData.mIndexBufferData.mBufferView.BufferLocation != boundIndexBufferLocation) {
+			commandList.IASetIndexBuffer(&geomData.mIndexBufferData.mBufferView);
+			boundIndexBufferLocation = geomData.mIndexBufferData.mBufferView.BufferLocation;
+		}
+
+		if (batch.mLodIndex == 0U && geomData.mMeshlets.empty() == false) {
+			RecordMeshletDrawCalls(commandList, instanceBufferRootParameterIndex, instanceBufferGpuAddress, batch);
+			continue;
+		}
+
+		commandList.SetGraphicsRootShaderResourceView(
+			instanceBufferRootParameterIndex, 
+			instanceBufferGpuAddress + batch.mFirstInstance * sizeof(InstanceData));
+
+		// Buffers can be ranges of vertex and index buffer pools
+		const std::uint32_t startIndex{ geomData.mIndexBufferData.mStartIndex };
+		const std::int32_t baseVertex{ static_cast<std::int32_t>(geomData.mVertexBufferData.mBaseVertex) };
+		if (geomData.mLods.empty()) {
+			commandList.DrawIndexedInstanced(
+				geomData.mIndexBufferData.mElementCount, batch.mInstanceCount, startIndex, baseVertex, 0U);
+		} else {
+			const MeshLod& lod{ geomData.mLods[batch.mLodIndex] };
+			commandList.DrawIndexedInstanced(
+				lod.mIndexCount, batch.mInstanceCount, startIndex + lod.mFirstIndex, baseVertex, 0U);
+		}
+	}
+}
+
+void GeometryPassCmdListRecorder::RecordMeshletDrawCalls(
+	ID3D12GraphicsCommandList& commandList,
+	const std::uint32_t instanceBufferRootParameterIndex,
+	const D3D12_GPU_VIRTUAL_ADDRESS instanceBufferGpuAddress,
+	const InstanceBatchBuilder::InstanceBatch& batch) noexcept
+{
+	const GeometryData& geomData{ mGeometryDataVec[batch.mGeometryDataIndex] };
+	const MeshLod& lod{ geomData.mLods[0U] };
+	const std::uint32_t startIndex{ geomData.mIndexBufferData.mStartIndex };
+	const std::int32_t baseVertex{ static_cast<std::int32_t>(geomData.mVertexBufferData.mBaseVertex) };
+	commandList.SetGraphicsRootShaderResourceView(
+		instanceBufferRootParameterIndex,
+		instanceBufferGpuAddress + batch.mFirstInstance * sizeof(InstanceData));
+
+	// Steps:
+	// - Gather the index ranges of all the instances of the batch. An instance without 
+	//   index ranges (it was not meshlet culled) needs the whole level of detail.
+	// - Merge them, so all the instances draw the union of their visible meshlets.
+	// - Draw each merged range instanced, or the whole level of detail if there are too many.
+	mBatchIndexRanges.clear();
+	bool drawsWholeLod{ false };
+	for (std::uint32_t i = 0U; i < batch.mInstanceCount; ++i) {
+		const std::uint32_t instanceIndex{ mPackedInstanceIndices[batch.mFirstInstance + i] };
+		const std::uint32_t indexRangeCount{ mInstanceIndexRangeCounts[instanceIndex] };
+		if (indexRangeCount == 0U) {
+			drawsWholeLod = true;
+			break;
+		}
+
+		const auto firstIndexRange = mInstanceIndexRanges.cbegin() + mInstanceFirstIndexRanges[instanceIndex];
+		mBatchIndexRanges.insert(mBatchIndexRanges.end(), firstIndexRange, firstIndexRange + indexRangeCount);
+	}
+
+	if (drawsWholeLod == false) {
+		drawsWholeLod = MeshletCuller::MergeIndexRanges(0UL, mBatchIndexRanges) > sMaxMeshletDrawCallCount;
+	}
+
+	if (drawsWholeLod) {
+		commandList.DrawIndexedInstanced(
+			lod.mIndexCount, batch.mInstanceCount, startIndex + lod.mFirstIndex, baseVertex, 0U);
+		return;
+	}
+
+	for (const MeshletCuller::IndexRange& indexRange : mBatchIndexRanges) {
+		commandList.DrawIndexedInstanced(
+			indexRange.mIndexCount, batch.mInstanceCount, startIndex + indexRange.mFirstIndex, baseVertex, 0U);
+	}
 }
@@ -1,14 +1,25 @@
 #pragma once
 
 #include <d3d12.h>
+#include <DirectXCollision.h>
 #include <DirectXMath.h>
 
 #include <CommandManager\CommandListPerFrame.h>
 #include <DXUtils/D3DFactory.h>
-#include <ResourceManager\FrameUploadCBufferPerFrame.h>
+#include <GeometryPass/InstanceBatchBuilder.h>
+#include <GeometryPass/MeshletCuller.h>
+#include <MathUtils/FrustumCulling.h>
+#include <ModelManager/Meshlet.h>
+#include <ModelManager/MeshLod.h>
+#include <ModelManager/VertexCompressor.h>
+#include <ResourceManager\UploadBuffer.h>
+#include <ResourceManager\UploadRingBuffer.h>
+#include <ResourceManager/TextureStreamer.h>
 #include <ResourceManager/VertexAndIndexBufferCreator.h>
+#include <SettingsManager\SettingsManager.h>
+#include <ShaderUtils\CBuffers.h>
 
-struct FrameCBuffer;
+struct Material;
 
 // To record command lists for deferred shading geometry pass.
 // Steps:
@@ -22,33 +33,138 @@ public:
 		VertexAndIndexBufferCreator::VertexBufferData mVertexBufferData;
 		VertexAndIndexBufferCreator::IndexBufferData mIndexBufferData;
 		std::vector<DirectX::XMFLOAT4X4> mWorldMatrices;
+
+		// Object space bounding box of the geometry (see Mesh::GetBoundingBox()).
+		// It is used to build world space bounding spheres for frustum culling.
+		DirectX::BoundingBox mBoundingBox;
+
+		// Levels of detail in the index buffer (see Mesh::GetLods()).
+		// If it is empty, the whole index buffer is drawn.
+		std::vector<MeshLod> mLods;
+
+		// Meshlets of the full detail level of detail (see Mesh::GetMeshlets()).
+		// If it is empty, meshlets are not culled.
+		std::vector<Meshlet> mMeshlets;
+
+		// Vertex buffer positions dequantization (see Mesh::GetPositionQuantization()).
+		// It is concatenated with the world matrices of the instances.
+		VertexCompressor::PositionQuantization mPositionQuantization;
 	};
 
 	GeometryPassCmdListRecorder() = default;
-	virtual ~GeometryPassCmdListRecorder() {}
+
+	// Destroys the texture descriptor tables registered by RegisterStreamedTextures()
+	virtual ~GeometryPassCmdListRecorder();
 
 	GeometryPassCmdListRecorder(const GeometryPassCmdListRecorder&) = delete;
 	const GeometryPassCmdListRecorder& operator=(const GeometryPassCmdListRecorder&) = delete;
 	GeometryPassCmdListRecorder(GeometryPassCmdListRecorder&&) = default;
 	GeometryPassCmdListRecorder& operator=(GeometryPassCmdListRecorder&&) = default;
 
+	// Visible instances data is uploaded to "uploadRingBuffer" every frame.
 	// Preconditions:
 	// - "geometryBufferRenderTargetViews" must not be nullptr
 	// - "geometryBufferRenderTargetViewCount" must be greater than zero
 	void Init(
 		const D3D12_CPU_DESCRIPTOR_HANDLE* geometryBufferRenderTargetViews,
 		const std::uint32_t geometryBufferRenderTargetViewCount,
-		const D3D12_CPU_DESCRIPTOR_HANDLE& depthBufferView) noexcept;
+		const D3D12_CPU_DESCRIPTOR_HANDLE& depthBufferView,
+		UploadRingBuffer& uploadRingBuffer) noexcept;
 		
+	// "frameCBuffer" is used for culling and "frameCBufferGpuAddress" 
+	// is the GPU address of the same data for shaders.
 	// Preconditions:
 	// - Init() must be called before
-	virtual void RecordAndPushCommandLists(const FrameCBuffer& frameCBuffer) noexcept = 0;
+	virtual void RecordAndPushCommandLists(
+		const FrameCBuffer& frameCBuffer,
+		const D3D12_GPU_VIRTUAL_ADDRESS frameCBufferGpuAddress) noexcept = 0;
 
 	// This method validates all data (nullptr's, etc)
 	// When you inherit from this class, you should reimplement it to include
 	// new members
 	virtual bool IsDataValid() const noexcept;
 
+	// Number of instances (world matrices) that were drawn or culled
+	// in the last call to RecordAndPushCommandLists()
+	__forceinline std::uint32_t GetDrawnInstanceCount() const noexcept { return mDrawnInstanceCount; }
+	__forceinline std::uint32_t GetCulledInstanceCount() const noexcept { return mCulledInstanceCount; }
+
+	// Maximum number of bytes that RecordAndPushCommandLists() allocates from the upload ring buffer
+	std::size_t GetMaxUploadSizePerFrame() const noexcept;
+
+protected:
+	// Computes world space bounding spheres of all the instances.
+	// World matrices do not change across frames, then it should be called once,
+	// after filling mGeometryDataVec.
+	// Preconditions:
+	// - mGeometryDataVec must not be empty
+	void InitWorldBoundingSpheres() noexcept;
+
+	// Culls all the instances against the frustum built from "frameCBuffer" 
+	// view and projection matrices and updates mInstanceVisibilityFlags and the counters.
+	// It also selects the level of detail of each visible instance (mInstanceLodIndices)
+	// from the projected size of its bounding sphere, and culls the meshlets of the visible
+	// instances that use the full detail level of detail (mInstanceIndexRanges).
+	// Streamed textures of visible instances (see RegisterStreamedTextures()) are requested
+	// with the screen area of the bounding sphere of the instance, and their other textures
+	// are marked as used (see ResourceManager::MarkResourcesUsed()).
+	// Instances follow mGeometryDataVec order (and world matrices order inside it)
+	// Preconditions:
+	// - InitWorldBoundingSpheres() must be called before
+	void UpdateInstanceVisibility(const FrameCBuffer& frameCBuffer) noexcept;
+
+	// Builds instance data (world matrices and material indices) from mGeometryDataVec
+	// and creates the materials structured buffer.
+	// Instance i (in mGeometryDataVec order) uses materials[i] and the i-th
+	// descriptor of each texture descriptor table.
+	// Preconditions:
+	// - mGeometryDataVec must not be empty
+	// - "materials" must not be nullptr
+	// - "materialCount" must be equal to the total number of instances
+	void InitInstanceAndMaterialBuffers(const Material* materials, const std::uint32_t materialCount) noexcept;
+
+	// Registers a texture descriptor table that starts at "firstTextureView", with a view of "textures[i]"
+	// for instance i. Views of streamed textures (see TextureStreamer) are updated when their mips change,
+	// and their textures are requested every frame by UpdateInstanceVisibility(). Other textures
+	// are marked as used every frame that their instances are visible.
+	// The recorder owns the table: its views are destroyed when the recorder is destroyed.
+	// Preconditions:
+	// - mGeometryDataVec must not be empty
+	// - "textures" must not be nullptr
+	// - "textureCount" must be equal to the total number of instances
+	void RegisterStreamedTextures(
+		ID3D12Resource* const* textures,
+		const std::uint32_t textureCount,
+		const D3D12_GPU_DESCRIPTOR_HANDLE firstTextureView) noexcept;
+
+	// Packs the visible instances (see UpdateInstanceVisibility()), uploads them
+	// to the upload ring buffer and records a DrawIndexedInstanced() per geometry data and level of detail with visible instances.
+	// Batches of instances with culled meshlets record a DrawIndexedInstanced() per index range of the union of
+	// their visible meshlets (or a single one of the whole level of detail, if it needs too many draw calls).
+	// The instance buffer of each batch is bound as a root shader resource view at "instanceBufferRootParameterIndex".
+	// Preconditions:
+	// - InitInstanceAndMaterialBuffers() must be called before
+	// - "commandList" must have its root signature and primitive topology already set
+	void RecordInstancedDrawCalls(
+		ID3D12GraphicsCommandList& commandList, 
+		const std::uint32_t instanceBufferRootParameterIndex) noexcept;
+
+private:
+	// Culls the meshlets of visible instances that use the full detail level of detail
+	// against world space "frustumPlanes" and fills their index ranges. Instances whose
+	// meshlets are all culled become invisible.
+	void UpdateInstanceIndexRanges(
+		const FrustumCulling::FrustumPlanes& frustumPlanes,
+		const DirectX::XMFLOAT3& eyePosition) noexcept;
+
+	// Records the draw calls of a batch of full detail instances of a geometry data with meshlets.
+	// All the instances of the batch draw the union of their visible meshlets.
+	void RecordMeshletDrawCalls(
+		ID3D12GraphicsCommandList& commandList,
+		const std::uint32_t instanceBufferRootParameterIndex,
+		const D3D12_GPU_VIRTUAL_ADDRESS instanceBufferGpuAddress,
+		const InstanceBatchBuilder::InstanceBatch& batch) noexcept;
+
 protected:
 	CommandListPerFrame mCommandListPerFrame;
 
@@ -57,16 +173,54 @@ protected:
 
 	std::vector<GeometryData> mGeometryDataVec;
 
-	FrameUploadCBufferPerFrame mFrameUploadCBufferPerFrame;
-
-	UploadBuffer* mObjectUploadCBuffers{ nullptr };
-	D3D12_GPU_DESCRIPTOR_HANDLE mStartObjectCBufferView;
-
-	D3D12_GPU_DESCRIPTOR_HANDLE mStartMaterialCBufferView;
-	UploadBuffer* mMaterialUploadCBuffers{ nullptr };
+	// Materials structured buffer. It is indexed by InstanceData::mMaterialIndex
+	UploadBuffer* mMaterialUploadBuffer{ nullptr };
 	
 	const D3D12_CPU_DESCRIPTOR_HANDLE* mGeometryBufferRenderTargetViews{ nullptr };
 	std::uint32_t mGeometryBufferRenderTargetViewCount{ 0U };
 
 	D3D12_CPU_DESCRIPTOR_HANDLE mDepthBufferView{ 0UL };
+
+	// Frustum culling and level of detail data. There is an element per instance.
+	std::vector<DirectX::BoundingSphere> mWorldBoundingSpheres;
+	std::vector<std::uint8_t> mInstanceVisibilityFlags;
+	std::vector<std::uint8_t> mInstanceLodIndices;
+	std::uint32_t mDrawnInstanceCount{ 0U };
+	std::uint32_t mCulledInstanceCount{ 0U };
+
+	// Streamed texture of each instance in each registered texture descriptor table
+	// (see RegisterStreamedTextures()), or TextureStreamer::sInvalidTextureId. Texture of instance i
+	// in table t is mInstanceStreamedTextureIds[t * instanceCount + i].
+	std::vector<std::uint32_t> mInstanceStreamedTextureIds;
+	std::vector<D3D12_GPU_DESCRIPTOR_HANDLE> mTextureDescriptorTables;
+	std::vector<TextureStreamer::Request> mStreamedTextureRequests;
+	bool mHasStreamedTextures{ false };
+
+	// Texture of each instance in each registered texture descriptor table, or nullptr if
+	// it is streamed, with the same layout as mInstanceStreamedTextureIds. Textures of
+	// visible instances are stored in mUsedTextures to be marked as used.
+	std::vector<ID3D12Resource*> mInstanceTextures;
+	std::vector<ID3D12Resource*> mUsedTextures;
+
+	// Meshlet culling data. Meshlet bounds have an element per geometry data, and the index
+	// ranges of visible meshlets of instance i are mInstanceIndexRanges[mInstanceFirstIndexRanges[i]]
+	// to mInstanceIndexRanges[mInstanceFirstIndexRanges[i] + mInstanceIndexRangeCounts[i]].
+	// Instances with zero index ranges draw their whole level of detail.
+	// mBatchIndexRanges holds the merged index ranges of the batch being recorded.
+	std::vector<MeshletCuller::MeshletBounds> mMeshletBoundsPerGeometryData;
+	std::vector<std::uint8_t> mMeshletVisibilityFlags;
+	std::vector<MeshletCuller::IndexRange> mInstanceIndexRanges;
+	std::vector<std::uint32_t> mInstanceFirstIndexRanges;
+	std::vector<std::uint32_t> mInstanceIndexRangeCounts;
+	std::vector<MeshletCuller::IndexRange> mBatchIndexRanges;
+
+	// Instancing data. mInstances has an element per instance (in mGeometryDataVec order)
+	// and visible ones are packed every frame in mPackedInstances before being uploaded.
+	// mPackedInstanceIndices has the index in mInstances of each packed instance.
+	std::vector<InstanceData> mInstances;
+	std::vector<InstanceData> mPackedInstances;
+	std::vector<std::uint32_t> mPackedInstanceIndices;
+	std::vector<std::uint32_t> mInstanceCountPerGeometryData;
+	std::vector<InstanceBatchBuilder::InstanceBatch> mInstanceBatches;
+	UploadRingBuffer* mUploadRingBuffer{ nullptr };
 };
\ No newline at end of file
@@ -0,0 +1,64 @@
+#include "InstanceBatchBuilder.h"
+
+#include <ModelManager/MeshLod.h>
+#include <Utils/DebugUtils.h>
+
+namespace InstanceBatchBuilder {
+	std::uint32_t PackVisibleInstances(
+		const std::uint8_t* visibilityFlags,
+		const std::uint8_t* lodIndices,
+		const std::uint32_t* instanceCounts,
+		const std::uint32_t geometryDataCount,
+		std::uint32_t* packedInstanceIndices,
+		std::vector<InstanceBatch>& batches) noexcept
+	{
+		ASSERT(visibilityFlags != nullptr);
+		ASSERT(lodIndices != nullptr);
+		ASSERT(instanceCounts != nullptr);
+		ASSERT(geometryDataCount > 0U);
+		ASSERT(packedInstanceIndices != nullptr);
+
+		batches.clear();
+
+		std::uint32_t firstInstanceIndex{ 0U };
+		std::uint32_t packedInstanceCount{ 0U };
+		for (std::uint32_t i = 0U; i < geometryDataCount; ++i) {
+			const std::uint32_t instanceCount{ instanceCounts[i] };
+
+			// Count visible instances per level of detail
+			std::uint32_t lodInstanceCounts[sMaxMeshLodCount]{};
+			for (std::uint32_t j = firstInstanceIndex; j < firstInstanceIndex + instanceCount; ++j) {
+				if (visibilityFlags[j] != 0U) {
+					ASSERT(lodIndices[j] < sMaxMeshLodCount);
+					++lodInstanceCounts[lodIndices[j]];
+				}
+			}
+
+			// Append a batch per level of detail with visible instances
+			std::uint32_t lodInstanceOffsets[sMaxMeshLodCount];
+			for (std::uint32_t lodIndex = 0U; lodIndex < sMaxMeshLodCount; ++lodIndex) {
+				lodInstanceOffsets[lodIndex] = packedInstanceCount;
+				if (lodInstanceCounts[lodIndex] != 0U) {
+					InstanceBatch batch;
+					batch.mGeometryDataIndex = i;
+					batch.mLodIndex = lodIndex;
+					batch.mFirstInstance = packedInstanceCount;
+					batch.mInstanceCount = lodInstanceCounts[lodIndex];
+					batches.push_back(batch);
+
+					packedInstanceCount += batch.mInstanceCount;
+				}
+			}
+
+			for (std::uint32_t j = firstInstanceIndex; j < firstInstanceIndex + instanceCount; ++j) {
+				if (visibilityFlags[j] != 0U) {
+					packedInstanceIndices[lodInstanceOffsets[lodIndices[j]]++] = j;
+				}
+			}
+
+			firstInstanceIndex += instanceCount;
+		}
+
+		return packedInstanceCount;
+	}
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// To pack visible instances and group them in batches that
+// can be drawn with a single DrawIndexedInstanced() call each.
+// Instances are packed by index (the caller gathers their data), so it does not
+// depend on the instance data layout.
+namespace InstanceBatchBuilder {
+	// Packed instances in [mFirstInstance, mFirstInstance + mInstanceCount)
+	// are drawn with the level of detail mLodIndex of the geometry data at index mGeometryDataIndex.
+	struct InstanceBatch {
+		std::uint32_t mGeometryDataIndex{ 0U };
+		std::uint32_t mLodIndex{ 0U };
+		std::uint32_t mFirstInstance{ 0U };
+		std::uint32_t mInstanceCount{ 0U };
+	};
+
+	// Instances follow geometry data order: the first instanceCounts[0] instances
+	// belong to geometry data 0, the next instanceCounts[1] to geometry data 1, and so on.
+	// The indices of the instances with a non-zero visibility flag are stored (keeping their order
+	// inside each level of detail) in "packedInstanceIndices", and a batch is appended to "batches" for
+	// each geometry data and level of detail ("lodIndices") with at least one visible instance.
+	// Returns the number of packed instances.
+	// Preconditions:
+	// - "visibilityFlags" must not be nullptr
+	// - "lodIndices" must not be nullptr and its elements must be less than sMaxMeshLodCount
+	// - "instanceCounts" must not be nullptr
+	// - "geometryDataCount" must be greater than zero
+	// - "packedInstanceIndices" must not be nullptr and it must have room for all the instances
+	std::uint32_t PackVisibleInstances(
+		const std::uint8_t* visibilityFlags,
+		const std::uint8_t* lodIndices,
+		const std::uint32_t* instanceCounts,
+		const std::uint32_t geometryDataCount,
+		std::uint32_t* packedInstanceIndices,
+		std::vector<InstanceBatch>& batches) noexcept;
+}
@@ -0,0 +1,50 @@
+#include "LodSelector.h"
+
+#include <cfloat>
+#include <cmath>
+
+#include <Utils/DebugUtils.h>
+
+namespace LodSelector {
+	float ComputeProjectedSphereRadius(
+		const DirectX::XMFLOAT3& sphereCenter,
+		const float sphereRadius,
+		const DirectX::XMFLOAT3& eyePosition,
+		const float projectionScaleY,
+		const float screenHeight) noexcept
+	{
+		const float x{ sphereCenter.x - eyePosition.x };
+		const float y{ sphereCenter.y - eyePosition.y };
+		const float z{ sphereCenter.z - eyePosition.z };
+		const float squaredDistance{ x * x + y * y + z * z };
+		const float squaredRadius{ sphereRadius * sphereRadius };
+		if (squaredDistance <= squaredRadius) {
+			return FLT_MAX;
+		}
+
+		// Tangent of the half angle subtended by the sphere, scaled to
+		// normalized device coordinates and then to pixels.
+		return sphereRadius * projectionScaleY * screenHeight * 0.5f / std::sqrt(squaredDistance - squaredRadius);
+	}
+
+	std::uint32_t SelectLod(
+		const MeshLod* lods,
+		const std::uint32_t lodCount,
+		const float projectedSphereRadius,
+		const float maxScreenError) noexcept
+	{
+		ASSERT(lods != nullptr);
+		ASSERT(lodCount > 0U);
+
+		std::uint32_t lodIndex{ 0U };
+		for (std::uint32_t i = 1U; i < lodCount; ++i) {
+			if (lods[i].mError * projectedSphereRadius > maxScreenError) {
+				break;
+			}
+
+			lodIndex = i;
+		}
+
+		return lodIndex;
+	}
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <DirectXMath.h>
+
+#include <ModelManager/MeshLod.h>
+
+// To select the level of detail of each instance from the screen size of its
+// world space bounding sphere. The simplification error of a level of detail (see MeshLod)
+// is relative to the bounding sphere radius, so its screen space error in pixels is
+// the error multiplied by the projected radius in pixels.
+namespace LodSelector {
+	// Maximum screen space error (in pixels) of the selected level of detail
+	const float sMaxScreenError{ 1.0f };
+
+	// Returns the radius (in pixels) of the projection of the sphere in the screen, or FLT_MAX if
+	// the eye is inside the sphere.
+	// "projectionScaleY" is the element (1, 1) of the perspective projection matrix (cotangent of half the vertical field of view)
+	float ComputeProjectedSphereRadius(
+		const DirectX::XMFLOAT3& sphereCenter,
+		const float sphereRadius,
+		const DirectX::XMFLOAT3& eyePosition,
+		const float projectionScaleY,
+		const float screenHeight) noexcept;
+
+	// Returns the index of the coarsest level of detail whose screen space
+	// error is not greater than "maxScreenError"
+	// Preconditions:
+	// - "lods" must not be nullptr and it must be sorted from full detail to coarsest.
+	// - "lodCount" must be greater than zero
+	std::uint32_t SelectLod(
+		const MeshLod* lods,
+		const std::uint32_t lodCount,
+		const float projectedSphereRadius,
+		const float maxScreenError = sMaxScreenError) noexcept;
+}
@@ -0,0 +1,153 @@
+#include "MeshletCuller.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <Utils/DebugUtils.h>
+
+namespace MeshletCuller {
+	void InitMeshletBounds(
+		const Meshlet* meshlets,
+		const std::size_t meshletCount,
+		MeshletBounds& meshletBounds) noexcept
+	{
+		ASSERT(meshlets != nullptr || meshletCount == 0UL);
+
+		meshletBounds.mCenterX.resize(meshletCount);
+		meshletBounds.mCenterY.resize(meshletCount);
+		meshletBounds.mCenterZ.resize(meshletCount);
+		meshletBounds.mRadius.resize(meshletCount);
+		meshletBounds.mConeAxisX.resize(meshletCount);
+		meshletBounds.mConeAxisY.resize(meshletCount);
+		meshletBounds.mConeAxisZ.resize(meshletCount);
+		meshletBounds.mConeCutoff.resize(meshletCount);
+		meshletBounds.mFirstIndices.resize(meshletCount);
+		meshletBounds.mIndexCounts.resize(meshletCount);
+
+		for (std::size_t i = 0UL; i < meshletCount; ++i) {
+			const Meshlet& meshlet = meshlets[i];
+			meshletBounds.mCenterX[i] = meshlet.mBoundingSphereCenter.x;
+			meshletBounds.mCenterY[i] = meshlet.mBoundingSphereCenter.y;
+			meshletBounds.mCenterZ[i] = meshlet.mBoundingSphereCenter.z;
+			meshletBounds.mRadius[i] = meshlet.mBoundingSphereRadius;
+			meshletBounds.mConeAxisX[i] = meshlet.mConeAxis.x;
+			meshletBounds.mConeAxisY[i] = meshlet.mConeAxis.y;
+			meshletBounds.mConeAxisZ[i] = meshlet.mConeAxis.z;
+			meshletBounds.mConeCutoff[i] = meshlet.mConeCutoff;
+			meshletBounds.mFirstIndices[i] = meshlet.mFirstIndex;
+			meshletBounds.mIndexCounts[i] = meshlet.mIndexCount;
+		}
+	}
+
+	std::uint32_t CullMeshlets(
+		const MeshletBounds& meshletBounds,
+		const DirectX::XMFLOAT4* frustumPlanes,
+		const DirectX::XMFLOAT3& eyePosition,
+		std::uint8_t* visibilityFlags) noexcept
+	{
+		ASSERT(frustumPlanes != nullptr);
+		ASSERT(visibilityFlags != nullptr);
+
+		const std::size_t meshletCount{ meshletBounds.mCenterX.size() };
+		const float* centerX{ meshletBounds.mCenterX.data() };
+		const float* centerY{ meshletBounds.mCenterY.data() };
+		const float* centerZ{ meshletBounds.mCenterZ.data() };
+		const float* radius{ meshletBounds.mRadius.data() };
+		const float* coneAxisX{ meshletBounds.mConeAxisX.data() };
+		const float* coneAxisY{ meshletBounds.mConeAxisY.data() };
+		const float* coneAxisZ{ meshletBounds.mConeAxisZ.data() };
+		const float* coneCutoff{ meshletBounds.mConeCutoff.data() };
+
+		std::uint32_t visibleMeshletCount{ 0U };
+		for (std::size_t i = 0UL; i < meshletCount; ++i) {
+			// Sphere is outside the frustum if it is behind any plane
+			bool isVisible{ true };
+			for (std::uint32_t j = 0U; j < 6U; ++j) {
+				const DirectX::XMFLOAT4& plane = frustumPlanes[j];
+				const float distance{ plane.x * centerX[i] + plane.y * centerY[i] + plane.z * centerZ[i] + plane.w };
+				isVisible &= distance >= -radius[i];
+			}
+
+			// All the triangles are back facing if the eye is inside the cone
+			// opposite to the normal cone, moved back by the sphere radius
+			// ("Optimizing the Graphics Pipeline with Compute", Wihlidal 2016)
+			const float viewX{ centerX[i] - eyePosition.x };
+			const float viewY{ centerY[i] - eyePosition.y };
+			const float viewZ{ centerZ[i] - eyePosition.z };
+			const float viewLength{ std::sqrt(viewX * viewX + viewY * viewY + viewZ * viewZ) };
+			const float viewDotAxis{ viewX * coneAxisX[i] + viewY * coneAxisY[i] + viewZ * coneAxisZ[i] };
+			isVisible &= viewDotAxis < coneCutoff[i] * viewLength + radius[i];
+
+			visibilityFlags[i] = isVisible ? 1U : 0U;
+			visibleMeshletCount += isVisible ? 1U : 0U;
+		}
+
+		return visibleMeshletCount;
+	}
+
+	std::uint32_t AppendIndexRanges(
+		const MeshletBounds& meshletBounds,
+		const std::uint8_t* visibilityFlags,
+		std::vector<IndexRange>& indexRanges) noexcept
+	{
+		ASSERT(visibilityFlags != nullptr);
+
+		const std::size_t firstRange{ indexRanges.size() };
+		const std::size_t meshletCount{ meshletBounds.mFirstIndices.size() };
+		for (std::size_t i = 0UL; i < meshletCount; ++i) {
+			if (visibilityFlags[i] == 0U) {
+				continue;
+			}
+
+			const std::uint32_t firstIndex{ meshletBounds.mFirstIndices[i] };
+			const std::uint32_t indexCount{ meshletBounds.mIndexCounts[i] };
+			if (indexRanges.size() > firstRange) {
+				IndexRange& lastRange = indexRanges.back();
+				if (lastRange.mFirstIndex + lastRange.mIndexCount == firstIndex) {
+					lastRange.mIndexCount += indexCount;
+					continue;
+				}
+			}
+
+			IndexRange indexRange;
+			indexRange.mFirstIndex = firstIndex;
+			indexRange.mIndexCount = indexCount;
+			indexRanges.push_back(indexRange);
+		}
+
+		return static_cast<std::uint32_t>(indexRanges.size() - firstRange);
+	}
+
+	std::uint32_t MergeIndexRanges(
+		const std::size_t firstRange,
+		std::vector<IndexRange>& indexRanges) noexcept
+	{
+		ASSERT(firstRange <= indexRanges.size());
+
+		std::sort(
+			indexRanges.begin() + firstRange,
+			indexRanges.end(),
+			[](const IndexRange& a, const IndexRange& b) { return a.mFirstIndex < b.mFirstIndex; });
+
+		std::size_t lastRange{ firstRange };
+		const std::size_t rangeCount{ indexRanges.size() };
+		for (std::size_t i = firstRange + 1UL; i < rangeCount; ++i) {
+			IndexRange& mergedRange = indexRanges[lastRange];
+			const IndexRange& indexRange = indexRanges[i];
+			const std::uint32_t mergedRangeEnd{ mergedRange.mFirstIndex + mergedRange.mIndexCount };
+			if (indexRange.mFirstIndex <= mergedRangeEnd) {
+				const std::uint32_t indexRangeEnd{ indexRange.mFirstIndex + indexRange.mIndexCount };
+				mergedRange.mIndexCount = std::max<std::uint32_t>(mergedRangeEnd, indexRangeEnd) - mergedRange.mFirstIndex;
+				continue;
+			}
+
+			indexRanges[++lastRange] = indexRange;
+		}
+
+		if (rangeCount > firstRange) {
+			indexRanges.resize(lastRange + 1UL);
+		}
+
+		return static_cast<std::uint32_t>(indexRanges.size() - firstRange);
+	}
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <DirectXMath.h>
+#include <vector>
+
+#include <ModelManager/Meshlet.h>
+
+// To cull the meshlets (see MeshletBuilder) of an instance against the frustum and to
+// reject back facing ones, so only the index ranges of visible meshlets are drawn.
+// Culling is done in object space, so the world matrix of the instance must not have
+// non uniform scale (in that case, the instance should be drawn without meshlet culling).
+// Meshlet bounds are stored as structure of arrays, so the culling loop
+// is branch free and can be vectorized by the compiler.
+namespace MeshletCuller {
+	struct MeshletBounds {
+		std::vector<float> mCenterX;
+		std::vector<float> mCenterY;
+		std::vector<float> mCenterZ;
+		std::vector<float> mRadius;
+		std::vector<float> mConeAxisX;
+		std::vector<float> mConeAxisY;
+		std::vector<float> mConeAxisZ;
+		std::vector<float> mConeCutoff;
+		std::vector<std::uint32_t> mFirstIndices;
+		std::vector<std::uint32_t> mIndexCounts;
+	};
+
+	struct IndexRange {
+		std::uint32_t mFirstIndex{ 0U };
+		std::uint32_t mIndexCount{ 0U };
+	};
+
+	void InitMeshletBounds(
+		const Meshlet* meshlets,
+		const std::size_t meshletCount,
+		MeshletBounds& meshletBounds) noexcept;
+
+	// "frustumPlanes" are the 6 object space frustum planes, as (a, b, c, d) with a normalized (a, b, c)
+	// that points to the inside of the frustum (like FrustumCulling::FrustumPlanes).
+	// Stores 1 in visibilityFlags[i] if meshlet i intersects the frustum and it is not back facing
+	// from "eyePosition" (object space), 0 otherwise.
+	// Returns the number of visible meshlets.
+	// Preconditions:
+	// - "frustumPlanes" must not be nullptr
+	// - "visibilityFlags" must not be nullptr and it must have room for all the meshlets
+	std::uint32_t CullMeshlets(
+		const MeshletBounds& meshletBounds,
+		const DirectX::XMFLOAT4* frustumPlanes,
+		const DirectX::XMFLOAT3& eyePosition,
+		std::uint8_t* visibilityFlags) noexcept;
+
+	// Appends to "indexRanges" the index ranges of visible meshlets.
+	// Meshlets that are contiguous in the index buffer are merged in a single range.
+	// Returns the number of appended ranges.
+	// Preconditions:
+	// - "visibilityFlags" must not be nullptr
+	std::uint32_t AppendIndexRanges(
+		const MeshletBounds& meshletBounds,
+		const std::uint8_t* visibilityFlags,
+		std::vector<IndexRange>& indexRanges) noexcept;
+
+	// Sorts the index ranges in [firstRange, indexRanges.size()) by first index and merges
+	// the ones that overlap or are contiguous, so the union of the visible meshlets of
+	// several instances can be drawn instanced. Merged ranges replace the original ones.
+	// Returns the number of merged ranges.
+	std::uint32_t MergeIndexRanges(
+		const std::size_t firstRange,
+		std::vector<IndexRange>& indexRanges) noexcept;
+}
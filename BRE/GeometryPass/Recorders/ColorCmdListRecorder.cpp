@@ -4,20 +4,18 @@
 
 #include <CommandListExecutor\CommandListExecutor.h>
 #include <DescriptorManager\CbvSrvUavDescriptorManager.h>
-#include <DirectXManager\DirectXManager.h>
 #include <MaterialManager/Material.h>
 #include <MathUtils/MathUtils.h>
 #include <PSOManager/PSOManager.h>
-#include <ResourceManager/UploadBufferManager.h>
 #include <RootSignatureManager\RootSignatureManager.h>
 #include <ShaderManager\ShaderManager.h>
 #include <ShaderUtils\CBuffers.h>
 #include <Utils/DebugUtils.h>
 
 // Root signature:
-// "DescriptorTable(CBV(b0), visibility = SHADER_VISIBILITY_VERTEX), " \ 0 -> Object CBuffers
+// "SRV(t0, visibility = SHADER_VISIBILITY_VERTEX), " \ 0 -> Instance Data
 // "CBV(b1, visibility = SHADER_VISIBILITY_VERTEX), " \ 1 -> Frame CBuffer
-// "DescriptorTable(CBV(b0), visibility = SHADER_VISIBILITY_PIXEL), " \ 2 -> Material CBuffers
+// "SRV(t0, visibility = SHADER_VISIBILITY_PIXEL), " \ 2 -> Materials
 // "CBV(b1, visibility = SHADER_VISIBILITY_PIXEL), " \ 3 -> Frame CBuffer
 
 namespace {
@@ -32,7 +30,7 @@ void ColorCmdListRecorder::InitSharedPSOAndRootSignature(const DXGI_FORMAT* geom
 	ASSERT(sRootSignature == nullptr);
 
 	PSOManager::PSOCreationData psoData{};
-	psoData.mInputLayoutDescriptors = D3DFactory::GetPosNormalTangentTexCoordInputLayout();
+	psoData.mInputLayoutDescriptors = D3DFactory::GetPackedPosNormalTangentTexCoordInputLayout();
 
 	psoData.mPixelShaderBytecode = ShaderManager::LoadShaderFileAndGetBytecode("GeometryPass/Shaders/ColorMapping/PS.cso");
 	psoData.mVertexShaderBytecode = ShaderManager::LoadShaderFileAndGetBytecode("GeometryPass/Shaders/ColorMapping/VS.cso");
@@ -76,12 +74,17 @@ void ColorCmdListRecorder::Init(
 		mGeometryDataVec.push_back(geometryDataVec[i]);
 	}
 
-	InitConstantBuffers(materials, numMaterials);
+	InitWorldBoundingSpheres();
+
+	InitInstanceAndMaterialBuffers(materials, numMaterials);
 
 	ASSERT(IsDataValid());
 }
 
-void ColorCmdListRecorder::RecordAndPushCommandLists(const FrameCBuffer& frameCBuffer) noexcept {
+void ColorCmdListRecorder::RecordAndPushCommandLists(
+	const FrameCBuffer& frameCBuffer,
+	const D3D12_GPU_VIRTUAL_ADDRESS frameCBufferGpuAddress) noexcept
+{
 	ASSERT(IsDataValid());
 	ASSERT(sPSO != nullptr);
 	ASSERT(sRootSignature != nullptr);
@@ -89,9 +92,8 @@ void ColorCmdListRecorder::RecordAndPushCommandLists(const FrameCBuffer& frameCB
 	ASSERT(mGeometryBufferRenderTargetViewCount != 0U);
 	ASSERT(mDepthBufferView.ptr != 0U);
 		
-	// Update frame constants
-	UploadBuffer& uploadFrameCBuffer(mFrameUploadCBufferPerFrame.GetNextFrameCBuffer());
-	uploadFrameCBuffer.CopyData(0U, &frameCBuffer, sizeof(frameCBuffer));
+	// Cull instances against the camera frustum
+	UpdateInstanceVisibility(frameCBuffer);
 
 	ID3D12GraphicsCommandList& commandList = mCommandListPerFrame.ResetWithNextCommandAllocator(sPSO);
 
@@ -103,96 +105,17 @@ void ColorCmdListRecorder::RecordAndPushCommandLists(const FrameCBuffer& frameCB
 	commandList.SetDescriptorHeaps(_countof(heaps), heaps);
 
 	commandList.SetGraphicsRootSignature(sRootSignature);
-	const std::size_t descHandleIncSize{ DirectXManager::GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV) };
-	D3D12_GPU_DESCRIPTOR_HANDLE objectCBufferGpuDesc(mStartObjectCBufferView);
-	D3D12_GPU_DESCRIPTOR_HANDLE materialsCBufferGpuDesc(mStartMaterialCBufferView);
-	D3D12_GPU_VIRTUAL_ADDRESS frameCBufferGpuVAddress(uploadFrameCBuffer.GetResource()->GetGPUVirtualAddress());
-	commandList.SetGraphicsRootConstantBufferView(1U, frameCBufferGpuVAddress);
-	commandList.SetGraphicsRootConstantBufferView(3U, frameCBufferGpuVAddress);
+	commandList.SetGraphicsRootConstantBufferView(1U, frameCBufferGpuAddress);
+	commandList.SetGraphicsRootConstantBufferView(3U, frameCBufferGpuAddress);
 	
 	commandList.IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-	const std::size_t geomCount{ mGeometryDataVec.size() };
-	for (std::size_t i = 0UL; i < geomCount; ++i) {
-		GeometryData& geomData{ mGeometryDataVec[i] };
-		commandList.IASetVertexBuffers(0U, 1U, &geomData.mVertexBufferData.mBufferView);
-		commandList.IASetIndexBuffer(&geomData.mIndexBufferData.mBufferView);
-		const std::size_t worldMatsCount{ geomData.mWorldMatrices.size() };
-		for (std::size_t j = 0UL; j < worldMatsCount; ++j) {
-			commandList.SetGraphicsRootDescriptorTable(0U, objectCBufferGpuDesc);
-			objectCBufferGpuDesc.ptr += descHandleIncSize;
-
-			commandList.SetGraphicsRootDescriptorTable(2U, materialsCBufferGpuDesc);
-			materialsCBufferGpuDesc.ptr += descHandleIncSize;
-
-			commandList.DrawIndexedInstanced(geomData.mIndexBufferData.mElementCount, 1U, 0U, 0U, 0U);
-		}
-	}
+
+	// Materials are indexed by InstanceData::mMaterialIndex in shaders
+	commandList.SetGraphicsRootShaderResourceView(2U, mMaterialUploadBuffer->GetResource()->GetGPUVirtualAddress());
+
+	// Draw visible instances
+	RecordInstancedDrawCalls(commandList, 0U);
 	
 	commandList.Close();
 	CommandListExecutor::Get().AddCommandList(commandList);
-}
-
-void ColorCmdListRecorder::InitConstantBuffers(
-	const Material* materials, 
-	const std::uint32_t numMaterials) noexcept 
-{
-	ASSERT(materials != nullptr);
-	ASSERT(numMaterials != 0UL);
-	ASSERT(mObjectUploadCBuffers == nullptr);
-	ASSERT(mMaterialUploadCBuffers == nullptr);
-
-	// Create object cbuffer and fill it
-	const std::size_t objCBufferElemSize{ UploadBuffer::GetRoundedConstantBufferSizeInBytes(sizeof(ObjectCBuffer)) };
-	mObjectUploadCBuffers = &UploadBufferManager::CreateUploadBuffer(objCBufferElemSize, numMaterials);
-	std::uint32_t k = 0U;
-	const std::size_t geometryDataCount{ mGeometryDataVec.size() };
-	ObjectCBuffer objCBuffer;
-	for (std::size_t i = 0UL; i < geometryDataCount; ++i) {
-		GeometryData& geomData{ mGeometryDataVec[i] };
-		const std::uint32_t worldMatsCount{ static_cast<std::uint32_t>(geomData.mWorldMatrices.size()) };
-		for (std::uint32_t j = 0UL; j < worldMatsCount; ++j) {
-			const DirectX::XMMATRIX wMatrix = DirectX::XMMatrixTranspose(DirectX::XMLoadFloat4x4(&geomData.mWorldMatrices[j]));
-			DirectX::XMStoreFloat4x4(&objCBuffer.mWorldMatrix, wMatrix);
-			mObjectUploadCBuffers->CopyData(k + j, &objCBuffer, sizeof(objCBuffer));
-		}
-
-		k += worldMatsCount;
-	}
-
-	// Create materials cbuffer		
-	const std::size_t matCBufferElemSize{ UploadBuffer::GetRoundedConstantBufferSizeInBytes(sizeof(Material)) };
-	mMaterialUploadCBuffers = &UploadBufferManager::CreateUploadBuffer(matCBufferElemSize, numMaterials);
-
-	D3D12_GPU_VIRTUAL_ADDRESS materialsGpuAddress{ mMaterialUploadCBuffers->GetResource()->GetGPUVirtualAddress() };
-	D3D12_GPU_VIRTUAL_ADDRESS objCBufferGpuAddress{ mObjectUploadCBuffers->GetResource()->GetGPUVirtualAddress() };
-
-	// Create object / materials cbuffers descriptors
-	// Create textures SRV descriptors
-	std::vector<D3D12_CONSTANT_BUFFER_VIEW_DESC> objectCbufferViewDescVec;
-	objectCbufferViewDescVec.reserve(numMaterials);
-
-	std::vector<D3D12_CONSTANT_BUFFER_VIEW_DESC> materialCbufferViewDescVec;
-	materialCbufferViewDescVec.reserve(numMaterials);
-	for (std::size_t i = 0UL; i < numMaterials; ++i) {
-		// Object cbuffer desc
-		D3D12_CONSTANT_BUFFER_VIEW_DESC cBufferDesc{};
-		cBufferDesc.BufferLocation = objCBufferGpuAddress + i * objCBufferElemSize;
-		cBufferDesc.SizeInBytes = static_cast<std::uint32_t>(objCBufferElemSize);
-		objectCbufferViewDescVec.push_back(cBufferDesc);
-
-		// Material cbuffer desc
-		cBufferDesc.BufferLocation = materialsGpuAddress + i * matCBufferElemSize;
-		cBufferDesc.SizeInBytes = static_cast<std::uint32_t>(matCBufferElemSize);
-		materialCbufferViewDescVec.push_back(cBufferDesc);
-
-		mMaterialUploadCBuffers->CopyData(static_cast<std::uint32_t>(i), &materials[i], sizeof(Material));
-	}
-	mStartObjectCBufferView =
-		CbvSrvUavDescriptorManager::CreateConstantBufferViews(
-			objectCbufferViewDescVec.data(), 
-			static_cast<std::uint32_t>(objectCbufferViewDescVec.size()));
-	mStartMaterialCBufferView =
-		CbvSrvUavDescriptorManager::CreateConstantBufferViews(
-			materialCbufferViewDescVec.data(), 
-			static_cast<std::uint32_t>(materialCbufferViewDescVec.size()));
 }
\ No newline at end of file
@@ -30,11 +30,7 @@ public:
 
 	// Preconditions:
 	// - Init() must be called first
-	void RecordAndPushCommandLists(const FrameCBuffer& frameCBuffer) noexcept final override;
-
-private:
-	// Preconditions:
-	// - "materials" must not be nullptr
-	// - "numMaterials" must be greater than zero
-	void InitConstantBuffers(const Material* materials, const std::uint32_t numMaterials) noexcept;
+	void RecordAndPushCommandLists(
+		const FrameCBuffer& frameCBuffer,
+		const D3D12_GPU_VIRTUAL_ADDRESS frameCBufferGpuAddress) noexcept final override;
 };
\ No newline at end of file
@@ -36,19 +36,19 @@ public:
 
 	// Preconditions:
 	// - Init() must be called first
-	void RecordAndPushCommandLists(const FrameCBuffer& frameCBuffer) noexcept final override;
+	void RecordAndPushCommandLists(
+		const FrameCBuffer& frameCBuffer,
+		const D3D12_GPU_VIRTUAL_ADDRESS frameCBufferGpuAddress) noexcept final override;
 
 	bool IsDataValid() const noexcept final override;
 
 private:
 	// Preconditions:
-	// - "materials" must not be nullptr
 	// - "textures" must not be nullptr
 	// - "normals" must not be nullptr
 	// - "heights" must not be nullptr
 	// - "dataCount" must be greater than zero
-	void InitConstantBuffers(
-		const Material* materials,
+	void InitShaderResourceViews(
 		ID3D12Resource** textures,
 		ID3D12Resource** normals,
 		ID3D12Resource** heights,
@@ -8,6 +8,7 @@ struct Input {
 	float3 mTangentWorldSpace : TANGENT_WORLD;
 	float2 mUV : TEXCOORD0;
 	float mTessellationFactor : TESS;
+	uint mMaterialIndex : MATERIAL_INDEX;
 };
 
 struct HullShaderConstantOutput {
@@ -20,6 +21,7 @@ struct Output {
 	float3 mNormalWorldSpace : NORMAL_WORLD;
 	float3 mTangentWorldSpace : TANGENT_WORLD;
 	float2 mUV : TEXCOORD0;
+	uint mMaterialIndex : MATERIAL_INDEX;
 };
 
 HullShaderConstantOutput constant_hull_shader(const InputPatch<Input, NUM_PATCH_POINTS> patch, const uint patchID : SV_PrimitiveID) {
@@ -49,6 +51,7 @@ Output main(const InputPatch <Input, NUM_PATCH_POINTS> patch, const uint control
 	output.mNormalWorldSpace = patch[controlPointID].mNormalWorldSpace;
 	output.mTangentWorldSpace = patch[controlPointID].mTangentWorldSpace;
 	output.mUV = patch[controlPointID].mUV;
+	output.mMaterialIndex = patch[controlPointID].mMaterialIndex;
 	
 	return output;
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include <ShaderUtils/CBuffers.hlsli>
+#include <ShaderUtils/Utils.hlsli>
 
 #include "RS.hlsl"
 
@@ -7,14 +8,16 @@
 #define MIN_TESS_FACTOR 1.0f
 #define MAX_TESS_FACTOR 5.0f
 
+// Packed vertex (see VertexCompressor::PackedVertex). Quantized position is
+// dequantized by the instance world matrix.
 struct Input {
-	float3 mPositionObjectSpace : POSITION;
-	float3 mNormalObjectSpace : NORMAL;
-	float3 mTangentObjectSpace : TANGENT;
+	float4 mPositionQuantized : POSITION;
+	float2 mNormalObjectSpaceEncoded : NORMAL;
+	float2 mTangentObjectSpaceEncoded : TANGENT;
 	float2 mUV : TEXCOORD;
 };
 
-ConstantBuffer<ObjectCBuffer> gObjCBuffer : register(b0);
+StructuredBuffer<InstanceData> gInstanceData : register(t0);
 ConstantBuffer<FrameCBuffer> gFrameCBuffer : register(b1);
 
 struct Output {
@@ -23,19 +26,22 @@ struct Output {
 	float3 mTangentWorldSpace : TANGENT_WORLD;
 	float2 mUV : TEXCOORD0;
 	float mTessellationFactor : TESS;
+	nointerpolation uint mMaterialIndex : MATERIAL_INDEX;
 };
 
 [RootSignature(RS)]
-Output main(in const Input input) {
+Output main(in const Input input, in const uint instanceId : SV_InstanceID) {
+	const InstanceData instanceData = gInstanceData[instanceId];
+
 	Output output;
 
-	output.mPositionWorldSpace = mul(float4(input.mPositionObjectSpace, 1.0f), gObjCBuffer.mWorldMatrix).xyz;
+	output.mPositionWorldSpace = mul(input.mPositionQuantized, instanceData.mWorldMatrix).xyz;
 
-	output.mNormalWorldSpace = mul(float4(input.mNormalObjectSpace, 0.0f), gObjCBuffer.mWorldMatrix).xyz;
+	output.mNormalWorldSpace = mul(float4(DecodeOctahedronSnorm(input.mNormalObjectSpaceEncoded), 0.0f), instanceData.mWorldMatrix).xyz;
 
-	output.mTangentWorldSpace = mul(float4(input.mTangentObjectSpace, 0.0f), gObjCBuffer.mWorldMatrix).xyz;
+	output.mTangentWorldSpace = mul(float4(DecodeOctahedronSnorm(input.mTangentObjectSpaceEncoded), 0.0f), instanceData.mWorldMatrix).xyz;
 
-	output.mUV = gObjCBuffer.mTexTransform * input.mUV;
+	output.mUV = instanceData.mTexTransform * input.mUV;
 		
 
 	// Normalized tessellation factor. 
@@ -48,5 +54,7 @@ Output main(in const Input input) {
 	// Rescale [0,1] --> [MIN_TESS_FACTOR, MAX_TESS_FACTOR].
 	output.mTessellationFactor = MIN_TESS_FACTOR + tessellationFactor * (MAX_TESS_FACTOR - MIN_TESS_FACTOR);
 
+	output.mMaterialIndex = instanceData.mMaterialIndex;
+
 	return output;
 }
\ No newline at end of file
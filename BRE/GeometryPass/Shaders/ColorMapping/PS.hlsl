@@ -10,9 +10,10 @@ struct Input {
 	float3 mPositionViewSpace : POS_VIEW;
 	float3 mNormalWorldSpace : NORMAL_WORLD;
 	float3 mNormalViewSpace : NORMAL_VIEW;
+	nointerpolation uint mMaterialIndex : MATERIAL_INDEX;
 };
 
-ConstantBuffer<Material> gMaterialCBuffer : register(b0);
+StructuredBuffer<Material> gMaterials : register(t0);
 ConstantBuffer<FrameCBuffer> gFrameCBuffer : register(b1);
 
 struct Output {	
@@ -24,15 +25,17 @@ struct Output {
 Output main(const in Input input) {
 	Output output = (Output)0;
 
+	const Material material = gMaterials[input.mMaterialIndex];
+
 	// Normal (encoded in view space)
 	const float3 normal = normalize(input.mNormalViewSpace);
 	output.mNormal_Smoothness.xy = Encode(normal);
 
 	// Metal mask
-	output.mBaseColor_MetalMask = gMaterialCBuffer.mBaseColor_MetalMask;
+	output.mBaseColor_MetalMask = material.mBaseColor_MetalMask;
 
 	// Smoothness
-	output.mNormal_Smoothness.z = gMaterialCBuffer.mSmoothness;
+	output.mNormal_Smoothness.z = material.mSmoothness;
 		
 	return output;
 }
\ No newline at end of file
@@ -15,13 +15,14 @@ struct Input {
 	float3 mBinormalWorldSpace : BINORMAL_WORLD;
 	float3 mBinormalViewSpace : BINORMAL_VIEW;
 	float2 mUV : TEXCOORD;
+	nointerpolation uint mMaterialIndex : MATERIAL_INDEX;
 };
 
-ConstantBuffer<Material> gMaterialCBuffer : register(b0);
+StructuredBuffer<Material> gMaterials : register(t0);
 ConstantBuffer<FrameCBuffer> gFrameCBuffer : register(b1);
 
 SamplerState TextureSampler : register (s0);
-Texture2D NormalTexture : register (t0);
+Texture2D NormalTextures[] : register (t0, space1);
 
 struct Output {
 	float4 mNormal_Smoothness : SV_Target0;
@@ -32,18 +33,20 @@ struct Output {
 Output main(const in Input input) {
 	Output output = (Output)0;
 
+	const Material material = gMaterials[input.mMaterialIndex];
+
 	// Normal (encoded in view space)
-	const float3 normalObjectSpace = normalize(UnmapF1(NormalTexture.Sample(TextureSampler, input.mUV).xyz));
+	const float3 normalObjectSpace = normalize(UnmapNormalXY(NormalTextures[NonUniformResourceIndex(input.mMaterialIndex)].Sample(TextureSampler, input.mUV).xy));
 	const float3x3 tbnWorldSpace = float3x3(normalize(input.mTangentWorldSpace), normalize(input.mBinormalWorldSpace), normalize(input.mNormalWorldSpace));
 	const float3 normalWorldSpace = normalize(mul(normalObjectSpace, tbnWorldSpace));
 	const float3x3 tbnViewSpace = float3x3(normalize(input.mTangentViewSpace), normalize(input.mBinormalViewSpace), normalize(input.mNormalViewSpace));
 	output.mNormal_Smoothness.xy = Encode(normalize(mul(normalObjectSpace, tbnViewSpace)));
 
 	// Base color and metal mask
-	output.mBaseColor_MetalMask = gMaterialCBuffer.mBaseColor_MetalMask;
+	output.mBaseColor_MetalMask = material.mBaseColor_MetalMask;
 
 	// Smoothness
-	output.mNormal_Smoothness.z = gMaterialCBuffer.mSmoothness;
+	output.mNormal_Smoothness.z = material.mSmoothness;
 
 	return output;
 }
\ No newline at end of file
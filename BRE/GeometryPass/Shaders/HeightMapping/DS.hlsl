@@ -15,12 +15,13 @@ struct Input {
 	float3 mNormalWorldSpace : NORMAL_WORLD;
 	float3 mTangentWorldSpace : TANGENT_WORLD;
 	float2 mUV : TEXCOORD0;
+	uint mMaterialIndex : MATERIAL_INDEX;
 };
 
 ConstantBuffer<FrameCBuffer> gFrameCBuffer : register(b0);
 
 SamplerState TextureSampler : register (s0);
-Texture2D HeightTexture : register (t0);
+Texture2D HeightTextures[] : register (t0, space1);
 
 struct Output {
 	float4 mPositionClipSpace : SV_Position;
@@ -33,6 +34,7 @@ struct Output {
 	float3 mBinormalWorldSpace : BINORMAL_WORLD;
 	float3 mBinormalViewSpace : BINORMAL_VIEW;
 	float2 mUV : TEXCOORD0;
+	nointerpolation uint mMaterialIndex : MATERIAL_INDEX;
 };
 
 [RootSignature(RS)]
@@ -40,6 +42,9 @@ struct Output {
 Output main(const HullShaderConstantOutput HSConstantOutput, const float3 uvw : SV_DomainLocation, const OutputPatch <Input, NUM_PATCH_POINTS> patch) {
 	Output output = (Output)0;
 
+	// All the patch control points belong to the same instance
+	output.mMaterialIndex = patch[0].mMaterialIndex;
+
 	// Get texture coordinates
 	output.mUV = uvw.x * patch[0].mUV + uvw.y * patch[1].mUV + uvw.z * patch[2].mUV;
 
@@ -55,7 +60,7 @@ Output main(const HullShaderConstantOutput HSConstantOutput, const float3 uvw :
 	// Choose the mipmap level based on distance to the eye; specifically, choose the next miplevel every mipInterval units, and clamp the miplevel in [0, 6].
 	const float mipInterval = 20.0f;
 	const float mipLevel = clamp((length(positionViewSpace) - mipInterval) / mipInterval, 0.0f, 6.0f);
-	const float height = HeightTexture.SampleLevel(TextureSampler, output.mUV, mipLevel).x;
+	const float height = HeightTextures[NonUniformResourceIndex(output.mMaterialIndex)].SampleLevel(TextureSampler, output.mUV, mipLevel).x;
 	const float displacement = (HEIGHT_SCALE * (height - 1));
 
 	// Offset vertex along normal
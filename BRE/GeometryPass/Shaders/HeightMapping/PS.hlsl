@@ -15,14 +15,15 @@ struct Input {
 	float3 mBinormalWorldSpace : BINORMAL_WORLD;
 	float3 mBinormalViewSpace : BINORMAL_VIEW;
 	float2 mUV : TEXCOORD0;
+	nointerpolation uint mMaterialIndex : MATERIAL_INDEX;
 };
 
-ConstantBuffer<Material> gMaterialCBuffer : register(b0);
+StructuredBuffer<Material> gMaterials : register(t0);
 ConstantBuffer<FrameCBuffer> gFrameCBuffer : register(b1);
 
 SamplerState TextureSampler : register (s0);
-Texture2D DiffuseTexture : register (t0);
-Texture2D NormalTexture : register (t1);
+Texture2D DiffuseTextures[] : register (t0, space1);
+Texture2D NormalTextures[] : register (t0, space2);
 
 struct Output {
 	float4 mNormal_Smoothness : SV_Target0;
@@ -33,19 +34,21 @@ struct Output {
 Output main(const in Input input) {
 	Output output = (Output)0;
 
+	const Material material = gMaterials[input.mMaterialIndex];
+
 	// Normal (encoded in view space) 
-	const float3 normalObjectSpace = normalize(UnmapF1(NormalTexture.Sample(TextureSampler, input.mUV).xyz));
+	const float3 normalObjectSpace = normalize(UnmapNormalXY(NormalTextures[NonUniformResourceIndex(input.mMaterialIndex)].Sample(TextureSampler, input.mUV).xy));
 	const float3x3 tbnWorldSpace = float3x3(normalize(input.mTangentWorldSpace), normalize(input.mBinormalWorldSpace), normalize(input.mNormalWorldSpace));
 	const float3 normalWorldSpace = mul(normalObjectSpace, tbnWorldSpace);
 	const float3x3 tbnViewSpace = float3x3(normalize(input.mTangentViewSpace), normalize(input.mBinormalViewSpace), normalize(input.mNormalViewSpace));
 	output.mNormal_Smoothness.xy = Encode(normalize(mul(normalObjectSpace, tbnViewSpace)));
 
 	// Base color and metal mask
-	const float3 diffuseColor = DiffuseTexture.Sample(TextureSampler, input.mUV).rgb;
-	output.mBaseColor_MetalMask = float4(gMaterialCBuffer.mBaseColor_MetalMask.xyz * diffuseColor, gMaterialCBuffer.mBaseColor_MetalMask.w);
+	const float3 diffuseColor = DiffuseTextures[NonUniformResourceIndex(input.mMaterialIndex)].Sample(TextureSampler, input.mUV).rgb;
+	output.mBaseColor_MetalMask = float4(material.mBaseColor_MetalMask.xyz * diffuseColor, material.mBaseColor_MetalMask.w);
 
 	// Smoothness
-	output.mNormal_Smoothness.z = gMaterialCBuffer.mSmoothness;
+	output.mNormal_Smoothness.z = material.mSmoothness;
 
 	return output;
 }
\ No newline at end of file
@@ -1,15 +1,18 @@
 #include <ShaderUtils/CBuffers.hlsli>
+#include <ShaderUtils/Utils.hlsli>
 
 #include "RS.hlsl"
 
+// Packed vertex (see VertexCompressor::PackedVertex). Quantized position is
+// dequantized by the instance world matrix.
 struct Input {
-	float3 mPositionObjectSpace : POSITION;
-	float3 mNormalObjectSpace : NORMAL;
-	float3 mTangentObjectSpace : TANGENT;
+	float4 mPositionQuantized : POSITION;
+	float2 mNormalObjectSpaceEncoded : NORMAL;
+	float2 mTangentObjectSpaceEncoded : TANGENT;
 	float2 mUV : TEXCOORD;
 };
 
-ConstantBuffer<ObjectCBuffer> gObjCBuffer : register(b0);
+StructuredBuffer<InstanceData> gInstanceData : register(t0);
 ConstantBuffer<FrameCBuffer> gFrameCBuffer : register(b1);
 
 struct Output {
@@ -23,25 +26,30 @@ struct Output {
 	float3 mBinormalWorldSpace : BINORMAL_WORLD;
 	float3 mBinormalViewSpace : BINORMAL_VIEW;
 	float2 mUV : TEXCOORD;
+	nointerpolation uint mMaterialIndex : MATERIAL_INDEX;
 };
 
 [RootSignature(RS)]
-Output main(in const Input input) {
+Output main(in const Input input, in const uint instanceId : SV_InstanceID) {
+	const InstanceData instanceData = gInstanceData[instanceId];
+
 	Output output;
-	output.mPositionWorldSpace = mul(float4(input.mPositionObjectSpace, 1.0f), gObjCBuffer.mWorldMatrix).xyz;
+	output.mPositionWorldSpace = mul(input.mPositionQuantized, instanceData.mWorldMatrix).xyz;
 	output.mPositionViewSpace = mul(float4(output.mPositionWorldSpace, 1.0f), gFrameCBuffer.mViewMatrix).xyz;
 	output.mPositionClipSpace = mul(float4(output.mPositionViewSpace, 1.0f), gFrameCBuffer.mProjectionMatrix);
 
-	output.mUV = gObjCBuffer.mTexTransform * input.mUV;
+	output.mUV = instanceData.mTexTransform * input.mUV;
 
-	output.mNormalWorldSpace = mul(float4(input.mNormalObjectSpace, 0.0f), gObjCBuffer.mWorldMatrix).xyz;
+	output.mNormalWorldSpace = mul(float4(DecodeOctahedronSnorm(input.mNormalObjectSpaceEncoded), 0.0f), instanceData.mWorldMatrix).xyz;
 	output.mNormalViewSpace = mul(float4(output.mNormalWorldSpace, 0.0f), gFrameCBuffer.mViewMatrix).xyz;
 
-	output.mTangentWorldSpace = mul(float4(input.mTangentObjectSpace, 0.0f), gObjCBuffer.mWorldMatrix).xyz;
+	output.mTangentWorldSpace = mul(float4(DecodeOctahedronSnorm(input.mTangentObjectSpaceEncoded), 0.0f), instanceData.mWorldMatrix).xyz;
 	output.mTangentViewSpace = mul(float4(output.mTangentWorldSpace, 0.0f), gFrameCBuffer.mViewMatrix).xyz;
 	
 	output.mBinormalWorldSpace = normalize(cross(output.mNormalWorldSpace, output.mTangentWorldSpace));
 	output.mBinormalViewSpace = normalize(cross(output.mNormalViewSpace, output.mTangentViewSpace));
 
+	output.mMaterialIndex = instanceData.mMaterialIndex;
+
 	return output;
 }
\ No newline at end of file
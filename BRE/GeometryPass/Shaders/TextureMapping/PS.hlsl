@@ -11,13 +11,14 @@ struct Input {
 	float3 mNormalWorldSpace : NORMAL_WORLD;
 	float3 mNormalViewSpace : NORMAL_VIEW;
 	float2 mUV : TEXCOORD;
+	nointerpolation uint mMaterialIndex : MATERIAL_INDEX;
 };
 
-ConstantBuffer<Material> gMaterialCBuffer : register(b0);
+StructuredBuffer<Material> gMaterials : register(t0);
 ConstantBuffer<FrameCBuffer> gFrameCBuffer : register(b1);
 
 SamplerState TextureSampler : register (s0);
-Texture2D DiffuseTexture : register (t0);
+Texture2D DiffuseTextures[] : register (t0, space1);
 
 struct Output {
 	float4 mNormal_Smoothness : SV_Target0;
@@ -28,16 +29,18 @@ struct Output {
 Output main(const in Input input) {
 	Output output = (Output)0;
 
+	const Material material = gMaterials[input.mMaterialIndex];
+
 	// Normal (encoded in view space)
 	const float3 normalViewSpace = normalize(input.mNormalViewSpace);
 	output.mNormal_Smoothness.xy = Encode(normalViewSpace);
 
 	// Base color and metal mask
-	const float3 diffuseColor = DiffuseTexture.Sample(TextureSampler, input.mUV).rgb;
-	output.mBaseColor_MetalMask = float4(gMaterialCBuffer.mBaseColor_MetalMask.xyz * diffuseColor, gMaterialCBuffer.mBaseColor_MetalMask.w);
+	const float3 diffuseColor = DiffuseTextures[NonUniformResourceIndex(input.mMaterialIndex)].Sample(TextureSampler, input.mUV).rgb;
+	output.mBaseColor_MetalMask = float4(material.mBaseColor_MetalMask.xyz * diffuseColor, material.mBaseColor_MetalMask.w);
 
 	// Smoothness
-	output.mNormal_Smoothness.z = gMaterialCBuffer.mSmoothness;
+	output.mNormal_Smoothness.z = material.mSmoothness;
 
 	return output;
 }
\ No newline at end of file
@@ -16,6 +16,8 @@ void LightingPass::Init(
 	Microsoft::WRL::ComPtr<ID3D12Resource>* geometryBuffers,
 	const std::uint32_t geometryBuffersCount,
 	ID3D12Resource& depthBuffer,
+	ID3D12Resource& ambientAccessibilityBuffer,
+	ID3D12Resource& blurBuffer,
 	ID3D12Resource& diffuseIrradianceCubeMap,
 	ID3D12Resource& specularPreConvolvedCubeMap,
 	const D3D12_CPU_DESCRIPTOR_HANDLE& renderTargetView) noexcept
@@ -35,6 +37,8 @@ void LightingPass::Init(
 		*geometryBuffers[GeometryPass::BASECOLOR_METALMASK].Get(),
 		*geometryBuffers[GeometryPass::NORMAL_SMOOTHNESS].Get(),		
 		depthBuffer,
+		ambientAccessibilityBuffer,
+		blurBuffer,
 		renderTargetView);
 
 	// Initialize environment light pass
@@ -54,12 +58,11 @@ void LightingPass::Init(
 	ASSERT(IsDataValid());
 }
 
-void LightingPass::Execute(const FrameCBuffer& frameCBuffer) noexcept {
+std::uint32_t LightingPass::Execute(const D3D12_GPU_VIRTUAL_ADDRESS frameCBufferGpuAddress) noexcept {
 	ASSERT(IsDataValid());
 
 	ExecuteBeginTask();
 
-	CommandListExecutor::Get().ResetExecutedCommandListCount();
 	const std::uint32_t lightTaskCount{ static_cast<std::uint32_t>(mCommandListRecorders.size())};
 	
 	// Execute tasks
@@ -67,19 +70,16 @@ void LightingPass::Execute(const FrameCBuffer& frameCBuffer) noexcept {
 	tbb::parallel_for(tbb::blocked_range<std::size_t>(0, lightTaskCount, grainSize),
 		[&](const tbb::blocked_range<size_t>& r) {
 		for (size_t i = r.begin(); i != r.end(); ++i)
-			mCommandListRecorders[i]->RecordAndPushCommandLists(frameCBuffer);
+			mCommandListRecorders[i]->RecordAndPushCommandLists(frameCBufferGpuAddress);
 	}
 	);
-	
-	// Wait until all previous tasks command lists are executed
-	while (CommandListExecutor::Get().GetExecutedCommandListCount() < lightTaskCount) {
-		Sleep(0U);
-	}
 
-	mAmbientLightPass.Execute(frameCBuffer);
-	mEnvironmentLightPass.Execute(frameCBuffer);
+	// Begin task command list + 1 command list per light recorder
+	std::uint32_t commandListCount{ lightTaskCount + 1U };
+	commandListCount += mAmbientLightPass.Execute(frameCBufferGpuAddress);
+	commandListCount += mEnvironmentLightPass.Execute(frameCBufferGpuAddress);
 
-	ExecuteFinalTask();
+	return commandListCount;
 }
 
 bool LightingPass::IsDataValid() const noexcept {
@@ -104,70 +104,21 @@ void LightingPass::ExecuteBeginTask() noexcept {
 	ASSERT(IsDataValid());
 
 	// Check resource states:
-	// - All geometry shaders must be in render target state because they were output
-	// of the geometry pass.
-#ifdef _DEBUG
-	for (std::uint32_t i = 0U; i < GeometryPass::BUFFERS_COUNT; ++i) {
-		ASSERT(ResourceStateManager::GetResourceState(*mGeometryBuffers[i].Get()) == D3D12_RESOURCE_STATE_RENDER_TARGET);
-	}
-#endif
-
-	// - Depth buffer was used for depth testing in geometry pass, so it must be in depth write state
-	ASSERT(ResourceStateManager::GetResourceState(*mDepthBuffer) == D3D12_RESOURCE_STATE_DEPTH_WRITE);
-
-	ID3D12GraphicsCommandList& commandList = mBeginCommandListPerFrame.ResetWithNextCommandAllocator(nullptr);
-
-	CD3DX12_RESOURCE_BARRIER barriers[]
-	{
-		ResourceStateManager::ChangeResourceStateAndGetBarrier(
-			*mGeometryBuffers[GeometryPass::NORMAL_SMOOTHNESS].Get(), 
-			D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE),
-
-		ResourceStateManager::ChangeResourceStateAndGetBarrier(
-			*mGeometryBuffers[GeometryPass::BASECOLOR_METALMASK].Get(), 
-			D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE),
-
-		ResourceStateManager::ChangeResourceStateAndGetBarrier(
-			*mDepthBuffer, 
-			D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE),
-	};
-
-	const std::uint32_t barriersCount = _countof(barriers);
-	ASSERT(barriersCount == GeometryPass::BUFFERS_COUNT + 1UL);
-	commandList.ResourceBarrier(barriersCount, barriers);
-
-	commandList.ClearRenderTargetView(mRenderTargetView, DirectX::Colors::Black, 0U, nullptr);
-
-	CHECK_HR(commandList.Close());
-	CommandListExecutor::Get().ExecuteCommandListAndWaitForCompletion(commandList);
-}
-
-void LightingPass::ExecuteFinalTask() noexcept {
-	ASSERT(IsDataValid());
-
-	// Check resource states:
-	// - All geometry shaders must be in pixel shader resource state because they were used
-	// by lighting pass shaders.
+	// - All geometry buffers must be in pixel shader resource state because 
+	// RenderManager frame graph transitioned them before this pass.
 #ifdef _DEBUG
 	for (std::uint32_t i = 0U; i < GeometryPass::BUFFERS_COUNT; ++i) {
 		ASSERT(ResourceStateManager::GetResourceState(*mGeometryBuffers[i].Get()) == D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
 	}
 #endif
 
-	// - Depth buffer must be in pixel shader resource because it was used by lighting pass shader.
+	// - Depth buffer is read by lighting pass shaders, so it must be in pixel shader resource state too.
 	ASSERT(ResourceStateManager::GetResourceState(*mDepthBuffer) == D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
 
-	ID3D12GraphicsCommandList& commandList = mFinalCommandListPerFrame.ResetWithNextCommandAllocator(nullptr);
-
-	CD3DX12_RESOURCE_BARRIER barriers[]
-	{
-		ResourceStateManager::ChangeResourceStateAndGetBarrier(*mDepthBuffer, D3D12_RESOURCE_STATE_DEPTH_WRITE),
-	};
+	ID3D12GraphicsCommandList& commandList = mBeginCommandListPerFrame.ResetWithNextCommandAllocator(nullptr);
 
-	const std::uint32_t barrierCount = _countof(barriers);
-	ASSERT(barrierCount == 1UL);
-	commandList.ResourceBarrier(barrierCount, barriers);
+	commandList.ClearRenderTargetView(mRenderTargetView, DirectX::Colors::Black, 0U, nullptr);
 
 	CHECK_HR(commandList.Close());
-	CommandListExecutor::Get().ExecuteCommandListAndWaitForCompletion(commandList);
+	CommandListExecutor::Get().AddCommandList(commandList);
 }
\ No newline at end of file
@@ -10,7 +10,6 @@
 #include <LightingPass\LightingPassCmdListRecorder.h>
 
 struct D3D12_CPU_DESCRIPTOR_HANDLE;
-struct FrameCBuffer;
 struct ID3D12Resource;
 
 // Pass responsible to execute recorders related with deferred shading lighting pass
@@ -28,6 +27,7 @@ public:
 	// You should get recorders and fill them, before calling Init()
 	__forceinline CommandListRecorders& GetCommandListRecorders() noexcept { return mCommandListRecorders; }
 
+	// "ambientAccessibilityBuffer" and "blurBuffer" are used by AmbientLightPass.
 	// Preconditions:
 	// - "geometryBuffers" must not be nullptr
 	// - "geometryBuffersCount" must be greater than zero
@@ -35,23 +35,25 @@ public:
 		Microsoft::WRL::ComPtr<ID3D12Resource>* geometryBuffers, 
 		const std::uint32_t geometryBuffersCount,
 		ID3D12Resource& depthBuffer,		
+		ID3D12Resource& ambientAccessibilityBuffer,
+		ID3D12Resource& blurBuffer,
 		ID3D12Resource& diffuseIrradianceCubeMap,
 		ID3D12Resource& specularPreConvolvedCubeMap,
 		const D3D12_CPU_DESCRIPTOR_HANDLE& renderTargetView) noexcept;
 
+	// Returns the number of command lists pushed to CommandListExecutor.
+	// It does not wait for them to be executed.
 	// Preconditions:
 	// - Init() must be called first
-	void Execute(const FrameCBuffer& frameCBuffer) noexcept;
+	std::uint32_t Execute(const D3D12_GPU_VIRTUAL_ADDRESS frameCBufferGpuAddress) noexcept;
 
 private:
 	// Method used internally for validation purposes
 	bool IsDataValid() const noexcept;
 
 	void ExecuteBeginTask() noexcept;
-	void ExecuteFinalTask() noexcept;
 
 	CommandListPerFrame mBeginCommandListPerFrame;
-	CommandListPerFrame mFinalCommandListPerFrame;
 
 	// Geometry buffers created by GeometryPass
 	Microsoft::WRL::ComPtr<ID3D12Resource>* mGeometryBuffers;
@@ -5,11 +5,9 @@
 
 #include <CommandManager\CommandListPerFrame.h>
 #include <DXUtils/D3DFactory.h>
-#include <ResourceManager\FrameUploadCBufferPerFrame.h>
+#include <ResourceManager\UploadBuffer.h>
 #include <ResourceManager/VertexAndIndexBufferCreator.h>
 
-struct FrameCBuffer;
-
 // Responsible of command lists recording to be executed by CommandListExecutor.
 // This class has common data and functionality to record command lists for deferred shading light pass.
 // Steps:
@@ -50,7 +48,8 @@ public:
 	// Preconditions:
 	// - Init() must be called first
 	// - SetOutputColorBufferCpuDescriptor() must be called first
-	virtual void RecordAndPushCommandLists(const FrameCBuffer& frameCBuffer) noexcept = 0;
+	// "frameCBufferGpuAddress" is the GPU address of the FrameCBuffer of the current frame
+	virtual void RecordAndPushCommandLists(const D3D12_GPU_VIRTUAL_ADDRESS frameCBufferGpuAddress) noexcept = 0;
 
 	// This method validates all data (nullptr's, etc)
 	// When you inherit from this class, you should reimplement it to include
@@ -67,8 +66,6 @@ protected:
 
 	std::uint32_t mNumLights{ 0U };
 
-	FrameUploadCBufferPerFrame mFrameUploadCBufferPerFrame;
-
 	UploadBuffer* mImmutableUploadCBuffer{ nullptr };
 
 	UploadBuffer* mLightsUploadBuffer{ nullptr };
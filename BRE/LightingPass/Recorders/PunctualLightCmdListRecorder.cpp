@@ -129,16 +129,12 @@ void PunctualLightCmdListRecorder::InitShaderResourceViews(
 			numResources);
 }
 
-void PunctualLightCmdListRecorder::RecordAndPushCommandLists(const FrameCBuffer& frameCBuffer) noexcept {
+void PunctualLightCmdListRecorder::RecordAndPushCommandLists(const D3D12_GPU_VIRTUAL_ADDRESS frameCBufferGpuAddress) noexcept {
 	ASSERT(IsDataValid());
 	ASSERT(sPSO != nullptr);
 	ASSERT(sRootSignature != nullptr);
 	ASSERT(mRenderTargetView.ptr != 0UL);
 
-	// Update frame constants
-	UploadBuffer& uploadFrameCBuffer(mFrameUploadCBufferPerFrame.GetNextFrameCBuffer());
-	uploadFrameCBuffer.CopyData(0U, &frameCBuffer, sizeof(frameCBuffer));
-
 	ID3D12GraphicsCommandList& commandList = mCommandListPerFrame.ResetWithNextCommandAllocator(sPSO);
 
 	commandList.RSSetViewports(1U, &SettingsManager::sScreenViewport);
@@ -149,13 +145,12 @@ void PunctualLightCmdListRecorder::RecordAndPushCommandLists(const FrameCBuffer&
 	commandList.SetDescriptorHeaps(_countof(heaps), heaps);
 
 	commandList.SetGraphicsRootSignature(sRootSignature);
-	const D3D12_GPU_VIRTUAL_ADDRESS frameCBufferGpuVAddress(uploadFrameCBuffer.GetResource()->GetGPUVirtualAddress());
 	const D3D12_GPU_VIRTUAL_ADDRESS immutableCBufferGpuVAddress(mImmutableUploadCBuffer->GetResource()->GetGPUVirtualAddress());
-	commandList.SetGraphicsRootConstantBufferView(0U, frameCBufferGpuVAddress);
+	commandList.SetGraphicsRootConstantBufferView(0U, frameCBufferGpuAddress);
 	commandList.SetGraphicsRootDescriptorTable(1U, mStartLightsBufferShaderResourceView);
-	commandList.SetGraphicsRootConstantBufferView(2U, frameCBufferGpuVAddress);
+	commandList.SetGraphicsRootConstantBufferView(2U, frameCBufferGpuAddress);
 	commandList.SetGraphicsRootConstantBufferView(3U, immutableCBufferGpuVAddress);
-	commandList.SetGraphicsRootConstantBufferView(4U, frameCBufferGpuVAddress);
+	commandList.SetGraphicsRootConstantBufferView(4U, frameCBufferGpuAddress);
 	commandList.SetGraphicsRootDescriptorTable(5U, mStartPixelShaderResourceView);
 	
 	commandList.IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_POINTLIST);	
@@ -0,0 +1,121 @@
+#include "FrustumCulling.h"
+
+#include <Utils/DebugUtils.h>
+
+using namespace DirectX;
+
+namespace {
+	// We load bounding spheres as (center.x, center.y, center.z, radius)
+	static_assert(sizeof(BoundingSphere) == sizeof(XMFLOAT4), "Unexpected BoundingSphere layout");
+
+	__forceinline XMVECTOR LoadSphere(const BoundingSphere& sphere) noexcept {
+		return XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&sphere.Center));
+	}
+}
+
+namespace FrustumCulling {
+	void ExtractFrustumPlanes(
+		const XMFLOAT4X4& viewMatrix,
+		const XMFLOAT4X4& projectionMatrix,
+		FrustumPlanes& frustumPlanes) noexcept
+	{
+		// Gribb/Hartmann method. As we use row vectors (p * M),
+		// planes are built from the columns of the view projection matrix,
+		// so we transpose it to access them as rows.
+		// Direct3D clip space z is in [0, w], then the near plane is the third column.
+		const XMMATRIX viewProjection = XMMatrixMultiply(XMLoadFloat4x4(&viewMatrix), XMLoadFloat4x4(&projectionMatrix));
+		const XMMATRIX columns = XMMatrixTranspose(viewProjection);
+
+		const XMVECTOR planes[PLANES_COUNT] = {
+			XMVectorAdd(columns.r[3U], columns.r[0U]),
+			XMVectorSubtract(columns.r[3U], columns.r[0U]),
+			XMVectorAdd(columns.r[3U], columns.r[1U]),
+			XMVectorSubtract(columns.r[3U], columns.r[1U]),
+			columns.r[2U],
+			XMVectorSubtract(columns.r[3U], columns.r[2U]),
+		};
+
+		for (std::uint32_t i = 0U; i < PLANES_COUNT; ++i) {
+			XMStoreFloat4(&frustumPlanes.mPlanes[i], XMPlaneNormalize(planes[i]));
+		}
+	}
+
+	bool IsSphereInsideFrustum(
+		const FrustumPlanes& frustumPlanes,
+		const BoundingSphere& sphere) noexcept
+	{
+		const XMVECTOR center = XMLoadFloat3(&sphere.Center);
+		const XMVECTOR negativeRadius = XMVectorReplicate(-sphere.Radius);
+		for (std::uint32_t i = 0U; i < PLANES_COUNT; ++i) {
+			const XMVECTOR distance = XMPlaneDotCoord(XMLoadFloat4(&frustumPlanes.mPlanes[i]), center);
+			if (XMVector4Less(distance, negativeRadius)) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	std::uint32_t CullSpheres(
+		const FrustumPlanes& frustumPlanes,
+		const BoundingSphere* spheres,
+		const std::uint32_t sphereCount,
+		std::uint8_t* visibilityFlags) noexcept
+	{
+		ASSERT(spheres != nullptr);
+		ASSERT(visibilityFlags != nullptr);
+		ASSERT(sphereCount > 0U);
+
+		// Splat planes coefficients once
+		XMVECTOR planeA[PLANES_COUNT];
+		XMVECTOR planeB[PLANES_COUNT];
+		XMVECTOR planeC[PLANES_COUNT];
+		XMVECTOR planeD[PLANES_COUNT];
+		for (std::uint32_t i = 0U; i < PLANES_COUNT; ++i) {
+			const XMVECTOR plane = XMLoadFloat4(&frustumPlanes.mPlanes[i]);
+			planeA[i] = XMVectorSplatX(plane);
+			planeB[i] = XMVectorSplatY(plane);
+			planeC[i] = XMVectorSplatZ(plane);
+			planeD[i] = XMVectorSplatW(plane);
+		}
+
+		std::uint32_t visibleCount{ 0U };
+
+		// Test 4 spheres at a time. After transposing them, we get
+		// all x, y, z and radius values in separate registers.
+		const std::uint32_t groupedSphereCount{ sphereCount & ~3U };
+		for (std::uint32_t i = 0U; i < groupedSphereCount; i += 4U) {
+			XMMATRIX group(
+				LoadSphere(spheres[i]),
+				LoadSphere(spheres[i + 1U]),
+				LoadSphere(spheres[i + 2U]),
+				LoadSphere(spheres[i + 3U]));
+			group = XMMatrixTranspose(group);
+			const XMVECTOR negativeRadius = XMVectorNegate(group.r[3U]);
+
+			XMVECTOR insideMask = XMVectorTrueInt();
+			for (std::uint32_t j = 0U; j < PLANES_COUNT; ++j) {
+				XMVECTOR distance = XMVectorMultiplyAdd(group.r[0U], planeA[j], planeD[j]);
+				distance = XMVectorMultiplyAdd(group.r[1U], planeB[j], distance);
+				distance = XMVectorMultiplyAdd(group.r[2U], planeC[j], distance);
+				insideMask = XMVectorAndInt(insideMask, XMVectorGreaterOrEqual(distance, negativeRadius));
+			}
+
+			XMUINT4 mask;
+			XMStoreUInt4(&mask, insideMask);
+			visibilityFlags[i] = static_cast<std::uint8_t>(mask.x != 0U);
+			visibilityFlags[i + 1U] = static_cast<std::uint8_t>(mask.y != 0U);
+			visibilityFlags[i + 2U] = static_cast<std::uint8_t>(mask.z != 0U);
+			visibilityFlags[i + 3U] = static_cast<std::uint8_t>(mask.w != 0U);
+			visibleCount += visibilityFlags[i] + visibilityFlags[i + 1U] + visibilityFlags[i + 2U] + visibilityFlags[i + 3U];
+		}
+
+		// Remaining spheres
+		for (std::uint32_t i = groupedSphereCount; i < sphereCount; ++i) {
+			visibilityFlags[i] = static_cast<std::uint8_t>(IsSphereInsideFrustum(frustumPlanes, spheres[i]));
+			visibleCount += visibilityFlags[i];
+		}
+
+		return visibleCount;
+	}
+}
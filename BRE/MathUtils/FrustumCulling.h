@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <DirectXCollision.h>
+#include <DirectXMath.h>
+
+// To cull bounding spheres against a view frustum.
+// Spheres are tested in groups of 4 (structure of arrays)
+// against the 6 frustum planes using DirectXMath SIMD operations.
+namespace FrustumCulling {
+	enum Planes {
+		LEFT_PLANE = 0U,
+		RIGHT_PLANE,
+		BOTTOM_PLANE,
+		TOP_PLANE,
+		NEAR_PLANE,
+		FAR_PLANE,
+		PLANES_COUNT
+	};
+
+	// World space frustum planes.
+	// Each plane is stored as (a, b, c, d) with a normalized (a, b, c)
+	// that points to the inside of the frustum. Then, a point p
+	// is inside the plane if dot(p, (a, b, c)) + d >= 0
+	struct FrustumPlanes {
+		DirectX::XMFLOAT4 mPlanes[PLANES_COUNT];
+	};
+
+	// View and projection matrices must not be transposed
+	// (row vector convention, like the ones returned by Camera)
+	void ExtractFrustumPlanes(
+		const DirectX::XMFLOAT4X4& viewMatrix,
+		const DirectX::XMFLOAT4X4& projectionMatrix,
+		FrustumPlanes& frustumPlanes) noexcept;
+
+	bool IsSphereInsideFrustum(
+		const FrustumPlanes& frustumPlanes,
+		const DirectX::BoundingSphere& sphere) noexcept;
+
+	// Stores 1 in visibilityFlags[i] if spheres[i] intersects the frustum, 0 otherwise.
+	// Returns the number of visible spheres.
+	// Preconditions:
+	// - "spheres" must not be nullptr
+	// - "visibilityFlags" must not be nullptr
+	// - "sphereCount" must be greater than zero
+	std::uint32_t CullSpheres(
+		const FrustumPlanes& frustumPlanes,
+		const DirectX::BoundingSphere* spheres,
+		const std::uint32_t sphereCount,
+		std::uint8_t* visibilityFlags) noexcept;
+}
+
@@ -0,0 +1,88 @@
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+#include <cstdio>
+#include <vector>
+
+#include <GeometryGenerator/GeometryGenerator.h>
+#include <ModelManager/CookedModel.h>
+#include <ModelManager/MeshDataConverter.h>
+#include <ModelManager/MeshletBuilder.h>
+#include <ModelManager/MeshOptimizer.h>
+#include <ModelManager/MeshSimplifier.h>
+
+// Offline tool to cook models (any format supported by assimp) to CookedModel format,
+// so they are loaded at runtime without assimp (Model loads files with CookedModel::sFileExtension).
+// Usage: ModelCooker <input model file> <output cooked model file>
+int main(int argc, char* argv[]) {
+	if (argc != 3) {
+		std::fprintf(stderr, "Usage: ModelCooker <input model file> <output .%s file>\n", CookedModel::sFileExtension);
+		return 1;
+	}
+
+	const char* inputFilePath{ argv[1] };
+	const char* outputFilePath{ argv[2] };
+
+	Assimp::Importer importer;
+	const aiScene* scene{ importer.ReadFile(inputFilePath, MeshDataConverter::GetImportFlags()) };
+	if (scene == nullptr || scene->HasMeshes() == false) {
+		std::fprintf(stderr, "%s cannot be imported: %s\n", inputFilePath, importer.GetErrorString());
+		return 1;
+	}
+
+	std::vector<GeometryGenerator::MeshData> meshes(scene->mNumMeshes);
+	std::vector<std::vector<MeshLod>> meshLods(scene->mNumMeshes);
+	std::vector<std::vector<Meshlet>> meshMeshlets(scene->mNumMeshes);
+	std::size_t vertexCount{ 0UL };
+	std::size_t indexCount{ 0UL };
+	for (std::uint32_t i = 0U; i < scene->mNumMeshes; ++i) {
+		GeometryGenerator::MeshData& meshData = meshes[i];
+		MeshDataConverter::ConvertMesh(*scene->mMeshes[i], meshData);
+
+		const MeshOptimizer::VertexCacheStatistics sourceStatistics{
+			MeshOptimizer::AnalyzeVertexCache(meshData.mIndices32.data(), meshData.mIndices32.size(), meshData.mVertices.size())
+		};
+		MeshOptimizer::OptimizeMesh(meshData);
+
+		std::vector<MeshLod>& lods = meshLods[i];
+		MeshSimplifier::GenerateLods(meshData, lods);
+		for (std::size_t j = 0UL; j < lods.size(); ++j) {
+			std::printf("Mesh %u: LOD %zu, %u triangles, error %.4f\n", i, j, lods[j].mIndexCount / 3U, lods[j].mError);
+		}
+
+		// Meshlets reorder the full detail triangles, so they are optimized again
+		std::vector<Meshlet>& meshlets = meshMeshlets[i];
+		MeshletBuilder::BuildMeshlets(meshData, lods[0U].mIndexCount, meshlets);
+		MeshOptimizer::OptimizeMeshletVertexCache(meshData.mIndices32.data(), meshData.mVertices.size(), meshlets.data(), meshlets.size());
+		std::printf("Mesh %u: %zu meshlets\n", i, meshlets.size());
+
+		// Full detail level of detail, as it is drawn
+		const MeshOptimizer::VertexCacheStatistics optimizedStatistics{
+			MeshOptimizer::AnalyzeVertexCache(meshData.mIndices32.data(), lods[0U].mIndexCount, meshData.mVertices.size())
+		};
+		std::printf(
+			"Mesh %u: ACMR %.3f -> %.3f, ATVR %.3f -> %.3f\n",
+			i,
+			sourceStatistics.mAcmr,
+			optimizedStatistics.mAcmr,
+			sourceStatistics.mAtvr,
+			optimizedStatistics.mAtvr);
+
+		vertexCount += meshData.mVertices.size();
+		indexCount += meshData.mIndices32.size();
+	}
+
+	if (CookedModel::Write(outputFilePath, meshes, meshLods, meshMeshlets) == false) {
+		std::fprintf(stderr, "%s cannot be written\n", outputFilePath);
+		return 1;
+	}
+
+	std::printf(
+		"%s -> %s: %zu meshes, %zu vertices, %zu indices\n",
+		inputFilePath,
+		outputFilePath,
+		meshes.size(),
+		vertexCount,
+		indexCount);
+
+	return 0;
+}
@@ -0,0 +1,265 @@
+#include "CookedModel.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cstdio>
+
+#include <Utils/DebugUtils.h>
+
+namespace {
+	std::uint64_t AlignOffset(const std::uint64_t offset) noexcept {
+		return (offset + CookedModel::sDataAlignment - 1UL) & ~(CookedModel::sDataAlignment - 1UL);
+	}
+
+	void ComputeBoundingBox(
+		const GeometryGenerator::MeshData& meshData,
+		CookedModel::MeshHeader& meshHeader) noexcept
+	{
+		ASSERT(meshData.mVertices.empty() == false);
+
+		DirectX::XMFLOAT3 minPosition{ FLT_MAX, FLT_MAX, FLT_MAX };
+		DirectX::XMFLOAT3 maxPosition{ -FLT_MAX, -FLT_MAX, -FLT_MAX };
+		for (const GeometryGenerator::Vertex& vertex : meshData.mVertices) {
+			minPosition.x = std::min<float>(minPosition.x, vertex.mPosition.x);
+			minPosition.y = std::min<float>(minPosition.y, vertex.mPosition.y);
+			minPosition.z = std::min<float>(minPosition.z, vertex.mPosition.z);
+			maxPosition.x = std::max<float>(maxPosition.x, vertex.mPosition.x);
+			maxPosition.y = std::max<float>(maxPosition.y, vertex.mPosition.y);
+			maxPosition.z = std::max<float>(maxPosition.z, vertex.mPosition.z);
+		}
+
+		meshHeader.mBoundingBoxCenter = DirectX::XMFLOAT3(
+			(minPosition.x + maxPosition.x) * 0.5f,
+			(minPosition.y + maxPosition.y) * 0.5f,
+			(minPosition.z + maxPosition.z) * 0.5f);
+		meshHeader.mBoundingBoxExtents = DirectX::XMFLOAT3(
+			(maxPosition.x - minPosition.x) * 0.5f,
+			(maxPosition.y - minPosition.y) * 0.5f,
+			(maxPosition.z - minPosition.z) * 0.5f);
+	}
+
+	bool WriteData(std::FILE& file, const void* data, const std::size_t dataSize) noexcept {
+		return std::fwrite(data, 1UL, dataSize, &file) == dataSize;
+	}
+
+	bool WritePadding(std::FILE& file, const std::uint64_t currentOffset) noexcept {
+		const std::uint8_t padding[CookedModel::sDataAlignment]{};
+		const std::size_t paddingSize{ static_cast<std::size_t>(AlignOffset(currentOffset) - currentOffset) };
+		return WriteData(file, padding, paddingSize);
+	}
+}
+
+namespace CookedModel {
+	bool Write(
+		const char* filePath,
+		const std::vector<GeometryGenerator::MeshData>& meshes,
+		const std::vector<std::vector<MeshLod>>& meshLods,
+		const std::vector<std::vector<Meshlet>>& meshMeshlets) noexcept
+	{
+		ASSERT(filePath != nullptr);
+		ASSERT(meshes.empty() == false);
+		ASSERT(meshLods.size() == meshes.size());
+		ASSERT(meshMeshlets.size() == meshes.size());
+
+		const std::size_t meshCount{ meshes.size() };
+
+		FileHeader fileHeader{};
+		fileHeader.mMagicNumber = sMagicNumber;
+		fileHeader.mVersion = sVersion;
+		fileHeader.mMeshCount = static_cast<std::uint32_t>(meshCount);
+		fileHeader.mVertexSize = sizeof(VertexCompressor::PackedVertex);
+
+		// Compute data offsets
+		std::vector<MeshHeader> meshHeaders(meshCount);
+		std::uint64_t offset{ sizeof(FileHeader) + sizeof(MeshHeader) * meshCount };
+		for (std::size_t i = 0UL; i < meshCount; ++i) {
+			const GeometryGenerator::MeshData& meshData = meshes[i];
+			ASSERT(meshData.mVertices.empty() == false);
+			ASSERT(meshData.mIndices32.empty() == false);
+
+			MeshHeader& meshHeader = meshHeaders[i];
+			meshHeader.mVertexCount = static_cast<std::uint32_t>(meshData.mVertices.size());
+			meshHeader.mIndexCount = static_cast<std::uint32_t>(meshData.mIndices32.size());
+			ComputeBoundingBox(meshData, meshHeader);
+			meshHeader.mPositionQuantization = VertexCompressor::ComputePositionQuantization(
+				meshData.mVertices.data(),
+				meshData.mVertices.size());
+
+			const std::vector<MeshLod>& lods = meshLods[i];
+			ASSERT(lods.empty() == false);
+			ASSERT(lods.size() <= sMaxMeshLodCount);
+			meshHeader.mLodCount = static_cast<std::uint32_t>(lods.size());
+			std::copy(lods.begin(), lods.end(), meshHeader.mLods);
+			meshHeader.mMeshletCount = static_cast<std::uint32_t>(meshMeshlets[i].size());
+
+			offset = AlignOffset(offset);
+			meshHeader.mVertexDataOffset = offset;
+			offset += sizeof(VertexCompressor::PackedVertex) * meshHeader.mVertexCount;
+
+			offset = AlignOffset(offset);
+			meshHeader.mIndexDataOffset = offset;
+			offset += sizeof(std::uint32_t) * meshHeader.mIndexCount;
+
+			offset = AlignOffset(offset);
+			meshHeader.mMeshletDataOffset = offset;
+			offset += sizeof(Meshlet) * meshHeader.mMeshletCount;
+		}
+
+		std::FILE* file{ nullptr };
+#ifdef _WIN32
+		if (fopen_s(&file, filePath, "wb") != 0) {
+			file = nullptr;
+		}
+#else
+		file = std::fopen(filePath, "wb");
+#endif
+		if (file == nullptr) {
+			return false;
+		}
+
+		bool result =
+			WriteData(*file, &fileHeader, sizeof(FileHeader)) &&
+			WriteData(*file, meshHeaders.data(), sizeof(MeshHeader) * meshCount);
+
+		std::vector<VertexCompressor::PackedVertex> packedVertices;
+		offset = sizeof(FileHeader) + sizeof(MeshHeader) * meshCount;
+		for (std::size_t i = 0UL; i < meshCount && result; ++i) {
+			const GeometryGenerator::MeshData& meshData = meshes[i];
+			const MeshHeader& meshHeader = meshHeaders[i];
+
+			result = WritePadding(*file, offset);
+			offset = meshHeader.mVertexDataOffset;
+			packedVertices.resize(meshHeader.mVertexCount);
+			VertexCompressor::EncodeVertices(
+				meshData.mVertices.data(),
+				meshHeader.mVertexCount,
+				meshHeader.mPositionQuantization,
+				packedVertices.data());
+			const std::size_t vertexDataSize{ sizeof(VertexCompressor::PackedVertex) * meshHeader.mVertexCount };
+			result = result && WriteData(*file, packedVertices.data(), vertexDataSize);
+			offset += vertexDataSize;
+
+			result = result && WritePadding(*file, offset);
+			offset = meshHeader.mIndexDataOffset;
+			const std::size_t indexDataSize{ sizeof(std::uint32_t) * meshHeader.mIndexCount };
+			result = result && WriteData(*file, meshData.mIndices32.data(), indexDataSize);
+			offset += indexDataSize;
+
+			result = result && WritePadding(*file, offset);
+			offset = meshHeader.mMeshletDataOffset;
+			const std::size_t meshletDataSize{ sizeof(Meshlet) * meshHeader.mMeshletCount };
+			result = result && WriteData(*file, meshMeshlets[i].data(), meshletDataSize);
+			offset += meshletDataSize;
+		}
+
+		result = (std::fclose(file) == 0) && result;
+
+		return result;
+	}
+
+	bool Read(
+		const std::uint8_t* data,
+		const std::size_t dataSize,
+		std::vector<MeshView>& meshes) noexcept
+	{
+		ASSERT(data != nullptr);
+		ASSERT(reinterpret_cast<std::uintptr_t>(data) % sDataAlignment == 0UL);
+
+		meshes.clear();
+
+		if (dataSize < sizeof(FileHeader)) {
+			return false;
+		}
+
+		const FileHeader& fileHeader = *reinterpret_cast<const FileHeader*>(data);
+		if (fileHeader.mMagicNumber != sMagicNumber ||
+			fileHeader.mVersion != sVersion ||
+			fileHeader.mVertexSize != sizeof(VertexCompressor::PackedVertex) ||
+			fileHeader.mMeshCount == 0U) {
+			return false;
+		}
+
+		const std::uint64_t meshCount{ fileHeader.mMeshCount };
+		if (dataSize < sizeof(FileHeader) + sizeof(MeshHeader) * meshCount) {
+			return false;
+		}
+
+		const MeshHeader* meshHeaders{ reinterpret_cast<const MeshHeader*>(data + sizeof(FileHeader)) };
+		meshes.resize(static_cast<std::size_t>(meshCount));
+		for (std::size_t i = 0UL; i < meshCount; ++i) {
+			const MeshHeader& meshHeader = meshHeaders[i];
+
+			const std::uint64_t vertexDataSize{ sizeof(VertexCompressor::PackedVertex) * static_cast<std::uint64_t>(meshHeader.mVertexCount) };
+			const std::uint64_t indexDataSize{ sizeof(std::uint32_t) * static_cast<std::uint64_t>(meshHeader.mIndexCount) };
+			const std::uint64_t meshletDataSize{ sizeof(Meshlet) * static_cast<std::uint64_t>(meshHeader.mMeshletCount) };
+			if (meshHeader.mVertexCount == 0U ||
+				meshHeader.mIndexCount == 0U ||
+				meshHeader.mVertexDataOffset % sDataAlignment != 0UL ||
+				meshHeader.mIndexDataOffset % sDataAlignment != 0UL ||
+				meshHeader.mMeshletDataOffset % sDataAlignment != 0UL ||
+				meshHeader.mVertexDataOffset > dataSize ||
+				meshHeader.mIndexDataOffset > dataSize ||
+				meshHeader.mMeshletDataOffset > dataSize ||
+				vertexDataSize > dataSize - meshHeader.mVertexDataOffset ||
+				indexDataSize > dataSize - meshHeader.mIndexDataOffset ||
+				meshletDataSize > dataSize - meshHeader.mMeshletDataOffset ||
+				meshHeader.mLodCount == 0U ||
+				meshHeader.mLodCount > sMaxMeshLodCount) {
+				meshes.clear();
+				return false;
+			}
+
+			for (std::uint32_t j = 0U; j < meshHeader.mLodCount; ++j) {
+				const MeshLod& lod = meshHeader.mLods[j];
+				if (lod.mIndexCount == 0U ||
+					lod.mFirstIndex > meshHeader.mIndexCount ||
+					lod.mIndexCount > meshHeader.mIndexCount - lod.mFirstIndex) {
+					meshes.clear();
+					return false;
+				}
+			}
+
+			// Indices must be in the mesh vertices, as they are drawn from a vertex buffer
+			// shared with other meshes (see VertexAndIndexBufferCreator)
+			const std::uint32_t* indices{ reinterpret_cast<const std::uint32_t*>(data + meshHeader.mIndexDataOffset) };
+			std::uint32_t maxIndex{ 0U };
+			for (std::uint32_t j = 0U; j < meshHeader.mIndexCount; ++j) {
+				maxIndex = std::max(maxIndex, indices[j]);
+			}
+			if (maxIndex >= meshHeader.mVertexCount) {
+				meshes.clear();
+				return false;
+			}
+
+			// Meshlets must be in the full detail level of detail
+			const Meshlet* meshlets{ reinterpret_cast<const Meshlet*>(data + meshHeader.mMeshletDataOffset) };
+			const MeshLod& fullDetailLod = meshHeader.mLods[0U];
+			for (std::uint32_t j = 0U; j < meshHeader.mMeshletCount; ++j) {
+				const Meshlet& meshlet = meshlets[j];
+				if (meshlet.mIndexCount == 0U ||
+					meshlet.mIndexCount % 3U != 0U ||
+					meshlet.mFirstIndex < fullDetailLod.mFirstIndex ||
+					meshlet.mFirstIndex - fullDetailLod.mFirstIndex > fullDetailLod.mIndexCount ||
+					meshlet.mIndexCount > fullDetailLod.mIndexCount - (meshlet.mFirstIndex - fullDetailLod.mFirstIndex)) {
+					meshes.clear();
+					return false;
+				}
+			}
+
+			MeshView& meshView = meshes[i];
+			meshView.mVertices = reinterpret_cast<const VertexCompressor::PackedVertex*>(data + meshHeader.mVertexDataOffset);
+			meshView.mVertexCount = meshHeader.mVertexCount;
+			meshView.mPositionQuantization = meshHeader.mPositionQuantization;
+			meshView.mIndices = reinterpret_cast<const std::uint32_t*>(data + meshHeader.mIndexDataOffset);
+			meshView.mIndexCount = meshHeader.mIndexCount;
+			meshView.mBoundingBoxCenter = meshHeader.mBoundingBoxCenter;
+			meshView.mBoundingBoxExtents = meshHeader.mBoundingBoxExtents;
+			meshView.mLods = meshHeader.mLods;
+			meshView.mLodCount = meshHeader.mLodCount;
+			meshView.mMeshlets = meshHeader.mMeshletCount != 0U ? meshlets : nullptr;
+			meshView.mMeshletCount = meshHeader.mMeshletCount;
+		}
+
+		return true;
+	}
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <DirectXMath.h>
+#include <vector>
+
+#include <GeometryGenerator/GeometryGenerator.h>
+#include <ModelManager/MeshLod.h>
+#include <ModelManager/Meshlet.h>
+#include <ModelManager/VertexCompressor.h>
+
+// Binary model format, written offline by ModelCooker, so models can be
+// loaded at runtime without importing and post processing them with assimp.
+// Vertex and index data are stored as VertexCompressor::PackedVertex (with the position
+// quantization of each mesh in its header) and 32 bits indices, in vertex and index buffer layout,
+// so they are copied in place from a memory mapped file to the buffers. Levels of detail indices follow the full detail ones
+// in the index data of each mesh (see MeshLod), and full detail indices are sorted by meshlet (see Meshlet).
+//
+// File layout (little endian):
+// - FileHeader
+// - MeshHeader per mesh
+// - Vertex, index and meshlet data of each mesh (offsets are from the beginning of the file,
+//   and they are aligned to sDataAlignment bytes)
+namespace CookedModel {
+	// File extension of cooked models (without dot)
+	const char sFileExtension[]{ "brm" };
+
+	// "BRM" followed by a zero byte
+	const std::uint32_t sMagicNumber{ 0x004D5242 };
+
+	// It must be incremented each time the layout changes, as the
+	// loader rejects files with a different version.
+	const std::uint32_t sVersion{ 4U };
+
+	const std::uint64_t sDataAlignment{ 16UL };
+
+	struct FileHeader {
+		std::uint32_t mMagicNumber;
+		std::uint32_t mVersion;
+		std::uint32_t mMeshCount;
+		std::uint32_t mVertexSize;
+	};
+
+	struct MeshHeader {
+		std::uint64_t mVertexDataOffset;
+		std::uint64_t mIndexDataOffset;
+		std::uint32_t mVertexCount;
+		std::uint32_t mIndexCount;
+		DirectX::XMFLOAT3 mBoundingBoxCenter;
+		DirectX::XMFLOAT3 mBoundingBoxExtents;
+		std::uint32_t mLodCount;
+		std::uint32_t mMeshletCount;
+		MeshLod mLods[sMaxMeshLodCount];
+		std::uint64_t mMeshletDataOffset;
+		VertexCompressor::PositionQuantization mPositionQuantization;
+	};
+
+	// Mesh data that points to the cooked model data (it is not copied),
+	// so it is valid while the data is.
+	struct MeshView {
+		const VertexCompressor::PackedVertex* mVertices{ nullptr };
+		std::uint32_t mVertexCount{ 0U };
+		VertexCompressor::PositionQuantization mPositionQuantization;
+		const std::uint32_t* mIndices{ nullptr };
+		std::uint32_t mIndexCount{ 0U };
+		DirectX::XMFLOAT3 mBoundingBoxCenter{ 0.0f, 0.0f, 0.0f };
+		DirectX::XMFLOAT3 mBoundingBoxExtents{ 0.0f, 0.0f, 0.0f };
+		const MeshLod* mLods{ nullptr };
+		std::uint32_t mLodCount{ 0U };
+		const Meshlet* mMeshlets{ nullptr };
+		std::uint32_t mMeshletCount{ 0U };
+	};
+
+	// Returns false if the file cannot be written.
+	// Preconditions:
+	// - "filePath" must not be nullptr
+	// - "meshes" must not be empty, and each mesh must have vertices and indices.
+	// - "meshLods" must have the levels of detail of each mesh (see MeshSimplifier::GenerateLods),
+	//   with at least one level of detail and no more than sMaxMeshLodCount.
+	// - "meshMeshlets" must have the meshlets of each mesh (see MeshletBuilder::BuildMeshlets),
+	//   that can be empty.
+	bool Write(
+		const char* filePath,
+		const std::vector<GeometryGenerator::MeshData>& meshes,
+		const std::vector<std::vector<MeshLod>>& meshLods,
+		const std::vector<std::vector<Meshlet>>& meshMeshlets) noexcept;
+
+	// Validates the cooked model in "data" and fills "meshes" with views to it.
+	// Returns false if data is not a valid cooked model (wrong magic number,
+	// version, vertex size or out of bounds data, indices, levels of detail or meshlets)
+	// Preconditions:
+	// - "data" must be aligned to sDataAlignment bytes (memory mapped files are)
+	bool Read(
+		const std::uint8_t* data,
+		const std::size_t dataSize,
+		std::vector<MeshView>& meshes) noexcept;
+}
@@ -1,16 +1,23 @@
 #pragma once
 
 #include <cstdint>
+#include <DirectXCollision.h>
+#include <vector>
 
 #include <GeometryGenerator/GeometryGenerator.h>
+#include <ModelManager/CookedModel.h>
+#include <ModelManager/Meshlet.h>
+#include <ModelManager/MeshLod.h>
+#include <ModelManager/VertexCompressor.h>
 #include <ResourceManager\VertexAndIndexBufferCreator.h>
 #include <Utils/DebugUtils.h>
 
 struct aiMesh;
-struct ID3D12GraphicsCommandList;
 class Model;
 
 // Stores model's mesh vertex and buffer data.
+// Vertex buffers store VertexCompressor::PackedVertex, and positions must be
+// dequantized with GetPositionQuantization()
 class Mesh {
 	friend class Model;
 
@@ -35,23 +42,41 @@ public:
 		return mIndexBufferData;
 	}
 
+	// Object space axis aligned bounding box.
+	// It is computed once, when the mesh is created.
+	__forceinline const DirectX::BoundingBox& GetBoundingBox() const noexcept { return mBoundingBox; }
+
+	// Levels of detail, from full detail to coarsest. Their indices
+	// are stored in the index buffer, one level of detail after the other.
+	__forceinline const std::vector<MeshLod>& GetLods() const noexcept { return mLods; }
+
+	// Meshlets of the full detail level of detail. It is empty
+	// if the mesh is too small to be worth culling its meshlets.
+	__forceinline const std::vector<Meshlet>& GetMeshlets() const noexcept { return mMeshlets; }
+
+	__forceinline const VertexCompressor::PositionQuantization& GetPositionQuantization() const noexcept { 
+		return mPositionQuantization; 
+	}
+
 private:
-	// Command lists are used to store buffers creation (vertex and index per mesh)
-	// "commandList" must be executed after calling these methods, to create the commited resource.
+	// Vertex and index buffers data is uploaded by TransferManager.
+	// It must be flushed before the buffers are used.
+	explicit Mesh(const aiMesh& mesh);
+	explicit Mesh(const GeometryGenerator::MeshData& meshData);
+	explicit Mesh(const CookedModel::MeshView& meshView);
+
+	// Releases the shared vertex and index buffers (see VertexAndIndexBufferCreator::CreateShared*Buffer()).
+	// Buffer data is not valid after it.
 	// Preconditions:
-	// - "commandList" must be in recorded state before calling these method.
-	explicit Mesh(
-		const aiMesh& mesh, 
-		ID3D12GraphicsCommandList& commandList,
-		Microsoft::WRL::ComPtr<ID3D12Resource>& uploadVertexBuffer,
-		Microsoft::WRL::ComPtr<ID3D12Resource>& uploadIndexBuffer);
-
-	explicit Mesh(
-		const GeometryGenerator::MeshData& meshData, 
-		ID3D12GraphicsCommandList& commandList,
-		Microsoft::WRL::ComPtr<ID3D12Resource>& uploadVertexBuffer,
-		Microsoft::WRL::ComPtr<ID3D12Resource>& uploadIndexBuffer);
+	// - GPU must have finished using the buffers
+	void ReleaseBuffers() noexcept;
 	
 	VertexAndIndexBufferCreator::VertexBufferData mVertexBufferData;
 	VertexAndIndexBufferCreator::IndexBufferData mIndexBufferData;
+	std::uint64_t mVertexBufferKey{ 0UL };
+	std::uint64_t mIndexBufferKey{ 0UL };
+	DirectX::BoundingBox mBoundingBox;
+	std::vector<MeshLod> mLods;
+	std::vector<Meshlet> mMeshlets;
+	VertexCompressor::PositionQuantization mPositionQuantization;
 };
\ No newline at end of file
@@ -0,0 +1,67 @@
+#include "MeshDataConverter.h"
+
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+#include <ModelManager/TangentGenerator.h>
+#include <Utils/DebugUtils.h>
+
+using namespace DirectX;
+
+namespace MeshDataConverter {
+	std::uint32_t GetImportFlags() noexcept {
+		return aiProcessPreset_TargetRealtime_Fast | aiProcess_ConvertToLeftHanded;
+	}
+
+	void ConvertMesh(const aiMesh& mesh, GeometryGenerator::MeshData& meshData) noexcept {
+		ASSERT(meshData.mVertices.empty());
+		ASSERT(meshData.mIndices32.empty());
+
+		// Positions and Normals
+		const std::size_t numVertices{ mesh.mNumVertices };
+		ASSERT(numVertices > 0U);
+		ASSERT(mesh.HasNormals());
+		meshData.mVertices.resize(numVertices);
+		for (std::uint32_t i = 0U; i < numVertices; ++i) {
+			meshData.mVertices[i].mPosition = XMFLOAT3(reinterpret_cast<const float*>(&mesh.mVertices[i]));
+			meshData.mVertices[i].mNormal = XMFLOAT3(reinterpret_cast<const float*>(&mesh.mNormals[i]));
+		}
+		
+		// Texture Coordinates (if any)
+		if (mesh.HasTextureCoords(0U)) {
+			ASSERT(mesh.GetNumUVChannels() == 1U);
+			const aiVector3D* aiTextureCoordinates{ mesh.mTextureCoords[0U] };
+			ASSERT(aiTextureCoordinates != nullptr);
+			for (std::uint32_t i = 0U; i < numVertices; i++) {
+				meshData.mVertices[i].mUV = XMFLOAT2(reinterpret_cast<const float*>(&aiTextureCoordinates[i]));
+			}
+		}
+		
+		// Indices
+		ASSERT(mesh.HasFaces());
+		const std::uint32_t numFaces{ mesh.mNumFaces };
+		for (std::uint32_t i = 0U; i < numFaces; ++i) {
+			const aiFace* face = &mesh.mFaces[i];
+			ASSERT(face != nullptr);
+			// We only allow triangles
+			ASSERT(face->mNumIndices == 3U);
+
+			meshData.mIndices32.push_back(face->mIndices[0U]);
+			meshData.mIndices32.push_back(face->mIndices[1U]);
+			meshData.mIndices32.push_back(face->mIndices[2U]);
+		}
+
+		// Tangents
+		if (mesh.HasTangentsAndBitangents()) {
+			for (std::uint32_t i = 0U; i < numVertices; ++i) {
+				meshData.mVertices[i].mTangent = XMFLOAT3(reinterpret_cast<const float*>(&mesh.mTangents[i]));
+			}
+		}
+		else {
+			// The workspace is reused by all the meshes converted by the same thread,
+			// so it does not allocate once it is big enough for the largest mesh.
+			static thread_local TangentGenerator::Workspace workspace;
+			TangentGenerator::ComputeTangents(meshData, workspace);
+		}
+	}
+}
\ No newline at end of file
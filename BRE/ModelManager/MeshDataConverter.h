@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+
+#include <GeometryGenerator/GeometryGenerator.h>
+
+struct aiMesh;
+
+// To convert meshes imported by assimp to GeometryGenerator::MeshData.
+// It is used at runtime (Model) and offline (ModelCooker), so
+// both get the same vertices and indices.
+namespace MeshDataConverter {
+	// Post processing flags that must be used to import models
+	std::uint32_t GetImportFlags() noexcept;
+
+	// If mesh does not have tangents, then they are computed (with a workspace per thread,
+	// see TangentGenerator::Workspace).
+	// Preconditions:
+	// - "mesh" must have vertices, normals and triangle faces.
+	// - "meshData" must be empty
+	void ConvertMesh(const aiMesh& mesh, GeometryGenerator::MeshData& meshData) noexcept;
+}
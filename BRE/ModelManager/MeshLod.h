@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstdint>
+
+// Maximum number of levels of detail per mesh (including the full detail one)
+const std::uint32_t sMaxMeshLodCount{ 4U };
+
+// Level of detail of a mesh. All the levels of detail share the vertex buffer,
+// and their indices are stored one after the other in the index buffer.
+struct MeshLod {
+	std::uint32_t mFirstIndex{ 0U };
+	std::uint32_t mIndexCount{ 0U };
+
+	// Simplification error relative to the mesh bounding sphere radius
+	// (object space error / radius). It is zero for the full detail level.
+	float mError{ 0.0f };
+};
@@ -0,0 +1,488 @@
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <Utils/DebugUtils.h>
+
+namespace {
+	const std::uint32_t sInvalidIndex{ 0xFFFFFFFF };
+
+	// First in first out cache simulation, with a time stamp per vertex.
+	// A vertex is in the cache if it was inserted less than "cacheSize" insertions ago.
+	class VertexCache {
+	public:
+		explicit VertexCache(const std::size_t vertexCount, const std::uint32_t cacheSize)
+			: mTimeStamps(vertexCount, 0U)
+			, mCacheSize(cacheSize)
+			, mTime(cacheSize + 1U)
+		{
+		}
+
+		// Returns true if it was a miss
+		__forceinline bool Access(const std::uint32_t vertexIndex) noexcept {
+			ASSERT(vertexIndex < mTimeStamps.size());
+			if (mTime - mTimeStamps[vertexIndex] > mCacheSize) {
+				mTimeStamps[vertexIndex] = mTime;
+				++mTime;
+				return true;
+			}
+
+			return false;
+		}
+
+		__forceinline void Flush() noexcept { mTime += mCacheSize + 1U; }
+
+	private:
+		std::vector<std::uint32_t> mTimeStamps;
+		std::uint32_t mCacheSize;
+		std::uint32_t mTime;
+	};
+
+	std::uint32_t CountCacheMisses(
+		const std::uint32_t* indices,
+		const std::size_t firstIndex,
+		const std::size_t lastIndex,
+		VertexCache& vertexCache) noexcept
+	{
+		std::uint32_t missCount{ 0U };
+		for (std::size_t i = firstIndex; i < lastIndex; ++i) {
+			missCount += vertexCache.Access(indices[i]) ? 1U : 0U;
+		}
+
+		return missCount;
+	}
+
+	// Triangles adjacent to each vertex, stored contiguously (vertex "i" triangles are
+	// mTriangles[mOffsets[i]] to mTriangles[mOffsets[i + 1] - 1])
+	struct VertexTriangleAdjacency {
+		explicit VertexTriangleAdjacency(
+			const std::uint32_t* indices,
+			const std::size_t indexCount,
+			const std::size_t vertexCount)
+			: mOffsets(vertexCount + 1UL, 0U)
+			, mTriangles(indexCount)
+		{
+			for (std::size_t i = 0UL; i < indexCount; ++i) {
+				ASSERT(indices[i] < vertexCount);
+				++mOffsets[indices[i] + 1UL];
+			}
+
+			for (std::size_t i = 1UL; i <= vertexCount; ++i) {
+				mOffsets[i] += mOffsets[i - 1UL];
+			}
+
+			std::vector<std::uint32_t> insertPositions(mOffsets.begin(), mOffsets.end() - 1);
+			for (std::size_t i = 0UL; i < indexCount; ++i) {
+				mTriangles[insertPositions[indices[i]]++] = static_cast<std::uint32_t>(i / 3UL);
+			}
+		}
+
+		std::vector<std::uint32_t> mOffsets;
+		std::vector<std::uint32_t> mTriangles;
+	};
+
+	// Next vertex to fan around, when there are no good candidates
+	std::uint32_t SkipDeadEnd(
+		const std::vector<std::uint32_t>& liveTriangleCounts,
+		std::vector<std::uint32_t>& deadEndStack,
+		std::uint32_t& cursor) noexcept
+	{
+		// Recently used vertices first
+		while (deadEndStack.empty() == false) {
+			const std::uint32_t vertexIndex{ deadEndStack.back() };
+			deadEndStack.pop_back();
+			if (liveTriangleCounts[vertexIndex] > 0U) {
+				return vertexIndex;
+			}
+		}
+
+		// Next vertex in input order
+		const std::uint32_t vertexCount{ static_cast<std::uint32_t>(liveTriangleCounts.size()) };
+		while (cursor < vertexCount) {
+			if (liveTriangleCounts[cursor] > 0U) {
+				return cursor;
+			}
+			++cursor;
+		}
+
+		return sInvalidIndex;
+	}
+
+	struct Float3 {
+		float mX;
+		float mY;
+		float mZ;
+	};
+
+	struct Cluster {
+		std::size_t mFirstIndex;
+		std::size_t mLastIndex;
+		Float3 mCentroid;
+		Float3 mNormal;
+		float mSortKey;
+	};
+
+	// Fills cluster centroid and normal, weighted by triangles area.
+	// Returns its area (sum of triangles area)
+	float ComputeClusterCentroidAndNormal(
+		const std::uint32_t* indices,
+		const GeometryGenerator::Vertex* vertices,
+		Cluster& cluster) noexcept
+	{
+		cluster.mCentroid = Float3{ 0.0f, 0.0f, 0.0f };
+		cluster.mNormal = Float3{ 0.0f, 0.0f, 0.0f };
+
+		float clusterArea{ 0.0f };
+		for (std::size_t i = cluster.mFirstIndex; i < cluster.mLastIndex; i += 3UL) {
+			const DirectX::XMFLOAT3& p0 = vertices[indices[i]].mPosition;
+			const DirectX::XMFLOAT3& p1 = vertices[indices[i + 1UL]].mPosition;
+			const DirectX::XMFLOAT3& p2 = vertices[indices[i + 2UL]].mPosition;
+
+			const Float3 edge1{ p1.x - p0.x, p1.y - p0.y, p1.z - p0.z };
+			const Float3 edge2{ p2.x - p0.x, p2.y - p0.y, p2.z - p0.z };
+
+			// Cross product length is twice the triangle area
+			const Float3 normal{
+				edge1.mY * edge2.mZ - edge1.mZ * edge2.mY,
+				edge1.mZ * edge2.mX - edge1.mX * edge2.mZ,
+				edge1.mX * edge2.mY - edge1.mY * edge2.mX };
+			const float area{ 0.5f * std::sqrt(normal.mX * normal.mX + normal.mY * normal.mY + normal.mZ * normal.mZ) };
+
+			cluster.mCentroid.mX += area * (p0.x + p1.x + p2.x) / 3.0f;
+			cluster.mCentroid.mY += area * (p0.y + p1.y + p2.y) / 3.0f;
+			cluster.mCentroid.mZ += area * (p0.z + p1.z + p2.z) / 3.0f;
+
+			cluster.mNormal.mX += normal.mX;
+			cluster.mNormal.mY += normal.mY;
+			cluster.mNormal.mZ += normal.mZ;
+
+			clusterArea += area;
+		}
+
+		if (clusterArea > 0.0f) {
+			cluster.mCentroid.mX /= clusterArea;
+			cluster.mCentroid.mY /= clusterArea;
+			cluster.mCentroid.mZ /= clusterArea;
+		}
+
+		const float normalLength{
+			std::sqrt(cluster.mNormal.mX * cluster.mNormal.mX + cluster.mNormal.mY * cluster.mNormal.mY + cluster.mNormal.mZ * cluster.mNormal.mZ)
+		};
+		if (normalLength > 0.0f) {
+			cluster.mNormal.mX /= normalLength;
+			cluster.mNormal.mY /= normalLength;
+			cluster.mNormal.mZ /= normalLength;
+		}
+
+		return clusterArea;
+	}
+}
+
+namespace MeshOptimizer {
+	VertexCacheStatistics AnalyzeVertexCache(
+		const std::uint32_t* indices,
+		const std::size_t indexCount,
+		const std::size_t vertexCount,
+		const std::uint32_t cacheSize) noexcept
+	{
+		ASSERT(indexCount % 3UL == 0UL);
+
+		VertexCacheStatistics statistics;
+		if (indexCount == 0UL || vertexCount == 0UL) {
+			return statistics;
+		}
+
+		ASSERT(indices != nullptr);
+
+		VertexCache vertexCache(vertexCount, cacheSize);
+		statistics.mTransformedVertexCount = CountCacheMisses(indices, 0UL, indexCount, vertexCache);
+		statistics.mAcmr = static_cast<float>(statistics.mTransformedVertexCount) / static_cast<float>(indexCount / 3UL);
+		statistics.mAtvr = static_cast<float>(statistics.mTransformedVertexCount) / static_cast<float>(vertexCount);
+
+		return statistics;
+	}
+
+	void OptimizeVertexCache(
+		const std::uint32_t* indices,
+		const std::size_t indexCount,
+		const std::size_t vertexCount,
+		std::uint32_t* destinationIndices,
+		std::vector<std::size_t>* clusterOffsets,
+		const std::uint32_t cacheSize) noexcept
+	{
+		ASSERT(indexCount % 3UL == 0UL);
+		ASSERT(indices != destinationIndices);
+
+		if (clusterOffsets != nullptr) {
+			clusterOffsets->clear();
+		}
+
+		if (indexCount == 0UL) {
+			return;
+		}
+
+		ASSERT(indices != nullptr);
+		ASSERT(destinationIndices != nullptr);
+
+		const VertexTriangleAdjacency adjacency(indices, indexCount, vertexCount);
+
+		std::vector<std::uint32_t> liveTriangleCounts(vertexCount);
+		for (std::size_t i = 0UL; i < vertexCount; ++i) {
+			liveTriangleCounts[i] = adjacency.mOffsets[i + 1UL] - adjacency.mOffsets[i];
+		}
+
+		std::vector<std::uint32_t> cacheTimeStamps(vertexCount, 0U);
+		std::vector<bool> isTriangleEmitted(indexCount / 3UL, false);
+		std::vector<std::uint32_t> deadEndStack;
+		std::vector<std::uint32_t> candidates;
+		std::uint32_t time{ cacheSize + 1U };
+		std::uint32_t cursor{ 0U };
+		std::size_t outputIndexCount{ 0UL };
+
+		std::uint32_t fanningVertex{ indices[0U] };
+		if (clusterOffsets != nullptr) {
+			clusterOffsets->push_back(0UL);
+		}
+
+		while (fanningVertex != sInvalidIndex) {
+			// Emit all the triangles around the fanning vertex
+			candidates.clear();
+			for (std::uint32_t i = adjacency.mOffsets[fanningVertex]; i < adjacency.mOffsets[fanningVertex + 1U]; ++i) {
+				const std::uint32_t triangle{ adjacency.mTriangles[i] };
+				if (isTriangleEmitted[triangle]) {
+					continue;
+				}
+
+				for (std::uint32_t j = 0U; j < 3U; ++j) {
+					const std::uint32_t vertexIndex{ indices[triangle * 3U + j] };
+					destinationIndices[outputIndexCount++] = vertexIndex;
+					deadEndStack.push_back(vertexIndex);
+					candidates.push_back(vertexIndex);
+					--liveTriangleCounts[vertexIndex];
+					if (time - cacheTimeStamps[vertexIndex] > cacheSize) {
+						cacheTimeStamps[vertexIndex] = time;
+						++time;
+					}
+				}
+
+				isTriangleEmitted[triangle] = true;
+			}
+
+			// Next fanning vertex is the candidate that is going to be in the cache for
+			// longer (after emitting its triangles), among the ones that are still in it.
+			fanningVertex = sInvalidIndex;
+			std::int64_t bestPriority{ -1 };
+			for (const std::uint32_t vertexIndex : candidates) {
+				if (liveTriangleCounts[vertexIndex] > 0U) {
+					std::int64_t priority{ 0 };
+					if (time - cacheTimeStamps[vertexIndex] + 2U * liveTriangleCounts[vertexIndex] <= cacheSize) {
+						priority = time - cacheTimeStamps[vertexIndex];
+					}
+
+					if (priority > bestPriority) {
+						bestPriority = priority;
+						fanningVertex = vertexIndex;
+					}
+				}
+			}
+
+			if (fanningVertex == sInvalidIndex) {
+				fanningVertex = SkipDeadEnd(liveTriangleCounts, deadEndStack, cursor);
+				if (clusterOffsets != nullptr && fanningVertex != sInvalidIndex) {
+					clusterOffsets->push_back(outputIndexCount);
+				}
+			}
+		}
+
+		ASSERT(outputIndexCount == indexCount);
+	}
+
+	void OptimizeOverdraw(
+		std::uint32_t* indices,
+		const std::size_t indexCount,
+		const GeometryGenerator::Vertex* vertices,
+		const std::size_t vertexCount,
+		const std::vector<std::size_t>& clusterOffsets,
+		const float threshold,
+		const std::uint32_t cacheSize) noexcept
+	{
+		ASSERT(indexCount % 3UL == 0UL);
+
+		if (indexCount == 0UL) {
+			return;
+		}
+
+		ASSERT(indices != nullptr);
+		ASSERT(vertices != nullptr);
+		ASSERT(clusterOffsets.empty() == false && clusterOffsets[0U] == 0UL);
+
+		// Split clusters while their ACMR does not increase more than the threshold.
+		// Each cluster is simulated with an empty cache, as they are going to be reordered.
+		std::vector<Cluster> clusters;
+		VertexCache vertexCache(vertexCount, cacheSize);
+		const std::size_t hardClusterCount{ clusterOffsets.size() };
+		for (std::size_t i = 0UL; i < hardClusterCount; ++i) {
+			const std::size_t firstIndex{ clusterOffsets[i] };
+			const std::size_t lastIndex{ i + 1UL < hardClusterCount ? clusterOffsets[i + 1UL] : indexCount };
+			ASSERT(firstIndex < lastIndex);
+
+			vertexCache.Flush();
+			const float clusterAcmr{
+				static_cast<float>(CountCacheMisses(indices, firstIndex, lastIndex, vertexCache)) /
+				static_cast<float>((lastIndex - firstIndex) / 3UL)
+			};
+
+			vertexCache.Flush();
+			std::size_t clusterFirstIndex{ firstIndex };
+			std::uint32_t missCount{ 0U };
+			for (std::size_t j = firstIndex; j < lastIndex; j += 3UL) {
+				missCount += CountCacheMisses(indices, j, j + 3UL, vertexCache);
+
+				const std::size_t clusterTriangleCount{ (j + 3UL - clusterFirstIndex) / 3UL };
+				const float acmr{ static_cast<float>(missCount) / static_cast<float>(clusterTriangleCount) };
+				if (j + 3UL == lastIndex || acmr <= clusterAcmr * threshold) {
+					clusters.push_back(Cluster{ clusterFirstIndex, j + 3UL, Float3{ 0.0f, 0.0f, 0.0f }, Float3{ 0.0f, 0.0f, 0.0f }, 0.0f });
+					clusterFirstIndex = j + 3UL;
+					missCount = 0U;
+					vertexCache.Flush();
+				}
+			}
+		}
+
+		// Sort clusters to draw first the ones that face outwards, far from the mesh centroid.
+		Float3 meshCentroid{ 0.0f, 0.0f, 0.0f };
+		float meshArea{ 0.0f };
+		for (Cluster& cluster : clusters) {
+			const float clusterArea{ ComputeClusterCentroidAndNormal(indices, vertices, cluster) };
+			meshCentroid.mX += cluster.mCentroid.mX * clusterArea;
+			meshCentroid.mY += cluster.mCentroid.mY * clusterArea;
+			meshCentroid.mZ += cluster.mCentroid.mZ * clusterArea;
+			meshArea += clusterArea;
+		}
+
+		if (meshArea > 0.0f) {
+			meshCentroid.mX /= meshArea;
+			meshCentroid.mY /= meshArea;
+			meshCentroid.mZ /= meshArea;
+		}
+
+		for (Cluster& cluster : clusters) {
+			cluster.mSortKey =
+				(cluster.mCentroid.mX - meshCentroid.mX) * cluster.mNormal.mX +
+				(cluster.mCentroid.mY - meshCentroid.mY) * cluster.mNormal.mY +
+				(cluster.mCentroid.mZ - meshCentroid.mZ) * cluster.mNormal.mZ;
+		}
+
+		std::stable_sort(
+			clusters.begin(),
+			clusters.end(),
+			[](const Cluster& cluster1, const Cluster& cluster2) { return cluster1.mSortKey > cluster2.mSortKey; });
+
+		const std::vector<std::uint32_t> sourceIndices(indices, indices + indexCount);
+		std::size_t outputIndexCount{ 0UL };
+		for (const Cluster& cluster : clusters) {
+			for (std::size_t i = cluster.mFirstIndex; i < cluster.mLastIndex; ++i) {
+				indices[outputIndexCount++] = sourceIndices[i];
+			}
+		}
+
+		ASSERT(outputIndexCount == indexCount);
+	}
+
+	void OptimizeVertexFetch(GeometryGenerator::MeshData& meshData) noexcept {
+		const std::size_t vertexCount{ meshData.mVertices.size() };
+		std::vector<std::uint32_t> remap(vertexCount, sInvalidIndex);
+
+		std::vector<GeometryGenerator::Vertex> vertices;
+		vertices.reserve(vertexCount);
+		for (std::uint32_t& index : meshData.mIndices32) {
+			ASSERT(index < vertexCount);
+			if (remap[index] == sInvalidIndex) {
+				remap[index] = static_cast<std::uint32_t>(vertices.size());
+				vertices.push_back(meshData.mVertices[index]);
+			}
+			index = remap[index];
+		}
+
+		meshData.mVertices = std::move(vertices);
+	}
+
+	void OptimizeMesh(GeometryGenerator::MeshData& meshData) noexcept {
+		const std::size_t indexCount{ meshData.mIndices32.size() };
+		ASSERT(indexCount % 3UL == 0UL);
+		if (indexCount == 0UL) {
+			return;
+		}
+
+		const std::size_t vertexCount{ meshData.mVertices.size() };
+
+		std::vector<std::uint32_t> vertexCacheIndices(indexCount);
+		std::vector<std::size_t> clusterOffsets;
+		OptimizeVertexCache(
+			meshData.mIndices32.data(),
+			indexCount,
+			vertexCount,
+			vertexCacheIndices.data(),
+			&clusterOffsets);
+
+		std::vector<std::uint32_t> overdrawIndices(vertexCacheIndices);
+		OptimizeOverdraw(
+			overdrawIndices.data(),
+			indexCount,
+			meshData.mVertices.data(),
+			vertexCount,
+			clusterOffsets);
+
+		// Clusters are sorted independently, so they do not share cache entries anymore.
+		// We keep the overdraw order only if it is close enough to the vertex cache order,
+		// and we never keep an order that is worse than the source one.
+		const float sourceAcmr{ AnalyzeVertexCache(meshData.mIndices32.data(), indexCount, vertexCount).mAcmr };
+		const float vertexCacheAcmr{ AnalyzeVertexCache(vertexCacheIndices.data(), indexCount, vertexCount).mAcmr };
+		const float overdrawAcmr{ AnalyzeVertexCache(overdrawIndices.data(), indexCount, vertexCount).mAcmr };
+		if (overdrawAcmr <= vertexCacheAcmr * sOverdrawThreshold && overdrawAcmr <= sourceAcmr) {
+			meshData.mIndices32.swap(overdrawIndices);
+		} else if (vertexCacheAcmr < sourceAcmr) {
+			meshData.mIndices32.swap(vertexCacheIndices);
+		}
+
+		OptimizeVertexFetch(meshData);
+	}
+
+	void OptimizeMeshletVertexCache(
+		std::uint32_t* indices,
+		const std::size_t vertexCount,
+		const Meshlet* meshlets,
+		const std::size_t meshletCount) noexcept
+	{
+		ASSERT(indices != nullptr);
+		ASSERT(meshletCount == 0UL || meshlets != nullptr);
+
+		// Orders are compared after the last triangles before the meshlet, as they
+		// leave their vertices in the cache (the cache holds less vertices than they have)
+		const std::size_t maxContextIndexCount{ 3UL * sVertexCacheSize };
+
+		std::vector<std::uint32_t> sourceIndices;
+		std::vector<std::uint32_t> optimizedIndices;
+		for (std::size_t i = 0UL; i < meshletCount; ++i) {
+			const Meshlet& meshlet = meshlets[i];
+			ASSERT(meshlet.mIndexCount % 3U == 0U);
+			std::uint32_t* firstIndex{ indices + meshlet.mFirstIndex };
+			const std::size_t contextIndexCount{ std::min<std::size_t>(meshlet.mFirstIndex, maxContextIndexCount) };
+			const std::size_t rangeIndexCount{ contextIndexCount + meshlet.mIndexCount };
+
+			sourceIndices.assign(firstIndex - contextIndexCount, firstIndex + meshlet.mIndexCount);
+			optimizedIndices.assign(firstIndex - contextIndexCount, firstIndex + meshlet.mIndexCount);
+			OptimizeVertexCache(firstIndex, meshlet.mIndexCount, vertexCount, optimizedIndices.data() + contextIndexCount);
+
+			// Meshlets grow through adjacent triangles, so their order can already be better
+			const std::uint32_t sourceVertexCount{ 
+				AnalyzeVertexCache(sourceIndices.data(), rangeIndexCount, vertexCount).mTransformedVertexCount };
+			const std::uint32_t optimizedVertexCount{ 
+				AnalyzeVertexCache(optimizedIndices.data(), rangeIndexCount, vertexCount).mTransformedVertexCount };
+			if (optimizedVertexCount < sourceVertexCount) {
+				std::copy(optimizedIndices.begin() + contextIndexCount, optimizedIndices.end(), firstIndex);
+			}
+		}
+	}
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <GeometryGenerator/GeometryGenerator.h>
+#include <ModelManager/Meshlet.h>
+
+// To reorder mesh triangles and vertices, so the GPU processes less vertices
+// and fetches less vertex data. It runs on the CPU, before vertex and index buffers are created.
+// Steps done by OptimizeMesh():
+// - Triangles are reordered for the post transform vertex cache (Tipsify,
+//   "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw", Sander et al. 2007)
+// - Triangle clusters are sorted to draw outer triangles first, to reduce overdraw.
+//   Clusters are only split where vertex cache efficiency is not reduced more than a threshold.
+// - Vertices are reordered in the order they are used by triangles (vertex fetch)
+// Meshlets (see MeshletBuilder) reorder triangles again, so their triangles are
+// optimized for the vertex cache with OptimizeMeshletVertexCache() after they are built.
+namespace MeshOptimizer {
+	// Post transform vertex cache size that is simulated (first in first out)
+	const std::uint32_t sVertexCacheSize{ 16U };
+
+	// Maximum ratio between ACMR after and before overdraw optimization
+	const float sOverdrawThreshold{ 1.05f };
+
+	struct VertexCacheStatistics {
+		// Average cache miss ratio: transformed vertices per triangle.
+		// It is between 0.5 (best case) and 3.0 (worst case)
+		float mAcmr{ 0.0f };
+
+		// Average transformed vertex ratio: transformed vertices per vertex.
+		// It is 1.0 in the best case.
+		float mAtvr{ 0.0f };
+
+		std::uint32_t mTransformedVertexCount{ 0U };
+	};
+
+	// Preconditions:
+	// - "indices" must be a triangle list, where each index is less than "vertexCount"
+	VertexCacheStatistics AnalyzeVertexCache(
+		const std::uint32_t* indices,
+		const std::size_t indexCount,
+		const std::size_t vertexCount,
+		const std::uint32_t cacheSize = sVertexCacheSize) noexcept;
+
+	// Reorders triangles with Tipsify and returns them in "destinationIndices".
+	// If "clusterOffsets" is not nullptr, then it is filled with the first index of each
+	// cluster of triangles (clusters start where the algorithm cannot continue locally).
+	// Preconditions:
+	// - "indices" must be a triangle list, where each index is less than "vertexCount"
+	// - "indices" and "destinationIndices" must not overlap
+	void OptimizeVertexCache(
+		const std::uint32_t* indices,
+		const std::size_t indexCount,
+		const std::size_t vertexCount,
+		std::uint32_t* destinationIndices,
+		std::vector<std::size_t>* clusterOffsets = nullptr,
+		const std::uint32_t cacheSize = sVertexCacheSize) noexcept;
+
+	// Sorts clusters of triangles (given by OptimizeVertexCache()) to draw first the triangles
+	// that are more likely to occlude others. Clusters are split in smaller ones
+	// while ACMR does not increase more than "threshold".
+	// Preconditions:
+	// - "clusterOffsets" must be sorted and its first element must be zero
+	void OptimizeOverdraw(
+		std::uint32_t* indices,
+		const std::size_t indexCount,
+		const GeometryGenerator::Vertex* vertices,
+		const std::size_t vertexCount,
+		const std::vector<std::size_t>& clusterOffsets,
+		const float threshold = sOverdrawThreshold,
+		const std::uint32_t cacheSize = sVertexCacheSize) noexcept;
+
+	// Reorders vertices in the order they are first referenced by indices, and remaps indices.
+	// Vertices that are not referenced are removed.
+	void OptimizeVertexFetch(GeometryGenerator::MeshData& meshData) noexcept;
+
+	// Applies all the optimizations
+	// Preconditions:
+	// - "meshData" must be a triangle list
+	void OptimizeMesh(GeometryGenerator::MeshData& meshData) noexcept;
+
+	// Reorders the triangles of each meshlet with OptimizeVertexCache(), so they keep being
+	// contiguous and they are not moved to other meshlets. The order of a meshlet is only changed
+	// if it transforms less vertices.
+	// Preconditions:
+	// - "indices" must be a triangle list, where each index is less than "vertexCount"
+	// - "meshlets" index ranges must be valid in "indices"
+	void OptimizeMeshletVertexCache(
+		std::uint32_t* indices,
+		const std::size_t vertexCount,
+		const Meshlet* meshlets,
+		const std::size_t meshletCount) noexcept;
+}
@@ -0,0 +1,487 @@
+#include "MeshSimplifier.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include <ModelManager/MeshOptimizer.h>
+#include <Utils/DebugUtils.h>
+
+namespace {
+	struct Quadric {
+		// Symmetric matrix A, vector b and scalar c of
+		// Q(p) = p^T * A * p + 2 * b^T * p + c
+		double mA00{ 0.0 };
+		double mA01{ 0.0 };
+		double mA02{ 0.0 };
+		double mA11{ 0.0 };
+		double mA12{ 0.0 };
+		double mA22{ 0.0 };
+		double mB0{ 0.0 };
+		double mB1{ 0.0 };
+		double mB2{ 0.0 };
+		double mC{ 0.0 };
+
+		// Sum of the areas of the planes
+		double mWeight{ 0.0 };
+	};
+
+	void AddPlane(
+		Quadric& quadric,
+		const double normalX,
+		const double normalY,
+		const double normalZ,
+		const double distance,
+		const double weight) noexcept
+	{
+		quadric.mA00 += weight * normalX * normalX;
+		quadric.mA01 += weight * normalX * normalY;
+		quadric.mA02 += weight * normalX * normalZ;
+		quadric.mA11 += weight * normalY * normalY;
+		quadric.mA12 += weight * normalY * normalZ;
+		quadric.mA22 += weight * normalZ * normalZ;
+		quadric.mB0 += weight * normalX * distance;
+		quadric.mB1 += weight * normalY * distance;
+		quadric.mB2 += weight * normalZ * distance;
+		quadric.mC += weight * distance * distance;
+		quadric.mWeight += weight;
+	}
+
+	void AddQuadric(Quadric& quadric, const Quadric& otherQuadric) noexcept {
+		quadric.mA00 += otherQuadric.mA00;
+		quadric.mA01 += otherQuadric.mA01;
+		quadric.mA02 += otherQuadric.mA02;
+		quadric.mA11 += otherQuadric.mA11;
+		quadric.mA12 += otherQuadric.mA12;
+		quadric.mA22 += otherQuadric.mA22;
+		quadric.mB0 += otherQuadric.mB0;
+		quadric.mB1 += otherQuadric.mB1;
+		quadric.mB2 += otherQuadric.mB2;
+		quadric.mC += otherQuadric.mC;
+		quadric.mWeight += otherQuadric.mWeight;
+	}
+
+	// Returns the mean squared distance from "position" to the quadric planes
+	double EvaluateQuadric(const Quadric& quadric, const DirectX::XMFLOAT3& position) noexcept {
+		if (quadric.mWeight <= 0.0) {
+			return 0.0;
+		}
+
+		const double x{ position.x };
+		const double y{ position.y };
+		const double z{ position.z };
+		const double error{
+			quadric.mA00 * x * x + quadric.mA11 * y * y + quadric.mA22 * z * z +
+			2.0 * (quadric.mA01 * x * y + quadric.mA02 * x * z + quadric.mA12 * y * z) +
+			2.0 * (quadric.mB0 * x + quadric.mB1 * y + quadric.mB2 * z) +
+			quadric.mC
+		};
+
+		return std::max<double>(error, 0.0) / quadric.mWeight;
+	}
+
+	void ComputeTriangleNormal(
+		const DirectX::XMFLOAT3& p0,
+		const DirectX::XMFLOAT3& p1,
+		const DirectX::XMFLOAT3& p2,
+		double normal[3U]) noexcept
+	{
+		const double edge1[3U]{ p1.x - p0.x, p1.y - p0.y, p1.z - p0.z };
+		const double edge2[3U]{ p2.x - p0.x, p2.y - p0.y, p2.z - p0.z };
+		normal[0U] = edge1[1U] * edge2[2U] - edge1[2U] * edge2[1U];
+		normal[1U] = edge1[2U] * edge2[0U] - edge1[0U] * edge2[2U];
+		normal[2U] = edge1[0U] * edge2[1U] - edge1[1U] * edge2[0U];
+	}
+
+	// Fills "positionIndices" with the first vertex that has the same position than each vertex,
+	// and "isSeamPosition" with true for positions that are shared by several vertices.
+	void WeldPositions(
+		const GeometryGenerator::Vertex* vertices,
+		const std::size_t vertexCount,
+		std::vector<std::uint32_t>& positionIndices,
+		std::vector<bool>& isSeamPosition) noexcept
+	{
+		std::vector<std::uint32_t> sortedVertices(vertexCount);
+		for (std::size_t i = 0UL; i < vertexCount; ++i) {
+			sortedVertices[i] = static_cast<std::uint32_t>(i);
+		}
+
+		const auto lessPosition = [vertices](const std::uint32_t vertex1, const std::uint32_t vertex2) {
+			const DirectX::XMFLOAT3& position1 = vertices[vertex1].mPosition;
+			const DirectX::XMFLOAT3& position2 = vertices[vertex2].mPosition;
+			if (position1.x != position2.x) {
+				return position1.x < position2.x;
+			}
+			if (position1.y != position2.y) {
+				return position1.y < position2.y;
+			}
+			if (position1.z != position2.z) {
+				return position1.z < position2.z;
+			}
+
+			return vertex1 < vertex2;
+		};
+		std::sort(sortedVertices.begin(), sortedVertices.end(), lessPosition);
+
+		positionIndices.resize(vertexCount);
+		isSeamPosition.assign(vertexCount, false);
+		std::size_t groupBegin{ 0UL };
+		while (groupBegin < vertexCount) {
+			const DirectX::XMFLOAT3& groupPosition = vertices[sortedVertices[groupBegin]].mPosition;
+			std::size_t groupEnd{ groupBegin + 1UL };
+			while (groupEnd < vertexCount) {
+				const DirectX::XMFLOAT3& position = vertices[sortedVertices[groupEnd]].mPosition;
+				if (position.x != groupPosition.x || position.y != groupPosition.y || position.z != groupPosition.z) {
+					break;
+				}
+				++groupEnd;
+			}
+
+			const std::uint32_t positionIndex{ sortedVertices[groupBegin] };
+			for (std::size_t i = groupBegin; i < groupEnd; ++i) {
+				positionIndices[sortedVertices[i]] = positionIndex;
+			}
+			isSeamPosition[positionIndex] = (groupEnd - groupBegin) > 1UL;
+
+			groupBegin = groupEnd;
+		}
+	}
+
+	// Positions of edges that are not shared by exactly two triangles (borders and non manifold edges)
+	void FindBorderPositions(
+		const std::uint32_t* indices,
+		const std::size_t indexCount,
+		const std::vector<std::uint32_t>& positionIndices,
+		std::vector<bool>& isBorderPosition) noexcept
+	{
+		std::vector<std::uint64_t> edges;
+		edges.reserve(indexCount);
+		for (std::size_t i = 0UL; i < indexCount; i += 3UL) {
+			for (std::size_t j = 0UL; j < 3UL; ++j) {
+				const std::uint64_t position1{ positionIndices[indices[i + j]] };
+				const std::uint64_t position2{ positionIndices[indices[i + (j + 1UL) % 3UL]] };
+				edges.push_back(position1 < position2 ? (position1 << 32UL) | position2 : (position2 << 32UL) | position1);
+			}
+		}
+		std::sort(edges.begin(), edges.end());
+
+		isBorderPosition.assign(positionIndices.size(), false);
+		std::size_t edgeBegin{ 0UL };
+		const std::size_t edgeCount{ edges.size() };
+		while (edgeBegin < edgeCount) {
+			std::size_t edgeEnd{ edgeBegin + 1UL };
+			while (edgeEnd < edgeCount && edges[edgeEnd] == edges[edgeBegin]) {
+				++edgeEnd;
+			}
+
+			if (edgeEnd - edgeBegin != 2UL) {
+				isBorderPosition[static_cast<std::size_t>(edges[edgeBegin] >> 32UL)] = true;
+				isBorderPosition[static_cast<std::size_t>(edges[edgeBegin] & 0xFFFFFFFFUL)] = true;
+			}
+
+			edgeBegin = edgeEnd;
+		}
+	}
+
+	struct Collapse {
+		std::uint32_t mSourceVertex;
+		std::uint32_t mTargetVertex;
+		double mError;
+	};
+
+	// Returns true if moving "sourceVertex" to "targetVertex" position flips
+	// any of the triangles around "sourceVertex" that are not removed by the collapse.
+	bool IsCollapseFlippingTriangles(
+		const std::uint32_t* indices,
+		const GeometryGenerator::Vertex* vertices,
+		const std::uint32_t* vertexTriangles,
+		const std::uint32_t vertexTriangleCount,
+		const std::uint32_t sourceVertex,
+		const std::uint32_t targetVertex) noexcept
+	{
+		for (std::uint32_t i = 0U; i < vertexTriangleCount; ++i) {
+			const std::uint32_t* triangle{ indices + vertexTriangles[i] * 3U };
+			if (triangle[0U] == targetVertex || triangle[1U] == targetVertex || triangle[2U] == targetVertex) {
+				continue;
+			}
+
+			const DirectX::XMFLOAT3* positions[3U];
+			const DirectX::XMFLOAT3* newPositions[3U];
+			for (std::uint32_t j = 0U; j < 3U; ++j) {
+				positions[j] = &vertices[triangle[j]].mPosition;
+				newPositions[j] = triangle[j] == sourceVertex ? &vertices[targetVertex].mPosition : positions[j];
+			}
+
+			double normal[3U];
+			double newNormal[3U];
+			ComputeTriangleNormal(*positions[0U], *positions[1U], *positions[2U], normal);
+			ComputeTriangleNormal(*newPositions[0U], *newPositions[1U], *newPositions[2U], newNormal);
+			if (normal[0U] * newNormal[0U] + normal[1U] * newNormal[1U] + normal[2U] * newNormal[2U] <= 0.0) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+}
+
+namespace MeshSimplifier {
+	float Simplify(
+		const std::uint32_t* indices,
+		const std::size_t indexCount,
+		const GeometryGenerator::Vertex* vertices,
+		const std::size_t vertexCount,
+		const std::size_t targetIndexCount,
+		const float maxError,
+		std::vector<std::uint32_t>& destinationIndices) noexcept
+	{
+		ASSERT(indexCount % 3UL == 0UL);
+
+		destinationIndices.assign(indices, indices + indexCount);
+		if (indexCount <= targetIndexCount) {
+			return 0.0f;
+		}
+
+		ASSERT(vertices != nullptr);
+
+		// Vertices on seams or borders are locked
+		std::vector<std::uint32_t> positionIndices;
+		std::vector<bool> isSeamPosition;
+		WeldPositions(vertices, vertexCount, positionIndices, isSeamPosition);
+
+		std::vector<bool> isBorderPosition;
+		FindBorderPositions(indices, indexCount, positionIndices, isBorderPosition);
+
+		std::vector<bool> isVertexLocked(vertexCount);
+		for (std::size_t i = 0UL; i < vertexCount; ++i) {
+			const std::uint32_t positionIndex{ positionIndices[i] };
+			isVertexLocked[i] = isSeamPosition[positionIndex] || isBorderPosition[positionIndex];
+		}
+
+		// Quadrics of triangle planes, weighted by triangle area
+		std::vector<Quadric> quadrics(vertexCount);
+		for (std::size_t i = 0UL; i < indexCount; i += 3UL) {
+			const DirectX::XMFLOAT3& p0 = vertices[indices[i]].mPosition;
+			double normal[3U];
+			ComputeTriangleNormal(p0, vertices[indices[i + 1UL]].mPosition, vertices[indices[i + 2UL]].mPosition, normal);
+			const double length{ std::sqrt(normal[0U] * normal[0U] + normal[1U] * normal[1U] + normal[2U] * normal[2U]) };
+			if (length <= 0.0) {
+				continue;
+			}
+
+			normal[0U] /= length;
+			normal[1U] /= length;
+			normal[2U] /= length;
+			const double distance{ -(normal[0U] * p0.x + normal[1U] * p0.y + normal[2U] * p0.z) };
+			for (std::size_t j = 0UL; j < 3UL; ++j) {
+				AddPlane(quadrics[positionIndices[indices[i + j]]], normal[0U], normal[1U], normal[2U], distance, length * 0.5);
+			}
+		}
+
+		const double maxSquaredError{ static_cast<double>(maxError) * static_cast<double>(maxError) };
+		double resultSquaredError{ 0.0 };
+		std::vector<std::uint32_t> triangleOffsets(vertexCount + 1UL);
+		std::vector<std::uint32_t> vertexTriangles;
+		std::vector<Collapse> collapses;
+		std::vector<std::uint32_t> remap(vertexCount);
+		std::vector<bool> isVertexTouched(vertexCount);
+
+		// Each pass collapses independent edges (ordered by error), and
+		// then removes degenerate triangles.
+		while (destinationIndices.size() > targetIndexCount) {
+			const std::size_t currentIndexCount{ destinationIndices.size() };
+
+			// Triangles adjacent to each vertex
+			std::fill(triangleOffsets.begin(), triangleOffsets.end(), 0U);
+			for (std::size_t i = 0UL; i < currentIndexCount; ++i) {
+				++triangleOffsets[destinationIndices[i] + 1UL];
+			}
+			for (std::size_t i = 1UL; i <= vertexCount; ++i) {
+				triangleOffsets[i] += triangleOffsets[i - 1UL];
+			}
+			vertexTriangles.resize(currentIndexCount);
+			{
+				std::vector<std::uint32_t> insertPositions(triangleOffsets.begin(), triangleOffsets.end() - 1);
+				for (std::size_t i = 0UL; i < currentIndexCount; ++i) {
+					vertexTriangles[insertPositions[destinationIndices[i]]++] = static_cast<std::uint32_t>(i / 3UL);
+				}
+			}
+
+			// Candidate collapses sorted by error
+			collapses.clear();
+			for (std::size_t i = 0UL; i < currentIndexCount; i += 3UL) {
+				for (std::size_t j = 0UL; j < 3UL; ++j) {
+					const std::uint32_t vertex1{ destinationIndices[i + j] };
+					const std::uint32_t vertex2{ destinationIndices[i + (j + 1UL) % 3UL] };
+					if (isVertexLocked[vertex1] == false) {
+						collapses.push_back(Collapse{
+							vertex1,
+							vertex2,
+							EvaluateQuadric(quadrics[positionIndices[vertex1]], vertices[vertex2].mPosition) });
+					}
+					if (isVertexLocked[vertex2] == false) {
+						collapses.push_back(Collapse{
+							vertex2,
+							vertex1,
+							EvaluateQuadric(quadrics[positionIndices[vertex2]], vertices[vertex1].mPosition) });
+					}
+				}
+			}
+			std::sort(
+				collapses.begin(),
+				collapses.end(),
+				[](const Collapse& collapse1, const Collapse& collapse2) { return collapse1.mError < collapse2.mError; });
+
+			// Collapse while we have not reached the target. Vertices around a collapsed one are touched,
+			// and they cannot be collapsed in the same pass, as their triangles changed.
+			for (std::size_t i = 0UL; i < vertexCount; ++i) {
+				remap[i] = static_cast<std::uint32_t>(i);
+			}
+			std::fill(isVertexTouched.begin(), isVertexTouched.end(), false);
+
+			const std::size_t triangleCountToRemove{ (currentIndexCount - targetIndexCount + 2UL) / 3UL };
+			std::size_t removedTriangleCount{ 0UL };
+			std::size_t collapseCount{ 0UL };
+			for (const Collapse& collapse : collapses) {
+				if (removedTriangleCount >= triangleCountToRemove || collapse.mError > maxSquaredError) {
+					break;
+				}
+
+				const std::uint32_t sourceVertex{ collapse.mSourceVertex };
+				const std::uint32_t targetVertex{ collapse.mTargetVertex };
+				if (isVertexTouched[sourceVertex] || isVertexTouched[targetVertex]) {
+					continue;
+				}
+
+				const std::uint32_t* sourceTriangles{ vertexTriangles.data() + triangleOffsets[sourceVertex] };
+				const std::uint32_t sourceTriangleCount{ triangleOffsets[sourceVertex + 1U] - triangleOffsets[sourceVertex] };
+				if (IsCollapseFlippingTriangles(
+					destinationIndices.data(),
+					vertices,
+					sourceTriangles,
+					sourceTriangleCount,
+					sourceVertex,
+					targetVertex)) {
+					continue;
+				}
+
+				for (std::uint32_t j = 0U; j < sourceTriangleCount; ++j) {
+					const std::uint32_t* triangle{ destinationIndices.data() + sourceTriangles[j] * 3U };
+					for (std::uint32_t k = 0U; k < 3U; ++k) {
+						isVertexTouched[triangle[k]] = true;
+					}
+					if (triangle[0U] == targetVertex || triangle[1U] == targetVertex || triangle[2U] == targetVertex) {
+						++removedTriangleCount;
+					}
+				}
+
+				remap[sourceVertex] = targetVertex;
+				AddQuadric(quadrics[positionIndices[targetVertex]], quadrics[positionIndices[sourceVertex]]);
+				resultSquaredError = std::max<double>(resultSquaredError, collapse.mError);
+				++collapseCount;
+			}
+
+			if (collapseCount == 0UL) {
+				break;
+			}
+
+			// Remap indices and remove degenerate triangles
+			std::size_t newIndexCount{ 0UL };
+			for (std::size_t i = 0UL; i < currentIndexCount; i += 3UL) {
+				const std::uint32_t vertex0{ remap[destinationIndices[i]] };
+				const std::uint32_t vertex1{ remap[destinationIndices[i + 1UL]] };
+				const std::uint32_t vertex2{ remap[destinationIndices[i + 2UL]] };
+				if (vertex0 != vertex1 && vertex0 != vertex2 && vertex1 != vertex2) {
+					destinationIndices[newIndexCount++] = vertex0;
+					destinationIndices[newIndexCount++] = vertex1;
+					destinationIndices[newIndexCount++] = vertex2;
+				}
+			}
+			destinationIndices.resize(newIndexCount);
+		}
+
+		return static_cast<float>(std::sqrt(resultSquaredError));
+	}
+
+	void GenerateLods(GeometryGenerator::MeshData& meshData, std::vector<MeshLod>& lods) noexcept {
+		const std::size_t indexCount{ meshData.mIndices32.size() };
+		ASSERT(indexCount % 3UL == 0UL);
+
+		lods.clear();
+		MeshLod lod;
+		lod.mIndexCount = static_cast<std::uint32_t>(indexCount);
+		lods.push_back(lod);
+
+		const std::size_t vertexCount{ meshData.mVertices.size() };
+		if (vertexCount == 0UL) {
+			return;
+		}
+
+		// Errors are relative to the bounding sphere radius of the bounding box,
+		// as it is used to select the level of detail.
+		DirectX::XMFLOAT3 minPosition{ meshData.mVertices[0U].mPosition };
+		DirectX::XMFLOAT3 maxPosition{ meshData.mVertices[0U].mPosition };
+		for (const GeometryGenerator::Vertex& vertex : meshData.mVertices) {
+			minPosition.x = std::min<float>(minPosition.x, vertex.mPosition.x);
+			minPosition.y = std::min<float>(minPosition.y, vertex.mPosition.y);
+			minPosition.z = std::min<float>(minPosition.z, vertex.mPosition.z);
+			maxPosition.x = std::max<float>(maxPosition.x, vertex.mPosition.x);
+			maxPosition.y = std::max<float>(maxPosition.y, vertex.mPosition.y);
+			maxPosition.z = std::max<float>(maxPosition.z, vertex.mPosition.z);
+		}
+		const float extentX{ (maxPosition.x - minPosition.x) * 0.5f };
+		const float extentY{ (maxPosition.y - minPosition.y) * 0.5f };
+		const float extentZ{ (maxPosition.z - minPosition.z) * 0.5f };
+		const float radius{ std::sqrt(extentX * extentX + extentY * extentY + extentZ * extentZ) };
+		if (radius <= 0.0f) {
+			return;
+		}
+
+		// Each level of detail is simplified from the full detail one, so its error is not accumulated.
+		const std::vector<std::uint32_t> sourceIndices(meshData.mIndices32);
+		std::vector<std::uint32_t> simplifiedIndices;
+		std::vector<std::uint32_t> optimizedIndices;
+		std::size_t previousIndexCount{ indexCount };
+		for (std::uint32_t i = 1U; i < sMaxMeshLodCount; ++i) {
+			const std::size_t targetIndexCount{
+				static_cast<std::size_t>(static_cast<float>(previousIndexCount) * sLodIndexCountRatio) / 3UL * 3UL
+			};
+			if (targetIndexCount < sMinLodIndexCount) {
+				break;
+			}
+
+			const float error{
+				Simplify(
+					sourceIndices.data(),
+					indexCount,
+					meshData.mVertices.data(),
+					vertexCount,
+					targetIndexCount,
+					sMaxLodError * radius,
+					simplifiedIndices)
+			};
+
+			// Stop if the mesh cannot be simplified enough (for example, if most vertices are locked)
+			const std::size_t simplifiedIndexCount{ simplifiedIndices.size() };
+			if (simplifiedIndexCount == 0UL ||
+				static_cast<float>(simplifiedIndexCount) > static_cast<float>(previousIndexCount) * 0.9f) {
+				break;
+			}
+
+			optimizedIndices.resize(simplifiedIndexCount);
+			MeshOptimizer::OptimizeVertexCache(
+				simplifiedIndices.data(),
+				simplifiedIndexCount,
+				vertexCount,
+				optimizedIndices.data());
+
+			lod.mFirstIndex = static_cast<std::uint32_t>(meshData.mIndices32.size());
+			lod.mIndexCount = static_cast<std::uint32_t>(simplifiedIndexCount);
+			lod.mError = std::max<float>(error / radius, lods.back().mError);
+			lods.push_back(lod);
+			meshData.mIndices32.insert(meshData.mIndices32.end(), optimizedIndices.begin(), optimizedIndices.end());
+
+			previousIndexCount = simplifiedIndexCount;
+		}
+	}
+}
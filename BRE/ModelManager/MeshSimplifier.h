@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <GeometryGenerator/GeometryGenerator.h>
+#include <ModelManager/MeshLod.h>
+
+// To simplify meshes with quadric error metrics ("Surface Simplification Using
+// Quadric Error Metrics", Garland and Heckbert 1997) and build levels of detail.
+// Vertices are collapsed onto one of their neighbours (they are never moved), so
+// all the levels of detail can share the same vertex buffer.
+// Vertices on borders or attribute seams (several vertices with the same position)
+// are never collapsed, to keep the mesh silhouette and its attributes.
+namespace MeshSimplifier {
+	// Each level of detail tries to have half the indices of the previous one
+	const float sLodIndexCountRatio{ 0.5f };
+
+	// Levels of detail are not generated below this number of indices
+	const std::size_t sMinLodIndexCount{ 3UL * 64UL };
+
+	// Maximum simplification error (relative to the mesh bounding sphere radius) of a level of detail
+	const float sMaxLodError{ 0.25f };
+
+	// Simplifies the triangle list until it has "targetIndexCount" indices or less, or
+	// until no more vertices can be collapsed with an error below "maxError" (object space distance).
+	// The resulting triangle list is stored in "destinationIndices".
+	// Returns the simplification error (maximum object space distance between collapsed
+	// vertices and the planes of their original triangles)
+	// Preconditions:
+	// - "indices" must be a triangle list, where each index is less than "vertexCount"
+	float Simplify(
+		const std::uint32_t* indices,
+		const std::size_t indexCount,
+		const GeometryGenerator::Vertex* vertices,
+		const std::size_t vertexCount,
+		const std::size_t targetIndexCount,
+		const float maxError,
+		std::vector<std::uint32_t>& destinationIndices) noexcept;
+
+	// Appends levels of detail indices to "meshData" indices, and fills "lods" with them.
+	// The first level of detail is the full detail mesh.
+	// Levels of detail indices are optimized for the vertex cache.
+	// Preconditions:
+	// - "meshData" must be a triangle list
+	void GenerateLods(GeometryGenerator::MeshData& meshData, std::vector<MeshLod>& lods) noexcept;
+}
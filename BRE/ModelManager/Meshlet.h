@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+#include <DirectXMath.h>
+
+// Maximum number of vertices and triangles of a meshlet
+const std::uint32_t sMaxMeshletVertexCount{ 64U };
+const std::uint32_t sMaxMeshletTriangleCount{ 124U };
+
+// Cluster of triangles of the full detail level of a mesh (see MeshletBuilder).
+// Its triangles are contiguous in the index buffer, so visible meshlets can
+// be drawn as index ranges. Bounds are in object space.
+struct Meshlet {
+	std::uint32_t mFirstIndex{ 0U };
+	std::uint32_t mIndexCount{ 0U };
+
+	DirectX::XMFLOAT3 mBoundingSphereCenter{ 0.0f, 0.0f, 0.0f };
+	float mBoundingSphereRadius{ 0.0f };
+
+	// Cone that contains the normals of all the triangles. mConeCutoff is the sine of its
+	// half angle. Meshlets with normals spread in more than a hemisphere have a zero
+	// axis and a cutoff of 1.0f, so they are never back facing.
+	DirectX::XMFLOAT3 mConeAxis{ 0.0f, 0.0f, 0.0f };
+	float mConeCutoff{ 1.0f };
+};
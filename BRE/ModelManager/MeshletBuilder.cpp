@@ -0,0 +1,290 @@
+#include "MeshletBuilder.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#include <Utils/DebugUtils.h>
+
+namespace {
+	const std::uint32_t sInvalidIndex{ 0xFFFFFFFF };
+
+	// Normal cones with a minimum dot product below it are not worth culling
+	const float sMinConeDot{ 0.1f };
+
+	// Weight of the angle between a triangle normal and the meshlet average normal,
+	// relative to the number of new vertices, when choosing the next triangle.
+	// It keeps meshlets flatter, so their normal cones are narrower (and more of them are back face culled),
+	// at the cost of a worse vertex cache usage.
+	const float sConeWeight{ 0.25f };
+
+	DirectX::XMFLOAT3 ComputeTriangleNormal(
+		const GeometryGenerator::Vertex* vertices,
+		const std::uint32_t* triangleIndices) noexcept
+	{
+		const DirectX::XMFLOAT3& p0 = vertices[triangleIndices[0U]].mPosition;
+		const DirectX::XMFLOAT3& p1 = vertices[triangleIndices[1U]].mPosition;
+		const DirectX::XMFLOAT3& p2 = vertices[triangleIndices[2U]].mPosition;
+		const DirectX::XMFLOAT3 edge1{ p1.x - p0.x, p1.y - p0.y, p1.z - p0.z };
+		const DirectX::XMFLOAT3 edge2{ p2.x - p0.x, p2.y - p0.y, p2.z - p0.z };
+		DirectX::XMFLOAT3 normal{
+			edge1.y * edge2.z - edge1.z * edge2.y,
+			edge1.z * edge2.x - edge1.x * edge2.z,
+			edge1.x * edge2.y - edge1.y * edge2.x
+		};
+
+		// Degenerate triangles have a zero normal
+		const float length{ std::sqrt(normal.x * normal.x + normal.y * normal.y + normal.z * normal.z) };
+		if (length > 0.0f) {
+			normal.x /= length;
+			normal.y /= length;
+			normal.z /= length;
+		}
+
+		return normal;
+	}
+
+	// Compressed sparse rows of the triangles that use each vertex
+	struct VertexTriangleAdjacency {
+		std::vector<std::uint32_t> mOffsets;
+		std::vector<std::uint32_t> mTriangles;
+	};
+
+	void BuildVertexTriangleAdjacency(
+		const std::uint32_t* indices,
+		const std::size_t indexCount,
+		const std::size_t vertexCount,
+		VertexTriangleAdjacency& adjacency) noexcept
+	{
+		adjacency.mOffsets.assign(vertexCount + 1UL, 0U);
+		for (std::size_t i = 0UL; i < indexCount; ++i) {
+			++adjacency.mOffsets[indices[i] + 1UL];
+		}
+		for (std::size_t i = 1UL; i <= vertexCount; ++i) {
+			adjacency.mOffsets[i] += adjacency.mOffsets[i - 1UL];
+		}
+
+		adjacency.mTriangles.resize(indexCount);
+		std::vector<std::uint32_t> insertPositions(adjacency.mOffsets.begin(), adjacency.mOffsets.end() - 1);
+		for (std::size_t i = 0UL; i < indexCount; ++i) {
+			adjacency.mTriangles[insertPositions[indices[i]]++] = static_cast<std::uint32_t>(i / 3UL);
+		}
+	}
+}
+
+namespace MeshletBuilder {
+	void BuildMeshlets(
+		GeometryGenerator::MeshData& meshData,
+		const std::size_t indexCount,
+		std::vector<Meshlet>& meshlets) noexcept
+	{
+		ASSERT(indexCount % 3UL == 0UL);
+		ASSERT(indexCount <= meshData.mIndices32.size());
+
+		meshlets.clear();
+
+		const std::size_t triangleCount{ indexCount / 3UL };
+		if (triangleCount < sMinTriangleCount) {
+			return;
+		}
+
+		const std::uint32_t* indices{ meshData.mIndices32.data() };
+		const std::size_t vertexCount{ meshData.mVertices.size() };
+		VertexTriangleAdjacency adjacency;
+		BuildVertexTriangleAdjacency(indices, indexCount, vertexCount, adjacency);
+
+		std::vector<DirectX::XMFLOAT3> triangleNormals(triangleCount);
+		for (std::size_t i = 0UL; i < triangleCount; ++i) {
+			triangleNormals[i] = ComputeTriangleNormal(meshData.mVertices.data(), indices + i * 3UL);
+		}
+
+		// Meshlet that each vertex belongs to (the last one that used it)
+		std::vector<std::uint32_t> vertexMeshlets(vertexCount, sInvalidIndex);
+		std::vector<bool> isTriangleEmitted(triangleCount, false);
+		std::vector<std::uint32_t> meshletVertices;
+		meshletVertices.reserve(sMaxMeshletVertexCount);
+		std::vector<std::uint32_t> meshletTriangles;
+		meshletTriangles.reserve(sMaxMeshletTriangleCount);
+		std::vector<std::uint32_t> sortedIndices;
+		sortedIndices.reserve(indexCount);
+
+		std::size_t nextSeedTriangle{ 0UL };
+		while (sortedIndices.size() < indexCount) {
+			const std::uint32_t meshletIndex{ static_cast<std::uint32_t>(meshlets.size()) };
+			meshletVertices.clear();
+			meshletTriangles.clear();
+			DirectX::XMFLOAT3 meshletNormal{ 0.0f, 0.0f, 0.0f };
+
+			while (meshletTriangles.size() < sMaxMeshletTriangleCount) {
+				const float meshletNormalLength{
+					std::sqrt(meshletNormal.x * meshletNormal.x + meshletNormal.y * meshletNormal.y + meshletNormal.z * meshletNormal.z) };
+				const float meshletNormalScale{ meshletNormalLength > 0.0f ? 1.0f / meshletNormalLength : 0.0f };
+
+				// Find the adjacent triangle that adds less vertices and whose normal is closer
+				// to the meshlet average normal (the first one in the current order if there are several)
+				std::uint32_t bestTriangle{ sInvalidIndex };
+				std::uint32_t bestNewVertexCount{ 3U };
+				float bestScore{ FLT_MAX };
+				for (const std::uint32_t vertex : meshletVertices) {
+					for (std::uint32_t i = adjacency.mOffsets[vertex]; i < adjacency.mOffsets[vertex + 1U]; ++i) {
+						const std::uint32_t triangle{ adjacency.mTriangles[i] };
+						if (isTriangleEmitted[triangle]) {
+							continue;
+						}
+
+						std::uint32_t newVertexCount{ 0U };
+						for (std::uint32_t j = 0U; j < 3U; ++j) {
+							newVertexCount += vertexMeshlets[indices[triangle * 3U + j]] != meshletIndex ? 1U : 0U;
+						}
+
+						const DirectX::XMFLOAT3& normal = triangleNormals[triangle];
+						const float normalDot{
+							(normal.x * meshletNormal.x + normal.y * meshletNormal.y + normal.z * meshletNormal.z) * meshletNormalScale };
+						const float score{ static_cast<float>(newVertexCount) + (1.0f - normalDot) * sConeWeight };
+						if (score < bestScore || (score == bestScore && triangle < bestTriangle)) {
+							bestTriangle = triangle;
+							bestNewVertexCount = newVertexCount;
+							bestScore = score;
+						}
+					}
+				}
+
+				// If there are no adjacent triangles, continue with the next triangle in the current order,
+				// as vertex cache optimization keeps near triangles together.
+				if (bestTriangle == sInvalidIndex) {
+					while (nextSeedTriangle < triangleCount && isTriangleEmitted[nextSeedTriangle]) {
+						++nextSeedTriangle;
+					}
+					if (nextSeedTriangle == triangleCount) {
+						break;
+					}
+
+					bestTriangle = static_cast<std::uint32_t>(nextSeedTriangle);
+					bestNewVertexCount = 0U;
+					for (std::uint32_t j = 0U; j < 3U; ++j) {
+						bestNewVertexCount += vertexMeshlets[indices[bestTriangle * 3U + j]] != meshletIndex ? 1U : 0U;
+					}
+				}
+
+				if (meshletVertices.size() + bestNewVertexCount > sMaxMeshletVertexCount) {
+					break;
+				}
+
+				for (std::uint32_t j = 0U; j < 3U; ++j) {
+					const std::uint32_t vertex{ indices[bestTriangle * 3U + j] };
+					if (vertexMeshlets[vertex] != meshletIndex) {
+						vertexMeshlets[vertex] = meshletIndex;
+						meshletVertices.push_back(vertex);
+					}
+				}
+				isTriangleEmitted[bestTriangle] = true;
+				meshletTriangles.push_back(bestTriangle);
+				meshletNormal.x += triangleNormals[bestTriangle].x;
+				meshletNormal.y += triangleNormals[bestTriangle].y;
+				meshletNormal.z += triangleNormals[bestTriangle].z;
+			}
+
+			ASSERT(meshletTriangles.empty() == false);
+
+			// Keep the relative order of the triangles for the vertex cache
+			std::sort(meshletTriangles.begin(), meshletTriangles.end());
+
+			Meshlet meshlet;
+			meshlet.mFirstIndex = static_cast<std::uint32_t>(sortedIndices.size());
+			meshlet.mIndexCount = static_cast<std::uint32_t>(meshletTriangles.size() * 3UL);
+			for (const std::uint32_t triangle : meshletTriangles) {
+				sortedIndices.insert(sortedIndices.end(), indices + triangle * 3U, indices + triangle * 3U + 3U);
+			}
+			meshlets.push_back(meshlet);
+		}
+
+		std::copy(sortedIndices.begin(), sortedIndices.end(), meshData.mIndices32.begin());
+
+		for (Meshlet& meshlet : meshlets) {
+			ComputeMeshletBounds(meshData.mIndices32.data(), meshData.mVertices.data(), meshlet);
+		}
+	}
+
+	void ComputeMeshletBounds(
+		const std::uint32_t* indices,
+		const GeometryGenerator::Vertex* vertices,
+		Meshlet& meshlet) noexcept
+	{
+		ASSERT(indices != nullptr);
+		ASSERT(vertices != nullptr);
+		ASSERT(meshlet.mIndexCount > 0U);
+
+		const std::uint32_t* meshletIndices{ indices + meshlet.mFirstIndex };
+
+		// Bounding sphere centered at the bounding box center
+		DirectX::XMFLOAT3 minPosition{ vertices[meshletIndices[0U]].mPosition };
+		DirectX::XMFLOAT3 maxPosition{ minPosition };
+		for (std::uint32_t i = 1U; i < meshlet.mIndexCount; ++i) {
+			const DirectX::XMFLOAT3& position = vertices[meshletIndices[i]].mPosition;
+			minPosition.x = std::min<float>(minPosition.x, position.x);
+			minPosition.y = std::min<float>(minPosition.y, position.y);
+			minPosition.z = std::min<float>(minPosition.z, position.z);
+			maxPosition.x = std::max<float>(maxPosition.x, position.x);
+			maxPosition.y = std::max<float>(maxPosition.y, position.y);
+			maxPosition.z = std::max<float>(maxPosition.z, position.z);
+		}
+
+		const DirectX::XMFLOAT3 center{
+			(minPosition.x + maxPosition.x) * 0.5f,
+			(minPosition.y + maxPosition.y) * 0.5f,
+			(minPosition.z + maxPosition.z) * 0.5f
+		};
+		float squaredRadius{ 0.0f };
+		for (std::uint32_t i = 0U; i < meshlet.mIndexCount; ++i) {
+			const DirectX::XMFLOAT3& position = vertices[meshletIndices[i]].mPosition;
+			const float x{ position.x - center.x };
+			const float y{ position.y - center.y };
+			const float z{ position.z - center.z };
+			squaredRadius = std::max<float>(squaredRadius, x * x + y * y + z * z);
+		}
+		meshlet.mBoundingSphereCenter = center;
+		meshlet.mBoundingSphereRadius = std::sqrt(squaredRadius);
+
+		// Normal cone. Its axis is the average triangle normal.
+		const std::uint32_t triangleCount{ meshlet.mIndexCount / 3U };
+		std::vector<DirectX::XMFLOAT3> normals;
+		normals.reserve(triangleCount);
+		DirectX::XMFLOAT3 axis{ 0.0f, 0.0f, 0.0f };
+		for (std::uint32_t i = 0U; i < triangleCount; ++i) {
+			const DirectX::XMFLOAT3 normal{ ComputeTriangleNormal(vertices, meshletIndices + i * 3U) };
+
+			// Degenerate triangles are never rasterized
+			if (normal.x == 0.0f && normal.y == 0.0f && normal.z == 0.0f) {
+				continue;
+			}
+
+			normals.push_back(normal);
+			axis.x += normal.x;
+			axis.y += normal.y;
+			axis.z += normal.z;
+		}
+
+		meshlet.mConeAxis = DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f);
+		meshlet.mConeCutoff = 1.0f;
+
+		const float axisLength{ std::sqrt(axis.x * axis.x + axis.y * axis.y + axis.z * axis.z) };
+		if (axisLength <= 0.0f) {
+			return;
+		}
+
+		axis.x /= axisLength;
+		axis.y /= axisLength;
+		axis.z /= axisLength;
+		float minDot{ 1.0f };
+		for (const DirectX::XMFLOAT3& normal : normals) {
+			minDot = std::min<float>(minDot, normal.x * axis.x + normal.y * axis.y + normal.z * axis.z);
+		}
+
+		if (minDot <= sMinConeDot) {
+			return;
+		}
+
+		meshlet.mConeAxis = axis;
+		meshlet.mConeCutoff = std::sqrt(1.0f - minDot * minDot);
+	}
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <GeometryGenerator/GeometryGenerator.h>
+#include <ModelManager/Meshlet.h>
+
+// To partition the triangles of a mesh into meshlets (clusters of at most sMaxMeshletVertexCount
+// vertices and sMaxMeshletTriangleCount triangles) with bounding spheres and normal cones,
+// so they can be culled against the frustum and back face culled (see MeshletCuller).
+// Meshlets grow through adjacent triangles (preferring the ones that add less vertices)
+// and their triangles keep their relative order, so vertex cache optimization is mostly preserved.
+namespace MeshletBuilder {
+	// Meshes with less triangles do not have meshlets, as culling them
+	// costs more than drawing their triangles.
+	const std::size_t sMinTriangleCount{ 1024UL };
+
+	// Reorders the triangles in [0, indexCount) of "meshData" indices, so each meshlet is contiguous,
+	// and fills "meshlets". "meshlets" is empty if the mesh has less than sMinTriangleCount triangles.
+	// Preconditions:
+	// - "indexCount" must be a multiple of 3 and it must not be greater than "meshData" index count
+	void BuildMeshlets(
+		GeometryGenerator::MeshData& meshData,
+		const std::size_t indexCount,
+		std::vector<Meshlet>& meshlets) noexcept;
+
+	// Computes bounding sphere and normal cone of the meshlet triangles
+	// Preconditions:
+	// - "meshlet" index range must be valid in "indices"
+	void ComputeMeshletBounds(
+		const std::uint32_t* indices,
+		const GeometryGenerator::Vertex* vertices,
+		Meshlet& meshlet) noexcept;
+}
@@ -1,26 +1,84 @@
 #include "Model.h"
 
 #include <assimp/Importer.hpp>
-#include <assimp/postprocess.h>
 #include <assimp/scene.h>
+#include <cstring>
 
+#include <ModelManager/MeshDataConverter.h>
 #include <ResourceManager/ResourceManager.h>
 #include <SettingsManager\SettingsManager.h>
 #include <Utils/DebugUtils.h>
+#include <Utils/MemoryMappedFile.h>
 
-Model::Model(
-	const char* modelFilename, 
-	ID3D12GraphicsCommandList& commandList,
-	Microsoft::WRL::ComPtr<ID3D12Resource>& uploadVertexBuffer,
-	Microsoft::WRL::ComPtr<ID3D12Resource>& uploadIndexBuffer) 
-{
+namespace {
+	bool IsCookedModelFile(const char* filePath) noexcept {
+		ASSERT(filePath != nullptr);
+
+		const char* extension{ std::strrchr(filePath, '.') };
+		return extension != nullptr && std::strcmp(extension + 1, CookedModel::sFileExtension) == 0;
+	}
+
+	void ReadCookedModel(
+		const std::uint8_t* modelData,
+		const std::size_t modelDataSize,
+		std::vector<CookedModel::MeshView>& meshViews) noexcept
+	{
+		if (CookedModel::Read(modelData, modelDataSize, meshViews) == false) {
+			MessageBox(nullptr, L"Invalid cooked model (it must be cooked again with ModelCooker)", nullptr, 0);
+			ASSERT(false);
+		}
+	}
+}
+
+Model::Model(const char* modelFilename) {
 	ASSERT(modelFilename != nullptr);
 	std::string filePath(SettingsManager::sResourcesPath);
 	filePath += modelFilename;
 
+	// Cooked models are used in place from the mapped file
+	if (IsCookedModelFile(modelFilename)) {
+		MemoryMappedFile file;
+		const bool result{ file.Open(filePath.c_str()) };
+		ASSERT(result);
+
+		std::vector<CookedModel::MeshView> meshViews;
+		ReadCookedModel(file.GetData(), file.GetSize(), meshViews);
+		CreateMeshes(meshViews);
+		return;
+	}
+
+	Assimp::Importer importer;
+	const aiScene* scene{ importer.ReadFile(filePath.c_str(), MeshDataConverter::GetImportFlags()) };
+	if (scene == nullptr) {
+		const std::string errorMessage{ importer.GetErrorString() };
+		const std::wstring wideErrorMessage = StringUtils::AnsiToWString(errorMessage);
+		MessageBox(nullptr, wideErrorMessage.c_str(), nullptr, 0);
+		ASSERT(scene != nullptr);
+	}
+
+	CreateMeshes(*scene);
+}
+
+Model::Model(
+	const std::uint8_t* modelData,
+	const std::size_t modelDataSize,
+	const char* fileExtension)
+{
+	ASSERT(modelData != nullptr);
+	ASSERT(modelDataSize > 0UL);
+	ASSERT(fileExtension != nullptr);
+
+	if (std::strcmp(fileExtension, CookedModel::sFileExtension) == 0) {
+		std::vector<CookedModel::MeshView> meshViews;
+		ReadCookedModel(modelData, modelDataSize, meshViews);
+		CreateMeshes(meshViews);
+		return;
+	}
+
 	Assimp::Importer importer;
-	const std::uint32_t flags{ aiProcessPreset_TargetRealtime_Fast | aiProcess_ConvertToLeftHanded };
-	const aiScene* scene{ importer.ReadFile(filePath.c_str(), flags) };
+	const aiScene* scene{ 
+		importer.ReadFileFromMemory(modelData, modelDataSize, MeshDataConverter::GetImportFlags(), fileExtension) 
+	};
 	if (scene == nullptr) {
 		const std::string errorMessage{ importer.GetErrorString() };
 		const std::wstring wideErrorMessage = StringUtils::AnsiToWString(errorMessage);
@@ -28,20 +86,49 @@ Model::Model(
 		ASSERT(scene != nullptr);
 	}
 
-	ASSERT(scene->HasMeshes());
+	CreateMeshes(*scene);
+}
+
+Model::Model(const GeometryGenerator::MeshData& meshData) {
+	mMeshes.push_back(Mesh(meshData));
+
+	ComputeBoundingBox();
+}
+
+void Model::ReleaseBuffers() noexcept {
+	for (Mesh& mesh : mMeshes) {
+		mesh.ReleaseBuffers();
+	}
+}
+
+void Model::CreateMeshes(const aiScene& scene) noexcept {
+	ASSERT(scene.HasMeshes());
 
-	for (std::uint32_t i = 0U; i < scene->mNumMeshes; ++i) {
-		aiMesh* mesh{ scene->mMeshes[i] };
+	for (std::uint32_t i = 0U; i < scene.mNumMeshes; ++i) {
+		aiMesh* mesh{ scene.mMeshes[i] };
 		ASSERT(mesh != nullptr);
-		mMeshes.push_back(Mesh(*mesh, commandList, uploadVertexBuffer, uploadIndexBuffer));
+		mMeshes.push_back(Mesh(*mesh));
 	}
+
+	ComputeBoundingBox();
 }
 
-Model::Model(
-	const GeometryGenerator::MeshData& meshData, 
-	ID3D12GraphicsCommandList& commandList,
-	Microsoft::WRL::ComPtr<ID3D12Resource>& uploadVertexBuffer,
-	Microsoft::WRL::ComPtr<ID3D12Resource>& uploadIndexBuffer) 
-{
-	mMeshes.push_back(Mesh(meshData, commandList, uploadVertexBuffer, uploadIndexBuffer));
+void Model::CreateMeshes(const std::vector<CookedModel::MeshView>& meshViews) noexcept {
+	ASSERT(meshViews.empty() == false);
+
+	for (const CookedModel::MeshView& meshView : meshViews) {
+		mMeshes.push_back(Mesh(meshView));
+	}
+
+	ComputeBoundingBox();
+}
+
+void Model::ComputeBoundingBox() noexcept {
+	ASSERT(HasMeshes());
+
+	mBoundingBox = mMeshes[0U].GetBoundingBox();
+	const std::size_t meshCount{ mMeshes.size() };
+	for (std::size_t i = 1UL; i < meshCount; ++i) {
+		DirectX::BoundingBox::CreateMerged(mBoundingBox, mBoundingBox, mMeshes[i].GetBoundingBox());
+	}
 }
\ No newline at end of file
@@ -1,13 +1,12 @@
 #pragma once
 
+#include <DirectXCollision.h>
 #include <vector>
-#include <wrl.h>
 
 #include <GeometryGenerator/GeometryGenerator.h>
 #include <ModelManager/Mesh.h>
 
-struct ID3D12GraphicsCommandList;
-struct ID3D12Resource;
+struct aiScene;
 
 // - To load model data from a filepath.
 // - To get meshes 
@@ -19,25 +18,40 @@ public:
 	Model(Model&&) = delete;
 	Model& operator=(Model&&) = delete;
 
-	// Command lists are used to store buffers creation (vertex and index per mesh)
-	// Preconditions:
-	// - "commandList" must be in recorded state before calling these method.
-	// - "commandList" must be executed after calling these methods, to create the commited resource.
-	explicit Model(
-		const char* modelFilename,
-		ID3D12GraphicsCommandList& commandList,
-		Microsoft::WRL::ComPtr<ID3D12Resource>& uploadVertexBuffer,
-		Microsoft::WRL::ComPtr<ID3D12Resource>& uploadIndexBuffer);
+	// Buffers data is uploaded by TransferManager (vertex and index per mesh). 
+	// It must be flushed before the buffers are used.
+	// Cooked models (CookedModel::sFileExtension) are memory mapped and they are not imported by assimp.
+	explicit Model(const char* modelFilename);
 
+	// "modelData" is the content of a model file that was already read, and 
+	// "fileExtension" is its extension (for example, "obj"), to know its format.
 	explicit Model(
-		const GeometryGenerator::MeshData& meshData,
-		ID3D12GraphicsCommandList& commandList,
-		Microsoft::WRL::ComPtr<ID3D12Resource>& uploadVertexBuffer,
-		Microsoft::WRL::ComPtr<ID3D12Resource>& uploadIndexBuffer);
+		const std::uint8_t* modelData,
+		const std::size_t modelDataSize,
+		const char* fileExtension);
+
+	explicit Model(const GeometryGenerator::MeshData& meshData);
 
 	__forceinline bool HasMeshes() const noexcept { return (mMeshes.size() > 0UL); }
 	__forceinline const std::vector<Mesh>& GetMeshes() const noexcept { return mMeshes; }
 
+	// Object space axis aligned bounding box that encloses all the meshes.
+	// It is computed once, when the model is created.
+	__forceinline const DirectX::BoundingBox& GetBoundingBox() const noexcept { return mBoundingBox; }
+
+	// Releases the shared buffers of all the meshes (see Mesh::ReleaseBuffers()).
+	// ModelManager calls it before destroying a model.
+	// Preconditions:
+	// - GPU must have finished using the buffers
+	void ReleaseBuffers() noexcept;
+
 private:
+	void CreateMeshes(const aiScene& scene) noexcept;
+
+	void CreateMeshes(const std::vector<CookedModel::MeshView>& meshViews) noexcept;
+
+	void ComputeBoundingBox() noexcept;
+
 	std::vector<Mesh> mMeshes;
+	DirectX::BoundingBox mBoundingBox;
 };
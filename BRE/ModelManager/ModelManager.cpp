@@ -1,105 +1,210 @@
 #include "ModelManager.h"
 
+#include <cstring>
+
 #include <GeometryGenerator\GeometryGenerator.h>
+#include <ModelManager/MeshDataConverter.h>
+#include <ModelManager/MeshOptimizer.h>
 #include <Utils/DebugUtils.h>
+#include <Utils/HashUtils.h>
+
+namespace {
+	// Built-in geometry key from its name, its float parameters and its integer parameters.
+	// Integers are hashed as integers, so every value gives a different key.
+	std::uint64_t GetBuiltInGeometryKey(
+		const char* geometryName,
+		const float* floatParameters,
+		const std::size_t floatParameterCount,
+		const std::uint32_t* integerParameters,
+		const std::size_t integerParameterCount) noexcept
+	{
+		ASSERT(geometryName != nullptr);
+		ASSERT(floatParameters != nullptr);
+		ASSERT(integerParameters != nullptr);
+
+		const std::uint64_t nameHash{ HashUtils::HashData(geometryName, std::strlen(geometryName)) };
+		const std::uint64_t floatParametersHash{ 
+			HashUtils::HashData(floatParameters, sizeof(float) * floatParameterCount, nameHash) };
+
+		return HashUtils::HashData(integerParameters, sizeof(std::uint32_t) * integerParameterCount, floatParametersHash);
+	}
+}
 
 ModelManager::Models ModelManager::mModels;
+std::mutex ModelManager::mModelsMutex;
+ModelManager::ModelRegistry ModelManager::mModelRegistry;
 std::mutex ModelManager::mMutex;
 
-void ModelManager::EraseAll() noexcept {
-	for (Model* model : mModels) {
+template<typename CreateModelFunction>
+Model& ModelManager::AcquireOrCreateModel(
+	const std::uint64_t key,
+	CreateModelFunction createModel) noexcept
+{
+	Model* model{ nullptr };
+	if (mModelRegistry.Acquire(key, model)) {
 		ASSERT(model != nullptr);
-		delete model;
+		return *model;
+	}
+
+	model = createModel();
+	ASSERT(model != nullptr);
+
+	// If another thread registered the same model after our Acquire(), then we use its model,
+	// and ours releases its references of the shared buffers before it is destroyed.
+	// Models are registered and stored under the lock, so a model that other threads
+	// can acquire can also be released.
+	Model* registeredModel{ model };
+	{
+		std::lock_guard<std::mutex> lock(mModelsMutex);
+		if (mModelRegistry.Register(key, registeredModel)) {
+			mModels.emplace(model, key);
+			return *model;
+		}
 	}
+
+	model->ReleaseBuffers();
+	delete model;
+
+	return *registeredModel;
 }
 
-Model& ModelManager::LoadModel(
-	const char* modelFilename, 
-	ID3D12GraphicsCommandList& commandList,
-	Microsoft::WRL::ComPtr<ID3D12Resource>& uploadVertexBuffer,
-	Microsoft::WRL::ComPtr<ID3D12Resource>& uploadIndexBuffer) noexcept 
-{
-	ASSERT(modelFilename != nullptr);
+void ModelManager::EraseAll() noexcept {
+	std::lock_guard<std::mutex> lock(mModelsMutex);
+	for (const Models::value_type& modelAndKey : mModels) {
+		ASSERT(modelAndKey.first != nullptr);
+		delete modelAndKey.first;
+	}
+	mModels.clear();
 
-	Model* model{ nullptr };
+	mModelRegistry.Clear();
+}
 
-	mMutex.lock();
-	model = new Model(modelFilename, commandList, uploadVertexBuffer, uploadIndexBuffer);
-	mMutex.unlock();
+void ModelManager::ReleaseModel(Model& model) noexcept {
+	std::uint64_t key{ 0UL };
+	{
+		std::lock_guard<std::mutex> lock(mModelsMutex);
+		const Models::const_iterator it = mModels.find(&model);
+		ASSERT(it != mModels.end());
+		key = it->second;
+	}
 
-	ASSERT(model != nullptr);
-	mModels.insert(model);
+	Model* releasedModel{ nullptr };
+	if (mModelRegistry.Release(key, releasedModel) > 0U) {
+		return;
+	}
+	ASSERT(releasedModel == &model);
+
+	// The model is not registered anymore, so no other thread can acquire it
+	{
+		std::lock_guard<std::mutex> lock(mModelsMutex);
+		mModels.erase(&model);
+	}
 
-	return *model;
+	model.ReleaseBuffers();
+	delete &model;
+}
+
+Model& ModelManager::LoadModel(const char* modelFilename) noexcept {
+	ASSERT(modelFilename != nullptr);
+
+	// Import flags are the seed, so the key changes if they change
+	const std::uint64_t key{ 
+		HashUtils::HashData(modelFilename, std::strlen(modelFilename), MeshDataConverter::GetImportFlags()) 
+	};
+
+	return AcquireOrCreateModel(
+		key,
+		[modelFilename]() {
+			std::lock_guard<std::mutex> lock(mMutex);
+			return new Model(modelFilename);
+		});
+}
+
+Model& ModelManager::LoadModelFromMemory(
+	const std::uint8_t* modelData,
+	const std::size_t modelDataSize,
+	const char* fileExtension) noexcept
+{
+	ASSERT(modelData != nullptr);
+	ASSERT(fileExtension != nullptr);
+
+	// There is no file path, so the key is the hash of the file content
+	const std::uint64_t extensionHash{
+		HashUtils::HashData(fileExtension, std::strlen(fileExtension), MeshDataConverter::GetImportFlags())
+	};
+	const std::uint64_t key{ HashUtils::HashData(modelData, modelDataSize, extensionHash) };
+
+	return AcquireOrCreateModel(
+		key,
+		[modelData, modelDataSize, fileExtension]() {
+			return new Model(modelData, modelDataSize, fileExtension);
+		});
 }
 
 Model& ModelManager::CreateBox(
 	const float width, 
 	const float height, 
 	const float depth, 
-	const std::uint32_t numSubdivisions,
-	ID3D12GraphicsCommandList& commandList,
-	Microsoft::WRL::ComPtr<ID3D12Resource>& uploadVertexBuffer,
-	Microsoft::WRL::ComPtr<ID3D12Resource>& uploadIndexBuffer) noexcept 
+	const std::uint32_t numSubdivisions) noexcept 
 {
-	Model* model{ nullptr };
-
-	GeometryGenerator::MeshData meshData;
-	GeometryGenerator::CreateBox(width, height, depth, numSubdivisions, meshData);
-
-	mMutex.lock();
-	model = new Model(meshData, commandList, uploadVertexBuffer, uploadIndexBuffer);
-	mMutex.unlock();
-
-	ASSERT(model != nullptr);
-	mModels.insert(model);
-
-	return *model;
+	const float floatParameters[]{ width, height, depth };
+	const std::uint32_t integerParameters[]{ numSubdivisions };
+	const std::uint64_t key{ 
+		GetBuiltInGeometryKey("Box", floatParameters, _countof(floatParameters), integerParameters, _countof(integerParameters)) };
+
+	return AcquireOrCreateModel(
+		key,
+		[=]() {
+			GeometryGenerator::MeshData meshData;
+			GeometryGenerator::CreateBox(width, height, depth, numSubdivisions, meshData);
+			MeshOptimizer::OptimizeMesh(meshData);
+
+			std::lock_guard<std::mutex> lock(mMutex);
+			return new Model(meshData);
+		});
 }
 
 Model& ModelManager::CreateSphere(
 	const float radius, 
 	const std::uint32_t sliceCount, 
-	const std::uint32_t stackCount, 
-	ID3D12GraphicsCommandList& commandList,
-	Microsoft::WRL::ComPtr<ID3D12Resource>& uploadVertexBuffer,
-	Microsoft::WRL::ComPtr<ID3D12Resource>& uploadIndexBuffer) noexcept
+	const std::uint32_t stackCount) noexcept
 {
-	Model* model{ nullptr };
-
-	GeometryGenerator::MeshData meshData;
-	GeometryGenerator::CreateSphere(radius, sliceCount, stackCount, meshData);
-
-	mMutex.lock();
-	model = new Model(meshData, commandList, uploadVertexBuffer, uploadIndexBuffer);
-	mMutex.unlock();
-
-	ASSERT(model != nullptr);
-	mModels.insert(model);
-
-	return *model;
+	const float floatParameters[]{ radius };
+	const std::uint32_t integerParameters[]{ sliceCount, stackCount };
+	const std::uint64_t key{ 
+		GetBuiltInGeometryKey("Sphere", floatParameters, _countof(floatParameters), integerParameters, _countof(integerParameters)) };
+
+	return AcquireOrCreateModel(
+		key,
+		[=]() {
+			GeometryGenerator::MeshData meshData;
+			GeometryGenerator::CreateSphere(radius, sliceCount, stackCount, meshData);
+			MeshOptimizer::OptimizeMesh(meshData);
+
+			std::lock_guard<std::mutex> lock(mMutex);
+			return new Model(meshData);
+		});
 }
 
 Model& ModelManager::CreateGeosphere(
 	const float radius, 
-	const std::uint32_t numSubdivisions, 
-	ID3D12GraphicsCommandList& commandList,
-	Microsoft::WRL::ComPtr<ID3D12Resource>& uploadVertexBuffer,
-	Microsoft::WRL::ComPtr<ID3D12Resource>& uploadIndexBuffer) noexcept 
+	const std::uint32_t numSubdivisions) noexcept 
 {
-	Model* model{ nullptr };
-
-	GeometryGenerator::MeshData meshData;
-	GeometryGenerator::CreateGeosphere(radius, numSubdivisions, meshData);
-
-	mMutex.lock();
-	model = new Model(meshData, commandList, uploadVertexBuffer, uploadIndexBuffer);
-	mMutex.unlock();
-
-	ASSERT(model != nullptr);
-	mModels.insert(model);
-
-	return *model;
+	const float floatParameters[]{ radius };
+	const std::uint32_t integerParameters[]{ numSubdivisions };
+	const std::uint64_t key{ 
+		GetBuiltInGeometryKey("Geosphere", floatParameters, _countof(floatParameters), integerParameters, _countof(integerParameters)) };
+
+	return AcquireOrCreateModel(
+		key,
+		[=]() {
+			GeometryGenerator::MeshData meshData;
+			GeometryGenerator::CreateGeosphere(radius, numSubdivisions, meshData);
+			MeshOptimizer::OptimizeMesh(meshData);
+
+			std::lock_guard<std::mutex> lock(mMutex);
+			return new Model(meshData);
+		});
 }
 
 Model& ModelManager::CreateCylinder(
@@ -107,46 +212,44 @@ Model& ModelManager::CreateCylinder(
 	const float topRadius,
 	const float height, 
 	const std::uint32_t sliceCount,
-	const std::uint32_t stackCount,
-	ID3D12GraphicsCommandList& commandList,
-	Microsoft::WRL::ComPtr<ID3D12Resource>& uploadVertexBuffer,
-	Microsoft::WRL::ComPtr<ID3D12Resource>& uploadIndexBuffer) noexcept 
+	const std::uint32_t stackCount) noexcept 
 {
-	Model* model{ nullptr };
-
-	GeometryGenerator::MeshData meshData;
-	GeometryGenerator::CreateCylinder(bottomRadius, topRadius, height, sliceCount, stackCount, meshData);
-
-	mMutex.lock();
-	model = new Model(meshData, commandList, uploadVertexBuffer, uploadIndexBuffer);
-	mMutex.unlock();
-
-	ASSERT(model != nullptr);
-	mModels.insert(model);
-
-	return *model;
+	const float floatParameters[]{ bottomRadius, topRadius, height };
+	const std::uint32_t integerParameters[]{ sliceCount, stackCount };
+	const std::uint64_t key{ 
+		GetBuiltInGeometryKey("Cylinder", floatParameters, _countof(floatParameters), integerParameters, _countof(integerParameters)) };
+
+	return AcquireOrCreateModel(
+		key,
+		[=]() {
+			GeometryGenerator::MeshData meshData;
+			GeometryGenerator::CreateCylinder(bottomRadius, topRadius, height, sliceCount, stackCount, meshData);
+			MeshOptimizer::OptimizeMesh(meshData);
+
+			std::lock_guard<std::mutex> lock(mMutex);
+			return new Model(meshData);
+		});
 }
 
 Model& ModelManager::CreateGrid(
 	const float width, 
 	const float depth, 
 	const std::uint32_t rows, 
-	const std::uint32_t columns, 
-	ID3D12GraphicsCommandList& commandList,
-	Microsoft::WRL::ComPtr<ID3D12Resource>& uploadVertexBuffer,
-	Microsoft::WRL::ComPtr<ID3D12Resource>& uploadIndexBuffer) noexcept 
+	const std::uint32_t columns) noexcept 
 {
-	Model* model{ nullptr };
-
-	GeometryGenerator::MeshData meshData;
-	GeometryGenerator::CreateGrid(width, depth, rows, columns, meshData);
-
-	mMutex.lock();
-	model = new Model(meshData, commandList, uploadVertexBuffer, uploadIndexBuffer);
-	mMutex.unlock();
-
-	ASSERT(model != nullptr);
-	mModels.insert(model);
-
-	return *model;
-}
\ No newline at end of file
+	const float floatParameters[]{ width, depth };
+	const std::uint32_t integerParameters[]{ rows, columns };
+	const std::uint64_t key{ 
+		GetBuiltInGeometryKey("Grid", floatParameters, _countof(floatParameters), integerParameters, _countof(integerParameters)) };
+
+	return AcquireOrCreateModel(
+		key,
+		[=]() {
+			GeometryGenerator::MeshData meshData;
+			GeometryGenerator::CreateGrid(width, depth, rows, columns, meshData);
+			MeshOptimizer::OptimizeMesh(meshData);
+
+			std::lock_guard<std::mutex> lock(mMutex);
+			return new Model(meshData);
+		});
+}
@@ -2,11 +2,16 @@
 
 #include <d3d12.h>
 #include <mutex>
-#include <tbb\concurrent_unordered_set.h>
+#include <unordered_map>
 
 #include <ModelManager/Model.h>
+#include <ResourceManager/SharedResourceRegistry.h>
 
 // To create/get models or built-in geometry.
+// Models are shared: loading the same file (or the same file content) or creating
+// built-in geometry with the same parameters returns the model that was already created.
+// Each returned model is a reference that can be released with ReleaseModel().
+// Buffers data is uploaded by TransferManager, and it must be flushed before models are drawn.
 class ModelManager {
 public:
 	ModelManager() = delete;
@@ -18,38 +23,47 @@ public:
 
 	static void EraseAll() noexcept;
 
-	static Model& LoadModel(
-		const char* modelFilename, 
-		ID3D12GraphicsCommandList& commandList,
-		Microsoft::WRL::ComPtr<ID3D12Resource>& uploadVertexBuffer,
-		Microsoft::WRL::ComPtr<ID3D12Resource>& uploadIndexBuffer) noexcept;
+	// Releases a reference of a model returned by LoadModel*() or Create*(). When there is no
+	// reference left, the model is unregistered, its buffers are released and it is destroyed.
+	// Preconditions:
+	// - "model" must have been returned by ModelManager and not released more times than returned
+	// - GPU must have finished using it, if it is its last reference
+	static void ReleaseModel(Model& model) noexcept;
+
+	using ModelRegistry = SharedResourceRegistry<Model*>;
+
+	// Hits and misses of the shared models
+	static ModelRegistry::Statistics GetStatistics() noexcept {
+		return mModelRegistry.GetStatistics();
+	}
+
+	static Model& LoadModel(const char* modelFilename) noexcept;
+
+	// Creates a model from the content of a model file that was already read.
+	// "fileExtension" is the extension of the file (for example, "obj" or CookedModel::sFileExtension).
+	// It does not lock, so several threads can load models at the same time.
+	static Model& LoadModelFromMemory(
+		const std::uint8_t* modelData,
+		const std::size_t modelDataSize,
+		const char* fileExtension) noexcept;
 
 	// Geometry is centered at the origin.
 	static Model& CreateBox(
 		const float width, 
 		const float height, 
 		const float depth, 
-		const std::uint32_t numSubdivisions, 
-		ID3D12GraphicsCommandList& commandList,
-		Microsoft::WRL::ComPtr<ID3D12Resource>& uploadVertexBuffer,
-		Microsoft::WRL::ComPtr<ID3D12Resource>& uploadIndexBuffer) noexcept;
+		const std::uint32_t numSubdivisions) noexcept;
 
 	// Geometry is centered at the origin.
 	static Model& CreateSphere(
 		const float radius, 
 		const std::uint32_t sliceCount, 
-		const std::uint32_t stackCount, 
-		ID3D12GraphicsCommandList& commandList,
-		Microsoft::WRL::ComPtr<ID3D12Resource>& uploadVertexBuffer,
-		Microsoft::WRL::ComPtr<ID3D12Resource>& uploadIndexBuffer) noexcept;
+		const std::uint32_t stackCount) noexcept;
 
 	// Geometry is centered at the origin.
 	static Model& CreateGeosphere(
 		const float radius, 
-		const std::uint32_t numSubdivisions, 
-		ID3D12GraphicsCommandList& commandList,
-		Microsoft::WRL::ComPtr<ID3D12Resource>& uploadVertexBuffer,
-		Microsoft::WRL::ComPtr<ID3D12Resource>& uploadIndexBuffer) noexcept;
+		const std::uint32_t numSubdivisions) noexcept;
 
 	// Creates a cylinder parallel to the y-axis, and centered about the origin.  
 	static Model& CreateCylinder(
@@ -57,10 +71,7 @@ public:
 		const float topRadius,
 		const float height, 
 		const std::uint32_t sliceCount,
-		const std::uint32_t stackCount,
-		ID3D12GraphicsCommandList& commandList,
-		Microsoft::WRL::ComPtr<ID3D12Resource>& uploadVertexBuffer,
-		Microsoft::WRL::ComPtr<ID3D12Resource>& uploadIndexBuffer) noexcept;
+		const std::uint32_t stackCount) noexcept;
 
 	// Creates a rows x columns grid in the xz-plane centered
 	// at the origin.
@@ -68,14 +79,21 @@ public:
 		const float width, 
 		const float depth, 
 		const std::uint32_t rows, 
-		const std::uint32_t columns, 
-		ID3D12GraphicsCommandList& commandList,
-		Microsoft::WRL::ComPtr<ID3D12Resource>& uploadVertexBuffer,
-		Microsoft::WRL::ComPtr<ID3D12Resource>& uploadIndexBuffer) noexcept;
+		const std::uint32_t columns) noexcept;
 
 private:
-	using Models = tbb::concurrent_unordered_set<Model*>;
+	// If there is a model with "key", then it returns it. Otherwise, it 
+	// creates the model with "createModel" (Model*()) and registers it.
+	template<typename CreateModelFunction>
+	static Model& AcquireOrCreateModel(
+		const std::uint64_t key, 
+		CreateModelFunction createModel) noexcept;
+
+	// Key of each model, to release it
+	using Models = std::unordered_map<Model*, std::uint64_t>;
 	static Models mModels;
+	static std::mutex mModelsMutex;
+	static ModelRegistry mModelRegistry;
 
 	static std::mutex mMutex;
 };
@@ -0,0 +1,173 @@
+#include "TangentGenerator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <tbb/parallel_for.h>
+
+#include <Utils/DebugUtils.h>
+
+using namespace DirectX;
+
+namespace {
+	// Number of triangles and vertices that each task processes
+	const std::size_t sTriangleGrainSize{ 4096UL };
+	const std::size_t sVertexGrainSize{ 8192UL };
+
+	// Triangles with a smaller texture coordinates area do not have a valid tangent
+	const float sMinTexCoordArea{ 1.0e-20f };
+
+	// It returns zero if "vector" length is zero
+	XMVECTOR Normalize(const XMVECTOR vector) noexcept {
+		const float squaredLength{ XMVectorGetX(XMVector3LengthSq(vector)) };
+
+		return squaredLength > 0.0f ? XMVectorScale(vector, 1.0f / std::sqrt(squaredLength)) : XMVectorZero();
+	}
+
+	// Returns "vector" projected to the plane perpendicular to "normal", and normalized.
+	// It returns zero if the projection is zero.
+	XMVECTOR ProjectToPlane(const XMVECTOR vector, const XMVECTOR normal) noexcept {
+		return Normalize(XMVectorSubtract(vector, XMVectorMultiply(normal, XMVector3Dot(normal, vector))));
+	}
+
+	// Stores the weighted tangent of each corner of triangles in [firstTriangle, lastTriangle)
+	void ComputeCornerTangents(
+		const std::uint32_t* indices,
+		const GeometryGenerator::Vertex* vertices,
+		const std::size_t firstTriangle,
+		const std::size_t lastTriangle,
+		XMFLOAT3* cornerTangents) noexcept
+	{
+		for (std::size_t i = firstTriangle; i < lastTriangle; ++i) {
+			const std::uint32_t* triangleIndices{ indices + i * 3UL };
+			const GeometryGenerator::Vertex* triangleVertices[3U]{
+				&vertices[triangleIndices[0U]],
+				&vertices[triangleIndices[1U]],
+				&vertices[triangleIndices[2U]]
+			};
+			XMFLOAT3* triangleCornerTangents{ cornerTangents + i * 3UL };
+
+			// Triangle tangent is dP/dU. It is computed without dividing by the texture coordinates
+			// area (only its sign matters) as it is normalized for each corner.
+			const XMVECTOR position0 = XMLoadFloat3(&triangleVertices[0U]->mPosition);
+			const XMVECTOR edge1 = XMVectorSubtract(XMLoadFloat3(&triangleVertices[1U]->mPosition), position0);
+			const XMVECTOR edge2 = XMVectorSubtract(XMLoadFloat3(&triangleVertices[2U]->mPosition), position0);
+			const float s1{ triangleVertices[1U]->mUV.x - triangleVertices[0U]->mUV.x };
+			const float t1{ triangleVertices[1U]->mUV.y - triangleVertices[0U]->mUV.y };
+			const float s2{ triangleVertices[2U]->mUV.x - triangleVertices[0U]->mUV.x };
+			const float t2{ triangleVertices[2U]->mUV.y - triangleVertices[0U]->mUV.y };
+			const float texCoordArea{ s1 * t2 - s2 * t1 };
+			if (std::abs(texCoordArea) <= sMinTexCoordArea) {
+				for (std::uint32_t j = 0U; j < 3U; ++j) {
+					triangleCornerTangents[j] = XMFLOAT3(0.0f, 0.0f, 0.0f);
+				}
+				continue;
+			}
+
+			const XMVECTOR triangleTangent = XMVectorScale(
+				XMVectorSubtract(XMVectorScale(edge1, t2), XMVectorScale(edge2, t1)),
+				texCoordArea > 0.0f ? 1.0f : -1.0f);
+
+			// Corner angles are computed from the normalized triangle edges. MikkTSpace projects
+			// the edges to the tangent plane of each corner first, but both are the same for
+			// flat triangles and the difference is negligible for smooth normals.
+			const XMVECTOR edges[3U]{
+				Normalize(edge1),
+				Normalize(XMVectorSubtract(edge2, edge1)),
+				Normalize(XMVectorNegate(edge2))
+			};
+			for (std::uint32_t j = 0U; j < 3U; ++j) {
+				const float cosAngle{ 
+					-XMVectorGetX(XMVector3Dot(edges[j], edges[(j + 2U) % 3U])) };
+				const float angle{ std::acos(std::min<float>(std::max<float>(cosAngle, -1.0f), 1.0f)) };
+
+				const XMVECTOR normal = XMLoadFloat3(&triangleVertices[j]->mNormal);
+				XMStoreFloat3(&triangleCornerTangents[j], XMVectorScale(ProjectToPlane(triangleTangent, normal), angle));
+			}
+		}
+	}
+
+	// Adds the corner tangents of vertices in [firstVertex, lastVertex), in corner order, and orthonormalizes them.
+	void AccumulateVertexTangents(
+		const TangentGenerator::Workspace& workspace,
+		const std::size_t firstVertex,
+		const std::size_t lastVertex,
+		GeometryGenerator::Vertex* vertices) noexcept
+	{
+		const std::uint32_t* cornerOffsets{ workspace.mVertexCornerOffsets.data() };
+		const std::uint32_t* corners{ workspace.mVertexCorners.data() };
+		const XMFLOAT3* cornerTangents{ workspace.mCornerTangents.data() };
+		for (std::size_t i = firstVertex; i < lastVertex; ++i) {
+			XMVECTOR tangent = XMVectorZero();
+			for (std::uint32_t j = cornerOffsets[i]; j < cornerOffsets[i + 1UL]; ++j) {
+				tangent = XMVectorAdd(tangent, XMLoadFloat3(&cornerTangents[corners[j]]));
+			}
+
+			const XMVECTOR normal = XMLoadFloat3(&vertices[i].mNormal);
+			tangent = ProjectToPlane(tangent, normal);
+
+			// Any direction perpendicular to the normal is valid
+			if (XMVectorGetX(XMVector3LengthSq(tangent)) <= 0.0f) {
+				const XMVECTOR axis = std::abs(vertices[i].mNormal.x) < 0.9f ? 
+					XMVectorSet(1.0f, 0.0f, 0.0f, 0.0f) : 
+					XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
+				tangent = ProjectToPlane(axis, normal);
+			}
+
+			XMStoreFloat3(&vertices[i].mTangent, tangent);
+		}
+	}
+}
+
+namespace TangentGenerator {
+	void ComputeTangents(
+		const std::uint32_t* indices,
+		const std::size_t indexCount,
+		GeometryGenerator::Vertex* vertices,
+		const std::size_t vertexCount,
+		Workspace& workspace) noexcept
+	{
+		ASSERT(indices != nullptr || indexCount == 0UL);
+		ASSERT(indexCount % 3UL == 0UL);
+		ASSERT(vertices != nullptr);
+
+		// Corners of each vertex (compressed sparse rows), in index buffer order
+		workspace.mVertexCornerOffsets.assign(vertexCount + 1UL, 0U);
+		for (std::size_t i = 0UL; i < indexCount; ++i) {
+			ASSERT(indices[i] < vertexCount);
+			++workspace.mVertexCornerOffsets[indices[i] + 1UL];
+		}
+		for (std::size_t i = 1UL; i <= vertexCount; ++i) {
+			workspace.mVertexCornerOffsets[i] += workspace.mVertexCornerOffsets[i - 1UL];
+		}
+		workspace.mVertexCorners.resize(indexCount);
+		for (std::size_t i = 0UL; i < indexCount; ++i) {
+			workspace.mVertexCorners[workspace.mVertexCornerOffsets[indices[i]]++] = static_cast<std::uint32_t>(i);
+		}
+		// Offsets were moved to the end of each row
+		for (std::size_t i = vertexCount; i > 0UL; --i) {
+			workspace.mVertexCornerOffsets[i] = workspace.mVertexCornerOffsets[i - 1UL];
+		}
+		workspace.mVertexCornerOffsets[0U] = 0U;
+
+		workspace.mCornerTangents.resize(indexCount);
+		const std::size_t triangleCount{ indexCount / 3UL };
+		tbb::parallel_for(tbb::blocked_range<std::size_t>(0UL, triangleCount, sTriangleGrainSize),
+			[&](const tbb::blocked_range<std::size_t>& range) {
+			ComputeCornerTangents(indices, vertices, range.begin(), range.end(), workspace.mCornerTangents.data());
+		});
+
+		tbb::parallel_for(tbb::blocked_range<std::size_t>(0UL, vertexCount, sVertexGrainSize),
+			[&](const tbb::blocked_range<std::size_t>& range) {
+			AccumulateVertexTangents(workspace, range.begin(), range.end(), vertices);
+		});
+	}
+
+	void ComputeTangents(GeometryGenerator::MeshData& meshData, Workspace& workspace) noexcept {
+		ComputeTangents(
+			meshData.mIndices32.data(),
+			meshData.mIndices32.size(),
+			meshData.mVertices.data(),
+			meshData.mVertices.size(),
+			workspace);
+	}
+}
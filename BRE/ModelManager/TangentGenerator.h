@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <GeometryGenerator/GeometryGenerator.h>
+
+// To compute vertex tangents from positions, normals and texture coordinates,
+// following MikkTSpace ("Simulation of Wrinkled Surfaces Revisited", Mikkelsen 2008):
+// - Each triangle tangent is the direction of increasing U in object space.
+// - It is projected to the tangent plane of each triangle corner (given by its vertex normal)
+//   and weighted by the corner angle.
+// - The weighted tangents of all the corners of a vertex are added and orthonormalized against its normal.
+// Vertices do not store the bitangent sign (shaders compute the bitangent as cross(normal, tangent)),
+// so vertices shared by mirrored triangles are not split.
+//
+// Triangle corners and vertices are processed in parallel ranges (TBB), and each vertex adds its
+// corners in index buffer order, so results do not depend on the number of threads.
+namespace TangentGenerator {
+	// Scratch memory. It can be reused across calls, so they do
+	// not allocate once it is big enough.
+	struct Workspace {
+		std::vector<DirectX::XMFLOAT3> mCornerTangents;
+		std::vector<std::uint32_t> mVertexCornerOffsets;
+		std::vector<std::uint32_t> mVertexCorners;
+	};
+
+	// Overwrites the tangent of every vertex. Vertices that are not used by any triangle
+	// with a valid texture coordinates mapping get an arbitrary tangent perpendicular to their normal.
+	// Preconditions:
+	// - "indices" must be a triangle list, where each index is less than "vertexCount"
+	// - "vertices" must not be nullptr and their normals must be normalized
+	void ComputeTangents(
+		const std::uint32_t* indices,
+		const std::size_t indexCount,
+		GeometryGenerator::Vertex* vertices,
+		const std::size_t vertexCount,
+		Workspace& workspace) noexcept;
+
+	void ComputeTangents(GeometryGenerator::MeshData& meshData, Workspace& workspace) noexcept;
+}
@@ -0,0 +1,229 @@
+#include "VertexCompressor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include <Utils/DebugUtils.h>
+
+namespace {
+	const float sMaxUnorm16{ 65535.0f };
+	const float sMaxSnorm16{ 32767.0f };
+
+	std::uint16_t QuantizeUnorm16(const float value) noexcept {
+		const float clampedValue{ std::min<float>(std::max<float>(value, 0.0f), 1.0f) };
+		return static_cast<std::uint16_t>(clampedValue * sMaxUnorm16 + 0.5f);
+	}
+
+	float DequantizeSnorm16(const std::int16_t value) noexcept {
+		// -32768 and -32767 are both -1.0f (like D3D SNORM formats)
+		return std::max<float>(static_cast<float>(value) / sMaxSnorm16, -1.0f);
+	}
+
+	float SignNotZero(const float value) noexcept {
+		return value >= 0.0f ? 1.0f : -1.0f;
+	}
+
+	float Dot(const DirectX::XMFLOAT3& vector1, const DirectX::XMFLOAT3& vector2) noexcept {
+		return vector1.x * vector2.x + vector1.y * vector2.y + vector1.z * vector2.z;
+	}
+}
+
+namespace VertexCompressor {
+	PositionQuantization ComputePositionQuantization(
+		const GeometryGenerator::Vertex* vertices,
+		const std::size_t vertexCount) noexcept
+	{
+		ASSERT(vertices != nullptr);
+		ASSERT(vertexCount > 0UL);
+
+		DirectX::XMFLOAT3 minPosition{ vertices[0U].mPosition };
+		DirectX::XMFLOAT3 maxPosition{ vertices[0U].mPosition };
+		for (std::size_t i = 1UL; i < vertexCount; ++i) {
+			const DirectX::XMFLOAT3& position = vertices[i].mPosition;
+			minPosition.x = std::min<float>(minPosition.x, position.x);
+			minPosition.y = std::min<float>(minPosition.y, position.y);
+			minPosition.z = std::min<float>(minPosition.z, position.z);
+			maxPosition.x = std::max<float>(maxPosition.x, position.x);
+			maxPosition.y = std::max<float>(maxPosition.y, position.y);
+			maxPosition.z = std::max<float>(maxPosition.z, position.z);
+		}
+
+		PositionQuantization positionQuantization;
+		positionQuantization.mOffset = minPosition;
+		const float maxDimension{
+			std::max<float>(std::max<float>(maxPosition.x - minPosition.x, maxPosition.y - minPosition.y), maxPosition.z - minPosition.z)
+		};
+		positionQuantization.mScale = maxDimension > 0.0f ? maxDimension : 1.0f;
+
+		return positionQuantization;
+	}
+
+	void EncodeVertices(
+		const GeometryGenerator::Vertex* vertices,
+		const std::size_t vertexCount,
+		const PositionQuantization& positionQuantization,
+		PackedVertex* packedVertices) noexcept
+	{
+		ASSERT(vertices != nullptr);
+		ASSERT(packedVertices != nullptr);
+		ASSERT(positionQuantization.mScale > 0.0f);
+
+		const float inverseScale{ 1.0f / positionQuantization.mScale };
+		for (std::size_t i = 0UL; i < vertexCount; ++i) {
+			const GeometryGenerator::Vertex& vertex = vertices[i];
+			PackedVertex& packedVertex = packedVertices[i];
+
+			packedVertex.mPosition[0U] = QuantizeUnorm16((vertex.mPosition.x - positionQuantization.mOffset.x) * inverseScale);
+			packedVertex.mPosition[1U] = QuantizeUnorm16((vertex.mPosition.y - positionQuantization.mOffset.y) * inverseScale);
+			packedVertex.mPosition[2U] = QuantizeUnorm16((vertex.mPosition.z - positionQuantization.mOffset.z) * inverseScale);
+			packedVertex.mPosition[3U] = 0xFFFF;
+
+			EncodeOctahedral(vertex.mNormal, packedVertex.mNormal);
+			EncodeOctahedral(vertex.mTangent, packedVertex.mTangent);
+
+			packedVertex.mUV[0U] = FloatToHalf(vertex.mUV.x);
+			packedVertex.mUV[1U] = FloatToHalf(vertex.mUV.y);
+		}
+	}
+
+	void DecodeVertex(
+		const PackedVertex& packedVertex,
+		const PositionQuantization& positionQuantization,
+		GeometryGenerator::Vertex& vertex) noexcept
+	{
+		const float scale{ positionQuantization.mScale / sMaxUnorm16 };
+		vertex.mPosition.x = positionQuantization.mOffset.x + static_cast<float>(packedVertex.mPosition[0U]) * scale;
+		vertex.mPosition.y = positionQuantization.mOffset.y + static_cast<float>(packedVertex.mPosition[1U]) * scale;
+		vertex.mPosition.z = positionQuantization.mOffset.z + static_cast<float>(packedVertex.mPosition[2U]) * scale;
+
+		vertex.mNormal = DecodeOctahedral(packedVertex.mNormal);
+		vertex.mTangent = DecodeOctahedral(packedVertex.mTangent);
+
+		vertex.mUV.x = HalfToFloat(packedVertex.mUV[0U]);
+		vertex.mUV.y = HalfToFloat(packedVertex.mUV[1U]);
+	}
+
+	void EncodeOctahedral(const DirectX::XMFLOAT3& vector, std::int16_t encodedVector[2U]) noexcept {
+		const float length1{ std::abs(vector.x) + std::abs(vector.y) + std::abs(vector.z) };
+		if (length1 <= 0.0f) {
+			encodedVector[0U] = 0;
+			encodedVector[1U] = 0;
+			return;
+		}
+
+		// Project to the octahedron and then fold the lower hemisphere
+		float x{ vector.x / length1 };
+		float y{ vector.y / length1 };
+		if (vector.z < 0.0f) {
+			const float foldedX{ (1.0f - std::abs(y)) * SignNotZero(x) };
+			const float foldedY{ (1.0f - std::abs(x)) * SignNotZero(y) };
+			x = foldedX;
+			y = foldedY;
+		}
+
+		// Rounding each component to the nearest value is not always the closest
+		// direction, so we keep the best of the 4 surrounding quantized values.
+		const float lengthInverse{ 1.0f / std::sqrt(Dot(vector, vector)) };
+		const DirectX::XMFLOAT3 normalizedVector{ vector.x * lengthInverse, vector.y * lengthInverse, vector.z * lengthInverse };
+		const float floorX{ std::floor(std::min<float>(std::max<float>(x, -1.0f), 1.0f) * sMaxSnorm16) };
+		const float floorY{ std::floor(std::min<float>(std::max<float>(y, -1.0f), 1.0f) * sMaxSnorm16) };
+		float bestDot{ -2.0f };
+		for (std::uint32_t i = 0U; i < 4U; ++i) {
+			const float candidateX{ std::min<float>(floorX + static_cast<float>(i & 1U), sMaxSnorm16) };
+			const float candidateY{ std::min<float>(floorY + static_cast<float>(i >> 1U), sMaxSnorm16) };
+			const std::int16_t candidate[2U]{ static_cast<std::int16_t>(candidateX), static_cast<std::int16_t>(candidateY) };
+			const float dot{ Dot(DecodeOctahedral(candidate), normalizedVector) };
+			if (dot > bestDot) {
+				bestDot = dot;
+				encodedVector[0U] = candidate[0U];
+				encodedVector[1U] = candidate[1U];
+			}
+		}
+	}
+
+	DirectX::XMFLOAT3 DecodeOctahedral(const std::int16_t encodedVector[2U]) noexcept {
+		float x{ DequantizeSnorm16(encodedVector[0U]) };
+		float y{ DequantizeSnorm16(encodedVector[1U]) };
+		const float z{ 1.0f - std::abs(x) - std::abs(y) };
+		if (z < 0.0f) {
+			const float unfoldedX{ (1.0f - std::abs(y)) * SignNotZero(x) };
+			const float unfoldedY{ (1.0f - std::abs(x)) * SignNotZero(y) };
+			x = unfoldedX;
+			y = unfoldedY;
+		}
+
+		const float lengthInverse{ 1.0f / std::sqrt(x * x + y * y + z * z) };
+
+		return DirectX::XMFLOAT3(x * lengthInverse, y * lengthInverse, z * lengthInverse);
+	}
+
+	std::uint16_t FloatToHalf(const float value) noexcept {
+		std::uint32_t bits;
+		std::memcpy(&bits, &value, sizeof(float));
+
+		const std::uint32_t sign{ (bits >> 16U) & 0x8000U };
+		const std::uint32_t exponent{ (bits >> 23U) & 0xFFU };
+		std::uint32_t mantissa{ bits & 0x7FFFFFU };
+
+		// Infinity and NaN
+		if (exponent == 0xFFU) {
+			return static_cast<std::uint16_t>(sign | 0x7C00U | (mantissa != 0U ? 0x200U : 0U));
+		}
+
+		const std::int32_t halfExponent{ static_cast<std::int32_t>(exponent) - 127 + 15 };
+		if (halfExponent >= 31) {
+			return static_cast<std::uint16_t>(sign | 0x7C00U);
+		}
+
+		// Subnormal half floats (or zero)
+		if (halfExponent <= 0) {
+			if (halfExponent < -10) {
+				return static_cast<std::uint16_t>(sign);
+			}
+
+			mantissa |= 0x800000U;
+			const std::uint32_t shift{ static_cast<std::uint32_t>(14 - halfExponent) };
+			std::uint32_t halfMantissa{ mantissa >> shift };
+			const std::uint32_t remainder{ mantissa & ((1U << shift) - 1U) };
+			const std::uint32_t halfway{ 1U << (shift - 1U) };
+			if (remainder > halfway || (remainder == halfway && (halfMantissa & 1U) != 0U)) {
+				++halfMantissa;
+			}
+
+			return static_cast<std::uint16_t>(sign | halfMantissa);
+		}
+
+		// A mantissa carry increments the exponent (up to infinity), as expected
+		std::uint32_t half{ (static_cast<std::uint32_t>(halfExponent) << 10U) | (mantissa >> 13U) };
+		const std::uint32_t remainder{ mantissa & 0x1FFFU };
+		if (remainder > 0x1000U || (remainder == 0x1000U && (half & 1U) != 0U)) {
+			++half;
+		}
+
+		return static_cast<std::uint16_t>(sign | half);
+	}
+
+	float HalfToFloat(const std::uint16_t value) noexcept {
+		const std::uint32_t sign{ (static_cast<std::uint32_t>(value) & 0x8000U) << 16U };
+		const std::uint32_t exponent{ (static_cast<std::uint32_t>(value) >> 10U) & 0x1FU };
+		const std::uint32_t mantissa{ static_cast<std::uint32_t>(value) & 0x3FFU };
+
+		if (exponent == 0U) {
+			const float subnormal{ std::ldexp(static_cast<float>(mantissa), -24) };
+			return sign != 0U ? -subnormal : subnormal;
+		}
+
+		std::uint32_t bits;
+		if (exponent == 0x1FU) {
+			bits = sign | 0x7F800000U | (mantissa << 13U);
+		} else {
+			bits = sign | ((exponent - 15U + 127U) << 23U) | (mantissa << 13U);
+		}
+
+		float result;
+		std::memcpy(&result, &bits, sizeof(float));
+
+		return result;
+	}
+}
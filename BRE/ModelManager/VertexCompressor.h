@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <DirectXMath.h>
+
+#include <GeometryGenerator/GeometryGenerator.h>
+
+// To compress GeometryGenerator::Vertex (44 bytes) to PackedVertex (20 bytes),
+// the vertex format of vertex buffers (see D3DFactory::GetPackedPosNormalTangentTexCoordInputLayout())
+// - Positions are quantized to 16 bits unsigned normalized integers, relative to the mesh bounding box.
+//   The same scale is used in all the axes, so the dequantization (see PositionQuantization) is a
+//   uniform scale and a translation that can be concatenated with the world matrix.
+// - Normals and tangents are octahedral encoded ("A Survey of Efficient Representations for
+//   Independent Unit Vectors", Cigolle et al. 2014) to 2 16 bits signed normalized integers.
+// - UVs are stored as half floats.
+namespace VertexCompressor {
+	struct PackedVertex {
+		// Fourth component is always the maximum value, so it is read as
+		// a point (w = 1.0f) by the input assembler.
+		std::uint16_t mPosition[4U];
+		std::int16_t mNormal[2U];
+		std::int16_t mTangent[2U];
+		std::uint16_t mUV[2U];
+	};
+
+	static_assert(sizeof(PackedVertex) == 20UL, "PackedVertex must not have padding");
+
+	// Object space position = mOffset + quantized position (in [0.0f, 1.0f]) * mScale
+	struct PositionQuantization {
+		DirectX::XMFLOAT3 mOffset{ 0.0f, 0.0f, 0.0f };
+		float mScale{ 1.0f };
+	};
+
+	// Computes the quantization of the bounding box of the vertices, so
+	// the maximum error is (largest bounding box dimension / 65535 / 2)
+	// Preconditions:
+	// - "vertices" must not be nullptr
+	// - "vertexCount" must be greater than zero
+	PositionQuantization ComputePositionQuantization(
+		const GeometryGenerator::Vertex* vertices,
+		const std::size_t vertexCount) noexcept;
+
+	// Preconditions:
+	// - "vertices" must not be nullptr
+	// - "packedVertices" must not be nullptr and it must have room for "vertexCount" vertices
+	void EncodeVertices(
+		const GeometryGenerator::Vertex* vertices,
+		const std::size_t vertexCount,
+		const PositionQuantization& positionQuantization,
+		PackedVertex* packedVertices) noexcept;
+
+	// It is used to validate the encoding. Shaders decode vertices on the GPU.
+	void DecodeVertex(
+		const PackedVertex& packedVertex,
+		const PositionQuantization& positionQuantization,
+		GeometryGenerator::Vertex& vertex) noexcept;
+
+	// "vector" does not need to be normalized. A zero vector is encoded as (0.0f, 0.0f, 1.0f)
+	void EncodeOctahedral(const DirectX::XMFLOAT3& vector, std::int16_t encodedVector[2U]) noexcept;
+
+	// Returns a normalized vector
+	DirectX::XMFLOAT3 DecodeOctahedral(const std::int16_t encodedVector[2U]) noexcept;
+
+	// Rounds to nearest even. Values out of half float range are converted to infinity.
+	std::uint16_t FloatToHalf(const float value) noexcept;
+
+	float HalfToFloat(const std::uint16_t value) noexcept;
+}
@@ -0,0 +1,82 @@
+#include "GraphicsPipelineKey.h"
+
+#include <PSOManager/PipelineKeyBuilder.h>
+#include <Utils/DebugUtils.h>
+
+namespace {
+	void AddShaderBytecode(const D3D12_SHADER_BYTECODE& shaderBytecode, PipelineKeyBuilder& keyBuilder) noexcept {
+		keyBuilder.AddData(shaderBytecode.pShaderBytecode, shaderBytecode.BytecodeLength);
+	}
+
+	void AddDepthStencilOperation(const D3D12_DEPTH_STENCILOP_DESC& operation, PipelineKeyBuilder& keyBuilder) noexcept {
+		keyBuilder.AddValue(operation.StencilFailOp);
+		keyBuilder.AddValue(operation.StencilDepthFailOp);
+		keyBuilder.AddValue(operation.StencilPassOp);
+		keyBuilder.AddValue(operation.StencilFunc);
+	}
+}
+
+std::uint64_t ComputeGraphicsPipelineKey(const GraphicsPipelineKeyData& data) noexcept {
+	ASSERT(data.mInputElements != nullptr || data.mInputElementCount == 0U);
+
+	PipelineKeyBuilder keyBuilder;
+	keyBuilder.AddValue(data.mRootSignatureKey);
+
+	keyBuilder.AddValue(static_cast<std::uint64_t>(data.mInputElementCount));
+	for (std::uint32_t i = 0U; i < data.mInputElementCount; ++i) {
+		const D3D12_INPUT_ELEMENT_DESC& inputElement{ data.mInputElements[i] };
+		keyBuilder.AddString(inputElement.SemanticName);
+		keyBuilder.AddValue(inputElement.SemanticIndex);
+		keyBuilder.AddValue(inputElement.Format);
+		keyBuilder.AddValue(inputElement.InputSlot);
+		keyBuilder.AddValue(inputElement.AlignedByteOffset);
+		keyBuilder.AddValue(inputElement.InputSlotClass);
+		keyBuilder.AddValue(inputElement.InstanceDataStepRate);
+	}
+
+	AddShaderBytecode(data.mVertexShaderBytecode, keyBuilder);
+	AddShaderBytecode(data.mGeometryShaderBytecode, keyBuilder);
+	AddShaderBytecode(data.mDomainShaderBytecode, keyBuilder);
+	AddShaderBytecode(data.mHullShaderBytecode, keyBuilder);
+	AddShaderBytecode(data.mPixelShaderBytecode, keyBuilder);
+
+	// Render target blend descriptors end with a byte, so they have padding
+	keyBuilder.AddValue(data.mBlendDescriptor.AlphaToCoverageEnable);
+	keyBuilder.AddValue(data.mBlendDescriptor.IndependentBlendEnable);
+	for (const D3D12_RENDER_TARGET_BLEND_DESC& renderTargetBlend : data.mBlendDescriptor.RenderTarget) {
+		keyBuilder.AddValue(renderTargetBlend.BlendEnable);
+		keyBuilder.AddValue(renderTargetBlend.LogicOpEnable);
+		keyBuilder.AddValue(renderTargetBlend.SrcBlend);
+		keyBuilder.AddValue(renderTargetBlend.DestBlend);
+		keyBuilder.AddValue(renderTargetBlend.BlendOp);
+		keyBuilder.AddValue(renderTargetBlend.SrcBlendAlpha);
+		keyBuilder.AddValue(renderTargetBlend.DestBlendAlpha);
+		keyBuilder.AddValue(renderTargetBlend.BlendOpAlpha);
+		keyBuilder.AddValue(renderTargetBlend.LogicOp);
+		keyBuilder.AddValue(renderTargetBlend.RenderTargetWriteMask);
+	}
+
+	// Rasterizer descriptor members are 4 bytes, so it does not have padding
+	static_assert(sizeof(D3D12_RASTERIZER_DESC) == 11UL * 4UL, "Rasterizer descriptor must not have padding");
+	keyBuilder.AddValue(data.mRasterizerDescriptor);
+
+	const D3D12_DEPTH_STENCIL_DESC& depthStencil{ data.mDepthStencilDescriptor };
+	keyBuilder.AddValue(depthStencil.DepthEnable);
+	keyBuilder.AddValue(depthStencil.DepthWriteMask);
+	keyBuilder.AddValue(depthStencil.DepthFunc);
+	keyBuilder.AddValue(depthStencil.StencilEnable);
+	keyBuilder.AddValue(depthStencil.StencilReadMask);
+	keyBuilder.AddValue(depthStencil.StencilWriteMask);
+	AddDepthStencilOperation(depthStencil.FrontFace, keyBuilder);
+	AddDepthStencilOperation(depthStencil.BackFace, keyBuilder);
+
+	keyBuilder.AddValue(data.mNumRenderTargets);
+	keyBuilder.AddValue(data.mRenderTargetFormats);
+	keyBuilder.AddValue(data.mDepthStencilFormat);
+	keyBuilder.AddValue(data.mSampleDescriptor.Count);
+	keyBuilder.AddValue(data.mSampleDescriptor.Quality);
+	keyBuilder.AddValue(data.mSampleMask);
+	keyBuilder.AddValue(data.mPrimitiveTopologyType);
+
+	return keyBuilder.GetKey();
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <climits>
+#include <cstdint>
+#include <d3d12.h>
+
+// Content of a graphics pipeline state that identifies it (see ComputeGraphicsPipelineKey()).
+// Shader bytecode, input elements and their semantic names are referenced, not copied.
+struct GraphicsPipelineKeyData {
+	// See RootSignatureManager::GetRootSignatureKey()
+	std::uint64_t mRootSignatureKey{ 0UL };
+
+	const D3D12_INPUT_ELEMENT_DESC* mInputElements{ nullptr };
+	std::uint32_t mInputElementCount{ 0U };
+
+	D3D12_SHADER_BYTECODE mVertexShaderBytecode{ nullptr, 0UL };
+	D3D12_SHADER_BYTECODE mGeometryShaderBytecode{ nullptr, 0UL };
+	D3D12_SHADER_BYTECODE mDomainShaderBytecode{ nullptr, 0UL };
+	D3D12_SHADER_BYTECODE mHullShaderBytecode{ nullptr, 0UL };
+	D3D12_SHADER_BYTECODE mPixelShaderBytecode{ nullptr, 0UL };
+
+	D3D12_BLEND_DESC mBlendDescriptor{};
+	D3D12_RASTERIZER_DESC mRasterizerDescriptor{};
+	D3D12_DEPTH_STENCIL_DESC mDepthStencilDescriptor{};
+	std::uint32_t mNumRenderTargets{ 0U };
+	DXGI_FORMAT mRenderTargetFormats[D3D12_SIMULTANEOUS_RENDER_TARGET_COUNT]{ DXGI_FORMAT_UNKNOWN };
+	DXGI_FORMAT mDepthStencilFormat{ DXGI_FORMAT_UNKNOWN };
+	DXGI_SAMPLE_DESC mSampleDescriptor{ 1U, 0U };
+	std::uint32_t mSampleMask{ UINT_MAX };
+	D3D12_PRIMITIVE_TOPOLOGY_TYPE mPrimitiveTopologyType{ D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE };
+};
+
+// Returns a key that changes with every member of "data" (see PipelineKeyBuilder). Padding
+// bytes are ignored, and shader bytecode is identified by its content, so equal pipeline states
+// have the same key in every execution. It identifies the pipelines of the cache file 
+// (see PipelineCacheFile), so PipelineCacheFile::sFormatVersion must be increased if it changes.
+// It must only use the descriptors of d3d12.h, as it is also built with a stand-in of d3d12.h (see Tests/Include).
+// Preconditions:
+// - "data.mInputElements" must not be nullptr if "data.mInputElementCount" is greater than zero
+std::uint64_t ComputeGraphicsPipelineKey(const GraphicsPipelineKeyData& data) noexcept;
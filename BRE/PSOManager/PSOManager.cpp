@@ -1,17 +1,106 @@
 #include "PSOManager.h"
 
+#include <chrono>
+#include <cwchar>
+
 #include <DirectXManager/DirectXManager.h>
+#include <PSOManager/GraphicsPipelineKey.h>
+#include <PSOManager/PipelineCacheFile.h>
+#include <PSOManager/PipelineKeyBuilder.h>
+#include <RootSignatureManager/RootSignatureManager.h>
 #include <SettingsManager\SettingsManager.h>
 #include <Utils/DebugUtils.h>
 
-PSOManager::PSOs PSOManager::mPSOs;
+std::unordered_map<std::uint64_t, ID3D12PipelineState*> PSOManager::mPSOByKey;
+PSOManager::Statistics PSOManager::mStatistics;
+Microsoft::WRL::ComPtr<ID3D12PipelineLibrary> PSOManager::mPipelineLibrary;
+std::vector<std::uint8_t> PSOManager::mPipelineLibraryData;
+std::uint64_t PSOManager::mDeviceKey{ 0UL };
+bool PSOManager::mIsPipelineLibraryModified{ false };
 std::mutex PSOManager::mMutex;
 
+namespace {
+	// Pipeline libraries can only be loaded by the adapter and the driver version that saved them.
+	// If the user mode driver version cannot be queried, a library saved by another driver version 
+	// is still rejected by CreatePipelineLibrary() (D3D12_ERROR_DRIVER_VERSION_MISMATCH).
+	std::uint64_t ComputeDeviceKey() noexcept {
+		Microsoft::WRL::ComPtr<IDXGIAdapter1> adapter;
+		CHECK_HR(DirectXManager::GetIDXGIFactory().EnumAdapterByLuid(
+			DirectXManager::GetDevice().GetAdapterLuid(),
+			IID_PPV_ARGS(adapter.GetAddressOf())));
+
+		DXGI_ADAPTER_DESC1 adapterDescriptor{};
+		CHECK_HR(adapter->GetDesc1(&adapterDescriptor));
+
+		PipelineKeyBuilder keyBuilder;
+		keyBuilder.AddValue(adapterDescriptor.VendorId);
+		keyBuilder.AddValue(adapterDescriptor.DeviceId);
+		keyBuilder.AddValue(adapterDescriptor.SubSysId);
+		keyBuilder.AddValue(adapterDescriptor.Revision);
+
+		LARGE_INTEGER userModeDriverVersion{};
+		if (SUCCEEDED(adapter->CheckInterfaceSupport(__uuidof(IDXGIDevice), &userModeDriverVersion))) {
+			keyBuilder.AddValue(userModeDriverVersion.QuadPart);
+		}
+
+		return keyBuilder.GetKey();
+	}
+
+	double GetElapsedSeconds(const std::chrono::high_resolution_clock::time_point startTime) noexcept {
+		return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - startTime).count();
+	}
+}
+
+void PSOManager::Init() noexcept {
+	ASSERT(mPipelineLibrary.Get() == nullptr);
+
+	// Pipeline libraries need ID3D12Device1 (Windows 10 Anniversary Update)
+	Microsoft::WRL::ComPtr<ID3D12Device1> device;
+	if (FAILED(DirectXManager::GetDevice().QueryInterface(IID_PPV_ARGS(device.GetAddressOf())))) {
+		return;
+	}
+
+	mDeviceKey = ComputeDeviceKey();
+
+	// The library is not created from the saved data if it was saved by another driver version, or if it is not valid
+	if (PipelineCacheFile::ReadFile(SettingsManager::sPipelineCacheFilePath, mDeviceKey, mPipelineLibraryData)) {
+		if (FAILED(device->CreatePipelineLibrary(
+			mPipelineLibraryData.data(),
+			mPipelineLibraryData.size(),
+			IID_PPV_ARGS(mPipelineLibrary.ReleaseAndGetAddressOf()))))
+		{
+			mPipelineLibrary.Reset();
+			mPipelineLibraryData.clear();
+		}
+	}
+
+	// Some drivers do not support pipeline libraries, so pipeline states are not cached in disk
+	if (mPipelineLibrary.Get() == nullptr) {
+		if (FAILED(device->CreatePipelineLibrary(nullptr, 0UL, IID_PPV_ARGS(mPipelineLibrary.ReleaseAndGetAddressOf())))) {
+			mPipelineLibrary.Reset();
+		}
+	}
+}
+
 void PSOManager::EraseAll() noexcept {
-	for (ID3D12PipelineState* pso : mPSOs) {
-		ASSERT(pso != nullptr);
-		pso->Release();
+	if (mPipelineLibrary.Get() != nullptr && mIsPipelineLibraryModified) {
+		std::vector<std::uint8_t> data(mPipelineLibrary->GetSerializedSize());
+		if (SUCCEEDED(mPipelineLibrary->Serialize(data.data(), data.size()))) {
+			// If it cannot be written, then the next execution compiles the pipeline states again
+			PipelineCacheFile::WriteFile(SettingsManager::sPipelineCacheFilePath, mDeviceKey, data.data(), data.size());
+		}
 	}
+
+	for (const std::pair<const std::uint64_t, ID3D12PipelineState*>& pso : mPSOByKey) {
+		ASSERT(pso.second != nullptr);
+		pso.second->Release();
+	}
+	mPSOByKey.clear();
+
+	mPipelineLibrary.Reset();
+	mPipelineLibraryData.clear();
+	mIsPipelineLibraryModified = false;
+	mStatistics = Statistics();
 }
 
 bool PSOManager::PSOCreationData::IsDataValid() const noexcept {
@@ -56,20 +145,72 @@ ID3D12PipelineState& PSOManager::CreateGraphicsPSO(const PSOManager::PSOCreation
 	psoDescriptor.SampleMask = psoData.mSampleMask;
 	psoDescriptor.VS = psoData.mVertexShaderBytecode;
 
-	return CreateGraphicsPSOByDescriptor(psoDescriptor);
-}
+	const std::uint64_t key{ ComputeGraphicsPSOKey(psoData) };
+
+	std::lock_guard<std::mutex> lock(mMutex);
+	++mStatistics.mRequestCount;
+
+	const std::unordered_map<std::uint64_t, ID3D12PipelineState*>::const_iterator it{ mPSOByKey.find(key) };
+	if (it != mPSOByKey.end()) {
+		++mStatistics.mReusedCount;
+		return *it->second;
+	}
+
+	// Pipeline states are named by their key in the pipeline library
+	wchar_t psoName[32U];
+	std::swprintf(psoName, _countof(psoName), L"PSO_%016llX", static_cast<unsigned long long>(key));
 
-ID3D12PipelineState& PSOManager::CreateGraphicsPSOByDescriptor(
-	const D3D12_GRAPHICS_PIPELINE_STATE_DESC& psoDescriptor) noexcept 
-{
 	ID3D12PipelineState* pso{ nullptr };
+	const std::chrono::high_resolution_clock::time_point startTime{ std::chrono::high_resolution_clock::now() };
+	if (mPipelineLibrary.Get() != nullptr &&
+		SUCCEEDED(mPipelineLibrary->LoadGraphicsPipeline(psoName, &psoDescriptor, IID_PPV_ARGS(&pso))))
+	{
+		++mStatistics.mLoadedCount;
+		mStatistics.mLoadTime += GetElapsedSeconds(startTime);
+	} else {
+		CHECK_HR(DirectXManager::GetDevice().CreateGraphicsPipelineState(&psoDescriptor, IID_PPV_ARGS(&pso)));
+		++mStatistics.mCreatedCount;
+		mStatistics.mCreationTime += GetElapsedSeconds(startTime);
 
-	mMutex.lock();
-	CHECK_HR(DirectXManager::GetDevice().CreateGraphicsPipelineState(&psoDescriptor, IID_PPV_ARGS(&pso)));
-	mMutex.unlock();
+		if (mPipelineLibrary.Get() != nullptr && SUCCEEDED(mPipelineLibrary->StorePipeline(psoName, pso))) {
+			mIsPipelineLibraryModified = true;
+		}
+	}
 
 	ASSERT(pso != nullptr);
-	mPSOs.insert(pso);
+	mPSOByKey.emplace(key, pso);
 
 	return *pso;
+}
+
+PSOManager::Statistics PSOManager::GetStatistics() noexcept {
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mStatistics;
+}
+
+std::uint64_t PSOManager::ComputeGraphicsPSOKey(const PSOManager::PSOCreationData& psoData) noexcept {
+	ASSERT(psoData.mRootSignature != nullptr);
+
+	GraphicsPipelineKeyData keyData;
+	keyData.mRootSignatureKey = RootSignatureManager::GetRootSignatureKey(*psoData.mRootSignature);
+	keyData.mInputElements = psoData.mInputLayoutDescriptors.data();
+	keyData.mInputElementCount = static_cast<std::uint32_t>(psoData.mInputLayoutDescriptors.size());
+	keyData.mVertexShaderBytecode = psoData.mVertexShaderBytecode;
+	keyData.mGeometryShaderBytecode = psoData.mGeometryShaderBytecode;
+	keyData.mDomainShaderBytecode = psoData.mDomainShaderBytecode;
+	keyData.mHullShaderBytecode = psoData.mHullShaderBytecode;
+	keyData.mPixelShaderBytecode = psoData.mPixelShaderBytecode;
+	keyData.mBlendDescriptor = psoData.mBlendDescriptor;
+	keyData.mRasterizerDescriptor = psoData.mRasterizerDescriptor;
+	keyData.mDepthStencilDescriptor = psoData.mDepthStencilDescriptor;
+	keyData.mNumRenderTargets = psoData.mNumRenderTargets;
+	for (std::uint32_t i = 0U; i < D3D12_SIMULTANEOUS_RENDER_TARGET_COUNT; ++i) {
+		keyData.mRenderTargetFormats[i] = psoData.mRenderTargetFormats[i];
+	}
+	keyData.mDepthStencilFormat = SettingsManager::sDepthStencilViewFormat;
+	keyData.mSampleDescriptor = psoData.mSampleDescriptor;
+	keyData.mSampleMask = psoData.mSampleMask;
+	keyData.mPrimitiveTopologyType = psoData.mPrimitiveTopologyType;
+
+	return ComputeGraphicsPipelineKey(keyData);
 }
\ No newline at end of file
@@ -2,11 +2,18 @@
 
 #include <d3d12.h>
 #include <mutex>
-#include <tbb/concurrent_unordered_set.h>
+#include <unordered_map>
+#include <vector>
+#include <wrl.h>
 
 #include <DXUtils/D3DFactory.h>
 
-// To create/get/erase pipeline state objects
+// To create/get/erase pipeline state objects.
+// Pipeline states are identified by a key, the hash of their creation data content (shaders
+// bytecode, root signature blob, input layout and states, see ComputeGraphicsPipelineKey()), so identical
+// pipeline states are created once. Created pipeline states are stored in a pipeline library
+// (see ID3D12PipelineLibrary) that is saved to SettingsManager::sPipelineCacheFilePath by EraseAll(),
+// and loaded by Init(), so the next executions load them instead of compiling them.
 class PSOManager {
 public:
 	PSOManager() = delete;
@@ -16,6 +23,31 @@ public:
 	PSOManager(PSOManager&&) = delete;
 	PSOManager& operator=(PSOManager&&) = delete;
 
+	struct Statistics {
+		std::uint32_t mRequestCount{ 0U };
+
+		// Requests that returned an existing pipeline state
+		std::uint32_t mReusedCount{ 0U };
+
+		// Pipeline states loaded from the pipeline library, and compiled
+		std::uint32_t mLoadedCount{ 0U };
+		std::uint32_t mCreatedCount{ 0U };
+
+		// In seconds
+		double mLoadTime{ 0.0 };
+		double mCreationTime{ 0.0 };
+
+		// Requests that did not compile a pipeline state
+		float GetHitRate() const noexcept {
+			return mRequestCount == 0U ? 0.0f : static_cast<float>(mReusedCount + mLoadedCount) / mRequestCount;
+		}
+	};
+
+	// Loads the pipeline library of the previous execution, if it exists and it was saved by the same
+	// adapter. Pipeline states are not cached in disk if the device does not support pipeline libraries.
+	static void Init() noexcept;
+
+	// Saves the pipeline library if new pipeline states were stored in it
 	static void EraseAll() noexcept;
 
 	struct PSOCreationData {
@@ -49,15 +81,27 @@ public:
 		D3D12_PRIMITIVE_TOPOLOGY_TYPE mPrimitiveTopologyType{ D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE };
 	};
 
+	// If a pipeline state was created with the same creation data content, then it is returned.
+	// Otherwise, it is loaded from the pipeline library, or it is compiled and stored in it.
 	// Preconditions:
 	// - "psoCreationData" must be valid
+	// - Its root signature must be created by RootSignatureManager
 	static ID3D12PipelineState& CreateGraphicsPSO(const PSOManager::PSOCreationData& psoCreationData) noexcept;
 
+	static Statistics GetStatistics() noexcept;
+
 private:
-	static ID3D12PipelineState& CreateGraphicsPSOByDescriptor(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& psoDescriptor) noexcept;
+	static std::uint64_t ComputeGraphicsPSOKey(const PSOManager::PSOCreationData& psoCreationData) noexcept;
+
+	static std::unordered_map<std::uint64_t, ID3D12PipelineState*> mPSOByKey;
+	static Statistics mStatistics;
 
-	using PSOs = tbb::concurrent_unordered_set<ID3D12PipelineState*>;
-	static PSOs mPSOs;
+	// The pipeline library uses the memory of mPipelineLibraryData, so it must live while the library lives.
+	// mDeviceKey identifies the adapter in the cache file (see PipelineCacheFile).
+	static Microsoft::WRL::ComPtr<ID3D12PipelineLibrary> mPipelineLibrary;
+	static std::vector<std::uint8_t> mPipelineLibraryData;
+	static std::uint64_t mDeviceKey;
+	static bool mIsPipelineLibraryModified;
 
 	static std::mutex mMutex;
 };
@@ -0,0 +1,112 @@
+#include "PipelineCacheFile.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include <Utils/DebugUtils.h>
+#include <Utils/HashUtils.h>
+#include <Utils/MemoryMappedFile.h>
+
+namespace {
+	const std::uint32_t sMagic{ 0x50455242U }; // "BREP"
+
+	struct Header {
+		std::uint32_t mMagic{ sMagic };
+		std::uint32_t mFormatVersion{ PipelineCacheFile::sFormatVersion };
+		std::uint64_t mDeviceKey{ 0UL };
+		std::uint64_t mDataSize{ 0UL };
+		std::uint64_t mDataHash{ 0UL };
+	};
+	static_assert(sizeof(Header) == 32UL, "Header must not have padding");
+
+	std::FILE* OpenFileToWrite(const char* filePath) noexcept {
+		std::FILE* file{ nullptr };
+#ifdef _WIN32
+		if (fopen_s(&file, filePath, "wb") != 0) {
+			file = nullptr;
+		}
+#else
+		file = std::fopen(filePath, "wb");
+#endif
+		return file;
+	}
+}
+
+namespace PipelineCacheFile {
+	std::size_t GetHeaderSize() noexcept {
+		return sizeof(Header);
+	}
+
+	bool ReadFile(
+		const char* filePath,
+		const std::uint64_t deviceKey,
+		std::vector<std::uint8_t>& data) noexcept
+	{
+		ASSERT(filePath != nullptr);
+
+		MemoryMappedFile file;
+		if (file.Open(filePath) == false || file.GetSize() < sizeof(Header)) {
+			return false;
+		}
+
+		Header header;
+		std::memcpy(&header, file.GetData(), sizeof(Header));
+		if (header.mMagic != sMagic ||
+			header.mFormatVersion != sFormatVersion ||
+			header.mDeviceKey != deviceKey ||
+			header.mDataSize != file.GetSize() - sizeof(Header))
+		{
+			return false;
+		}
+
+		const std::uint8_t* fileData{ file.GetData() + sizeof(Header) };
+		const std::size_t dataSize{ static_cast<std::size_t>(header.mDataSize) };
+		if (HashUtils::HashData(fileData, dataSize) != header.mDataHash) {
+			return false;
+		}
+
+		data.assign(fileData, fileData + dataSize);
+
+		return true;
+	}
+
+	bool WriteFile(
+		const char* filePath,
+		const std::uint64_t deviceKey,
+		const void* data,
+		const std::size_t dataSize) noexcept
+	{
+		ASSERT(filePath != nullptr);
+		ASSERT(data != nullptr || dataSize == 0UL);
+
+		Header header;
+		header.mDeviceKey = deviceKey;
+		header.mDataSize = dataSize;
+		header.mDataHash = HashUtils::HashData(data, dataSize);
+
+		const std::string temporaryFilePath{ std::string(filePath) + ".tmp" };
+		std::FILE* file{ OpenFileToWrite(temporaryFilePath.c_str()) };
+		if (file == nullptr) {
+			return false;
+		}
+
+		bool result =
+			std::fwrite(&header, sizeof(Header), 1UL, file) == 1UL &&
+			(dataSize == 0UL || std::fwrite(data, 1UL, dataSize, file) == dataSize);
+
+		result = (std::fclose(file) == 0) && result;
+
+		// Windows does not rename a file over an existing one
+		if (result) {
+			std::remove(filePath);
+			result = std::rename(temporaryFilePath.c_str(), filePath) == 0;
+		}
+
+		if (result == false) {
+			std::remove(temporaryFilePath.c_str());
+		}
+
+		return result;
+	}
+}
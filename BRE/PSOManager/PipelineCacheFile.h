@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// To read and write the file where pipeline states are cached between executions.
+// The file has a header and the serialized data of a pipeline library (see ID3D12PipelineLibrary):
+// - Magic number ("BREP") and format version
+// - Device key, that identifies the adapter that created the pipelines. Pipeline libraries
+//   created by other adapters cannot be loaded, so the file is ignored if it does not match.
+// - Data size and data hash (see HashUtils::HashData()), to detect truncated or corrupted files.
+// All the values are little endian.
+namespace PipelineCacheFile {
+	// Increase it if the header or the keys of the pipelines change
+	const std::uint32_t sFormatVersion{ 1U };
+
+	// Size in bytes of the header that precedes the data
+	std::size_t GetHeaderSize() noexcept;
+
+	// Returns false if the file does not exist, or if it is not valid for "deviceKey".
+	// Preconditions:
+	// - "filePath" must not be nullptr
+	bool ReadFile(
+		const char* filePath,
+		const std::uint64_t deviceKey,
+		std::vector<std::uint8_t>& data) noexcept;
+
+	// The file is written to a temporary file that replaces it, so a failed write does not
+	// leave a corrupted file. Returns false if it cannot be written.
+	// Preconditions:
+	// - "filePath" must not be nullptr
+	// - "data" must not be nullptr if "dataSize" is greater than zero
+	bool WriteFile(
+		const char* filePath,
+		const std::uint64_t deviceKey,
+		const void* data,
+		const std::size_t dataSize) noexcept;
+}
@@ -0,0 +1,35 @@
+#include "PipelineKeyBuilder.h"
+
+#include <cstring>
+
+#include <Utils/DebugUtils.h>
+#include <Utils/HashUtils.h>
+
+void PipelineKeyBuilder::AddData(const void* data, const std::size_t dataSize) noexcept {
+	ASSERT(data != nullptr || dataSize == 0UL);
+
+	const std::uint64_t size{ dataSize };
+	const std::uint64_t hash{ HashUtils::HashData(data, dataSize) };
+	AddBytes(&size, sizeof(std::uint64_t));
+	AddBytes(&hash, sizeof(std::uint64_t));
+}
+
+void PipelineKeyBuilder::AddString(const char* str) noexcept {
+	// The length of a nullptr string is the maximum value
+	const std::uint64_t length{ str == nullptr ? UINT64_MAX : static_cast<std::uint64_t>(std::strlen(str)) };
+	AddBytes(&length, sizeof(std::uint64_t));
+	if (str != nullptr) {
+		AddBytes(str, static_cast<std::size_t>(length));
+	}
+}
+
+std::uint64_t PipelineKeyBuilder::GetKey() const noexcept {
+	return HashUtils::HashData(mBuffer.data(), mBuffer.size());
+}
+
+void PipelineKeyBuilder::AddBytes(const void* bytes, const std::size_t byteCount) noexcept {
+	ASSERT(bytes != nullptr || byteCount == 0UL);
+
+	const std::uint8_t* firstByte{ static_cast<const std::uint8_t*>(bytes) };
+	mBuffer.insert(mBuffer.end(), firstByte, firstByte + byteCount);
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+// To build a key that identifies a pipeline state (or any other object) by its content.
+// Values are appended to a buffer, and data that can be large (for example, shader bytecode)
+// is appended as its size and its hash (see HashUtils::HashData()). Keys do not depend on
+// addresses, so they are the same in every execution and they can identify cached pipelines.
+// Values must not have padding bytes (their content is undefined), so structures with
+// padding must be added member by member.
+class PipelineKeyBuilder {
+public:
+	PipelineKeyBuilder() = default;
+	~PipelineKeyBuilder() = default;
+	PipelineKeyBuilder(const PipelineKeyBuilder&) = delete;
+	const PipelineKeyBuilder& operator=(const PipelineKeyBuilder&) = delete;
+	PipelineKeyBuilder(PipelineKeyBuilder&&) = delete;
+	PipelineKeyBuilder& operator=(PipelineKeyBuilder&&) = delete;
+
+	template<typename T>
+	void AddValue(const T& value) noexcept {
+		static_assert(std::is_trivially_copyable<T>::value, "Values must be trivially copyable");
+		AddBytes(&value, sizeof(T));
+	}
+
+	// Preconditions:
+	// - "data" must not be nullptr if "dataSize" is greater than zero
+	void AddData(const void* data, const std::size_t dataSize) noexcept;
+
+	// A nullptr string is different from an empty string
+	void AddString(const char* str) noexcept;
+
+	std::uint64_t GetKey() const noexcept;
+
+	void Clear() noexcept { mBuffer.clear(); }
+
+private:
+	void AddBytes(const void* bytes, const std::size_t byteCount) noexcept;
+
+	std::vector<std::uint8_t> mBuffer;
+};
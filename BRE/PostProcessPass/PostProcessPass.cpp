@@ -23,7 +23,7 @@ void PostProcessPass::Init(ID3D12Resource& inputColorBuffer) noexcept {
 	ASSERT(IsDataValid());
 }
 
-void PostProcessPass::Execute(
+std::uint32_t PostProcessPass::Execute(
 	ID3D12Resource& renderTargetBuffer,
 	const D3D12_CPU_DESCRIPTOR_HANDLE& renderTargetView) noexcept 
 {
@@ -32,13 +32,10 @@ void PostProcessPass::Execute(
 
 	ExecuteBeginTask(renderTargetBuffer, renderTargetView);
 		
-	CommandListExecutor::Get().ResetExecutedCommandListCount();
 	mCommandListRecorder->RecordAndPushCommandLists(renderTargetView);
 
-	// Wait until all previous tasks command lists are executed
-	while (CommandListExecutor::Get().GetExecutedCommandListCount() < 1) {
-		Sleep(0U);
-	}
+	// Begin task command list + recorder command list
+	return 2U;
 }
 
 bool PostProcessPass::IsDataValid() const noexcept {
@@ -57,22 +54,16 @@ void PostProcessPass::ExecuteBeginTask(
 	ASSERT(renderTargetView.ptr != 0UL);
 
 	// Check resource states:
-	// - Input color buffer was used as render target in previous pass
-	// - Output color buffer is the frame buffer, so it was used to present before.
-	ASSERT(ResourceStateManager::GetResourceState(*mInputColorBuffer) == D3D12_RESOURCE_STATE_RENDER_TARGET);
-	ASSERT(ResourceStateManager::GetResourceState(renderTargetBuffer) == D3D12_RESOURCE_STATE_PRESENT);
+	// - Input color buffer must be in pixel shader resource state
+	// - Output color buffer is the frame buffer, and it must be in render target state
+	// RenderManager frame graph transitioned them before this pass.
+	ASSERT(ResourceStateManager::GetResourceState(*mInputColorBuffer) == D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+	ASSERT(ResourceStateManager::GetResourceState(renderTargetBuffer) == D3D12_RESOURCE_STATE_RENDER_TARGET);
 
 	ID3D12GraphicsCommandList& commandList = mCommandListPerFrame.ResetWithNextCommandAllocator(nullptr);
 
-	CD3DX12_RESOURCE_BARRIER barriers[]
-	{
-		ResourceStateManager::ChangeResourceStateAndGetBarrier(*mInputColorBuffer, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE),
-		ResourceStateManager::ChangeResourceStateAndGetBarrier(renderTargetBuffer, D3D12_RESOURCE_STATE_RENDER_TARGET),		
-	};
-	commandList.ResourceBarrier(_countof(barriers), barriers);
-
 	commandList.ClearRenderTargetView(renderTargetView, DirectX::Colors::Black, 0U, nullptr);
 
 	CHECK_HR(commandList.Close());
-	CommandListExecutor::Get().ExecuteCommandListAndWaitForCompletion(commandList);
+	CommandListExecutor::Get().AddCommandList(commandList);
 }
\ No newline at end of file
@@ -20,9 +20,11 @@ public:
 
 	void Init(ID3D12Resource& inputColorBuffer) noexcept;
 
+	// Returns the number of command lists pushed to CommandListExecutor.
+	// It does not wait for them to be executed.
 	// Preconditions:
 	// - Init() must be called first
-	void Execute(
+	std::uint32_t Execute(
 		ID3D12Resource& renderTargetBuffer,
 		const D3D12_CPU_DESCRIPTOR_HANDLE& renderTargetView) noexcept;
 
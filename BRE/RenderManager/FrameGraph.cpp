@@ -0,0 +1,302 @@
+#include "FrameGraph.h"
+
+#include <functional>
+#include <queue>
+
+#include <Utils/DebugUtils.h>
+
+const std::uint32_t FrameGraph::sInvalidIndex;
+
+void FrameGraph::Clear() noexcept {
+	mPasses.clear();
+	mResources.clear();
+	mExecutionOrder.clear();
+	mFinalTransitions.clear();
+	mIsCompiled = false;
+}
+
+std::uint32_t FrameGraph::AddResource(const std::uint32_t initialState, const bool isOutput) noexcept {
+	ASSERT(mIsCompiled == false);
+
+	Resource resource;
+	resource.mInitialState = initialState;
+	resource.mIsOutput = isOutput;
+	mResources.push_back(resource);
+
+	return static_cast<std::uint32_t>(mResources.size() - 1UL);
+}
+
+std::uint32_t FrameGraph::AddPass(const bool hasSideEffects) noexcept {
+	ASSERT(mIsCompiled == false);
+
+	mPasses.emplace_back();
+	mPasses.back().mHasSideEffects = hasSideEffects;
+
+	return static_cast<std::uint32_t>(mPasses.size() - 1UL);
+}
+
+void FrameGraph::ReadResource(
+	const std::uint32_t passIndex,
+	const std::uint32_t resourceIndex,
+	const std::uint32_t state) noexcept
+{
+	AddResourceAccess(passIndex, resourceIndex, state, false);
+}
+
+void FrameGraph::WriteResource(
+	const std::uint32_t passIndex,
+	const std::uint32_t resourceIndex,
+	const std::uint32_t state) noexcept
+{
+	AddResourceAccess(passIndex, resourceIndex, state, true);
+}
+
+void FrameGraph::Compile() noexcept {
+	ASSERT(mIsCompiled == false);
+
+	BuildDependencies();
+	CullPasses();
+	SortPasses();
+	ComputeTransitionsAndLifetimes();
+
+	mIsCompiled = true;
+}
+
+const std::vector<std::uint32_t>& FrameGraph::GetExecutionOrder() const noexcept {
+	ASSERT(mIsCompiled);
+	return mExecutionOrder;
+}
+
+bool FrameGraph::IsPassCulled(const std::uint32_t passIndex) const noexcept {
+	ASSERT(mIsCompiled);
+	ASSERT(passIndex < GetPassCount());
+	return mPasses[passIndex].mIsCulled;
+}
+
+const std::vector<FrameGraph::Transition>& FrameGraph::GetTransitionsBeforePass(const std::uint32_t passIndex) const noexcept {
+	ASSERT(mIsCompiled);
+	ASSERT(passIndex < GetPassCount());
+	return mPasses[passIndex].mTransitionsBeforePass;
+}
+
+const std::vector<FrameGraph::Transition>& FrameGraph::GetFinalTransitions() const noexcept {
+	ASSERT(mIsCompiled);
+	return mFinalTransitions;
+}
+
+const FrameGraph::ResourceLifetime& FrameGraph::GetResourceLifetime(const std::uint32_t resourceIndex) const noexcept {
+	ASSERT(mIsCompiled);
+	ASSERT(resourceIndex < GetResourceCount());
+	return mResources[resourceIndex].mLifetime;
+}
+
+void FrameGraph::AddResourceAccess(
+	const std::uint32_t passIndex,
+	const std::uint32_t resourceIndex,
+	const std::uint32_t state,
+	const bool isWrite) noexcept
+{
+	ASSERT(mIsCompiled == false);
+	ASSERT(passIndex < GetPassCount());
+	ASSERT(resourceIndex < GetResourceCount());
+
+	std::vector<ResourceAccess>& accesses = mPasses[passIndex].mAccesses;
+#ifdef _DEBUG
+	for (const ResourceAccess& access : accesses) {
+		ASSERT(access.mResourceIndex != resourceIndex);
+	}
+#endif
+
+	ResourceAccess access;
+	access.mResourceIndex = resourceIndex;
+	access.mState = state;
+	access.mIsWrite = isWrite;
+	accesses.push_back(access);
+}
+
+void FrameGraph::BuildDependencies() noexcept {
+	// Writer passes of each resource, in declaration order
+	std::vector<std::vector<std::uint32_t>> writerPasses(mResources.size());
+	const std::uint32_t passCount{ GetPassCount() };
+	for (std::uint32_t i = 0U; i < passCount; ++i) {
+		Pass& pass = mPasses[i];
+		pass.mProducerPasses.clear();
+		pass.mReaderPasses.clear();
+
+		for (const ResourceAccess& access : pass.mAccesses) {
+			if (access.mIsWrite) {
+				writerPasses[access.mResourceIndex].push_back(i);
+			}
+		}
+	}
+
+	// Number of writer passes of each resource declared before the current pass
+	std::vector<std::uint32_t> previousWriterCounts(mResources.size(), 0U);
+	for (std::uint32_t i = 0U; i < passCount; ++i) {
+		Pass& pass = mPasses[i];
+		for (const ResourceAccess& access : pass.mAccesses) {
+			const std::vector<std::uint32_t>& resourceWriterPasses = writerPasses[access.mResourceIndex];
+			std::uint32_t& previousWriterCount = previousWriterCounts[access.mResourceIndex];
+
+			if (access.mIsWrite) {
+				// Writes (render targets are not always fully overwritten) consume the output of the previous writer
+				if (previousWriterCount > 0U) {
+					pass.mProducerPasses.push_back(resourceWriterPasses[previousWriterCount - 1U]);
+				}
+				++previousWriterCount;
+				continue;
+			}
+
+			if (resourceWriterPasses.empty()) {
+				continue;
+			}
+
+			// The reader consumes the output of the last writer declared before it (or of the first writer),
+			// and it must be executed before the next writer overwrites it.
+			const std::uint32_t producerIndex{ previousWriterCount > 0U ? previousWriterCount - 1U : 0U };
+			pass.mProducerPasses.push_back(resourceWriterPasses[producerIndex]);
+			if (producerIndex + 1U < resourceWriterPasses.size()) {
+				mPasses[resourceWriterPasses[producerIndex + 1U]].mReaderPasses.push_back(i);
+			}
+		}
+	}
+}
+
+void FrameGraph::CullPasses() noexcept {
+	// Passes with side effects or that write output resources are the roots.
+	std::vector<std::uint32_t> passesToVisit;
+	const std::uint32_t passCount{ GetPassCount() };
+	for (std::uint32_t i = 0U; i < passCount; ++i) {
+		Pass& pass = mPasses[i];
+		pass.mIsCulled = true;
+
+		bool isRoot{ pass.mHasSideEffects };
+		for (const ResourceAccess& access : pass.mAccesses) {
+			if (access.mIsWrite && mResources[access.mResourceIndex].mIsOutput) {
+				isRoot = true;
+			}
+		}
+
+		if (isRoot) {
+			pass.mIsCulled = false;
+			passesToVisit.push_back(i);
+		}
+	}
+
+	// Every pass that produces something consumed by a pass that is not culled, is not culled.
+	while (passesToVisit.empty() == false) {
+		const std::uint32_t passIndex{ passesToVisit.back() };
+		passesToVisit.pop_back();
+
+		for (const std::uint32_t producerPassIndex : mPasses[passIndex].mProducerPasses) {
+			Pass& producerPass = mPasses[producerPassIndex];
+			if (producerPass.mIsCulled) {
+				producerPass.mIsCulled = false;
+				passesToVisit.push_back(producerPassIndex);
+			}
+		}
+	}
+}
+
+void FrameGraph::SortPasses() noexcept {
+	// Kahn's algorithm over the passes that were not culled. Producer passes of a pass that is not culled
+	// are not culled either, but reader passes (write after read) can be culled, so they are ignored.
+	// The pass with the lowest index is taken from the passes that are ready, so independent
+	// passes keep their declaration order.
+	const std::uint32_t passCount{ GetPassCount() };
+	std::vector<std::uint32_t> pendingDependencyCounts(passCount, 0U);
+	std::vector<std::vector<std::uint32_t>> dependentPasses(passCount);
+	std::uint32_t activePassCount{ 0U };
+	for (std::uint32_t i = 0U; i < passCount; ++i) {
+		const Pass& pass = mPasses[i];
+		if (pass.mIsCulled) {
+			continue;
+		}
+
+		++activePassCount;
+		for (const std::uint32_t producerPassIndex : pass.mProducerPasses) {
+			ASSERT(mPasses[producerPassIndex].mIsCulled == false);
+			dependentPasses[producerPassIndex].push_back(i);
+			++pendingDependencyCounts[i];
+		}
+
+		for (const std::uint32_t readerPassIndex : pass.mReaderPasses) {
+			if (mPasses[readerPassIndex].mIsCulled == false) {
+				dependentPasses[readerPassIndex].push_back(i);
+				++pendingDependencyCounts[i];
+			}
+		}
+	}
+
+	std::priority_queue<std::uint32_t, std::vector<std::uint32_t>, std::greater<std::uint32_t>> readyPasses;
+	for (std::uint32_t i = 0U; i < passCount; ++i) {
+		if (mPasses[i].mIsCulled == false && pendingDependencyCounts[i] == 0U) {
+			readyPasses.push(i);
+		}
+	}
+
+	mExecutionOrder.clear();
+	while (readyPasses.empty() == false) {
+		const std::uint32_t passIndex{ readyPasses.top() };
+		readyPasses.pop();
+		mExecutionOrder.push_back(passIndex);
+
+		for (const std::uint32_t dependentPassIndex : dependentPasses[passIndex]) {
+			ASSERT(pendingDependencyCounts[dependentPassIndex] > 0U);
+			if (--pendingDependencyCounts[dependentPassIndex] == 0U) {
+				readyPasses.push(dependentPassIndex);
+			}
+		}
+	}
+
+	// Otherwise, there is a dependency cycle
+	ASSERT(mExecutionOrder.size() == activePassCount);
+}
+
+void FrameGraph::ComputeTransitionsAndLifetimes() noexcept {
+	std::vector<std::uint32_t> currentStates(mResources.size());
+	for (std::size_t i = 0UL; i < mResources.size(); ++i) {
+		currentStates[i] = mResources[i].mInitialState;
+		mResources[i].mLifetime = ResourceLifetime();
+	}
+
+	for (Pass& pass : mPasses) {
+		pass.mTransitionsBeforePass.clear();
+	}
+
+	const std::uint32_t executionOrderCount{ static_cast<std::uint32_t>(mExecutionOrder.size()) };
+	for (std::uint32_t position = 0U; position < executionOrderCount; ++position) {
+		Pass& pass = mPasses[mExecutionOrder[position]];
+
+		for (const ResourceAccess& access : pass.mAccesses) {
+			const std::uint32_t resourceIndex{ access.mResourceIndex };
+			std::uint32_t& currentState = currentStates[resourceIndex];
+			if (currentState != access.mState) {
+				Transition transition;
+				transition.mResourceIndex = resourceIndex;
+				transition.mStateBefore = currentState;
+				transition.mStateAfter = access.mState;
+				pass.mTransitionsBeforePass.push_back(transition);
+
+				currentState = access.mState;
+			}
+
+			ResourceLifetime& lifetime = mResources[resourceIndex].mLifetime;
+			if (lifetime.mFirstPosition == sInvalidIndex) {
+				lifetime.mFirstPosition = position;
+			}
+			lifetime.mLastPosition = position;
+		}
+	}
+
+	mFinalTransitions.clear();
+	for (std::uint32_t i = 0U; i < GetResourceCount(); ++i) {
+		if (currentStates[i] != mResources[i].mInitialState) {
+			Transition transition;
+			transition.mResourceIndex = i;
+			transition.mStateBefore = currentStates[i];
+			transition.mStateAfter = mResources[i].mInitialState;
+			mFinalTransitions.push_back(transition);
+		}
+	}
+}
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Frame graph (render graph) compiler.
+// Passes declare the resources they read and write, and the state each resource
+// must be in while the pass is executed. Then Compile():
+// - Builds dependencies between passes (read after write, write after write and write after read)
+// - Culls passes that do not contribute to an output resource or have side effects
+// - Sorts the remaining passes topologically to get their execution order
+// - Places the state transitions needed before each pass and at the end of the frame
+// - Computes the lifetime of each resource (first and last pass in execution order that uses it)
+// Resource states are opaque bit masks (D3D12_RESOURCE_STATES in our case).
+// Steps:
+// - Add resources with AddResource() and passes with AddPass()
+// - Declare pass accesses with ReadResource() and WriteResource()
+// - Call Compile() once and use the compiled data every frame
+class FrameGraph {
+public:
+	static const std::uint32_t sInvalidIndex{ 0xFFFFFFFFU };
+
+	struct Transition {
+		std::uint32_t mResourceIndex{ sInvalidIndex };
+		std::uint32_t mStateBefore{ 0U };
+		std::uint32_t mStateAfter{ 0U };
+	};
+
+	// Positions in the execution order of the first and last
+	// pass that use the resource. They are sInvalidIndex if no pass uses it.
+	struct ResourceLifetime {
+		std::uint32_t mFirstPosition{ sInvalidIndex };
+		std::uint32_t mLastPosition{ sInvalidIndex };
+	};
+
+	FrameGraph() = default;
+	~FrameGraph() = default;
+	FrameGraph(const FrameGraph&) = delete;
+	const FrameGraph& operator=(const FrameGraph&) = delete;
+	FrameGraph(FrameGraph&&) = delete;
+	FrameGraph& operator=(FrameGraph&&) = delete;
+
+	// Removes all the resources and passes
+	void Clear() noexcept;
+
+	// "initialState" is the state of the resource when the frame begins.
+	// At the end of the frame, the resource is transitioned back to it, so the
+	// compiled graph can be executed frame after frame.
+	// Passes that write output resources (for example, the frame buffer) are never culled.
+	// Returns the resource index.
+	// Preconditions:
+	// - Compile() must not have been called
+	std::uint32_t AddResource(const std::uint32_t initialState, const bool isOutput) noexcept;
+
+	// Passes with side effects are never culled.
+	// Passes can be declared in any order. The writes of a resource happen in declaration order,
+	// and a pass that reads the resource reads what the last writer declared before it wrote
+	// (or what the first writer wrote, if it is declared before all of them).
+	// Passes without dependencies between them are executed in declaration order.
+	// Returns the pass index.
+	// Preconditions:
+	// - Compile() must not have been called
+	std::uint32_t AddPass(const bool hasSideEffects) noexcept;
+
+	// Preconditions:
+	// - Compile() must not have been called
+	// - "passIndex" and "resourceIndex" must be valid
+	// - A pass must access a resource once
+	void ReadResource(
+		const std::uint32_t passIndex,
+		const std::uint32_t resourceIndex,
+		const std::uint32_t state) noexcept;
+
+	// Preconditions:
+	// - Compile() must not have been called
+	// - "passIndex" and "resourceIndex" must be valid
+	// - A pass must access a resource once
+	void WriteResource(
+		const std::uint32_t passIndex,
+		const std::uint32_t resourceIndex,
+		const std::uint32_t state) noexcept;
+
+	// Preconditions:
+	// - Compile() must not have been called
+	// - Dependencies between passes must not have cycles
+	void Compile() noexcept;
+
+	__forceinline bool IsCompiled() const noexcept { return mIsCompiled; }
+
+	__forceinline std::uint32_t GetPassCount() const noexcept { return static_cast<std::uint32_t>(mPasses.size()); }
+	__forceinline std::uint32_t GetResourceCount() const noexcept { return static_cast<std::uint32_t>(mResources.size()); }
+
+	// Indices of the passes that were not culled, in execution order.
+	// Preconditions:
+	// - Compile() must be called first
+	const std::vector<std::uint32_t>& GetExecutionOrder() const noexcept;
+
+	// Preconditions:
+	// - Compile() must be called first
+	// - "passIndex" must be valid
+	bool IsPassCulled(const std::uint32_t passIndex) const noexcept;
+
+	// Transitions to execute before the pass. It is empty for culled passes.
+	// Preconditions:
+	// - Compile() must be called first
+	// - "passIndex" must be valid
+	const std::vector<Transition>& GetTransitionsBeforePass(const std::uint32_t passIndex) const noexcept;
+
+	// Transitions to execute after the last pass, to restore the initial state of the resources.
+	// Preconditions:
+	// - Compile() must be called first
+	const std::vector<Transition>& GetFinalTransitions() const noexcept;
+
+	// Preconditions:
+	// - Compile() must be called first
+	// - "resourceIndex" must be valid
+	const ResourceLifetime& GetResourceLifetime(const std::uint32_t resourceIndex) const noexcept;
+
+private:
+	struct ResourceAccess {
+		std::uint32_t mResourceIndex{ sInvalidIndex };
+		std::uint32_t mState{ 0U };
+		bool mIsWrite{ false };
+	};
+
+	struct Pass {
+		std::vector<ResourceAccess> mAccesses;
+
+		// Passes whose output is consumed by this pass (read after write and write after write)
+		std::vector<std::uint32_t> mProducerPasses;
+
+		// Passes that read a resource before this pass overwrites it (write after read)
+		std::vector<std::uint32_t> mReaderPasses;
+
+		std::vector<Transition> mTransitionsBeforePass;
+		bool mHasSideEffects{ false };
+		bool mIsCulled{ true };
+	};
+
+	struct Resource {
+		ResourceLifetime mLifetime;
+		std::uint32_t mInitialState{ 0U };
+		bool mIsOutput{ false };
+	};
+
+	void AddResourceAccess(
+		const std::uint32_t passIndex,
+		const std::uint32_t resourceIndex,
+		const std::uint32_t state,
+		const bool isWrite) noexcept;
+
+	void BuildDependencies() noexcept;
+	void CullPasses() noexcept;
+	void SortPasses() noexcept;
+	void ComputeTransitionsAndLifetimes() noexcept;
+
+	std::vector<Pass> mPasses;
+	std::vector<Resource> mResources;
+	std::vector<std::uint32_t> mExecutionOrder;
+	std::vector<Transition> mFinalTransitions;
+	bool mIsCompiled{ false };
+};
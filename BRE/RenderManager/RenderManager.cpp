@@ -1,10 +1,12 @@
 #include "RenderManager.h"
 
+#include <algorithm>
 #include <tbb/parallel_for.h>
 
 #include <CommandListExecutor/CommandListExecutor.h>
 #include <CommandManager/CommandQueueManager.h>
 #include <CommandManager/FenceManager.h>
+#include <DescriptorManager\CbvSrvUavDescriptorManager.h>
 #include <DescriptorManager\DepthStencilDescriptorManager.h>
 #include <DescriptorManager\RenderTargetDescriptorManager.h>
 #include <DirectXManager\DirectXManager.h>
@@ -12,6 +14,8 @@
 #include <Input/Keyboard.h>
 #include <Input/Mouse.h>
 #include <ResourceManager\ResourceManager.h>
+#include <ResourceManager/TextureStreamer.h>
+#include <ResourceManager\UploadBufferManager.h>
 #include <ResourceStateManager\ResourceStateManager.h>
 #include <Scene/Scene.h>
 #include <SettingsManager\SettingsManager.h>
@@ -20,6 +24,11 @@ using namespace DirectX;
 
 namespace {
 	const std::uint32_t MAX_NUM_CMD_LISTS{ 3U };	
+
+	// Frame graph resource states are D3D12_RESOURCE_STATES
+	std::uint32_t GetFrameGraphState(const D3D12_RESOURCE_STATES state) noexcept {
+		return static_cast<std::uint32_t>(state);
+	}
 	
 	void UpdateCameraAndFrameCBuffer(
 		const float elapsedFrameTime,
@@ -156,18 +165,18 @@ RenderManager::RenderManager(Scene& scene) {
 
 	CreateFrameBuffersAndRenderTargetViews();
 
-	CreateDepthStencilBufferAndView();
+	BuildFrameGraph();
 
-	CreateIntermediateColorBufferAndRenderTargetView(
-		D3D12_RESOURCE_STATE_RENDER_TARGET,
-		L"Intermediate Color Buffer 1",
-		mIntermediateColorBuffer1,
+	CreateTransientResources();
+
+	CreateDepthStencilView();
+
+	CreateIntermediateColorBufferRenderTargetView(
+		GetFrameGraphResource(INTERMEDIATE_COLOR_BUFFER_1),
 		mIntermediateColorBuffer1RenderTargetView);
 
-	CreateIntermediateColorBufferAndRenderTargetView(
-		D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE,
-		L"Intermediate Color Buffer 2",
-		mIntermediateColorBuffer2,\
+	CreateIntermediateColorBufferRenderTargetView(
+		GetFrameGraphResource(INTERMEDIATE_COLOR_BUFFER_2),
 		mIntermediateColorBuffer2RenderTargetView);
 
 	mCamera.SetFrustum(
@@ -183,11 +192,32 @@ RenderManager::RenderManager(Scene& scene) {
 }
 
 void RenderManager::InitPasses(Scene& scene) noexcept {
+	// Scene loads its resources asynchronously, so we initialize passes 
+	// that do not need them first (pipeline state objects creation overlaps loading).
 	scene.Init();
+
+	mToneMappingPass.Init(
+		GetFrameGraphResource(INTERMEDIATE_COLOR_BUFFER_1), 
+		GetFrameGraphResource(INTERMEDIATE_COLOR_BUFFER_2),
+		mIntermediateColorBuffer2RenderTargetView);
+
+	mPostProcessPass.Init(GetFrameGraphResource(INTERMEDIATE_COLOR_BUFFER_2));
 	
 	// Generate recorders for all the passes
 	scene.CreateGeometryPassRecorders(mGeometryPass.GetCommandListRecorders());
-	mGeometryPass.Init(DepthStencilCpuDesc());
+
+	// We can record a frame while the GPU executes sQueuedFrameCount frames, and we add
+	// a frame more for the memory that is wasted when allocations wrap around the ring.
+	const std::size_t uploadSizePerFrame{ 
+		RingBufferAllocator::GetAlignedSize(sizeof(FrameCBuffer)) + mGeometryPass.GetMaxUploadSizePerFrame() };
+	mFrameUploadRingBuffer = &UploadBufferManager::CreateUploadRingBuffer(
+		uploadSizePerFrame * (SettingsManager::sQueuedFrameCount + 2U));
+
+	ID3D12Resource* geometryBuffers[GeometryPass::BUFFERS_COUNT];
+	for (std::uint32_t i = 0U; i < GeometryPass::BUFFERS_COUNT; ++i) {
+		geometryBuffers[i] = &GetFrameGraphResource(i);
+	}
+	mGeometryPass.Init(geometryBuffers, DepthStencilCpuDesc(), *mFrameUploadRingBuffer);
 
 	ID3D12Resource* skyBoxCubeMap;
 	ID3D12Resource* diffuseIrradianceCubeMap;
@@ -197,16 +227,19 @@ void RenderManager::InitPasses(Scene& scene) noexcept {
 	ASSERT(diffuseIrradianceCubeMap != nullptr);
 	ASSERT(specularPreConvolvedCubeMap != nullptr);
 
+	ID3D12Resource& depthBuffer = GetFrameGraphResource(DEPTH_BUFFER);
 	scene.CreateLightingPassRecorders(
 		mGeometryPass.GetGeometryBuffers(), 
 		GeometryPass::BUFFERS_COUNT, 
-		*mDepthBuffer, 
+		depthBuffer, 
 		mLightingPass.GetCommandListRecorders());
 
 	mLightingPass.Init(
 		mGeometryPass.GetGeometryBuffers(),
 		GeometryPass::BUFFERS_COUNT,
-		*mDepthBuffer,		
+		depthBuffer,
+		GetFrameGraphResource(AMBIENT_ACCESSIBILITY_BUFFER),
+		GetFrameGraphResource(BLUR_BUFFER),
 		*diffuseIrradianceCubeMap,
 		*specularPreConvolvedCubeMap,
 		mIntermediateColorBuffer1RenderTargetView);
@@ -215,19 +248,17 @@ void RenderManager::InitPasses(Scene& scene) noexcept {
 		*skyBoxCubeMap, 
 		mIntermediateColorBuffer1RenderTargetView,
 		DepthStencilCpuDesc());
-
-	mToneMappingPass.Init(
-		*mIntermediateColorBuffer1.Get(), 
-		*mIntermediateColorBuffer2.Get(),
-		mIntermediateColorBuffer2RenderTargetView);
-
-	mPostProcessPass.Init(*mIntermediateColorBuffer2.Get());
 		
 	// Initialize fence values for all frames to the same number.
 	const std::uint64_t count{ _countof(mFenceValueByQueuedFrameIndex) };
 	for (std::uint64_t i = 0UL; i < count; ++i) {
 		mFenceValueByQueuedFrameIndex[i] = mCurrentFenceValue;
 	}
+
+	// Resources used by the first frame are marked with its fence value, and views destroyed while
+	// it is recorded are reused after it completes
+	ResourceManager::UpdateResidency(mCurrentFenceValue + 1UL, mFence->GetCompletedValue());
+	CbvSrvUavDescriptorManager::SetFrameFenceValue(mCurrentFenceValue + 1UL);
 }
 
 void RenderManager::Terminate() noexcept {
@@ -239,17 +270,34 @@ tbb::task* RenderManager::execute() {
 	while (!mTerminate) {
 		mTimer.Tick();
 		UpdateCameraAndFrameCBuffer(mTimer.DeltaTimeInSeconds(), mCamera, mFrameCBuffer);
+		mFrameCBufferGpuAddress = mFrameUploadRingBuffer->CopyData(&mFrameCBuffer, sizeof(mFrameCBuffer));
 
 		ASSERT(CommandListExecutor::Get().AreTherePendingCommandListsToExecute());
 
-		mGeometryPass.Execute(mFrameCBuffer);
-		mLightingPass.Execute(mFrameCBuffer);
-		mSkyBoxPass.Execute(mFrameCBuffer);
-		mToneMappingPass.Execute();
-		mPostProcessPass.Execute(*CurrentFrameBuffer(), CurrentFrameBufferCpuDesc());
-		ExecuteFinalPass();
+		// CommandListExecutor executes command lists in the same order they were pushed,
+		// so passes do not need to wait for previous passes. We only wait once, before presenting.
+		CommandListExecutor::Get().ResetExecutedCommandListCount();
+		std::uint32_t commandListCount{ 0U };
+		for (const std::uint32_t passIndex : mFrameGraph.GetExecutionOrder()) {
+			commandListCount += RecordAndPushTransitions(
+				mResourcesToActivateByPass[passIndex],
+				mFrameGraph.GetTransitionsBeforePass(passIndex), 
+				mTransitionCommandListsPerFrame[passIndex]);
+			commandListCount += ExecuteFrameGraphPass(passIndex);
+		}
+		commandListCount += RecordAndPushTransitions(
+			std::vector<std::uint32_t>(), 
+			mFrameGraph.GetFinalTransitions(), 
+			mFinalCommandListPerFrame);
+
+		CommandListExecutor::Get().WaitForExecutedCommandLists(commandListCount);
 
 		SignalFenceAndPresent();
+
+		// Fence values increase every frame, so they are used as frame indices
+		TextureStreamer::Update(mCurrentFenceValue);
+		ResourceManager::UpdateResidency(mCurrentFenceValue + 1UL, mFence->GetCompletedValue());
+		CbvSrvUavDescriptorManager::SetFrameFenceValue(mCurrentFenceValue + 1UL);
 	}
 
 	// If we need to terminate, then we terminates command list processor
@@ -260,32 +308,241 @@ tbb::task* RenderManager::execute() {
 	return nullptr;
 }
 
-void RenderManager::ExecuteFinalPass() {
-	ID3D12GraphicsCommandList& commandList = mFinalCommandListPerFrame.ResetWithNextCommandAllocator(nullptr);
+void RenderManager::BuildFrameGraph() noexcept {
+	ASSERT(mFrameGraph.IsCompiled() == false);
 
-	CD3DX12_RESOURCE_BARRIER barriers[]{
-		ResourceStateManager::ChangeResourceStateAndGetBarrier(
-			*mGeometryPass.GetGeometryBuffers()[GeometryPass::NORMAL_SMOOTHNESS].Get(), 
-			D3D12_RESOURCE_STATE_RENDER_TARGET),
+	const std::uint32_t renderTarget{ GetFrameGraphState(D3D12_RESOURCE_STATE_RENDER_TARGET) };
+	const std::uint32_t pixelShaderResource{ GetFrameGraphState(D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE) };
+	const std::uint32_t depthWrite{ GetFrameGraphState(D3D12_RESOURCE_STATE_DEPTH_WRITE) };
 
-		ResourceStateManager::ChangeResourceStateAndGetBarrier(
-			*mGeometryPass.GetGeometryBuffers()[GeometryPass::BASECOLOR_METALMASK].Get(), 
-			D3D12_RESOURCE_STATE_RENDER_TARGET),
+	// Resources (in FrameGraphResources order) with their state when a frame begins.
+	// Frame buffer is the only output.
+	for (std::uint32_t i = 0U; i < GeometryPass::BUFFERS_COUNT; ++i) {
+		mFrameGraph.AddResource(renderTarget, false);
+	}
+	mFrameGraph.AddResource(depthWrite, false);
+	mFrameGraph.AddResource(renderTarget, false);
+	mFrameGraph.AddResource(pixelShaderResource, false);
+	mFrameGraph.AddResource(pixelShaderResource, false);
+	mFrameGraph.AddResource(pixelShaderResource, false);
+	mFrameGraph.AddResource(GetFrameGraphState(D3D12_RESOURCE_STATE_PRESENT), true);
+	ASSERT(mFrameGraph.GetResourceCount() == FRAME_GRAPH_RESOURCES_COUNT);
+
+	// Passes (in FrameGraphPasses order) with the resources they read and write.
+	std::uint32_t passIndex{ mFrameGraph.AddPass(false) };
+	ASSERT(passIndex == GEOMETRY_PASS);
+	mFrameGraph.WriteResource(passIndex, GeometryPass::NORMAL_SMOOTHNESS, renderTarget);
+	mFrameGraph.WriteResource(passIndex, GeometryPass::BASECOLOR_METALMASK, renderTarget);
+	mFrameGraph.WriteResource(passIndex, DEPTH_BUFFER, depthWrite);
+
+	passIndex = mFrameGraph.AddPass(false);
+	ASSERT(passIndex == LIGHTING_PASS);
+	mFrameGraph.ReadResource(passIndex, GeometryPass::NORMAL_SMOOTHNESS, pixelShaderResource);
+	mFrameGraph.ReadResource(passIndex, GeometryPass::BASECOLOR_METALMASK, pixelShaderResource);
+	mFrameGraph.ReadResource(passIndex, DEPTH_BUFFER, pixelShaderResource);
+	mFrameGraph.WriteResource(passIndex, INTERMEDIATE_COLOR_BUFFER_1, renderTarget);
+	// AmbientLightPass changes the state of these buffers internally, and it restores them.
+	mFrameGraph.WriteResource(passIndex, AMBIENT_ACCESSIBILITY_BUFFER, pixelShaderResource);
+	mFrameGraph.WriteResource(passIndex, BLUR_BUFFER, pixelShaderResource);
+
+	passIndex = mFrameGraph.AddPass(false);
+	ASSERT(passIndex == SKY_BOX_PASS);
+	mFrameGraph.WriteResource(passIndex, DEPTH_BUFFER, depthWrite);
+	mFrameGraph.WriteResource(passIndex, INTERMEDIATE_COLOR_BUFFER_1, renderTarget);
+
+	passIndex = mFrameGraph.AddPass(false);
+	ASSERT(passIndex == TONE_MAPPING_PASS);
+	mFrameGraph.ReadResource(passIndex, INTERMEDIATE_COLOR_BUFFER_1, pixelShaderResource);
+	mFrameGraph.WriteResource(passIndex, INTERMEDIATE_COLOR_BUFFER_2, renderTarget);
+
+	passIndex = mFrameGraph.AddPass(false);
+	ASSERT(passIndex == POST_PROCESS_PASS);
+	mFrameGraph.ReadResource(passIndex, INTERMEDIATE_COLOR_BUFFER_2, pixelShaderResource);
+	mFrameGraph.WriteResource(passIndex, FRAME_BUFFER, renderTarget);
+	ASSERT(mFrameGraph.GetPassCount() == FRAME_GRAPH_PASSES_COUNT);
+
+	mFrameGraph.Compile();
+}
 
-		ResourceStateManager::ChangeResourceStateAndGetBarrier(
-			*CurrentFrameBuffer(), 
-			D3D12_RESOURCE_STATE_PRESENT),
+void RenderManager::CreateTransientResources() noexcept {
+	ASSERT(mFrameGraph.IsCompiled());
+	ASSERT(mTransientResourceAllocator.GetResourceCount() == 0U);
 
-		ResourceStateManager::ChangeResourceStateAndGetBarrier(
-			*mIntermediateColorBuffer1.Get(), 
-			D3D12_RESOURCE_STATE_RENDER_TARGET),	
+	// Descriptors, clear values and initial states (see BuildFrameGraph()) 
+	// of all the frame graph resources but the frame buffer.
+	D3D12_RESOURCE_DESC resourceDescriptors[FRAME_BUFFER];
+	D3D12_CLEAR_VALUE clearValues[FRAME_BUFFER];
+	D3D12_RESOURCE_STATES initialStates[FRAME_BUFFER];
+	const wchar_t* resourceNames[FRAME_BUFFER] =
+	{
+		L"Normal_SmoothnessTexture Buffer",
+		L"BaseColor_MetalMaskTexture Buffer",
+		L"Depth Stencil Buffer",
+		L"Intermediate Color Buffer 1",
+		L"Intermediate Color Buffer 2",
+		L"Ambient Accessibility Buffer",
+		L"Blur Buffer",
 	};
-	const std::size_t barrierCount = _countof(barriers);
-	ASSERT(barrierCount == GeometryPass::BUFFERS_COUNT + 2UL);
-	commandList.ResourceBarrier(_countof(barriers), barriers);
+
+	GeometryPass::GetBufferDescriptors(resourceDescriptors, clearValues);
+	for (std::uint32_t i = 0U; i < GeometryPass::BUFFERS_COUNT; ++i) {
+		initialStates[i] = D3D12_RESOURCE_STATE_RENDER_TARGET;
+	}
+
+	D3D12_RESOURCE_DESC& depthStencilDesc = resourceDescriptors[DEPTH_BUFFER];
+	depthStencilDesc = {};
+	depthStencilDesc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
+	depthStencilDesc.Alignment = 0U;
+	depthStencilDesc.Width = SettingsManager::sWindowWidth;
+	depthStencilDesc.Height = SettingsManager::sWindowHeight;
+	depthStencilDesc.DepthOrArraySize = 1U;
+	depthStencilDesc.MipLevels = 1U;
+	depthStencilDesc.Format = SettingsManager::sDepthStencilFormat;
+	depthStencilDesc.SampleDesc.Count = 1U;
+	depthStencilDesc.SampleDesc.Quality = 0U;
+	depthStencilDesc.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
+	depthStencilDesc.Flags = D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL;
+	clearValues[DEPTH_BUFFER] = {};
+	clearValues[DEPTH_BUFFER].Format = SettingsManager::sDepthStencilViewFormat;
+	clearValues[DEPTH_BUFFER].DepthStencil.Depth = 1.0f;
+	clearValues[DEPTH_BUFFER].DepthStencil.Stencil = 0U;
+	initialStates[DEPTH_BUFFER] = D3D12_RESOURCE_STATE_DEPTH_WRITE;
+
+	D3D12_RESOURCE_DESC& intermediateColorBufferDesc = resourceDescriptors[INTERMEDIATE_COLOR_BUFFER_1];
+	intermediateColorBufferDesc = {};
+	intermediateColorBufferDesc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
+	intermediateColorBufferDesc.Alignment = 0U;
+	intermediateColorBufferDesc.Width = SettingsManager::sWindowWidth;
+	intermediateColorBufferDesc.Height = SettingsManager::sWindowHeight;
+	intermediateColorBufferDesc.DepthOrArraySize = 1U;
+	intermediateColorBufferDesc.MipLevels = 0U;
+	intermediateColorBufferDesc.SampleDesc.Count = 1U;
+	intermediateColorBufferDesc.SampleDesc.Quality = 0U;
+	intermediateColorBufferDesc.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
+	intermediateColorBufferDesc.Flags = D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET;
+	intermediateColorBufferDesc.Format = SettingsManager::sColorBufferFormat;
+	clearValues[INTERMEDIATE_COLOR_BUFFER_1] = { intermediateColorBufferDesc.Format, 0.0f, 0.0f, 0.0f, 1.0f };
+	initialStates[INTERMEDIATE_COLOR_BUFFER_1] = D3D12_RESOURCE_STATE_RENDER_TARGET;
+
+	resourceDescriptors[INTERMEDIATE_COLOR_BUFFER_2] = intermediateColorBufferDesc;
+	clearValues[INTERMEDIATE_COLOR_BUFFER_2] = clearValues[INTERMEDIATE_COLOR_BUFFER_1];
+	initialStates[INTERMEDIATE_COLOR_BUFFER_2] = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
+
+	AmbientLightPass::GetBufferDescriptor(
+		resourceDescriptors[AMBIENT_ACCESSIBILITY_BUFFER], 
+		clearValues[AMBIENT_ACCESSIBILITY_BUFFER]);
+	initialStates[AMBIENT_ACCESSIBILITY_BUFFER] = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
+	resourceDescriptors[BLUR_BUFFER] = resourceDescriptors[AMBIENT_ACCESSIBILITY_BUFFER];
+	clearValues[BLUR_BUFFER] = clearValues[AMBIENT_ACCESSIBILITY_BUFFER];
+	initialStates[BLUR_BUFFER] = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
+
+	// Frame graph execution order positions are used as resource lifetimes
+	for (std::uint32_t i = 0U; i < FRAME_BUFFER; ++i) {
+		const FrameGraph::ResourceLifetime& lifetime = mFrameGraph.GetResourceLifetime(i);
+		ASSERT(lifetime.mFirstPosition != FrameGraph::sInvalidIndex);
+		const std::uint32_t resourceIndex = mTransientResourceAllocator.AddResource(
+			resourceDescriptors[i],
+			initialStates[i],
+			&clearValues[i],
+			lifetime.mFirstPosition,
+			lifetime.mLastPosition,
+			resourceNames[i]);
+		ASSERT(resourceIndex == i);
+	}
+	mTransientResourceAllocator.Allocate();
+
+	// Aliased resources must be activated before their first use in every frame
+	const std::vector<std::uint32_t>& executionOrder = mFrameGraph.GetExecutionOrder();
+	for (std::uint32_t i = 0U; i < FRAME_BUFFER; ++i) {
+		if (mTransientResourceAllocator.IsAliased(i)) {
+			const std::uint32_t passIndex = executionOrder[mFrameGraph.GetResourceLifetime(i).mFirstPosition];
+			mResourcesToActivateByPass[passIndex].push_back(i);
+		}
+	}
+}
+
+ID3D12Resource& RenderManager::GetFrameGraphResource(const std::uint32_t resourceIndex) noexcept {
+	ASSERT(resourceIndex < FRAME_GRAPH_RESOURCES_COUNT);
+
+	if (resourceIndex == FRAME_BUFFER) {
+		ID3D12Resource* frameBuffer{ CurrentFrameBuffer() };
+		ASSERT(frameBuffer != nullptr);
+		return *frameBuffer;
+	}
+
+	return mTransientResourceAllocator.GetResource(resourceIndex);
+}
+
+std::uint32_t RenderManager::ExecuteFrameGraphPass(const std::uint32_t passIndex) noexcept {
+	switch (passIndex) {
+	case GEOMETRY_PASS:
+		return mGeometryPass.Execute(mFrameCBuffer, mFrameCBufferGpuAddress);
+	case LIGHTING_PASS:
+		return mLightingPass.Execute(mFrameCBufferGpuAddress);
+	case SKY_BOX_PASS:
+		return mSkyBoxPass.Execute(mFrameCBufferGpuAddress);
+	case TONE_MAPPING_PASS:
+		return mToneMappingPass.Execute();
+	case POST_PROCESS_PASS:
+		return mPostProcessPass.Execute(*CurrentFrameBuffer(), CurrentFrameBufferCpuDesc());
+	default:
+		ASSERT(false);
+		return 0U;
+	}
+}
+
+std::uint32_t RenderManager::RecordAndPushTransitions(
+	const std::vector<std::uint32_t>& resourcesToActivate,
+	const std::vector<FrameGraph::Transition>& transitions,
+	CommandListPerFrame& commandListPerFrame) noexcept
+{
+	if (resourcesToActivate.empty() && transitions.empty()) {
+		return 0U;
+	}
+
+	ASSERT(resourcesToActivate.size() <= FRAME_GRAPH_RESOURCES_COUNT);
+	ID3D12GraphicsCommandList& commandList = commandListPerFrame.ResetWithNextCommandAllocator(nullptr);
+
+	// Aliased resources share memory with resources used before in the frame, 
+	// so we need to activate them with an aliasing barrier, and to discard their content 
+	// (it is undefined). Discard requires render target or depth write state.
+	D3D12_RESOURCE_STATES statesBeforeActivation[FRAME_GRAPH_RESOURCES_COUNT];
+	for (const std::uint32_t resourceIndex : resourcesToActivate) {
+		mBarrierBatch.AddAliasingBarrier(nullptr, &GetFrameGraphResource(resourceIndex));
+	}
+	for (std::size_t i = 0UL; i < resourcesToActivate.size(); ++i) {
+		ID3D12Resource& resource = GetFrameGraphResource(resourcesToActivate[i]);
+		statesBeforeActivation[i] = ResourceStateManager::GetResourceState(resource);
+		const D3D12_RESOURCE_STATES writeState = 
+			(resource.GetDesc().Flags & D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL) != 0U ?
+			D3D12_RESOURCE_STATE_DEPTH_WRITE :
+			D3D12_RESOURCE_STATE_RENDER_TARGET;
+		mBarrierBatch.Transition(&resource, writeState);
+	}
+	ResourceStateManager::FlushBarrierBatch(mBarrierBatch, commandList);
+	for (const std::uint32_t resourceIndex : resourcesToActivate) {
+		commandList.DiscardResource(&GetFrameGraphResource(resourceIndex), nullptr);
+	}
+
+	// Activated resources must return to the state the frame graph expects. 
+	// If they have a frame graph transition, then the batch merges both transitions.
+	for (std::size_t i = 0UL; i < resourcesToActivate.size(); ++i) {
+		mBarrierBatch.Transition(&GetFrameGraphResource(resourcesToActivate[i]), statesBeforeActivation[i]);
+	}
+
+	for (const FrameGraph::Transition& transition : transitions) {
+		ID3D12Resource& resource = GetFrameGraphResource(transition.mResourceIndex);
+		ASSERT(
+			GetFrameGraphState(ResourceStateManager::GetResourceState(resource)) == transition.mStateBefore ||
+			std::find(resourcesToActivate.begin(), resourcesToActivate.end(), transition.mResourceIndex) != resourcesToActivate.end());
+		mBarrierBatch.Transition(&resource, transition.mStateAfter);
+	}
+	ResourceStateManager::FlushBarrierBatch(mBarrierBatch, commandList);
 
 	CHECK_HR(commandList.Close());
-	CommandListExecutor::Get().ExecuteCommandListAndWaitForCompletion(commandList);
+	CommandListExecutor::Get().AddCommandList(commandList);
+
+	return 1U;
 }
 
 void RenderManager::CreateFrameBuffersAndRenderTargetViews() noexcept {
@@ -315,82 +572,27 @@ void RenderManager::CreateFrameBuffersAndRenderTargetViews() noexcept {
 	}
 }
 
-void RenderManager::CreateDepthStencilBufferAndView() noexcept {
-	// Create the depth/stencil buffer and view.
-	D3D12_RESOURCE_DESC depthStencilDesc = {};
-	depthStencilDesc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
-	depthStencilDesc.Alignment = 0U;
-	depthStencilDesc.Width = SettingsManager::sWindowWidth;
-	depthStencilDesc.Height = SettingsManager::sWindowHeight;
-	depthStencilDesc.DepthOrArraySize = 1U;
-	depthStencilDesc.MipLevels = 1U;
-	depthStencilDesc.Format = SettingsManager::sDepthStencilFormat;
-	depthStencilDesc.SampleDesc.Count = 1U;
-	depthStencilDesc.SampleDesc.Quality = 0U;
-	depthStencilDesc.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
-	depthStencilDesc.Flags = D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL;
-
-	D3D12_CLEAR_VALUE clearValue = {};
-	clearValue.Format = SettingsManager::sDepthStencilViewFormat;
-	clearValue.DepthStencil.Depth = 1.0f;
-	clearValue.DepthStencil.Stencil = 0U;
-
-	CD3DX12_HEAP_PROPERTIES heapProps{ D3D12_HEAP_TYPE_DEFAULT };
-	mDepthBuffer = &ResourceManager::CreateCommittedResource(
-		heapProps,
-		D3D12_HEAP_FLAG_NONE,
-		depthStencilDesc,
-		D3D12_RESOURCE_STATE_DEPTH_WRITE,
-		&clearValue,
-		L"Depth Stencil Buffer");
-
+void RenderManager::CreateDepthStencilView() noexcept {
 	// Create descriptor to mip level 0 of entire resource using the format of the resource.
 	D3D12_DEPTH_STENCIL_VIEW_DESC depthStencilViewDesc = {};
 	depthStencilViewDesc.Format = SettingsManager::sDepthStencilViewFormat;
 	depthStencilViewDesc.ViewDimension = D3D12_DSV_DIMENSION_TEXTURE2D;
 	depthStencilViewDesc.Texture2D.MipSlice = 0;
-	DepthStencilDescriptorManager::CreateDepthStencilView(*mDepthBuffer, depthStencilViewDesc, &mDepthBufferRenderTargetView);
+	DepthStencilDescriptorManager::CreateDepthStencilView(
+		GetFrameGraphResource(DEPTH_BUFFER), 
+		depthStencilViewDesc, 
+		&mDepthBufferRenderTargetView);
 }
 
-void RenderManager::CreateIntermediateColorBufferAndRenderTargetView(
-	const D3D12_RESOURCE_STATES initialState,
-	const wchar_t* resourceName,
-	Microsoft::WRL::ComPtr<ID3D12Resource>& buffer,
+void RenderManager::CreateIntermediateColorBufferRenderTargetView(
+	ID3D12Resource& buffer,
 	D3D12_CPU_DESCRIPTOR_HANDLE& renderTargetView) noexcept
 {
-	ASSERT(resourceName != nullptr);
-
-	// Fill resource description
-	D3D12_RESOURCE_DESC resourceDescriptor = {};
-	resourceDescriptor.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
-	resourceDescriptor.Alignment = 0U;
-	resourceDescriptor.Width = SettingsManager::sWindowWidth;
-	resourceDescriptor.Height = SettingsManager::sWindowHeight;
-	resourceDescriptor.DepthOrArraySize = 1U;
-	resourceDescriptor.MipLevels = 0U;
-	resourceDescriptor.SampleDesc.Count = 1U;
-	resourceDescriptor.SampleDesc.Quality = 0U;
-	resourceDescriptor.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
-	resourceDescriptor.Flags = D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET;
-	resourceDescriptor.Format = SettingsManager::sColorBufferFormat;
-
-	// Create buffer and render target view
 	D3D12_RENDER_TARGET_VIEW_DESC rtvDescriptor{};
 	rtvDescriptor.ViewDimension = D3D12_RTV_DIMENSION_TEXTURE2D;
-	rtvDescriptor.Format = resourceDescriptor.Format;
-	CD3DX12_HEAP_PROPERTIES heapProperties{ D3D12_HEAP_TYPE_DEFAULT };
-	D3D12_CLEAR_VALUE clearValue = { resourceDescriptor.Format, 0.0f, 0.0f, 0.0f, 1.0f };
-	ID3D12Resource* resource = &ResourceManager::CreateCommittedResource(
-		heapProperties,
-		D3D12_HEAP_FLAG_NONE,
-		resourceDescriptor,
-		initialState,
-		&clearValue,
-		resourceName);
-	buffer = Microsoft::WRL::ComPtr<ID3D12Resource>(resource);
-
+	rtvDescriptor.Format = SettingsManager::sColorBufferFormat;
 	RenderTargetDescriptorManager::CreateRenderTargetView(
-		*buffer.Get(),
+		buffer,
 		rtvDescriptor,
 		&renderTargetView);
 }
@@ -418,6 +620,7 @@ void RenderManager::SignalFenceAndPresent() noexcept {
 	// are on the GPU time line, the new fence point won't be set until the GPU finishes
 	// processing all the commands prior to this Signal().
 	mFenceValueByQueuedFrameIndex[mCurrentQueuedFrameIndex] = ++mCurrentFenceValue;
+	mFrameUploadRingBuffer->FinishFrame(mCurrentFenceValue);
 	mCurrentQueuedFrameIndex = (mCurrentQueuedFrameIndex + 1U) % SettingsManager::sQueuedFrameCount;
 	const std::uint64_t oldestFence{ mFenceValueByQueuedFrameIndex[mCurrentQueuedFrameIndex] };
 
@@ -427,4 +630,9 @@ void RenderManager::SignalFenceAndPresent() noexcept {
 		*mFence,
 		mCurrentFenceValue,
 		oldestFence);
+
+	// Upload memory and descriptors used by completed frames can be reused
+	const std::uint64_t completedFence{ mFence->GetCompletedValue() };
+	mFrameUploadRingBuffer->ReleaseCompletedFrames(completedFence);
+	CbvSrvUavDescriptorManager::ReleaseCompletedDescriptors(completedFence);
 }
@@ -9,6 +9,10 @@
 #include <GeometryPass\GeometryPass.h>
 #include <LightingPass\LightingPass.h>
 #include <PostProcesspass\PostProcesspass.h>
+#include <RenderManager\FrameGraph.h>
+#include <ResourceManager\TransientResourceAllocator.h>
+#include <ResourceManager\UploadRingBuffer.h>
+#include <ResourceStateManager\ResourceBarrierBatch.h>
 #include <SettingsManager\SettingsManager.h>
 #include <SkyBoxPass\SkyBoxPass.h>
 #include <ShaderUtils\CBuffers.h>
@@ -37,6 +41,28 @@ public:
 	void Terminate() noexcept;
 
 private:
+	// Frame graph passes, in declaration order
+	enum FrameGraphPasses {
+		GEOMETRY_PASS = 0U,
+		LIGHTING_PASS,
+		SKY_BOX_PASS,
+		TONE_MAPPING_PASS,
+		POST_PROCESS_PASS,
+		FRAME_GRAPH_PASSES_COUNT
+	};
+
+	// Frame graph resources. Geometry buffers are the first ones, 
+	// so GeometryPass::Buffers values are also frame graph resource indices.
+	enum FrameGraphResources {
+		DEPTH_BUFFER = GeometryPass::BUFFERS_COUNT,
+		INTERMEDIATE_COLOR_BUFFER_1,
+		INTERMEDIATE_COLOR_BUFFER_2,
+		AMBIENT_ACCESSIBILITY_BUFFER,
+		BLUR_BUFFER,
+		FRAME_BUFFER,
+		FRAME_GRAPH_RESOURCES_COUNT
+	};
+
 	explicit RenderManager(Scene& scene);
 
 	// Called when tbb::task is spawned
@@ -46,14 +72,34 @@ private:
 
 	void InitPasses(Scene& scene) noexcept;
 
+	// Declares passes and the resources they read and write, and compiles the frame graph.
+	void BuildFrameGraph() noexcept;
+
+	// Creates all the frame graph resources but the frame buffer in a shared heap,
+	// where resources whose lifetimes do not overlap share memory.
+	// Preconditions:
+	// - BuildFrameGraph() must be called first
+	void CreateTransientResources() noexcept;
+
+	ID3D12Resource& GetFrameGraphResource(const std::uint32_t resourceIndex) noexcept;
+
+	// Returns the number of command lists pushed to CommandListExecutor
+	std::uint32_t ExecuteFrameGraphPass(const std::uint32_t passIndex) noexcept;
+
+	// Records resource barriers to activate aliased resources (see TransientResourceAllocator) and
+	// for the frame graph transitions, and pushes them to CommandListExecutor. 
+	// Returns the number of pushed command lists (zero if there are no barriers)
+	std::uint32_t RecordAndPushTransitions(
+		const std::vector<std::uint32_t>& resourcesToActivate,
+		const std::vector<FrameGraph::Transition>& transitions,
+		CommandListPerFrame& commandListPerFrame) noexcept;
+
 	void CreateFrameBuffersAndRenderTargetViews() noexcept;
 
-	void CreateDepthStencilBufferAndView() noexcept;
+	void CreateDepthStencilView() noexcept;
 
-	void CreateIntermediateColorBufferAndRenderTargetView(		
-		const D3D12_RESOURCE_STATES initialState,
-		const wchar_t* resourceName,
-		Microsoft::WRL::ComPtr<ID3D12Resource>& buffer,
+	void CreateIntermediateColorBufferRenderTargetView(
+		ID3D12Resource& buffer,
 		D3D12_CPU_DESCRIPTOR_HANDLE& renderTargetView) noexcept;
 	
 	ID3D12Resource* CurrentFrameBuffer() const noexcept {
@@ -69,8 +115,6 @@ private:
 		return mDepthBufferRenderTargetView;
 	}
 
-	void ExecuteFinalPass();
-
 	void FlushCommandQueue() noexcept;
 	void SignalFenceAndPresent() noexcept;
 
@@ -89,24 +133,37 @@ private:
 	ToneMappingPass mToneMappingPass;
 	PostProcessPass mPostProcessPass;
 
+	FrameGraph mFrameGraph;
+
+	// Frame graph resources (but the frame buffer) are placed here, using frame graph resource indices.
+	TransientResourceAllocator mTransientResourceAllocator;
+
+	// Aliased resources whose first use is each pass. They must be activated before the pass.
+	std::vector<std::uint32_t> mResourcesToActivateByPass[FRAME_GRAPH_PASSES_COUNT];
+
+	// Command lists to record frame graph transitions before each pass and at the end of the frame
+	CommandListPerFrame mTransitionCommandListsPerFrame[FRAME_GRAPH_PASSES_COUNT];
 	CommandListPerFrame mFinalCommandListPerFrame;
+	ResourceBarrierBatch mBarrierBatch;
 	
 	Microsoft::WRL::ComPtr<ID3D12Resource> mFrameBuffers[SettingsManager::sSwapChainBufferCount];
 	D3D12_CPU_DESCRIPTOR_HANDLE mFrameBufferRenderTargetViews[SettingsManager::sSwapChainBufferCount]{ 0UL };
 
-	ID3D12Resource* mDepthBuffer{ nullptr };
 	D3D12_CPU_DESCRIPTOR_HANDLE mDepthBufferRenderTargetView{ 0UL };
 
-	// Buffers used for intermediate computations.
+	// Render target views of buffers used for intermediate computations.
 	// They are used as render targets (light pass) or pixel shader resources (post processing passes)
-	Microsoft::WRL::ComPtr<ID3D12Resource> mIntermediateColorBuffer1;
 	D3D12_CPU_DESCRIPTOR_HANDLE mIntermediateColorBuffer1RenderTargetView;
-	Microsoft::WRL::ComPtr<ID3D12Resource> mIntermediateColorBuffer2;
 	D3D12_CPU_DESCRIPTOR_HANDLE mIntermediateColorBuffer2RenderTargetView;
 
 	// We cache it here, as is is used by most passes.
 	FrameCBuffer mFrameCBuffer;
 
+	// Data uploaded every frame (frame constant buffer and instance data) is allocated here.
+	// Frame constant buffer is uploaded once per frame and shared by all the passes.
+	UploadRingBuffer* mFrameUploadRingBuffer{ nullptr };
+	D3D12_GPU_VIRTUAL_ADDRESS mFrameCBufferGpuAddress{ 0UL };
+
 	Camera mCamera;
 	Timer mTimer;
 	
@@ -0,0 +1,933 @@
+#include "BlockCompressor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <emmintrin.h>
+#include <limits>
+#include <tbb/parallel_for.h>
+
+#include <Utils/DebugUtils.h>
+
+namespace {
+	const std::uint32_t sTexelCount{ 16U };
+
+	// Number of least squares refinements of the endpoints
+	const std::uint32_t sRefinementCount{ 2U };
+
+	// Interpolation weights (out of 64) of BC7 4 bits indices
+	const std::uint32_t sBC7Weights[16U]{ 0U, 4U, 9U, 13U, 17U, 21U, 26U, 30U, 34U, 38U, 43U, 47U, 51U, 55U, 60U, 64U };
+
+	// Texels of a block by channel (RGBA), so 4 texels are processed at a time
+	struct BlockChannels {
+		alignas(16) float mValues[4U][sTexelCount];
+
+		// Texels whose weight is zero do not count in errors and endpoints
+		alignas(16) float mWeights[sTexelCount];
+	};
+
+	// Palette of up to 16 colors
+	struct Palette {
+		float mColors[16U][4U];
+		std::uint32_t mSize{ 0U };
+	};
+
+	void LoadBlockChannels(const std::uint8_t* texels, BlockChannels& channels) noexcept {
+		for (std::uint32_t i = 0U; i < sTexelCount; ++i) {
+			for (std::uint32_t c = 0U; c < 4U; ++c) {
+				channels.mValues[c][i] = static_cast<float>(texels[i * 4U + c]);
+			}
+			channels.mWeights[i] = 1.0f;
+		}
+	}
+
+	std::uint32_t Quantize(const float value, const std::uint32_t maxValue, const float scale) noexcept {
+		const float quantizedValue{ std::floor(value * scale + 0.5f) };
+		return static_cast<std::uint32_t>(std::min<float>(std::max<float>(quantizedValue, 0.0f), static_cast<float>(maxValue)));
+	}
+
+	// Selects the nearest palette color of each texel (in the first "channelCount" channels),
+	// and returns the sum of the weighted squared errors.
+	float SelectIndices(
+		const BlockChannels& channels,
+		const std::uint32_t channelCount,
+		const Palette& palette,
+		std::uint8_t* indices) noexcept
+	{
+		ASSERT(channelCount <= 4U);
+		ASSERT(palette.mSize > 0U);
+
+		__m128 totalError{ _mm_setzero_ps() };
+		for (std::uint32_t i = 0U; i < sTexelCount; i += 4U) {
+			__m128 nearestDistance{ _mm_set1_ps(std::numeric_limits<float>::max()) };
+			__m128i nearestIndex{ _mm_setzero_si128() };
+			for (std::uint32_t j = 0U; j < palette.mSize; ++j) {
+				__m128 distance{ _mm_setzero_ps() };
+				for (std::uint32_t c = 0U; c < channelCount; ++c) {
+					const __m128 difference{ _mm_sub_ps(_mm_load_ps(&channels.mValues[c][i]), _mm_set1_ps(palette.mColors[j][c])) };
+					distance = _mm_add_ps(distance, _mm_mul_ps(difference, difference));
+				}
+
+				const __m128i isNearer{ _mm_castps_si128(_mm_cmplt_ps(distance, nearestDistance)) };
+				nearestDistance = _mm_min_ps(distance, nearestDistance);
+				nearestIndex = _mm_or_si128(
+					_mm_andnot_si128(isNearer, nearestIndex),
+					_mm_and_si128(isNearer, _mm_set1_epi32(static_cast<int>(j))));
+			}
+
+			totalError = _mm_add_ps(totalError, _mm_mul_ps(nearestDistance, _mm_load_ps(&channels.mWeights[i])));
+
+			alignas(16) std::int32_t nearestIndices[4U];
+			_mm_store_si128(reinterpret_cast<__m128i*>(nearestIndices), nearestIndex);
+			for (std::uint32_t k = 0U; k < 4U; ++k) {
+				indices[i + k] = static_cast<std::uint8_t>(nearestIndices[k]);
+			}
+		}
+
+		alignas(16) float errors[4U];
+		_mm_store_ps(errors, totalError);
+
+		return errors[0U] + errors[1U] + errors[2U] + errors[3U];
+	}
+
+	// Endpoints of the line that fits the texels (the principal axis of their covariance)
+	void ComputePrincipalEndpoints(
+		const BlockChannels& channels,
+		const std::uint32_t channelCount,
+		float* endpoint0,
+		float* endpoint1) noexcept
+	{
+		float mean[4U]{};
+		float totalWeight{ 0.0f };
+		for (std::uint32_t i = 0U; i < sTexelCount; ++i) {
+			for (std::uint32_t c = 0U; c < channelCount; ++c) {
+				mean[c] += channels.mValues[c][i] * channels.mWeights[i];
+			}
+			totalWeight += channels.mWeights[i];
+		}
+		ASSERT(totalWeight > 0.0f);
+
+		for (std::uint32_t c = 0U; c < channelCount; ++c) {
+			mean[c] /= totalWeight;
+		}
+
+		float covariance[4U][4U]{};
+		float minValues[4U]{ 255.0f, 255.0f, 255.0f, 255.0f };
+		float maxValues[4U]{};
+		for (std::uint32_t i = 0U; i < sTexelCount; ++i) {
+			if (channels.mWeights[i] == 0.0f) {
+				continue;
+			}
+
+			for (std::uint32_t c = 0U; c < channelCount; ++c) {
+				const float value{ channels.mValues[c][i] };
+				minValues[c] = std::min<float>(minValues[c], value);
+				maxValues[c] = std::max<float>(maxValues[c], value);
+				for (std::uint32_t d = 0U; d < channelCount; ++d) {
+					covariance[c][d] += (value - mean[c]) * (channels.mValues[d][i] - mean[d]) * channels.mWeights[i];
+				}
+			}
+		}
+
+		// Power iteration, from the diagonal of the bounding box
+		float axis[4U]{};
+		for (std::uint32_t c = 0U; c < channelCount; ++c) {
+			axis[c] = maxValues[c] - minValues[c];
+		}
+		for (std::uint32_t iteration = 0U; iteration < 8U; ++iteration) {
+			float nextAxis[4U]{};
+			float length{ 0.0f };
+			for (std::uint32_t c = 0U; c < channelCount; ++c) {
+				for (std::uint32_t d = 0U; d < channelCount; ++d) {
+					nextAxis[c] += covariance[c][d] * axis[d];
+				}
+				length = std::max<float>(length, std::abs(nextAxis[c]));
+			}
+
+			if (length < 1e-6f) {
+				break;
+			}
+
+			for (std::uint32_t c = 0U; c < channelCount; ++c) {
+				axis[c] = nextAxis[c] / length;
+			}
+		}
+
+		float squaredLength{ 0.0f };
+		for (std::uint32_t c = 0U; c < channelCount; ++c) {
+			squaredLength += axis[c] * axis[c];
+		}
+
+		// Texels project to the mean if they are equal
+		float minProjection{ 0.0f };
+		float maxProjection{ 0.0f };
+		if (squaredLength > 1e-12f) {
+			minProjection = std::numeric_limits<float>::max();
+			maxProjection = -std::numeric_limits<float>::max();
+			for (std::uint32_t i = 0U; i < sTexelCount; ++i) {
+				if (channels.mWeights[i] == 0.0f) {
+					continue;
+				}
+
+				float projection{ 0.0f };
+				for (std::uint32_t c = 0U; c < channelCount; ++c) {
+					projection += (channels.mValues[c][i] - mean[c]) * axis[c];
+				}
+				projection /= squaredLength;
+				minProjection = std::min<float>(minProjection, projection);
+				maxProjection = std::max<float>(maxProjection, projection);
+			}
+		}
+
+		for (std::uint32_t c = 0U; c < channelCount; ++c) {
+			endpoint0[c] = std::min<float>(std::max<float>(mean[c] + axis[c] * maxProjection, 0.0f), 255.0f);
+			endpoint1[c] = std::min<float>(std::max<float>(mean[c] + axis[c] * minProjection, 0.0f), 255.0f);
+		}
+	}
+
+	// Endpoints that minimize the squared error of the texels, if each texel is
+	// (1 - f) * endpoint0 + f * endpoint1, where f is the fraction of its index.
+	// Texels whose index fraction is negative are not included.
+	// It returns false if the endpoints cannot be computed (for example, all the texels have the same index).
+	bool RefineEndpoints(
+		const BlockChannels& channels,
+		const std::uint32_t channelCount,
+		const std::uint8_t* indices,
+		const float* indexFractions,
+		float* endpoint0,
+		float* endpoint1) noexcept
+	{
+		float a{ 0.0f };
+		float b{ 0.0f };
+		float c{ 0.0f };
+		float x0[4U]{};
+		float x1[4U]{};
+		for (std::uint32_t i = 0U; i < sTexelCount; ++i) {
+			const float fraction{ indexFractions[indices[i]] };
+			const float weight{ channels.mWeights[i] };
+			if (fraction < 0.0f || weight == 0.0f) {
+				continue;
+			}
+
+			const float inverseFraction{ 1.0f - fraction };
+			a += inverseFraction * inverseFraction * weight;
+			b += inverseFraction * fraction * weight;
+			c += fraction * fraction * weight;
+			for (std::uint32_t ch = 0U; ch < channelCount; ++ch) {
+				x0[ch] += inverseFraction * channels.mValues[ch][i] * weight;
+				x1[ch] += fraction * channels.mValues[ch][i] * weight;
+			}
+		}
+
+		const float determinant{ a * c - b * b };
+		if (std::abs(determinant) < 1e-6f) {
+			return false;
+		}
+
+		for (std::uint32_t ch = 0U; ch < channelCount; ++ch) {
+			endpoint0[ch] = std::min<float>(std::max<float>((c * x0[ch] - b * x1[ch]) / determinant, 0.0f), 255.0f);
+			endpoint1[ch] = std::min<float>(std::max<float>((a * x1[ch] - b * x0[ch]) / determinant, 0.0f), 255.0f);
+		}
+
+		return true;
+	}
+
+	void WriteUInt16(const std::uint32_t value, std::uint8_t* data) noexcept {
+		data[0U] = static_cast<std::uint8_t>(value & 0xFFU);
+		data[1U] = static_cast<std::uint8_t>(value >> 8U);
+	}
+
+	std::uint32_t ReadUInt16(const std::uint8_t* data) noexcept {
+		return static_cast<std::uint32_t>(data[0U]) | (static_cast<std::uint32_t>(data[1U]) << 8U);
+	}
+
+	//
+	// BC1
+	//
+
+	std::uint32_t QuantizeRGB565(const float* color) noexcept {
+		return
+			(Quantize(color[0U], 31U, 31.0f / 255.0f) << 11U) |
+			(Quantize(color[1U], 63U, 63.0f / 255.0f) << 5U) |
+			Quantize(color[2U], 31U, 31.0f / 255.0f);
+	}
+
+	void ExpandRGB565(const std::uint32_t color, std::uint32_t* expandedColor) noexcept {
+		const std::uint32_t r{ (color >> 11U) & 0x1FU };
+		const std::uint32_t g{ (color >> 5U) & 0x3FU };
+		const std::uint32_t b{ color & 0x1FU };
+		expandedColor[0U] = (r << 3U) | (r >> 2U);
+		expandedColor[1U] = (g << 2U) | (g >> 4U);
+		expandedColor[2U] = (b << 3U) | (b >> 2U);
+	}
+
+	// Colors in 4 colors mode are color0, color1, 2/3 color0 + 1/3 color1, and 1/3 color0 + 2/3 color1.
+	// Colors in 3 colors mode are color0, color1, 1/2 color0 + 1/2 color1, and transparent black.
+	void ComputeBC1Palette(
+		const std::uint32_t color0,
+		const std::uint32_t color1,
+		const bool isFourColorMode,
+		Palette& palette) noexcept
+	{
+		std::uint32_t expandedColor0[3U];
+		std::uint32_t expandedColor1[3U];
+		ExpandRGB565(color0, expandedColor0);
+		ExpandRGB565(color1, expandedColor1);
+
+		for (std::uint32_t c = 0U; c < 3U; ++c) {
+			const std::uint32_t value0{ expandedColor0[c] };
+			const std::uint32_t value1{ expandedColor1[c] };
+			palette.mColors[0U][c] = static_cast<float>(value0);
+			palette.mColors[1U][c] = static_cast<float>(value1);
+			if (isFourColorMode) {
+				palette.mColors[2U][c] = static_cast<float>((2U * value0 + value1 + 1U) / 3U);
+				palette.mColors[3U][c] = static_cast<float>((value0 + 2U * value1 + 1U) / 3U);
+			} else {
+				palette.mColors[2U][c] = static_cast<float>((value0 + value1 + 1U) / 2U);
+				palette.mColors[3U][c] = 0.0f;
+			}
+		}
+
+		palette.mColors[0U][3U] = 255.0f;
+		palette.mColors[1U][3U] = 255.0f;
+		palette.mColors[2U][3U] = 255.0f;
+		palette.mColors[3U][3U] = isFourColorMode ? 255.0f : 0.0f;
+		palette.mSize = 4U;
+	}
+
+	// If "isAlwaysFourColorMode" is true (BC3 color), then texels are not transparent,
+	// and the decoder always uses 4 colors mode.
+	void CompressBC1Block(
+		const std::uint8_t* texels,
+		const bool isAlwaysFourColorMode,
+		std::uint8_t* block) noexcept
+	{
+		BlockChannels channels;
+		LoadBlockChannels(texels, channels);
+
+		bool hasTransparentTexels{ false };
+		if (isAlwaysFourColorMode == false) {
+			for (std::uint32_t i = 0U; i < sTexelCount; ++i) {
+				if (texels[i * 4U + 3U] < 128U) {
+					channels.mWeights[i] = 0.0f;
+					hasTransparentTexels = true;
+				}
+			}
+		}
+
+		std::uint8_t bestIndices[sTexelCount]{};
+		std::uint32_t bestColor0{ 0U };
+		std::uint32_t bestColor1{ 0U };
+		float bestError{ std::numeric_limits<float>::max() };
+
+		float totalWeight{ 0.0f };
+		for (std::uint32_t i = 0U; i < sTexelCount; ++i) {
+			totalWeight += channels.mWeights[i];
+		}
+
+		if (totalWeight > 0.0f) {
+			float endpoint0[4U];
+			float endpoint1[4U];
+			ComputePrincipalEndpoints(channels, 3U, endpoint0, endpoint1);
+
+			for (std::uint32_t iteration = 0U; iteration <= sRefinementCount; ++iteration) {
+				std::uint32_t color0{ QuantizeRGB565(endpoint0) };
+				std::uint32_t color1{ QuantizeRGB565(endpoint1) };
+
+				// Endpoints order selects the mode: 4 colors mode if color0 > color1
+				if (hasTransparentTexels ? color0 > color1 : color0 < color1) {
+					std::swap(color0, color1);
+				}
+
+				const bool isFourColorMode{ isAlwaysFourColorMode || color0 > color1 };
+				Palette palette;
+				ComputeBC1Palette(color0, color1, isFourColorMode, palette);
+				palette.mSize = isFourColorMode ? 4U : 3U;
+
+				std::uint8_t indices[sTexelCount];
+				const float error{ SelectIndices(channels, 3U, palette, indices) };
+				if (error < bestError) {
+					bestError = error;
+					bestColor0 = color0;
+					bestColor1 = color1;
+					std::memcpy(bestIndices, indices, sizeof(indices));
+				}
+
+				const float fourColorModeFractions[4U]{ 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+				const float threeColorModeFractions[4U]{ 0.0f, 1.0f, 0.5f, -1.0f };
+				if (iteration == sRefinementCount ||
+					RefineEndpoints(
+						channels,
+						3U,
+						indices,
+						isFourColorMode ? fourColorModeFractions : threeColorModeFractions,
+						endpoint0,
+						endpoint1) == false)
+				{
+					break;
+				}
+			}
+		}
+
+		for (std::uint32_t i = 0U; i < sTexelCount; ++i) {
+			if (channels.mWeights[i] == 0.0f) {
+				bestIndices[i] = 3U;
+			}
+		}
+
+		WriteUInt16(bestColor0, block);
+		WriteUInt16(bestColor1, block + 2U);
+		std::uint32_t packedIndices{ 0U };
+		for (std::uint32_t i = 0U; i < sTexelCount; ++i) {
+			packedIndices |= static_cast<std::uint32_t>(bestIndices[i]) << (2U * i);
+		}
+		for (std::uint32_t i = 0U; i < 4U; ++i) {
+			block[4U + i] = static_cast<std::uint8_t>(packedIndices >> (8U * i));
+		}
+	}
+
+	void DecompressBC1Block(
+		const std::uint8_t* block,
+		const bool isAlwaysFourColorMode,
+		std::uint8_t* texels) noexcept
+	{
+		const std::uint32_t color0{ ReadUInt16(block) };
+		const std::uint32_t color1{ ReadUInt16(block + 2U) };
+		Palette palette;
+		ComputeBC1Palette(color0, color1, isAlwaysFourColorMode || color0 > color1, palette);
+
+		for (std::uint32_t i = 0U; i < sTexelCount; ++i) {
+			const std::uint32_t index{ (block[4U + i / 4U] >> (2U * (i % 4U))) & 0x3U };
+			for (std::uint32_t c = 0U; c < 4U; ++c) {
+				texels[i * 4U + c] = static_cast<std::uint8_t>(palette.mColors[index][c]);
+			}
+		}
+	}
+
+	//
+	// BC4
+	//
+
+	// Values in 8 values mode (value0 > value1) are value0, value1, and 6 interpolated values.
+	// Values in 6 values mode are value0, value1, 4 interpolated values, 0 and 255.
+	void ComputeBC4Palette(
+		const std::uint32_t value0,
+		const std::uint32_t value1,
+		const std::uint32_t channel,
+		Palette& palette) noexcept
+	{
+		std::uint32_t values[8U]{ value0, value1 };
+		if (value0 > value1) {
+			for (std::uint32_t i = 2U; i < 8U; ++i) {
+				values[i] = ((8U - i) * value0 + (i - 1U) * value1 + 3U) / 7U;
+			}
+		} else {
+			for (std::uint32_t i = 2U; i < 6U; ++i) {
+				values[i] = ((6U - i) * value0 + (i - 1U) * value1 + 2U) / 5U;
+			}
+			values[6U] = 0U;
+			values[7U] = 255U;
+		}
+
+		for (std::uint32_t i = 0U; i < 8U; ++i) {
+			palette.mColors[i][channel] = static_cast<float>(values[i]);
+		}
+		palette.mSize = 8U;
+	}
+
+	// Compresses a channel of the block
+	void CompressBC4Block(
+		const BlockChannels& channels,
+		const std::uint32_t channel,
+		std::uint8_t* block) noexcept
+	{
+		// Channels before "channel" are zero in the palette and in the texels, so they do not change errors
+		BlockChannels blockChannel{};
+		std::memcpy(blockChannel.mValues[channel], channels.mValues[channel], sizeof(blockChannel.mValues[channel]));
+		std::memcpy(blockChannel.mWeights, channels.mWeights, sizeof(blockChannel.mWeights));
+		const std::uint32_t channelCount{ channel + 1U };
+
+		float minValue{ 255.0f };
+		float maxValue{ 0.0f };
+		float minInnerValue{ 255.0f };
+		float maxInnerValue{ 0.0f };
+		for (std::uint32_t i = 0U; i < sTexelCount; ++i) {
+			const float value{ blockChannel.mValues[channel][i] };
+			minValue = std::min<float>(minValue, value);
+			maxValue = std::max<float>(maxValue, value);
+			if (value > 0.0f && value < 255.0f) {
+				minInnerValue = std::min<float>(minInnerValue, value);
+				maxInnerValue = std::max<float>(maxInnerValue, value);
+			}
+		}
+
+		std::uint8_t bestIndices[sTexelCount]{};
+		std::uint32_t bestValue0{ static_cast<std::uint32_t>(minValue) };
+		std::uint32_t bestValue1{ static_cast<std::uint32_t>(minValue) };
+		float bestError{ std::numeric_limits<float>::max() };
+
+		// 8 values mode, from the range of the values
+		if (minValue < maxValue) {
+			float endpoint0[4U]{};
+			float endpoint1[4U]{};
+			endpoint0[channel] = maxValue;
+			endpoint1[channel] = minValue;
+			for (std::uint32_t iteration = 0U; iteration <= sRefinementCount; ++iteration) {
+				std::uint32_t value0{ Quantize(endpoint0[channel], 255U, 1.0f) };
+				std::uint32_t value1{ Quantize(endpoint1[channel], 255U, 1.0f) };
+				if (value0 < value1) {
+					std::swap(value0, value1);
+				} else if (value0 == value1) {
+					if (value0 < 255U) {
+						++value0;
+					} else {
+						--value1;
+					}
+				}
+
+				Palette palette{};
+				ComputeBC4Palette(value0, value1, channel, palette);
+				std::uint8_t indices[sTexelCount];
+				const float error{ SelectIndices(blockChannel, channelCount, palette, indices) };
+				if (error < bestError) {
+					bestError = error;
+					bestValue0 = value0;
+					bestValue1 = value1;
+					std::memcpy(bestIndices, indices, sizeof(indices));
+				}
+
+				const float indexFractions[8U]{ 0.0f, 1.0f, 1.0f / 7.0f, 2.0f / 7.0f, 3.0f / 7.0f, 4.0f / 7.0f, 5.0f / 7.0f, 6.0f / 7.0f };
+				if (iteration == sRefinementCount ||
+					RefineEndpoints(blockChannel, channelCount, indices, indexFractions, endpoint0, endpoint1) == false)
+				{
+					break;
+				}
+			}
+		}
+
+		// 6 values mode, from the range of the values that are not 0 or 255
+		if (bestError > 0.0f) {
+			const std::uint32_t value0{ minInnerValue <= maxInnerValue ? static_cast<std::uint32_t>(minInnerValue) : 0U };
+			const std::uint32_t value1{ minInnerValue <= maxInnerValue ? static_cast<std::uint32_t>(maxInnerValue) : 0U };
+			Palette palette{};
+			ComputeBC4Palette(value0, value1, channel, palette);
+			std::uint8_t indices[sTexelCount];
+			const float error{ SelectIndices(blockChannel, channelCount, palette, indices) };
+			if (error < bestError) {
+				bestError = error;
+				bestValue0 = value0;
+				bestValue1 = value1;
+				std::memcpy(bestIndices, indices, sizeof(indices));
+			}
+		}
+
+		block[0U] = static_cast<std::uint8_t>(bestValue0);
+		block[1U] = static_cast<std::uint8_t>(bestValue1);
+		std::uint64_t packedIndices{ 0UL };
+		for (std::uint32_t i = 0U; i < sTexelCount; ++i) {
+			packedIndices |= static_cast<std::uint64_t>(bestIndices[i]) << (3U * i);
+		}
+		for (std::uint32_t i = 0U; i < 6U; ++i) {
+			block[2U + i] = static_cast<std::uint8_t>(packedIndices >> (8U * i));
+		}
+	}
+
+	void DecompressBC4Block(
+		const std::uint8_t* block,
+		const std::uint32_t channel,
+		std::uint8_t* texels) noexcept
+	{
+		Palette palette{};
+		ComputeBC4Palette(block[0U], block[1U], channel, palette);
+
+		std::uint64_t packedIndices{ 0UL };
+		for (std::uint32_t i = 0U; i < 6U; ++i) {
+			packedIndices |= static_cast<std::uint64_t>(block[2U + i]) << (8U * i);
+		}
+
+		for (std::uint32_t i = 0U; i < sTexelCount; ++i) {
+			const std::uint32_t index{ static_cast<std::uint32_t>(packedIndices >> (3U * i)) & 0x7U };
+			texels[i * 4U + channel] = static_cast<std::uint8_t>(palette.mColors[index][channel]);
+		}
+	}
+
+	//
+	// BC7 (mode 6)
+	//
+
+	// Bits are written from the least significant bit of the first byte
+	class BitWriter {
+	public:
+		explicit BitWriter(std::uint8_t* data) : mData(data) {}
+
+		void Write(const std::uint32_t value, const std::uint32_t bitCount) noexcept {
+			for (std::uint32_t i = 0U; i < bitCount; ++i, ++mPosition) {
+				if ((value >> i) & 0x1U) {
+					mData[mPosition / 8U] |= static_cast<std::uint8_t>(1U << (mPosition % 8U));
+				}
+			}
+		}
+
+	private:
+		std::uint8_t* mData{ nullptr };
+		std::uint32_t mPosition{ 0U };
+	};
+
+	class BitReader {
+	public:
+		explicit BitReader(const std::uint8_t* data) : mData(data) {}
+
+		std::uint32_t Read(const std::uint32_t bitCount) noexcept {
+			std::uint32_t value{ 0U };
+			for (std::uint32_t i = 0U; i < bitCount; ++i, ++mPosition) {
+				value |= ((mData[mPosition / 8U] >> (mPosition % 8U)) & 0x1U) << i;
+			}
+
+			return value;
+		}
+
+	private:
+		const std::uint8_t* mData{ nullptr };
+		std::uint32_t mPosition{ 0U };
+	};
+
+	// Endpoints are 7 bits per channel, and a bit per endpoint that is the least significant bit of its channels
+	struct BC7Endpoints {
+		std::uint32_t mColors[2U][4U];
+		std::uint32_t mBits[2U];
+	};
+
+	void ComputeBC7Palette(const BC7Endpoints& endpoints, Palette& palette) noexcept {
+		for (std::uint32_t c = 0U; c < 4U; ++c) {
+			const std::uint32_t value0{ (endpoints.mColors[0U][c] << 1U) | endpoints.mBits[0U] };
+			const std::uint32_t value1{ (endpoints.mColors[1U][c] << 1U) | endpoints.mBits[1U] };
+			for (std::uint32_t i = 0U; i < 16U; ++i) {
+				palette.mColors[i][c] = static_cast<float>(((64U - sBC7Weights[i]) * value0 + sBC7Weights[i] * value1 + 32U) >> 6U);
+			}
+		}
+		palette.mSize = 16U;
+	}
+
+	void CompressBC7Block(const std::uint8_t* texels, std::uint8_t* block) noexcept {
+		BlockChannels channels;
+		LoadBlockChannels(texels, channels);
+
+		float endpoint0[4U];
+		float endpoint1[4U];
+		ComputePrincipalEndpoints(channels, 4U, endpoint0, endpoint1);
+
+		BC7Endpoints bestEndpoints{};
+		std::uint8_t bestIndices[sTexelCount]{};
+		float bestError{ std::numeric_limits<float>::max() };
+		for (std::uint32_t iteration = 0U; iteration <= sRefinementCount; ++iteration) {
+			// Each combination of endpoint bits quantizes endpoints differently
+			std::uint8_t iterationIndices[sTexelCount]{};
+			float iterationError{ std::numeric_limits<float>::max() };
+			for (std::uint32_t bits = 0U; bits < 4U; ++bits) {
+				BC7Endpoints endpoints;
+				endpoints.mBits[0U] = bits & 0x1U;
+				endpoints.mBits[1U] = bits >> 1U;
+				for (std::uint32_t c = 0U; c < 4U; ++c) {
+					endpoints.mColors[0U][c] = Quantize(endpoint0[c] - static_cast<float>(endpoints.mBits[0U]), 127U, 0.5f);
+					endpoints.mColors[1U][c] = Quantize(endpoint1[c] - static_cast<float>(endpoints.mBits[1U]), 127U, 0.5f);
+				}
+
+				Palette palette;
+				ComputeBC7Palette(endpoints, palette);
+				std::uint8_t indices[sTexelCount];
+				const float error{ SelectIndices(channels, 4U, palette, indices) };
+				if (error < iterationError) {
+					iterationError = error;
+					std::memcpy(iterationIndices, indices, sizeof(indices));
+				}
+				if (error < bestError) {
+					bestError = error;
+					bestEndpoints = endpoints;
+					std::memcpy(bestIndices, indices, sizeof(indices));
+				}
+			}
+
+			float indexFractions[16U];
+			for (std::uint32_t i = 0U; i < 16U; ++i) {
+				indexFractions[i] = static_cast<float>(sBC7Weights[i]) / 64.0f;
+			}
+			if (bestError == 0.0f ||
+				iteration == sRefinementCount ||
+				RefineEndpoints(channels, 4U, iterationIndices, indexFractions, endpoint0, endpoint1) == false)
+			{
+				break;
+			}
+		}
+
+		// The most significant bit of the index of the first texel is not stored, so it must be zero
+		if (bestIndices[0U] >= 8U) {
+			std::swap(bestEndpoints.mColors[0U], bestEndpoints.mColors[1U]);
+			std::swap(bestEndpoints.mBits[0U], bestEndpoints.mBits[1U]);
+			for (std::uint32_t i = 0U; i < sTexelCount; ++i) {
+				bestIndices[i] = static_cast<std::uint8_t>(15U - bestIndices[i]);
+			}
+		}
+
+		std::memset(block, 0, 16UL);
+		BitWriter writer(block);
+		writer.Write(1U << 6U, 7U);
+		for (std::uint32_t c = 0U; c < 4U; ++c) {
+			writer.Write(bestEndpoints.mColors[0U][c], 7U);
+			writer.Write(bestEndpoints.mColors[1U][c], 7U);
+		}
+		writer.Write(bestEndpoints.mBits[0U], 1U);
+		writer.Write(bestEndpoints.mBits[1U], 1U);
+		writer.Write(bestIndices[0U], 3U);
+		for (std::uint32_t i = 1U; i < sTexelCount; ++i) {
+			writer.Write(bestIndices[i], 4U);
+		}
+	}
+
+	void DecompressBC7Block(const std::uint8_t* block, std::uint8_t* texels) noexcept {
+		BitReader reader(block);
+		const std::uint32_t modeBits{ reader.Read(7U) };
+		ASSERT(modeBits == (1U << 6U));
+		if (modeBits != (1U << 6U)) {
+			std::memset(texels, 0, sTexelCount * 4UL);
+			return;
+		}
+
+		BC7Endpoints endpoints;
+		for (std::uint32_t c = 0U; c < 4U; ++c) {
+			endpoints.mColors[0U][c] = reader.Read(7U);
+			endpoints.mColors[1U][c] = reader.Read(7U);
+		}
+		endpoints.mBits[0U] = reader.Read(1U);
+		endpoints.mBits[1U] = reader.Read(1U);
+
+		Palette palette;
+		ComputeBC7Palette(endpoints, palette);
+		for (std::uint32_t i = 0U; i < sTexelCount; ++i) {
+			const std::uint32_t index{ reader.Read(i == 0U ? 3U : 4U) };
+			for (std::uint32_t c = 0U; c < 4U; ++c) {
+				texels[i * 4U + c] = static_cast<std::uint8_t>(palette.mColors[index][c]);
+			}
+		}
+	}
+}
+
+namespace BlockCompressor {
+	std::size_t GetBlockSize(const Format format) noexcept {
+		return (format == Format::BC1 || format == Format::BC4) ? 8UL : 16UL;
+	}
+
+	DXGI_FORMAT GetDXGIFormat(const Format format, const bool isSRGB) noexcept {
+		switch (format) {
+		case Format::BC1:
+			return isSRGB ? DXGI_FORMAT_BC1_UNORM_SRGB : DXGI_FORMAT_BC1_UNORM;
+		case Format::BC3:
+			return isSRGB ? DXGI_FORMAT_BC3_UNORM_SRGB : DXGI_FORMAT_BC3_UNORM;
+		case Format::BC4:
+			return DXGI_FORMAT_BC4_UNORM;
+		case Format::BC5:
+			return DXGI_FORMAT_BC5_UNORM;
+		case Format::BC7:
+			return isSRGB ? DXGI_FORMAT_BC7_UNORM_SRGB : DXGI_FORMAT_BC7_UNORM;
+		default:
+			ASSERT(false);
+			return DXGI_FORMAT_UNKNOWN;
+		}
+	}
+
+	std::size_t GetCompressedSize(
+		const std::uint32_t width,
+		const std::uint32_t height,
+		const Format format) noexcept
+	{
+		const std::size_t blockColumnCount{ (width + sBlockDimension - 1U) / sBlockDimension };
+		const std::size_t blockRowCount{ (height + sBlockDimension - 1U) / sBlockDimension };
+
+		return blockColumnCount * blockRowCount * GetBlockSize(format);
+	}
+
+	void CompressBlock(
+		const std::uint8_t* texels,
+		const Format format,
+		std::uint8_t* block) noexcept
+	{
+		ASSERT(texels != nullptr);
+		ASSERT(block != nullptr);
+
+		switch (format) {
+		case Format::BC1:
+			CompressBC1Block(texels, false, block);
+			break;
+		case Format::BC3:
+		{
+			BlockChannels channels;
+			LoadBlockChannels(texels, channels);
+			CompressBC4Block(channels, 3U, block);
+			CompressBC1Block(texels, true, block + 8U);
+			break;
+		}
+		case Format::BC4:
+		case Format::BC5:
+		{
+			BlockChannels channels;
+			LoadBlockChannels(texels, channels);
+			CompressBC4Block(channels, 0U, block);
+			if (format == Format::BC5) {
+				CompressBC4Block(channels, 1U, block + 8U);
+			}
+			break;
+		}
+		case Format::BC7:
+			CompressBC7Block(texels, block);
+			break;
+		default:
+			ASSERT(false);
+			break;
+		}
+	}
+
+	void DecompressBlock(
+		const std::uint8_t* block,
+		const Format format,
+		std::uint8_t* texels) noexcept
+	{
+		ASSERT(block != nullptr);
+		ASSERT(texels != nullptr);
+
+		switch (format) {
+		case Format::BC1:
+			DecompressBC1Block(block, false, texels);
+			break;
+		case Format::BC3:
+			DecompressBC1Block(block + 8U, true, texels);
+			DecompressBC4Block(block, 3U, texels);
+			break;
+		case Format::BC4:
+		case Format::BC5:
+			for (std::uint32_t i = 0U; i < sTexelCount; ++i) {
+				texels[i * 4U + 1U] = 0U;
+				texels[i * 4U + 2U] = 0U;
+				texels[i * 4U + 3U] = 255U;
+			}
+			DecompressBC4Block(block, 0U, texels);
+			if (format == Format::BC5) {
+				DecompressBC4Block(block + 8U, 1U, texels);
+			}
+			break;
+		case Format::BC7:
+			DecompressBC7Block(block, texels);
+			break;
+		default:
+			ASSERT(false);
+			break;
+		}
+	}
+
+	void CompressImage(
+		const std::uint8_t* texels,
+		const std::uint32_t width,
+		const std::uint32_t height,
+		const std::size_t rowPitch,
+		const Format format,
+		std::uint8_t* blocks) noexcept
+	{
+		ASSERT(texels != nullptr);
+		ASSERT(blocks != nullptr);
+		ASSERT(rowPitch >= 4UL * width);
+
+		const std::uint32_t blockColumnCount{ (width + sBlockDimension - 1U) / sBlockDimension };
+		const std::uint32_t blockRowCount{ (height + sBlockDimension - 1U) / sBlockDimension };
+		const std::size_t blockSize{ GetBlockSize(format) };
+
+		tbb::parallel_for(tbb::blocked_range<std::uint32_t>(0U, blockRowCount),
+			[&](const tbb::blocked_range<std::uint32_t>& range) {
+			std::uint8_t blockTexels[sTexelCount * 4U];
+			for (std::uint32_t blockRow = range.begin(); blockRow != range.end(); ++blockRow) {
+				for (std::uint32_t blockColumn = 0U; blockColumn < blockColumnCount; ++blockColumn) {
+					for (std::uint32_t y = 0U; y < sBlockDimension; ++y) {
+						const std::uint32_t row{ std::min<std::uint32_t>(blockRow * sBlockDimension + y, height - 1U) };
+						for (std::uint32_t x = 0U; x < sBlockDimension; ++x) {
+							const std::uint32_t column{ std::min<std::uint32_t>(blockColumn * sBlockDimension + x, width - 1U) };
+							std::memcpy(blockTexels + (y * sBlockDimension + x) * 4U, texels + row * rowPitch + column * 4UL, 4UL);
+						}
+					}
+
+					CompressBlock(blockTexels, format, blocks + (blockRow * blockColumnCount + blockColumn) * blockSize);
+				}
+			}
+		});
+	}
+
+	void DecompressImage(
+		const std::uint8_t* blocks,
+		const std::uint32_t width,
+		const std::uint32_t height,
+		const Format format,
+		std::uint8_t* texels) noexcept
+	{
+		ASSERT(blocks != nullptr);
+		ASSERT(texels != nullptr);
+
+		const std::uint32_t blockColumnCount{ (width + sBlockDimension - 1U) / sBlockDimension };
+		const std::uint32_t blockRowCount{ (height + sBlockDimension - 1U) / sBlockDimension };
+		const std::size_t blockSize{ GetBlockSize(format) };
+
+		std::uint8_t blockTexels[sTexelCount * 4U];
+		for (std::uint32_t blockRow = 0U; blockRow < blockRowCount; ++blockRow) {
+			for (std::uint32_t blockColumn = 0U; blockColumn < blockColumnCount; ++blockColumn) {
+				DecompressBlock(blocks + (blockRow * blockColumnCount + blockColumn) * blockSize, format, blockTexels);
+
+				// Texels out of the image are not copied
+				for (std::uint32_t y = 0U; y < sBlockDimension; ++y) {
+					const std::uint32_t row{ blockRow * sBlockDimension + y };
+					for (std::uint32_t x = 0U; x < sBlockDimension; ++x) {
+						const std::uint32_t column{ blockColumn * sBlockDimension + x };
+						if (row < height && column < width) {
+							std::memcpy(texels + (static_cast<std::size_t>(row) * width + column) * 4UL, blockTexels + (y * sBlockDimension + x) * 4U, 4UL);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	float ComputePSNR(
+		const std::uint8_t* texels,
+		const std::uint8_t* otherTexels,
+		const std::size_t texelCount,
+		const Format format) noexcept
+	{
+		ASSERT(texels != nullptr);
+		ASSERT(otherTexels != nullptr);
+
+		std::uint32_t channelCount{ 4U };
+		switch (format) {
+		case Format::BC1:
+			channelCount = 3U;
+			break;
+		case Format::BC4:
+			channelCount = 1U;
+			break;
+		case Format::BC5:
+			channelCount = 2U;
+			break;
+		default:
+			break;
+		}
+
+		double squaredError{ 0.0 };
+		for (std::size_t i = 0UL; i < texelCount; ++i) {
+			for (std::uint32_t c = 0U; c < channelCount; ++c) {
+				const double difference{ static_cast<double>(texels[i * 4UL + c]) - static_cast<double>(otherTexels[i * 4UL + c]) };
+				squaredError += difference * difference;
+			}
+		}
+
+		if (squaredError == 0.0) {
+			return std::numeric_limits<float>::infinity();
+		}
+
+		const double meanSquaredError{ squaredError / static_cast<double>(texelCount * channelCount) };
+
+		return static_cast<float>(10.0 * std::log10(255.0 * 255.0 / meanSquaredError));
+	}
+}
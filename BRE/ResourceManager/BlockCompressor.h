@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <dxgiformat.h>
+
+// To compress RGBA8 images to block compressed formats (blocks of 4x4 texels), and to decompress them.
+// - BC1: RGB, 8 bytes per block. Texels whose alpha is less than 128 are transparent.
+// - BC3: RGBA, 16 bytes per block (BC4 alpha and BC1 color).
+// - BC4: R, 8 bytes per block. It is used for height maps.
+// - BC5: RG, 16 bytes per block (two BC4 blocks). It is used for normal maps (z is computed in shaders).
+// - BC7: RGBA, 16 bytes per block. Only mode 6 (a single subset, with 7 bits endpoints,
+//   a bit per endpoint and 4 bits indices) is compressed and decompressed.
+// Endpoints are fitted to the principal axis of the texels of the block, and refined by least squares.
+// Indices of the texels are selected 4 texels at a time with SSE2, and rows of blocks are compressed in parallel (TBB).
+namespace BlockCompressor {
+	enum class Format {
+		BC1 = 0,
+		BC3,
+		BC4,
+		BC5,
+		BC7
+	};
+
+	// Width and height of a block
+	const std::uint32_t sBlockDimension{ 4U };
+
+	// Size in bytes of a block
+	std::size_t GetBlockSize(const Format format) noexcept;
+
+	// Returns the sRGB format if "isSRGB" is true and the format has it
+	DXGI_FORMAT GetDXGIFormat(const Format format, const bool isSRGB) noexcept;
+
+	// Size in bytes of an image of "width" x "height" texels (partial blocks are whole blocks)
+	std::size_t GetCompressedSize(
+		const std::uint32_t width,
+		const std::uint32_t height,
+		const Format format) noexcept;
+
+	// "texels" are the 16 RGBA8 texels of the block, row by row.
+	// Preconditions:
+	// - "texels" and "block" must not be nullptr
+	void CompressBlock(
+		const std::uint8_t* texels,
+		const Format format,
+		std::uint8_t* block) noexcept;
+
+	// Channels that the format does not store are zero (alpha is 255).
+	// Preconditions:
+	// - "block" and "texels" must not be nullptr
+	// - BC7 blocks must be mode 6 blocks
+	void DecompressBlock(
+		const std::uint8_t* block,
+		const Format format,
+		std::uint8_t* texels) noexcept;
+
+	// Compresses an RGBA8 image whose rows are "rowPitch" bytes. Blocks on the right and bottom edges
+	// repeat the last column and row of the image. "blocks" must have GetCompressedSize() bytes.
+	// Preconditions:
+	// - "texels" and "blocks" must not be nullptr
+	// - "rowPitch" must be at least 4 * "width"
+	void CompressImage(
+		const std::uint8_t* texels,
+		const std::uint32_t width,
+		const std::uint32_t height,
+		const std::size_t rowPitch,
+		const Format format,
+		std::uint8_t* blocks) noexcept;
+
+	// Decompresses an image to RGBA8 texels (4 * "width" bytes per row)
+	// Preconditions:
+	// - "blocks" and "texels" must not be nullptr
+	void DecompressImage(
+		const std::uint8_t* blocks,
+		const std::uint32_t width,
+		const std::uint32_t height,
+		const Format format,
+		std::uint8_t* texels) noexcept;
+
+	// Peak signal to noise ratio (in decibels) between two RGBA8 images, of the channels that the format stores.
+	// It is infinite if the images are equal.
+	// Preconditions:
+	// - "texels" and "otherTexels" must not be nullptr
+	float ComputePSNR(
+		const std::uint8_t* texels,
+		const std::uint8_t* otherTexels,
+		const std::size_t texelCount,
+		const Format format) noexcept;
+}
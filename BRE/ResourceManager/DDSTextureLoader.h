@@ -59,12 +59,14 @@ namespace DirectX
                                         _Out_opt_ DDS_ALPHA_MODE* alphaMode = nullptr
                                       ) noexcept;
 
+	// D3D12 textures are created in D3D12_RESOURCE_STATE_COMMON state, and their data is uploaded 
+	// by TransferManager directly from "ddsData" (for example, a MemoryMappedFile), without copying it.
+	// Headers are parsed by DDSTextureParser. Missing mips of 2D textures and cube maps
+	// are generated with a box filter (see MipGenerator) if their format is supported.
 	HRESULT CreateDDSTextureFromMemory12(_In_ ID3D12Device* device,
-		                                 _In_ ID3D12GraphicsCommandList* cmdList,
 		                                 _In_reads_bytes_(ddsDataSize) const uint8_t* ddsData,
 		                                 _In_ std::size_t ddsDataSize,
 		                                 _Out_ Microsoft::WRL::ComPtr<ID3D12Resource>& texture,
-		                                 _Out_ Microsoft::WRL::ComPtr<ID3D12Resource>& textureUploadHeap,
 		                                 _In_ std::size_t maxsize = 0,
 		                                 _Out_opt_ DDS_ALPHA_MODE* alphaMode = nullptr
 		                                 ) noexcept;
@@ -77,15 +79,6 @@ namespace DirectX
                                       _Out_opt_ DDS_ALPHA_MODE* alphaMode = nullptr
                                     ) noexcept;
 
-	HRESULT CreateDDSTextureFromFile12(_In_ ID3D12Device* device,
-		                               _In_ ID3D12GraphicsCommandList* cmdList,
-		                               _In_z_ const wchar_t* szFileName,
-		                               _Out_ Microsoft::WRL::ComPtr<ID3D12Resource>& texture,
-		                               _Out_ Microsoft::WRL::ComPtr<ID3D12Resource>& textureUploadHeap,
-		                               _In_ std::size_t maxsize = 0,
-		                               _Out_opt_ DDS_ALPHA_MODE* alphaMode = nullptr
-		                               ) noexcept;
-
     // Standard version with optional auto-gen mipmap support
     HRESULT CreateDDSTextureFromMemory( _In_ ID3D11Device* d3dDevice,
                                         _In_opt_ ID3D11DeviceContext* d3dContext,
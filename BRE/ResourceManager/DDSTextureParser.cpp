@@ -0,0 +1,804 @@
+//--------------------------------------------------------------------------------------
+// File: DDSTextureParser.cpp
+//
+// DDS file structures and parsing functions of DDSTextureLoader, that do not depend on Direct3D
+//
+// THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+// PARTICULAR PURPOSE.
+//
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// http://go.microsoft.com/fwlink/?LinkId=248926
+// http://go.microsoft.com/fwlink/?LinkId=248929
+//--------------------------------------------------------------------------------------
+
+#include "DDSTextureParser.h"
+
+#include <algorithm>
+#include <assert.h>
+#include <tbb/parallel_for.h>
+
+#include <Utils/DebugUtils.h>
+
+namespace {
+	// Values of D3D11_RESOURCE_DIMENSION and D3D11_RESOURCE_MISC_FLAG used by the DX10 header
+	const std::uint32_t sResourceDimensionTexture1D{ 2U };
+	const std::uint32_t sResourceDimensionTexture2D{ 3U };
+	const std::uint32_t sResourceDimensionTexture3D{ 4U };
+	const std::uint32_t sResourceMiscTextureCube{ 0x4U };
+
+	// Minimum number of array slices per task of ComputeSubresourceLayouts()
+	const std::uint32_t sArraySliceGrainSize{ 64U };
+
+	DDSTextureParser::Result CheckDimensions(
+		const DDSTextureParser::Dimension dimension,
+		const std::uint32_t width,
+		const std::uint32_t height,
+		const std::uint32_t depth,
+		const std::uint32_t arraySize) noexcept
+	{
+		bool isSupported{ false };
+		switch (dimension) {
+		case DDSTextureParser::Dimension::TEXTURE1D:
+			isSupported =
+				arraySize <= DDSTextureParser::sMaxArraySize &&
+				width <= DDSTextureParser::sMaxTexture1DDimension;
+			break;
+		case DDSTextureParser::Dimension::TEXTURE2D:
+			// Array size of cube maps includes their 6 faces
+			isSupported =
+				arraySize <= DDSTextureParser::sMaxArraySize &&
+				width <= DDSTextureParser::sMaxTexture2DDimension &&
+				height <= DDSTextureParser::sMaxTexture2DDimension;
+			break;
+		case DDSTextureParser::Dimension::TEXTURE3D:
+			isSupported =
+				arraySize == 1U &&
+				width <= DDSTextureParser::sMaxTexture3DDimension &&
+				height <= DDSTextureParser::sMaxTexture3DDimension &&
+				depth <= DDSTextureParser::sMaxTexture3DDimension;
+			break;
+		default:
+			break;
+		}
+
+		return isSupported ? DDSTextureParser::Result::SUCCESS : DDSTextureParser::Result::NOT_SUPPORTED;
+	}
+
+	// Number of mips of a texture with all its mips: floor(log2(max(width, height, depth))) + 1
+	std::uint32_t GetFullMipCount(
+		const std::uint32_t width,
+		const std::uint32_t height,
+		const std::uint32_t depth) noexcept
+	{
+		std::uint32_t maxDimension{ std::max(std::max(width, height), depth) };
+		std::uint32_t mipCount{ 1U };
+		while (maxDimension > 1U) {
+			maxDimension >>= 1U;
+			++mipCount;
+		}
+
+		return mipCount;
+	}
+}
+
+DDSTextureParser::Result DDSTextureParser::ParseHeader(
+	const std::uint8_t* data,
+	const std::size_t dataSize,
+	TextureInfo& textureInfo) noexcept
+{
+	ASSERT(data != nullptr);
+
+	textureInfo = TextureInfo();
+
+	if (dataSize < sizeof(std::uint32_t) + sizeof(DDS_HEADER)) {
+		return Result::INVALID_DATA;
+	}
+
+	const std::uint32_t magicNumber{ *reinterpret_cast<const std::uint32_t*>(data) };
+	if (magicNumber != DDS_MAGIC) {
+		return Result::INVALID_DATA;
+	}
+
+	const DDS_HEADER* header{ reinterpret_cast<const DDS_HEADER*>(data + sizeof(std::uint32_t)) };
+	if (header->size != sizeof(DDS_HEADER) || header->ddspf.size != sizeof(DDS_PIXELFORMAT)) {
+		return Result::INVALID_DATA;
+	}
+
+	std::size_t dataOffset{ sizeof(std::uint32_t) + sizeof(DDS_HEADER) };
+	Dimension dimension{ Dimension::TEXTURE2D };
+	std::uint32_t width{ header->width };
+	std::uint32_t height{ header->height };
+	std::uint32_t depth{ header->depth };
+	std::uint32_t arraySize{ 1U };
+	const std::uint32_t mipCount{ header->mipMapCount == 0U ? 1U : header->mipMapCount };
+	DXGI_FORMAT format{ DXGI_FORMAT_UNKNOWN };
+	bool isCubeMap{ false };
+
+	if ((header->ddspf.flags & DDS_FOURCC) && (MAKEFOURCC('D', 'X', '1', '0') == header->ddspf.fourCC)) {
+		// Must be long enough for both headers and magic value
+		if (dataSize < dataOffset + sizeof(DDS_HEADER_DXT10)) {
+			return Result::INVALID_DATA;
+		}
+
+		const DDS_HEADER_DXT10* d3d10ext{ reinterpret_cast<const DDS_HEADER_DXT10*>(data + dataOffset) };
+		dataOffset += sizeof(DDS_HEADER_DXT10);
+
+		arraySize = d3d10ext->arraySize;
+		if (arraySize == 0U) {
+			return Result::INVALID_DATA;
+		}
+
+		format = d3d10ext->dxgiFormat;
+		switch (format) {
+		case DXGI_FORMAT_AI44:
+		case DXGI_FORMAT_IA44:
+		case DXGI_FORMAT_P8:
+		case DXGI_FORMAT_A8P8:
+			return Result::NOT_SUPPORTED;
+		default:
+			if (BitsPerPixel(format) == 0UL) {
+				return Result::NOT_SUPPORTED;
+			}
+		}
+
+		switch (d3d10ext->resourceDimension) {
+		case sResourceDimensionTexture1D:
+			if ((header->flags & DDS_HEIGHT) && height != 1U) {
+				return Result::INVALID_DATA;
+			}
+			dimension = Dimension::TEXTURE1D;
+			height = 1U;
+			depth = 1U;
+			break;
+		case sResourceDimensionTexture2D:
+			if (d3d10ext->miscFlag & sResourceMiscTextureCube) {
+				arraySize *= 6U;
+				isCubeMap = true;
+			}
+			dimension = Dimension::TEXTURE2D;
+			depth = 1U;
+			break;
+		case sResourceDimensionTexture3D:
+			if ((header->flags & DDS_HEADER_FLAGS_VOLUME) == 0U) {
+				return Result::INVALID_DATA;
+			}
+			dimension = Dimension::TEXTURE3D;
+			break;
+		default:
+			return Result::NOT_SUPPORTED;
+		}
+	} else {
+		format = GetDXGIFormat(header->ddspf);
+		if (format == DXGI_FORMAT_UNKNOWN) {
+			return Result::NOT_SUPPORTED;
+		}
+
+		if (header->flags & DDS_HEADER_FLAGS_VOLUME) {
+			dimension = Dimension::TEXTURE3D;
+		} else {
+			if (header->caps2 & DDS_CUBEMAP) {
+				if ((header->caps2 & DDS_CUBEMAP_ALLFACES) != DDS_CUBEMAP_ALLFACES) {
+					return Result::NOT_SUPPORTED;
+				}
+				arraySize = 6U;
+				isCubeMap = true;
+			}
+
+			dimension = Dimension::TEXTURE2D;
+			depth = 1U;
+		}
+	}
+
+	// Files with values greater than the hardware limits are not trusted
+	if (mipCount > sMaxMipCount) {
+		return Result::NOT_SUPPORTED;
+	}
+
+	const Result result{ CheckDimensions(dimension, width, height, depth, arraySize) };
+	if (result != Result::SUCCESS) {
+		return result;
+	}
+
+	// Mips after the 1 x 1 x 1 one do not exist
+	if (mipCount > GetFullMipCount(width, height, depth)) {
+		return Result::INVALID_DATA;
+	}
+
+	textureInfo.mDimension = dimension;
+	textureInfo.mWidth = width;
+	textureInfo.mHeight = height;
+	textureInfo.mDepth = depth;
+	textureInfo.mArraySize = arraySize;
+	textureInfo.mMipCount = mipCount;
+	textureInfo.mFormat = format;
+	textureInfo.mIsCubeMap = isCubeMap;
+	textureInfo.mDataOffset = dataOffset;
+
+	return Result::SUCCESS;
+}
+
+DDSTextureParser::Result DDSTextureParser::ComputeSubresourceLayouts(
+	const TextureInfo& textureInfo,
+	const std::size_t maxSize,
+	const std::size_t dataSize,
+	SubresourceLayout* layouts,
+	std::uint32_t& skippedMipCount,
+	std::uint32_t& width,
+	std::uint32_t& height,
+	std::uint32_t& depth) noexcept
+{
+	ASSERT(textureInfo.mMipCount > 0U);
+	ASSERT(layouts != nullptr);
+
+	skippedMipCount = 0U;
+	width = 0U;
+	height = 0U;
+	depth = 0U;
+
+	// Layouts of the mips of the first array slice
+	const std::uint32_t mipCount{ textureInfo.mMipCount };
+	std::uint32_t mipLayoutCount{ 0U };
+	std::size_t offset{ textureInfo.mDataOffset };
+	std::size_t w{ textureInfo.mWidth };
+	std::size_t h{ textureInfo.mHeight };
+	std::size_t d{ textureInfo.mDepth };
+	for (std::uint32_t i = 0U; i < mipCount; ++i) {
+		std::size_t numBytes{ 0UL };
+		std::size_t rowBytes{ 0UL };
+		GetSurfaceInfo(w, h, textureInfo.mFormat, &numBytes, &rowBytes, nullptr);
+
+		if (mipCount <= 1U || maxSize == 0UL || (w <= maxSize && h <= maxSize && d <= maxSize)) {
+			if (mipLayoutCount == 0U) {
+				width = static_cast<std::uint32_t>(w);
+				height = static_cast<std::uint32_t>(h);
+				depth = static_cast<std::uint32_t>(d);
+			}
+
+			SubresourceLayout& layout{ layouts[mipLayoutCount] };
+			layout.mOffset = offset;
+			layout.mRowPitch = rowBytes;
+			layout.mSlicePitch = numBytes;
+			layout.mSize = numBytes * d;
+			++mipLayoutCount;
+		} else {
+			++skippedMipCount;
+		}
+
+		offset += numBytes * d;
+
+		w = std::max<std::size_t>(w >> 1UL, 1UL);
+		h = std::max<std::size_t>(h >> 1UL, 1UL);
+		d = std::max<std::size_t>(d >> 1UL, 1UL);
+	}
+
+	if (mipLayoutCount == 0U) {
+		return Result::INVALID_DATA;
+	}
+
+	// All the array slices have the same size, so the file must include
+	// "arraySize" slices (this form of the comparison does not overflow).
+	const std::uint32_t arraySize{ textureInfo.mArraySize };
+	const std::size_t sliceSize{ offset - textureInfo.mDataOffset };
+	if (dataSize < textureInfo.mDataOffset || sliceSize > (dataSize - textureInfo.mDataOffset) / arraySize) {
+		return Result::END_OF_FILE;
+	}
+
+	// Layouts of the other array slices are the ones of the first slice, displaced by the slice size
+	tbb::parallel_for(tbb::blocked_range<std::uint32_t>(1U, arraySize, sArraySliceGrainSize),
+		[&](const tbb::blocked_range<std::uint32_t>& range) {
+		for (std::uint32_t j = range.begin(); j != range.end(); ++j) {
+			SubresourceLayout* sliceLayouts{ layouts + j * mipLayoutCount };
+			for (std::uint32_t i = 0U; i < mipLayoutCount; ++i) {
+				sliceLayouts[i] = layouts[i];
+				sliceLayouts[i].mOffset += j * sliceSize;
+			}
+		}
+	});
+
+	return Result::SUCCESS;
+}
+
+//--------------------------------------------------------------------------------------
+// Return the BPP for a particular format
+//--------------------------------------------------------------------------------------
+std::size_t DDSTextureParser::BitsPerPixel( DXGI_FORMAT fmt ) noexcept
+{
+    switch( fmt )
+    {
+    case DXGI_FORMAT_R32G32B32A32_TYPELESS:
+    case DXGI_FORMAT_R32G32B32A32_FLOAT:
+    case DXGI_FORMAT_R32G32B32A32_UINT:
+    case DXGI_FORMAT_R32G32B32A32_SINT:
+        return 128;
+
+    case DXGI_FORMAT_R32G32B32_TYPELESS:
+    case DXGI_FORMAT_R32G32B32_FLOAT:
+    case DXGI_FORMAT_R32G32B32_UINT:
+    case DXGI_FORMAT_R32G32B32_SINT:
+        return 96;
+
+    case DXGI_FORMAT_R16G16B16A16_TYPELESS:
+    case DXGI_FORMAT_R16G16B16A16_FLOAT:
+    case DXGI_FORMAT_R16G16B16A16_UNORM:
+    case DXGI_FORMAT_R16G16B16A16_UINT:
+    case DXGI_FORMAT_R16G16B16A16_SNORM:
+    case DXGI_FORMAT_R16G16B16A16_SINT:
+    case DXGI_FORMAT_R32G32_TYPELESS:
+    case DXGI_FORMAT_R32G32_FLOAT:
+    case DXGI_FORMAT_R32G32_UINT:
+    case DXGI_FORMAT_R32G32_SINT:
+    case DXGI_FORMAT_R32G8X24_TYPELESS:
+    case DXGI_FORMAT_D32_FLOAT_S8X24_UINT:
+    case DXGI_FORMAT_R32_FLOAT_X8X24_TYPELESS:
+    case DXGI_FORMAT_X32_TYPELESS_G8X24_UINT:
+    case DXGI_FORMAT_Y416:
+    case DXGI_FORMAT_Y210:
+    case DXGI_FORMAT_Y216:
+        return 64;
+
+    case DXGI_FORMAT_R10G10B10A2_TYPELESS:
+    case DXGI_FORMAT_R10G10B10A2_UNORM:
+    case DXGI_FORMAT_R10G10B10A2_UINT:
+    case DXGI_FORMAT_R11G11B10_FLOAT:
+    case DXGI_FORMAT_R8G8B8A8_TYPELESS:
+    case DXGI_FORMAT_R8G8B8A8_UNORM:
+    case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+    case DXGI_FORMAT_R8G8B8A8_UINT:
+    case DXGI_FORMAT_R8G8B8A8_SNORM:
+    case DXGI_FORMAT_R8G8B8A8_SINT:
+    case DXGI_FORMAT_R16G16_TYPELESS:
+    case DXGI_FORMAT_R16G16_FLOAT:
+    case DXGI_FORMAT_R16G16_UNORM:
+    case DXGI_FORMAT_R16G16_UINT:
+    case DXGI_FORMAT_R16G16_SNORM:
+    case DXGI_FORMAT_R16G16_SINT:
+    case DXGI_FORMAT_R32_TYPELESS:
+    case DXGI_FORMAT_D32_FLOAT:
+    case DXGI_FORMAT_R32_FLOAT:
+    case DXGI_FORMAT_R32_UINT:
+    case DXGI_FORMAT_R32_SINT:
+    case DXGI_FORMAT_R24G8_TYPELESS:
+    case DXGI_FORMAT_D24_UNORM_S8_UINT:
+    case DXGI_FORMAT_R24_UNORM_X8_TYPELESS:
+    case DXGI_FORMAT_X24_TYPELESS_G8_UINT:
+    case DXGI_FORMAT_R9G9B9E5_SHAREDEXP:
+    case DXGI_FORMAT_R8G8_B8G8_UNORM:
+    case DXGI_FORMAT_G8R8_G8B8_UNORM:
+    case DXGI_FORMAT_B8G8R8A8_UNORM:
+    case DXGI_FORMAT_B8G8R8X8_UNORM:
+    case DXGI_FORMAT_R10G10B10_XR_BIAS_A2_UNORM:
+    case DXGI_FORMAT_B8G8R8A8_TYPELESS:
+    case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+    case DXGI_FORMAT_B8G8R8X8_TYPELESS:
+    case DXGI_FORMAT_B8G8R8X8_UNORM_SRGB:
+    case DXGI_FORMAT_AYUV:
+    case DXGI_FORMAT_Y410:
+    case DXGI_FORMAT_YUY2:
+        return 32;
+
+    case DXGI_FORMAT_P010:
+    case DXGI_FORMAT_P016:
+        return 24;
+
+    case DXGI_FORMAT_R8G8_TYPELESS:
+    case DXGI_FORMAT_R8G8_UNORM:
+    case DXGI_FORMAT_R8G8_UINT:
+    case DXGI_FORMAT_R8G8_SNORM:
+    case DXGI_FORMAT_R8G8_SINT:
+    case DXGI_FORMAT_R16_TYPELESS:
+    case DXGI_FORMAT_R16_FLOAT:
+    case DXGI_FORMAT_D16_UNORM:
+    case DXGI_FORMAT_R16_UNORM:
+    case DXGI_FORMAT_R16_UINT:
+    case DXGI_FORMAT_R16_SNORM:
+    case DXGI_FORMAT_R16_SINT:
+    case DXGI_FORMAT_B5G6R5_UNORM:
+    case DXGI_FORMAT_B5G5R5A1_UNORM:
+    case DXGI_FORMAT_A8P8:
+    case DXGI_FORMAT_B4G4R4A4_UNORM:
+        return 16;
+
+    case DXGI_FORMAT_NV12:
+    case DXGI_FORMAT_420_OPAQUE:
+    case DXGI_FORMAT_NV11:
+        return 12;
+
+    case DXGI_FORMAT_R8_TYPELESS:
+    case DXGI_FORMAT_R8_UNORM:
+    case DXGI_FORMAT_R8_UINT:
+    case DXGI_FORMAT_R8_SNORM:
+    case DXGI_FORMAT_R8_SINT:
+    case DXGI_FORMAT_A8_UNORM:
+    case DXGI_FORMAT_AI44:
+    case DXGI_FORMAT_IA44:
+    case DXGI_FORMAT_P8:
+        return 8;
+
+    case DXGI_FORMAT_R1_UNORM:
+        return 1;
+
+    case DXGI_FORMAT_BC1_TYPELESS:
+    case DXGI_FORMAT_BC1_UNORM:
+    case DXGI_FORMAT_BC1_UNORM_SRGB:
+    case DXGI_FORMAT_BC4_TYPELESS:
+    case DXGI_FORMAT_BC4_UNORM:
+    case DXGI_FORMAT_BC4_SNORM:
+        return 4;
+
+    case DXGI_FORMAT_BC2_TYPELESS:
+    case DXGI_FORMAT_BC2_UNORM:
+    case DXGI_FORMAT_BC2_UNORM_SRGB:
+    case DXGI_FORMAT_BC3_TYPELESS:
+    case DXGI_FORMAT_BC3_UNORM:
+    case DXGI_FORMAT_BC3_UNORM_SRGB:
+    case DXGI_FORMAT_BC5_TYPELESS:
+    case DXGI_FORMAT_BC5_UNORM:
+    case DXGI_FORMAT_BC5_SNORM:
+    case DXGI_FORMAT_BC6H_TYPELESS:
+    case DXGI_FORMAT_BC6H_UF16:
+    case DXGI_FORMAT_BC6H_SF16:
+    case DXGI_FORMAT_BC7_TYPELESS:
+    case DXGI_FORMAT_BC7_UNORM:
+    case DXGI_FORMAT_BC7_UNORM_SRGB:
+        return 8;
+
+    default:
+        return 0;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------
+// Get surface information for a particular format
+//--------------------------------------------------------------------------------------
+void DDSTextureParser::GetSurfaceInfo( std::size_t width,
+                                       std::size_t height,
+                                       DXGI_FORMAT fmt,
+                                       std::size_t* outNumBytes,
+                                       std::size_t* outRowBytes,
+                                       std::size_t* outNumRows ) noexcept
+{
+    std::size_t numBytes;
+    std::size_t rowBytes;
+    std::size_t numRows;
+
+    bool bc = false;
+    bool packed = false;
+    bool planar = false;
+    std::size_t bpe = 0;
+    switch (fmt)
+    {
+    case DXGI_FORMAT_BC1_TYPELESS:
+    case DXGI_FORMAT_BC1_UNORM:
+    case DXGI_FORMAT_BC1_UNORM_SRGB:
+    case DXGI_FORMAT_BC4_TYPELESS:
+    case DXGI_FORMAT_BC4_UNORM:
+    case DXGI_FORMAT_BC4_SNORM:
+        bc=true;
+        bpe = 8;
+        break;
+
+    case DXGI_FORMAT_BC2_TYPELESS:
+    case DXGI_FORMAT_BC2_UNORM:
+    case DXGI_FORMAT_BC2_UNORM_SRGB:
+    case DXGI_FORMAT_BC3_TYPELESS:
+    case DXGI_FORMAT_BC3_UNORM:
+    case DXGI_FORMAT_BC3_UNORM_SRGB:
+    case DXGI_FORMAT_BC5_TYPELESS:
+    case DXGI_FORMAT_BC5_UNORM:
+    case DXGI_FORMAT_BC5_SNORM:
+    case DXGI_FORMAT_BC6H_TYPELESS:
+    case DXGI_FORMAT_BC6H_UF16:
+    case DXGI_FORMAT_BC6H_SF16:
+    case DXGI_FORMAT_BC7_TYPELESS:
+    case DXGI_FORMAT_BC7_UNORM:
+    case DXGI_FORMAT_BC7_UNORM_SRGB:
+        bc = true;
+        bpe = 16;
+        break;
+
+    case DXGI_FORMAT_R8G8_B8G8_UNORM:
+    case DXGI_FORMAT_G8R8_G8B8_UNORM:
+    case DXGI_FORMAT_YUY2:
+        packed = true;
+        bpe = 4;
+        break;
+
+    case DXGI_FORMAT_Y210:
+    case DXGI_FORMAT_Y216:
+        packed = true;
+        bpe = 8;
+        break;
+
+    case DXGI_FORMAT_NV12:
+    case DXGI_FORMAT_420_OPAQUE:
+        planar = true;
+        bpe = 2;
+        break;
+
+    case DXGI_FORMAT_P010:
+    case DXGI_FORMAT_P016:
+        planar = true;
+        bpe = 4;
+        break;
+	default:
+		break;
+    }
+
+    if (bc)
+    {
+        std::size_t numBlocksWide = 0;
+        if (width > 0)
+        {
+            numBlocksWide = std::max<std::size_t>( 1, (width + 3) / 4 );
+        }
+        std::size_t numBlocksHigh = 0;
+        if (height > 0)
+        {
+            numBlocksHigh = std::max<std::size_t>( 1, (height + 3) / 4 );
+        }
+        rowBytes = numBlocksWide * bpe;
+        numRows = numBlocksHigh;
+        numBytes = rowBytes * numBlocksHigh;
+    }
+    else if (packed)
+    {
+        rowBytes = ( ( width + 1 ) >> 1 ) * bpe;
+        numRows = height;
+        numBytes = rowBytes * height;
+    }
+    else if ( fmt == DXGI_FORMAT_NV11 )
+    {
+        rowBytes = ( ( width + 3 ) >> 2 ) * 4;
+        numRows = height * 2; // Direct3D makes this simplifying assumption, although it is larger than the 4:1:1 data
+        numBytes = rowBytes * numRows;
+    }
+    else if (planar)
+    {
+        rowBytes = ( ( width + 1 ) >> 1 ) * bpe;
+        numBytes = ( rowBytes * height ) + ( ( rowBytes * height + 1 ) >> 1 );
+        numRows = height + ( ( height + 1 ) >> 1 );
+    }
+    else
+    {
+        std::size_t bpp = BitsPerPixel( fmt );
+        rowBytes = ( width * bpp + 7 ) / 8; // round up to nearest byte
+        numRows = height;
+        numBytes = rowBytes * height;
+    }
+
+    if (outNumBytes)
+    {
+        *outNumBytes = numBytes;
+    }
+    if (outRowBytes)
+    {
+        *outRowBytes = rowBytes;
+    }
+    if (outNumRows)
+    {
+        *outNumRows = numRows;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------
+#define ISBITMASK( r,g,b,a ) ( ddpf.RBitMask == r && ddpf.GBitMask == g && ddpf.BBitMask == b && ddpf.ABitMask == a )
+
+DXGI_FORMAT DDSTextureParser::GetDXGIFormat( const DDS_PIXELFORMAT& ddpf ) noexcept
+{
+    if (ddpf.flags & DDS_RGB)
+    {
+        // Note that sRGB formats are written using the "DX10" extended header
+
+        switch (ddpf.RGBBitCount)
+        {
+        case 32:
+            if (ISBITMASK(0x000000ff,0x0000ff00,0x00ff0000,0xff000000))
+            {
+                return DXGI_FORMAT_R8G8B8A8_UNORM;
+            }
+
+            if (ISBITMASK(0x00ff0000,0x0000ff00,0x000000ff,0xff000000))
+            {
+                return DXGI_FORMAT_B8G8R8A8_UNORM;
+            }
+
+            if (ISBITMASK(0x00ff0000,0x0000ff00,0x000000ff,0x00000000))
+            {
+                return DXGI_FORMAT_B8G8R8X8_UNORM;
+            }
+
+            // No DXGI format maps to ISBITMASK(0x000000ff,0x0000ff00,0x00ff0000,0x00000000) aka D3DFMT_X8B8G8R8
+
+            // Note that many common DDS reader/writers (including D3DX) swap the
+            // the RED/BLUE masks for 10:10:10:2 formats. We assume
+            // below that the 'backwards' header mask is being used since it is most
+            // likely written by D3DX. The more robust solution is to use the 'DX10'
+            // header extension and specify the DXGI_FORMAT_R10G10B10A2_UNORM format directly
+
+            // For 'correct' writers, this should be 0x000003ff,0x000ffc00,0x3ff00000 for RGB data
+            if (ISBITMASK(0x3ff00000,0x000ffc00,0x000003ff,0xc0000000))
+            {
+                return DXGI_FORMAT_R10G10B10A2_UNORM;
+            }
+
+            // No DXGI format maps to ISBITMASK(0x000003ff,0x000ffc00,0x3ff00000,0xc0000000) aka D3DFMT_A2R10G10B10
+
+            if (ISBITMASK(0x0000ffff,0xffff0000,0x00000000,0x00000000))
+            {
+                return DXGI_FORMAT_R16G16_UNORM;
+            }
+
+            if (ISBITMASK(0xffffffff,0x00000000,0x00000000,0x00000000))
+            {
+                // Only 32-bit color channel format in D3D9 was R32F
+                return DXGI_FORMAT_R32_FLOAT; // D3DX writes this out as a FourCC of 114
+            }
+            break;
+
+        case 24:
+            // No 24bpp DXGI formats aka D3DFMT_R8G8B8
+            break;
+
+        case 16:
+            if (ISBITMASK(0x7c00,0x03e0,0x001f,0x8000))
+            {
+                return DXGI_FORMAT_B5G5R5A1_UNORM;
+            }
+            if (ISBITMASK(0xf800,0x07e0,0x001f,0x0000))
+            {
+                return DXGI_FORMAT_B5G6R5_UNORM;
+            }
+
+            // No DXGI format maps to ISBITMASK(0x7c00,0x03e0,0x001f,0x0000) aka D3DFMT_X1R5G5B5
+
+            if (ISBITMASK(0x0f00,0x00f0,0x000f,0xf000))
+            {
+                return DXGI_FORMAT_B4G4R4A4_UNORM;
+            }
+
+            // No DXGI format maps to ISBITMASK(0x0f00,0x00f0,0x000f,0x0000) aka D3DFMT_X4R4G4B4
+
+            // No 3:3:2, 3:3:2:8, or paletted DXGI formats aka D3DFMT_A8R3G3B2, D3DFMT_R3G3B2, D3DFMT_P8, D3DFMT_A8P8, etc.
+            break;
+		default:
+			assert(false);
+			break;
+        }
+    }
+    else if (ddpf.flags & DDS_LUMINANCE)
+    {
+        if (8 == ddpf.RGBBitCount)
+        {
+            if (ISBITMASK(0x000000ff,0x00000000,0x00000000,0x00000000))
+            {
+                return DXGI_FORMAT_R8_UNORM; // D3DX10/11 writes this out as DX10 extension
+            }
+
+            // No DXGI format maps to ISBITMASK(0x0f,0x00,0x00,0xf0) aka D3DFMT_A4L4
+        }
+
+        if (16 == ddpf.RGBBitCount)
+        {
+            if (ISBITMASK(0x0000ffff,0x00000000,0x00000000,0x00000000))
+            {
+                return DXGI_FORMAT_R16_UNORM; // D3DX10/11 writes this out as DX10 extension
+            }
+            if (ISBITMASK(0x000000ff,0x00000000,0x00000000,0x0000ff00))
+            {
+                return DXGI_FORMAT_R8G8_UNORM; // D3DX10/11 writes this out as DX10 extension
+            }
+        }
+    }
+    else if (ddpf.flags & DDS_ALPHA)
+    {
+        if (8 == ddpf.RGBBitCount)
+        {
+            return DXGI_FORMAT_A8_UNORM;
+        }
+    }
+    else if (ddpf.flags & DDS_FOURCC)
+    {
+        if (MAKEFOURCC( 'D', 'X', 'T', '1' ) == ddpf.fourCC)
+        {
+            return DXGI_FORMAT_BC1_UNORM;
+        }
+        if (MAKEFOURCC( 'D', 'X', 'T', '3' ) == ddpf.fourCC)
+        {
+            return DXGI_FORMAT_BC2_UNORM;
+        }
+        if (MAKEFOURCC( 'D', 'X', 'T', '5' ) == ddpf.fourCC)
+        {
+            return DXGI_FORMAT_BC3_UNORM;
+        }
+
+        // While pre-multiplied alpha isn't directly supported by the DXGI formats,
+        // they are basically the same as these BC formats so they can be mapped
+        if (MAKEFOURCC( 'D', 'X', 'T', '2' ) == ddpf.fourCC)
+        {
+            return DXGI_FORMAT_BC2_UNORM;
+        }
+        if (MAKEFOURCC( 'D', 'X', 'T', '4' ) == ddpf.fourCC)
+        {
+            return DXGI_FORMAT_BC3_UNORM;
+        }
+
+        if (MAKEFOURCC( 'A', 'T', 'I', '1' ) == ddpf.fourCC)
+        {
+            return DXGI_FORMAT_BC4_UNORM;
+        }
+        if (MAKEFOURCC( 'B', 'C', '4', 'U' ) == ddpf.fourCC)
+        {
+            return DXGI_FORMAT_BC4_UNORM;
+        }
+        if (MAKEFOURCC( 'B', 'C', '4', 'S' ) == ddpf.fourCC)
+        {
+            return DXGI_FORMAT_BC4_SNORM;
+        }
+
+        if (MAKEFOURCC( 'A', 'T', 'I', '2' ) == ddpf.fourCC)
+        {
+            return DXGI_FORMAT_BC5_UNORM;
+        }
+        if (MAKEFOURCC( 'B', 'C', '5', 'U' ) == ddpf.fourCC)
+        {
+            return DXGI_FORMAT_BC5_UNORM;
+        }
+        if (MAKEFOURCC( 'B', 'C', '5', 'S' ) == ddpf.fourCC)
+        {
+            return DXGI_FORMAT_BC5_SNORM;
+        }
+
+        // BC6H and BC7 are written using the "DX10" extended header
+
+        if (MAKEFOURCC( 'R', 'G', 'B', 'G' ) == ddpf.fourCC)
+        {
+            return DXGI_FORMAT_R8G8_B8G8_UNORM;
+        }
+        if (MAKEFOURCC( 'G', 'R', 'G', 'B' ) == ddpf.fourCC)
+        {
+            return DXGI_FORMAT_G8R8_G8B8_UNORM;
+        }
+
+        if (MAKEFOURCC('Y','U','Y','2') == ddpf.fourCC)
+        {
+            return DXGI_FORMAT_YUY2;
+        }
+
+        // Check for D3DFORMAT enums being set here
+        switch( ddpf.fourCC )
+        {
+        case 36: // D3DFMT_A16B16G16R16
+            return DXGI_FORMAT_R16G16B16A16_UNORM;
+
+        case 110: // D3DFMT_Q16W16V16U16
+            return DXGI_FORMAT_R16G16B16A16_SNORM;
+
+        case 111: // D3DFMT_R16F
+            return DXGI_FORMAT_R16_FLOAT;
+
+        case 112: // D3DFMT_G16R16F
+            return DXGI_FORMAT_R16G16_FLOAT;
+
+        case 113: // D3DFMT_A16B16G16R16F
+            return DXGI_FORMAT_R16G16B16A16_FLOAT;
+
+        case 114: // D3DFMT_R32F
+            return DXGI_FORMAT_R32_FLOAT;
+
+        case 115: // D3DFMT_G32R32F
+            return DXGI_FORMAT_R32G32_FLOAT;
+
+        case 116: // D3DFMT_A32B32G32R32F
+            return DXGI_FORMAT_R32G32B32A32_FLOAT;
+		default:
+			break;
+        }
+    }
+
+    return DXGI_FORMAT_UNKNOWN;
+}
@@ -0,0 +1,204 @@
+//--------------------------------------------------------------------------------------
+// File: DDSTextureParser.h
+//
+// DDS file structures and parsing functions of DDSTextureLoader, that do not depend on Direct3D
+//
+// THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+// PARTICULAR PURPOSE.
+//
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// http://go.microsoft.com/fwlink/?LinkId=248926
+// http://go.microsoft.com/fwlink/?LinkId=248929
+//--------------------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <dxgiformat.h>
+
+//--------------------------------------------------------------------------------------
+// Macros
+//--------------------------------------------------------------------------------------
+#ifndef MAKEFOURCC
+    #define MAKEFOURCC(ch0, ch1, ch2, ch3)                              \
+                ((std::uint32_t)(uint8_t)(ch0) | ((std::uint32_t)(uint8_t)(ch1) << 8) |       \
+                ((std::uint32_t)(uint8_t)(ch2) << 16) | ((std::uint32_t)(uint8_t)(ch3) << 24 ))
+#endif /* defined(MAKEFOURCC) */
+
+//--------------------------------------------------------------------------------------
+// DDS file structure definitions
+//
+// See DDS.h in the 'Texconv' sample and the 'DirectXTex' library
+//--------------------------------------------------------------------------------------
+#pragma pack(push,1)
+
+const std::uint32_t DDS_MAGIC = 0x20534444; // "DDS "
+
+struct DDS_PIXELFORMAT
+{
+    std::uint32_t    size;
+    std::uint32_t    flags;
+    std::uint32_t    fourCC;
+    std::uint32_t    RGBBitCount;
+    std::uint32_t    RBitMask;
+    std::uint32_t    GBitMask;
+    std::uint32_t    BBitMask;
+    std::uint32_t    ABitMask;
+};
+
+#define DDS_FOURCC      0x00000004  // DDPF_FOURCC
+#define DDS_RGB         0x00000040  // DDPF_RGB
+#define DDS_LUMINANCE   0x00020000  // DDPF_LUMINANCE
+#define DDS_ALPHA       0x00000002  // DDPF_ALPHA
+
+#define DDS_HEADER_FLAGS_VOLUME         0x00800000  // DDSD_DEPTH
+
+#define DDS_HEIGHT 0x00000002 // DDSD_HEIGHT
+#define DDS_WIDTH  0x00000004 // DDSD_WIDTH
+
+#define DDS_CUBEMAP_POSITIVEX 0x00000600 // DDSCAPS2_CUBEMAP | DDSCAPS2_CUBEMAP_POSITIVEX
+#define DDS_CUBEMAP_NEGATIVEX 0x00000a00 // DDSCAPS2_CUBEMAP | DDSCAPS2_CUBEMAP_NEGATIVEX
+#define DDS_CUBEMAP_POSITIVEY 0x00001200 // DDSCAPS2_CUBEMAP | DDSCAPS2_CUBEMAP_POSITIVEY
+#define DDS_CUBEMAP_NEGATIVEY 0x00002200 // DDSCAPS2_CUBEMAP | DDSCAPS2_CUBEMAP_NEGATIVEY
+#define DDS_CUBEMAP_POSITIVEZ 0x00004200 // DDSCAPS2_CUBEMAP | DDSCAPS2_CUBEMAP_POSITIVEZ
+#define DDS_CUBEMAP_NEGATIVEZ 0x00008200 // DDSCAPS2_CUBEMAP | DDSCAPS2_CUBEMAP_NEGATIVEZ
+
+#define DDS_CUBEMAP_ALLFACES ( DDS_CUBEMAP_POSITIVEX | DDS_CUBEMAP_NEGATIVEX |\
+                               DDS_CUBEMAP_POSITIVEY | DDS_CUBEMAP_NEGATIVEY |\
+                               DDS_CUBEMAP_POSITIVEZ | DDS_CUBEMAP_NEGATIVEZ )
+
+#define DDS_CUBEMAP 0x00000200 // DDSCAPS2_CUBEMAP
+
+enum class DDS_MISC_FLAGS2 : std::uint32_t
+{
+    DDS_MISC_FLAGS2_ALPHA_MODE_MASK = 0x7L,
+};
+
+struct DDS_HEADER
+{
+    std::uint32_t        size;
+    std::uint32_t        flags;
+    std::uint32_t        height;
+    std::uint32_t        width;
+    std::uint32_t        pitchOrLinearSize;
+    std::uint32_t        depth; // only if DDS_HEADER_FLAGS_VOLUME is set in flags
+    std::uint32_t        mipMapCount;
+    std::uint32_t        reserved1[11];
+    DDS_PIXELFORMAT ddspf;
+    std::uint32_t        caps;
+    std::uint32_t        caps2;
+    std::uint32_t        caps3;
+    std::uint32_t        caps4;
+    std::uint32_t        reserved2;
+};
+
+struct DDS_HEADER_DXT10
+{
+    DXGI_FORMAT     dxgiFormat;
+    std::uint32_t        resourceDimension;
+    std::uint32_t        miscFlag; // see D3D11_RESOURCE_MISC_FLAG
+    std::uint32_t        arraySize;
+    std::uint32_t        miscFlags2;
+};
+
+#pragma pack(pop)
+
+// To parse DDS file data in place (for example, a MemoryMappedFile) without copying it.
+// ParseHeader() validates the headers, and ComputeSubresourceLayouts() locates the data of each
+// subresource, so it can be uploaded directly from the file data.
+namespace DDSTextureParser {
+	enum class Result {
+		SUCCESS = 0,
+		INVALID_DATA,
+		NOT_SUPPORTED,
+		END_OF_FILE
+	};
+
+	// Values are the ones of D3D12_RESOURCE_DIMENSION
+	enum class Dimension : std::uint32_t {
+		TEXTURE1D = 2U,
+		TEXTURE2D = 3U,
+		TEXTURE3D = 4U
+	};
+
+	// Maximum values of Direct3D 12 hardware. Files with greater values are not supported.
+	const std::uint32_t sMaxMipCount{ 15U };
+	const std::uint32_t sMaxTexture1DDimension{ 16384U };
+	const std::uint32_t sMaxTexture2DDimension{ 16384U };
+	const std::uint32_t sMaxTexture3DDimension{ 2048U };
+	const std::uint32_t sMaxArraySize{ 2048U };
+
+	struct TextureInfo {
+		Dimension mDimension{ Dimension::TEXTURE2D };
+		std::uint32_t mWidth{ 0U };
+		std::uint32_t mHeight{ 0U };
+		std::uint32_t mDepth{ 0U };
+
+		// Cube maps have 6 array slices per cube
+		std::uint32_t mArraySize{ 0U };
+		std::uint32_t mMipCount{ 0U };
+		DXGI_FORMAT mFormat{ DXGI_FORMAT_UNKNOWN };
+		bool mIsCubeMap{ false };
+
+		// Offset of the data of the first subresource, from the beginning of the file
+		std::size_t mDataOffset{ 0UL };
+	};
+
+	// Location of the data of a subresource in the file
+	struct SubresourceLayout {
+		// Offset from the beginning of the file
+		std::size_t mOffset{ 0UL };
+		std::size_t mRowPitch{ 0UL };
+		std::size_t mSlicePitch{ 0UL };
+
+		// Size of all the depth slices of the subresource
+		std::size_t mSize{ 0UL };
+	};
+
+	// Parses the magic number and the headers of the file. "data" only needs to include them,
+	// so the data of the subresources is not read.
+	// It returns Result::INVALID_DATA if the mip count exceeds the one of the full mip chain.
+	// Preconditions:
+	// - "data" must not be nullptr
+	Result ParseHeader(
+		const std::uint8_t* data,
+		const std::size_t dataSize,
+		TextureInfo& textureInfo) noexcept;
+
+	// Computes the layouts of the subresources of the file. Subresources are stored from the
+	// first array slice, and from the finest mip. Mips whose width, height or depth are greater than
+	// "maxSize" are skipped (except if "maxSize" is zero, or there is a single mip): "skippedMipCount" 
+	// is the number of skipped mips, and "width", "height" and "depth" are the ones of the first mip that is not skipped.
+	// Array slices are computed in parallel if there are enough of them.
+	// It returns Result::END_OF_FILE if "dataSize" (the size of the whole file) does not include all the subresources.
+	// Preconditions:
+	// - "textureInfo" must be returned by ParseHeader()
+	// - "layouts" must not be nullptr, and it must have space for mip count * array size layouts
+	Result ComputeSubresourceLayouts(
+		const TextureInfo& textureInfo,
+		const std::size_t maxSize,
+		const std::size_t dataSize,
+		SubresourceLayout* layouts,
+		std::uint32_t& skippedMipCount,
+		std::uint32_t& width,
+		std::uint32_t& height,
+		std::uint32_t& depth) noexcept;
+
+	// Returns zero if the format is not supported
+	std::size_t BitsPerPixel(const DXGI_FORMAT format) noexcept;
+
+	void GetSurfaceInfo(
+		const std::size_t width,
+		const std::size_t height,
+		const DXGI_FORMAT format,
+		std::size_t* outNumBytes,
+		std::size_t* outRowBytes,
+		std::size_t* outNumRows) noexcept;
+
+	// Returns DXGI_FORMAT_UNKNOWN if the pixel format has no equivalent DXGI format
+	DXGI_FORMAT GetDXGIFormat(const DDS_PIXELFORMAT& ddpf) noexcept;
+}
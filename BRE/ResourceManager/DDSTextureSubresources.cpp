@@ -0,0 +1,114 @@
+#include "DDSTextureSubresources.h"
+
+#include <algorithm>
+
+#include <ResourceManager/MipGenerator.h>
+#include <Utils/DebugUtils.h>
+
+namespace DDSTextureSubresources {
+	DDSTextureParser::Result ComputeSubresources(
+		const std::uint8_t* data,
+		const std::size_t dataSize,
+		const DDSTextureParser::TextureInfo& textureInfo,
+		const std::size_t maxSize,
+		Subresources& subresources) noexcept
+	{
+		ASSERT(data != nullptr);
+
+		subresources = Subresources();
+
+		const std::uint32_t arraySize{ textureInfo.mArraySize };
+		std::vector<DDSTextureParser::SubresourceLayout> layouts(static_cast<std::size_t>(textureInfo.mMipCount) * arraySize);
+		std::uint32_t skippedMipCount{ 0U };
+		std::uint32_t width{ 0U };
+		std::uint32_t height{ 0U };
+		std::uint32_t depth{ 0U };
+		const DDSTextureParser::Result result{ DDSTextureParser::ComputeSubresourceLayouts(
+			textureInfo, maxSize, dataSize, layouts.data(), skippedMipCount, width, height, depth) };
+		if (result != DDSTextureParser::Result::SUCCESS) {
+			return result;
+		}
+
+		// Mips of the file. The mip count is checked before the mips to generate are
+		// computed from it, as a file can claim more mips than its dimensions have.
+		const std::uint32_t mipCount{ textureInfo.mMipCount - skippedMipCount };
+		std::uint32_t generatedMipCount{ 0U };
+		if (textureInfo.mDimension == DDSTextureParser::Dimension::TEXTURE2D) {
+			const std::uint32_t fullMipCount{ MipGenerator::GetFullMipCount(width, height) };
+			if (mipCount > fullMipCount) {
+				return DDSTextureParser::Result::INVALID_DATA;
+			}
+
+			if (MipGenerator::IsFormatSupported(textureInfo.mFormat)) {
+				generatedMipCount = fullMipCount - mipCount;
+			}
+		}
+
+		const std::uint32_t totalMipCount{ mipCount + generatedMipCount };
+		subresources.mSubresources.resize(static_cast<std::size_t>(totalMipCount) * arraySize);
+		for (std::uint32_t j = 0U; j < arraySize; ++j) {
+			for (std::uint32_t i = 0U; i < mipCount; ++i) {
+				const DDSTextureParser::SubresourceLayout& layout = layouts[j * mipCount + i];
+				SubresourceData& subresource = subresources.mSubresources[j * totalMipCount + i];
+				subresource.mData = data + layout.mOffset;
+				subresource.mRowPitch = layout.mRowPitch;
+				subresource.mSlicePitch = layout.mSlicePitch;
+			}
+		}
+
+		if (generatedMipCount > 0U) {
+			std::uint32_t lastMipWidth{ width };
+			std::uint32_t lastMipHeight{ height };
+			for (std::uint32_t i = 1U; i < mipCount; ++i) {
+				lastMipWidth = std::max<std::uint32_t>(lastMipWidth / 2U, 1U);
+				lastMipHeight = std::max<std::uint32_t>(lastMipHeight / 2U, 1U);
+			}
+
+			std::vector<const std::uint8_t*> lastMips(arraySize);
+			for (std::uint32_t j = 0U; j < arraySize; ++j) {
+				lastMips[j] = data + layouts[j * mipCount + mipCount - 1U].mOffset;
+			}
+
+			const std::size_t sliceGeneratedMipsSize{ MipGenerator::GetMipsSize(
+				lastMipWidth, lastMipHeight, textureInfo.mFormat, generatedMipCount) };
+			subresources.mGeneratedMips.resize(sliceGeneratedMipsSize * arraySize);
+			MipGenerator::GenerateMips(
+				lastMips.data(),
+				arraySize,
+				lastMipWidth,
+				lastMipHeight,
+				textureInfo.mFormat,
+				MipGenerator::Filter::BOX,
+				generatedMipCount,
+				subresources.mGeneratedMips.data());
+
+			for (std::uint32_t j = 0U; j < arraySize; ++j) {
+				const std::uint8_t* mip{ subresources.mGeneratedMips.data() + j * sliceGeneratedMipsSize };
+				std::size_t mipWidth{ lastMipWidth };
+				std::size_t mipHeight{ lastMipHeight };
+				for (std::uint32_t i = mipCount; i < totalMipCount; ++i) {
+					mipWidth = std::max<std::size_t>(mipWidth / 2UL, 1UL);
+					mipHeight = std::max<std::size_t>(mipHeight / 2UL, 1UL);
+
+					std::size_t numBytes{ 0UL };
+					std::size_t rowBytes{ 0UL };
+					DDSTextureParser::GetSurfaceInfo(mipWidth, mipHeight, textureInfo.mFormat, &numBytes, &rowBytes, nullptr);
+
+					SubresourceData& subresource = subresources.mSubresources[j * totalMipCount + i];
+					subresource.mData = mip;
+					subresource.mRowPitch = rowBytes;
+					subresource.mSlicePitch = numBytes;
+					mip += numBytes;
+				}
+			}
+		}
+
+		subresources.mWidth = width;
+		subresources.mHeight = height;
+		subresources.mDepth = depth;
+		subresources.mMipCount = totalMipCount;
+		subresources.mGeneratedMipCount = generatedMipCount;
+
+		return DDSTextureParser::Result::SUCCESS;
+	}
+}
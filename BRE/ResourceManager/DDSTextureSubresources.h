@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <ResourceManager/DDSTextureParser.h>
+
+// Subresources of a DDS file to create its texture (see DDSTextureLoader): the ones in the file,
+// that point to the file data (it is not copied), and the missing mips of 2D textures (and cube maps)
+// that are generated from the last mip of the file (see MipGenerator).
+namespace DDSTextureSubresources {
+	// Layout of D3D12_SUBRESOURCE_DATA
+	struct SubresourceData {
+		const std::uint8_t* mData{ nullptr };
+		std::size_t mRowPitch{ 0UL };
+		std::size_t mSlicePitch{ 0UL };
+	};
+
+	struct Subresources {
+		// Dimensions of the first mip that is not skipped
+		std::uint32_t mWidth{ 0U };
+		std::uint32_t mHeight{ 0U };
+		std::uint32_t mDepth{ 0U };
+
+		// Mips of each array slice, including the generated ones
+		std::uint32_t mMipCount{ 0U };
+		std::uint32_t mGeneratedMipCount{ 0U };
+
+		// "mMipCount" subresources per array slice, from the first array slice, and from the finest mip
+		std::vector<SubresourceData> mSubresources;
+
+		// Data of the generated mips, that the subresources of the generated mips point to
+		std::vector<std::uint8_t> mGeneratedMips;
+	};
+
+	// Computes the subresources of the file in "data", skipping the mips whose dimensions are greater than
+	// "maxSize" (see DDSTextureParser::ComputeSubresourceLayouts()). The missing mips of 2D textures are
+	// generated if their format is supported by MipGenerator.
+	// It returns Result::INVALID_DATA if the mip count exceeds the one of the full mip chain, and
+	// "subresources" is only filled if it returns Result::SUCCESS.
+	// Preconditions:
+	// - "data" must not be nullptr
+	// - "textureInfo" must be returned by DDSTextureParser::ParseHeader()
+	DDSTextureParser::Result ComputeSubresources(
+		const std::uint8_t* data,
+		const std::size_t dataSize,
+		const DDSTextureParser::TextureInfo& textureInfo,
+		const std::size_t maxSize,
+		Subresources& subresources) noexcept;
+}
@@ -0,0 +1,126 @@
+#include "DDSTextureWriter.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#include <Utils/DebugUtils.h>
+
+namespace {
+	// DDS_HEADER flags
+	const std::uint32_t sHeaderFlagsTexture{ 0x00001007U }; // DDSD_CAPS | DDSD_HEIGHT | DDSD_WIDTH | DDSD_PIXELFORMAT
+	const std::uint32_t sHeaderFlagsMipMap{ 0x00020000U }; // DDSD_MIPMAPCOUNT
+	const std::uint32_t sHeaderFlagsPitch{ 0x00000008U }; // DDSD_PITCH
+	const std::uint32_t sHeaderFlagsLinearSize{ 0x00080000U }; // DDSD_LINEARSIZE
+
+	// DDS_HEADER caps
+	const std::uint32_t sSurfaceFlagsTexture{ 0x00001000U }; // DDSCAPS_TEXTURE
+	const std::uint32_t sSurfaceFlagsMipMap{ 0x00400008U }; // DDSCAPS_COMPLEX | DDSCAPS_MIPMAP
+	const std::uint32_t sSurfaceFlagsCubeMap{ 0x00000008U }; // DDSCAPS_COMPLEX
+
+	// DDS_HEADER_DXT10 misc flag of cube maps (D3D11_RESOURCE_MISC_TEXTURECUBE)
+	const std::uint32_t sResourceMiscTextureCube{ 0x4U };
+
+	bool IsBlockCompressed(const DXGI_FORMAT format) noexcept {
+		return
+			(format >= DXGI_FORMAT_BC1_TYPELESS && format <= DXGI_FORMAT_BC5_SNORM) ||
+			(format >= DXGI_FORMAT_BC6H_TYPELESS && format <= DXGI_FORMAT_BC7_UNORM_SRGB);
+	}
+}
+
+namespace DDSTextureWriter {
+	bool WriteFile(
+		const char* filePath,
+		const DDSTextureParser::TextureInfo& textureInfo,
+		const std::uint8_t* data,
+		const std::size_t dataSize) noexcept
+	{
+		ASSERT(filePath != nullptr);
+		ASSERT(data != nullptr);
+		ASSERT(dataSize == ComputeDataSize(textureInfo));
+		ASSERT(textureInfo.mIsCubeMap == false || textureInfo.mArraySize % 6U == 0U);
+
+		std::size_t rowBytes{ 0UL };
+		std::size_t numBytes{ 0UL };
+		DDSTextureParser::GetSurfaceInfo(textureInfo.mWidth, textureInfo.mHeight, textureInfo.mFormat, &numBytes, &rowBytes, nullptr);
+
+		DDS_HEADER header;
+		std::memset(&header, 0, sizeof(DDS_HEADER));
+		header.size = sizeof(DDS_HEADER);
+		header.flags = sHeaderFlagsTexture | sHeaderFlagsMipMap;
+		header.height = textureInfo.mHeight;
+		header.width = textureInfo.mWidth;
+		header.mipMapCount = textureInfo.mMipCount;
+		header.ddspf.size = sizeof(DDS_PIXELFORMAT);
+		header.ddspf.flags = DDS_FOURCC;
+		header.ddspf.fourCC = MAKEFOURCC('D', 'X', '1', '0');
+		header.caps = sSurfaceFlagsTexture;
+
+		if (IsBlockCompressed(textureInfo.mFormat)) {
+			header.flags |= sHeaderFlagsLinearSize;
+			header.pitchOrLinearSize = static_cast<std::uint32_t>(numBytes);
+		} else {
+			header.flags |= sHeaderFlagsPitch;
+			header.pitchOrLinearSize = static_cast<std::uint32_t>(rowBytes);
+		}
+
+		if (textureInfo.mMipCount > 1U) {
+			header.caps |= sSurfaceFlagsMipMap;
+		}
+
+		if (textureInfo.mDimension == DDSTextureParser::Dimension::TEXTURE3D) {
+			header.flags |= DDS_HEADER_FLAGS_VOLUME;
+			header.depth = textureInfo.mDepth;
+		} else if (textureInfo.mIsCubeMap) {
+			header.caps |= sSurfaceFlagsCubeMap;
+			header.caps2 = DDS_CUBEMAP_ALLFACES;
+		}
+
+		DDS_HEADER_DXT10 extendedHeader;
+		std::memset(&extendedHeader, 0, sizeof(DDS_HEADER_DXT10));
+		extendedHeader.dxgiFormat = textureInfo.mFormat;
+		extendedHeader.resourceDimension = static_cast<std::uint32_t>(textureInfo.mDimension);
+		extendedHeader.miscFlag = textureInfo.mIsCubeMap ? sResourceMiscTextureCube : 0U;
+		extendedHeader.arraySize = textureInfo.mIsCubeMap ? textureInfo.mArraySize / 6U : textureInfo.mArraySize;
+
+		std::FILE* file{ nullptr };
+#ifdef _WIN32
+		if (fopen_s(&file, filePath, "wb") != 0) {
+			file = nullptr;
+		}
+#else
+		file = std::fopen(filePath, "wb");
+#endif
+		if (file == nullptr) {
+			return false;
+		}
+
+		bool result =
+			std::fwrite(&DDS_MAGIC, sizeof(std::uint32_t), 1UL, file) == 1UL &&
+			std::fwrite(&header, sizeof(DDS_HEADER), 1UL, file) == 1UL &&
+			std::fwrite(&extendedHeader, sizeof(DDS_HEADER_DXT10), 1UL, file) == 1UL &&
+			std::fwrite(data, 1UL, dataSize, file) == dataSize;
+
+		result = (std::fclose(file) == 0) && result;
+
+		return result;
+	}
+
+	std::size_t ComputeDataSize(const DDSTextureParser::TextureInfo& textureInfo) noexcept {
+		std::size_t sliceSize{ 0UL };
+		std::size_t width{ textureInfo.mWidth };
+		std::size_t height{ textureInfo.mHeight };
+		std::size_t depth{ textureInfo.mDepth };
+		for (std::uint32_t i = 0U; i < textureInfo.mMipCount; ++i) {
+			std::size_t numBytes{ 0UL };
+			DDSTextureParser::GetSurfaceInfo(width, height, textureInfo.mFormat, &numBytes, nullptr, nullptr);
+			sliceSize += numBytes * depth;
+
+			width = std::max<std::size_t>(width / 2UL, 1UL);
+			height = std::max<std::size_t>(height / 2UL, 1UL);
+			depth = std::max<std::size_t>(depth / 2UL, 1UL);
+		}
+
+		return sliceSize * textureInfo.mArraySize;
+	}
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <ResourceManager/DDSTextureParser.h>
+
+// To write DDS files that DDSTextureLoader loads (for example, textures compressed by TextureCooker).
+// Files have the DX10 header, so any DXGI format can be written.
+namespace DDSTextureWriter {
+	// "data" has the subresources, from the first array slice, and from the finest mip
+	// (see DDSTextureParser::ComputeSubresourceLayouts()). The mip count must be a full or partial mip chain.
+	// Cube maps have 6 array slices per cube. The data offset of "textureInfo" is ignored.
+	// It returns false if the file cannot be written.
+	// Preconditions:
+	// - "filePath" and "data" must not be nullptr
+	// - "dataSize" must be the size of all the subresources
+	bool WriteFile(
+		const char* filePath,
+		const DDSTextureParser::TextureInfo& textureInfo,
+		const std::uint8_t* data,
+		const std::size_t dataSize) noexcept;
+
+	// Size of the subresources of a texture. It is the size of "data" in WriteFile().
+	std::size_t ComputeDataSize(const DDSTextureParser::TextureInfo& textureInfo) noexcept;
+}
@@ -0,0 +1,539 @@
+#include "MipGenerator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <emmintrin.h>
+#include <tbb/parallel_for.h>
+#include <vector>
+
+#include <ResourceManager/BlockCompressor.h>
+#include <ResourceManager/DDSTextureParser.h>
+#include <Utils/DebugUtils.h>
+
+namespace {
+	// Radius (in texels of the generated mip) and shape of the Kaiser filter
+	const float sKaiserRadius{ 3.0f };
+	const float sKaiserAlpha{ 4.0f };
+
+	const float sPi{ 3.14159265358979f };
+
+	// How texels are stored
+	enum class Layout {
+		R8 = 0,
+		R8G8,
+		R8G8B8A8,
+		B8G8R8A8,
+		B8G8R8X8,
+		R32,
+		R32G32B32A32,
+		BLOCK_COMPRESSED
+	};
+
+	struct FormatInfo {
+		Layout mLayout{ Layout::R8 };
+		bool mIsSRGB{ false };
+		BlockCompressor::Format mBlockFormat{ BlockCompressor::Format::BC1 };
+	};
+
+	bool GetFormatInfo(const DXGI_FORMAT format, FormatInfo& formatInfo) noexcept {
+		formatInfo = FormatInfo();
+		switch (format) {
+		case DXGI_FORMAT_R8_UNORM:
+			formatInfo.mLayout = Layout::R8;
+			return true;
+		case DXGI_FORMAT_R8G8_UNORM:
+			formatInfo.mLayout = Layout::R8G8;
+			return true;
+		case DXGI_FORMAT_R8G8B8A8_UNORM:
+		case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+			formatInfo.mLayout = Layout::R8G8B8A8;
+			formatInfo.mIsSRGB = format == DXGI_FORMAT_R8G8B8A8_UNORM_SRGB;
+			return true;
+		case DXGI_FORMAT_B8G8R8A8_UNORM:
+		case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+			formatInfo.mLayout = Layout::B8G8R8A8;
+			formatInfo.mIsSRGB = format == DXGI_FORMAT_B8G8R8A8_UNORM_SRGB;
+			return true;
+		case DXGI_FORMAT_B8G8R8X8_UNORM:
+		case DXGI_FORMAT_B8G8R8X8_UNORM_SRGB:
+			formatInfo.mLayout = Layout::B8G8R8X8;
+			formatInfo.mIsSRGB = format == DXGI_FORMAT_B8G8R8X8_UNORM_SRGB;
+			return true;
+		case DXGI_FORMAT_R32_FLOAT:
+			formatInfo.mLayout = Layout::R32;
+			return true;
+		case DXGI_FORMAT_R32G32B32A32_FLOAT:
+			formatInfo.mLayout = Layout::R32G32B32A32;
+			return true;
+		case DXGI_FORMAT_BC1_UNORM:
+		case DXGI_FORMAT_BC1_UNORM_SRGB:
+			formatInfo.mLayout = Layout::BLOCK_COMPRESSED;
+			formatInfo.mIsSRGB = format == DXGI_FORMAT_BC1_UNORM_SRGB;
+			formatInfo.mBlockFormat = BlockCompressor::Format::BC1;
+			return true;
+		case DXGI_FORMAT_BC3_UNORM:
+		case DXGI_FORMAT_BC3_UNORM_SRGB:
+			formatInfo.mLayout = Layout::BLOCK_COMPRESSED;
+			formatInfo.mIsSRGB = format == DXGI_FORMAT_BC3_UNORM_SRGB;
+			formatInfo.mBlockFormat = BlockCompressor::Format::BC3;
+			return true;
+		case DXGI_FORMAT_BC4_UNORM:
+			formatInfo.mLayout = Layout::BLOCK_COMPRESSED;
+			formatInfo.mBlockFormat = BlockCompressor::Format::BC4;
+			return true;
+		case DXGI_FORMAT_BC5_UNORM:
+			formatInfo.mLayout = Layout::BLOCK_COMPRESSED;
+			formatInfo.mBlockFormat = BlockCompressor::Format::BC5;
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	// Number of intervals of [0.0f, 1.0f] linear values whose first sRGB value is stored
+	const std::uint32_t sLinearIntervalCount{ 4096U };
+
+	// Conversions of 8 bits values (sRGB or linear) to linear values, and linear values
+	// where sRGB 8 bits values are rounded to the next value (rounding is in sRGB space).
+	struct ConversionTables {
+		ConversionTables() noexcept {
+			for (std::uint32_t i = 0U; i < 256U; ++i) {
+				mUNORMToLinear[i] = static_cast<float>(i) / 255.0f;
+				mSRGBToLinear[i] = SRGBToLinear(mUNORMToLinear[i]);
+			}
+
+			for (std::uint32_t i = 0U; i < 255U; ++i) {
+				mSRGBThresholds[i] = SRGBToLinear((static_cast<float>(i) + 0.5f) / 255.0f);
+			}
+
+			for (std::uint32_t i = 0U; i < sLinearIntervalCount; ++i) {
+				const float value{ static_cast<float>(i) / static_cast<float>(sLinearIntervalCount) };
+				mLinearIntervalSRGBs[i] = static_cast<std::uint8_t>(
+					std::upper_bound(mSRGBThresholds, mSRGBThresholds + 255U, value) - mSRGBThresholds);
+			}
+		}
+
+		static float SRGBToLinear(const float value) noexcept {
+			return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+		}
+
+		float mUNORMToLinear[256U];
+		float mSRGBToLinear[256U];
+		float mSRGBThresholds[255U];
+		std::uint8_t mLinearIntervalSRGBs[sLinearIntervalCount];
+	};
+
+	const ConversionTables& GetConversionTables() noexcept {
+		static const ConversionTables sConversionTables;
+		return sConversionTables;
+	}
+
+	// 8 bits sRGB value of a linear value. Intervals are shorter than the
+	// distance between thresholds, so the first value of the interval is incremented at most once.
+	std::uint8_t LinearToSRGB(const float value, const ConversionTables& tables) noexcept {
+		const float clampedValue{ std::min<float>(std::max<float>(value, 0.0f), 1.0f) };
+		const std::uint32_t interval{
+			std::min<std::uint32_t>(static_cast<std::uint32_t>(clampedValue * sLinearIntervalCount), sLinearIntervalCount - 1U) };
+		std::uint32_t srgbValue{ tables.mLinearIntervalSRGBs[interval] };
+		if (srgbValue < 255U && clampedValue >= tables.mSRGBThresholds[srgbValue]) {
+			++srgbValue;
+		}
+
+		return static_cast<std::uint8_t>(srgbValue);
+	}
+
+	// Source texels and weights of each texel of a generated mip, along an axis
+	struct Kernel {
+		std::uint32_t mTapCount{ 0U };
+
+		// "mTapCount" source texels (clamped to the edges) and weights per texel
+		std::vector<std::uint32_t> mIndices;
+		std::vector<float> mWeights;
+	};
+
+	float Sinc(const float x) noexcept {
+		return x == 0.0f ? 1.0f : std::sin(sPi * x) / (sPi * x);
+	}
+
+	// Modified Bessel function of the first kind and order 0
+	float BesselI0(const float x) noexcept {
+		float sum{ 1.0f };
+		float term{ 1.0f };
+		for (std::uint32_t k = 1U; term > 1e-7f * sum; ++k) {
+			const float factor{ 0.5f * x / static_cast<float>(k) };
+			term *= factor * factor;
+			sum += term;
+		}
+
+		return sum;
+	}
+
+	float Kaiser(const float x) noexcept {
+		const float t{ x / sKaiserRadius };
+		return BesselI0(sKaiserAlpha * std::sqrt(std::max<float>(1.0f - t * t, 0.0f))) / BesselI0(sKaiserAlpha);
+	}
+
+	void ComputeKernel(
+		const std::uint32_t sourceSize,
+		const std::uint32_t size,
+		const MipGenerator::Filter filter,
+		Kernel& kernel) noexcept
+	{
+		// Source texel i covers [i, i + 1], and filter radius is in source texels
+		const float scale{ static_cast<float>(sourceSize) / static_cast<float>(size) };
+		const float radius{ filter == MipGenerator::Filter::BOX ? 0.5f * scale : sKaiserRadius * scale };
+
+		kernel.mTapCount = static_cast<std::uint32_t>(std::ceil(2.0f * radius)) + 1U;
+		kernel.mIndices.resize(size * kernel.mTapCount);
+		kernel.mWeights.resize(size * kernel.mTapCount);
+		for (std::uint32_t i = 0U; i < size; ++i) {
+			const float center{ (static_cast<float>(i) + 0.5f) * scale };
+			const std::int32_t firstTap{ static_cast<std::int32_t>(std::floor(center - radius)) };
+			std::uint32_t* indices{ kernel.mIndices.data() + i * kernel.mTapCount };
+			float* weights{ kernel.mWeights.data() + i * kernel.mTapCount };
+			float weightSum{ 0.0f };
+			for (std::uint32_t j = 0U; j < kernel.mTapCount; ++j) {
+				const std::int32_t tap{ firstTap + static_cast<std::int32_t>(j) };
+				float weight{ 0.0f };
+				if (filter == MipGenerator::Filter::BOX) {
+					// Area of the source texel that the texel covers
+					weight = std::max<float>(
+						std::min<float>(static_cast<float>(tap + 1), center + radius) - std::max<float>(static_cast<float>(tap), center - radius),
+						0.0f);
+				} else {
+					const float x{ (static_cast<float>(tap) + 0.5f - center) / scale };
+					weight = std::abs(x) < sKaiserRadius ? Sinc(x) * Kaiser(x) : 0.0f;
+				}
+
+				indices[j] = static_cast<std::uint32_t>(std::min<std::int32_t>(std::max<std::int32_t>(tap, 0), static_cast<std::int32_t>(sourceSize) - 1));
+				weights[j] = weight;
+				weightSum += weight;
+			}
+
+			ASSERT(weightSum > 0.0f);
+			for (std::uint32_t j = 0U; j < kernel.mTapCount; ++j) {
+				weights[j] /= weightSum;
+			}
+		}
+	}
+
+	// Texels of a mip of an array slice, 4 floats (RGBA) per texel
+	struct Image {
+		std::vector<float> mTexels;
+		std::uint32_t mWidth{ 0U };
+		std::uint32_t mHeight{ 0U };
+	};
+
+	std::size_t GetMipSize(
+		const std::uint32_t width,
+		const std::uint32_t height,
+		const DXGI_FORMAT format) noexcept
+	{
+		std::size_t numBytes{ 0UL };
+		DDSTextureParser::GetSurfaceInfo(width, height, format, &numBytes, nullptr, nullptr);
+		return numBytes;
+	}
+
+	// "blockTexels" stores decompressed texels of block compressed formats
+	void LoadTexels(
+		const std::uint8_t* data,
+		const FormatInfo& formatInfo,
+		std::vector<std::uint8_t>& blockTexels,
+		Image& image) noexcept
+	{
+		const std::uint32_t width{ image.mWidth };
+		const std::uint32_t height{ image.mHeight };
+		image.mTexels.resize(static_cast<std::size_t>(width) * height * 4UL);
+
+		if (formatInfo.mLayout == Layout::BLOCK_COMPRESSED) {
+			blockTexels.resize(static_cast<std::size_t>(width) * height * 4UL);
+			BlockCompressor::DecompressImage(data, width, height, formatInfo.mBlockFormat, blockTexels.data());
+			data = blockTexels.data();
+		}
+
+		const ConversionTables& tables{ GetConversionTables() };
+		const float* colorTable{ formatInfo.mIsSRGB ? tables.mSRGBToLinear : tables.mUNORMToLinear };
+		const float* unormTable{ tables.mUNORMToLinear };
+		tbb::parallel_for(tbb::blocked_range<std::uint32_t>(0U, height),
+			[&](const tbb::blocked_range<std::uint32_t>& range) {
+			for (std::uint32_t y = range.begin(); y != range.end(); ++y) {
+				float* texel{ image.mTexels.data() + static_cast<std::size_t>(y) * width * 4UL };
+				for (std::uint32_t x = 0U; x < width; ++x, texel += 4U) {
+					const std::size_t i{ static_cast<std::size_t>(y) * width + x };
+					switch (formatInfo.mLayout) {
+					case Layout::R8:
+						texel[0U] = unormTable[data[i]];
+						texel[1U] = 0.0f;
+						texel[2U] = 0.0f;
+						texel[3U] = 1.0f;
+						break;
+					case Layout::R8G8:
+						texel[0U] = unormTable[data[i * 2UL]];
+						texel[1U] = unormTable[data[i * 2UL + 1UL]];
+						texel[2U] = 0.0f;
+						texel[3U] = 1.0f;
+						break;
+					case Layout::R8G8B8A8:
+					case Layout::BLOCK_COMPRESSED:
+						texel[0U] = colorTable[data[i * 4UL]];
+						texel[1U] = colorTable[data[i * 4UL + 1UL]];
+						texel[2U] = colorTable[data[i * 4UL + 2UL]];
+						texel[3U] = unormTable[data[i * 4UL + 3UL]];
+						break;
+					case Layout::B8G8R8A8:
+					case Layout::B8G8R8X8:
+						texel[0U] = colorTable[data[i * 4UL + 2UL]];
+						texel[1U] = colorTable[data[i * 4UL + 1UL]];
+						texel[2U] = colorTable[data[i * 4UL]];
+						texel[3U] = formatInfo.mLayout == Layout::B8G8R8X8 ? 1.0f : unormTable[data[i * 4UL + 3UL]];
+						break;
+					case Layout::R32:
+						std::memcpy(texel, data + i * 4UL, 4UL);
+						texel[1U] = 0.0f;
+						texel[2U] = 0.0f;
+						texel[3U] = 1.0f;
+						break;
+					case Layout::R32G32B32A32:
+						std::memcpy(texel, data + i * 16UL, 16UL);
+						break;
+					default:
+						ASSERT(false);
+						break;
+					}
+				}
+			}
+		});
+	}
+
+	// "blockTexels" stores texels to compress of block compressed formats
+	void StoreTexels(
+		const Image& image,
+		const FormatInfo& formatInfo,
+		std::vector<std::uint8_t>& blockTexels,
+		std::uint8_t* data) noexcept
+	{
+		const std::uint32_t width{ image.mWidth };
+		const std::uint32_t height{ image.mHeight };
+		std::uint8_t* texels{ data };
+		if (formatInfo.mLayout == Layout::BLOCK_COMPRESSED) {
+			blockTexels.resize(static_cast<std::size_t>(width) * height * 4UL);
+			texels = blockTexels.data();
+		}
+
+		const ConversionTables& tables{ GetConversionTables() };
+		tbb::parallel_for(tbb::blocked_range<std::uint32_t>(0U, height),
+			[&](const tbb::blocked_range<std::uint32_t>& range) {
+			const __m128 zero{ _mm_setzero_ps() };
+			const __m128 one{ _mm_set1_ps(1.0f) };
+			const __m128 scale{ _mm_set1_ps(255.0f) };
+			const __m128 half{ _mm_set1_ps(0.5f) };
+			for (std::uint32_t y = range.begin(); y != range.end(); ++y) {
+				const float* texel{ image.mTexels.data() + static_cast<std::size_t>(y) * width * 4UL };
+				for (std::uint32_t x = 0U; x < width; ++x, texel += 4U) {
+					const std::size_t i{ static_cast<std::size_t>(y) * width + x };
+					if (formatInfo.mLayout == Layout::R32) {
+						std::memcpy(texels + i * 4UL, texel, 4UL);
+						continue;
+					}
+
+					if (formatInfo.mLayout == Layout::R32G32B32A32) {
+						std::memcpy(texels + i * 16UL, texel, 16UL);
+						continue;
+					}
+
+					// Filters with negative weights can overshoot, so values are clamped
+					const __m128 value{ _mm_add_ps(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(texel), zero), one), scale), half) };
+					const __m128i value16{ _mm_packs_epi32(_mm_cvttps_epi32(value), _mm_setzero_si128()) };
+					const std::uint32_t packedValue{ static_cast<std::uint32_t>(_mm_cvtsi128_si32(_mm_packus_epi16(value16, value16))) };
+					std::uint8_t rgba[4U];
+					std::memcpy(rgba, &packedValue, 4UL);
+					if (formatInfo.mIsSRGB) {
+						for (std::uint32_t c = 0U; c < 3U; ++c) {
+							rgba[c] = LinearToSRGB(texel[c], tables);
+						}
+					}
+
+					switch (formatInfo.mLayout) {
+					case Layout::R8:
+						texels[i] = rgba[0U];
+						break;
+					case Layout::R8G8:
+						texels[i * 2UL] = rgba[0U];
+						texels[i * 2UL + 1UL] = rgba[1U];
+						break;
+					case Layout::R8G8B8A8:
+					case Layout::BLOCK_COMPRESSED:
+						std::memcpy(texels + i * 4UL, rgba, 4UL);
+						break;
+					case Layout::B8G8R8A8:
+					case Layout::B8G8R8X8:
+						texels[i * 4UL] = rgba[2U];
+						texels[i * 4UL + 1UL] = rgba[1U];
+						texels[i * 4UL + 2UL] = rgba[0U];
+						texels[i * 4UL + 3UL] = formatInfo.mLayout == Layout::B8G8R8X8 ? 255U : rgba[3U];
+						break;
+					default:
+						ASSERT(false);
+						break;
+					}
+				}
+			}
+		});
+
+		if (formatInfo.mLayout == Layout::BLOCK_COMPRESSED) {
+			BlockCompressor::CompressImage(texels, width, height, width * 4UL, formatInfo.mBlockFormat, data);
+		}
+	}
+
+	// Filters rows to "rowImage" (source height, mip width), and then columns to "image"
+	void FilterImage(
+		const Image& sourceImage,
+		const Kernel& horizontalKernel,
+		const Kernel& verticalKernel,
+		Image& rowImage,
+		Image& image) noexcept
+	{
+		const std::uint32_t sourceWidth{ sourceImage.mWidth };
+		const std::uint32_t width{ image.mWidth };
+		rowImage.mWidth = width;
+		rowImage.mHeight = sourceImage.mHeight;
+		rowImage.mTexels.resize(static_cast<std::size_t>(rowImage.mWidth) * rowImage.mHeight * 4UL);
+		image.mTexels.resize(static_cast<std::size_t>(width) * image.mHeight * 4UL);
+
+		tbb::parallel_for(tbb::blocked_range<std::uint32_t>(0U, rowImage.mHeight),
+			[&](const tbb::blocked_range<std::uint32_t>& range) {
+			const std::uint32_t tapCount{ horizontalKernel.mTapCount };
+			for (std::uint32_t y = range.begin(); y != range.end(); ++y) {
+				const float* sourceRow{ sourceImage.mTexels.data() + static_cast<std::size_t>(y) * sourceWidth * 4UL };
+				float* row{ rowImage.mTexels.data() + static_cast<std::size_t>(y) * width * 4UL };
+				for (std::uint32_t x = 0U; x < width; ++x) {
+					const std::uint32_t* indices{ horizontalKernel.mIndices.data() + x * tapCount };
+					const float* weights{ horizontalKernel.mWeights.data() + x * tapCount };
+					__m128 sum{ _mm_setzero_ps() };
+					for (std::uint32_t i = 0U; i < tapCount; ++i) {
+						sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(weights[i]), _mm_loadu_ps(sourceRow + indices[i] * 4UL)));
+					}
+					_mm_storeu_ps(row + x * 4UL, sum);
+				}
+			}
+		});
+
+		tbb::parallel_for(tbb::blocked_range<std::uint32_t>(0U, image.mHeight),
+			[&](const tbb::blocked_range<std::uint32_t>& range) {
+			const std::uint32_t tapCount{ verticalKernel.mTapCount };
+			for (std::uint32_t y = range.begin(); y != range.end(); ++y) {
+				const std::uint32_t* indices{ verticalKernel.mIndices.data() + y * tapCount };
+				const float* weights{ verticalKernel.mWeights.data() + y * tapCount };
+				float* row{ image.mTexels.data() + static_cast<std::size_t>(y) * width * 4UL };
+				std::fill(row, row + width * 4UL, 0.0f);
+				for (std::uint32_t i = 0U; i < tapCount; ++i) {
+					if (weights[i] == 0.0f) {
+						continue;
+					}
+
+					const __m128 weight{ _mm_set1_ps(weights[i]) };
+					const float* sourceRow{ rowImage.mTexels.data() + static_cast<std::size_t>(indices[i]) * width * 4UL };
+					for (std::uint32_t x = 0U; x < width; ++x) {
+						_mm_storeu_ps(row + x * 4UL, _mm_add_ps(_mm_loadu_ps(row + x * 4UL), _mm_mul_ps(weight, _mm_loadu_ps(sourceRow + x * 4UL))));
+					}
+				}
+			}
+		});
+	}
+}
+
+namespace MipGenerator {
+	bool IsFormatSupported(const DXGI_FORMAT format) noexcept {
+		FormatInfo formatInfo;
+		return GetFormatInfo(format, formatInfo);
+	}
+
+	std::uint32_t GetFullMipCount(
+		const std::uint32_t width,
+		const std::uint32_t height) noexcept
+	{
+		std::uint32_t mipCount{ 1U };
+		for (std::uint32_t dimension = std::max<std::uint32_t>(width, height); dimension > 1U; dimension /= 2U) {
+			++mipCount;
+		}
+
+		return mipCount;
+	}
+
+	std::size_t GetMipsSize(
+		const std::uint32_t width,
+		const std::uint32_t height,
+		const DXGI_FORMAT format,
+		const std::uint32_t mipCount) noexcept
+	{
+		std::size_t size{ 0UL };
+		std::uint32_t mipWidth{ width };
+		std::uint32_t mipHeight{ height };
+		for (std::uint32_t i = 0U; i < mipCount; ++i) {
+			mipWidth = std::max<std::uint32_t>(mipWidth / 2U, 1U);
+			mipHeight = std::max<std::uint32_t>(mipHeight / 2U, 1U);
+			size += GetMipSize(mipWidth, mipHeight, format);
+		}
+
+		return size;
+	}
+
+	void GenerateMips(
+		const std::uint8_t* const* sourceSlices,
+		const std::uint32_t sliceCount,
+		const std::uint32_t width,
+		const std::uint32_t height,
+		const DXGI_FORMAT format,
+		const Filter filter,
+		const std::uint32_t mipCount,
+		std::uint8_t* mips) noexcept
+	{
+		ASSERT(sourceSlices != nullptr);
+		ASSERT(mips != nullptr);
+		ASSERT(mipCount < GetFullMipCount(width, height));
+
+		FormatInfo formatInfo;
+		const bool isFormatSupported{ GetFormatInfo(format, formatInfo) };
+		ASSERT(isFormatSupported);
+
+		// Kernels are the same for all the array slices
+		std::vector<Kernel> horizontalKernels(mipCount);
+		std::vector<Kernel> verticalKernels(mipCount);
+		std::uint32_t mipWidth{ width };
+		std::uint32_t mipHeight{ height };
+		for (std::uint32_t i = 0U; i < mipCount; ++i) {
+			ComputeKernel(mipWidth, std::max<std::uint32_t>(mipWidth / 2U, 1U), filter, horizontalKernels[i]);
+			ComputeKernel(mipHeight, std::max<std::uint32_t>(mipHeight / 2U, 1U), filter, verticalKernels[i]);
+			mipWidth = std::max<std::uint32_t>(mipWidth / 2U, 1U);
+			mipHeight = std::max<std::uint32_t>(mipHeight / 2U, 1U);
+		}
+
+		const std::size_t sliceMipsSize{ GetMipsSize(width, height, format, mipCount) };
+		tbb::parallel_for(tbb::blocked_range<std::uint32_t>(0U, sliceCount, 1U),
+			[&](const tbb::blocked_range<std::uint32_t>& range) {
+			Image sourceImage;
+			Image rowImage;
+			Image image;
+			std::vector<std::uint8_t> blockTexels;
+			for (std::uint32_t slice = range.begin(); slice != range.end(); ++slice) {
+				ASSERT(sourceSlices[slice] != nullptr);
+				sourceImage.mWidth = width;
+				sourceImage.mHeight = height;
+				LoadTexels(sourceSlices[slice], formatInfo, blockTexels, sourceImage);
+
+				// Mips are filtered from the previous mip, in floating point
+				std::uint8_t* mip{ mips + slice * sliceMipsSize };
+				for (std::uint32_t i = 0U; i < mipCount; ++i) {
+					image.mWidth = std::max<std::uint32_t>(sourceImage.mWidth / 2U, 1U);
+					image.mHeight = std::max<std::uint32_t>(sourceImage.mHeight / 2U, 1U);
+					FilterImage(sourceImage, horizontalKernels[i], verticalKernels[i], rowImage, image);
+					StoreTexels(image, formatInfo, blockTexels, mip);
+
+					mip += GetMipSize(image.mWidth, image.mHeight, format);
+					std::swap(sourceImage, image);
+				}
+			}
+		});
+	}
+}
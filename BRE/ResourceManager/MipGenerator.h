@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <dxgiformat.h>
+
+// To generate the mips of textures that do not have all their mips (for example, textures created
+// with a single mip). Each mip is filtered from the previous one, in 32 bits floating point, with a
+// separable filter: a box filter (texels are weighted by their area) or a Kaiser windowed sinc filter
+// (sharper). Texels of sRGB formats are filtered in linear space (gamma-correct), and texels beyond the
+// edges repeat the edge texels (so each face of a cube map is filtered independently).
+// Texels are filtered 4 channels at a time with SSE2, and rows and array slices are filtered in parallel (TBB).
+// Block compressed formats are decompressed and their mips are compressed again (see BlockCompressor).
+namespace MipGenerator {
+	enum class Filter {
+		BOX = 0,
+		KAISER
+	};
+
+	// 8 bits per channel formats (R8, R8G8, R8G8B8A8, B8G8R8A8 and B8G8R8X8, UNORM and sRGB),
+	// R32_FLOAT, R32G32B32A32_FLOAT, and BC1 to BC5 (UNORM and sRGB)
+	bool IsFormatSupported(const DXGI_FORMAT format) noexcept;
+
+	// Number of mips of a texture of "width" x "height" texels with all its mips (the last one is 1 x 1)
+	std::uint32_t GetFullMipCount(
+		const std::uint32_t width,
+		const std::uint32_t height) noexcept;
+
+	// Size in bytes of the "mipCount" mips that follow a mip of "width" x "height" texels, of an array slice
+	std::size_t GetMipsSize(
+		const std::uint32_t width,
+		const std::uint32_t height,
+		const DXGI_FORMAT format,
+		const std::uint32_t mipCount) noexcept;
+
+	// Generates the "mipCount" mips that follow a mip of "width" x "height" texels, of "sliceCount" array
+	// slices (6 per cube map). "sourceSlices" has the mip of each array slice. Mips are read and written with
+	// the layout of DDS files (see DDSTextureParser::GetSurfaceInfo()), and generated mips are written to "mips"
+	// slice after slice, so it must have "sliceCount" * GetMipsSize() bytes.
+	// Preconditions:
+	// - "sourceSlices" and "mips" must not be nullptr
+	// - "format" must be supported (see IsFormatSupported())
+	// - "mipCount" must not exceed the mips that follow the source mip
+	void GenerateMips(
+		const std::uint8_t* const* sourceSlices,
+		const std::uint32_t sliceCount,
+		const std::uint32_t width,
+		const std::uint32_t height,
+		const DXGI_FORMAT format,
+		const Filter filter,
+		const std::uint32_t mipCount,
+		std::uint8_t* mips) noexcept;
+}
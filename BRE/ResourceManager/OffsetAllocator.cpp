@@ -0,0 +1,110 @@
+#include "OffsetAllocator.h"
+
+#include <iterator>
+
+#include <Utils/DebugUtils.h>
+
+const std::uint32_t OffsetAllocator::sInvalidOffset;
+
+OffsetAllocator::OffsetAllocator(const std::uint32_t capacity)
+	: mCapacity(capacity)
+{
+	ASSERT(capacity > 0U);
+	ASSERT(capacity < sInvalidOffset);
+
+	AddFreeRangeLocked(0U, capacity);
+}
+
+std::uint32_t OffsetAllocator::Allocate(const std::uint32_t elementCount) noexcept {
+	ASSERT(elementCount > 0U);
+
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	// Smallest free range where it fits
+	const FreeRangesBySize::iterator bySizeIt{ mFreeRangesBySize.lower_bound(elementCount) };
+	if (bySizeIt == mFreeRangesBySize.end()) {
+		return sInvalidOffset;
+	}
+
+	const std::uint32_t freeRangeSize{ bySizeIt->first };
+	const std::uint32_t offset{ bySizeIt->second };
+	mFreeRangesBySize.erase(bySizeIt);
+	mFreeRangesByOffset.erase(offset);
+	mFreeSize -= freeRangeSize;
+
+	// The rest of the free range is still free
+	if (freeRangeSize > elementCount) {
+		AddFreeRangeLocked(offset + elementCount, freeRangeSize - elementCount);
+	}
+
+	return offset;
+}
+
+void OffsetAllocator::Free(const std::uint32_t offset, const std::uint32_t elementCount) noexcept {
+	ASSERT(elementCount > 0U);
+	ASSERT(offset < mCapacity);
+	ASSERT(elementCount <= mCapacity - offset);
+
+	std::uint32_t rangeOffset{ offset };
+	std::uint32_t rangeSize{ elementCount };
+
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	// Merge with the next free range
+	FreeRangesByOffset::iterator nextIt{ mFreeRangesByOffset.lower_bound(offset) };
+	ASSERT(nextIt == mFreeRangesByOffset.end() || nextIt->first >= offset + elementCount);
+	if (nextIt != mFreeRangesByOffset.end() && nextIt->first == offset + elementCount) {
+		rangeSize += nextIt->second->first;
+		mFreeSize -= nextIt->second->first;
+		mFreeRangesBySize.erase(nextIt->second);
+		nextIt = mFreeRangesByOffset.erase(nextIt);
+	}
+
+	// Merge with the previous free range
+	if (nextIt != mFreeRangesByOffset.begin()) {
+		const FreeRangesByOffset::iterator previousIt{ std::prev(nextIt) };
+		const std::uint32_t previousSize{ previousIt->second->first };
+		ASSERT(previousIt->first + previousSize <= offset);
+		if (previousIt->first + previousSize == offset) {
+			rangeOffset = previousIt->first;
+			rangeSize += previousSize;
+			mFreeSize -= previousSize;
+			mFreeRangesBySize.erase(previousIt->second);
+			mFreeRangesByOffset.erase(previousIt);
+		}
+	}
+
+	AddFreeRangeLocked(rangeOffset, rangeSize);
+}
+
+std::uint32_t OffsetAllocator::GetFreeSize() const noexcept {
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mFreeSize;
+}
+
+std::uint32_t OffsetAllocator::GetFreeRangeCount() const noexcept {
+	std::lock_guard<std::mutex> lock(mMutex);
+	return static_cast<std::uint32_t>(mFreeRangesByOffset.size());
+}
+
+std::uint32_t OffsetAllocator::GetLargestFreeRangeSize() const noexcept {
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mFreeRangesBySize.empty() ? 0U : mFreeRangesBySize.rbegin()->first;
+}
+
+float OffsetAllocator::GetFragmentation() const noexcept {
+	std::lock_guard<std::mutex> lock(mMutex);
+	if (mFreeSize == 0U) {
+		return 0.0f;
+	}
+
+	return 1.0f - static_cast<float>(mFreeRangesBySize.rbegin()->first) / static_cast<float>(mFreeSize);
+}
+
+void OffsetAllocator::AddFreeRangeLocked(const std::uint32_t offset, const std::uint32_t elementCount) noexcept {
+	ASSERT(elementCount > 0U);
+
+	const FreeRangesBySize::iterator bySizeIt{ mFreeRangesBySize.emplace(elementCount, offset) };
+	mFreeRangesByOffset.emplace(offset, bySizeIt);
+	mFreeSize += elementCount;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+
+// To allocate ranges of [0, capacity) elements (for example, the vertices
+// of a vertex buffer that is shared by several meshes). 
+// Ranges are allocated best-fit (from the smallest free range where they fit), and 
+// freed ranges are merged with their neighbors, to keep fragmentation low.
+// Free ranges are sorted by size and by offset, so both operations are logarithmic.
+class OffsetAllocator {
+public:
+	static const std::uint32_t sInvalidOffset{ 0xFFFFFFFFU };
+
+	// Preconditions:
+	// - "capacity" must be greater than zero and less than sInvalidOffset
+	explicit OffsetAllocator(const std::uint32_t capacity);
+
+	~OffsetAllocator() = default;
+	OffsetAllocator(const OffsetAllocator&) = delete;
+	const OffsetAllocator& operator=(const OffsetAllocator&) = delete;
+	OffsetAllocator(OffsetAllocator&&) = delete;
+	OffsetAllocator& operator=(OffsetAllocator&&) = delete;
+
+	// Returns the offset of the first element of "elementCount" contiguous elements,
+	// or sInvalidOffset if there is no free range big enough. It is thread safe.
+	// Preconditions:
+	// - "elementCount" must be greater than zero
+	std::uint32_t Allocate(const std::uint32_t elementCount) noexcept;
+
+	// Frees a range returned by Allocate(). It is thread safe.
+	// Preconditions:
+	// - Range must have been returned by Allocate() and not freed
+	void Free(const std::uint32_t offset, const std::uint32_t elementCount) noexcept;
+
+	__forceinline std::uint32_t GetCapacity() const noexcept { return mCapacity; }
+
+	// Fragmentation statistics. They are thread safe.
+	std::uint32_t GetFreeSize() const noexcept;
+	std::uint32_t GetFreeRangeCount() const noexcept;
+	std::uint32_t GetLargestFreeRangeSize() const noexcept;
+
+	// 0.0 if free elements are contiguous, and close to 1.0 if they
+	// are split in many small ranges (1 - largest free range size / free size)
+	float GetFragmentation() const noexcept;
+
+private:
+	// Preconditions:
+	// - mMutex must be locked
+	void AddFreeRangeLocked(const std::uint32_t offset, const std::uint32_t elementCount) noexcept;
+
+	// Free ranges by size (to find the best fit) and by offset (to merge neighbors).
+	// Each free range by offset has its position in the free ranges by size, to erase it.
+	using FreeRangesBySize = std::multimap<std::uint32_t, std::uint32_t>;
+	using FreeRangesByOffset = std::map<std::uint32_t, FreeRangesBySize::iterator>;
+
+	std::uint32_t mCapacity{ 0U };
+	std::uint32_t mFreeSize{ 0U };
+
+	mutable std::mutex mMutex;
+	FreeRangesBySize mFreeRangesBySize;
+	FreeRangesByOffset mFreeRangesByOffset;
+};
@@ -0,0 +1,228 @@
+#include "ResidencyScheduler.h"
+
+#include <algorithm>
+
+#include <Utils/DebugUtils.h>
+
+ResidencyScheduler::ResidencyScheduler(
+	const std::uint64_t memoryBudget,
+	const std::uint32_t minIdleFrameCount,
+	const std::uint32_t demotionIdleFrameCount)
+	: mMemoryBudget(memoryBudget)
+	, mMinIdleFrameCount(minIdleFrameCount)
+	, mDemotionIdleFrameCount(demotionIdleFrameCount)
+{
+	ASSERT(demotionIdleFrameCount > 0U);
+}
+
+std::uint32_t ResidencyScheduler::AddPageable(
+	const std::uint64_t size,
+	const Category category,
+	const std::uint64_t frameIndex) noexcept
+{
+	ASSERT(category < Category::COUNT);
+
+	std::uint32_t pageableId{ 0U };
+	if (mFreePageableIds.empty()) {
+		pageableId = static_cast<std::uint32_t>(mPageables.size());
+		mPageables.push_back(Pageable());
+	} else {
+		pageableId = mFreePageableIds.back();
+		mFreePageableIds.pop_back();
+	}
+
+	Pageable& pageable{ mPageables[pageableId] };
+	pageable.mSize = size;
+	pageable.mLastUsedFrame = frameIndex;
+	pageable.mCategory = category;
+	pageable.mIsAlive = true;
+	pageable.mIsResident = true;
+	pageable.mIsEvictable = false;
+
+	CategoryStatistics& categoryStatistics{ mStatistics.mCategories[static_cast<std::uint32_t>(category)] };
+	++categoryStatistics.mPageableCount;
+	++categoryStatistics.mResidentPageableCount;
+	categoryStatistics.mSize += size;
+	categoryStatistics.mResidentSize += size;
+
+	if (IsBudgeted(category)) {
+		mResidentSize += size;
+	}
+
+	return pageableId;
+}
+
+void ResidencyScheduler::RemovePageable(const std::uint32_t pageableId) noexcept {
+	ASSERT(pageableId < mPageables.size());
+
+	Pageable& pageable{ mPageables[pageableId] };
+	ASSERT(pageable.mIsAlive);
+
+	CategoryStatistics& categoryStatistics{ mStatistics.mCategories[static_cast<std::uint32_t>(pageable.mCategory)] };
+	ASSERT(categoryStatistics.mPageableCount > 0U);
+	--categoryStatistics.mPageableCount;
+	categoryStatistics.mSize -= pageable.mSize;
+	if (pageable.mIsDemoted) {
+		categoryStatistics.mDemotedSize -= pageable.mSize;
+	}
+	if (pageable.mIsResident) {
+		--categoryStatistics.mResidentPageableCount;
+		categoryStatistics.mResidentSize -= pageable.mSize;
+		if (IsBudgeted(pageable.mCategory)) {
+			ASSERT(mResidentSize >= pageable.mSize);
+			mResidentSize -= pageable.mSize;
+		}
+	}
+
+	pageable = Pageable();
+	mFreePageableIds.push_back(pageableId);
+}
+
+void ResidencyScheduler::SetEvictable(const std::uint32_t pageableId, const bool isEvictable) noexcept {
+	ASSERT(pageableId < mPageables.size());
+
+	Pageable& pageable{ mPageables[pageableId] };
+	ASSERT(pageable.mIsAlive);
+	pageable.mIsEvictable = isEvictable && IsBudgeted(pageable.mCategory);
+	if (pageable.mIsEvictable == false && pageable.mIsDemoted) {
+		Promote(pageableId);
+	}
+}
+
+bool ResidencyScheduler::MarkUsed(const std::uint32_t pageableId, const std::uint64_t frameIndex) noexcept {
+	ASSERT(pageableId < mPageables.size());
+
+	Pageable& pageable{ mPageables[pageableId] };
+	ASSERT(pageable.mIsAlive);
+	pageable.mLastUsedFrame = std::max<std::uint64_t>(pageable.mLastUsedFrame, frameIndex);
+	if (pageable.mIsDemoted) {
+		Promote(pageableId);
+	}
+
+	if (pageable.mIsResident) {
+		return false;
+	}
+
+	pageable.mIsResident = true;
+
+	CategoryStatistics& categoryStatistics{ mStatistics.mCategories[static_cast<std::uint32_t>(pageable.mCategory)] };
+	++categoryStatistics.mResidentPageableCount;
+	categoryStatistics.mResidentSize += pageable.mSize;
+	mResidentSize += pageable.mSize;
+
+	++mStatistics.mMakeResidentCount;
+	mStatistics.mMadeResidentSize += pageable.mSize;
+
+	return true;
+}
+
+void ResidencyScheduler::ScheduleChanges(
+	const std::uint64_t frameIndex,
+	const std::uint64_t completedFrameIndex,
+	Changes& changes) noexcept
+{
+	ASSERT(completedFrameIndex < frameIndex);
+
+	// Steps:
+	// - Report the promoted pageables that are still alive
+	// - Demote the idle pageables, and collect the resident pageables that can be evicted
+	// - Sort them from the least recently used one
+	// - Evict them until the resident size fits in the budget
+	for (const std::uint32_t pageableId : mPromotedPageableIds) {
+		if (mPageables[pageableId].mIsAlive) {
+			changes.mPromotedPageableIds.push_back(pageableId);
+		}
+	}
+	mPromotedPageableIds.clear();
+
+	const bool isOverBudget{ mResidentSize > mMemoryBudget };
+	mCandidates.clear();
+	const std::uint32_t pageableCount{ static_cast<std::uint32_t>(mPageables.size()) };
+	for (std::uint32_t i = 0U; i < pageableCount; ++i) {
+		Pageable& pageable{ mPageables[i] };
+		if (pageable.mIsResident == false || pageable.mIsEvictable == false) {
+			continue;
+		}
+
+		if (pageable.mIsDemoted == false && pageable.mLastUsedFrame + mDemotionIdleFrameCount < frameIndex) {
+			pageable.mIsDemoted = true;
+			mStatistics.mCategories[static_cast<std::uint32_t>(pageable.mCategory)].mDemotedSize += pageable.mSize;
+			changes.mDemotedPageableIds.push_back(i);
+		}
+
+		if (isOverBudget == false) {
+			continue;
+		}
+
+		if (pageable.mLastUsedFrame > completedFrameIndex ||
+			pageable.mLastUsedFrame + mMinIdleFrameCount >= frameIndex)
+		{
+			continue;
+		}
+
+		Candidate candidate;
+		candidate.mLastUsedFrame = pageable.mLastUsedFrame;
+		candidate.mPageableId = i;
+		mCandidates.push_back(candidate);
+	}
+
+	std::sort(
+		mCandidates.begin(),
+		mCandidates.end(),
+		[](const Candidate& a, const Candidate& b) {
+			if (a.mLastUsedFrame != b.mLastUsedFrame) {
+				return a.mLastUsedFrame < b.mLastUsedFrame;
+			}
+			return a.mPageableId < b.mPageableId;
+		});
+
+	for (const Candidate& candidate : mCandidates) {
+		if (mResidentSize <= mMemoryBudget) {
+			break;
+		}
+
+		Pageable& pageable{ mPageables[candidate.mPageableId] };
+		pageable.mIsResident = false;
+
+		CategoryStatistics& categoryStatistics{ mStatistics.mCategories[static_cast<std::uint32_t>(pageable.mCategory)] };
+		--categoryStatistics.mResidentPageableCount;
+		categoryStatistics.mResidentSize -= pageable.mSize;
+		ASSERT(mResidentSize >= pageable.mSize);
+		mResidentSize -= pageable.mSize;
+
+		++mStatistics.mEvictionCount;
+		mStatistics.mEvictedSize += pageable.mSize;
+
+		changes.mEvictedPageableIds.push_back(candidate.mPageableId);
+	}
+}
+
+bool ResidencyScheduler::IsResident(const std::uint32_t pageableId) const noexcept {
+	ASSERT(pageableId < mPageables.size());
+	ASSERT(mPageables[pageableId].mIsAlive);
+
+	return mPageables[pageableId].mIsResident;
+}
+
+bool ResidencyScheduler::IsDemoted(const std::uint32_t pageableId) const noexcept {
+	ASSERT(pageableId < mPageables.size());
+	ASSERT(mPageables[pageableId].mIsAlive);
+
+	return mPageables[pageableId].mIsDemoted;
+}
+
+ResidencyScheduler::Statistics ResidencyScheduler::GetStatistics() const noexcept {
+	Statistics statistics(mStatistics);
+	statistics.mMemoryBudget = mMemoryBudget;
+	statistics.mResidentSize = mResidentSize;
+
+	return statistics;
+}
+
+void ResidencyScheduler::Promote(const std::uint32_t pageableId) noexcept {
+	Pageable& pageable{ mPageables[pageableId] };
+	ASSERT(pageable.mIsDemoted);
+	pageable.mIsDemoted = false;
+	mStatistics.mCategories[static_cast<std::uint32_t>(pageable.mCategory)].mDemotedSize -= pageable.mSize;
+	mPromotedPageableIds.push_back(pageableId);
+}
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// To decide which pageables (heaps and committed resources) are resident within a memory budget.
+// Pageables are used in frames (see MarkUsed()), and ScheduleChanges() evicts the least recently used
+// pageables while the resident size exceeds the budget:
+// - Only evictable pageables are evicted (see SetEvictable()). New pageables are not evictable.
+// - Pageables used in frames that the GPU did not complete are not evicted.
+// - Pageables used in the last "minIdleFrameCount" frames are not evicted, to avoid evicting and
+//   making resident the same pageables every frame when the budget is too small.
+// Evictable pageables that were not used in the last "demotionIdleFrameCount" frames are demoted
+// (their residency priority is lowered, so the OS pages them out first), and they are promoted
+// again when they are used. An evicted pageable is made resident again when it is used.
+// Pageables of the UPLOAD category live in system memory: they are reported, but they
+// do not count against the budget and they are never evicted.
+class ResidencyScheduler {
+public:
+	enum class Category {
+		TEXTURE = 0,
+		BUFFER,
+		RENDER_TARGET,
+		UPLOAD,
+		COUNT
+	};
+
+	struct CategoryStatistics {
+		std::uint32_t mPageableCount{ 0U };
+		std::uint32_t mResidentPageableCount{ 0U };
+		std::uint64_t mSize{ 0UL };
+		std::uint64_t mResidentSize{ 0UL };
+
+		// Size of the demoted pageables (resident or not)
+		std::uint64_t mDemotedSize{ 0UL };
+	};
+
+	// Pageables whose residency or priority changed
+	struct Changes {
+		std::vector<std::uint32_t> mEvictedPageableIds;
+		std::vector<std::uint32_t> mDemotedPageableIds;
+		std::vector<std::uint32_t> mPromotedPageableIds;
+	};
+
+	struct Statistics {
+		CategoryStatistics mCategories[static_cast<std::uint32_t>(Category::COUNT)];
+		std::uint64_t mMemoryBudget{ 0UL };
+
+		// Resident size of the pageables that count against the budget
+		std::uint64_t mResidentSize{ 0UL };
+
+		// Since the scheduler was created
+		std::uint64_t mEvictionCount{ 0UL };
+		std::uint64_t mEvictedSize{ 0UL };
+		std::uint64_t mMakeResidentCount{ 0UL };
+		std::uint64_t mMadeResidentSize{ 0UL };
+	};
+
+	// Preconditions:
+	// - "demotionIdleFrameCount" must be greater than zero
+	explicit ResidencyScheduler(
+		const std::uint64_t memoryBudget,
+		const std::uint32_t minIdleFrameCount,
+		const std::uint32_t demotionIdleFrameCount);
+	~ResidencyScheduler() = default;
+	ResidencyScheduler(const ResidencyScheduler&) = delete;
+	const ResidencyScheduler& operator=(const ResidencyScheduler&) = delete;
+	ResidencyScheduler(ResidencyScheduler&&) = delete;
+	ResidencyScheduler& operator=(ResidencyScheduler&&) = delete;
+
+	// Returns the identifier of the pageable. Identifiers of removed pageables are reused.
+	// The pageable is resident, it is not evictable, and it is used in "frameIndex".
+	std::uint32_t AddPageable(
+		const std::uint64_t size,
+		const Category category,
+		const std::uint64_t frameIndex) noexcept;
+
+	// Preconditions:
+	// - "pageableId" must be returned by AddPageable() and not removed
+	void RemovePageable(const std::uint32_t pageableId) noexcept;
+
+	// Pageables must be evictable only if every use of them is marked (see MarkUsed()).
+	// Pageables that are not evictable are not demoted either.
+	// Preconditions:
+	// - "pageableId" must be returned by AddPageable() and not removed
+	void SetEvictable(const std::uint32_t pageableId, const bool isEvictable) noexcept;
+
+	// The pageable is used in "frameIndex". It returns true if it was evicted, and then
+	// it must be made resident before the GPU uses it.
+	// Preconditions:
+	// - "pageableId" must be returned by AddPageable() and not removed
+	bool MarkUsed(const std::uint32_t pageableId, const std::uint64_t frameIndex) noexcept;
+
+	// Demotes the idle pageables, and appends them and the pageables promoted since the previous call
+	// to "changes". If the resident size exceeds the budget, then evicts pageables used in frames less
+	// or equal than "completedFrameIndex", from the least recently used one, and appends them to "changes".
+	// "frameIndex" is the frame whose uses are being marked.
+	// Preconditions:
+	// - "completedFrameIndex" must be less than "frameIndex"
+	void ScheduleChanges(
+		const std::uint64_t frameIndex,
+		const std::uint64_t completedFrameIndex,
+		Changes& changes) noexcept;
+
+	// Next call to ScheduleChanges() evicts pageables if resident pageables do not fit in the new budget
+	__forceinline void SetMemoryBudget(const std::uint64_t memoryBudget) noexcept { mMemoryBudget = memoryBudget; }
+	__forceinline std::uint64_t GetMemoryBudget() const noexcept { return mMemoryBudget; }
+
+	// Resident size of the pageables that count against the budget
+	__forceinline std::uint64_t GetResidentSize() const noexcept { return mResidentSize; }
+
+	bool IsResident(const std::uint32_t pageableId) const noexcept;
+	bool IsDemoted(const std::uint32_t pageableId) const noexcept;
+
+	Statistics GetStatistics() const noexcept;
+
+private:
+	struct Pageable {
+		std::uint64_t mSize{ 0UL };
+		std::uint64_t mLastUsedFrame{ 0UL };
+		Category mCategory{ Category::TEXTURE };
+		bool mIsAlive{ false };
+		bool mIsResident{ false };
+		bool mIsEvictable{ false };
+		bool mIsDemoted{ false };
+	};
+
+	struct Candidate {
+		std::uint64_t mLastUsedFrame{ 0UL };
+		std::uint32_t mPageableId{ 0U };
+	};
+
+	static bool IsBudgeted(const Category category) noexcept { return category != Category::UPLOAD; }
+
+	// Restores the priority of a demoted pageable in the next ScheduleChanges()
+	void Promote(const std::uint32_t pageableId) noexcept;
+
+	std::vector<Pageable> mPageables;
+	std::vector<std::uint32_t> mFreePageableIds;
+
+	// Pageables promoted since the previous ScheduleChanges(), and the eviction candidates of the current one
+	std::vector<std::uint32_t> mPromotedPageableIds;
+	std::vector<Candidate> mCandidates;
+
+	Statistics mStatistics;
+
+	std::uint64_t mMemoryBudget{ 0UL };
+	std::uint64_t mResidentSize{ 0UL };
+	std::uint32_t mMinIdleFrameCount{ 0U };
+	std::uint32_t mDemotionIdleFrameCount{ 0U };
+};
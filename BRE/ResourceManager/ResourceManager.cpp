@@ -1,72 +1,412 @@
 #include "ResourceManager.h"
 
+#include <algorithm>
+
 #include <DirectXManager/DirectXManager.h>
 #include <DXUtils/d3dx12.h>
 #include <ResourceManager\DDSTextureLoader.h>
+#include <ResourceManager/TransferManager.h>
 #include <ResourceStateManager\ResourceStateManager.h>
 #include <SettingsManager\SettingsManager.h>
 #include <Utils/DebugUtils.h>
-#include <Utils\StringUtils.h>
+#include <Utils/MemoryMappedFile.h>
 
+const std::uint64_t ResourceManager::sResourceHeapSize;
 ResourceManager::Resources ResourceManager::mResources;
+ResourceManager::Heaps ResourceManager::mHeaps;
 std::mutex ResourceManager::mMutex;
+std::vector<ResourceManager::ResourceHeap*> ResourceManager::mResourceHeaps;
+std::unordered_map<ID3D12Resource*, ResourceManager::PlacedAllocation> ResourceManager::mPlacedAllocations;
+std::uint64_t ResourceManager::mResourceHeapUsedSize{ 0UL };
+std::uint64_t ResourceManager::mResourceHeapPeakUsedSize{ 0UL };
+std::mutex ResourceManager::mResourceHeapMutex;
+ResidencyScheduler ResourceManager::mResidencyScheduler(
+	0UL, 
+	SettingsManager::sResidencyMinIdleFrameCount, 
+	SettingsManager::sResidencyDemotionIdleFrameCount);
+std::unordered_map<ID3D12Pageable*, std::uint32_t> ResourceManager::mPageableIds;
+std::unordered_set<ID3D12Pageable*> ResourceManager::mKeptResidentPageables;
+std::vector<ID3D12Pageable*> ResourceManager::mPageablesById;
+std::uint64_t ResourceManager::mResidencyFrameIndex{ 1UL };
+std::mutex ResourceManager::mResidencyMutex;
+Microsoft::WRL::ComPtr<IDXGIAdapter3> ResourceManager::mAdapter;
+Microsoft::WRL::ComPtr<ID3D12Device1> ResourceManager::mDevice1;
+bool ResourceManager::mIsDevice1Queried{ false };
+
+namespace {
+	ResidencyScheduler::Category GetHeapCategory(const D3D12_HEAP_DESC& heapDescriptor) noexcept {
+		const D3D12_HEAP_TYPE heapType{ heapDescriptor.Properties.Type };
+		if (heapType == D3D12_HEAP_TYPE_UPLOAD || heapType == D3D12_HEAP_TYPE_READBACK) {
+			return ResidencyScheduler::Category::UPLOAD;
+		}
+
+		if ((heapDescriptor.Flags & D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS) == D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS) {
+			return ResidencyScheduler::Category::BUFFER;
+		}
+
+		if ((heapDescriptor.Flags & D3D12_HEAP_FLAG_ALLOW_ONLY_NON_RT_DS_TEXTURES) == D3D12_HEAP_FLAG_ALLOW_ONLY_NON_RT_DS_TEXTURES) {
+			return ResidencyScheduler::Category::TEXTURE;
+		}
+
+		return ResidencyScheduler::Category::RENDER_TARGET;
+	}
+
+	ResidencyScheduler::Category GetResourceCategory(
+		const D3D12_HEAP_TYPE heapType,
+		const D3D12_RESOURCE_DESC& resourceDescriptor) noexcept
+	{
+		if (heapType == D3D12_HEAP_TYPE_UPLOAD || heapType == D3D12_HEAP_TYPE_READBACK) {
+			return ResidencyScheduler::Category::UPLOAD;
+		}
+
+		if (resourceDescriptor.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER) {
+			return ResidencyScheduler::Category::BUFFER;
+		}
+
+		const D3D12_RESOURCE_FLAGS renderTargetFlags{
+			D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET | D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL };
+		if ((resourceDescriptor.Flags & renderTargetFlags) != 0U) {
+			return ResidencyScheduler::Category::RENDER_TARGET;
+		}
+
+		return ResidencyScheduler::Category::TEXTURE;
+	}
+}
 
 void ResourceManager::EraseAll() noexcept {
 	for (ID3D12Resource* resource : mResources) {
 		ASSERT(resource != nullptr);
 		resource->Release();
 	}
+
+	// Heaps are released after their placed resources
+	for (ID3D12Heap* heap : mHeaps) {
+		ASSERT(heap != nullptr);
+		heap->Release();
+	}
+
+	for (ResourceHeap* resourceHeap : mResourceHeaps) {
+		ASSERT(resourceHeap != nullptr);
+		delete resourceHeap;
+	}
+	mResourceHeaps.clear();
+	mPlacedAllocations.clear();
+	mResourceHeapUsedSize = 0UL;
+
+	for (const std::pair<ID3D12Pageable* const, std::uint32_t>& pageableId : mPageableIds) {
+		mResidencyScheduler.RemovePageable(pageableId.second);
+	}
+	mPageableIds.clear();
+	mKeptResidentPageables.clear();
+	mPageablesById.clear();
+	mAdapter.Reset();
+	mDevice1.Reset();
+	mIsDevice1Queried = false;
+}
+
+void ResourceManager::ReleaseResource(ID3D12Resource& resource) noexcept {
+	ASSERT(mResources.count(&resource) == 1UL);
+
+	mResourceHeapMutex.lock();
+	const std::unordered_map<ID3D12Resource*, PlacedAllocation>::iterator it{ mPlacedAllocations.find(&resource) };
+	if (it != mPlacedAllocations.end()) {
+		ResourceHeap& resourceHeap{ *it->second.mResourceHeap };
+		resourceHeap.mAllocator.Free(it->second.mHandle);
+		ASSERT(mResourceHeapUsedSize >= it->second.mSize);
+		mResourceHeapUsedSize -= it->second.mSize;
+
+		if (it->second.mIsMarked == false) {
+			ASSERT(resourceHeap.mUnmarkedResourceCount > 0U);
+			--resourceHeap.mUnmarkedResourceCount;
+			if (resourceHeap.mUnmarkedResourceCount == 0U) {
+				std::lock_guard<std::mutex> lock(mResidencyMutex);
+				mResidencyScheduler.SetEvictable(resourceHeap.mPageableId, true);
+			}
+		}
+
+		mPlacedAllocations.erase(it);
+	} else {
+		std::lock_guard<std::mutex> lock(mResidencyMutex);
+		const std::unordered_map<ID3D12Pageable*, std::uint32_t>::iterator pageableIt{ mPageableIds.find(&resource) };
+		if (pageableIt != mPageableIds.end()) {
+			mResidencyScheduler.RemovePageable(pageableIt->second);
+			mPageablesById[pageableIt->second] = nullptr;
+			mPageableIds.erase(pageableIt);
+			mKeptResidentPageables.erase(&resource);
+		}
+	}
+	mResourceHeapMutex.unlock();
+
+	ResourceStateManager::RemoveResource(resource);
+	mResources.unsafe_erase(&resource);
+	resource.Release();
+}
+
+ResourceManager::HeapStatistics ResourceManager::GetHeapStatistics() noexcept {
+	HeapStatistics statistics;
+
+	std::lock_guard<std::mutex> lock(mResourceHeapMutex);
+	statistics.mHeapCount = static_cast<std::uint32_t>(mResourceHeaps.size());
+	statistics.mPlacedResourceCount = static_cast<std::uint32_t>(mPlacedAllocations.size());
+	statistics.mHeapSize = statistics.mHeapCount * sResourceHeapSize;
+	statistics.mUsedSize = mResourceHeapUsedSize;
+	statistics.mPeakUsedSize = mResourceHeapPeakUsedSize;
+
+	const std::uint64_t freeSize{ statistics.mHeapSize - statistics.mUsedSize };
+	if (freeSize > 0UL) {
+		for (const ResourceHeap* resourceHeap : mResourceHeaps) {
+			ASSERT(resourceHeap != nullptr);
+			const std::uint64_t heapFreeSize{ sResourceHeapSize - resourceHeap->mAllocator.GetUsedSize() };
+			statistics.mFragmentation += 
+				resourceHeap->mAllocator.GetFragmentation() * static_cast<float>(heapFreeSize) / static_cast<float>(freeSize);
+		}
+	}
+
+	return statistics;
+}
+
+void ResourceManager::MarkResourcesUsed(
+	ID3D12Resource* const* resources,
+	const std::uint32_t resourceCount) noexcept
+{
+	ASSERT(resources != nullptr || resourceCount == 0U);
+
+	std::vector<ID3D12Pageable*> pageablesToMakeResident;
+
+	mResourceHeapMutex.lock();
+	mResidencyMutex.lock();
+	for (std::uint32_t i = 0U; i < resourceCount; ++i) {
+		ID3D12Resource* resource{ resources[i] };
+		ASSERT(resource != nullptr);
+
+		std::uint32_t pageableId{ 0U };
+		const std::unordered_map<ID3D12Resource*, PlacedAllocation>::iterator it{ mPlacedAllocations.find(resource) };
+		if (it != mPlacedAllocations.end()) {
+			ResourceHeap& resourceHeap{ *it->second.mResourceHeap };
+			pageableId = resourceHeap.mPageableId;
+			if (it->second.mIsMarked == false && it->second.mIsKeptResident == false) {
+				it->second.mIsMarked = true;
+				ASSERT(resourceHeap.mUnmarkedResourceCount > 0U);
+				--resourceHeap.mUnmarkedResourceCount;
+				if (resourceHeap.mUnmarkedResourceCount == 0U) {
+					mResidencyScheduler.SetEvictable(pageableId, true);
+				}
+			}
+		} else {
+			const std::unordered_map<ID3D12Pageable*, std::uint32_t>::iterator pageableIt{ mPageableIds.find(resource) };
+			if (pageableIt == mPageableIds.end()) {
+				// It is placed in a heap created with CreateHeap()
+				continue;
+			}
+			pageableId = pageableIt->second;
+			if (mKeptResidentPageables.count(resource) == 0UL) {
+				mResidencyScheduler.SetEvictable(pageableId, true);
+			}
+		}
+
+		if (mResidencyScheduler.MarkUsed(pageableId, mResidencyFrameIndex)) {
+			pageablesToMakeResident.push_back(mPageablesById[pageableId]);
+		}
+	}
+	mResidencyMutex.unlock();
+	mResourceHeapMutex.unlock();
+
+	// It waits until the pageables are resident, so no lock is held. They are not evicted 
+	// in the meantime, because they are used in a frame that the GPU did not complete.
+	if (pageablesToMakeResident.empty() == false) {
+		CHECK_HR(DirectXManager::GetDevice().MakeResident(
+			static_cast<std::uint32_t>(pageablesToMakeResident.size()), 
+			pageablesToMakeResident.data()));
+	}
+}
+
+void ResourceManager::KeepResourcesResident(
+	ID3D12Resource* const* resources,
+	const std::uint32_t resourceCount) noexcept
+{
+	ASSERT(resources != nullptr || resourceCount == 0U);
+
+	std::vector<ID3D12Pageable*> pageablesToMakeResident;
+
+	mResourceHeapMutex.lock();
+	mResidencyMutex.lock();
+	for (std::uint32_t i = 0U; i < resourceCount; ++i) {
+		ID3D12Resource* resource{ resources[i] };
+		ASSERT(resource != nullptr);
+
+		std::uint32_t pageableId{ 0U };
+		const std::unordered_map<ID3D12Resource*, PlacedAllocation>::iterator it{ mPlacedAllocations.find(resource) };
+		if (it != mPlacedAllocations.end()) {
+			// The heap is not evictable while it has an unmarked resource
+			ResourceHeap& resourceHeap{ *it->second.mResourceHeap };
+			pageableId = resourceHeap.mPageableId;
+			it->second.mIsKeptResident = true;
+			if (it->second.mIsMarked) {
+				it->second.mIsMarked = false;
+				++resourceHeap.mUnmarkedResourceCount;
+			}
+		} else {
+			const std::unordered_map<ID3D12Pageable*, std::uint32_t>::iterator pageableIt{ mPageableIds.find(resource) };
+			if (pageableIt == mPageableIds.end()) {
+				// It is placed in a heap created with CreateHeap()
+				continue;
+			}
+			pageableId = pageableIt->second;
+			mKeptResidentPageables.insert(resource);
+		}
+
+		mResidencyScheduler.SetEvictable(pageableId, false);
+		if (mResidencyScheduler.MarkUsed(pageableId, mResidencyFrameIndex)) {
+			pageablesToMakeResident.push_back(mPageablesById[pageableId]);
+		}
+	}
+	mResidencyMutex.unlock();
+	mResourceHeapMutex.unlock();
+
+	if (pageablesToMakeResident.empty() == false) {
+		CHECK_HR(DirectXManager::GetDevice().MakeResident(
+			static_cast<std::uint32_t>(pageablesToMakeResident.size()), 
+			pageablesToMakeResident.data()));
+	}
+}
+
+void ResourceManager::UpdateResidency(
+	const std::uint64_t frameIndex,
+	const std::uint64_t completedFrameIndex) noexcept
+{
+	std::uint64_t memoryBudget{ SettingsManager::sResidencyMemoryBudget };
+	if (memoryBudget == 0UL) {
+		// The budget that the OS gives to the process changes with the other processes
+		if (mAdapter.Get() == nullptr) {
+			CHECK_HR(DirectXManager::GetIDXGIFactory().EnumAdapterByLuid(
+				DirectXManager::GetDevice().GetAdapterLuid(), 
+				IID_PPV_ARGS(mAdapter.GetAddressOf())));
+		}
+
+		DXGI_QUERY_VIDEO_MEMORY_INFO videoMemoryInfo{};
+		CHECK_HR(mAdapter->QueryVideoMemoryInfo(0U, DXGI_MEMORY_SEGMENT_GROUP_LOCAL, &videoMemoryInfo));
+		memoryBudget = videoMemoryInfo.Budget;
+	}
+
+	// Residency priorities need ID3D12Device1 (Windows 10 Anniversary Update). 
+	// Without it, idle pageables are not demoted.
+	if (mIsDevice1Queried == false) {
+		DirectXManager::GetDevice().QueryInterface(IID_PPV_ARGS(mDevice1.GetAddressOf()));
+		mIsDevice1Queried = true;
+	}
+
+	ResidencyScheduler::Changes changes;
+
+	std::lock_guard<std::mutex> lock(mResidencyMutex);
+	mResidencyFrameIndex = frameIndex;
+	mResidencyScheduler.SetMemoryBudget(memoryBudget);
+	mResidencyScheduler.ScheduleChanges(frameIndex, completedFrameIndex, changes);
+
+	std::vector<ID3D12Pageable*> pageables;
+	std::vector<D3D12_RESIDENCY_PRIORITY> priorities;
+	if (mDevice1.Get() != nullptr) {
+		for (const std::uint32_t pageableId : changes.mDemotedPageableIds) {
+			pageables.push_back(mPageablesById[pageableId]);
+			priorities.push_back(D3D12_RESIDENCY_PRIORITY_LOW);
+		}
+		for (const std::uint32_t pageableId : changes.mPromotedPageableIds) {
+			pageables.push_back(mPageablesById[pageableId]);
+			priorities.push_back(D3D12_RESIDENCY_PRIORITY_NORMAL);
+		}
+
+		if (pageables.empty() == false) {
+			mMutex.lock();
+			CHECK_HR(mDevice1->SetResidencyPriority(
+				static_cast<std::uint32_t>(pageables.size()), 
+				pageables.data(), 
+				priorities.data()));
+			mMutex.unlock();
+		}
+	}
+
+	if (changes.mEvictedPageableIds.empty()) {
+		return;
+	}
+
+	pageables.clear();
+	for (const std::uint32_t pageableId : changes.mEvictedPageableIds) {
+		ASSERT(mPageablesById[pageableId] != nullptr);
+		pageables.push_back(mPageablesById[pageableId]);
+	}
+
+	mMutex.lock();
+	CHECK_HR(DirectXManager::GetDevice().Evict(
+		static_cast<std::uint32_t>(pageables.size()), 
+		pageables.data()));
+	mMutex.unlock();
+}
+
+ResidencyScheduler::Statistics ResourceManager::GetResidencyStatistics() noexcept {
+	std::lock_guard<std::mutex> lock(mResidencyMutex);
+	return mResidencyScheduler.GetStatistics();
 }
 
 ID3D12Resource& ResourceManager::LoadTextureFromFile(
 	const char* textureFilename, 
-	ID3D12GraphicsCommandList& commandList,
-	Microsoft::WRL::ComPtr<ID3D12Resource>& uploadBuffer,
 	const wchar_t* resourceName) noexcept
 {
-	ID3D12Resource* resource{ nullptr };
-
 	ASSERT(textureFilename != nullptr);
 	std::string filePath(SettingsManager::sResourcesPath);
 	filePath += textureFilename;
 
-	const std::wstring filePathW(StringUtils::ToWideString(filePath));
-	
-	Microsoft::WRL::ComPtr<ID3D12Resource> resourcePtr;
-	mMutex.lock();
-	CHECK_HR(DirectX::CreateDDSTextureFromFile12(
-		&DirectXManager::GetDevice(), 
-		&commandList, 
-		filePathW.c_str(), 
-		resourcePtr,
-		uploadBuffer));
-	mMutex.unlock();
+	// Subresources are uploaded from the mapped file, so the file is not copied.
+	// It can be closed after the call, because uploads are copied to the staging buffer.
+	MemoryMappedFile file;
+	const bool result{ file.Open(filePath.c_str()) };
+	ASSERT(result);
 
-	resource = resourcePtr.Detach();
+	return LoadTextureFromMemory(file.GetData(), file.GetSize(), resourceName);
+}
 
+ID3D12Resource& ResourceManager::LoadTextureFromMemory(
+	const std::uint8_t* textureData,
+	const std::size_t textureDataSize,
+	const wchar_t* resourceName) noexcept
+{
+	ASSERT(textureData != nullptr);
+	ASSERT(textureDataSize > 0UL);
+
+	Microsoft::WRL::ComPtr<ID3D12Resource> resourcePtr;
+	CHECK_HR(DirectX::CreateDDSTextureFromMemory12(
+		&DirectXManager::GetDevice(),
+		textureData,
+		textureDataSize,
+		resourcePtr));
+
+	ID3D12Resource* resource{ resourcePtr.Detach() };
 	ASSERT(resource != nullptr);
 	mResources.insert(resource);
 
+	const D3D12_RESOURCE_DESC resourceDescriptor{ resource->GetDesc() };
+	mMutex.lock();
+	const D3D12_RESOURCE_ALLOCATION_INFO allocationInfo =
+		DirectXManager::GetDevice().GetResourceAllocationInfo(0U, 1U, &resourceDescriptor);
+	mMutex.unlock();
+
+	mResidencyMutex.lock();
+	AddPageable(*resource, allocationInfo.SizeInBytes, ResidencyScheduler::Category::TEXTURE);
+	mResidencyMutex.unlock();
+
 	if (resourceName != nullptr) {
 		resource->SetName(resourceName);
 	}
-	
+
 	return *resource;
 }
 
 ID3D12Resource& ResourceManager::CreateDefaultBuffer(
-	ID3D12GraphicsCommandList& commandList,
 	const void* sourceData,
 	const std::size_t sourceDataSize,
-	Microsoft::WRL::ComPtr<ID3D12Resource>& uploadBuffer,
 	const wchar_t* resourceName) noexcept
 {
 	ASSERT(sourceData != nullptr);
 	ASSERT(sourceDataSize > 0);
 
-	ID3D12Resource* resource{ nullptr };
-	
-	// Create the actual default buffer resource.
 	D3D12_HEAP_PROPERTIES heapProps{};
 	heapProps.Type = D3D12_HEAP_TYPE_DEFAULT;
 	heapProps.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
@@ -74,55 +414,60 @@ ID3D12Resource& ResourceManager::CreateDefaultBuffer(
 	heapProps.CreationNodeMask = 1U;
 	heapProps.VisibleNodeMask = 1U;
 
-	CD3DX12_RESOURCE_DESC resDesc{ CD3DX12_RESOURCE_DESC::Buffer(sourceDataSize) };
-	mMutex.lock();
-	CHECK_HR(DirectXManager::GetDevice().CreateCommittedResource(
-		&heapProps,
+	// Buffer stays in common state: the copy queue and the draws implicitly promote it
+	const CD3DX12_RESOURCE_DESC resDesc{ CD3DX12_RESOURCE_DESC::Buffer(sourceDataSize) };
+	ID3D12Resource& resource = CreateCommittedResource(
+		heapProps,
 		D3D12_HEAP_FLAG_NONE,
-		&resDesc,
+		resDesc,
 		D3D12_RESOURCE_STATE_COMMON,
 		nullptr,
-		IID_PPV_ARGS(&resource)));
+		resourceName);
 
-	// In order to copy CPU memory data into our default buffer, we need to create
-	// an intermediate upload heap. 
-	heapProps = D3D12_HEAP_PROPERTIES{};
-	heapProps.Type = D3D12_HEAP_TYPE_UPLOAD;
-	heapProps.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
-	heapProps.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
-	heapProps.CreationNodeMask = 1U;
-	heapProps.VisibleNodeMask = 1U;
-	resDesc = CD3DX12_RESOURCE_DESC::Buffer(sourceDataSize);
+	TransferManager::UploadBuffer(resource, 0UL, sourceData, sourceDataSize);
+
+	return resource;
+}
 
+ID3D12Resource& ResourceManager::CreateCommittedResource(
+	const D3D12_HEAP_PROPERTIES& heapProperties,
+	const D3D12_HEAP_FLAGS& heapFlags,
+	const D3D12_RESOURCE_DESC& resourceDescriptor,
+	const D3D12_RESOURCE_STATES& resourceStates,
+	const D3D12_CLEAR_VALUE* clearValue,
+	const wchar_t* resourceName) noexcept
+{
+	ID3D12Resource* resource{ 
+		CreateResourceInResourceHeap(heapProperties, heapFlags, resourceDescriptor, resourceStates, clearValue, resourceName) 
+	};
+	if (resource != nullptr) {
+		return *resource;
+	}
+
+	mMutex.lock();
 	CHECK_HR(DirectXManager::GetDevice().CreateCommittedResource(
-		&heapProps,
-		D3D12_HEAP_FLAG_NONE,
-		&resDesc,
-		D3D12_RESOURCE_STATE_GENERIC_READ,
-		nullptr,
-		IID_PPV_ARGS(uploadBuffer.GetAddressOf())));
+		&heapProperties, 
+		heapFlags, 
+		&resourceDescriptor, 
+		resourceStates, 
+		clearValue, 
+		IID_PPV_ARGS(&resource)));
+	const D3D12_RESOURCE_ALLOCATION_INFO allocationInfo =
+		DirectXManager::GetDevice().GetResourceAllocationInfo(0U, 1U, &resourceDescriptor);
 	mMutex.unlock();
 
-	// Describe the data we want to copy into the default buffer.
-	D3D12_SUBRESOURCE_DATA subResourceData = {};
-	subResourceData.pData = sourceData;
-	subResourceData.RowPitch = sourceDataSize;
-	subResourceData.SlicePitch = subResourceData.RowPitch;
-
-	// Schedule to copy the data to the default buffer resource. At a high level, the helper function UpdateSubresources
-	// will copy the CPU memory into the intermediate upload heap.  Then, using ID3D12CommandList::CopySubresourceRegion,
-	// the intermediate upload heap data will be copied to mBuffer.
-	CD3DX12_RESOURCE_BARRIER resBarrier{ CD3DX12_RESOURCE_BARRIER::Transition(
-		resource, 
-		D3D12_RESOURCE_STATE_COMMON, D3D12_RESOURCE_STATE_COPY_DEST) };
-	commandList.ResourceBarrier(1, &resBarrier);
-	UpdateSubresources<1>(&commandList, resource, uploadBuffer.Get(), 0, 0, 1, &subResourceData);
-	resBarrier = CD3DX12_RESOURCE_BARRIER::Transition(resource, D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_GENERIC_READ);
-	commandList.ResourceBarrier(1, &resBarrier);
+	ResourceStateManager::AddResource(*resource, resourceStates);
 
 	ASSERT(resource != nullptr);
 	mResources.insert(resource);
 
+	mResidencyMutex.lock();
+	AddPageable(
+		*resource, 
+		allocationInfo.SizeInBytes, 
+		GetResourceCategory(heapProperties.Type, resourceDescriptor));
+	mResidencyMutex.unlock();
+
 	if (resourceName != nullptr) {
 		resource->SetName(resourceName);
 	}
@@ -130,9 +475,33 @@ ID3D12Resource& ResourceManager::CreateDefaultBuffer(
 	return *resource;
 }
 
-ID3D12Resource& ResourceManager::CreateCommittedResource(
-	const D3D12_HEAP_PROPERTIES& heapProperties,
-	const D3D12_HEAP_FLAGS& heapFlags,
+ID3D12Heap& ResourceManager::CreateHeap(
+	const D3D12_HEAP_DESC& heapDescriptor,
+	const wchar_t* heapName) noexcept
+{
+	ID3D12Heap* heap{ nullptr };
+
+	mMutex.lock();
+	CHECK_HR(DirectXManager::GetDevice().CreateHeap(&heapDescriptor, IID_PPV_ARGS(&heap)));
+	mMutex.unlock();
+
+	ASSERT(heap != nullptr);
+	mHeaps.insert(heap);
+
+	mResidencyMutex.lock();
+	AddPageable(*heap, heapDescriptor.SizeInBytes, GetHeapCategory(heapDescriptor));
+	mResidencyMutex.unlock();
+
+	if (heapName != nullptr) {
+		heap->SetName(heapName);
+	}
+
+	return *heap;
+}
+
+ID3D12Resource& ResourceManager::CreatePlacedResource(
+	ID3D12Heap& heap,
+	const std::uint64_t heapOffset,
 	const D3D12_RESOURCE_DESC& resourceDescriptor,
 	const D3D12_RESOURCE_STATES& resourceStates,
 	const D3D12_CLEAR_VALUE* clearValue,
@@ -141,12 +510,12 @@ ID3D12Resource& ResourceManager::CreateCommittedResource(
 	ID3D12Resource* resource{ nullptr };
 
 	mMutex.lock();
-	CHECK_HR(DirectXManager::GetDevice().CreateCommittedResource(
-		&heapProperties, 
-		heapFlags, 
-		&resourceDescriptor, 
-		resourceStates, 
-		clearValue, 
+	CHECK_HR(DirectXManager::GetDevice().CreatePlacedResource(
+		&heap,
+		heapOffset,
+		&resourceDescriptor,
+		resourceStates,
+		clearValue,
 		IID_PPV_ARGS(&resource)));
 	mMutex.unlock();
 
@@ -161,3 +530,149 @@ ID3D12Resource& ResourceManager::CreateCommittedResource(
 
 	return *resource;
 }
+
+ResourceManager::ResourceHeap::ResourceHeap(
+	ID3D12Heap& heap, 
+	const D3D12_HEAP_TYPE heapType, 
+	const D3D12_HEAP_FLAGS heapFlags)
+	: mHeap(&heap)
+	, mHeapType(heapType)
+	, mHeapFlags(heapFlags)
+	, mAllocator(sResourceHeapSize, D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT)
+{
+}
+
+ID3D12Resource* ResourceManager::CreateResourceInResourceHeap(
+	const D3D12_HEAP_PROPERTIES& heapProperties,
+	const D3D12_HEAP_FLAGS& heapFlags,
+	const D3D12_RESOURCE_DESC& resourceDescriptor,
+	const D3D12_RESOURCE_STATES& resourceStates,
+	const D3D12_CLEAR_VALUE* clearValue,
+	const wchar_t* resourceName) noexcept
+{
+	const D3D12_HEAP_TYPE heapType{ heapProperties.Type };
+	if (heapType != D3D12_HEAP_TYPE_DEFAULT && heapType != D3D12_HEAP_TYPE_UPLOAD && heapType != D3D12_HEAP_TYPE_READBACK) {
+		return nullptr;
+	}
+
+	if (heapFlags != D3D12_HEAP_FLAG_NONE || resourceDescriptor.SampleDesc.Count > 1U) {
+		return nullptr;
+	}
+
+	// Heap tier 1 hardware can not mix buffers and textures in the same heap. 
+	// Upload and readback heaps only have buffers.
+	D3D12_HEAP_FLAGS resourceHeapFlags{ D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS };
+	if (resourceDescriptor.Dimension != D3D12_RESOURCE_DIMENSION_BUFFER) {
+		const D3D12_RESOURCE_FLAGS renderTargetFlags{ 
+			D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET | D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL };
+		if (heapType != D3D12_HEAP_TYPE_DEFAULT || (resourceDescriptor.Flags & renderTargetFlags) != 0U) {
+			return nullptr;
+		}
+		resourceHeapFlags = D3D12_HEAP_FLAG_ALLOW_ONLY_NON_RT_DS_TEXTURES;
+	}
+
+	mMutex.lock();
+	const D3D12_RESOURCE_ALLOCATION_INFO allocationInfo = 
+		DirectXManager::GetDevice().GetResourceAllocationInfo(0U, 1U, &resourceDescriptor);
+	mMutex.unlock();
+
+	if (allocationInfo.SizeInBytes > sResourceHeapSize) {
+		return nullptr;
+	}
+
+	mResourceHeapMutex.lock();
+
+	ResourceHeap* resourceHeap{ nullptr };
+	std::uint32_t handle{ TlsfAllocator::sInvalidHandle };
+	std::uint64_t heapOffset{ 0UL };
+	for (ResourceHeap* currentResourceHeap : mResourceHeaps) {
+		ASSERT(currentResourceHeap != nullptr);
+		if (currentResourceHeap->mHeapType == heapType && currentResourceHeap->mHeapFlags == resourceHeapFlags) {
+			handle = currentResourceHeap->mAllocator.Allocate(allocationInfo.SizeInBytes, allocationInfo.Alignment, heapOffset);
+			if (handle != TlsfAllocator::sInvalidHandle) {
+				resourceHeap = currentResourceHeap;
+				break;
+			}
+		}
+	}
+
+	// There is no room in the heaps, so we create a new one
+	if (resourceHeap == nullptr) {
+		D3D12_HEAP_DESC heapDescriptor{};
+		heapDescriptor.SizeInBytes = sResourceHeapSize;
+		heapDescriptor.Properties = heapProperties;
+		heapDescriptor.Alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+		heapDescriptor.Flags = resourceHeapFlags;
+
+		ID3D12Heap& heap = CreateHeap(heapDescriptor, L"Resource Heap");
+		resourceHeap = new ResourceHeap(heap, heapType, resourceHeapFlags);
+		mResourceHeaps.push_back(resourceHeap);
+
+		mResidencyMutex.lock();
+		ASSERT(mPageableIds.count(&heap) == 1UL);
+		resourceHeap->mPageableId = mPageableIds[&heap];
+		mResidencyMutex.unlock();
+
+		handle = resourceHeap->mAllocator.Allocate(allocationInfo.SizeInBytes, allocationInfo.Alignment, heapOffset);
+		if (handle == TlsfAllocator::sInvalidHandle) {
+			// Its alignment padding does not fit
+			mResourceHeapMutex.unlock();
+			return nullptr;
+		}
+	}
+
+	ID3D12Resource& resource = CreatePlacedResource(
+		*resourceHeap->mHeap,
+		heapOffset,
+		resourceDescriptor,
+		resourceStates,
+		clearValue,
+		resourceName);
+
+	PlacedAllocation placedAllocation;
+	placedAllocation.mResourceHeap = resourceHeap;
+	placedAllocation.mHandle = handle;
+	const std::uint64_t granularity{ D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT };
+	placedAllocation.mSize = (allocationInfo.SizeInBytes + granularity - 1UL) & ~(granularity - 1UL);
+	mPlacedAllocations.emplace(&resource, placedAllocation);
+
+	mResourceHeapUsedSize += placedAllocation.mSize;
+	mResourceHeapPeakUsedSize = std::max<std::uint64_t>(mResourceHeapPeakUsedSize, mResourceHeapUsedSize);
+
+	// The heap is not evicted until the new resource is marked as used, and
+	// it must be resident before its data is uploaded.
+	++resourceHeap->mUnmarkedResourceCount;
+	ID3D12Pageable* pageableToMakeResident{ nullptr };
+	mResidencyMutex.lock();
+	mResidencyScheduler.SetEvictable(resourceHeap->mPageableId, false);
+	if (mResidencyScheduler.MarkUsed(resourceHeap->mPageableId, mResidencyFrameIndex)) {
+		pageableToMakeResident = resourceHeap->mHeap;
+	}
+	mResidencyMutex.unlock();
+	mResourceHeapMutex.unlock();
+
+	// It waits until the heap is resident, so no lock is held. It is not evicted
+	// in the meantime, because it is not evictable.
+	if (pageableToMakeResident != nullptr) {
+		CHECK_HR(DirectXManager::GetDevice().MakeResident(1U, &pageableToMakeResident));
+	}
+
+	return &resource;
+}
+
+std::uint32_t ResourceManager::AddPageable(
+	ID3D12Pageable& pageable,
+	const std::uint64_t size,
+	const ResidencyScheduler::Category category) noexcept
+{
+	ASSERT(mPageableIds.count(&pageable) == 0UL);
+
+	const std::uint32_t pageableId{ mResidencyScheduler.AddPageable(size, category, mResidencyFrameIndex) };
+	if (pageableId >= mPageablesById.size()) {
+		mPageablesById.resize(pageableId + 1UL, nullptr);
+	}
+	mPageablesById[pageableId] = &pageable;
+	mPageableIds.emplace(&pageable, pageableId);
+
+	return pageableId;
+}
@@ -1,9 +1,16 @@
 #pragma once
 
 #include <d3d12.h>
+#include <dxgi1_4.h>
 #include <mutex>
 #include <tbb/concurrent_unordered_set.h>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <wrl.h>
 
+#include <ResourceManager/ResidencyScheduler.h>
+#include <ResourceManager/TlsfAllocator.h>
 #include <ResourceManager/UploadBuffer.h>
 
 // This class is responsible to create/get:
@@ -19,19 +26,89 @@ public:
 	ResourceManager(ResourceManager&&) = delete;
 	ResourceManager& operator=(ResourceManager&&) = delete;
 
+	// Size of the heaps where CreateCommittedResource() places resources
+	static const std::uint64_t sResourceHeapSize{ 64UL * 1024UL * 1024UL };
+
+	struct HeapStatistics {
+		std::uint32_t mHeapCount{ 0U };
+		std::uint32_t mPlacedResourceCount{ 0U };
+		std::uint64_t mHeapSize{ 0UL };
+		std::uint64_t mUsedSize{ 0UL };
+		std::uint64_t mPeakUsedSize{ 0UL };
+
+		// Fragmentation of the heaps (see TlsfAllocator::GetFragmentation()) weighted by their free size
+		float mFragmentation{ 0.0f };
+	};
+
 	static void EraseAll() noexcept;
 
+	// Releases a resource created by this class. If it was placed in a 
+	// resource heap (see CreateCommittedResource()), then its memory is reused.
+	// It must not be called at the same time than other methods.
+	// Preconditions:
+	// - GPU must have finished using it
+	static void ReleaseResource(ID3D12Resource& resource) noexcept;
+
+	// Statistics of the heaps where CreateCommittedResource() places resources
+	static HeapStatistics GetHeapStatistics() noexcept;
+
+	// Heaps and committed resources created by this class are pageables whose residency is
+	// decided by a ResidencyScheduler, within the budget of SettingsManager::sResidencyMemoryBudget
+	// (or the local video memory budget that the OS gives to the process, if it is zero).
+	// Resources are never evicted until they are marked as used. After that, they must be marked
+	// in every frame that uses them, before the frame is executed, by every pass that uses them.
+	// Passes that do not mark the resources they use must keep them resident (see KeepResourcesResident()).
+	// A resource heap is evicted only if all its placed resources are marked. Evicted resources are 
+	// made resident before it returns. Resources placed in heaps created with CreateHeap() are 
+	// ignored (their heap is never evicted).
+	static void MarkResourcesUsed(
+		ID3D12Resource* const* resources,
+		const std::uint32_t resourceCount) noexcept;
+
+	// Resources used by a pass that does not mark them in every frame (like the cube maps of the
+	// sky box and the environment light), are never evicted, even if other passes mark them.
+	// If they were evicted, they are made resident before it returns.
+	static void KeepResourcesResident(
+		ID3D12Resource* const* resources,
+		const std::uint32_t resourceCount) noexcept;
+
+	// Lowers the residency priority of idle pageables (the OS pages them out first), restores the
+	// priority of the ones that are used again, and evicts the least recently used pageables if the
+	// resident ones do not fit in the budget.
+	// "frameIndex" is the fence value of the frame whose resources are marked after the call, and
+	// "completedFrameIndex" is the last fence value that the GPU completed.
+	// It must be called from a single thread, once per frame.
+	static void UpdateResidency(
+		const std::uint64_t frameIndex,
+		const std::uint64_t completedFrameIndex) noexcept;
+
+	// Size of the heaps and committed resources by category (textures, buffers, render targets and
+	// upload buffers), and the demotions and evictions done.
+	static ResidencyScheduler::Statistics GetResidencyStatistics() noexcept;
+
+	// Textures and default buffers are created in D3D12_RESOURCE_STATE_COMMON state, and their
+	// data is uploaded by TransferManager. It must be flushed, and the queue that uses them 
+	// must wait for it (see TransferManager::WaitOnGpu()), before they are used.
+
+	// The file is mapped in memory (see MemoryMappedFile) and loaded with LoadTextureFromMemory().
 	// If resourceName is nullptr, then it will have 
 	// the default name.
 	static ID3D12Resource& LoadTextureFromFile(
 		const char* textureFilename, 
-		ID3D12GraphicsCommandList& commandList,
-		Microsoft::WRL::ComPtr<ID3D12Resource>& uploadBuffer,
 		const wchar_t* resourceName) noexcept;
 
-	// Note: uploadBuffer has to be kept alive after the above function calls because
-	// the command list has not been executed yet that performs the actual copy.
-	// The caller can Release the uploadBuffer after it knows the copy has been executed.
+	// Creates a texture from DDS file data that was already read. Missing mips of
+	// 2D textures and cube maps are generated (see MipGenerator).
+	// It does not lock, so several threads can create textures at the same time.
+	// If resourceName is nullptr, then it will have 
+	// the default name.
+	// Preconditions:
+	// - "textureData" must not be nullptr
+	// - "textureDataSize" must be greater than zero
+	static ID3D12Resource& LoadTextureFromMemory(
+		const std::uint8_t* textureData,
+		const std::size_t textureDataSize,
+		const wchar_t* resourceName) noexcept;
 	
 	// If resourceName is nullptr, then it will have 
 	// the default name.
@@ -39,12 +116,16 @@ public:
 	// - "sourceData" must not be nullptr
 	// - "sourceDataSize" must be greater than zero
 	static ID3D12Resource& CreateDefaultBuffer(
-		ID3D12GraphicsCommandList& commandList,
 		const void* sourceData,
 		const std::size_t sourceDataSize,
-		Microsoft::WRL::ComPtr<ID3D12Resource>& uploadBuffer,
 		const wchar_t* resourceName) noexcept;
 
+	// Buffers and textures (except render targets, depth stencils and multisampled textures, that need
+	// to be initialized when their memory is reused) of default, upload and readback heaps without heap flags
+	// are not committed: they are placed in shared heaps of sResourceHeapSize bytes, one set of heaps per heap
+	// type and kind of resource, to avoid an implicit heap per resource. Their memory is suballocated
+	// with a TlsfAllocator, aligned to the resource alignment. 
+	// Resources larger than a heap are committed.
 	// If resourceName is nullptr, then it will have 
 	// the default name.
 	static ID3D12Resource& CreateCommittedResource(
@@ -55,9 +136,98 @@ public:
 		const D3D12_CLEAR_VALUE* clearValue,
 		const wchar_t* resourceName) noexcept;
 
+	// If heapName is nullptr, then it will have 
+	// the default name.
+	static ID3D12Heap& CreateHeap(
+		const D3D12_HEAP_DESC& heapDescriptor,
+		const wchar_t* heapName) noexcept;
+
+	// Creates a resource in "heap" memory, starting at "heapOffset".
+	// Several placed resources can share (alias) the same memory.
+	// If resourceName is nullptr, then it will have 
+	// the default name.
+	// Preconditions:
+	// - "heapOffset" must be aligned to the resource alignment
+	static ID3D12Resource& CreatePlacedResource(
+		ID3D12Heap& heap,
+		const std::uint64_t heapOffset,
+		const D3D12_RESOURCE_DESC& resourceDescriptor,
+		const D3D12_RESOURCE_STATES& resourceStates,
+		const D3D12_CLEAR_VALUE* clearValue,
+		const wchar_t* resourceName) noexcept;
+
 private:
+	struct ResourceHeap {
+		explicit ResourceHeap(ID3D12Heap& heap, const D3D12_HEAP_TYPE heapType, const D3D12_HEAP_FLAGS heapFlags);
+
+		ID3D12Heap* mHeap{ nullptr };
+		D3D12_HEAP_TYPE mHeapType{ D3D12_HEAP_TYPE_DEFAULT };
+		D3D12_HEAP_FLAGS mHeapFlags{ D3D12_HEAP_FLAG_NONE };
+		TlsfAllocator mAllocator;
+
+		// See ResidencyScheduler. The heap can be evicted when all its placed resources are marked as used.
+		std::uint32_t mPageableId{ 0U };
+		std::uint32_t mUnmarkedResourceCount{ 0U };
+	};
+
+	struct PlacedAllocation {
+		ResourceHeap* mResourceHeap{ nullptr };
+		std::uint32_t mHandle{ TlsfAllocator::sInvalidHandle };
+
+		// Allocated bytes (resource size rounded up to the allocator granularity)
+		std::uint64_t mSize{ 0UL };
+
+		// If it was marked as used (see MarkResourcesUsed()). It is never marked
+		// if it is kept resident (see KeepResourcesResident())
+		bool mIsMarked{ false };
+		bool mIsKeptResident{ false };
+	};
+
+	// Returns nullptr if the resource cannot be placed in a resource heap
+	static ID3D12Resource* CreateResourceInResourceHeap(
+		const D3D12_HEAP_PROPERTIES& heapProperties,
+		const D3D12_HEAP_FLAGS& heapFlags,
+		const D3D12_RESOURCE_DESC& resourceDescriptor,
+		const D3D12_RESOURCE_STATES& resourceStates,
+		const D3D12_CLEAR_VALUE* clearValue,
+		const wchar_t* resourceName) noexcept;
+
 	using Resources = tbb::concurrent_unordered_set<ID3D12Resource*>;
 	static Resources mResources;
 
+	using Heaps = tbb::concurrent_unordered_set<ID3D12Heap*>;
+	static Heaps mHeaps;
+
 	static std::mutex mMutex;
+
+	// Resource heaps and the allocations of their placed resources. 
+	// They are protected by mResourceHeapMutex, that is locked before mMutex.
+	static std::vector<ResourceHeap*> mResourceHeaps;
+	static std::unordered_map<ID3D12Resource*, PlacedAllocation> mPlacedAllocations;
+	static std::uint64_t mResourceHeapUsedSize;
+	static std::uint64_t mResourceHeapPeakUsedSize;
+	static std::mutex mResourceHeapMutex;
+
+	// Adds the heap or committed resource to the residency scheduler.
+	// mResidencyMutex must be locked.
+	static std::uint32_t AddPageable(
+		ID3D12Pageable& pageable,
+		const std::uint64_t size,
+		const ResidencyScheduler::Category category) noexcept;
+
+	// Residency of heaps and committed resources, and the pageable of each
+	// identifier. They are protected by mResidencyMutex, that is locked after 
+	// mResourceHeapMutex and before mMutex.
+	static ResidencyScheduler mResidencyScheduler;
+	static std::unordered_map<ID3D12Pageable*, std::uint32_t> mPageableIds;
+	static std::unordered_set<ID3D12Pageable*> mKeptResidentPageables;
+	static std::vector<ID3D12Pageable*> mPageablesById;
+	static std::uint64_t mResidencyFrameIndex;
+	static std::mutex mResidencyMutex;
+
+	// To query the local video memory budget, and to set the residency priority of pageables
+	// (it is nullptr if the device does not support ID3D12Device1)
+	static Microsoft::WRL::ComPtr<IDXGIAdapter3> mAdapter;
+	static Microsoft::WRL::ComPtr<ID3D12Device1> mDevice1;
+	static bool mIsDevice1Queried;
 };
@@ -0,0 +1,68 @@
+#include "RingBufferAllocator.h"
+
+#include <Utils/DebugUtils.h>
+
+const std::size_t RingBufferAllocator::sAlignment;
+const std::size_t RingBufferAllocator::sInvalidOffset;
+
+RingBufferAllocator::RingBufferAllocator(const std::size_t capacity)
+	: mCapacity(capacity)
+{
+	ASSERT(capacity > 0UL);
+	ASSERT(capacity % sAlignment == 0UL);
+}
+
+std::size_t RingBufferAllocator::Allocate(const std::size_t sizeInBytes) noexcept {
+	ASSERT(sizeInBytes > 0UL);
+	const std::uint64_t alignedSize{ GetAlignedSize(sizeInBytes) };
+	ASSERT(alignedSize <= mCapacity);
+
+	std::uint64_t head{ mHead.load(std::memory_order_relaxed) };
+	for (;;) {
+		// Allocations must be contiguous. If it wraps around the end of the ring, then
+		// the bytes up to the end are wasted (until the frame is released) and it is placed at the beginning.
+		const std::size_t headOffset{ static_cast<std::size_t>(head % mCapacity) };
+		std::size_t offset{ headOffset };
+		std::uint64_t newHead{ head + alignedSize };
+		if (headOffset + alignedSize > mCapacity) {
+			offset = 0UL;
+			newHead += mCapacity - headOffset;
+		}
+
+		// Check we do not overwrite memory the GPU can still be reading.
+		// Tail only grows, so a tail that is being released makes us fail conservatively.
+		if (newHead - mTail.load(std::memory_order_acquire) > mCapacity) {
+			return sInvalidOffset;
+		}
+
+		// If another thread claimed memory meanwhile, then "head" is updated and we try again
+		if (mHead.compare_exchange_weak(head, newHead, std::memory_order_relaxed)) {
+			return offset;
+		}
+	}
+}
+
+void RingBufferAllocator::FinishFrame(const std::uint64_t fenceValue) noexcept {
+	ASSERT(fenceValue > mLastFenceValue);
+	mLastFenceValue = fenceValue;
+
+	FrameData frameData;
+	frameData.mFenceValue = fenceValue;
+	frameData.mEnd = mHead.load(std::memory_order_relaxed);
+	mFramesInFlight.push(frameData);
+}
+
+void RingBufferAllocator::ReleaseCompletedFrames(const std::uint64_t completedFenceValue) noexcept {
+	while (mFramesInFlight.empty() == false && mFramesInFlight.front().mFenceValue <= completedFenceValue) {
+		mTail.store(mFramesInFlight.front().mEnd, std::memory_order_release);
+		mFramesInFlight.pop();
+	}
+}
+
+std::size_t RingBufferAllocator::GetUsedSize() const noexcept {
+	return static_cast<std::size_t>(mHead.load(std::memory_order_relaxed) - mTail.load(std::memory_order_relaxed));
+}
+
+std::size_t RingBufferAllocator::GetAlignedSize(const std::size_t sizeInBytes) noexcept {
+	return (sizeInBytes + sAlignment - 1UL) & ~(sAlignment - 1UL);
+}
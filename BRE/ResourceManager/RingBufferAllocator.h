@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <queue>
+
+// Linear allocator over a ring of "capacity" bytes, to allocate data
+// that is used by the GPU during a frame (for example, constant buffers).
+// Allocations are sAlignment bytes aligned (constant buffer alignment), and
+// they are claimed with an atomic compare and swap, so many threads can allocate at the same time.
+// Memory is not freed per allocation, but per frame, when the GPU finished using it.
+// Steps:
+// - Allocate() from any thread while you record a frame
+// - Call FinishFrame() with the fence value signaled after the frame command lists
+// - Call ReleaseCompletedFrames() with the last completed fence value to reuse memory
+class RingBufferAllocator {
+public:
+	static const std::size_t sAlignment{ 256UL };
+	static const std::size_t sInvalidOffset{ ~static_cast<std::size_t>(0UL) };
+
+	// Preconditions:
+	// - "capacity" must be greater than zero and a multiple of sAlignment
+	explicit RingBufferAllocator(const std::size_t capacity);
+
+	~RingBufferAllocator() = default;
+	RingBufferAllocator(const RingBufferAllocator&) = delete;
+	const RingBufferAllocator& operator=(const RingBufferAllocator&) = delete;
+	RingBufferAllocator(RingBufferAllocator&&) = delete;
+	RingBufferAllocator& operator=(RingBufferAllocator&&) = delete;
+
+	// Returns the offset in the ring of "sizeInBytes" bytes, or sInvalidOffset if the ring
+	// has not enough free memory (used memory is released in ReleaseCompletedFrames()).
+	// A failed allocation does not claim memory. It is thread safe.
+	// Preconditions:
+	// - "sizeInBytes" must be greater than zero
+	// - Aligned "sizeInBytes" must be less or equal than capacity
+	std::size_t Allocate(const std::size_t sizeInBytes) noexcept;
+
+	// Marks the end of the allocations of a frame. 
+	// It must not be called at the same time than other methods.
+	// Preconditions:
+	// - "fenceValue" must be greater than fence values of previous frames
+	void FinishFrame(const std::uint64_t fenceValue) noexcept;
+
+	// Releases the memory of the frames whose fence value is less or equal than "completedFenceValue".
+	// It must not be called at the same time than FinishFrame() or itself.
+	void ReleaseCompletedFrames(const std::uint64_t completedFenceValue) noexcept;
+
+	__forceinline std::size_t GetCapacity() const noexcept { return mCapacity; }
+
+	// Bytes allocated but not released yet (it includes bytes wasted when we wrap around the ring)
+	std::size_t GetUsedSize() const noexcept;
+
+	static std::size_t GetAlignedSize(const std::size_t sizeInBytes) noexcept;
+
+private:
+	struct FrameData {
+		std::uint64_t mFenceValue{ 0UL };
+		std::uint64_t mEnd{ 0UL };
+	};
+
+	std::size_t mCapacity{ 0UL };
+
+	// Total number of allocated and released bytes since creation. 
+	// They only grow, and mHead - mTail is the used memory.
+	std::atomic<std::uint64_t> mHead{ 0UL };
+	std::atomic<std::uint64_t> mTail{ 0UL };
+
+	// Frames whose memory was not released yet
+	std::queue<FrameData> mFramesInFlight;
+	std::uint64_t mLastFenceValue{ 0UL };
+};
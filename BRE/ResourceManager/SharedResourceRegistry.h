@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+#include <Utils/DebugUtils.h>
+
+// To share resources (buffers, models, etc) that are identified by a 64 bits key,
+// usually a hash of their content (see HashUtils::HashData()) or of the parameters
+// used to create them. Each registered resource has a reference count, and
+// lookups are counted as hits or misses.
+// Keys are trusted: two resources with the same key are considered equal.
+// It is thread safe, and it does not create or destroy resources, so it can be used without a device.
+// Steps:
+// - Call Acquire() with the resource key. If it returns true, use the returned resource.
+// - Otherwise, create the resource and call Register(). If it returns false, another thread
+//   registered it first, so use the returned resource instead of the new one.
+// - Call Release() when the resource is not used anymore.
+template<typename ResourceType>
+class SharedResourceRegistry {
+public:
+	struct Statistics {
+		std::uint64_t mHitCount{ 0UL };
+		std::uint64_t mMissCount{ 0UL };
+		std::uint32_t mResourceCount{ 0U };
+
+		// Sum of the reference counts of all the resources
+		std::uint32_t mReferenceCount{ 0U };
+	};
+
+	SharedResourceRegistry() = default;
+	~SharedResourceRegistry() = default;
+	SharedResourceRegistry(const SharedResourceRegistry&) = delete;
+	const SharedResourceRegistry& operator=(const SharedResourceRegistry&) = delete;
+	SharedResourceRegistry(SharedResourceRegistry&&) = delete;
+	SharedResourceRegistry& operator=(SharedResourceRegistry&&) = delete;
+
+	// If there is a resource with "key", then it is stored in "resource", its
+	// reference count is incremented and it returns true (hit). Otherwise, it returns false (miss).
+	bool Acquire(const std::uint64_t key, ResourceType& resource) noexcept {
+		std::lock_guard<std::mutex> lock(mMutex);
+		typename Entries::iterator it = mEntries.find(key);
+		if (it == mEntries.end()) {
+			++mStatistics.mMissCount;
+			return false;
+		}
+
+		++mStatistics.mHitCount;
+		++mStatistics.mReferenceCount;
+		++it->second.mReferenceCount;
+		resource = it->second.mResource;
+
+		return true;
+	}
+
+	// Registers "resource" with a reference count of 1 and returns true.
+	// If there is already a resource with "key" (another thread registered it after 
+	// our Acquire()), then it is stored in "resource", its reference count is incremented and it returns false.
+	bool Register(const std::uint64_t key, ResourceType& resource) noexcept {
+		std::lock_guard<std::mutex> lock(mMutex);
+		const std::pair<typename Entries::iterator, bool> result = mEntries.emplace(key, Entry{ resource, 1U });
+		++mStatistics.mReferenceCount;
+		if (result.second) {
+			++mStatistics.mResourceCount;
+			return true;
+		}
+
+		++result.first->second.mReferenceCount;
+		resource = result.first->second.mResource;
+
+		return false;
+	}
+
+	// Decrements the reference count of the resource with "key", stores the resource
+	// in "resource" and returns the reference count. When it reaches zero, the
+	// resource is unregistered, and the caller can destroy it.
+	// Preconditions:
+	// - There must be a resource with "key"
+	std::uint32_t Release(const std::uint64_t key, ResourceType& resource) noexcept {
+		std::lock_guard<std::mutex> lock(mMutex);
+		typename Entries::iterator it = mEntries.find(key);
+		ASSERT(it != mEntries.end());
+		ASSERT(it->second.mReferenceCount > 0U);
+
+		--mStatistics.mReferenceCount;
+		resource = it->second.mResource;
+		const std::uint32_t referenceCount{ --it->second.mReferenceCount };
+		if (referenceCount == 0U) {
+			mEntries.erase(it);
+			--mStatistics.mResourceCount;
+		}
+
+		return referenceCount;
+	}
+
+	// Unregisters all the resources. Statistics are kept.
+	void Clear() noexcept {
+		std::lock_guard<std::mutex> lock(mMutex);
+		mEntries.clear();
+		mStatistics.mResourceCount = 0U;
+		mStatistics.mReferenceCount = 0U;
+	}
+
+	Statistics GetStatistics() const noexcept {
+		std::lock_guard<std::mutex> lock(mMutex);
+		return mStatistics;
+	}
+
+private:
+	struct Entry {
+		ResourceType mResource;
+		std::uint32_t mReferenceCount;
+	};
+
+	using Entries = std::unordered_map<std::uint64_t, Entry>;
+	Entries mEntries;
+	Statistics mStatistics;
+	mutable std::mutex mMutex;
+};
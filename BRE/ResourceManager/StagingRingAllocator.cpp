@@ -0,0 +1,72 @@
+#include "StagingRingAllocator.h"
+
+#include <Utils/DebugUtils.h>
+
+const std::uint64_t StagingRingAllocator::sInvalidOffset;
+
+StagingRingAllocator::StagingRingAllocator(const std::uint64_t capacity)
+	: mCapacity(capacity)
+{
+	ASSERT(capacity > 0UL);
+}
+
+std::uint64_t StagingRingAllocator::Allocate(const std::uint64_t sizeInBytes, const std::uint64_t alignment) noexcept {
+	ASSERT(sizeInBytes > 0UL);
+	ASSERT(sizeInBytes <= mCapacity);
+	ASSERT(alignment > 0UL && (alignment & (alignment - 1UL)) == 0UL);
+	ASSERT(mCapacity % alignment == 0UL);
+
+	// If everything was released, then we start at the beginning of the ring,
+	// so the allocation does not need to wrap around.
+	if (mHead == mTail && mPendingBatches.empty()) {
+		const std::uint64_t ringBegin{ ((mHead + mCapacity - 1UL) / mCapacity) * mCapacity };
+		mHead = ringBegin;
+		mTail = ringBegin;
+		mOpenBatchBegin = ringBegin;
+	}
+
+	const std::uint64_t headOffset{ mHead % mCapacity };
+	std::uint64_t offset{ (headOffset + alignment - 1UL) & ~(alignment - 1UL) };
+	std::uint64_t padding{ offset - headOffset };
+
+	// Wrap around. The beginning of the ring is aligned because capacity is a multiple of the alignment.
+	if (offset + sizeInBytes > mCapacity) {
+		offset = 0UL;
+		padding = mCapacity - headOffset;
+	}
+
+	const std::uint64_t newHead{ mHead + padding + sizeInBytes };
+
+	// Check we do not overwrite memory the GPU can still be reading
+	if (newHead - mTail > mCapacity) {
+		return sInvalidOffset;
+	}
+
+	mHead = newHead;
+
+	return offset;
+}
+
+void StagingRingAllocator::CloseBatch(const std::uint64_t fenceValue) noexcept {
+	ASSERT(fenceValue > mLastFenceValue);
+	mLastFenceValue = fenceValue;
+
+	Batch batch;
+	batch.mFenceValue = fenceValue;
+	batch.mEnd = mHead;
+	mPendingBatches.push(batch);
+
+	mOpenBatchBegin = mHead;
+}
+
+void StagingRingAllocator::ReleaseCompletedBatches(const std::uint64_t completedFenceValue) noexcept {
+	while (mPendingBatches.empty() == false && mPendingBatches.front().mFenceValue <= completedFenceValue) {
+		mTail = mPendingBatches.front().mEnd;
+		mPendingBatches.pop();
+	}
+}
+
+std::uint64_t StagingRingAllocator::GetOldestBatchFenceValue() const noexcept {
+	ASSERT(mPendingBatches.empty() == false);
+	return mPendingBatches.front().mFenceValue;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <queue>
+
+// Allocator over a ring of "capacity" bytes of staging (upload) memory.
+// Allocations are grouped in batches: all the allocations done between two CloseBatch() calls
+// belong to the batch that is submitted to the GPU with the fence value given to CloseBatch().
+// The memory of a batch is released when its fence value is completed (ReleaseCompletedBatches()).
+// Allocations are contiguous: if an allocation does not fit before the end of the ring, then 
+// the bytes up to the end are wasted (until the batch is released) and it is placed at the beginning.
+// It is not thread safe.
+// Steps:
+// - Allocate() while you record copies from the staging memory
+// - Call CloseBatch() with the fence value signaled after the copies are executed
+// - Call ReleaseCompletedBatches() with the last completed fence value to reuse memory.
+//   If Allocate() fails, then you should wait for GetOldestBatchFenceValue() and release it.
+class StagingRingAllocator {
+public:
+	static const std::uint64_t sInvalidOffset{ 0xFFFFFFFFFFFFFFFFULL };
+
+	// Preconditions:
+	// - "capacity" must be greater than zero
+	explicit StagingRingAllocator(const std::uint64_t capacity);
+
+	~StagingRingAllocator() = default;
+	StagingRingAllocator(const StagingRingAllocator&) = delete;
+	const StagingRingAllocator& operator=(const StagingRingAllocator&) = delete;
+	StagingRingAllocator(StagingRingAllocator&&) = delete;
+	StagingRingAllocator& operator=(StagingRingAllocator&&) = delete;
+
+	// Returns the offset in the ring of "sizeInBytes" bytes aligned to "alignment" bytes, 
+	// or sInvalidOffset if the ring has not enough free memory.
+	// If there is no used memory and no pending batch, then it always succeeds.
+	// Preconditions:
+	// - "sizeInBytes" must be greater than zero and less or equal than capacity
+	// - "alignment" must be a power of two, and capacity must be a multiple of it
+	std::uint64_t Allocate(const std::uint64_t sizeInBytes, const std::uint64_t alignment) noexcept;
+
+	// Closes the batch of the allocations done since the previous call. Its memory
+	// is released when "fenceValue" is completed.
+	// Preconditions:
+	// - "fenceValue" must be greater than fence values of previous batches
+	void CloseBatch(const std::uint64_t fenceValue) noexcept;
+
+	// Releases the memory of the batches whose fence value is less or equal than "completedFenceValue"
+	void ReleaseCompletedBatches(const std::uint64_t completedFenceValue) noexcept;
+
+	__forceinline std::uint64_t GetCapacity() const noexcept { return mCapacity; }
+
+	// Bytes allocated but not released yet (it includes bytes wasted by alignment and wrap around)
+	__forceinline std::uint64_t GetUsedSize() const noexcept { return mHead - mTail; }
+
+	// Bytes allocated since the last CloseBatch()
+	__forceinline std::uint64_t GetOpenBatchSize() const noexcept { return mHead - mOpenBatchBegin; }
+
+	// Closed batches whose memory was not released yet
+	__forceinline std::uint32_t GetPendingBatchCount() const noexcept { 
+		return static_cast<std::uint32_t>(mPendingBatches.size()); 
+	}
+
+	// Preconditions:
+	// - There must be pending batches
+	std::uint64_t GetOldestBatchFenceValue() const noexcept;
+
+private:
+	struct Batch {
+		std::uint64_t mFenceValue{ 0UL };
+		std::uint64_t mEnd{ 0UL };
+	};
+
+	std::uint64_t mCapacity{ 0UL };
+
+	// Total number of allocated and released bytes since creation. 
+	// They only grow, and mHead - mTail is the used memory.
+	std::uint64_t mHead{ 0UL };
+	std::uint64_t mTail{ 0UL };
+	std::uint64_t mOpenBatchBegin{ 0UL };
+
+	std::queue<Batch> mPendingBatches;
+	std::uint64_t mLastFenceValue{ 0UL };
+};
@@ -0,0 +1,356 @@
+#include "TextureStreamer.h"
+
+#include <algorithm>
+
+#include <CommandListExecutor/CommandListExecutor.h>
+#include <CommandManager\FenceManager.h>
+#include <DescriptorManager\CbvSrvUavDescriptorManager.h>
+#include <DXUtils/d3dx12.h>
+#include <ResourceManager/BlockCompressor.h>
+#include <ResourceManager\ResourceManager.h>
+#include <ResourceManager/TransferManager.h>
+#include <Utils/DebugUtils.h>
+#include <Utils/MemoryMappedFile.h>
+
+namespace {
+	// Streamed textures are 2D textures (not arrays nor cube maps) with mips finer than the mip tail
+	bool IsStreamable(const DDSTextureParser::TextureInfo& textureInfo, const std::uint32_t pinnedMipCount) noexcept {
+		return
+			textureInfo.mDimension == DDSTextureParser::Dimension::TEXTURE2D &&
+			textureInfo.mArraySize == 1U &&
+			textureInfo.mIsCubeMap == false &&
+			pinnedMipCount < textureInfo.mMipCount;
+	}
+
+	// Textures are created from their first resident mip, and the first mip of
+	// block compressed textures must have whole blocks
+	std::uint32_t GetFirstResidentMipMask(const DDSTextureParser::TextureInfo& textureInfo) noexcept {
+		const bool isBlockCompressed{
+			(textureInfo.mFormat >= DXGI_FORMAT_BC1_TYPELESS && textureInfo.mFormat <= DXGI_FORMAT_BC5_SNORM) ||
+			(textureInfo.mFormat >= DXGI_FORMAT_BC6H_TYPELESS && textureInfo.mFormat <= DXGI_FORMAT_BC7_UNORM_SRGB) };
+
+		return TextureStreamingScheduler::ComputeAlignedMipMask(
+			textureInfo.mWidth,
+			textureInfo.mHeight,
+			textureInfo.mMipCount,
+			isBlockCompressed ? BlockCompressor::sBlockDimension : 1U);
+	}
+}
+
+const std::uint32_t TextureStreamer::sInvalidTextureId;
+const std::uint32_t TextureStreamer::sMipTailMaxDimension;
+const std::uint64_t TextureStreamer::sFramesBetweenSwaps;
+const std::uint64_t TextureStreamer::sMaxLoadSizePerUpdate;
+std::vector<TextureStreamer::StreamedTexture> TextureStreamer::mTextures;
+std::unordered_map<const ID3D12Resource*, std::uint32_t> TextureStreamer::mTextureIdByResource;
+std::unique_ptr<TextureStreamingScheduler> TextureStreamer::mScheduler;
+std::vector<TextureStreamingScheduler::Change> TextureStreamer::mChanges;
+std::vector<TextureStreamer::PendingTexture> TextureStreamer::mPendingTextures;
+bool TextureStreamer::mIsLoading{ false };
+std::atomic<bool> TextureStreamer::mAreLoadsFlushed{ false };
+std::uint64_t TextureStreamer::mLoadFenceValue{ 0UL };
+std::uint64_t TextureStreamer::mLastSwapFrameIndex{ 0UL };
+tbb::task_group TextureStreamer::mTaskGroup;
+ID3D12Fence* TextureStreamer::mFence{ nullptr };
+std::uint64_t TextureStreamer::mFenceValue{ 0UL };
+std::mutex TextureStreamer::mMutex;
+
+void TextureStreamer::Init(const std::uint64_t memoryBudget) noexcept {
+	ASSERT(mScheduler.get() == nullptr);
+
+	mScheduler.reset(new TextureStreamingScheduler(memoryBudget, sMaxLoadSizePerUpdate));
+	mFence = &FenceManager::CreateFence(0U, D3D12_FENCE_FLAG_NONE);
+}
+
+void TextureStreamer::EraseAll() noexcept {
+	mTaskGroup.wait();
+
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	// Textures and the fence are destroyed by their managers
+	mTextures.clear();
+	mTextureIdByResource.clear();
+	mPendingTextures.clear();
+	mScheduler.reset();
+	mIsLoading = false;
+	mFence = nullptr;
+}
+
+ID3D12Resource& TextureStreamer::LoadTextureFromMemory(
+	const std::uint8_t* textureData,
+	const std::size_t textureDataSize,
+	const char* textureFilePath) noexcept
+{
+	ASSERT(textureData != nullptr);
+	ASSERT(textureFilePath != nullptr);
+	ASSERT(mScheduler.get() != nullptr);
+
+	// Invalid or unsupported files are reported by ResourceManager::LoadTextureFromMemory()
+	TextureLayout layout;
+	DDSTextureParser::Result result{ DDSTextureParser::ParseHeader(textureData, textureDataSize, layout.mInfo) };
+	const std::uint32_t firstResidentMipMask{
+		result == DDSTextureParser::Result::SUCCESS ? GetFirstResidentMipMask(layout.mInfo) : 0U };
+	const std::uint32_t pinnedMipCount{
+		result == DDSTextureParser::Result::SUCCESS ?
+		TextureStreamingScheduler::ComputePinnedMipCount(
+			layout.mInfo.mWidth,
+			layout.mInfo.mHeight,
+			layout.mInfo.mMipCount,
+			sMipTailMaxDimension,
+			firstResidentMipMask) :
+		0U };
+	if (result != DDSTextureParser::Result::SUCCESS || IsStreamable(layout.mInfo, pinnedMipCount) == false) {
+		return ResourceManager::LoadTextureFromMemory(textureData, textureDataSize, nullptr);
+	}
+
+	layout.mMipLayouts.resize(layout.mInfo.mMipCount);
+	std::uint32_t skippedMipCount{ 0U };
+	std::uint32_t width{ 0U };
+	std::uint32_t height{ 0U };
+	std::uint32_t depth{ 0U };
+	result = DDSTextureParser::ComputeSubresourceLayouts(
+		layout.mInfo,
+		0UL,
+		textureDataSize,
+		layout.mMipLayouts.data(),
+		skippedMipCount,
+		width,
+		height,
+		depth);
+	if (result != DDSTextureParser::Result::SUCCESS) {
+		return ResourceManager::LoadTextureFromMemory(textureData, textureDataSize, nullptr);
+	}
+
+	ID3D12Resource& texture = CreateTexture(layout, layout.mInfo.mMipCount - pinnedMipCount, textureData, textureDataSize);
+
+	std::uint64_t mipSizes[DDSTextureParser::sMaxMipCount];
+	for (std::uint32_t i = 0U; i < layout.mInfo.mMipCount; ++i) {
+		mipSizes[i] = layout.mMipLayouts[i].mSize;
+	}
+
+	StreamedTexture streamedTexture;
+	streamedTexture.mFilePath = textureFilePath;
+	streamedTexture.mLayout = layout;
+	streamedTexture.mTexture = &texture;
+
+	std::lock_guard<std::mutex> lock(mMutex);
+	const std::uint32_t textureId{ mScheduler->AddTexture(mipSizes, layout.mInfo.mMipCount, pinnedMipCount, firstResidentMipMask) };
+	ASSERT(textureId == mTextures.size());
+	mTextures.push_back(streamedTexture);
+	mTextureIdByResource[&texture] = textureId;
+
+	return texture;
+}
+
+std::uint32_t TextureStreamer::GetTextureId(const ID3D12Resource& texture) noexcept {
+	std::lock_guard<std::mutex> lock(mMutex);
+	const auto it = mTextureIdByResource.find(&texture);
+
+	return it == mTextureIdByResource.end() ? sInvalidTextureId : it->second;
+}
+
+void TextureStreamer::AddShaderResourceView(
+	const std::uint32_t textureId,
+	const D3D12_GPU_DESCRIPTOR_HANDLE view) noexcept
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	ASSERT(textureId < mTextures.size());
+	mTextures[textureId].mViews.push_back(view);
+}
+
+void TextureStreamer::RemoveShaderResourceView(
+	const std::uint32_t textureId,
+	const D3D12_GPU_DESCRIPTOR_HANDLE view) noexcept
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	if (textureId >= mTextures.size()) {
+		return;
+	}
+
+	std::vector<D3D12_GPU_DESCRIPTOR_HANDLE>& views = mTextures[textureId].mViews;
+	const std::vector<D3D12_GPU_DESCRIPTOR_HANDLE>::iterator it{
+		std::find_if(
+			views.begin(),
+			views.end(),
+			[view](const D3D12_GPU_DESCRIPTOR_HANDLE registeredView) { return registeredView.ptr == view.ptr; }) };
+	ASSERT(it != views.end());
+	if (it != views.end()) {
+		*it = views.back();
+		views.pop_back();
+	}
+}
+
+void TextureStreamer::RequestTextures(const Request* requests, const std::uint32_t requestCount) noexcept {
+	ASSERT(requests != nullptr);
+
+	std::lock_guard<std::mutex> lock(mMutex);
+	if (mScheduler.get() == nullptr) {
+		return;
+	}
+
+	for (std::uint32_t i = 0U; i < requestCount; ++i) {
+		const Request& request{ requests[i] };
+		ASSERT(request.mTextureId < mTextures.size());
+
+		const DDSTextureParser::TextureInfo& textureInfo{ mTextures[request.mTextureId].mLayout.mInfo };
+		const std::uint32_t mip{
+			TextureStreamingScheduler::ComputeRequiredMip(
+				textureInfo.mWidth,
+				textureInfo.mHeight,
+				textureInfo.mMipCount,
+				request.mCoveredPixelCount) };
+		mScheduler->RequestMip(request.mTextureId, mip, request.mCoveredPixelCount);
+	}
+}
+
+void TextureStreamer::Update(const std::uint64_t frameIndex) noexcept {
+	if (mScheduler.get() == nullptr) {
+		return;
+	}
+
+	// Textures are not scheduled again until the pending ones replace their textures
+	if (mIsLoading) {
+		if (mAreLoadsFlushed == false ||
+			TransferManager::IsCompleted(mLoadFenceValue) == false ||
+			frameIndex < mLastSwapFrameIndex + sFramesBetweenSwaps) {
+			return;
+		}
+
+		mTaskGroup.wait();
+		SwapPendingTextures();
+		mLastSwapFrameIndex = frameIndex;
+		mIsLoading = false;
+	}
+
+	std::lock_guard<std::mutex> lock(mMutex);
+	mChanges.clear();
+	mScheduler->ScheduleChanges(frameIndex, mChanges);
+	if (mChanges.empty()) {
+		return;
+	}
+
+	// Tasks do not access mTextures, because textures can be added while they run
+	mPendingTextures.clear();
+	for (const TextureStreamingScheduler::Change& change : mChanges) {
+		const StreamedTexture& streamedTexture{ mTextures[change.mTextureId] };
+
+		PendingTexture pendingTexture;
+		pendingTexture.mTextureId = change.mTextureId;
+		pendingTexture.mFirstMip = change.mFirstResidentMip;
+		pendingTexture.mFilePath = streamedTexture.mFilePath;
+		pendingTexture.mLayout = streamedTexture.mLayout;
+		mPendingTextures.push_back(pendingTexture);
+	}
+
+	mIsLoading = true;
+	mAreLoadsFlushed = false;
+	mTaskGroup.run([]() { LoadPendingTextures(); });
+}
+
+std::uint64_t TextureStreamer::GetResidentSize() noexcept {
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mScheduler.get() == nullptr ? 0UL : mScheduler->GetResidentSize();
+}
+
+ID3D12Resource& TextureStreamer::CreateTexture(
+	const TextureLayout& layout,
+	const std::uint32_t firstMip,
+	const std::uint8_t* textureData,
+	const std::size_t textureDataSize) noexcept
+{
+	ASSERT(textureData != nullptr);
+	ASSERT(firstMip < layout.mInfo.mMipCount);
+	ASSERT(((GetFirstResidentMipMask(layout.mInfo) >> firstMip) & 1U) != 0U);
+
+	const std::uint32_t mipCount{ layout.mInfo.mMipCount - firstMip };
+	const CD3DX12_RESOURCE_DESC textureDescriptor{
+		CD3DX12_RESOURCE_DESC::Tex2D(
+			layout.mInfo.mFormat,
+			std::max<std::uint32_t>(layout.mInfo.mWidth >> firstMip, 1U),
+			std::max<std::uint32_t>(layout.mInfo.mHeight >> firstMip, 1U),
+			1U,
+			static_cast<std::uint16_t>(mipCount)) };
+
+	D3D12_HEAP_PROPERTIES heapProps{};
+	heapProps.Type = D3D12_HEAP_TYPE_DEFAULT;
+	heapProps.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+	heapProps.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+	heapProps.CreationNodeMask = 1U;
+	heapProps.VisibleNodeMask = 1U;
+
+	ID3D12Resource& texture = ResourceManager::CreateCommittedResource(
+		heapProps,
+		D3D12_HEAP_FLAG_NONE,
+		textureDescriptor,
+		D3D12_RESOURCE_STATE_COMMON,
+		nullptr,
+		nullptr);
+
+	// TransferManager splits the mips in groups that fit in the staging buffer
+	std::vector<D3D12_SUBRESOURCE_DATA> subresourceData(mipCount);
+	for (std::uint32_t i = 0U; i < mipCount; ++i) {
+		const DDSTextureParser::SubresourceLayout& mipLayout{ layout.mMipLayouts[firstMip + i] };
+		ASSERT(mipLayout.mOffset + mipLayout.mSize <= textureDataSize);
+
+		subresourceData[i].pData = textureData + mipLayout.mOffset;
+		subresourceData[i].RowPitch = static_cast<LONG_PTR>(mipLayout.mRowPitch);
+		subresourceData[i].SlicePitch = static_cast<LONG_PTR>(mipLayout.mSlicePitch);
+	}
+	TransferManager::UploadTexture(texture, 0U, mipCount, subresourceData.data());
+
+	return texture;
+}
+
+void TextureStreamer::LoadPendingTextures() noexcept {
+	for (PendingTexture& pendingTexture : mPendingTextures) {
+		MemoryMappedFile file;
+		const bool result{ file.Open(pendingTexture.mFilePath.c_str()) };
+		ASSERT(result);
+		if (result) {
+			pendingTexture.mTexture = &CreateTexture(
+				pendingTexture.mLayout,
+				pendingTexture.mFirstMip,
+				file.GetData(),
+				file.GetSize());
+		}
+	}
+
+	mLoadFenceValue = TransferManager::Flush();
+	mAreLoadsFlushed = true;
+}
+
+void TextureStreamer::SwapPendingTextures() noexcept {
+	ASSERT(mFence != nullptr);
+
+	// Views can only be updated when the GPU does not use them
+	++mFenceValue;
+	CommandListExecutor::Get().SignalFenceAndWaitForCompletion(*mFence, mFenceValue, mFenceValue);
+
+	std::lock_guard<std::mutex> lock(mMutex);
+	for (const PendingTexture& pendingTexture : mPendingTextures) {
+		if (pendingTexture.mTexture == nullptr) {
+			continue;
+		}
+
+		StreamedTexture& streamedTexture{ mTextures[pendingTexture.mTextureId] };
+		ASSERT(streamedTexture.mTexture != nullptr);
+
+		D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc{};
+		srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+		srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+		srvDesc.Texture2D.MostDetailedMip = 0;
+		srvDesc.Texture2D.ResourceMinLODClamp = 0.0f;
+		srvDesc.Format = pendingTexture.mTexture->GetDesc().Format;
+		srvDesc.Texture2D.MipLevels = pendingTexture.mTexture->GetDesc().MipLevels;
+		for (const D3D12_GPU_DESCRIPTOR_HANDLE view : streamedTexture.mViews) {
+			CbvSrvUavDescriptorManager::UpdateShaderResourceView(view, *pendingTexture.mTexture, srvDesc);
+		}
+
+		mTextureIdByResource.erase(streamedTexture.mTexture);
+		mTextureIdByResource[pendingTexture.mTexture] = pendingTexture.mTextureId;
+		ResourceManager::ReleaseResource(*streamedTexture.mTexture);
+		streamedTexture.mTexture = pendingTexture.mTexture;
+	}
+
+	mPendingTextures.clear();
+}
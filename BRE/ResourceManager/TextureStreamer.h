@@ -0,0 +1,176 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <d3d12.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tbb/task_group.h>
+#include <unordered_map>
+#include <vector>
+
+#include <ResourceManager/DDSTextureParser.h>
+#include <ResourceManager/TextureStreamingScheduler.h>
+
+// To stream the mips of DDS textures within a memory budget.
+// Streamed textures are created with their coarsest mips (the mip tail, see sMipTailMaxDimension),
+// and their finer mips are loaded when the instances that use them cover enough pixels on
+// the screen (see RequestTextures()). If they do not fit in the budget, then the least recently
+// needed mips are evicted (see TextureStreamingScheduler).
+// Textures change their mips in a new texture, in a TBB task: the resident range of mips is read from
+// the memory mapped file (only its pages are read) and uploaded by TransferManager. Kept mips are read again
+// instead of being copied from the old texture, so the copy queue never uses a texture the graphics queue reads.
+// Once uploads are completed, views of the textures (see AddShaderResourceView()) are updated to the
+// new textures at a safe point (the graphics queue is idle), at most once every sFramesBetweenSwaps frames,
+// and old textures are released.
+// Steps:
+// - Call Init() once
+// - Call LoadTextureFromMemory() to create textures, and AddShaderResourceView() for their views
+// - Call RemoveShaderResourceView() before destroying a view
+// - Call RequestTextures() every frame, from any thread
+// - Call Update() once per frame, after presenting
+class TextureStreamer {
+public:
+	static const std::uint32_t sInvalidTextureId{ 0xFFFFFFFFU };
+
+	// Mips whose width and height are not greater than it are always resident. Block compressed
+	// textures are created from mips with whole blocks, so their mip tail starts at the first of these mips.
+	static const std::uint32_t sMipTailMaxDimension{ 64U };
+
+	// Minimum number of frames between two updates of textures (each one waits for the graphics queue)
+	static const std::uint64_t sFramesBetweenSwaps{ 15UL };
+
+	// Maximum size of the mips that are loaded by an update (kept mips are not included)
+	static const std::uint64_t sMaxLoadSizePerUpdate{ 32UL * 1024UL * 1024UL };
+
+	TextureStreamer() = delete;
+	~TextureStreamer() = delete;
+	TextureStreamer(const TextureStreamer&) = delete;
+	const TextureStreamer& operator=(const TextureStreamer&) = delete;
+	TextureStreamer(TextureStreamer&&) = delete;
+	TextureStreamer& operator=(TextureStreamer&&) = delete;
+
+	// Preconditions:
+	// - Init() must be called once
+	static void Init(const std::uint64_t memoryBudget) noexcept;
+
+	// Waits for the loads in progress. It must be called before TransferManager::EraseAll().
+	// Textures are destroyed by ResourceManager::EraseAll().
+	static void EraseAll() noexcept;
+
+	// Creates a texture from DDS file data that was already mapped (see MemoryMappedFile).
+	// 2D textures (not arrays nor cube maps) with mips finer than the mip tail are streamed:
+	// only the pages of the mip tail are read, and "textureFilePath" is mapped again to load finer mips.
+	// Other textures are created with all their data (see ResourceManager::LoadTextureFromMemory()).
+	// It can be called by several threads at the same time.
+	// Preconditions:
+	// - "textureData" must not be nullptr
+	// - "textureFilePath" must not be nullptr
+	// - Init() must be called before
+	static ID3D12Resource& LoadTextureFromMemory(
+		const std::uint8_t* textureData,
+		const std::size_t textureDataSize,
+		const char* textureFilePath) noexcept;
+
+	// Returns the identifier of a texture returned by LoadTextureFromMemory(),
+	// or sInvalidTextureId if the texture is not streamed.
+	static std::uint32_t GetTextureId(const ID3D12Resource& texture) noexcept;
+
+	// Registers a view of the streamed texture, so it is updated when the texture changes its mips.
+	// Preconditions:
+	// - "textureId" must be returned by GetTextureId()
+	// - "view" must be a D3D12_SRV_DIMENSION_TEXTURE2D view of all the mips of the texture
+	static void AddShaderResourceView(
+		const std::uint32_t textureId,
+		const D3D12_GPU_DESCRIPTOR_HANDLE view) noexcept;
+
+	// Unregisters a view registered by AddShaderResourceView(), before it is destroyed.
+	// It does nothing if the textures were erased (see EraseAll()).
+	static void RemoveShaderResourceView(
+		const std::uint32_t textureId,
+		const D3D12_GPU_DESCRIPTOR_HANDLE view) noexcept;
+
+	struct Request {
+		std::uint32_t mTextureId{ sInvalidTextureId };
+
+		// Number of pixels the texture covers on the screen. It is used to
+		// select the finest mip the texture needs, and as the priority of its load.
+		float mCoveredPixelCount{ 0.0f };
+	};
+
+	// Requests the mips that "requestCount" textures need in the current frame.
+	// Preconditions:
+	// - "requests" must not be nullptr
+	static void RequestTextures(const Request* requests, const std::uint32_t requestCount) noexcept;
+
+	// Schedules loads and evictions of mips with the requests of the frame, and updates
+	// the textures whose new mips are uploaded.
+	// Preconditions:
+	// - Command lists must not be recorded or executed at the same time
+	// - "frameIndex" must be greater than the one of the previous call
+	static void Update(const std::uint64_t frameIndex) noexcept;
+
+	// Size of the resident mips of streamed textures
+	static std::uint64_t GetResidentSize() noexcept;
+
+private:
+	struct TextureLayout {
+		DDSTextureParser::TextureInfo mInfo;
+
+		// Layouts of the mips in the file, from the finest one
+		std::vector<DDSTextureParser::SubresourceLayout> mMipLayouts;
+	};
+
+	struct StreamedTexture {
+		std::string mFilePath;
+		TextureLayout mLayout;
+		ID3D12Resource* mTexture{ nullptr };
+		std::vector<D3D12_GPU_DESCRIPTOR_HANDLE> mViews;
+	};
+
+	// Texture with a new range of mips, that replaces the texture of mTextureId
+	struct PendingTexture {
+		std::uint32_t mTextureId{ 0U };
+		std::uint32_t mFirstMip{ 0U };
+		std::string mFilePath;
+		TextureLayout mLayout;
+		ID3D12Resource* mTexture{ nullptr };
+	};
+
+	// Creates a texture with the mips of "layout" from "firstMip", and uploads them from "textureData"
+	// (the data of the whole file). Only the pages of these mips are read.
+	static ID3D12Resource& CreateTexture(
+		const TextureLayout& layout,
+		const std::uint32_t firstMip,
+		const std::uint8_t* textureData,
+		const std::size_t textureDataSize) noexcept;
+
+	// Creates the textures of mPendingTextures and flushes their uploads. It runs in a TBB task.
+	static void LoadPendingTextures() noexcept;
+
+	// Replaces textures and their views with mPendingTextures, and releases the old textures.
+	// Preconditions:
+	// - Uploads of mPendingTextures must be completed
+	static void SwapPendingTextures() noexcept;
+
+	static std::vector<StreamedTexture> mTextures;
+	static std::unordered_map<const ID3D12Resource*, std::uint32_t> mTextureIdByResource;
+	static std::unique_ptr<TextureStreamingScheduler> mScheduler;
+	static std::vector<TextureStreamingScheduler::Change> mChanges;
+
+	// Textures that are loaded (mIsLoading) until the uploads of mLoadFenceValue are completed
+	static std::vector<PendingTexture> mPendingTextures;
+	static bool mIsLoading;
+	static std::atomic<bool> mAreLoadsFlushed;
+	static std::uint64_t mLoadFenceValue;
+	static std::uint64_t mLastSwapFrameIndex;
+	static tbb::task_group mTaskGroup;
+
+	// To wait until the graphics queue is idle before updating views
+	static ID3D12Fence* mFence;
+	static std::uint64_t mFenceValue;
+
+	static std::mutex mMutex;
+};
@@ -0,0 +1,308 @@
+#include "TextureStreamingScheduler.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <Utils/DebugUtils.h>
+
+namespace {
+	bool IsMipInMask(const std::uint32_t mipMask, const std::uint32_t mip) noexcept {
+		return ((mipMask >> mip) & 1U) != 0U;
+	}
+
+	// Size of the mips in [firstMip, endMip)
+	std::uint64_t GetMipsSize(
+		const std::vector<std::uint64_t>& mipSizes,
+		const std::uint32_t firstMip,
+		const std::uint32_t endMip) noexcept
+	{
+		std::uint64_t size{ 0UL };
+		for (std::uint32_t i = firstMip; i < endMip; ++i) {
+			size += mipSizes[i];
+		}
+
+		return size;
+	}
+}
+
+const std::uint32_t TextureStreamingScheduler::sAllMipsMask;
+const std::uint32_t TextureStreamingScheduler::sMaxMipCount;
+
+TextureStreamingScheduler::TextureStreamingScheduler(
+	const std::uint64_t memoryBudget,
+	const std::uint64_t maxLoadSizePerSchedule)
+	: mMemoryBudget(memoryBudget)
+	, mMaxLoadSizePerSchedule(maxLoadSizePerSchedule)
+{
+	ASSERT(maxLoadSizePerSchedule > 0UL);
+}
+
+std::uint32_t TextureStreamingScheduler::AddTexture(
+	const std::uint64_t* mipSizes,
+	const std::uint32_t mipCount,
+	const std::uint32_t pinnedMipCount,
+	const std::uint32_t firstResidentMipMask) noexcept
+{
+	ASSERT(mipSizes != nullptr);
+	ASSERT(mipCount <= sMaxMipCount);
+	ASSERT(pinnedMipCount > 0U);
+	ASSERT(pinnedMipCount <= mipCount);
+	ASSERT(IsMipInMask(firstResidentMipMask, mipCount - pinnedMipCount));
+
+	Texture texture;
+	texture.mMipSizes.assign(mipSizes, mipSizes + mipCount);
+	texture.mLastNeededFrames.resize(mipCount, 0UL);
+	texture.mFirstPinnedMip = mipCount - pinnedMipCount;
+	texture.mFirstResidentMipMask = firstResidentMipMask;
+	texture.mFirstResidentMip = texture.mFirstPinnedMip;
+	texture.mRequestedMip = mipCount;
+	texture.mFirstResidentMipBeforeSchedule = texture.mFirstResidentMip;
+
+	for (std::uint32_t i = texture.mFirstPinnedMip; i < mipCount; ++i) {
+		mResidentSize += mipSizes[i];
+	}
+
+	mTextures.push_back(texture);
+
+	return static_cast<std::uint32_t>(mTextures.size() - 1UL);
+}
+
+void TextureStreamingScheduler::RequestMip(
+	const std::uint32_t textureId,
+	const std::uint32_t mip,
+	const float priority) noexcept
+{
+	ASSERT(textureId < mTextures.size());
+
+	Texture& texture{ mTextures[textureId] };
+	ASSERT(mip < texture.mMipSizes.size());
+
+	const std::uint32_t mipCount{ static_cast<std::uint32_t>(texture.mMipSizes.size()) };
+	if (texture.mRequestedMip == mipCount) {
+		mRequestedTextureIds.push_back(textureId);
+		texture.mRequestPriority = priority;
+	} else {
+		texture.mRequestPriority = std::max<float>(texture.mRequestPriority, priority);
+	}
+
+	texture.mRequestedMip = std::min<std::uint32_t>(texture.mRequestedMip, mip);
+}
+
+std::uint32_t TextureStreamingScheduler::ComputeRequiredMip(
+	const std::uint32_t width,
+	const std::uint32_t height,
+	const std::uint32_t mipCount,
+	const float coveredPixelCount) noexcept
+{
+	ASSERT(mipCount > 0U);
+
+	if (coveredPixelCount <= 0.0f) {
+		return mipCount - 1U;
+	}
+
+	// Each mip has a quarter of the texels of the previous one
+	const float texelsPerPixel{ static_cast<float>(width) * static_cast<float>(height) / coveredPixelCount };
+	if (texelsPerPixel <= 1.0f) {
+		return 0U;
+	}
+
+	const std::uint32_t mip{ static_cast<std::uint32_t>(std::floor(0.5f * std::log2(texelsPerPixel))) };
+
+	return std::min<std::uint32_t>(mip, mipCount - 1U);
+}
+
+std::uint32_t TextureStreamingScheduler::ComputeAlignedMipMask(
+	const std::uint32_t width,
+	const std::uint32_t height,
+	const std::uint32_t mipCount,
+	const std::uint32_t blockDimension) noexcept
+{
+	ASSERT(mipCount <= sMaxMipCount);
+	ASSERT(blockDimension > 0U);
+
+	std::uint32_t mipMask{ 0U };
+	for (std::uint32_t i = 0U; i < mipCount; ++i) {
+		const std::uint32_t mipWidth{ std::max<std::uint32_t>(width >> i, 1U) };
+		const std::uint32_t mipHeight{ std::max<std::uint32_t>(height >> i, 1U) };
+		if (mipWidth % blockDimension == 0U && mipHeight % blockDimension == 0U) {
+			mipMask |= 1U << i;
+		}
+	}
+
+	return mipMask;
+}
+
+std::uint32_t TextureStreamingScheduler::ComputePinnedMipCount(
+	const std::uint32_t width,
+	const std::uint32_t height,
+	const std::uint32_t mipCount,
+	const std::uint32_t mipTailMaxDimension,
+	const std::uint32_t firstResidentMipMask) noexcept
+{
+	ASSERT(mipCount > 0U);
+	ASSERT(mipCount <= sMaxMipCount);
+
+	std::uint32_t pinnedMipCount{ mipCount };
+	for (std::uint32_t i = 0U; i < mipCount; ++i) {
+		if (IsMipInMask(firstResidentMipMask, i) == false) {
+			continue;
+		}
+
+		pinnedMipCount = mipCount - i;
+		const std::uint32_t mipWidth{ std::max<std::uint32_t>(width >> i, 1U) };
+		const std::uint32_t mipHeight{ std::max<std::uint32_t>(height >> i, 1U) };
+		if (mipWidth <= mipTailMaxDimension && mipHeight <= mipTailMaxDimension) {
+			break;
+		}
+	}
+
+	return pinnedMipCount;
+}
+
+void TextureStreamingScheduler::ScheduleChanges(
+	const std::uint64_t frameIndex,
+	std::vector<Change>& changes) noexcept
+{
+	ASSERT(frameIndex > mLastFrameIndex);
+	mLastFrameIndex = frameIndex;
+
+	for (Texture& texture : mTextures) {
+		texture.mFirstResidentMipBeforeSchedule = texture.mFirstResidentMip;
+	}
+
+	// Requested mips are needed in this frame, and the ones that are not resident must be loaded
+	mLoads.clear();
+	for (const std::uint32_t textureId : mRequestedTextureIds) {
+		Texture& texture{ mTextures[textureId] };
+		const std::uint32_t mipCount{ static_cast<std::uint32_t>(texture.mMipSizes.size()) };
+		ASSERT(texture.mRequestedMip < mipCount);
+
+		std::fill(
+			texture.mLastNeededFrames.begin() + texture.mRequestedMip,
+			texture.mLastNeededFrames.end(),
+			frameIndex);
+
+		if (texture.mRequestedMip < texture.mFirstResidentMip) {
+			Load load;
+			load.mTextureId = textureId;
+			load.mRequestedMip = texture.mRequestedMip;
+			load.mPriority = texture.mRequestPriority;
+			mLoads.push_back(load);
+		}
+
+		texture.mRequestedMip = mipCount;
+	}
+	mRequestedTextureIds.clear();
+
+	// Fit resident mips in the budget
+	const std::uint32_t invalidTextureId{ static_cast<std::uint32_t>(mTextures.size()) };
+	while (mResidentSize > mMemoryBudget && EvictLeastRecentlyNeededMips(frameIndex, true, invalidTextureId)) {
+	}
+
+	// Textures with greater priority load first, and their mips are loaded from 
+	// the coarsest one, so they improve gradually if their finest mips do not fit.
+	std::stable_sort(
+		mLoads.begin(),
+		mLoads.end(),
+		[](const Load& a, const Load& b) { return a.mPriority > b.mPriority; });
+
+	std::uint64_t loadSize{ 0UL };
+	for (const Load& load : mLoads) {
+		Texture& texture{ mTextures[load.mTextureId] };
+		while (texture.mFirstResidentMip > load.mRequestedMip) {
+			// Mips are loaded up to the previous mip that can be the first resident one
+			std::uint32_t firstMip{ texture.mFirstResidentMip - 1U };
+			while (firstMip > 0U && IsMipInMask(texture.mFirstResidentMipMask, firstMip) == false) {
+				--firstMip;
+			}
+			if (IsMipInMask(texture.mFirstResidentMipMask, firstMip) == false) {
+				break;
+			}
+
+			// Mips larger than the maximum load size are loaded alone, so they are not postponed forever
+			const std::uint64_t mipsSize{ GetMipsSize(texture.mMipSizes, firstMip, texture.mFirstResidentMip) };
+			if (loadSize > 0UL && loadSize + mipsSize > mMaxLoadSizePerSchedule) {
+				break;
+			}
+
+			while (mResidentSize + mipsSize > mMemoryBudget &&
+				   EvictLeastRecentlyNeededMips(frameIndex, false, load.mTextureId)) {
+			}
+
+			if (mResidentSize + mipsSize > mMemoryBudget) {
+				break;
+			}
+
+			texture.mFirstResidentMip = firstMip;
+			mResidentSize += mipsSize;
+			loadSize += mipsSize;
+		}
+	}
+
+	const std::uint32_t textureCount{ static_cast<std::uint32_t>(mTextures.size()) };
+	for (std::uint32_t i = 0U; i < textureCount; ++i) {
+		const Texture& texture{ mTextures[i] };
+		if (texture.mFirstResidentMip != texture.mFirstResidentMipBeforeSchedule) {
+			Change change;
+			change.mTextureId = i;
+			change.mPreviousFirstResidentMip = texture.mFirstResidentMipBeforeSchedule;
+			change.mFirstResidentMip = texture.mFirstResidentMip;
+			changes.push_back(change);
+		}
+	}
+}
+
+std::uint32_t TextureStreamingScheduler::GetFirstResidentMip(const std::uint32_t textureId) const noexcept {
+	ASSERT(textureId < mTextures.size());
+	return mTextures[textureId].mFirstResidentMip;
+}
+
+bool TextureStreamingScheduler::EvictLeastRecentlyNeededMips(
+	const std::uint64_t frameIndex,
+	const bool canEvictNeededMips,
+	const std::uint32_t excludedTextureId) noexcept
+{
+	// Finer mips are never needed more recently than coarser ones, so the first resident mips
+	// are the least recently needed mips of each texture. They are evicted up to the next mip
+	// that can be the first resident one (the first pinned mip can be), and they are needed
+	// as recently as the coarsest of them.
+	Texture* leastRecentlyNeededTexture{ nullptr };
+	std::uint32_t leastRecentlyNeededEndMip{ 0U };
+	std::uint64_t leastRecentlyNeededFrame{ frameIndex };
+	const std::uint32_t textureCount{ static_cast<std::uint32_t>(mTextures.size()) };
+	for (std::uint32_t i = 0U; i < textureCount; ++i) {
+		Texture& texture{ mTextures[i] };
+		if (i == excludedTextureId || texture.mFirstResidentMip == texture.mFirstPinnedMip) {
+			continue;
+		}
+
+		std::uint32_t endMip{ texture.mFirstResidentMip + 1U };
+		while (IsMipInMask(texture.mFirstResidentMipMask, endMip) == false) {
+			++endMip;
+		}
+		ASSERT(endMip <= texture.mFirstPinnedMip);
+
+		const std::uint64_t lastNeededFrame{ texture.mLastNeededFrames[endMip - 1U] };
+		if (canEvictNeededMips == false && lastNeededFrame >= frameIndex) {
+			continue;
+		}
+
+		if (leastRecentlyNeededTexture == nullptr || lastNeededFrame < leastRecentlyNeededFrame) {
+			leastRecentlyNeededTexture = &texture;
+			leastRecentlyNeededEndMip = endMip;
+			leastRecentlyNeededFrame = lastNeededFrame;
+		}
+	}
+
+	if (leastRecentlyNeededTexture == nullptr) {
+		return false;
+	}
+
+	const std::uint64_t mipsSize{ GetMipsSize(
+		leastRecentlyNeededTexture->mMipSizes, leastRecentlyNeededTexture->mFirstResidentMip, leastRecentlyNeededEndMip) };
+	ASSERT(mResidentSize >= mipsSize);
+	mResidentSize -= mipsSize;
+	leastRecentlyNeededTexture->mFirstResidentMip = leastRecentlyNeededEndMip;
+
+	return true;
+}
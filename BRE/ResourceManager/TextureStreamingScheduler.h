@@ -0,0 +1,164 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// To decide which mips of streamed textures are resident within a memory budget.
+// Resident mips of a texture go from its first resident mip to its last mip, and the
+// last mips (the pinned mips) are always resident. Textures request the finest mip they
+// need (see RequestMip()), and ScheduleChanges() changes the first resident mip of textures:
+// - Requested textures load their missing mips, in decreasing priority order,
+//   up to a maximum load size per call (a mip larger than it is loaded alone).
+// - If a load does not fit in the budget, then the least recently needed mips of other
+//   textures are evicted. Mips needed in the current frame are not evicted to load others.
+// - If resident mips do not fit in the budget (for example, after it is reduced), then
+//   the least recently needed mips are evicted.
+// Textures can restrict the mips that can be their first resident mip (for example, block compressed
+// textures can only start at mips with whole blocks), and then several mips are loaded or evicted at once.
+class TextureStreamingScheduler {
+public:
+	// Mask of the mips that can be the first resident mip (bit i is mip i), if all of them can
+	static const std::uint32_t sAllMipsMask{ 0xFFFFFFFFU };
+
+	// Maximum number of mips of a texture (bits of the mask of the mips)
+	static const std::uint32_t sMaxMipCount{ 32U };
+
+	struct Change {
+		std::uint32_t mTextureId{ 0U };
+		std::uint32_t mPreviousFirstResidentMip{ 0U };
+		std::uint32_t mFirstResidentMip{ 0U };
+	};
+
+	// Preconditions:
+	// - "maxLoadSizePerSchedule" must be greater than zero
+	explicit TextureStreamingScheduler(
+		const std::uint64_t memoryBudget,
+		const std::uint64_t maxLoadSizePerSchedule);
+	~TextureStreamingScheduler() = default;
+	TextureStreamingScheduler(const TextureStreamingScheduler&) = delete;
+	const TextureStreamingScheduler& operator=(const TextureStreamingScheduler&) = delete;
+	TextureStreamingScheduler(TextureStreamingScheduler&&) = delete;
+	TextureStreamingScheduler& operator=(TextureStreamingScheduler&&) = delete;
+
+	// Returns the identifier of the texture. Identifiers are consecutive, starting at zero.
+	// "mipSizes" are the sizes in bytes of the mips, from the finest one.
+	// Only the last "pinnedMipCount" mips are resident after the call.
+	// "firstResidentMipMask" has the mips that can be the first resident mip (bit i is mip i).
+	// Preconditions:
+	// - "mipSizes" must not be nullptr
+	// - "mipCount" must not be greater than sMaxMipCount
+	// - "pinnedMipCount" must be greater than zero and not greater than "mipCount"
+	// - The first pinned mip must be in "firstResidentMipMask"
+	std::uint32_t AddTexture(
+		const std::uint64_t* mipSizes,
+		const std::uint32_t mipCount,
+		const std::uint32_t pinnedMipCount,
+		const std::uint32_t firstResidentMipMask = sAllMipsMask) noexcept;
+
+	// Requests "mip" (and the coarser mips) of the texture. If the texture is requested several
+	// times before ScheduleChanges(), then the finest mip and the greatest priority are kept.
+	// Preconditions:
+	// - "textureId" must be returned by AddTexture()
+	// - "mip" must be less than the mip count of the texture
+	void RequestMip(
+		const std::uint32_t textureId,
+		const std::uint32_t mip,
+		const float priority) noexcept;
+
+	// Returns the finest mip that a texture of "width" x "height" texels needs to
+	// be drawn in "coveredPixelCount" pixels of the screen (about a texel per pixel).
+	// Preconditions:
+	// - "mipCount" must be greater than zero
+	static std::uint32_t ComputeRequiredMip(
+		const std::uint32_t width,
+		const std::uint32_t height,
+		const std::uint32_t mipCount,
+		const float coveredPixelCount) noexcept;
+
+	// Returns the mask of the mips of a texture of "width" x "height" texels whose width and
+	// height are multiples of "blockDimension" (bit i is mip i). Block compressed textures can only
+	// be created from these mips, so it is their mask of first resident mips (see AddTexture()).
+	// Preconditions:
+	// - "mipCount" must not be greater than sMaxMipCount
+	// - "blockDimension" must be greater than zero
+	static std::uint32_t ComputeAlignedMipMask(
+		const std::uint32_t width,
+		const std::uint32_t height,
+		const std::uint32_t mipCount,
+		const std::uint32_t blockDimension) noexcept;
+
+	// Returns the number of pinned mips of a texture of "width" x "height" texels: the mips from the first
+	// mip of "firstResidentMipMask" whose width and height are not greater than "mipTailMaxDimension", or
+	// from the coarsest mip of "firstResidentMipMask" if there is none. It returns "mipCount" if
+	// "firstResidentMipMask" has no mips, so the texture cannot be streamed.
+	// Preconditions:
+	// - "mipCount" must be greater than zero and not greater than sMaxMipCount
+	static std::uint32_t ComputePinnedMipCount(
+		const std::uint32_t width,
+		const std::uint32_t height,
+		const std::uint32_t mipCount,
+		const std::uint32_t mipTailMaxDimension,
+		const std::uint32_t firstResidentMipMask) noexcept;
+
+	// Changes resident mips with the requests done since the previous call, and
+	// appends the textures whose first resident mip changed to "changes".
+	// Preconditions:
+	// - "frameIndex" must be greater than the one of the previous call
+	void ScheduleChanges(const std::uint64_t frameIndex, std::vector<Change>& changes) noexcept;
+
+	// Next call to ScheduleChanges() evicts mips if resident mips do not fit in the new budget
+	__forceinline void SetMemoryBudget(const std::uint64_t memoryBudget) noexcept { mMemoryBudget = memoryBudget; }
+	__forceinline std::uint64_t GetMemoryBudget() const noexcept { return mMemoryBudget; }
+
+	// Size of the resident mips of all the textures
+	__forceinline std::uint64_t GetResidentSize() const noexcept { return mResidentSize; }
+
+	__forceinline std::uint32_t GetTextureCount() const noexcept { return static_cast<std::uint32_t>(mTextures.size()); }
+
+	std::uint32_t GetFirstResidentMip(const std::uint32_t textureId) const noexcept;
+
+private:
+	struct Texture {
+		std::vector<std::uint64_t> mMipSizes;
+
+		// Last frame index that needed each mip (zero if it was never needed)
+		std::vector<std::uint64_t> mLastNeededFrames;
+
+		std::uint32_t mFirstResidentMip{ 0U };
+		std::uint32_t mFirstPinnedMip{ 0U };
+		std::uint32_t mFirstResidentMipMask{ sAllMipsMask };
+
+		// Finest requested mip since the previous ScheduleChanges(), or
+		// the mip count if it was not requested.
+		std::uint32_t mRequestedMip{ 0U };
+		float mRequestPriority{ 0.0f };
+
+		std::uint32_t mFirstResidentMipBeforeSchedule{ 0U };
+	};
+
+	struct Load {
+		std::uint32_t mTextureId{ 0U };
+		std::uint32_t mRequestedMip{ 0U };
+		float mPriority{ 0.0f };
+	};
+
+	// Evicts the first resident mips of the texture (except "excludedTextureId") whose first
+	// resident mips were needed least recently, up to the next mip that can be the first resident one.
+	// If "canEvictNeededMips" is false, then mips needed in "frameIndex" are not evicted.
+	// It returns false if there are no mips to evict.
+	bool EvictLeastRecentlyNeededMips(
+		const std::uint64_t frameIndex,
+		const bool canEvictNeededMips,
+		const std::uint32_t excludedTextureId) noexcept;
+
+	std::vector<Texture> mTextures;
+
+	// Textures requested since the previous ScheduleChanges(), and the loads of the current one
+	std::vector<std::uint32_t> mRequestedTextureIds;
+	std::vector<Load> mLoads;
+
+	std::uint64_t mMemoryBudget{ 0UL };
+	std::uint64_t mMaxLoadSizePerSchedule{ 0UL };
+	std::uint64_t mResidentSize{ 0UL };
+	std::uint64_t mLastFrameIndex{ 0UL };
+};
@@ -0,0 +1,327 @@
+#include "TlsfAllocator.h"
+
+#ifdef _WIN32
+#include <intrin.h>
+#endif
+
+#include <Utils/DebugUtils.h>
+
+namespace {
+	const std::uint64_t sOne{ 1U };
+
+	// Index of the least significant bit set
+	std::uint32_t FindFirstSetBit(const std::uint64_t value) noexcept {
+		ASSERT(value != 0UL);
+#ifdef _WIN32
+		unsigned long index;
+		_BitScanForward64(&index, value);
+		return static_cast<std::uint32_t>(index);
+#else
+		return static_cast<std::uint32_t>(__builtin_ctzll(value));
+#endif
+	}
+
+	// Index of the most significant bit set
+	std::uint32_t FindLastSetBit(const std::uint64_t value) noexcept {
+		ASSERT(value != 0UL);
+#ifdef _WIN32
+		unsigned long index;
+		_BitScanReverse64(&index, value);
+		return static_cast<std::uint32_t>(index);
+#else
+		return static_cast<std::uint32_t>(63 - __builtin_clzll(value));
+#endif
+	}
+
+	std::uint64_t AlignUp(const std::uint64_t value, const std::uint64_t alignment) noexcept {
+		return (value + alignment - sOne) & ~(alignment - sOne);
+	}
+}
+
+const std::uint32_t TlsfAllocator::sInvalidHandle;
+const std::uint32_t TlsfAllocator::sSecondLevelBitCount;
+const std::uint32_t TlsfAllocator::sSecondLevelCount;
+const std::uint32_t TlsfAllocator::sFirstLevelCount;
+
+TlsfAllocator::TlsfAllocator(const std::uint64_t capacity, const std::uint64_t granularity)
+	: mCapacity(capacity)
+	, mGranularity(granularity)
+{
+	ASSERT(granularity > 0UL && (granularity & (granularity - sOne)) == 0UL);
+	ASSERT(capacity > 0UL && capacity % granularity == 0UL);
+
+	for (std::uint32_t i = 0U; i < sFirstLevelCount; ++i) {
+		mSecondLevelBitmaps[i] = 0U;
+		for (std::uint32_t j = 0U; j < sSecondLevelCount; ++j) {
+			mFreeLists[i][j] = sInvalidHandle;
+		}
+	}
+
+	InsertFreeBlock(CreateBlock(0UL, capacity));
+}
+
+std::uint32_t TlsfAllocator::Allocate(const std::uint64_t size, const std::uint64_t alignment, std::uint64_t& offset) noexcept {
+	ASSERT(size > 0UL);
+	ASSERT(alignment > 0UL && (alignment & (alignment - sOne)) == 0UL);
+
+	// Block offsets are granularity aligned, so we only need padding for larger alignments
+	const std::uint64_t alignedSize{ AlignUp(size, mGranularity) };
+	const std::uint64_t maxPadding{ alignment > mGranularity ? alignment - mGranularity : 0UL };
+	if (alignedSize + maxPadding > mCapacity - mUsedSize) {
+		return sInvalidHandle;
+	}
+
+	std::uint32_t blockIndex{ FindFreeBlock(alignedSize + maxPadding) };
+	if (blockIndex == sInvalidHandle) {
+		return sInvalidHandle;
+	}
+	RemoveFreeBlock(blockIndex);
+
+	// Padding before the aligned offset is a new free block. Its previous 
+	// physical block is not free, because free neighbors are always merged.
+	const std::uint64_t blockOffset{ mBlocks[blockIndex].mOffset };
+	const std::uint64_t padding{ AlignUp(blockOffset, alignment) - blockOffset };
+	if (padding > 0UL) {
+		const std::uint32_t paddingBlockIndex{ blockIndex };
+		blockIndex = SplitBlock(paddingBlockIndex, padding);
+		InsertFreeBlock(paddingBlockIndex);
+	}
+
+	// The rest after the allocation is a new free block
+	ASSERT(mBlocks[blockIndex].mSize >= alignedSize);
+	if (mBlocks[blockIndex].mSize > alignedSize) {
+		InsertFreeBlock(SplitBlock(blockIndex, alignedSize));
+	}
+
+	mUsedSize += alignedSize;
+	mPeakUsedSize = mUsedSize > mPeakUsedSize ? mUsedSize : mPeakUsedSize;
+	++mAllocationCount;
+
+	offset = mBlocks[blockIndex].mOffset;
+	ASSERT(offset % alignment == 0UL);
+
+	return blockIndex;
+}
+
+void TlsfAllocator::Free(const std::uint32_t handle) noexcept {
+	ASSERT(handle < mBlocks.size());
+	ASSERT(mBlocks[handle].mIsFree == false);
+	ASSERT(mAllocationCount > 0U);
+
+	mUsedSize -= mBlocks[handle].mSize;
+	--mAllocationCount;
+
+	std::uint32_t blockIndex{ handle };
+
+	const std::uint32_t nextIndex{ mBlocks[blockIndex].mNextPhysical };
+	if (nextIndex != sInvalidHandle && mBlocks[nextIndex].mIsFree) {
+		RemoveFreeBlock(nextIndex);
+		MergeWithNextBlock(blockIndex);
+	}
+
+	const std::uint32_t previousIndex{ mBlocks[blockIndex].mPreviousPhysical };
+	if (previousIndex != sInvalidHandle && mBlocks[previousIndex].mIsFree) {
+		RemoveFreeBlock(previousIndex);
+		MergeWithNextBlock(previousIndex);
+		blockIndex = previousIndex;
+	}
+
+	InsertFreeBlock(blockIndex);
+}
+
+TlsfAllocator::Statistics TlsfAllocator::GetStatistics() const noexcept {
+	Statistics statistics;
+	statistics.mUsedSize = mUsedSize;
+	statistics.mPeakUsedSize = mPeakUsedSize;
+	statistics.mFreeBlockCount = mFreeBlockCount;
+	statistics.mAllocationCount = mAllocationCount;
+
+	// Largest free block is in the highest non empty list
+	if (mFirstLevelBitmap != 0UL) {
+		const std::uint32_t firstLevelIndex{ FindLastSetBit(mFirstLevelBitmap) };
+		const std::uint32_t secondLevelIndex{ FindLastSetBit(mSecondLevelBitmaps[firstLevelIndex]) };
+		std::uint32_t blockIndex{ mFreeLists[firstLevelIndex][secondLevelIndex] };
+		while (blockIndex != sInvalidHandle) {
+			if (mBlocks[blockIndex].mSize > statistics.mLargestFreeBlockSize) {
+				statistics.mLargestFreeBlockSize = mBlocks[blockIndex].mSize;
+			}
+			blockIndex = mBlocks[blockIndex].mNextFree;
+		}
+	}
+
+	return statistics;
+}
+
+float TlsfAllocator::GetFragmentation() const noexcept {
+	const std::uint64_t freeSize{ mCapacity - mUsedSize };
+	if (freeSize == 0UL) {
+		return 0.0f;
+	}
+
+	return 1.0f - static_cast<float>(GetStatistics().mLargestFreeBlockSize) / static_cast<float>(freeSize);
+}
+
+void TlsfAllocator::GetListIndices(
+	const std::uint64_t size,
+	std::uint32_t& firstLevelIndex,
+	std::uint32_t& secondLevelIndex) noexcept
+{
+	ASSERT(size > 0UL);
+
+	// Sizes less than sSecondLevelCount are in the first level, one class per size
+	if (size < sSecondLevelCount) {
+		firstLevelIndex = 0U;
+		secondLevelIndex = static_cast<std::uint32_t>(size);
+		return;
+	}
+
+	const std::uint32_t lastSetBit{ FindLastSetBit(size) };
+	firstLevelIndex = lastSetBit - sSecondLevelBitCount + 1U;
+	secondLevelIndex = static_cast<std::uint32_t>(size >> (lastSetBit - sSecondLevelBitCount)) ^ sSecondLevelCount;
+}
+
+std::uint32_t TlsfAllocator::FindFreeBlock(const std::uint64_t size) const noexcept {
+	// Size is rounded up to the next size class, so any block of its list is large enough
+	std::uint64_t searchSize{ size };
+	if (size >= sSecondLevelCount) {
+		searchSize += (sOne << (FindLastSetBit(size) - sSecondLevelBitCount)) - sOne;
+	}
+
+	std::uint32_t firstLevelIndex;
+	std::uint32_t secondLevelIndex;
+	GetListIndices(searchSize, firstLevelIndex, secondLevelIndex);
+
+	// Non empty list in the same first level, with a greater or equal second level
+	const std::uint32_t secondLevelBitmap{ mSecondLevelBitmaps[firstLevelIndex] & (~0U << secondLevelIndex) };
+	if (secondLevelBitmap != 0U) {
+		return mFreeLists[firstLevelIndex][FindFirstSetBit(secondLevelBitmap)];
+	}
+
+	// Otherwise, the first non empty list in a greater first level
+	if (firstLevelIndex + 1U >= sFirstLevelCount) {
+		return sInvalidHandle;
+	}
+	const std::uint64_t firstLevelBitmap{ mFirstLevelBitmap & ~((sOne << (firstLevelIndex + 1U)) - sOne) };
+	if (firstLevelBitmap == 0UL) {
+		return sInvalidHandle;
+	}
+
+	firstLevelIndex = FindFirstSetBit(firstLevelBitmap);
+	secondLevelIndex = FindFirstSetBit(mSecondLevelBitmaps[firstLevelIndex]);
+
+	return mFreeLists[firstLevelIndex][secondLevelIndex];
+}
+
+std::uint32_t TlsfAllocator::CreateBlock(const std::uint64_t offset, const std::uint64_t size) noexcept {
+	std::uint32_t blockIndex;
+	if (mUnusedBlockIndices.empty()) {
+		blockIndex = static_cast<std::uint32_t>(mBlocks.size());
+		mBlocks.emplace_back();
+	} else {
+		blockIndex = mUnusedBlockIndices.back();
+		mUnusedBlockIndices.pop_back();
+		mBlocks[blockIndex] = Block();
+	}
+
+	mBlocks[blockIndex].mOffset = offset;
+	mBlocks[blockIndex].mSize = size;
+
+	return blockIndex;
+}
+
+void TlsfAllocator::DestroyBlock(const std::uint32_t blockIndex) noexcept {
+	ASSERT(blockIndex < mBlocks.size());
+	mUnusedBlockIndices.push_back(blockIndex);
+}
+
+void TlsfAllocator::InsertFreeBlock(const std::uint32_t blockIndex) noexcept {
+	Block& block = mBlocks[blockIndex];
+	ASSERT(block.mIsFree == false);
+
+	std::uint32_t firstLevelIndex;
+	std::uint32_t secondLevelIndex;
+	GetListIndices(block.mSize, firstLevelIndex, secondLevelIndex);
+
+	const std::uint32_t headIndex{ mFreeLists[firstLevelIndex][secondLevelIndex] };
+	block.mIsFree = true;
+	block.mPreviousFree = sInvalidHandle;
+	block.mNextFree = headIndex;
+	if (headIndex != sInvalidHandle) {
+		mBlocks[headIndex].mPreviousFree = blockIndex;
+	}
+
+	mFreeLists[firstLevelIndex][secondLevelIndex] = blockIndex;
+	mFirstLevelBitmap |= sOne << firstLevelIndex;
+	mSecondLevelBitmaps[firstLevelIndex] |= 1U << secondLevelIndex;
+	++mFreeBlockCount;
+}
+
+void TlsfAllocator::RemoveFreeBlock(const std::uint32_t blockIndex) noexcept {
+	Block& block = mBlocks[blockIndex];
+	ASSERT(block.mIsFree);
+
+	if (block.mPreviousFree != sInvalidHandle) {
+		mBlocks[block.mPreviousFree].mNextFree = block.mNextFree;
+	} else {
+		// It is the head of its list
+		std::uint32_t firstLevelIndex;
+		std::uint32_t secondLevelIndex;
+		GetListIndices(block.mSize, firstLevelIndex, secondLevelIndex);
+		ASSERT(mFreeLists[firstLevelIndex][secondLevelIndex] == blockIndex);
+
+		mFreeLists[firstLevelIndex][secondLevelIndex] = block.mNextFree;
+		if (block.mNextFree == sInvalidHandle) {
+			mSecondLevelBitmaps[firstLevelIndex] &= ~(1U << secondLevelIndex);
+			if (mSecondLevelBitmaps[firstLevelIndex] == 0U) {
+				mFirstLevelBitmap &= ~(sOne << firstLevelIndex);
+			}
+		}
+	}
+
+	if (block.mNextFree != sInvalidHandle) {
+		mBlocks[block.mNextFree].mPreviousFree = block.mPreviousFree;
+	}
+
+	block.mIsFree = false;
+	block.mPreviousFree = sInvalidHandle;
+	block.mNextFree = sInvalidHandle;
+	--mFreeBlockCount;
+}
+
+std::uint32_t TlsfAllocator::SplitBlock(const std::uint32_t blockIndex, const std::uint64_t size) noexcept {
+	ASSERT(mBlocks[blockIndex].mIsFree == false);
+	ASSERT(size > 0UL && size < mBlocks[blockIndex].mSize);
+
+	// CreateBlock() can reallocate mBlocks, so we take references after it
+	const std::uint32_t restIndex{ CreateBlock(mBlocks[blockIndex].mOffset + size, mBlocks[blockIndex].mSize - size) };
+	Block& block = mBlocks[blockIndex];
+	Block& rest = mBlocks[restIndex];
+
+	rest.mPreviousPhysical = blockIndex;
+	rest.mNextPhysical = block.mNextPhysical;
+	if (block.mNextPhysical != sInvalidHandle) {
+		mBlocks[block.mNextPhysical].mPreviousPhysical = restIndex;
+	}
+
+	block.mNextPhysical = restIndex;
+	block.mSize = size;
+
+	return restIndex;
+}
+
+void TlsfAllocator::MergeWithNextBlock(const std::uint32_t blockIndex) noexcept {
+	Block& block = mBlocks[blockIndex];
+	const std::uint32_t nextIndex{ block.mNextPhysical };
+	ASSERT(nextIndex != sInvalidHandle);
+	ASSERT(block.mIsFree == false && mBlocks[nextIndex].mIsFree == false);
+
+	const Block& next = mBlocks[nextIndex];
+	ASSERT(block.mOffset + block.mSize == next.mOffset);
+	block.mSize += next.mSize;
+	block.mNextPhysical = next.mNextPhysical;
+	if (next.mNextPhysical != sInvalidHandle) {
+		mBlocks[next.mNextPhysical].mPreviousPhysical = blockIndex;
+	}
+
+	DestroyBlock(nextIndex);
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Two-Level Segregated Fit allocator of ranges of [0, capacity) bytes (for 
+// example, the placed resources of a heap).
+// Free blocks are kept in lists by size class: the first level is the power of two 
+// of the size, and the second level splits it in sSecondLevelCount linear classes.
+// Bitmaps of non empty lists find a free block that is large enough in constant time,
+// and freed blocks are merged with their free neighbors in constant time.
+// Offsets and sizes are multiples of "granularity", and offsets can have a larger alignment.
+// It is not thread safe.
+class TlsfAllocator {
+public:
+	static const std::uint32_t sInvalidHandle{ 0xFFFFFFFFU };
+	static const std::uint32_t sSecondLevelBitCount{ 4U };
+	static const std::uint32_t sSecondLevelCount{ 1U << sSecondLevelBitCount };
+	static const std::uint32_t sFirstLevelCount{ 64U };
+
+	struct Statistics {
+		std::uint64_t mUsedSize{ 0UL };
+		std::uint64_t mPeakUsedSize{ 0UL };
+		std::uint64_t mLargestFreeBlockSize{ 0UL };
+		std::uint32_t mFreeBlockCount{ 0U };
+		std::uint32_t mAllocationCount{ 0U };
+	};
+
+	// Preconditions:
+	// - "granularity" must be a power of two
+	// - "capacity" must be a multiple of "granularity" and greater than zero
+	explicit TlsfAllocator(const std::uint64_t capacity, const std::uint64_t granularity);
+
+	~TlsfAllocator() = default;
+	TlsfAllocator(const TlsfAllocator&) = delete;
+	const TlsfAllocator& operator=(const TlsfAllocator&) = delete;
+	TlsfAllocator(TlsfAllocator&&) = delete;
+	TlsfAllocator& operator=(TlsfAllocator&&) = delete;
+
+	// Allocates "size" bytes (rounded up to the granularity) starting at an "alignment" aligned offset. 
+	// It returns the handle of the allocation (to free it) and its offset in "offset",
+	// or sInvalidHandle if there is no free block large enough.
+	// Preconditions:
+	// - "size" must be greater than zero
+	// - "alignment" must be a power of two
+	std::uint32_t Allocate(const std::uint64_t size, const std::uint64_t alignment, std::uint64_t& offset) noexcept;
+
+	// Preconditions:
+	// - "handle" must have been returned by Allocate() and not freed
+	void Free(const std::uint32_t handle) noexcept;
+
+	__forceinline std::uint64_t GetCapacity() const noexcept { return mCapacity; }
+	__forceinline std::uint64_t GetUsedSize() const noexcept { return mUsedSize; }
+	__forceinline std::uint32_t GetAllocationCount() const noexcept { return mAllocationCount; }
+
+	Statistics GetStatistics() const noexcept;
+
+	// 0.0 if free bytes are contiguous, and close to 1.0 if they are
+	// split in many small blocks (1 - largest free block size / free size)
+	float GetFragmentation() const noexcept;
+
+private:
+	struct Block {
+		std::uint64_t mOffset{ 0UL };
+		std::uint64_t mSize{ 0UL };
+
+		// Neighbor blocks in memory
+		std::uint32_t mPreviousPhysical{ sInvalidHandle };
+		std::uint32_t mNextPhysical{ sInvalidHandle };
+
+		// Neighbor blocks in the free list (only for free blocks)
+		std::uint32_t mPreviousFree{ sInvalidHandle };
+		std::uint32_t mNextFree{ sInvalidHandle };
+
+		bool mIsFree{ false };
+	};
+
+	// Size class of a block of "size" bytes
+	static void GetListIndices(
+		const std::uint64_t size, 
+		std::uint32_t& firstLevelIndex, 
+		std::uint32_t& secondLevelIndex) noexcept;
+
+	// Returns a free block of at least "size" bytes, or sInvalidHandle
+	std::uint32_t FindFreeBlock(const std::uint64_t size) const noexcept;
+
+	std::uint32_t CreateBlock(const std::uint64_t offset, const std::uint64_t size) noexcept;
+	void DestroyBlock(const std::uint32_t blockIndex) noexcept;
+	void InsertFreeBlock(const std::uint32_t blockIndex) noexcept;
+	void RemoveFreeBlock(const std::uint32_t blockIndex) noexcept;
+
+	// Keeps the first "size" bytes in the block, and the rest is a new 
+	// block placed after it, whose index is returned.
+	std::uint32_t SplitBlock(const std::uint32_t blockIndex, const std::uint64_t size) noexcept;
+
+	// Merges the next physical block into the block and destroys it
+	void MergeWithNextBlock(const std::uint32_t blockIndex) noexcept;
+
+	std::uint64_t mCapacity{ 0UL };
+	std::uint64_t mGranularity{ 0UL };
+	std::uint64_t mUsedSize{ 0UL };
+	std::uint64_t mPeakUsedSize{ 0UL };
+	std::uint32_t mAllocationCount{ 0U };
+	std::uint32_t mFreeBlockCount{ 0U };
+
+	// Blocks are stored in a vector, and the elements of destroyed blocks are reused.
+	// Allocation handles are block indices.
+	std::vector<Block> mBlocks;
+	std::vector<std::uint32_t> mUnusedBlockIndices;
+
+	// Heads of the free lists and bitmaps of the non empty lists
+	std::uint32_t mFreeLists[sFirstLevelCount][sSecondLevelCount];
+	std::uint64_t mFirstLevelBitmap{ 0UL };
+	std::uint32_t mSecondLevelBitmaps[sFirstLevelCount];
+};
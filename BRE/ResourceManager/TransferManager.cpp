@@ -0,0 +1,405 @@
+#include "TransferManager.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include <CommandManager\CommandAllocatorManager.h>
+#include <CommandManager\CommandListManager.h>
+#include <CommandManager\CommandQueueManager.h>
+#include <CommandManager\FenceManager.h>
+#include <DirectXManager\DirectXManager.h>
+#include <DXUtils/d3dx12.h>
+#include <ResourceManager\ResourceManager.h>
+#include <Utils/DebugUtils.h>
+
+namespace {
+	// Copies "rowCount" rows of "depth" slices of "sourceData" to the staging memory of "layout", 
+	// and records the copy of "layout" to the subresource of "destinationTexture" at ("destinationY", "destinationZ").
+	void CopySubresource(
+		ID3D12GraphicsCommandList& commandList,
+		ID3D12Resource& destinationTexture,
+		const std::uint32_t subresource,
+		const std::uint32_t destinationY,
+		const std::uint32_t destinationZ,
+		ID3D12Resource& stagingBuffer,
+		std::uint8_t* stagingBufferData,
+		const D3D12_PLACED_SUBRESOURCE_FOOTPRINT& layout,
+		const std::uint32_t rowCount,
+		const std::uint64_t rowSize,
+		const D3D12_SUBRESOURCE_DATA& sourceData) noexcept
+	{
+		const D3D12_MEMCPY_DEST destinationData{
+			stagingBufferData + layout.Offset,
+			layout.Footprint.RowPitch,
+			static_cast<std::size_t>(layout.Footprint.RowPitch) * rowCount
+		};
+		MemcpySubresource(
+			&destinationData,
+			&sourceData,
+			static_cast<std::size_t>(rowSize),
+			rowCount,
+			layout.Footprint.Depth);
+
+		const CD3DX12_TEXTURE_COPY_LOCATION destinationLocation(&destinationTexture, subresource);
+		const CD3DX12_TEXTURE_COPY_LOCATION sourceLocation(&stagingBuffer, layout);
+		commandList.CopyTextureRegion(&destinationLocation, 0U, destinationY, destinationZ, &sourceLocation, nullptr);
+	}
+
+	std::uint64_t GetSubresourceSize(const D3D12_PLACED_SUBRESOURCE_FOOTPRINT& layout, const std::uint32_t rowCount) noexcept {
+		return static_cast<std::uint64_t>(layout.Footprint.RowPitch) * rowCount * layout.Footprint.Depth;
+	}
+}
+
+const std::uint64_t TransferManager::sStagingBufferSize;
+ID3D12CommandQueue* TransferManager::mCommandQueue{ nullptr };
+ID3D12Fence* TransferManager::mFence{ nullptr };
+std::uint64_t TransferManager::mLastSubmittedFenceValue{ 0UL };
+ID3D12GraphicsCommandList* TransferManager::mCommandList{ nullptr };
+ID3D12CommandAllocator* TransferManager::mCommandAllocator{ nullptr };
+std::queue<TransferManager::CommandAllocatorInFlight> TransferManager::mCommandAllocatorsInFlight;
+bool TransferManager::mIsBatchOpen{ false };
+ID3D12Resource* TransferManager::mStagingBuffer{ nullptr };
+std::uint8_t* TransferManager::mStagingBufferData{ nullptr };
+StagingRingAllocator TransferManager::mStagingRing(TransferManager::sStagingBufferSize);
+std::mutex TransferManager::mMutex;
+
+void TransferManager::Init() noexcept {
+	ASSERT(mCommandQueue == nullptr);
+
+	D3D12_COMMAND_QUEUE_DESC commandQueueDescriptor = {};
+	commandQueueDescriptor.Type = D3D12_COMMAND_LIST_TYPE_COPY;
+	commandQueueDescriptor.Flags = D3D12_COMMAND_QUEUE_FLAG_NONE;
+	mCommandQueue = &CommandQueueManager::CreateCommandQueue(commandQueueDescriptor);
+	mCommandQueue->SetName(L"Copy Queue");
+
+	mFence = &FenceManager::CreateFence(0U, D3D12_FENCE_FLAG_NONE);
+
+	// Command lists are created in recording state. The allocator is ready to be reused.
+	CommandAllocatorInFlight commandAllocatorInFlight;
+	commandAllocatorInFlight.mCommandAllocator = &CommandAllocatorManager::CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_COPY);
+	mCommandList = &CommandListManager::CreateCommandList(D3D12_COMMAND_LIST_TYPE_COPY, *commandAllocatorInFlight.mCommandAllocator);
+	CHECK_HR(mCommandList->Close());
+	mCommandAllocatorsInFlight.push(commandAllocatorInFlight);
+
+	D3D12_HEAP_PROPERTIES heapProps{};
+	heapProps.Type = D3D12_HEAP_TYPE_UPLOAD;
+	heapProps.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+	heapProps.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+	heapProps.CreationNodeMask = 1U;
+	heapProps.VisibleNodeMask = 1U;
+
+	const CD3DX12_RESOURCE_DESC resDesc{ CD3DX12_RESOURCE_DESC::Buffer(sStagingBufferSize) };
+	mStagingBuffer = &ResourceManager::CreateCommittedResource(
+		heapProps,
+		D3D12_HEAP_FLAG_NONE,
+		resDesc,
+		D3D12_RESOURCE_STATE_GENERIC_READ,
+		nullptr,
+		L"Staging Buffer");
+
+	// We do not read from it
+	const D3D12_RANGE readRange{ 0UL, 0UL };
+	CHECK_HR(mStagingBuffer->Map(0U, &readRange, reinterpret_cast<void**>(&mStagingBufferData)));
+}
+
+void TransferManager::EraseAll() noexcept {
+	std::lock_guard<std::mutex> lock(mMutex);
+	if (mCommandQueue == nullptr) {
+		return;
+	}
+
+	if (mIsBatchOpen) {
+		SubmitBatch();
+	}
+	WaitOnCpu(mLastSubmittedFenceValue);
+	mStagingRing.ReleaseCompletedBatches(mLastSubmittedFenceValue);
+
+	// Command objects and the staging buffer are destroyed by their managers
+	mCommandAllocatorsInFlight = std::queue<CommandAllocatorInFlight>();
+	mCommandAllocator = nullptr;
+	mCommandList = nullptr;
+	mFence = nullptr;
+	mCommandQueue = nullptr;
+	mStagingBuffer = nullptr;
+	mStagingBufferData = nullptr;
+}
+
+void TransferManager::UploadBuffer(
+	ID3D12Resource& destinationBuffer,
+	const std::uint64_t destinationOffset,
+	const void* sourceData,
+	const std::size_t sourceDataSize) noexcept
+{
+	ASSERT(sourceData != nullptr);
+	ASSERT(sourceDataSize > 0UL);
+	ASSERT(destinationOffset + sourceDataSize <= destinationBuffer.GetDesc().Width);
+
+	const std::uint8_t* data{ static_cast<const std::uint8_t*>(sourceData) };
+	std::uint64_t copiedSize{ 0UL };
+
+	std::unique_lock<std::mutex> lock(mMutex);
+	ASSERT(mCommandQueue != nullptr);
+	while (copiedSize < sourceDataSize) {
+		const std::uint64_t remainingSize{ sourceDataSize - copiedSize };
+		const std::uint64_t size{ remainingSize < sStagingBufferSize ? remainingSize : sStagingBufferSize };
+
+		// Buffer copies do not need alignment, but we keep staging data 16 bytes aligned for memcpy.
+		const std::uint64_t stagingOffset{ AllocateStagingMemory(lock, size, 16UL) };
+		std::memcpy(mStagingBufferData + stagingOffset, data + copiedSize, static_cast<std::size_t>(size));
+
+		GetCommandList().CopyBufferRegion(
+			&destinationBuffer, 
+			destinationOffset + copiedSize, 
+			mStagingBuffer, 
+			stagingOffset, 
+			size);
+
+		copiedSize += size;
+	}
+}
+
+void TransferManager::UploadTexture(
+	ID3D12Resource& destinationTexture,
+	const std::uint32_t firstSubresource,
+	const std::uint32_t subresourceCount,
+	const D3D12_SUBRESOURCE_DATA* subresourceData) noexcept
+{
+	ASSERT(subresourceData != nullptr);
+	ASSERT(subresourceCount > 0U);
+
+	const D3D12_RESOURCE_DESC textureDescriptor{ destinationTexture.GetDesc() };
+	std::vector<D3D12_PLACED_SUBRESOURCE_FOOTPRINT> layouts(subresourceCount);
+	std::vector<std::uint32_t> rowCounts(subresourceCount);
+	std::vector<std::uint64_t> rowSizes(subresourceCount);
+	DirectXManager::GetDevice().GetCopyableFootprints(
+		&textureDescriptor,
+		firstSubresource,
+		subresourceCount,
+		0UL,
+		layouts.data(),
+		rowCounts.data(),
+		rowSizes.data(),
+		nullptr);
+
+	std::unique_lock<std::mutex> lock(mMutex);
+	ASSERT(mCommandQueue != nullptr);
+
+	// Consecutive subresources are uploaded in groups that fit in the staging buffer.
+	// Footprints are contiguous, so a group is copied to a single allocation.
+	std::uint32_t groupBegin{ 0U };
+	while (groupBegin < subresourceCount) {
+		const std::uint64_t groupOffset{ layouts[groupBegin].Offset };
+		std::uint64_t groupSize{ 0UL };
+		std::uint32_t groupEnd{ groupBegin };
+		while (groupEnd < subresourceCount) {
+			const std::uint64_t subresourceEnd{ layouts[groupEnd].Offset + GetSubresourceSize(layouts[groupEnd], rowCounts[groupEnd]) };
+			if (subresourceEnd - groupOffset > sStagingBufferSize) {
+				break;
+			}
+			groupSize = subresourceEnd - groupOffset;
+			++groupEnd;
+		}
+
+		if (groupEnd == groupBegin) {
+			UploadLargeSubresource(
+				lock,
+				destinationTexture,
+				firstSubresource + groupBegin,
+				layouts[groupBegin],
+				rowCounts[groupBegin],
+				rowSizes[groupBegin],
+				subresourceData[groupBegin]);
+			++groupBegin;
+			continue;
+		}
+
+		// Footprint offsets are relative to the beginning of the group. It is aligned to the
+		// placement alignment, so they keep their alignment in the staging buffer.
+		const std::uint64_t stagingOffset{ AllocateStagingMemory(lock, groupSize, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT) };
+
+		ID3D12GraphicsCommandList& commandList = GetCommandList();
+		for (std::uint32_t i = groupBegin; i < groupEnd; ++i) {
+			D3D12_PLACED_SUBRESOURCE_FOOTPRINT layout{ layouts[i] };
+			layout.Offset = layout.Offset - groupOffset + stagingOffset;
+			CopySubresource(
+				commandList,
+				destinationTexture,
+				firstSubresource + i,
+				0U,
+				0U,
+				*mStagingBuffer,
+				mStagingBufferData,
+				layout,
+				rowCounts[i],
+				rowSizes[i],
+				subresourceData[i]);
+		}
+
+		groupBegin = groupEnd;
+	}
+}
+
+std::uint64_t TransferManager::Flush() noexcept {
+	std::lock_guard<std::mutex> lock(mMutex);
+	ASSERT(mCommandQueue != nullptr);
+
+	if (mIsBatchOpen) {
+		SubmitBatch();
+	}
+
+	return mLastSubmittedFenceValue;
+}
+
+void TransferManager::WaitOnGpu(ID3D12CommandQueue& commandQueue, const std::uint64_t fenceValue) noexcept {
+	ASSERT(mFence != nullptr);
+	ASSERT(fenceValue <= mLastSubmittedFenceValue);
+
+	if (mFence->GetCompletedValue() < fenceValue) {
+		CHECK_HR(commandQueue.Wait(mFence, fenceValue));
+	}
+}
+
+void TransferManager::WaitOnCpu(const std::uint64_t fenceValue) noexcept {
+	ASSERT(mFence != nullptr);
+	ASSERT(fenceValue <= mLastSubmittedFenceValue);
+
+	if (mFence->GetCompletedValue() < fenceValue) {
+		const HANDLE eventHandle{ CreateEventEx(nullptr, nullptr, false, EVENT_ALL_ACCESS) };
+		ASSERT(eventHandle);
+
+		CHECK_HR(mFence->SetEventOnCompletion(fenceValue, eventHandle));
+		WaitForSingleObject(eventHandle, INFINITE);
+		CloseHandle(eventHandle);
+	}
+}
+
+bool TransferManager::IsCompleted(const std::uint64_t fenceValue) noexcept {
+	ASSERT(mFence != nullptr);
+	ASSERT(fenceValue <= mLastSubmittedFenceValue);
+
+	return mFence->GetCompletedValue() >= fenceValue;
+}
+
+void TransferManager::UploadLargeSubresource(
+	std::unique_lock<std::mutex>& lock,
+	ID3D12Resource& destinationTexture,
+	const std::uint32_t subresource,
+	const D3D12_PLACED_SUBRESOURCE_FOOTPRINT& layout,
+	const std::uint32_t rowCount,
+	const std::uint64_t rowSize,
+	const D3D12_SUBRESOURCE_DATA& subresourceData) noexcept
+{
+	ASSERT(layout.Footprint.RowPitch <= sStagingBufferSize);
+	ASSERT(rowCount > 0U && layout.Footprint.Height % rowCount == 0U);
+
+	// A row of a block compressed format is a row of blocks
+	const std::uint32_t rowHeight{ layout.Footprint.Height / rowCount };
+	const std::uint32_t maxSlabRowCount{ static_cast<std::uint32_t>(sStagingBufferSize / layout.Footprint.RowPitch) };
+
+	// Each depth slice is copied in slabs of rows that fit in the staging buffer
+	for (std::uint32_t slice = 0U; slice < layout.Footprint.Depth; ++slice) {
+		for (std::uint32_t row = 0U; row < rowCount; row += maxSlabRowCount) {
+			const std::uint32_t slabRowCount{ std::min<std::uint32_t>(maxSlabRowCount, rowCount - row) };
+
+			D3D12_PLACED_SUBRESOURCE_FOOTPRINT slabLayout{ layout };
+			slabLayout.Footprint.Height = slabRowCount * rowHeight;
+			slabLayout.Footprint.Depth = 1U;
+			slabLayout.Offset = AllocateStagingMemory(
+				lock, 
+				static_cast<std::uint64_t>(layout.Footprint.RowPitch) * slabRowCount, 
+				D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+
+			D3D12_SUBRESOURCE_DATA slabData{ subresourceData };
+			slabData.pData = static_cast<const std::uint8_t*>(subresourceData.pData) + 
+				slice * subresourceData.SlicePitch + 
+				row * subresourceData.RowPitch;
+
+			CopySubresource(
+				GetCommandList(),
+				destinationTexture,
+				subresource,
+				row * rowHeight,
+				slice,
+				*mStagingBuffer,
+				mStagingBufferData,
+				slabLayout,
+				slabRowCount,
+				rowSize,
+				slabData);
+		}
+	}
+}
+
+std::uint64_t TransferManager::AllocateStagingMemory(
+	std::unique_lock<std::mutex>& lock, 
+	const std::uint64_t sizeInBytes, 
+	const std::uint64_t alignment) noexcept 
+{
+	ASSERT(lock.owns_lock());
+	mStagingRing.ReleaseCompletedBatches(mFence->GetCompletedValue());
+
+	std::uint64_t offset{ mStagingRing.Allocate(sizeInBytes, alignment) };
+	while (offset == StagingRingAllocator::sInvalidOffset) {
+		// Staging memory of the open batch is not released until it is submitted
+		if (mIsBatchOpen) {
+			SubmitBatch();
+		}
+
+		// Other threads can record uploads that fit in the released memory (or wait too) 
+		// while this thread waits for the GPU. They can allocate it before us, so we retry.
+		const std::uint64_t oldestBatchFenceValue{ mStagingRing.GetOldestBatchFenceValue() };
+		lock.unlock();
+		WaitOnCpu(oldestBatchFenceValue);
+		lock.lock();
+
+		mStagingRing.ReleaseCompletedBatches(mFence->GetCompletedValue());
+		offset = mStagingRing.Allocate(sizeInBytes, alignment);
+	}
+
+	return offset;
+}
+
+ID3D12GraphicsCommandList& TransferManager::GetCommandList() noexcept {
+	if (mIsBatchOpen) {
+		return *mCommandList;
+	}
+
+	// Reuse the oldest command allocator if the GPU completed its batch
+	ASSERT(mCommandAllocator == nullptr);
+	if (mCommandAllocatorsInFlight.empty() == false && 
+		mCommandAllocatorsInFlight.front().mFenceValue <= mFence->GetCompletedValue()) 
+	{
+		mCommandAllocator = mCommandAllocatorsInFlight.front().mCommandAllocator;
+		mCommandAllocatorsInFlight.pop();
+		CHECK_HR(mCommandAllocator->Reset());
+	} else {
+		mCommandAllocator = &CommandAllocatorManager::CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_COPY);
+	}
+
+	CHECK_HR(mCommandList->Reset(mCommandAllocator, nullptr));
+	mIsBatchOpen = true;
+
+	return *mCommandList;
+}
+
+void TransferManager::SubmitBatch() noexcept {
+	ASSERT(mIsBatchOpen);
+	ASSERT(mCommandAllocator != nullptr);
+
+	CHECK_HR(mCommandList->Close());
+	ID3D12CommandList* commandLists[1U]{ mCommandList };
+	mCommandQueue->ExecuteCommandLists(_countof(commandLists), commandLists);
+
+	++mLastSubmittedFenceValue;
+	CHECK_HR(mCommandQueue->Signal(mFence, mLastSubmittedFenceValue));
+	mStagingRing.CloseBatch(mLastSubmittedFenceValue);
+
+	CommandAllocatorInFlight commandAllocatorInFlight;
+	commandAllocatorInFlight.mCommandAllocator = mCommandAllocator;
+	commandAllocatorInFlight.mFenceValue = mLastSubmittedFenceValue;
+	mCommandAllocatorsInFlight.push(commandAllocatorInFlight);
+
+	mCommandAllocator = nullptr;
+	mIsBatchOpen = false;
+}
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <d3d12.h>
+#include <mutex>
+#include <queue>
+
+#include <ResourceManager/StagingRingAllocator.h>
+
+// To upload data to default heap buffers and textures.
+// Data is copied to a persistent staging buffer (a ring, see StagingRingAllocator), and 
+// copies are recorded in a command list that is executed in a dedicated copy queue. 
+// Uploads of all the threads are recorded in the same command list (the open batch), 
+// so many uploads are submitted at once by Flush(). Each batch signals a fence in the copy queue,
+// and the graphics queue only waits for it (on the GPU) when it needs the data (see WaitOnGpu()).
+// Staging memory of a batch is reused when its fence is completed. If the staging buffer
+// is full, then the open batch is submitted and the calling thread waits for the oldest batch
+// (without blocking the other threads).
+// Destination resources must be in D3D12_RESOURCE_STATE_COMMON state: they are implicitly promoted
+// to copy destination state, and they decay back to common state when the batch is completed, so the graphics
+// queue can read them without barriers (implicit promotion to read states).
+// Steps:
+// - Call Init() once
+// - Call UploadBuffer() / UploadTexture() from any thread
+// - Call Flush() and use its fence value with WaitOnGpu() or WaitOnCpu() before using the resources
+class TransferManager {
+public:
+	// Size of the staging buffer. Larger uploads are copied in several parts.
+	static const std::uint64_t sStagingBufferSize{ 64UL * 1024UL * 1024UL };
+
+	TransferManager() = delete;
+	~TransferManager() = delete;
+	TransferManager(const TransferManager&) = delete;
+	const TransferManager& operator=(const TransferManager&) = delete;
+	TransferManager(TransferManager&&) = delete;
+	TransferManager& operator=(TransferManager&&) = delete;
+
+	// Preconditions:
+	// - Init() must be called once
+	static void Init() noexcept;
+
+	// Waits until the GPU completes all the batches. It must be called before
+	// command managers and ResourceManager erase their objects.
+	static void EraseAll() noexcept;
+
+	// Copies "sourceData" to "destinationBuffer", starting at "destinationOffset".
+	// Data larger than the staging buffer is copied in several parts.
+	// Preconditions:
+	// - "sourceData" must not be nullptr
+	// - "sourceDataSize" must be greater than zero
+	// - "destinationBuffer" must be in D3D12_RESOURCE_STATE_COMMON state
+	static void UploadBuffer(
+		ID3D12Resource& destinationBuffer,
+		const std::uint64_t destinationOffset,
+		const void* sourceData,
+		const std::size_t sourceDataSize) noexcept;
+
+	// Copies "subresourceCount" subresources (starting at "firstSubresource") of "destinationTexture".
+	// Subresources are copied in groups that fit in the staging buffer, and a subresource 
+	// larger than the staging buffer is copied in slabs of rows.
+	// Preconditions:
+	// - "subresourceData" must have "subresourceCount" elements
+	// - A row of a subresource must fit in the staging buffer
+	// - "destinationTexture" must be in D3D12_RESOURCE_STATE_COMMON state
+	static void UploadTexture(
+		ID3D12Resource& destinationTexture,
+		const std::uint32_t firstSubresource,
+		const std::uint32_t subresourceCount,
+		const D3D12_SUBRESOURCE_DATA* subresourceData) noexcept;
+
+	// Submits the open batch to the copy queue, and returns the fence value that 
+	// is signaled when all the uploads done before are completed.
+	static std::uint64_t Flush() noexcept;
+
+	// Makes "commandQueue" wait (on the GPU) until "fenceValue" is completed, so the command 
+	// lists that are executed after this call can use the uploaded data. It does not block the CPU.
+	// Preconditions:
+	// - "fenceValue" must be returned by Flush()
+	static void WaitOnGpu(ID3D12CommandQueue& commandQueue, const std::uint64_t fenceValue) noexcept;
+
+	// Blocks the calling thread until "fenceValue" is completed.
+	// Preconditions:
+	// - "fenceValue" must be returned by Flush()
+	static void WaitOnCpu(const std::uint64_t fenceValue) noexcept;
+
+	// Returns true if "fenceValue" is completed. It does not block.
+	// Preconditions:
+	// - "fenceValue" must be returned by Flush()
+	static bool IsCompleted(const std::uint64_t fenceValue) noexcept;
+
+private:
+	// Copies a subresource that does not fit in the staging buffer in slabs of rows
+	// of each depth slice. "layout" is its footprint (its offset is ignored).
+	// Preconditions:
+	// - "lock" must own mMutex
+	static void UploadLargeSubresource(
+		std::unique_lock<std::mutex>& lock,
+		ID3D12Resource& destinationTexture,
+		const std::uint32_t subresource,
+		const D3D12_PLACED_SUBRESOURCE_FOOTPRINT& layout,
+		const std::uint32_t rowCount,
+		const std::uint64_t rowSize,
+		const D3D12_SUBRESOURCE_DATA& subresourceData) noexcept;
+
+	// Returns the offset of "sizeInBytes" bytes in the staging buffer. If the staging buffer
+	// is full, then it submits the open batch and waits until the oldest batch is completed.
+	// "lock" is released while it waits, so other threads are not blocked by the GPU, and
+	// the command list of the open batch must be got (GetCommandList()) after this call.
+	// Preconditions:
+	// - "lock" must own mMutex
+	// - "sizeInBytes" must be less or equal than sStagingBufferSize
+	static std::uint64_t AllocateStagingMemory(
+		std::unique_lock<std::mutex>& lock, 
+		const std::uint64_t sizeInBytes, 
+		const std::uint64_t alignment) noexcept;
+
+	// Returns the command list of the open batch, ready to record.
+	// Preconditions:
+	// - mMutex must be locked
+	static ID3D12GraphicsCommandList& GetCommandList() noexcept;
+
+	// Preconditions:
+	// - mMutex must be locked
+	static void SubmitBatch() noexcept;
+
+	struct CommandAllocatorInFlight {
+		ID3D12CommandAllocator* mCommandAllocator{ nullptr };
+		std::uint64_t mFenceValue{ 0UL };
+	};
+
+	static ID3D12CommandQueue* mCommandQueue;
+	static ID3D12Fence* mFence;
+	static std::uint64_t mLastSubmittedFenceValue;
+
+	// Command list of the open batch, and allocators of submitted batches 
+	// (they are reused when their fence is completed)
+	static ID3D12GraphicsCommandList* mCommandList;
+	static ID3D12CommandAllocator* mCommandAllocator;
+	static std::queue<CommandAllocatorInFlight> mCommandAllocatorsInFlight;
+	static bool mIsBatchOpen;
+
+	// Staging buffer is persistently mapped
+	static ID3D12Resource* mStagingBuffer;
+	static std::uint8_t* mStagingBufferData;
+	static StagingRingAllocator mStagingRing;
+
+	static std::mutex mMutex;
+};
@@ -0,0 +1,105 @@
+#include "TransientResourceAllocator.h"
+
+#include <algorithm>
+
+#include <DirectXManager/DirectXManager.h>
+#include <ResourceManager\ResourceManager.h>
+#include <Utils/DebugUtils.h>
+
+std::uint32_t TransientResourceAllocator::AddResource(
+	const D3D12_RESOURCE_DESC& resourceDescriptor,
+	const D3D12_RESOURCE_STATES initialState,
+	const D3D12_CLEAR_VALUE* clearValue,
+	const std::uint32_t firstUse,
+	const std::uint32_t lastUse,
+	const wchar_t* resourceName) noexcept
+{
+	ASSERT(mHeap == nullptr);
+	ASSERT((resourceDescriptor.Flags & (D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET | D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL)) != 0U);
+	ASSERT(firstUse <= lastUse);
+
+	ResourceData resourceData;
+	resourceData.mResourceDescriptor = resourceDescriptor;
+	resourceData.mInitialState = initialState;
+	resourceData.mResourceName = resourceName;
+	if (clearValue != nullptr) {
+		resourceData.mClearValue = *clearValue;
+		resourceData.mHasClearValue = true;
+	}
+	mResources.push_back(resourceData);
+
+	// Size and alignment are filled by Allocate()
+	TransientResourcePlanner::ResourceRequest request;
+	request.mFirstUse = firstUse;
+	request.mLastUse = lastUse;
+	mRequests.push_back(request);
+
+	return static_cast<std::uint32_t>(mResources.size() - 1UL);
+}
+
+void TransientResourceAllocator::Allocate() noexcept {
+	ASSERT(mHeap == nullptr);
+	ASSERT(mResources.empty() == false);
+
+	const std::uint32_t resourceCount{ GetResourceCount() };
+	std::uint64_t heapAlignment{ D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT };
+	for (std::uint32_t i = 0U; i < resourceCount; ++i) {
+		const D3D12_RESOURCE_ALLOCATION_INFO allocationInfo =
+			DirectXManager::GetDevice().GetResourceAllocationInfo(0U, 1U, &mResources[i].mResourceDescriptor);
+		mRequests[i].mSize = allocationInfo.SizeInBytes;
+		mRequests[i].mAlignment = allocationInfo.Alignment;
+		heapAlignment = std::max<std::uint64_t>(heapAlignment, allocationInfo.Alignment);
+	}
+
+	std::vector<std::uint64_t> heapOffsets(resourceCount);
+	mHeapSize = TransientResourcePlanner::PlanHeapOffsets(mRequests.data(), resourceCount, heapOffsets.data());
+	mNonAliasedHeapSize = TransientResourcePlanner::GetNonAliasedHeapSize(mRequests.data(), resourceCount);
+
+	D3D12_HEAP_DESC heapDescriptor = {};
+	heapDescriptor.SizeInBytes = mHeapSize;
+	heapDescriptor.Properties.Type = D3D12_HEAP_TYPE_DEFAULT;
+	heapDescriptor.Properties.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+	heapDescriptor.Properties.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+	heapDescriptor.Properties.CreationNodeMask = 1U;
+	heapDescriptor.Properties.VisibleNodeMask = 1U;
+	heapDescriptor.Alignment = heapAlignment;
+	heapDescriptor.Flags = D3D12_HEAP_FLAG_ALLOW_ONLY_RT_DS_TEXTURES;
+	mHeap = &ResourceManager::CreateHeap(heapDescriptor, L"Transient Resources Heap");
+
+	for (std::uint32_t i = 0U; i < resourceCount; ++i) {
+		ResourceData& resourceData = mResources[i];
+		resourceData.mResource = &ResourceManager::CreatePlacedResource(
+			*mHeap,
+			heapOffsets[i],
+			resourceData.mResourceDescriptor,
+			resourceData.mInitialState,
+			resourceData.mHasClearValue ? &resourceData.mClearValue : nullptr,
+			resourceData.mResourceName);
+
+		// Check if its memory overlaps the memory of another resource
+		for (std::uint32_t j = 0U; j < resourceCount; ++j) {
+			if (i != j &&
+				heapOffsets[i] < heapOffsets[j] + mRequests[j].mSize &&
+				heapOffsets[j] < heapOffsets[i] + mRequests[i].mSize)
+			{
+				ASSERT(TransientResourcePlanner::AreLifetimesOverlapping(mRequests[i], mRequests[j]) == false);
+				resourceData.mIsAliased = true;
+			}
+		}
+	}
+}
+
+ID3D12Resource& TransientResourceAllocator::GetResource(const std::uint32_t resourceIndex) const noexcept {
+	ASSERT(mHeap != nullptr);
+	ASSERT(resourceIndex < GetResourceCount());
+	ASSERT(mResources[resourceIndex].mResource != nullptr);
+
+	return *mResources[resourceIndex].mResource;
+}
+
+bool TransientResourceAllocator::IsAliased(const std::uint32_t resourceIndex) const noexcept {
+	ASSERT(mHeap != nullptr);
+	ASSERT(resourceIndex < GetResourceCount());
+
+	return mResources[resourceIndex].mIsAliased;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <d3d12.h>
+#include <vector>
+
+#include <ResourceManager\TransientResourcePlanner.h>
+
+// To create transient render targets and depth stencil buffers in a shared heap.
+// Resources whose lifetimes do not overlap share (alias) heap memory, so we only
+// pay for the resources that are alive at the same time.
+// Steps:
+// - Add resources with AddResource()
+// - Call Allocate() once to create the heap and the placed resources
+// - Get resources with GetResource()
+// - Before the first use of an aliased resource (IsAliased()) in a frame, you must execute
+//   an aliasing barrier and initialize it (clear, discard or copy), because other
+//   resources could have written the same memory.
+class TransientResourceAllocator {
+public:
+	TransientResourceAllocator() = default;
+	~TransientResourceAllocator() = default;
+	TransientResourceAllocator(const TransientResourceAllocator&) = delete;
+	const TransientResourceAllocator& operator=(const TransientResourceAllocator&) = delete;
+	TransientResourceAllocator(TransientResourceAllocator&&) = delete;
+	TransientResourceAllocator& operator=(TransientResourceAllocator&&) = delete;
+
+	// "firstUse" and "lastUse" are the inclusive range of positions
+	// (for example, frame graph execution order positions) where the resource is used.
+	// If resourceName is nullptr, then it will have the default name.
+	// Returns the resource index.
+	// Preconditions:
+	// - Allocate() must not have been called
+	// - Resource must be a render target or a depth stencil texture
+	// - "firstUse" must be less or equal than "lastUse"
+	std::uint32_t AddResource(
+		const D3D12_RESOURCE_DESC& resourceDescriptor,
+		const D3D12_RESOURCE_STATES initialState,
+		const D3D12_CLEAR_VALUE* clearValue,
+		const std::uint32_t firstUse,
+		const std::uint32_t lastUse,
+		const wchar_t* resourceName) noexcept;
+
+	// Preconditions:
+	// - Allocate() must not have been called
+	// - At least one resource must have been added
+	void Allocate() noexcept;
+
+	// Preconditions:
+	// - Allocate() must be called first
+	// - "resourceIndex" must be valid
+	ID3D12Resource& GetResource(const std::uint32_t resourceIndex) const noexcept;
+
+	// Returns true if the resource shares memory with another resource.
+	// Preconditions:
+	// - Allocate() must be called first
+	// - "resourceIndex" must be valid
+	bool IsAliased(const std::uint32_t resourceIndex) const noexcept;
+
+	__forceinline std::uint32_t GetResourceCount() const noexcept { return static_cast<std::uint32_t>(mResources.size()); }
+
+	// Size of the shared heap and size that we would need without aliasing
+	__forceinline std::uint64_t GetHeapSize() const noexcept { return mHeapSize; }
+	__forceinline std::uint64_t GetNonAliasedHeapSize() const noexcept { return mNonAliasedHeapSize; }
+
+private:
+	struct ResourceData {
+		D3D12_RESOURCE_DESC mResourceDescriptor{};
+		D3D12_CLEAR_VALUE mClearValue{};
+		D3D12_RESOURCE_STATES mInitialState{ D3D12_RESOURCE_STATE_COMMON };
+		const wchar_t* mResourceName{ nullptr };
+		ID3D12Resource* mResource{ nullptr };
+		bool mHasClearValue{ false };
+		bool mIsAliased{ false };
+	};
+
+	std::vector<ResourceData> mResources;
+	std::vector<TransientResourcePlanner::ResourceRequest> mRequests;
+
+	ID3D12Heap* mHeap{ nullptr };
+	std::uint64_t mHeapSize{ 0UL };
+	std::uint64_t mNonAliasedHeapSize{ 0UL };
+};
@@ -0,0 +1,110 @@
+#include "TransientResourcePlanner.h"
+
+#include <algorithm>
+#include <vector>
+
+#include <Utils/DebugUtils.h>
+
+namespace {
+	std::uint64_t AlignOffset(const std::uint64_t offset, const std::uint64_t alignment) noexcept {
+		ASSERT(alignment > 0UL && (alignment & (alignment - 1UL)) == 0UL);
+		return (offset + alignment - 1UL) & ~(alignment - 1UL);
+	}
+
+	// Memory range [mBegin, mEnd) used by a placed resource
+	struct MemoryRange {
+		std::uint64_t mBegin{ 0UL };
+		std::uint64_t mEnd{ 0UL };
+	};
+}
+
+namespace TransientResourcePlanner {
+	bool AreLifetimesOverlapping(const ResourceRequest& request1, const ResourceRequest& request2) noexcept {
+		return request1.mFirstUse <= request2.mLastUse && request2.mFirstUse <= request1.mLastUse;
+	}
+
+	std::uint64_t PlanHeapOffsets(
+		const ResourceRequest* requests,
+		const std::uint32_t requestCount,
+		std::uint64_t* heapOffsets) noexcept
+	{
+		ASSERT(requests != nullptr);
+		ASSERT(requestCount > 0U);
+		ASSERT(heapOffsets != nullptr);
+
+		// Place bigger resources first (and earlier ones first if sizes are equal),
+		// as small resources are easier to fit in the gaps.
+		std::vector<std::uint32_t> placementOrder(requestCount);
+		for (std::uint32_t i = 0U; i < requestCount; ++i) {
+			ASSERT(requests[i].mSize > 0UL);
+			ASSERT(requests[i].mFirstUse <= requests[i].mLastUse);
+			placementOrder[i] = i;
+		}
+		std::sort(
+			placementOrder.begin(),
+			placementOrder.end(),
+			[requests](const std::uint32_t index1, const std::uint32_t index2) {
+				if (requests[index1].mSize != requests[index2].mSize) {
+					return requests[index1].mSize > requests[index2].mSize;
+				}
+				if (requests[index1].mFirstUse != requests[index2].mFirstUse) {
+					return requests[index1].mFirstUse < requests[index2].mFirstUse;
+				}
+				return index1 < index2;
+			});
+
+		std::vector<std::uint32_t> placedRequests;
+		placedRequests.reserve(requestCount);
+		std::vector<MemoryRange> usedRanges;
+		usedRanges.reserve(requestCount);
+
+		std::uint64_t heapSize{ 0UL };
+		for (const std::uint32_t requestIndex : placementOrder) {
+			const ResourceRequest& request = requests[requestIndex];
+
+			// Memory used by placed resources that are alive at the same time
+			usedRanges.clear();
+			for (const std::uint32_t placedRequestIndex : placedRequests) {
+				if (AreLifetimesOverlapping(request, requests[placedRequestIndex])) {
+					MemoryRange range;
+					range.mBegin = heapOffsets[placedRequestIndex];
+					range.mEnd = range.mBegin + requests[placedRequestIndex].mSize;
+					usedRanges.push_back(range);
+				}
+			}
+			std::sort(
+				usedRanges.begin(),
+				usedRanges.end(),
+				[](const MemoryRange& range1, const MemoryRange& range2) { return range1.mBegin < range2.mBegin; });
+
+			// Find the lowest aligned offset where the resource fits
+			std::uint64_t offset{ 0UL };
+			for (const MemoryRange& range : usedRanges) {
+				if (offset + request.mSize <= range.mBegin) {
+					break;
+				}
+				offset = std::max<std::uint64_t>(offset, AlignOffset(range.mEnd, request.mAlignment));
+			}
+
+			heapOffsets[requestIndex] = offset;
+			placedRequests.push_back(requestIndex);
+			heapSize = std::max<std::uint64_t>(heapSize, offset + request.mSize);
+		}
+
+		return heapSize;
+	}
+
+	std::uint64_t GetNonAliasedHeapSize(
+		const ResourceRequest* requests,
+		const std::uint32_t requestCount) noexcept
+	{
+		ASSERT(requests != nullptr);
+
+		std::uint64_t heapSize{ 0UL };
+		for (std::uint32_t i = 0U; i < requestCount; ++i) {
+			heapSize = AlignOffset(heapSize, requests[i].mAlignment) + requests[i].mSize;
+		}
+
+		return heapSize;
+	}
+}
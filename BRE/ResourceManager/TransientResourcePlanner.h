@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+
+// To place transient resources (resources that are only used during
+// a part of the frame) in a shared heap.
+// Resources whose lifetimes overlap get disjoint memory ranges, and
+// resources whose lifetimes do not overlap can share (alias) memory.
+namespace TransientResourcePlanner {
+	// Lifetime is the inclusive range [mFirstUse, mLastUse] of
+	// positions (for example, frame graph pass positions) where the resource is used.
+	struct ResourceRequest {
+		std::uint64_t mSize{ 0UL };
+		std::uint64_t mAlignment{ 1UL };
+		std::uint32_t mFirstUse{ 0U };
+		std::uint32_t mLastUse{ 0U };
+	};
+
+	bool AreLifetimesOverlapping(const ResourceRequest& request1, const ResourceRequest& request2) noexcept;
+
+	// Stores in heapOffsets[i] the heap offset of requests[i], and returns the heap size.
+	// Bigger resources are placed first, each one at the lowest aligned offset
+	// that does not overlap memory of placed resources with overlapping lifetimes.
+	// Preconditions:
+	// - "requests" must not be nullptr
+	// - "requestCount" must be greater than zero
+	// - "heapOffsets" must not be nullptr
+	// - Sizes must be greater than zero
+	// - Alignments must be powers of 2
+	// - mFirstUse must be less or equal than mLastUse
+	std::uint64_t PlanHeapOffsets(
+		const ResourceRequest* requests,
+		const std::uint32_t requestCount,
+		std::uint64_t* heapOffsets) noexcept;
+
+	// Returns the heap size needed if resources did not share memory
+	std::uint64_t GetNonAliasedHeapSize(
+		const ResourceRequest* requests,
+		const std::uint32_t requestCount) noexcept;
+}
@@ -4,6 +4,7 @@
 #include <Utils/DebugUtils.h>
 
 UploadBufferManager::UploadBuffers UploadBufferManager::mUploadBuffers;
+UploadBufferManager::UploadRingBuffers UploadBufferManager::mUploadRingBuffers;
 std::mutex UploadBufferManager::mMutex;
 
 void UploadBufferManager::EraseAll() noexcept {
@@ -11,6 +12,11 @@ void UploadBufferManager::EraseAll() noexcept {
 		ASSERT(uploadBuffer != nullptr);
 		delete uploadBuffer;
 	}
+
+	for (UploadRingBuffer* uploadRingBuffer : mUploadRingBuffers) {
+		ASSERT(uploadRingBuffer != nullptr);
+		delete uploadRingBuffer;
+	}
 }
 
 UploadBuffer& UploadBufferManager::CreateUploadBuffer(
@@ -25,3 +31,12 @@ UploadBuffer& UploadBufferManager::CreateUploadBuffer(
 
 	return *uploadBuffer;
 }
+
+UploadRingBuffer& UploadBufferManager::CreateUploadRingBuffer(const std::size_t sizeInBytes) noexcept {
+	ASSERT(sizeInBytes > 0UL);
+
+	UploadRingBuffer* uploadRingBuffer = new UploadRingBuffer(DirectXManager::GetDevice(), sizeInBytes);
+	mUploadRingBuffers.insert(uploadRingBuffer);
+
+	return *uploadRingBuffer;
+}
@@ -5,6 +5,7 @@
 #include <tbb/concurrent_unordered_set.h>
 
 #include <ResourceManager/UploadBuffer.h>
+#include <ResourceManager/UploadRingBuffer.h>
 
 // This class is responsible to create/get upload buffers
 class UploadBufferManager {
@@ -25,9 +26,16 @@ public:
 		const std::size_t elementSize,
 		const std::uint32_t elementCount) noexcept;
 
+	// Preconditions:
+	// - "sizeInBytes" must be greater than zero.
+	static UploadRingBuffer& CreateUploadRingBuffer(const std::size_t sizeInBytes) noexcept;
+
 private:
 	using UploadBuffers = tbb::concurrent_unordered_set<UploadBuffer*>;
 	static UploadBuffers mUploadBuffers;
 
+	using UploadRingBuffers = tbb::concurrent_unordered_set<UploadRingBuffer*>;
+	static UploadRingBuffers mUploadRingBuffers;
+
 	static std::mutex mMutex;
 };
@@ -0,0 +1,97 @@
+#include "UploadRingBuffer.h"
+
+#include <cstring>
+
+#include <DxUtils/d3dx12.h>
+#include <Utils/DebugUtils.h>
+
+UploadRingBuffer::UploadRingBuffer(
+	ID3D12Device& device,
+	const std::size_t sizeInBytes)
+	: mDevice(device)
+	, mAllocator(RingBufferAllocator::GetAlignedSize(sizeInBytes))
+{
+	ASSERT(sizeInBytes > 0UL);
+
+	CD3DX12_HEAP_PROPERTIES heapProperties{ D3D12_HEAP_TYPE_UPLOAD };
+	CD3DX12_RESOURCE_DESC resourceDescriptor{ CD3DX12_RESOURCE_DESC::Buffer(mAllocator.GetCapacity()) };
+	CHECK_HR(device.CreateCommittedResource(
+		&heapProperties,
+		D3D12_HEAP_FLAG_NONE,
+		&resourceDescriptor,
+		D3D12_RESOURCE_STATE_GENERIC_READ,
+		nullptr,
+		IID_PPV_ARGS(&mBuffer)));
+	mBuffer->SetName(L"Upload Ring Buffer");
+
+	// It is mapped while it lives. We do not read it from the CPU.
+	const D3D12_RANGE readRange{ 0UL, 0UL };
+	CHECK_HR(mBuffer->Map(0U, &readRange, reinterpret_cast<void**>(&mMappedData)));
+	mGpuAddress = mBuffer->GetGPUVirtualAddress();
+}
+
+UploadRingBuffer::~UploadRingBuffer() {
+	ASSERT(mBuffer);
+	mBuffer->Unmap(0U, nullptr);
+	mMappedData = nullptr;
+}
+
+D3D12_GPU_VIRTUAL_ADDRESS UploadRingBuffer::CopyData(
+	const void* sourceData,
+	const std::size_t sourceDataSize) noexcept
+{
+	ASSERT(sourceData != nullptr);
+
+	const Allocation allocation{ Allocate(sourceDataSize) };
+	memcpy(allocation.mCpuAddress, sourceData, sourceDataSize);
+
+	return allocation.mGpuAddress;
+}
+
+void UploadRingBuffer::FinishFrame(const std::uint64_t fenceValue) noexcept {
+	mAllocator.FinishFrame(fenceValue);
+
+	std::lock_guard<std::mutex> lock(mOverflowBuffersMutex);
+	for (OverflowBuffer& overflowBuffer : mCurrentFrameOverflowBuffers) {
+		overflowBuffer.mFenceValue = fenceValue;
+		mOverflowBuffersInFlight.push(std::move(overflowBuffer));
+	}
+	mCurrentFrameOverflowBuffers.clear();
+}
+
+void UploadRingBuffer::ReleaseCompletedFrames(const std::uint64_t completedFenceValue) noexcept {
+	mAllocator.ReleaseCompletedFrames(completedFenceValue);
+
+	std::lock_guard<std::mutex> lock(mOverflowBuffersMutex);
+	while (mOverflowBuffersInFlight.empty() == false && mOverflowBuffersInFlight.front().mFenceValue <= completedFenceValue) {
+		mOverflowBuffersInFlight.pop();
+	}
+}
+
+UploadRingBuffer::Allocation UploadRingBuffer::AllocateOverflowBuffer(const std::size_t sizeInBytes) noexcept {
+	ASSERT(sizeInBytes > 0UL);
+	ASSERT(sizeInBytes <= mAllocator.GetCapacity());
+
+	OverflowBuffer overflowBuffer;
+	CD3DX12_HEAP_PROPERTIES heapProperties{ D3D12_HEAP_TYPE_UPLOAD };
+	CD3DX12_RESOURCE_DESC resourceDescriptor{ CD3DX12_RESOURCE_DESC::Buffer(RingBufferAllocator::GetAlignedSize(sizeInBytes)) };
+	CHECK_HR(mDevice.CreateCommittedResource(
+		&heapProperties,
+		D3D12_HEAP_FLAG_NONE,
+		&resourceDescriptor,
+		D3D12_RESOURCE_STATE_GENERIC_READ,
+		nullptr,
+		IID_PPV_ARGS(&overflowBuffer.mBuffer)));
+	overflowBuffer.mBuffer->SetName(L"Upload Ring Buffer Overflow");
+
+	// Upload buffers can stay mapped until they are released
+	Allocation allocation;
+	const D3D12_RANGE readRange{ 0UL, 0UL };
+	CHECK_HR(overflowBuffer.mBuffer->Map(0U, &readRange, reinterpret_cast<void**>(&allocation.mCpuAddress)));
+	allocation.mGpuAddress = overflowBuffer.mBuffer->GetGPUVirtualAddress();
+
+	std::lock_guard<std::mutex> lock(mOverflowBuffersMutex);
+	mCurrentFrameOverflowBuffers.push_back(std::move(overflowBuffer));
+
+	return allocation;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <d3d12.h>
+#include <mutex>
+#include <queue>
+#include <vector>
+#include <wrl.h>
+
+#include <ResourceManager\RingBufferAllocator.h>
+
+// Upload buffer that is persistently mapped and shared by all the 
+// command list recorders to upload data that changes every frame 
+// (frame constant buffer, instance data, etc).
+// See RingBufferAllocator to know how memory is allocated and released.
+// If the ring is full (the GPU did not finish the frames that use it), then
+// the data is placed in an overflow upload buffer, that lives until its frame is completed.
+// That is slow, so the ring should be sized to not need it.
+class UploadRingBuffer {
+public:
+	struct Allocation {
+		std::uint8_t* mCpuAddress{ nullptr };
+		D3D12_GPU_VIRTUAL_ADDRESS mGpuAddress{ 0UL };
+	};
+
+	// Preconditions:
+	// - "sizeInBytes" must be greater than zero
+	explicit UploadRingBuffer(
+		ID3D12Device& device,
+		const std::size_t sizeInBytes);
+
+	~UploadRingBuffer();
+	UploadRingBuffer(const UploadRingBuffer&) = delete;
+	const UploadRingBuffer& operator=(const UploadRingBuffer&) = delete;
+	UploadRingBuffer(UploadRingBuffer&&) = delete;
+	UploadRingBuffer& operator=(UploadRingBuffer&&) = delete;
+
+	// It is thread safe. Allocation is aligned to constant buffer alignment.
+	// Preconditions:
+	// - "sizeInBytes" must be greater than zero and less or equal than the ring size
+	__forceinline Allocation Allocate(const std::size_t sizeInBytes) noexcept {
+		const std::size_t offset{ mAllocator.Allocate(sizeInBytes) };
+		if (offset == RingBufferAllocator::sInvalidOffset) {
+			return AllocateOverflowBuffer(sizeInBytes);
+		}
+
+		return Allocation{ mMappedData + offset, mGpuAddress + offset };
+	}
+
+	// Allocates and copies "sourceData". It is thread safe.
+	// Returns the GPU address of the data.
+	// Preconditions:
+	// - "sourceData" must not be nullptr
+	D3D12_GPU_VIRTUAL_ADDRESS CopyData(
+		const void* sourceData,
+		const std::size_t sourceDataSize) noexcept;
+
+	// See RingBufferAllocator
+	void FinishFrame(const std::uint64_t fenceValue) noexcept;
+	void ReleaseCompletedFrames(const std::uint64_t completedFenceValue) noexcept;
+
+private:
+	struct OverflowBuffer {
+		Microsoft::WRL::ComPtr<ID3D12Resource> mBuffer;
+		std::uint64_t mFenceValue{ 0UL };
+	};
+
+	// Creates an overflow buffer of "sizeInBytes" bytes for the current frame. It is thread safe.
+	Allocation AllocateOverflowBuffer(const std::size_t sizeInBytes) noexcept;
+
+	ID3D12Device& mDevice;
+	RingBufferAllocator mAllocator;
+	Microsoft::WRL::ComPtr<ID3D12Resource> mBuffer;
+	std::uint8_t* mMappedData{ nullptr };
+	D3D12_GPU_VIRTUAL_ADDRESS mGpuAddress{ 0UL };
+
+	// Overflow buffers of the current frame, and of the frames the GPU did not complete yet
+	std::mutex mOverflowBuffersMutex;
+	std::vector<OverflowBuffer> mCurrentFrameOverflowBuffers;
+	std::queue<OverflowBuffer> mOverflowBuffersInFlight;
+};
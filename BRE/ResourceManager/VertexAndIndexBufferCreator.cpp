@@ -1,7 +1,33 @@
 #include "VertexAndIndexBufferCreator.h"
 
+#include <DXUtils/d3dx12.h>
 #include <ResourceManager/ResourceManager.h>
+#include <ResourceManager/TransferManager.h>
 #include <Utils/DebugUtils.h>
+#include <Utils/HashUtils.h>
+
+namespace {
+	DXGI_FORMAT GetIndexFormat(const std::size_t elementSize) noexcept {
+		switch (elementSize)
+		{
+		case 1U:
+			return DXGI_FORMAT_R8_UINT;
+		case 2U:
+			return DXGI_FORMAT_R16_UINT;
+		case 4U:
+			return DXGI_FORMAT_R32_UINT;
+		default:
+			return DXGI_FORMAT_UNKNOWN;
+		}
+	}
+}
+
+const std::size_t VertexAndIndexBufferCreator::sPoolSizeInBytes;
+VertexAndIndexBufferCreator::BufferPools VertexAndIndexBufferCreator::mVertexBufferPools;
+VertexAndIndexBufferCreator::BufferPools VertexAndIndexBufferCreator::mIndexBufferPools;
+std::mutex VertexAndIndexBufferCreator::mPoolMutex;
+VertexAndIndexBufferCreator::VertexBufferRegistry VertexAndIndexBufferCreator::mVertexBufferRegistry;
+VertexAndIndexBufferCreator::IndexBufferRegistry VertexAndIndexBufferCreator::mIndexBufferRegistry;
 
 VertexAndIndexBufferCreator::BufferCreationData::BufferCreationData(
 	const void* data, 
@@ -28,6 +54,7 @@ VertexAndIndexBufferCreator::VertexBufferData::operator=(
 	mBuffer = instance.mBuffer;
 	mBufferView = instance.mBufferView;
 	mElementCount = instance.mElementCount;
+	mBaseVertex = instance.mBaseVertex;
 
 	return *this;
 }
@@ -44,10 +71,8 @@ bool VertexAndIndexBufferCreator::VertexBufferData::IsDataValid() const noexcept
 }
 
 void VertexAndIndexBufferCreator::CreateVertexBuffer(
-	ID3D12GraphicsCommandList& commandList,
 	const BufferCreationData& bufferCreationData,
-	VertexBufferData& vertexBufferData,
-	Microsoft::WRL::ComPtr<ID3D12Resource>& uploadBuffer) noexcept
+	VertexBufferData& vertexBufferData) noexcept
 {
 	ASSERT(bufferCreationData.IsDataValid());
 
@@ -56,10 +81,8 @@ void VertexAndIndexBufferCreator::CreateVertexBuffer(
 		bufferCreationData.mElementCount * static_cast<std::uint32_t>(bufferCreationData.mElementSize) 
 	};
 	vertexBufferData.mBuffer = &ResourceManager::CreateDefaultBuffer(
-		commandList, 
 		bufferCreationData.mData, 
 		bufferSize, 
-		uploadBuffer,
 		nullptr);
 	vertexBufferData.mElementCount = bufferCreationData.mElementCount;
 
@@ -82,6 +105,7 @@ VertexAndIndexBufferCreator::IndexBufferData::operator=(
 	mBuffer = instance.mBuffer;
 	mBufferView = instance.mBufferView;
 	mElementCount = instance.mElementCount;
+	mStartIndex = instance.mStartIndex;
 
 	return *this;
 }
@@ -98,10 +122,8 @@ bool VertexAndIndexBufferCreator::IndexBufferData::IsDataValid() const noexcept
 }
 
 void VertexAndIndexBufferCreator::CreateIndexBuffer(
-	ID3D12GraphicsCommandList& commandList,
 	const BufferCreationData& bufferCreationData,
-	IndexBufferData& indexBufferData,
-	Microsoft::WRL::ComPtr<ID3D12Resource>& uploadBuffer) noexcept
+	IndexBufferData& indexBufferData) noexcept
 {
 	ASSERT(bufferCreationData.IsDataValid());
 
@@ -109,29 +131,13 @@ void VertexAndIndexBufferCreator::CreateIndexBuffer(
 	const std::uint32_t elementSize{ static_cast<std::uint32_t>(bufferCreationData.mElementSize) };
 	const std::uint32_t bufferSize{ bufferCreationData.mElementCount * elementSize };
 	indexBufferData.mBuffer = &ResourceManager::CreateDefaultBuffer(
-		commandList, 
 		bufferCreationData.mData, 
 		bufferSize, 
-		uploadBuffer,
 		nullptr);
 	indexBufferData.mElementCount = bufferCreationData.mElementCount;
 
 	// Set index format
-	DXGI_FORMAT format{ DXGI_FORMAT_UNKNOWN };
-	switch (elementSize)
-	{
-	case 1U:
-		format = DXGI_FORMAT_R8_UINT;
-		break;
-	case 2U:
-		format = DXGI_FORMAT_R16_UINT;
-		break;
-	case 4U:
-		format = DXGI_FORMAT_R32_UINT;
-		break;
-	default:
-		break;
-	}
+	const DXGI_FORMAT format{ GetIndexFormat(elementSize) };
 	ASSERT(format != DXGI_FORMAT_UNKNOWN);
 
 	// Fill view
@@ -142,5 +148,259 @@ void VertexAndIndexBufferCreator::CreateIndexBuffer(
 	ASSERT(indexBufferData.IsDataValid());
 }
 
+void VertexAndIndexBufferCreator::CreatePooledVertexBuffer(
+	const BufferCreationData& bufferCreationData,
+	VertexBufferData& vertexBufferData) noexcept
+{
+	ASSERT(bufferCreationData.IsDataValid());
+
+	std::uint32_t firstElement{ 0U };
+	BufferPool* pool{ AllocateFromPools(mVertexBufferPools, bufferCreationData, L"Vertex Buffer Pool", firstElement) };
+	if (pool == nullptr) {
+		CreateVertexBuffer(bufferCreationData, vertexBufferData);
+		return;
+	}
+
+	TransferManager::UploadBuffer(
+		*pool->mBuffer,
+		firstElement * bufferCreationData.mElementSize,
+		bufferCreationData.mData,
+		bufferCreationData.mElementCount * bufferCreationData.mElementSize);
+
+	vertexBufferData.mBuffer = pool->mBuffer;
+	vertexBufferData.mElementCount = bufferCreationData.mElementCount;
+	vertexBufferData.mBaseVertex = firstElement;
+
+	// View covers the whole pool
+	vertexBufferData.mBufferView.BufferLocation = pool->mBuffer->GetGPUVirtualAddress();
+	vertexBufferData.mBufferView.SizeInBytes = static_cast<std::uint32_t>(pool->mBuffer->GetDesc().Width);
+	vertexBufferData.mBufferView.StrideInBytes = static_cast<std::uint32_t>(bufferCreationData.mElementSize);
+
+	ASSERT(vertexBufferData.IsDataValid());
+}
+
+void VertexAndIndexBufferCreator::CreatePooledIndexBuffer(
+	const BufferCreationData& bufferCreationData,
+	IndexBufferData& indexBufferData) noexcept
+{
+	ASSERT(bufferCreationData.IsDataValid());
+
+	const DXGI_FORMAT format{ GetIndexFormat(bufferCreationData.mElementSize) };
+	ASSERT(format != DXGI_FORMAT_UNKNOWN);
+
+	std::uint32_t firstElement{ 0U };
+	BufferPool* pool{ AllocateFromPools(mIndexBufferPools, bufferCreationData, L"Index Buffer Pool", firstElement) };
+	if (pool == nullptr) {
+		CreateIndexBuffer(bufferCreationData, indexBufferData);
+		return;
+	}
+
+	TransferManager::UploadBuffer(
+		*pool->mBuffer,
+		firstElement * bufferCreationData.mElementSize,
+		bufferCreationData.mData,
+		bufferCreationData.mElementCount * bufferCreationData.mElementSize);
+
+	indexBufferData.mBuffer = pool->mBuffer;
+	indexBufferData.mElementCount = bufferCreationData.mElementCount;
+	indexBufferData.mStartIndex = firstElement;
+
+	// View covers the whole pool
+	indexBufferData.mBufferView.BufferLocation = pool->mBuffer->GetGPUVirtualAddress();
+	indexBufferData.mBufferView.Format = format;
+	indexBufferData.mBufferView.SizeInBytes = static_cast<std::uint32_t>(pool->mBuffer->GetDesc().Width);
+
+	ASSERT(indexBufferData.IsDataValid());
+}
+
+void VertexAndIndexBufferCreator::ReleasePooledVertexBuffer(const VertexBufferData& vertexBufferData) noexcept {
+	ASSERT(vertexBufferData.IsDataValid());
+	ReleaseToPools(
+		mVertexBufferPools, 
+		vertexBufferData.mBuffer, 
+		vertexBufferData.mBaseVertex, 
+		vertexBufferData.mElementCount);
+}
 
+void VertexAndIndexBufferCreator::ReleasePooledIndexBuffer(const IndexBufferData& indexBufferData) noexcept {
+	ASSERT(indexBufferData.IsDataValid());
+	ReleaseToPools(
+		mIndexBufferPools,
+		indexBufferData.mBuffer,
+		indexBufferData.mStartIndex,
+		indexBufferData.mElementCount);
+}
+
+void VertexAndIndexBufferCreator::EraseAllPools() noexcept {
+	std::lock_guard<std::mutex> lock(mPoolMutex);
+	for (BufferPool* pool : mVertexBufferPools) {
+		ASSERT(pool != nullptr);
+		delete pool;
+	}
+	mVertexBufferPools.clear();
+
+	for (BufferPool* pool : mIndexBufferPools) {
+		ASSERT(pool != nullptr);
+		delete pool;
+	}
+	mIndexBufferPools.clear();
+}
+
+std::uint64_t VertexAndIndexBufferCreator::CreateSharedVertexBuffer(
+	const BufferCreationData& bufferCreationData,
+	VertexBufferData& vertexBufferData) noexcept
+{
+	ASSERT(bufferCreationData.IsDataValid());
+
+	const std::uint64_t key{ GetBufferKey(bufferCreationData) };
+	if (mVertexBufferRegistry.Acquire(key, vertexBufferData)) {
+		// Element count and size are part of the key (see GetBufferKey())
+		ASSERT(vertexBufferData.mElementCount == bufferCreationData.mElementCount);
+		ASSERT(vertexBufferData.mBufferView.StrideInBytes == bufferCreationData.mElementSize);
+		return key;
+	}
 
+	// If another thread registered the same buffer after our Acquire(), then we use
+	// its buffer and ours is released to its pool. Its upload is still pending, but 
+	// the uploads of later buffers that reuse its range are recorded after it.
+	CreatePooledVertexBuffer(bufferCreationData, vertexBufferData);
+	const VertexBufferData createdVertexBufferData{ vertexBufferData };
+	if (mVertexBufferRegistry.Register(key, vertexBufferData) == false) {
+		ReleasePooledVertexBuffer(createdVertexBufferData);
+	}
+
+	return key;
+}
+
+std::uint64_t VertexAndIndexBufferCreator::CreateSharedIndexBuffer(
+	const BufferCreationData& bufferCreationData,
+	IndexBufferData& indexBufferData) noexcept
+{
+	ASSERT(bufferCreationData.IsDataValid());
+
+	const std::uint64_t key{ GetBufferKey(bufferCreationData) };
+	if (mIndexBufferRegistry.Acquire(key, indexBufferData)) {
+		ASSERT(indexBufferData.mElementCount == bufferCreationData.mElementCount);
+		ASSERT(indexBufferData.mBufferView.Format == GetIndexFormat(bufferCreationData.mElementSize));
+		return key;
+	}
+
+	CreatePooledIndexBuffer(bufferCreationData, indexBufferData);
+	const IndexBufferData createdIndexBufferData{ indexBufferData };
+	if (mIndexBufferRegistry.Register(key, indexBufferData) == false) {
+		ReleasePooledIndexBuffer(createdIndexBufferData);
+	}
+
+	return key;
+}
+
+void VertexAndIndexBufferCreator::ReleaseSharedVertexBuffer(const std::uint64_t key) noexcept {
+	VertexBufferData vertexBufferData;
+	if (mVertexBufferRegistry.Release(key, vertexBufferData) == 0U) {
+		ReleasePooledVertexBuffer(vertexBufferData);
+	}
+}
+
+void VertexAndIndexBufferCreator::ReleaseSharedIndexBuffer(const std::uint64_t key) noexcept {
+	IndexBufferData indexBufferData;
+	if (mIndexBufferRegistry.Release(key, indexBufferData) == 0U) {
+		ReleasePooledIndexBuffer(indexBufferData);
+	}
+}
+
+void VertexAndIndexBufferCreator::ClearSharedBuffers() noexcept {
+	mVertexBufferRegistry.Clear();
+	mIndexBufferRegistry.Clear();
+}
+
+std::uint64_t VertexAndIndexBufferCreator::GetBufferKey(const BufferCreationData& bufferCreationData) noexcept {
+	ASSERT(bufferCreationData.IsDataValid());
+
+	// Element count and size are hashed to the seed, so the same bytes with a different
+	// stride (or index format) give a different key, and a buffer with another layout
+	// is only acquired if the hashes of both its layout and its data collide.
+	const std::uint64_t layout[]{ bufferCreationData.mElementCount, bufferCreationData.mElementSize };
+	return HashUtils::HashData(
+		bufferCreationData.mData, 
+		bufferCreationData.mElementCount * bufferCreationData.mElementSize,
+		HashUtils::HashData(layout, sizeof(layout)));
+}
+
+VertexAndIndexBufferCreator::BufferPool::BufferPool(
+	ID3D12Resource& buffer,
+	const std::size_t elementSize,
+	const std::uint32_t elementCount)
+	: mBuffer(&buffer)
+	, mElementSize(elementSize)
+	, mAllocator(elementCount)
+{
+}
+
+VertexAndIndexBufferCreator::BufferPool* VertexAndIndexBufferCreator::AllocateFromPools(
+	BufferPools& pools,
+	const BufferCreationData& bufferCreationData,
+	const wchar_t* poolName,
+	std::uint32_t& firstElement) noexcept
+{
+	ASSERT(bufferCreationData.IsDataValid());
+
+	const std::size_t elementSize{ bufferCreationData.mElementSize };
+	const std::uint32_t poolElementCount{ static_cast<std::uint32_t>(sPoolSizeInBytes / elementSize) };
+	if (bufferCreationData.mElementCount > poolElementCount) {
+		return nullptr;
+	}
+
+	std::lock_guard<std::mutex> lock(mPoolMutex);
+	for (BufferPool* pool : pools) {
+		ASSERT(pool != nullptr);
+		if (pool->mElementSize == elementSize) {
+			firstElement = pool->mAllocator.Allocate(bufferCreationData.mElementCount);
+			if (firstElement != OffsetAllocator::sInvalidOffset) {
+				return pool;
+			}
+		}
+	}
+
+	// Pools are in common state, so copies and draws implicitly promote them (see TransferManager)
+	D3D12_HEAP_PROPERTIES heapProps{};
+	heapProps.Type = D3D12_HEAP_TYPE_DEFAULT;
+	heapProps.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+	heapProps.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+	heapProps.CreationNodeMask = 1U;
+	heapProps.VisibleNodeMask = 1U;
+
+	const CD3DX12_RESOURCE_DESC resDesc{ CD3DX12_RESOURCE_DESC::Buffer(poolElementCount * elementSize) };
+	ID3D12Resource& buffer = ResourceManager::CreateCommittedResource(
+		heapProps,
+		D3D12_HEAP_FLAG_NONE,
+		resDesc,
+		D3D12_RESOURCE_STATE_COMMON,
+		nullptr,
+		poolName);
+
+	BufferPool* pool{ new BufferPool(buffer, elementSize, poolElementCount) };
+	pools.push_back(pool);
+
+	firstElement = pool->mAllocator.Allocate(bufferCreationData.mElementCount);
+	ASSERT(firstElement != OffsetAllocator::sInvalidOffset);
+
+	return pool;
+}
+
+void VertexAndIndexBufferCreator::ReleaseToPools(
+	BufferPools& pools,
+	const ID3D12Resource* buffer,
+	const std::uint32_t firstElement,
+	const std::uint32_t elementCount) noexcept
+{
+	ASSERT(buffer != nullptr);
+
+	std::lock_guard<std::mutex> lock(mPoolMutex);
+	for (BufferPool* pool : pools) {
+		ASSERT(pool != nullptr);
+		if (pool->mBuffer == buffer) {
+			pool->mAllocator.Free(firstElement, elementCount);
+			return;
+		}
+	}
+}
@@ -3,10 +3,17 @@
 #include <cstddef>
 #include <cstdint>
 #include <d3d12.h>
-#include <wrl.h>
+#include <mutex>
+#include <vector>
+
+#include <ResourceManager/OffsetAllocator.h>
+#include <ResourceManager/SharedResourceRegistry.h>
 
 class VertexAndIndexBufferCreator {
 public:
+	// Size of each vertex or index buffer pool (see CreatePooledVertexBuffer())
+	static const std::size_t sPoolSizeInBytes{ 64UL * 1024UL * 1024UL };
+
 	VertexAndIndexBufferCreator() = delete;
 	~VertexAndIndexBufferCreator() = delete;
 	VertexAndIndexBufferCreator(const VertexAndIndexBufferCreator&) = delete;
@@ -48,6 +55,10 @@ public:
 		ID3D12Resource* mBuffer{ nullptr };
 		D3D12_VERTEX_BUFFER_VIEW mBufferView{};
 		std::uint32_t mElementCount{ 0U };
+
+		// First vertex in mBufferView. It must be added to the 
+		// base vertex location of draw calls.
+		std::uint32_t mBaseVertex{ 0U };
 	};
 
 	struct IndexBufferData {
@@ -65,17 +76,111 @@ public:
 		ID3D12Resource* mBuffer{ nullptr };
 		D3D12_INDEX_BUFFER_VIEW mBufferView{};
 		std::uint32_t mElementCount{ 0U };
+
+		// First index in mBufferView. It must be added to the 
+		// start index location of draw calls.
+		std::uint32_t mStartIndex{ 0U };
 	};
 	
+	// Buffer data is uploaded by TransferManager (see ResourceManager::CreateDefaultBuffer())
 	static void CreateVertexBuffer(
-		ID3D12GraphicsCommandList& commandList, 
 		const BufferCreationData& bufferCreationData,
-		VertexBufferData& vertexBufferData,
-		Microsoft::WRL::ComPtr<ID3D12Resource>& uploadBuffer) noexcept;
+		VertexBufferData& vertexBufferData) noexcept;
 
 	static void CreateIndexBuffer(
-		ID3D12GraphicsCommandList& commandList, 
 		const BufferCreationData& bufferCreationData,
-		IndexBufferData& indexBufferData,
-		Microsoft::WRL::ComPtr<ID3D12Resource>& uploadBuffer) noexcept;
+		IndexBufferData& indexBufferData) noexcept;
+
+	// Pooled buffers are ranges of large buffers (pools) that are shared by all the
+	// pooled buffers with the same element size, so there is a buffer allocation per pool
+	// instead of per mesh, and meshes of the same pool do not need to bind other buffers.
+	// Buffer views cover the whole pool, and the range starts at mBaseVertex / mStartIndex.
+	// If the pools are full, then a new pool is created. If the buffer is larger
+	// than a pool, then it is created as a separate buffer.
+	static void CreatePooledVertexBuffer(
+		const BufferCreationData& bufferCreationData,
+		VertexBufferData& vertexBufferData) noexcept;
+
+	static void CreatePooledIndexBuffer(
+		const BufferCreationData& bufferCreationData,
+		IndexBufferData& indexBufferData) noexcept;
+
+	// Frees the range of a pooled buffer, so it can be reused by other pooled buffers.
+	// It does nothing for buffers that are not in a pool.
+	// Preconditions:
+	// - GPU must have finished using it
+	static void ReleasePooledVertexBuffer(const VertexBufferData& vertexBufferData) noexcept;
+	static void ReleasePooledIndexBuffer(const IndexBufferData& indexBufferData) noexcept;
+
+	// Pool buffers are destroyed by ResourceManager::EraseAll()
+	static void EraseAllPools() noexcept;
+
+	// Shared buffers are pooled buffers identified by a hash of their content (see GetBufferKey()),
+	// so buffers with the same data, element count and element size are created once.
+	// It returns the key of the buffer, to call Release*Buffer() when it is not used anymore.
+	static std::uint64_t CreateSharedVertexBuffer(
+		const BufferCreationData& bufferCreationData,
+		VertexBufferData& vertexBufferData) noexcept;
+
+	static std::uint64_t CreateSharedIndexBuffer(
+		const BufferCreationData& bufferCreationData,
+		IndexBufferData& indexBufferData) noexcept;
+
+	// Buffers are unregistered when their reference count reaches zero, and their
+	// range is released to its pool (see Release*PooledBuffer()).
+	// Preconditions:
+	// - GPU must have finished using the buffer, if its reference count reaches zero
+	static void ReleaseSharedVertexBuffer(const std::uint64_t key) noexcept;
+	static void ReleaseSharedIndexBuffer(const std::uint64_t key) noexcept;
+
+	// Unregisters all the shared buffers. It should be called with ResourceManager::EraseAll()
+	static void ClearSharedBuffers() noexcept;
+
+	static std::uint64_t GetBufferKey(const BufferCreationData& bufferCreationData) noexcept;
+
+	using VertexBufferRegistry = SharedResourceRegistry<VertexBufferData>;
+	using IndexBufferRegistry = SharedResourceRegistry<IndexBufferData>;
+
+	static VertexBufferRegistry::Statistics GetSharedVertexBufferStatistics() noexcept {
+		return mVertexBufferRegistry.GetStatistics();
+	}
+
+	static IndexBufferRegistry::Statistics GetSharedIndexBufferStatistics() noexcept {
+		return mIndexBufferRegistry.GetStatistics();
+	}
+
+private:
+	struct BufferPool {
+		explicit BufferPool(
+			ID3D12Resource& buffer, 
+			const std::size_t elementSize, 
+			const std::uint32_t elementCount);
+
+		ID3D12Resource* mBuffer{ nullptr };
+		std::size_t mElementSize{ 0UL };
+		OffsetAllocator mAllocator;
+	};
+	using BufferPools = std::vector<BufferPool*>;
+
+	// Allocates the elements of "bufferCreationData" from a pool of "pools" with its 
+	// element size (it creates the pool if needed), and it returns the pool and the first element.
+	// It returns nullptr if the buffer is larger than a pool.
+	static BufferPool* AllocateFromPools(
+		BufferPools& pools,
+		const BufferCreationData& bufferCreationData,
+		const wchar_t* poolName,
+		std::uint32_t& firstElement) noexcept;
+
+	static void ReleaseToPools(
+		BufferPools& pools,
+		const ID3D12Resource* buffer,
+		const std::uint32_t firstElement,
+		const std::uint32_t elementCount) noexcept;
+
+	static BufferPools mVertexBufferPools;
+	static BufferPools mIndexBufferPools;
+	static std::mutex mPoolMutex;
+
+	static VertexBufferRegistry mVertexBufferRegistry;
+	static IndexBufferRegistry mIndexBufferRegistry;
 };
\ No newline at end of file
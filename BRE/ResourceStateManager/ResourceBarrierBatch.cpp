@@ -0,0 +1,114 @@
+#include "ResourceBarrierBatch.h"
+
+#include <Utils/DebugUtils.h>
+
+void ResourceBarrierBatch::Transition(
+	const ResourceHandle resource,
+	const std::uint32_t stateAfter,
+	const std::uint32_t subresource) noexcept
+{
+	ASSERT(resource != nullptr);
+
+	// All the barriers of the batch are executed together, so a transition can be merged
+	// with the last transition of the same subresource, if there are no split transitions 
+	// or aliasing barriers of the resource between them.
+	// A transition of all the subresources replaces the previous transitions of the resource.
+	for (std::size_t i = mEntries.size(); i > 0UL; --i) {
+		Entry& entry = mEntries[i - 1UL];
+		if (entry.mType == ResourceStateTable::ALIASING_BARRIER) {
+			if (entry.mResource == resource || entry.mResourceAfter == resource || entry.mResource == nullptr) {
+				break;
+			}
+			continue;
+		}
+
+		if (entry.mResource != resource) {
+			continue;
+		}
+
+		if (entry.mFlags != ResourceStateTable::sBarrierFlagNone) {
+			break;
+		}
+
+		if (subresource == ResourceStateTable::sAllSubresources) {
+			mEntries.erase(mEntries.begin() + (i - 1UL));
+			continue;
+		}
+
+		if (entry.mSubresource == subresource) {
+			entry.mStateAfter = stateAfter;
+			return;
+		}
+
+		if (entry.mSubresource == ResourceStateTable::sAllSubresources) {
+			break;
+		}
+	}
+
+	AddTransitionEntry(resource, stateAfter, subresource, ResourceStateTable::sBarrierFlagNone);
+}
+
+void ResourceBarrierBatch::BeginTransition(
+	const ResourceHandle resource,
+	const std::uint32_t stateAfter,
+	const std::uint32_t subresource) noexcept
+{
+	ASSERT(resource != nullptr);
+	AddTransitionEntry(resource, stateAfter, subresource, ResourceStateTable::sBarrierFlagBeginOnly);
+}
+
+void ResourceBarrierBatch::EndTransition(
+	const ResourceHandle resource,
+	const std::uint32_t stateAfter,
+	const std::uint32_t subresource) noexcept
+{
+	ASSERT(resource != nullptr);
+	AddTransitionEntry(resource, stateAfter, subresource, ResourceStateTable::sBarrierFlagEndOnly);
+}
+
+void ResourceBarrierBatch::AddAliasingBarrier(const ResourceHandle resourceBefore, const ResourceHandle resourceAfter) noexcept {
+	ASSERT(resourceAfter != nullptr);
+
+	Entry entry;
+	entry.mType = ResourceStateTable::ALIASING_BARRIER;
+	entry.mResource = resourceBefore;
+	entry.mResourceAfter = resourceAfter;
+	mEntries.push_back(entry);
+}
+
+std::uint32_t ResourceBarrierBatch::Resolve(
+	ResourceStateTable& stateTable,
+	std::vector<ResourceStateTable::Barrier>& barriers) noexcept
+{
+	std::uint32_t barrierCount{ 0U };
+	for (const Entry& entry : mEntries) {
+		if (entry.mType == ResourceStateTable::ALIASING_BARRIER) {
+			ResourceStateTable::Barrier barrier;
+			barrier.mType = ResourceStateTable::ALIASING_BARRIER;
+			barrier.mResource = entry.mResource;
+			barrier.mResourceAfter = entry.mResourceAfter;
+			barriers.push_back(barrier);
+			++barrierCount;
+		} else {
+			barrierCount += stateTable.Transition(entry.mResource, entry.mSubresource, entry.mStateAfter, entry.mFlags, barriers);
+		}
+	}
+	mEntries.clear();
+
+	return barrierCount;
+}
+
+void ResourceBarrierBatch::AddTransitionEntry(
+	const ResourceHandle resource,
+	const std::uint32_t stateAfter,
+	const std::uint32_t subresource,
+	const std::uint32_t flags) noexcept
+{
+	Entry entry;
+	entry.mType = ResourceStateTable::TRANSITION_BARRIER;
+	entry.mResource = resource;
+	entry.mSubresource = subresource;
+	entry.mStateAfter = stateAfter;
+	entry.mFlags = flags;
+	mEntries.push_back(entry);
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <ResourceStateManager/ResourceStateTable.h>
+
+// To accumulate the barriers of a command list and to resolve them all at once.
+// Transitions only store the state after. The state before is resolved later by Resolve() 
+// with the resource states at that moment, so recording threads do not need to access 
+// shared resource states for each transition.
+// Before they are resolved:
+// - Consecutive transitions of the same subresource are merged (A->B->C becomes A->C)
+// - Round trips (A->B->A) are dropped when they are resolved
+// All the barriers of a batch are executed together, so it must be resolved (and its barriers
+// recorded) before recording commands that need the new states.
+// It is not thread safe. Use a batch per command list.
+class ResourceBarrierBatch {
+public:
+	using ResourceHandle = ResourceStateTable::ResourceHandle;
+
+	ResourceBarrierBatch() = default;
+	~ResourceBarrierBatch() = default;
+	ResourceBarrierBatch(const ResourceBarrierBatch&) = delete;
+	const ResourceBarrierBatch& operator=(const ResourceBarrierBatch&) = delete;
+	ResourceBarrierBatch(ResourceBarrierBatch&&) = delete;
+	ResourceBarrierBatch& operator=(ResourceBarrierBatch&&) = delete;
+
+	// Preconditions:
+	// - "resource" must not be nullptr
+	void Transition(
+		const ResourceHandle resource,
+		const std::uint32_t stateAfter,
+		const std::uint32_t subresource = ResourceStateTable::sAllSubresources) noexcept;
+
+	// Split transitions let the GPU change the state while it executes other work.
+	// The resource must not be used between BeginTransition() and EndTransition(), and
+	// both must use the same "stateAfter" and "subresource".
+	// Preconditions:
+	// - "resource" must not be nullptr
+	void BeginTransition(
+		const ResourceHandle resource,
+		const std::uint32_t stateAfter,
+		const std::uint32_t subresource = ResourceStateTable::sAllSubresources) noexcept;
+	void EndTransition(
+		const ResourceHandle resource,
+		const std::uint32_t stateAfter,
+		const std::uint32_t subresource = ResourceStateTable::sAllSubresources) noexcept;
+
+	// "resourceBefore" can be nullptr (any placed resource in the same heap)
+	// Preconditions:
+	// - "resourceAfter" must not be nullptr
+	void AddAliasingBarrier(const ResourceHandle resourceBefore, const ResourceHandle resourceAfter) noexcept;
+
+	// Appends to "barriers" the barriers of the batch, changes the states in "stateTable", 
+	// and clears the batch. Returns the number of appended barriers.
+	// Preconditions:
+	// - All the resources must have been added to "stateTable"
+	std::uint32_t Resolve(
+		ResourceStateTable& stateTable, 
+		std::vector<ResourceStateTable::Barrier>& barriers) noexcept;
+
+	__forceinline bool IsEmpty() const noexcept { return mEntries.empty(); }
+	__forceinline void Clear() noexcept { mEntries.clear(); }
+
+private:
+	struct Entry {
+		ResourceStateTable::BarrierType mType{ ResourceStateTable::TRANSITION_BARRIER };
+		ResourceHandle mResource{ nullptr };
+		ResourceHandle mResourceAfter{ nullptr };
+		std::uint32_t mSubresource{ ResourceStateTable::sAllSubresources };
+		std::uint32_t mStateAfter{ 0U };
+		std::uint32_t mFlags{ ResourceStateTable::sBarrierFlagNone };
+	};
+
+	void AddTransitionEntry(
+		const ResourceHandle resource,
+		const std::uint32_t stateAfter,
+		const std::uint32_t subresource,
+		const std::uint32_t flags) noexcept;
+
+	std::vector<Entry> mEntries;
+};
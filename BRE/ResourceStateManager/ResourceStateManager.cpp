@@ -1,41 +1,87 @@
 #include "ResourceStateManager.h"
 
+#include <algorithm>
 #include <memory>
 
 #include <Utils\DebugUtils.h>
 
-ResourceStateManager::StateByResource ResourceStateManager::mStateByResource;
+ResourceStateTable ResourceStateManager::mStateTable;
+std::vector<ResourceStateTable::Barrier> ResourceStateManager::mBarriers;
+std::vector<CD3DX12_RESOURCE_BARRIER> ResourceStateManager::mResourceBarriers;
+std::mutex ResourceStateManager::mMutex;
 
 void ResourceStateManager::AddResource(ID3D12Resource& resource, const D3D12_RESOURCE_STATES initialState) noexcept {
-	StateByResource::accessor accessor;
-#ifdef _DEBUG
-	mStateByResource.find(accessor, &resource);
-	ASSERT(accessor.empty());
-#endif
-	mStateByResource.insert(accessor, &resource);
-	accessor->second = initialState;
-	accessor.release();
+	const std::uint32_t subresourceCount{ GetSubresourceCount(resource) };
+
+	std::lock_guard<std::mutex> lock(mMutex);
+	mStateTable.AddResource(&resource, subresourceCount, static_cast<std::uint32_t>(initialState));
 }
 
-CD3DX12_RESOURCE_BARRIER ResourceStateManager::ChangeResourceStateAndGetBarrier(
-	ID3D12Resource& resource, 
-	const D3D12_RESOURCE_STATES newState) noexcept 
-{
-	StateByResource::accessor accessor;
-	mStateByResource.find(accessor, &resource);
-	ASSERT(accessor.empty() == false);
+void ResourceStateManager::RemoveResource(ID3D12Resource& resource) noexcept {
+	std::lock_guard<std::mutex> lock(mMutex);
+	mStateTable.RemoveResource(&resource);
+}
+
+void ResourceStateManager::FlushBarrierBatch(ResourceBarrierBatch& barrierBatch, ID3D12GraphicsCommandList& commandList) noexcept {
+	if (barrierBatch.IsEmpty()) {
+		return;
+	}
+
+	// We lock once per batch, instead of once per transition
+	std::lock_guard<std::mutex> lock(mMutex);
+	mBarriers.clear();
+	const std::uint32_t barrierCount{ barrierBatch.Resolve(mStateTable, mBarriers) };
+	if (barrierCount == 0U) {
+		return;
+	}
+
+	mResourceBarriers.clear();
+	for (const ResourceStateTable::Barrier& barrier : mBarriers) {
+		ID3D12Resource* resource{ const_cast<ID3D12Resource*>(static_cast<const ID3D12Resource*>(barrier.mResource)) };
+		if (barrier.mType == ResourceStateTable::ALIASING_BARRIER) {
+			ID3D12Resource* resourceAfter{ const_cast<ID3D12Resource*>(static_cast<const ID3D12Resource*>(barrier.mResourceAfter)) };
+			mResourceBarriers.push_back(CD3DX12_RESOURCE_BARRIER::Aliasing(resource, resourceAfter));
+		} else {
+			mResourceBarriers.push_back(CD3DX12_RESOURCE_BARRIER::Transition(
+				resource,
+				static_cast<D3D12_RESOURCE_STATES>(barrier.mStateBefore),
+				static_cast<D3D12_RESOURCE_STATES>(barrier.mStateAfter),
+				barrier.mSubresource,
+				static_cast<D3D12_RESOURCE_BARRIER_FLAGS>(barrier.mFlags)));
+		}
+	}
 
-	const D3D12_RESOURCE_STATES oldState = accessor->second;
-	ASSERT(oldState != newState);
-	accessor->second = newState;
-	accessor.release();
+	commandList.ResourceBarrier(barrierCount, mResourceBarriers.data());
+}
 
-	return CD3DX12_RESOURCE_BARRIER::Transition(&resource, oldState, newState);
+D3D12_RESOURCE_STATES ResourceStateManager::GetResourceState(
+	ID3D12Resource& resource,
+	const std::uint32_t subresource) noexcept 
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	return static_cast<D3D12_RESOURCE_STATES>(mStateTable.GetState(&resource, subresource));
 }
 
-D3D12_RESOURCE_STATES ResourceStateManager::GetResourceState(ID3D12Resource& resource) noexcept {
-	StateByResource::accessor accessor;
-	mStateByResource.find(accessor, &resource);
-	ASSERT(accessor.empty() == false);
-	return accessor->second;
-}
\ No newline at end of file
+std::uint32_t ResourceStateManager::GetSubresourceCount(ID3D12Resource& resource) noexcept {
+	const D3D12_RESOURCE_DESC resourceDescriptor = resource.GetDesc();
+	if (resourceDescriptor.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER) {
+		return 1U;
+	}
+
+	// Array size is the depth of 3D textures, and they do not have array slices.
+	// Planes (for example, stencil) are not tracked separately.
+	const std::uint32_t arraySize{ 
+		resourceDescriptor.Dimension == D3D12_RESOURCE_DIMENSION_TEXTURE3D ? 1U : resourceDescriptor.DepthOrArraySize };
+
+	// Zero mip levels means the full mip chain
+	std::uint32_t mipLevels{ resourceDescriptor.MipLevels };
+	if (mipLevels == 0U) {
+		std::uint64_t size{ std::max<std::uint64_t>(resourceDescriptor.Width, resourceDescriptor.Height) };
+		while (size > 0UL) {
+			++mipLevels;
+			size >>= 1UL;
+		}
+	}
+
+	return mipLevels * arraySize;
+}
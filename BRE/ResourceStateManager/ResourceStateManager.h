@@ -1,17 +1,27 @@
 #pragma once
 
 #include <d3d12.h>
-#include <tbb/concurrent_hash_map.h>
+#include <mutex>
+#include <vector>
 
 #include <DXUtils\d3dx12.h>
+#include <ResourceStateManager\ResourceBarrierBatch.h>
+#include <ResourceStateManager\ResourceStateTable.h>
 
+struct ID3D12GraphicsCommandList;
 struct ID3D12Resource;
 
 // To track resource states.
 // Its functionality includes:
 // - GetResource state registration
-// - GetResource state change
+// - GetResource state change through barrier batches
 // - GetResource unregistration
+//
+// Command lists accumulate their transitions in a ResourceBarrierBatch, and
+// FlushBarrierBatch() resolves all of them with the current states.
+// Preconditions:
+// - Command lists that change states of the same resource must flush their batches in 
+//   the same order they are executed.
 class ResourceStateManager {
 public:
 	ResourceStateManager() = delete;
@@ -24,19 +34,29 @@ public:
 	// Preconditions:
 	// - Resource must not have been registered
 	static void AddResource(ID3D12Resource& resource, const D3D12_RESOURCE_STATES initialState) noexcept;
- 
+
 	// Preconditions:
 	// - Resource must have been registered
-	// - New state must be different than current state
-	static CD3DX12_RESOURCE_BARRIER ChangeResourceStateAndGetBarrier(
-		ID3D12Resource& resource, 
-		const D3D12_RESOURCE_STATES newState) noexcept;
+	static void RemoveResource(ID3D12Resource& resource) noexcept;
+
+	// Resolves the barriers of the batch with the current resource states, 
+	// records them in the command list and clears the batch.
+	// Preconditions:
+	// - All the resources in the batch must have been registered
+	static void FlushBarrierBatch(ResourceBarrierBatch& barrierBatch, ID3D12GraphicsCommandList& commandList) noexcept;
 
 	// Preconditions:
 	// - Resource must have been registered
-	static D3D12_RESOURCE_STATES GetResourceState(ID3D12Resource& resource) noexcept;
+	// - If "subresource" is D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES, then all the subresources must be in the same state
+	static D3D12_RESOURCE_STATES GetResourceState(
+		ID3D12Resource& resource,
+		const std::uint32_t subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES) noexcept;
 
 private:
-	using StateByResource = tbb::concurrent_hash_map<ID3D12Resource*, D3D12_RESOURCE_STATES>;
-	static StateByResource mStateByResource;
-};
\ No newline at end of file
+	static std::uint32_t GetSubresourceCount(ID3D12Resource& resource) noexcept;
+
+	static ResourceStateTable mStateTable;
+	static std::vector<ResourceStateTable::Barrier> mBarriers;
+	static std::vector<CD3DX12_RESOURCE_BARRIER> mResourceBarriers;
+	static std::mutex mMutex;
+};
@@ -0,0 +1,174 @@
+#include "ResourceStateTable.h"
+
+#include <Utils/DebugUtils.h>
+
+const std::uint32_t ResourceStateTable::sAllSubresources;
+const std::uint32_t ResourceStateTable::sBarrierFlagNone;
+const std::uint32_t ResourceStateTable::sBarrierFlagBeginOnly;
+const std::uint32_t ResourceStateTable::sBarrierFlagEndOnly;
+
+void ResourceStateTable::AddResource(
+	const ResourceHandle resource,
+	const std::uint32_t subresourceCount,
+	const std::uint32_t initialState) noexcept
+{
+	ASSERT(resource != nullptr);
+	ASSERT(subresourceCount > 0U);
+	ASSERT(HasResource(resource) == false);
+
+	ResourceState& resourceState = mStateByResource[resource];
+	resourceState.mState = initialState;
+	resourceState.mSubresourceCount = subresourceCount;
+}
+
+void ResourceStateTable::RemoveResource(const ResourceHandle resource) noexcept {
+	ASSERT(HasResource(resource));
+	mStateByResource.erase(resource);
+
+	std::map<SplitTransitionKey, std::uint32_t>::iterator it =
+		mStateBeforeBySplitTransition.lower_bound(SplitTransitionKey(resource, 0U));
+	while (it != mStateBeforeBySplitTransition.end() && it->first.first == resource) {
+		it = mStateBeforeBySplitTransition.erase(it);
+	}
+}
+
+bool ResourceStateTable::HasResource(const ResourceHandle resource) const noexcept {
+	return mStateByResource.find(resource) != mStateByResource.end();
+}
+
+std::uint32_t ResourceStateTable::GetState(
+	const ResourceHandle resource,
+	const std::uint32_t subresource) const noexcept
+{
+	std::unordered_map<ResourceHandle, ResourceState>::const_iterator it = mStateByResource.find(resource);
+	ASSERT(it != mStateByResource.end());
+	const ResourceState& resourceState = it->second;
+
+	if (resourceState.mSubresourceStates.empty()) {
+		ASSERT(subresource == sAllSubresources || subresource < resourceState.mSubresourceCount);
+		return resourceState.mState;
+	}
+
+	ASSERT(subresource != sAllSubresources);
+	ASSERT(subresource < resourceState.mSubresourceCount);
+	return resourceState.mSubresourceStates[subresource];
+}
+
+std::uint32_t ResourceStateTable::Transition(
+	const ResourceHandle resource,
+	const std::uint32_t subresource,
+	const std::uint32_t stateAfter,
+	const std::uint32_t flags,
+	std::vector<Barrier>& barriers) noexcept
+{
+	ASSERT(flags == sBarrierFlagNone || flags == sBarrierFlagBeginOnly || flags == sBarrierFlagEndOnly);
+
+	if (flags == sBarrierFlagEndOnly) {
+		return EndSplitTransitions(resource, subresource, stateAfter, barriers);
+	}
+
+	std::unordered_map<ResourceHandle, ResourceState>::iterator it = mStateByResource.find(resource);
+	ASSERT(it != mStateByResource.end());
+	ResourceState& resourceState = it->second;
+	ASSERT(subresource == sAllSubresources || subresource < resourceState.mSubresourceCount);
+
+	const std::size_t firstBarrierIndex{ barriers.size() };
+	if (subresource == sAllSubresources) {
+		if (resourceState.mSubresourceStates.empty()) {
+			if (resourceState.mState != stateAfter) {
+				AppendTransitionBarrier(resource, sAllSubresources, resourceState.mState, stateAfter, flags, barriers);
+			}
+		} else {
+			// Subresources are in different states, so each one needs its own barrier
+			for (std::uint32_t i = 0U; i < resourceState.mSubresourceCount; ++i) {
+				if (resourceState.mSubresourceStates[i] != stateAfter) {
+					AppendTransitionBarrier(resource, i, resourceState.mSubresourceStates[i], stateAfter, flags, barriers);
+				}
+			}
+			resourceState.mSubresourceStates.clear();
+		}
+		resourceState.mState = stateAfter;
+	} else {
+		if (resourceState.mSubresourceStates.empty()) {
+			if (resourceState.mState == stateAfter) {
+				return 0U;
+			}
+			resourceState.mSubresourceStates.assign(resourceState.mSubresourceCount, resourceState.mState);
+		}
+
+		std::uint32_t& subresourceState = resourceState.mSubresourceStates[subresource];
+		if (subresourceState != stateAfter) {
+			AppendTransitionBarrier(resource, subresource, subresourceState, stateAfter, flags, barriers);
+			subresourceState = stateAfter;
+		}
+
+		// Go back to a single state if all the subresources are in the same state
+		bool areStatesEqual{ true };
+		for (const std::uint32_t state : resourceState.mSubresourceStates) {
+			if (state != stateAfter) {
+				areStatesEqual = false;
+				break;
+			}
+		}
+		if (areStatesEqual) {
+			resourceState.mState = stateAfter;
+			resourceState.mSubresourceStates.clear();
+		}
+	}
+
+	if (flags == sBarrierFlagBeginOnly) {
+		for (std::size_t i = firstBarrierIndex; i < barriers.size(); ++i) {
+			const SplitTransitionKey key(resource, barriers[i].mSubresource);
+			ASSERT(mStateBeforeBySplitTransition.find(key) == mStateBeforeBySplitTransition.end());
+			mStateBeforeBySplitTransition[key] = barriers[i].mStateBefore;
+		}
+	}
+
+	return static_cast<std::uint32_t>(barriers.size() - firstBarrierIndex);
+}
+
+void ResourceStateTable::AppendTransitionBarrier(
+	const ResourceHandle resource,
+	const std::uint32_t subresource,
+	const std::uint32_t stateBefore,
+	const std::uint32_t stateAfter,
+	const std::uint32_t flags,
+	std::vector<Barrier>& barriers) noexcept
+{
+	Barrier barrier;
+	barrier.mType = TRANSITION_BARRIER;
+	barrier.mResource = resource;
+	barrier.mSubresource = subresource;
+	barrier.mStateBefore = stateBefore;
+	barrier.mStateAfter = stateAfter;
+	barrier.mFlags = flags;
+	barriers.push_back(barrier);
+}
+
+std::uint32_t ResourceStateTable::EndSplitTransitions(
+	const ResourceHandle resource,
+	const std::uint32_t subresource,
+	const std::uint32_t stateAfter,
+	std::vector<Barrier>& barriers) noexcept
+{
+	ASSERT(HasResource(resource));
+
+	// Split transitions begun for all the subresources can be stored per subresource
+	// (if subresources were in different states), so we end all of them.
+	std::uint32_t barrierCount{ 0U };
+	std::map<SplitTransitionKey, std::uint32_t>::iterator it =
+		mStateBeforeBySplitTransition.lower_bound(SplitTransitionKey(resource, 0U));
+	while (it != mStateBeforeBySplitTransition.end() && it->first.first == resource) {
+		if (subresource != sAllSubresources && it->first.second != subresource) {
+			++it;
+			continue;
+		}
+
+		ASSERT(GetState(resource, it->first.second) == stateAfter);
+		AppendTransitionBarrier(resource, it->first.second, it->second, stateAfter, sBarrierFlagEndOnly, barriers);
+		++barrierCount;
+		it = mStateBeforeBySplitTransition.erase(it);
+	}
+
+	return barrierCount;
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// To track the states of resources and of their subresources, and to get
+// the barriers that change them.
+// Resources are opaque handles and states and flags are plain integers 
+// (D3D12_RESOURCE_STATES and D3D12_RESOURCE_BARRIER_FLAGS values).
+// It is not thread safe.
+class ResourceStateTable {
+public:
+	using ResourceHandle = const void*;
+
+	// Same values than D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES and D3D12_RESOURCE_BARRIER_FLAGS
+	static const std::uint32_t sAllSubresources{ 0xFFFFFFFFU };
+	static const std::uint32_t sBarrierFlagNone{ 0U };
+	static const std::uint32_t sBarrierFlagBeginOnly{ 1U };
+	static const std::uint32_t sBarrierFlagEndOnly{ 2U };
+
+	enum BarrierType {
+		TRANSITION_BARRIER = 0,
+		ALIASING_BARRIER,
+	};
+
+	// Transition barriers use mResource, mSubresource, states and mFlags.
+	// Aliasing barriers use mResource (resource before) and mResourceAfter.
+	struct Barrier {
+		BarrierType mType{ TRANSITION_BARRIER };
+		ResourceHandle mResource{ nullptr };
+		ResourceHandle mResourceAfter{ nullptr };
+		std::uint32_t mSubresource{ sAllSubresources };
+		std::uint32_t mStateBefore{ 0U };
+		std::uint32_t mStateAfter{ 0U };
+		std::uint32_t mFlags{ sBarrierFlagNone };
+	};
+
+	ResourceStateTable() = default;
+	~ResourceStateTable() = default;
+	ResourceStateTable(const ResourceStateTable&) = delete;
+	const ResourceStateTable& operator=(const ResourceStateTable&) = delete;
+	ResourceStateTable(ResourceStateTable&&) = delete;
+	ResourceStateTable& operator=(ResourceStateTable&&) = delete;
+
+	// Preconditions:
+	// - Resource must not have been added
+	// - "subresourceCount" must be greater than zero
+	void AddResource(
+		const ResourceHandle resource,
+		const std::uint32_t subresourceCount,
+		const std::uint32_t initialState) noexcept;
+
+	// Preconditions:
+	// - Resource must have been added
+	void RemoveResource(const ResourceHandle resource) noexcept;
+
+	bool HasResource(const ResourceHandle resource) const noexcept;
+
+	// Preconditions:
+	// - Resource must have been added
+	// - If "subresource" is sAllSubresources, then all the subresources must be in the same state
+	std::uint32_t GetState(
+		const ResourceHandle resource,
+		const std::uint32_t subresource = sAllSubresources) const noexcept;
+
+	// Changes the state of the subresource (or all the subresources) and appends to "barriers"
+	// the transition barriers needed. Subresources already in "stateAfter" do not get barriers.
+	// - sBarrierFlagBeginOnly changes the state and remembers the previous state.
+	// - sBarrierFlagEndOnly ends the split transitions begun for the subresource (or all the subresources).
+	// Returns the number of appended barriers.
+	// Preconditions:
+	// - Resource must have been added
+	// - "subresource" must be valid
+	// - With sBarrierFlagEndOnly, "stateAfter" must be the state used to begin the transitions
+	std::uint32_t Transition(
+		const ResourceHandle resource,
+		const std::uint32_t subresource,
+		const std::uint32_t stateAfter,
+		const std::uint32_t flags,
+		std::vector<Barrier>& barriers) noexcept;
+
+	// Number of split transitions that were begun but not ended
+	__forceinline std::uint32_t GetPendingSplitTransitionCount() const noexcept {
+		return static_cast<std::uint32_t>(mStateBeforeBySplitTransition.size());
+	}
+
+private:
+	// If mSubresourceStates is empty, then all the subresources are in mState
+	struct ResourceState {
+		std::uint32_t mState{ 0U };
+		std::uint32_t mSubresourceCount{ 1U };
+		std::vector<std::uint32_t> mSubresourceStates;
+	};
+
+	static void AppendTransitionBarrier(
+		const ResourceHandle resource,
+		const std::uint32_t subresource,
+		const std::uint32_t stateBefore,
+		const std::uint32_t stateAfter,
+		const std::uint32_t flags,
+		std::vector<Barrier>& barriers) noexcept;
+
+	std::uint32_t EndSplitTransitions(
+		const ResourceHandle resource,
+		const std::uint32_t subresource,
+		const std::uint32_t stateAfter,
+		std::vector<Barrier>& barriers) noexcept;
+
+	std::unordered_map<ResourceHandle, ResourceState> mStateByResource;
+
+	// State before of split transitions that were begun, by (resource, subresource)
+	using SplitTransitionKey = std::pair<ResourceHandle, std::uint32_t>;
+	std::map<SplitTransitionKey, std::uint32_t> mStateBeforeBySplitTransition;
+};
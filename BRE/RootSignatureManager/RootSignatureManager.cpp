@@ -4,30 +4,58 @@
 
 #include <DirectXManager/DirectXManager.h>
 #include <Utils/DebugUtils.h>
+#include <Utils/HashUtils.h>
 
-RootSignatureManager::RootSignatures RootSignatureManager::mRootSignatures;
+std::unordered_map<std::uint64_t, ID3D12RootSignature*> RootSignatureManager::mRootSignatureByKey;
+std::unordered_map<ID3D12RootSignature*, std::uint64_t> RootSignatureManager::mKeyByRootSignature;
+RootSignatureManager::Statistics RootSignatureManager::mStatistics;
 std::mutex RootSignatureManager::mMutex;
 
 void RootSignatureManager::EraseAll() noexcept {
-	for (ID3D12RootSignature* rootSignature : mRootSignatures) {
-		ASSERT(rootSignature != nullptr);
-		rootSignature->Release();
+	for (const std::pair<const std::uint64_t, ID3D12RootSignature*>& rootSignature : mRootSignatureByKey) {
+		ASSERT(rootSignature.second != nullptr);
+		rootSignature.second->Release();
 	}
+	mRootSignatureByKey.clear();
+	mKeyByRootSignature.clear();
+	mStatistics = Statistics();
 }
 
 ID3D12RootSignature& RootSignatureManager::CreateRootSignatureFromBlob(ID3DBlob& blob) noexcept {
-	ID3D12RootSignature* rootSignature{ nullptr };
+	const std::uint64_t key{ HashUtils::HashData(blob.GetBufferPointer(), blob.GetBufferSize()) };
+
+	std::lock_guard<std::mutex> lock(mMutex);
+	++mStatistics.mRequestCount;
+
+	const std::unordered_map<std::uint64_t, ID3D12RootSignature*>::const_iterator it{ mRootSignatureByKey.find(key) };
+	if (it != mRootSignatureByKey.end()) {
+		++mStatistics.mReusedCount;
+		return *it->second;
+	}
 
-	mMutex.lock();
-	DirectXManager::GetDevice().CreateRootSignature(
+	ID3D12RootSignature* rootSignature{ nullptr };
+	CHECK_HR(DirectXManager::GetDevice().CreateRootSignature(
 		0U, 
 		blob.GetBufferPointer(), 
 		blob.GetBufferSize(), 
-		IID_PPV_ARGS(&rootSignature));
-	mMutex.unlock();
+		IID_PPV_ARGS(&rootSignature)));
 
 	ASSERT(rootSignature != nullptr);
-	mRootSignatures.insert(rootSignature);
+	mRootSignatureByKey.emplace(key, rootSignature);
+	mKeyByRootSignature.emplace(rootSignature, key);
 
 	return *rootSignature;
-}
\ No newline at end of file
+}
+
+std::uint64_t RootSignatureManager::GetRootSignatureKey(ID3D12RootSignature& rootSignature) noexcept {
+	std::lock_guard<std::mutex> lock(mMutex);
+	const std::unordered_map<ID3D12RootSignature*, std::uint64_t>::const_iterator it{ mKeyByRootSignature.find(&rootSignature) };
+	ASSERT(it != mKeyByRootSignature.end());
+
+	return it->second;
+}
+
+RootSignatureManager::Statistics RootSignatureManager::GetStatistics() noexcept {
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mStatistics;
+}
@@ -1,10 +1,13 @@
 #pragma once
 
+#include <cstdint>
 #include <d3d12.h>
 #include <mutex>
-#include <tbb\concurrent_unordered_set.h>
+#include <unordered_map>
 
-// This class is responsible to create/get/erase root signatures
+// This class is responsible to create/get/erase root signatures.
+// Root signatures are identified by the content of their blob, so identical
+// blobs share the same root signature.
 class RootSignatureManager {
 public:
 	RootSignatureManager() = delete;
@@ -14,13 +17,29 @@ public:
 	RootSignatureManager(RootSignatureManager&&) = delete;
 	RootSignatureManager& operator=(RootSignatureManager&&) = delete;
 
+	struct Statistics {
+		std::uint32_t mRequestCount{ 0U };
+
+		// Requests that returned an existing root signature
+		std::uint32_t mReusedCount{ 0U };
+	};
+
 	static void EraseAll() noexcept;
 
+	// If a root signature was created with the same blob content, then it is returned.
 	static ID3D12RootSignature& CreateRootSignatureFromBlob(ID3DBlob& blob) noexcept;
 
+	// Hash of the blob content of a root signature, that identifies it in every execution (see PSOManager)
+	// Preconditions:
+	// - "rootSignature" must be created by this class
+	static std::uint64_t GetRootSignatureKey(ID3D12RootSignature& rootSignature) noexcept;
+
+	static Statistics GetStatistics() noexcept;
+
 private:
-	using RootSignatures = tbb::concurrent_unordered_set<ID3D12RootSignature*>;
-	static RootSignatures mRootSignatures;
+	static std::unordered_map<std::uint64_t, ID3D12RootSignature*> mRootSignatureByKey;
+	static std::unordered_map<ID3D12RootSignature*, std::uint64_t> mKeyByRootSignature;
+	static Statistics mStatistics;
 
 	static std::mutex mMutex;
 };
@@ -1,89 +1,124 @@
 #include "SceneUtils.h"
 
 #include <d3d12.h>
-#include <wrl.h>
 
 #include <CommandListExecutor\CommandListExecutor.h>
 #include <ModelManager\ModelManager.h>
 #include <ResourceManager\ResourceManager.h>
+#include <ResourceManager/TextureStreamer.h>
+#include <ResourceManager\TransferManager.h>
+#include <SettingsManager\SettingsManager.h>
 #include <Utils/DebugUtils.h>
 
-namespace SceneUtils {
-	void SceneResources::LoadTextures(
-		const std::vector<std::string>& sourceTextureFilenames,
-		ID3D12CommandAllocator& cmdAlloc,
-		ID3D12GraphicsCommandList& cmdList) noexcept
-	{
-		const std::size_t numTexturesToLoad = sourceTextureFilenames.size();
-		ASSERT(numTexturesToLoad > 0UL);
-		std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> uploadBuffers;
-		uploadBuffers.resize(numTexturesToLoad);		
-
-		std::size_t nextTextureAvailableIndex = mTextures.size();
-		const std::size_t newTextureCount = mTextures.size() + numTexturesToLoad;
-		mTextures.resize(newTextureCount);
-
-		CHECK_HR(cmdList.Reset(&cmdAlloc, nullptr));
-		
-		for (std::size_t i = 0UL; i < newTextureCount; ++i, ++nextTextureAvailableIndex) {
-			mTextures[nextTextureAvailableIndex] = &ResourceManager::LoadTextureFromFile(
-				sourceTextureFilenames[i].c_str(),
-				cmdList,
-				uploadBuffers[i],
-				nullptr);
-			ASSERT(mTextures[nextTextureAvailableIndex] != nullptr);
+namespace {
+	std::vector<std::string> GetFilePaths(const std::vector<std::string>& filenames) noexcept {
+		std::vector<std::string> filePaths;
+		filePaths.reserve(filenames.size());
+		for (const std::string& filename : filenames) {
+			filePaths.push_back(SettingsManager::sResourcesPath + filename);
 		}
-		cmdList.Close();
 
-		CommandListExecutor::Get().ExecuteCommandListAndWaitForCompletion(cmdList);
+		return filePaths;
 	}
+}
 
-	ID3D12Resource& SceneResources::GetTexture(const std::size_t index) noexcept {
-		ASSERT(index < mTextures.size());
-		ID3D12Resource* res = mTextures[index];
-		ASSERT(res != nullptr);
-		return *res;
+namespace SceneUtils {
+	void SceneResources::LoadTextures(const std::vector<std::string>& textureFilenames) noexcept
+	{
+		ASSERT(mAreTexturesLoading == false);
+
+		const std::size_t numTexturesToLoad = textureFilenames.size();
+		ASSERT(numTexturesToLoad > 0UL);
+
+		// Tasks fill their own elements, so vectors must not grow while they run
+		const std::size_t firstTextureIndex = mTextures.size();
+		mTextures.resize(firstTextureIndex + numTexturesToLoad, nullptr);
+		mAreTexturesLoading = true;
+
+		// Streamed textures map their files again to load finer mips, so tasks need their paths
+		const std::vector<std::string> filePaths{ GetFilePaths(textureFilenames) };
+		mFileLoader.Load(
+			filePaths,
+			[this, firstTextureIndex, filePaths](
+				const std::size_t fileIndex, 
+				const std::uint8_t* fileData, 
+				const std::size_t fileDataSize) {
+				mTextures[firstTextureIndex + fileIndex] = &TextureStreamer::LoadTextureFromMemory(
+					fileData,
+					fileDataSize,
+					filePaths[fileIndex].c_str());
+			});
 	}
 
-	void SceneResources::LoadModels(
-		const std::vector<std::string>& modelFiles,
-		ID3D12CommandAllocator& cmdAlloc,
-		ID3D12GraphicsCommandList& cmdList) noexcept
+	void SceneResources::LoadModels(const std::vector<std::string>& modelFilenames) noexcept
 	{
-		ASSERT(mModels.empty());
+		ASSERT(mAreModelsLoading == false);
 
-		const std::size_t numModelsToLoad = modelFiles.size();
+		const std::size_t numModelsToLoad = modelFilenames.size();
 		ASSERT(numModelsToLoad > 0UL);
 
-		std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> uploadVertexBuffers;
-		uploadVertexBuffers.resize(numModelsToLoad);
-		std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> uploadIndexBuffers;
-		uploadIndexBuffers.resize(numModelsToLoad);
+		// Extension is used to know the model format, as data is parsed from memory
+		std::vector<std::string> fileExtensions(numModelsToLoad);
+		for (std::size_t i = 0UL; i < numModelsToLoad; ++i) {
+			const std::size_t dotPosition = modelFilenames[i].find_last_of('.');
+			ASSERT(dotPosition != std::string::npos);
+			fileExtensions[i] = modelFilenames[i].substr(dotPosition + 1UL);
+		}
+
+		// Tasks fill their own elements, so vectors must not grow while they run.
+		const std::size_t firstModelIndex = mModels.size();
+		mModels.resize(firstModelIndex + numModelsToLoad, nullptr);
+		mAreModelsLoading = true;
+
+		mFileLoader.Load(
+			GetFilePaths(modelFilenames),
+			[this, firstModelIndex, fileExtensions](
+				const std::size_t fileIndex, 
+				const std::uint8_t* fileData, 
+				const std::size_t fileDataSize) {
+				mModels[firstModelIndex + fileIndex] = &ModelManager::LoadModelFromMemory(
+					fileData,
+					fileDataSize,
+					fileExtensions[fileIndex].c_str());
+			});
+	}
 
-		std::size_t nextModelAvailableIndex = mModels.size();
-		const std::size_t newModelCount = mModels.size() + numModelsToLoad;
-		mModels.resize(newModelCount);
+	void SceneResources::WaitForLoading() noexcept {
+		if (mAreTexturesLoading == false && mAreModelsLoading == false) {
+			return;
+		}
 
-		CHECK_HR(cmdList.Reset(&cmdAlloc, nullptr));
+		mFileLoader.Wait();
 
-		for (std::size_t i = 0UL; i < numModelsToLoad; ++i, ++nextModelAvailableIndex) {
-			mModels[nextModelAvailableIndex] = &ModelManager::LoadModel(
-				modelFiles[i].c_str(),
-				cmdList, 
-				uploadVertexBuffers[i], 
-				uploadIndexBuffers[i]);
-			ASSERT(mTextures[nextModelAvailableIndex] != nullptr);
+		// Uploads of all the files are submitted at once, and command lists that are 
+		// executed after this call (in the graphics queue) wait for them.
+		const std::uint64_t uploadFenceValue{ TransferManager::Flush() };
+		TransferManager::WaitOnGpu(CommandListExecutor::Get().GetCommandQueue(), uploadFenceValue);
+
+		for (const ID3D12Resource* texture : mTextures) {
+			ASSERT(texture != nullptr);
+		}
+		for (const Model* model : mModels) {
+			ASSERT(model != nullptr);
 		}
-		cmdList.Close();
 
-		CommandListExecutor::Get().ExecuteCommandListAndWaitForCompletion(cmdList);
+		mAreTexturesLoading = false;
+		mAreModelsLoading = false;
+	}
+
+	ID3D12Resource& SceneResources::GetTexture(const std::size_t index) noexcept {
+		ASSERT(mAreTexturesLoading == false);
+		ASSERT(index < mTextures.size());
+		ID3D12Resource* res = mTextures[index];
+		ASSERT(res != nullptr);
+		return *res;
 	}
 
 	const Model& SceneResources::GetModel(const std::size_t index) const noexcept {
+		ASSERT(mAreModelsLoading == false);
 		ASSERT(index < mModels.size());
 		Model* model = mModels[index];
 		ASSERT(model != nullptr);
 		return *model;
 	}
 }
-
@@ -1,15 +1,23 @@
 #pragma once
 
 #include <cstddef>
+#include <string>
 #include <vector>
 
-struct ID3D12CommandAllocator;
-struct ID3D12GraphicsCommandList;
+#include <Utils/DebugUtils.h>
+#include <Utils/ParallelFileLoader.h>
+
 struct ID3D12Resource;
 class Model;
 
 namespace SceneUtils {
 
+	// Textures and models are loaded asynchronously: files are read and parsed
+	// in parallel by TBB tasks, and their data is uploaded by TransferManager.
+	// Steps:
+	// - Call LoadTextures() and LoadModels(). They return immediately.
+	// - Do other work (for example, create pipeline state objects)
+	// - Call WaitForLoading() before getting textures or models
 	class SceneResources {
 	public:
 		SceneResources() = default;
@@ -19,28 +27,44 @@ namespace SceneUtils {
 		SceneResources(SceneResources&&) = delete;
 		SceneResources& operator=(SceneResources&&) = delete;
 
-		void LoadTextures(
-			const std::vector<std::string>& sourceTextureFiles,
-			ID3D12CommandAllocator& cmdAlloc,
-			ID3D12GraphicsCommandList& cmdList) noexcept;
+		// 2D textures with mips are streamed (see TextureStreamer::LoadTextureFromMemory())
+		// Preconditions:
+		// - Textures must not be loading (WaitForLoading() must be called after the previous call)
+		void LoadTextures(const std::vector<std::string>& textureFilenames) noexcept;
+
+		// Preconditions:
+		// - Models must not be loading (WaitForLoading() must be called after the previous call)
+		void LoadModels(const std::vector<std::string>& modelFilenames) noexcept;
+
+		// Waits until all the files are loaded, and submits their uploads to the copy queue.
+		// The graphics queue waits for them on the GPU, so it does not block until they are completed.
+		// It returns immediately if nothing is loading.
+		void WaitForLoading() noexcept;
 
 		// Preconditionts:
 		// - There must be a valid texture at "index" 
+		// - Textures must not be loading
 		ID3D12Resource& GetTexture(const std::size_t index) noexcept;
-		const std::vector<ID3D12Resource*>& GetTextures() const noexcept { return mTextures; }
-
-		void LoadModels(
-			const std::vector<std::string>& modelFilenames,
-			ID3D12CommandAllocator& cmdAlloc,
-			ID3D12GraphicsCommandList& cmdList) noexcept;
+		const std::vector<ID3D12Resource*>& GetTextures() const noexcept { 
+			ASSERT(mAreTexturesLoading == false);
+			return mTextures; 
+		}
 
 		// Preconditionts:
 		// - There must be a valid model at "index" 
+		// - Models must not be loading
 		const Model& GetModel(const std::size_t index) const noexcept;		
-		const std::vector<Model*>& GetModels() const noexcept { return mModels; }
+		const std::vector<Model*>& GetModels() const noexcept { 
+			ASSERT(mAreModelsLoading == false);
+			return mModels; 
+		}
 
 	private:
 		std::vector<ID3D12Resource*> mTextures;
 		std::vector<Model*> mModels;
+		bool mAreTexturesLoading{ false };
+		bool mAreModelsLoading{ false };
+
+		ParallelFileLoader mFileLoader;
 	};
 };
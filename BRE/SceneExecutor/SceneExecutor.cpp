@@ -16,8 +16,12 @@
 #include <PSOManager\PSOManager.h>
 #include <RenderManager/RenderManager.h>
 #include <ResourceManager\ResourceManager.h>
+#include <ResourceManager/TextureStreamer.h>
+#include <ResourceManager/TransferManager.h>
 #include <ResourceManager\UploadBufferManager.h>
+#include <ResourceManager/VertexAndIndexBufferCreator.h>
 #include <RootSignatureManager\RootSignatureManager.h>
+#include <SettingsManager\SettingsManager.h>
 #include <ShaderManager\ShaderManager.h>
 #include <ShaderUtils\CBuffers.h>
 #include <Utils\DebugUtils.h>
@@ -42,11 +46,17 @@ namespace {
 		DepthStencilDescriptorManager::Init();
 		RenderTargetDescriptorManager::Init();
 		MaterialManager::Init();
+		PSOManager::Init();
+		TransferManager::Init();
+		TextureStreamer::Init(SettingsManager::sTextureMemoryBudget);
 
 		ShowCursor(false);
 	}
 
 	void FinalizeSystems() noexcept {
+		// They wait for pending loads and uploads, so they go before the managers that destroy their objects
+		TextureStreamer::EraseAll();
+		TransferManager::EraseAll();
 		CommandAllocatorManager::EraseAll();
 		CommandListManager::EraseAll();
 		CommandQueueManager::EraseAll();
@@ -56,6 +66,8 @@ namespace {
 		RootSignatureManager::EraseAll();
 		ShaderManager::EraseAll();
 		UploadBufferManager::EraseAll();
+		VertexAndIndexBufferCreator::ClearSharedBuffers();
+		VertexAndIndexBufferCreator::EraseAllPools();
 	}
 
 	void UpdateKeyboardAndMouse() noexcept {
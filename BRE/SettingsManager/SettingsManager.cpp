@@ -5,6 +5,7 @@
 #include <MathUtils/MathUtils.h>
 
 const char* SettingsManager::sResourcesPath{ "../../../external/resources/" };
+const char* SettingsManager::sPipelineCacheFilePath{ "PipelineCache.bin" };
 const bool SettingsManager::sIsFullscreenWindow{ true };
 const std::uint32_t SettingsManager::sCpuProcessorCount{ 4U }; // This should be changed according your processor
 const std::uint32_t SettingsManager::sWindowWidth{ 1920U };
@@ -25,4 +26,9 @@ const float SettingsManager::sVerticalFieldOfView{ 0.25f * MathUtils::Pi };
 const D3D12_VIEWPORT SettingsManager::sScreenViewport{ 0.0f, 0.0f, SettingsManager::sWindowWidth, SettingsManager::sWindowHeight, 0.0f, 1.0f };
 const D3D12_RECT SettingsManager::sScissorRect{ 0, 0, SettingsManager::sWindowWidth, SettingsManager::sWindowHeight };
 
+const std::uint64_t SettingsManager::sTextureMemoryBudget{ 512UL * 1024UL * 1024UL };
+const std::uint64_t SettingsManager::sResidencyMemoryBudget{ 0UL };
+const std::uint32_t SettingsManager::sResidencyMinIdleFrameCount{ 60U };
+const std::uint32_t SettingsManager::sResidencyDemotionIdleFrameCount{ 30U };
+
 const float SettingsManager::sSecondsPerFrame{ 1.0f / 60.0f };
\ No newline at end of file
@@ -15,6 +15,9 @@ public:
 	__forceinline static float AspectRatio() noexcept { return static_cast<float>(sWindowWidth) / sWindowHeight; }
 
 	static const char* sResourcesPath;
+
+	// File where pipeline states are cached between executions (see PSOManager)
+	static const char* sPipelineCacheFilePath;
 	static const bool sIsFullscreenWindow;
 	static const std::uint32_t sCpuProcessorCount;
 	static const std::uint32_t sSwapChainBufferCount{ 4U };
@@ -45,6 +48,18 @@ public:
 	static const D3D12_VIEWPORT sScreenViewport;
 	static const D3D12_RECT sScissorRect;
 
+	// Memory budget of the mips of streamed textures (see TextureStreamer)
+	static const std::uint64_t sTextureMemoryBudget;
+
+	// Memory budget of the heaps and resources of ResourceManager (see ResourceManager::UpdateResidency()).
+	// If it is zero, then the budget is the local video memory budget that the OS gives to the process.
+	static const std::uint64_t sResidencyMemoryBudget;
+
+	// Frames that a resource must not be used before it can be evicted, and before its
+	// residency priority is lowered
+	static const std::uint32_t sResidencyMinIdleFrameCount;
+	static const std::uint32_t sResidencyDemotionIdleFrameCount;
+
 	// Used to update physics. If you
 	// want a fixed update time step, for example,
 	// 60 FPS, then you should store 1.0f / 60.0f here
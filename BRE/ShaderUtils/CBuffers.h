@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <DirectXMath.h>
 
 #include <MathUtils\MathUtils.h>
@@ -17,6 +18,25 @@ struct ObjectCBuffer {
 	float mTextureScaleFactor{ 2.0f };
 };
 
+// Per instance data used by instanced geometry pass draw calls.
+// It is stored in a structured buffer that shaders index with SV_InstanceID.
+// Its layout must match InstanceData in CBuffers.hlsli
+struct InstanceData {
+	InstanceData() = default;
+	~InstanceData() = default;
+	InstanceData(const InstanceData&) = default;
+	InstanceData& operator=(const InstanceData&) = default;
+	InstanceData(InstanceData&&) = default;
+	InstanceData& operator=(InstanceData&&) = default;
+
+	DirectX::XMFLOAT4X4 mWorldMatrix{ MathUtils::GetIdentity4x4Matrix() };
+	float mTextureScaleFactor{ 2.0f };
+
+	// Index of the instance material and textures
+	std::uint32_t mMaterialIndex{ 0U };
+	float mPadding[2U];
+};
+
 // Per frame constant buffer data
 struct FrameCBuffer {
 	FrameCBuffer() = default;
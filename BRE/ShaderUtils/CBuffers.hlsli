@@ -7,6 +7,15 @@ struct ObjectCBuffer {
 	float mTexTransform;
 };
 
+// Per instance data used by instanced geometry pass draw calls.
+// It is stored in a structured buffer indexed with SV_InstanceID
+struct InstanceData {
+	float4x4 mWorldMatrix;
+	float mTexTransform;
+	uint mMaterialIndex;
+	float2 mPadding;
+};
+
 // Per frame constant buffer data
 struct FrameCBuffer {	
 	float4x4 mViewMatrix;
@@ -4,6 +4,9 @@
 struct Material {
 	float4 mBaseColor_MetalMask;
 	float mSmoothness;
+
+	// To match Material (C++) size when it is stored in a structured buffer
+	float3 mPadding;
 };
 
 #endif 
\ No newline at end of file
@@ -66,6 +66,16 @@ float3 Decode(float2 encN) {
 	return n;
 }
 
+// Decodes an octahedron-normal encoded in [-1.0, 1.0], like 
+// SNORM vertex attributes (see VertexCompressor::EncodeOctahedral())
+float3 DecodeOctahedronSnorm(const float2 encN) {
+	float3 n;
+	n.z = 1.0 - abs(encN.x) - abs(encN.y);
+	n.xy = n.z >= 0.0 ? encN.xy : OctWrap(encN.xy);
+	n = normalize(n);
+	return n;
+}
+
 // Map vector from [-1.0f, 1.0f] to [0.0f, 1.0f]
 float3 MapF1(const float3 n) {
 	return n * 0.5f + float3(0.5f, 0.5f, 0.5f);
@@ -76,6 +86,13 @@ float3 UnmapF1(const float3 n) {
 	return n * 2.0f - float3(1.0f, 1.0f, 1.0f);
 }
 
+// UnMap a unit normal from its x and y in [0.0f, 1.0f].
+// z is reconstructed (z >= 0.0f), so normal maps can be compressed to two channels (BC5).
+float3 UnmapNormalXY(const float2 n) {
+	const float2 xy = n * 2.0f - float2(1.0f, 1.0f);
+	return float3(xy, sqrt(saturate(1.0f - dot(xy, xy))));
+}
+
 //
 // sRGB <-> Linear 
 // 
@@ -2,10 +2,12 @@
 
 #include "RS.hlsl"
 
+// Packed vertex (see VertexCompressor::PackedVertex). Quantized position is
+// dequantized by the world matrix.
 struct Input {
-	float3 mPositionObjectSpace : POSITION;
-	float3 mNormalObjectSpace : NORMAL;
-	float3 mTangentObjectSpace : TANGENT;
+	float4 mPositionQuantized : POSITION;
+	float2 mNormalObjectSpaceEncoded : NORMAL;
+	float2 mTangentObjectSpaceEncoded : TANGENT;
 	float2 mUV : TEXCOORD;
 };
 
@@ -24,10 +26,11 @@ Output main(in const Input input) {
 	Output output;
 
 	// Use local vertex position as cubemap lookup vector.
-	output.mPositionObjectSpace = input.mPositionObjectSpace;
+	// World matrix only dequantizes the position (sky box is centered at the origin).
+	float3 positionWorldSpace = mul(input.mPositionQuantized, gObjCBuffer.mWorldMatrix).xyz;
+	output.mPositionObjectSpace = positionWorldSpace;
 
 	// Always center sky about camera.
-	float3 positionWorldSpace = mul(float4(input.mPositionObjectSpace, 1.0f), gObjCBuffer.mWorldMatrix).xyz;
 	positionWorldSpace += gFrameCBuffer.mEyePositionWorldSpace.xyz;
 
 	// Set z = w so that z/w = 1 (i.e., skydome always on far plane).
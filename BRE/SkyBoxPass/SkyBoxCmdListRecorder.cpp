@@ -6,6 +6,7 @@
 #include <DescriptorManager\CbvSrvUavDescriptorManager.h>
 #include <DirectXManager\DirectXManager.h>
 #include <PSOManager/PSOManager.h>
+#include <ResourceManager/ResourceManager.h>
 #include <ResourceManager/UploadBufferManager.h>
 #include <RootSignatureManager\RootSignatureManager.h>
 #include <ShaderManager\ShaderManager.h>
@@ -35,7 +36,7 @@ void SkyBoxCmdListRecorder::InitSharedPSOAndRootSignature() noexcept {
 	// Otherwise, the normalized depth values at z = 1 (NDC) will 
 	// fail the depth test if the depth buffer was cleared to 1.
 	psoData.mDepthStencilDescriptor.DepthFunc = D3D12_COMPARISON_FUNC_LESS_EQUAL;
-	psoData.mInputLayoutDescriptors = D3DFactory::GetPosNormalTangentTexCoordInputLayout();
+	psoData.mInputLayoutDescriptors = D3DFactory::GetPackedPosNormalTangentTexCoordInputLayout();
 
 	psoData.mPixelShaderBytecode = ShaderManager::LoadShaderFileAndGetBytecode("SkyBoxPass/Shaders/PS.cso");
 	psoData.mVertexShaderBytecode = ShaderManager::LoadShaderFileAndGetBytecode("SkyBoxPass/Shaders/VS.cso");
@@ -74,18 +75,18 @@ void SkyBoxCmdListRecorder::Init(
 	InitConstantBuffers(worldMatrix);
 	InitShaderResourceViews(skyBoxCubeMap);
 
+	// It is not marked as used every frame
+	ID3D12Resource* cubeMap{ &skyBoxCubeMap };
+	ResourceManager::KeepResourcesResident(&cubeMap, 1U);
+
 	ASSERT(IsDataValid());
 }
 
-void SkyBoxCmdListRecorder::RecordAndPushCommandLists(const FrameCBuffer& frameCBuffer) noexcept {
+void SkyBoxCmdListRecorder::RecordAndPushCommandLists(const D3D12_GPU_VIRTUAL_ADDRESS frameCBufferGpuAddress) noexcept {
 	ASSERT(IsDataValid());
 	ASSERT(sPSO != nullptr);
 	ASSERT(sRootSignature != nullptr);
 
-	// Update frame constants
-	UploadBuffer& uploadFrameCBuffer(mFrameUploadCBufferPerFrame.GetNextFrameCBuffer());
-	uploadFrameCBuffer.CopyData(0U, &frameCBuffer, sizeof(frameCBuffer));
-
 	ID3D12GraphicsCommandList& commandList = mCommandListPerFrame.ResetWithNextCommandAllocator(sPSO);
 
 	commandList.RSSetViewports(1U, &SettingsManager::sScreenViewport);
@@ -96,15 +97,19 @@ void SkyBoxCmdListRecorder::RecordAndPushCommandLists(const FrameCBuffer& frameC
 	commandList.SetDescriptorHeaps(_countof(heaps), heaps);
 
 	commandList.SetGraphicsRootSignature(sRootSignature);
-	D3D12_GPU_VIRTUAL_ADDRESS frameCBufferGpuVAddress(uploadFrameCBuffer.GetResource()->GetGPUVirtualAddress());
 	commandList.SetGraphicsRootDescriptorTable(0U, mObjectCBufferView);
-	commandList.SetGraphicsRootConstantBufferView(1U, frameCBufferGpuVAddress);
+	commandList.SetGraphicsRootConstantBufferView(1U, frameCBufferGpuAddress);
 	commandList.SetGraphicsRootDescriptorTable(2U, mStartPixelShaderResourceView);
 
 	commandList.IASetVertexBuffers(0U, 1U, &mVertexBufferData.mBufferView);
 	commandList.IASetIndexBuffer(&mIndexBufferData.mBufferView);
 	commandList.IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-	commandList.DrawIndexedInstanced(mIndexBufferData.mElementCount, 1U, 0U, 0U, 0U);
+	commandList.DrawIndexedInstanced(
+		mIndexBufferData.mElementCount, 
+		1U, 
+		mIndexBufferData.mStartIndex, 
+		static_cast<std::int32_t>(mVertexBufferData.mBaseVertex), 
+		0U);
 
 	commandList.Close();
 	CommandListExecutor::Get().AddCommandList(commandList);
@@ -4,12 +4,11 @@
 
 #include <CommandManager\CommandListPerFrame.h>
 #include <MathUtils\MathUtils.h>
-#include <ResourceManager\FrameUploadCBufferPerFrame.h>
+#include <ResourceManager\UploadBuffer.h>
 #include <ResourceManager/VertexAndIndexBufferCreator.h>
 
 struct D3D12_CPU_DESCRIPTOR_HANDLE;
 struct D3D12_GPU_DESCRIPTOR_HANDLE;
-struct FrameCBuffer;
 struct ID3D12CommandAllocator;
 struct ID3D12Resource;
 struct ID3D12GraphicsCommandList;
@@ -37,7 +36,7 @@ public:
 
 	// Preconditions:
 	// - Init() must be called first
-	void RecordAndPushCommandLists(const FrameCBuffer& frameCBuffer) noexcept;
+	void RecordAndPushCommandLists(const D3D12_GPU_VIRTUAL_ADDRESS frameCBufferGpuAddress) noexcept;
 
 	bool IsDataValid() const noexcept;
 
@@ -50,8 +49,6 @@ private:
 	VertexAndIndexBufferCreator::VertexBufferData mVertexBufferData;
 	VertexAndIndexBufferCreator::IndexBufferData mIndexBufferData;
 
-	FrameUploadCBufferPerFrame mFrameUploadCBufferPerFrame;
-
 	UploadBuffer* mObjectUploadCBuffer{ nullptr };
 	D3D12_GPU_DESCRIPTOR_HANDLE mObjectCBufferView;
 
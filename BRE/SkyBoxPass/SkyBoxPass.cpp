@@ -3,38 +3,21 @@
 #include <d3d12.h>
 
 #include <CommandListExecutor/CommandListExecutor.h>
-#include <CommandManager\CommandAllocatorManager.h>
-#include <CommandManager\CommandListManager.h>
 #include <ModelManager\Mesh.h>
 #include <ModelManager\Model.h>
 #include <ModelManager\ModelManager.h>
+#include <ResourceManager/TransferManager.h>
 #include <SkyBoxPass\SkyBoxCmdListRecorder.h>
 #include <ShaderUtils\CBuffers.h>
 #include <Utils\DebugUtils.h>
 
 namespace {
-	void CreateCommandObjects(
-		ID3D12CommandAllocator* &commandAllocator,
-		ID3D12GraphicsCommandList* &commandList) noexcept 
-	{
-		// Create command allocators and command list
-		commandAllocator = &CommandAllocatorManager::CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT);
-		commandList = &CommandListManager::CreateCommandList(D3D12_COMMAND_LIST_TYPE_DIRECT, *commandAllocator);
-		commandList->Close();
-	}
-
-	Model& CreateAndGetSkyBoxSphereModel(
-		ID3D12CommandAllocator& commandAllocator, 
-		ID3D12GraphicsCommandList& commandList) 
-	{
-		CHECK_HR(commandList.Reset(&commandAllocator, nullptr));
-
-		Microsoft::WRL::ComPtr<ID3D12Resource> uploadVertexBuffer;
-		Microsoft::WRL::ComPtr<ID3D12Resource> uploadIndexBuffer;
-		Model* model = &ModelManager::CreateSphere(3000, 50, 50, commandList, uploadVertexBuffer, uploadIndexBuffer);
+	Model& CreateAndGetSkyBoxSphereModel() {
+		Model* model = &ModelManager::CreateSphere(3000, 50, 50);
 		
-		commandList.Close();
-		CommandListExecutor::Get().ExecuteCommandListAndWaitForCompletion(commandList);
+		// Graphics queue waits for the sphere buffers on the GPU
+		const std::uint64_t uploadFenceValue{ TransferManager::Flush() };
+		TransferManager::WaitOnGpu(CommandListExecutor::Get().GetCommandQueue(), uploadFenceValue);
 
 		return *model;
 	}
@@ -47,18 +30,26 @@ void SkyBoxPass::Init(
 {
 	ASSERT(IsDataValid() == false);
 
-	ID3D12CommandAllocator* commandAllocator;
-	ID3D12GraphicsCommandList* commandList;
-	CreateCommandObjects(commandAllocator, commandList);
-
-	Model& model = CreateAndGetSkyBoxSphereModel(*commandAllocator, *commandList);
+	Model& model = CreateAndGetSkyBoxSphereModel();
 	const std::vector<Mesh>& meshes(model.GetMeshes());
 	ASSERT(meshes.size() == 1UL);
 
-	// Build world matrix
+	// Build world matrix. The sky box sphere is centered at the origin, so
+	// its world matrix only dequantizes vertex positions.
 	const Mesh& mesh{ meshes[0] };
+	const VertexCompressor::PositionQuantization& positionQuantization = mesh.GetPositionQuantization();
 	DirectX::XMFLOAT4X4 worldMatrix;
-	MathUtils::ComputeMatrix(worldMatrix, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f);
+	MathUtils::ComputeMatrix(
+		worldMatrix, 
+		positionQuantization.mOffset.x, 
+		positionQuantization.mOffset.y, 
+		positionQuantization.mOffset.z, 
+		positionQuantization.mScale, 
+		positionQuantization.mScale, 
+		positionQuantization.mScale, 
+		0.0f, 
+		0.0f, 
+		0.0f);
 
 	SkyBoxCmdListRecorder::InitSharedPSOAndRootSignature();
 
@@ -74,16 +65,12 @@ void SkyBoxPass::Init(
 	ASSERT(IsDataValid());
 }
 
-void SkyBoxPass::Execute(const FrameCBuffer& frameCBuffer) const noexcept {
+std::uint32_t SkyBoxPass::Execute(const D3D12_GPU_VIRTUAL_ADDRESS frameCBufferGpuAddress) const noexcept {
 	ASSERT(IsDataValid());
 
-	CommandListExecutor::Get().ResetExecutedCommandListCount();
-	mCommandListRecorder->RecordAndPushCommandLists(frameCBuffer);
+	mCommandListRecorder->RecordAndPushCommandLists(frameCBufferGpuAddress);
 
-	// Wait until all previous tasks command lists are executed
-	while (CommandListExecutor::Get().GetExecutedCommandListCount() < 1U) {
-		Sleep(0U);
-	}
+	return 1U;
 }
 
 bool SkyBoxPass::IsDataValid() const noexcept {
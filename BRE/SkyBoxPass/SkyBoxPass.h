@@ -5,7 +5,6 @@
 #include <SkyBoxPass\SkyBoxCmdListRecorder.h>
 
 struct D3D12_CPU_DESCRIPTOR_HANDLE;
-struct FrameCBuffer;
 
 class SkyBoxPass {
 public:
@@ -21,9 +20,11 @@ public:
 		const D3D12_CPU_DESCRIPTOR_HANDLE& renderTargetView,
 		const D3D12_CPU_DESCRIPTOR_HANDLE& depthBufferView) noexcept;
 
+	// Returns the number of command lists pushed to CommandListExecutor.
+	// It does not wait for them to be executed.
 	// Preconditions:
 	// - Init() must be called first
-	void Execute(const FrameCBuffer& frameCBuffer) const noexcept;
+	std::uint32_t Execute(const D3D12_GPU_VIRTUAL_ADDRESS frameCBufferGpuAddress) const noexcept;
 
 private:
 	bool IsDataValid() const noexcept;
@@ -0,0 +1,62 @@
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include <ResourceManager/BlockCompressor.h>
+#include <TestUtils.h>
+#include <TextureTestUtils.h>
+
+// Compression and decompression speed of BlockCompressor (in millions of texels per second), and 
+// the PSNR of the decompressed images, for each format and each image of external/resources/textures
+// (the first mip, decompressed to RGBA8 if the file is block compressed).
+namespace {
+	const BlockCompressor::Format sFormats[]{
+		BlockCompressor::Format::BC1,
+		BlockCompressor::Format::BC3,
+		BlockCompressor::Format::BC4,
+		BlockCompressor::Format::BC5,
+		BlockCompressor::Format::BC7 };
+
+	const char* GetFormatName(const BlockCompressor::Format format) {
+		const char* formatNames[]{ "BC1", "BC3", "BC4", "BC5", "BC7" };
+		return formatNames[static_cast<std::uint32_t>(format)];
+	}
+
+	void Run(const TextureTestUtils::Image& image, const BlockCompressor::Format format) {
+		std::vector<std::uint8_t> blocks(BlockCompressor::GetCompressedSize(image.mWidth, image.mHeight, format));
+		std::vector<std::uint8_t> decompressedTexels(image.mTexels.size());
+		const double compressMilliseconds{ TestUtils::MeasureMinimumMilliseconds(2U, [&image, &blocks, format]() {
+			BlockCompressor::CompressImage(image.mTexels.data(), image.mWidth, image.mHeight, image.mWidth * 4UL, format, blocks.data());
+		}) };
+		const double decompressMilliseconds{ TestUtils::MeasureMinimumMilliseconds(3U, [&image, &blocks, &decompressedTexels, format]() {
+			BlockCompressor::DecompressImage(blocks.data(), image.mWidth, image.mHeight, format, decompressedTexels.data());
+		}) };
+
+		const double texelCount{ static_cast<double>(image.mWidth) * image.mHeight };
+		std::printf(
+			"%-22s %4ux%-4u %s | compress %7.2f Mtexels/s | decompress %7.1f Mtexels/s | PSNR %6.2f dB\n",
+			image.mName.c_str(),
+			image.mWidth,
+			image.mHeight,
+			GetFormatName(format),
+			texelCount / (compressMilliseconds * 1000.0),
+			texelCount / (decompressMilliseconds * 1000.0),
+			BlockCompressor::ComputePSNR(image.mTexels.data(), decompressedTexels.data(), image.mTexels.size() / 4UL, format));
+	}
+}
+
+int main() {
+	const std::vector<TextureTestUtils::Image> images{ TextureTestUtils::ReadResourceImages(0U) };
+	if (images.empty()) {
+		std::printf("No textures found\n");
+		return 0;
+	}
+
+	for (const BlockCompressor::Format format : sFormats) {
+		for (const TextureTestUtils::Image& image : images) {
+			Run(image, format);
+		}
+	}
+
+	return 0;
+}
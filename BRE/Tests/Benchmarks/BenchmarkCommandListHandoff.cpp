@@ -0,0 +1,158 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <ctime>
+#endif
+
+#include <tbb/concurrent_queue.h>
+
+#include <TestUtils.h>
+#include <Utils/BlockingQueue.h>
+#include <Utils/CompletionLatch.h>
+
+// Compares the handoff between a pass and CommandListExecutor before and after they block
+// (BlockingQueue and CompletionLatch) instead of polling with Sleep(0) (std::this_thread::yield()):
+// - CPU time consumed by the executor while there are no command lists to execute
+// - Latency from the pass pushing a command list to the pass seeing it executed
+namespace {
+	const std::uint32_t sIdleMilliseconds{ 500U };
+	const std::uint32_t sRoundCount{ 20000U };
+
+	double GetProcessCpuMilliseconds() noexcept {
+#ifdef _WIN32
+		FILETIME creationTime;
+		FILETIME exitTime;
+		FILETIME kernelTime;
+		FILETIME userTime;
+		GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime);
+		const std::uint64_t kernel{ (static_cast<std::uint64_t>(kernelTime.dwHighDateTime) << 32UL) | kernelTime.dwLowDateTime };
+		const std::uint64_t user{ (static_cast<std::uint64_t>(userTime.dwHighDateTime) << 32UL) | userTime.dwLowDateTime };
+		return static_cast<double>(kernel + user) / 10000.0;
+#else
+		timespec time;
+		clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time);
+		return static_cast<double>(time.tv_sec) * 1000.0 + static_cast<double>(time.tv_nsec) / 1.0e6;
+#endif
+	}
+
+	struct Result {
+		double mIdleCpuMilliseconds{ 0.0 };
+		double mMedianLatencyMicroseconds{ 0.0 };
+		double mAverageLatencyMicroseconds{ 0.0 };
+	};
+
+	double GetMedian(std::vector<double>& values) noexcept {
+		std::sort(values.begin(), values.end());
+		return values[values.size() / 2UL];
+	}
+
+	double GetAverage(const std::vector<double>& values) noexcept {
+		double sum{ 0.0 };
+		for (const double value : values) {
+			sum += value;
+		}
+		return sum / static_cast<double>(values.size());
+	}
+
+	// Previous implementation: the executor polls a concurrent queue and
+	// the pass polls the executed command list count
+	Result RunPolling() {
+		tbb::concurrent_queue<std::uint32_t> queue;
+		std::atomic<std::uint32_t> executedCount{ 0U };
+		std::atomic<bool> isTerminated{ false };
+		std::thread executorThread([&queue, &executedCount, &isTerminated]() {
+			std::uint32_t commandList{ 0U };
+			while (isTerminated == false) {
+				if (queue.try_pop(commandList)) {
+					++executedCount;
+				} else {
+					std::this_thread::yield();
+				}
+			}
+		});
+
+		Result result;
+		const double cpuTime{ GetProcessCpuMilliseconds() };
+		std::this_thread::sleep_for(std::chrono::milliseconds(sIdleMilliseconds));
+		result.mIdleCpuMilliseconds = GetProcessCpuMilliseconds() - cpuTime;
+
+		std::vector<double> latencies;
+		latencies.reserve(sRoundCount);
+		for (std::uint32_t i = 0U; i < sRoundCount; ++i) {
+			const std::uint32_t expectedCount{ executedCount + 1U };
+			TestUtils::Stopwatch stopwatch;
+			queue.push(i);
+			while (executedCount < expectedCount) {
+				std::this_thread::yield();
+			}
+			latencies.push_back(stopwatch.GetElapsedMilliseconds() * 1000.0);
+		}
+
+		isTerminated = true;
+		executorThread.join();
+
+		result.mMedianLatencyMicroseconds = GetMedian(latencies);
+		result.mAverageLatencyMicroseconds = GetAverage(latencies);
+		return result;
+	}
+
+	// Current implementation
+	Result RunBlocking() {
+		BlockingQueue<std::uint32_t> queue;
+		CompletionLatch latch;
+		std::thread executorThread([&queue, &latch]() {
+			std::uint32_t commandLists[8U];
+			std::uint32_t count{ 0U };
+			while ((count = queue.WaitAndPop(commandLists, 8U)) != 0U) {
+				latch.Increment(count);
+			}
+		});
+
+		Result result;
+		const double cpuTime{ GetProcessCpuMilliseconds() };
+		std::this_thread::sleep_for(std::chrono::milliseconds(sIdleMilliseconds));
+		result.mIdleCpuMilliseconds = GetProcessCpuMilliseconds() - cpuTime;
+
+		std::vector<double> latencies;
+		latencies.reserve(sRoundCount);
+		for (std::uint32_t i = 0U; i < sRoundCount; ++i) {
+			TestUtils::Stopwatch stopwatch;
+			queue.Push(i);
+			latch.Wait(i + 1U);
+			latencies.push_back(stopwatch.GetElapsedMilliseconds() * 1000.0);
+		}
+
+		queue.Close();
+		executorThread.join();
+
+		result.mMedianLatencyMicroseconds = GetMedian(latencies);
+		result.mAverageLatencyMicroseconds = GetAverage(latencies);
+		return result;
+	}
+
+	void PrintResult(const char* name, const Result& result) noexcept {
+		std::printf(
+			"%-8s idle CPU time %7.1f ms in %u ms (%5.1f%% of a core), handoff latency median %6.2f us, average %6.2f us\n",
+			name,
+			result.mIdleCpuMilliseconds,
+			sIdleMilliseconds,
+			100.0 * result.mIdleCpuMilliseconds / sIdleMilliseconds,
+			result.mMedianLatencyMicroseconds,
+			result.mAverageLatencyMicroseconds);
+	}
+}
+
+int main() {
+	std::printf("%u hardware threads, %u handoffs\n", std::thread::hardware_concurrency(), sRoundCount);
+	PrintResult("Polling", RunPolling());
+	PrintResult("Blocking", RunBlocking());
+
+	return 0;
+}
@@ -0,0 +1,117 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <tbb/task_arena.h>
+#include <vector>
+
+#include <ResourceManager/DDSTextureParser.h>
+#include <TestUtils.h>
+#include <Utils/MemoryMappedFile.h>
+
+// Throughput of DDSTextureParser::ParseHeader() and ComputeSubresourceLayouts() over the memory mapped
+// files of external/resources/textures, and time to compute the layouts of large texture arrays
+// with all the threads (array slices in parallel) and with a single thread.
+namespace {
+	const std::uint32_t sRepetitionCount{ 2000U };
+
+	void RunResourceFiles() {
+		const std::vector<std::string> filePaths{ TestUtils::GetFilePaths(TestUtils::GetResourcesPath() + "textures", ".dds") };
+		std::vector<std::unique_ptr<MemoryMappedFile>> files;
+		std::size_t totalSize{ 0UL };
+		for (const std::string& filePath : filePaths) {
+			std::unique_ptr<MemoryMappedFile> file(new MemoryMappedFile());
+			if (file->Open(filePath.c_str()) == false) {
+				std::printf("%s cannot be opened\n", filePath.c_str());
+				continue;
+			}
+			totalSize += file->GetSize();
+			files.push_back(std::move(file));
+		}
+		if (files.empty()) {
+			std::printf("No textures found\n");
+			return;
+		}
+
+		std::vector<DDSTextureParser::SubresourceLayout> layouts;
+		std::size_t offsetSum{ 0UL };
+		const double milliseconds{ TestUtils::MeasureMinimumMilliseconds(5U, [&]() {
+			for (std::uint32_t i = 0U; i < sRepetitionCount; ++i) {
+				for (const std::unique_ptr<MemoryMappedFile>& file : files) {
+					DDSTextureParser::TextureInfo textureInfo;
+					if (DDSTextureParser::ParseHeader(file->GetData(), file->GetSize(), textureInfo) != DDSTextureParser::Result::SUCCESS) {
+						continue;
+					}
+
+					layouts.resize(static_cast<std::size_t>(textureInfo.mMipCount) * textureInfo.mArraySize);
+					std::uint32_t skippedMipCount{ 0U };
+					std::uint32_t width{ 0U };
+					std::uint32_t height{ 0U };
+					std::uint32_t depth{ 0U };
+					DDSTextureParser::ComputeSubresourceLayouts(
+						textureInfo, 0UL, file->GetSize(), layouts.data(), skippedMipCount, width, height, depth);
+					offsetSum += layouts[0U].mOffset;
+				}
+			}
+		}) };
+		if (offsetSum == 1UL) {
+			std::printf("Unexpected offset sum\n");
+		}
+
+		const double fileCount{ static_cast<double>(sRepetitionCount) * files.size() };
+		std::printf(
+			"%zu files (%.1f MB) | %.3f us/file | %.0f files/s\n",
+			files.size(),
+			totalSize / (1024.0 * 1024.0),
+			milliseconds * 1000.0 / fileCount,
+			fileCount / (milliseconds / 1000.0));
+	}
+
+	void RunTextureArray(const std::uint32_t arraySize) {
+		DDSTextureParser::TextureInfo textureInfo;
+		textureInfo.mDimension = DDSTextureParser::Dimension::TEXTURE2D;
+		textureInfo.mWidth = 1024U;
+		textureInfo.mHeight = 1024U;
+		textureInfo.mDepth = 1U;
+		textureInfo.mArraySize = arraySize;
+		textureInfo.mMipCount = 11U;
+		textureInfo.mFormat = DXGI_FORMAT_BC7_UNORM;
+		textureInfo.mDataOffset = sizeof(std::uint32_t) + sizeof(DDS_HEADER) + sizeof(DDS_HEADER_DXT10);
+
+		// Layouts are computed from the header: the file data is never read
+		const std::size_t fileSize{ ~static_cast<std::size_t>(0UL) };
+		std::vector<DDSTextureParser::SubresourceLayout> layouts(static_cast<std::size_t>(textureInfo.mMipCount) * arraySize);
+		const auto computeLayouts = [&]() {
+			std::uint32_t skippedMipCount{ 0U };
+			std::uint32_t width{ 0U };
+			std::uint32_t height{ 0U };
+			std::uint32_t depth{ 0U };
+			DDSTextureParser::ComputeSubresourceLayouts(
+				textureInfo, 0UL, fileSize, layouts.data(), skippedMipCount, width, height, depth);
+		};
+
+		const double parallelMilliseconds{ TestUtils::MeasureMinimumMilliseconds(20U, computeLayouts) };
+		double serialMilliseconds{ 0.0 };
+		tbb::task_arena singleThreadArena(1);
+		singleThreadArena.execute([&]() {
+			serialMilliseconds = TestUtils::MeasureMinimumMilliseconds(20U, computeLayouts);
+		});
+
+		std::printf(
+			"%4u array slices x %u mips | all threads %8.4f ms | 1 thread %8.4f ms\n",
+			arraySize,
+			textureInfo.mMipCount,
+			parallelMilliseconds,
+			serialMilliseconds);
+	}
+}
+
+int main() {
+	RunResourceFiles();
+	for (const std::uint32_t arraySize : { 6U, 64U, 512U, 2048U }) {
+		RunTextureArray(arraySize);
+	}
+
+	return 0;
+}
@@ -0,0 +1,79 @@
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include <DescriptorManager/DescriptorAllocator.h>
+#include <TestUtils.h>
+
+// Throughput of single descriptors allocations and frees (lock-free free list) against
+// allocations and frees of ranges of one descriptor (first-fit under a mutex),
+// with several threads creating and destroying views while a thread releases completed frees.
+namespace {
+	const std::uint32_t sCapacity{ 16384U };
+	const std::uint32_t sOperationCountPerThread{ 200000U };
+	const std::uint32_t sDescriptorsPerThread{ 256U };
+
+	double Run(const std::uint32_t threadCount, const bool useRanges) {
+		DescriptorAllocator allocator(sCapacity);
+		std::atomic<std::uint64_t> fenceValue{ 1UL };
+		std::atomic<bool> isTerminated{ false };
+
+		TestUtils::Stopwatch stopwatch;
+		std::vector<std::thread> threads;
+		for (std::uint32_t i = 0U; i < threadCount; ++i) {
+			threads.emplace_back([&allocator, &fenceValue, useRanges]() {
+				std::vector<std::uint32_t> descriptorIndices;
+				descriptorIndices.reserve(sDescriptorsPerThread);
+				for (std::uint32_t j = 0U; j < sOperationCountPerThread; ++j) {
+					if (descriptorIndices.size() < sDescriptorsPerThread) {
+						const std::uint32_t descriptorIndex{ useRanges ? allocator.AllocateRange(1U) : allocator.Allocate() };
+						if (descriptorIndex != DescriptorAllocator::sInvalidIndex) {
+							descriptorIndices.push_back(descriptorIndex);
+						}
+					} else {
+						for (const std::uint32_t descriptorIndex : descriptorIndices) {
+							if (useRanges) {
+								allocator.FreeRange(descriptorIndex, 1U, fenceValue.load());
+							} else {
+								allocator.Free(descriptorIndex, fenceValue.load());
+							}
+						}
+						descriptorIndices.clear();
+					}
+				}
+			});
+		}
+
+		std::thread releaseThread([&allocator, &fenceValue, &isTerminated]() {
+			while (isTerminated == false) {
+				const std::uint64_t completedFenceValue{ fenceValue.fetch_add(1UL) };
+				allocator.ReleaseCompletedFrees(completedFenceValue - 1UL);
+				std::this_thread::yield();
+			}
+		});
+
+		for (std::thread& thread : threads) {
+			thread.join();
+		}
+		const double milliseconds{ stopwatch.GetElapsedMilliseconds() };
+		isTerminated = true;
+		releaseThread.join();
+
+		return static_cast<double>(threadCount) * sOperationCountPerThread / (milliseconds * 1000.0);
+	}
+}
+
+int main() {
+	std::printf("%u hardware threads, %u operations per thread\n", std::thread::hardware_concurrency(), sOperationCountPerThread);
+	for (const std::uint32_t threadCount : { 1U, 2U, 4U }) {
+		std::printf(
+			"%u threads: free list %7.2f M operations/s, ranges %7.2f M operations/s\n",
+			threadCount,
+			Run(threadCount, false),
+			Run(threadCount, true));
+	}
+
+	return 0;
+}
@@ -0,0 +1,57 @@
+#include <cstdint>
+#include <cstdio>
+#include <random>
+
+#include <RenderManager/FrameGraph.h>
+#include <TestUtils.h>
+
+// Time to build and compile frame graphs with many passes. Each pass reads
+// a few resources written by previous passes and writes new ones, and
+// passes are declared in reverse order to exercise the topological sort.
+namespace {
+	const std::uint32_t sReadCountPerPass{ 3U };
+	const std::uint32_t sRepetitionCount{ 20U };
+
+	void BuildGraph(FrameGraph& frameGraph, const std::uint32_t passCount) {
+		std::mt19937 generator(1U);
+		// The output is written by the last pass in execution order, so only the passes
+		// it depends on are executed
+		for (std::uint32_t i = 0U; i < passCount; ++i) {
+			frameGraph.AddResource(0x4U, i == 0U);
+		}
+
+		// The i-th pass in execution order writes a resource and reads resources written by passes before it
+		for (std::uint32_t i = 0U; i < passCount; ++i) {
+			frameGraph.AddPass(false);
+		}
+		for (std::uint32_t i = 0U; i < passCount; ++i) {
+			const std::uint32_t passIndex{ passCount - 1U - i };
+			std::uint32_t previousReadResource{ 0xFFFFFFFFU };
+			for (std::uint32_t j = 0U; j < sReadCountPerPass && i > 0U; ++j) {
+				const std::uint32_t readResource{ static_cast<std::uint32_t>(generator() % i) };
+				if (readResource != previousReadResource) {
+					frameGraph.ReadResource(passIndex, passCount - 1U - readResource, 0x80U);
+					previousReadResource = readResource;
+				}
+			}
+			frameGraph.WriteResource(passIndex, passIndex, 0x4U);
+		}
+	}
+}
+
+int main() {
+	for (std::uint32_t passCount = 8U; passCount <= 8192U; passCount *= 4U) {
+		std::uint32_t executedPassCount{ 0U };
+		const double time{ TestUtils::MeasureMinimumMilliseconds(sRepetitionCount, [&]() {
+			FrameGraph frameGraph;
+			BuildGraph(frameGraph, passCount);
+			frameGraph.Compile();
+			executedPassCount = static_cast<std::uint32_t>(frameGraph.GetExecutionOrder().size());
+		}) };
+
+		std::printf("%5u passes (%5u executed): build and compile %8.3f ms (%6.2f us per pass)\n",
+			passCount, executedPassCount, time, time * 1000.0 / passCount);
+	}
+
+	return 0;
+}
@@ -0,0 +1,67 @@
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include <MathUtils/FrustumCulling.h>
+#include <TestUtils.h>
+
+using namespace DirectX;
+
+// Time to cull the instances of a large scene: spheres tested one at a time
+// (IsSphereInsideFrustum()) and 4 at a time (CullSpheres()).
+// DirectXMath is a scalar stand-in on platforms without the Windows SDK, so
+// the SIMD speedup must be measured on Windows.
+namespace {
+	const std::uint32_t sSphereCount{ 100000U };
+	const std::uint32_t sRepetitionCount{ 20U };
+}
+
+int main() {
+	const float height{ 1.0f / std::tan(0.25f * 3.14159265f) };
+	const float range{ 1000.0f / (1000.0f - 1.0f) };
+	const XMFLOAT4X4 viewMatrix(
+		1.0f, 0.0f, 0.0f, 0.0f,
+		0.0f, 1.0f, 0.0f, 0.0f,
+		0.0f, 0.0f, 1.0f, 0.0f,
+		0.0f, 0.0f, 0.0f, 1.0f);
+	const XMFLOAT4X4 projectionMatrix(
+		height, 0.0f, 0.0f, 0.0f,
+		0.0f, height, 0.0f, 0.0f,
+		0.0f, 0.0f, range, 1.0f,
+		0.0f, 0.0f, -range, 0.0f);
+	FrustumCulling::FrustumPlanes frustumPlanes;
+	FrustumCulling::ExtractFrustumPlanes(viewMatrix, projectionMatrix, frustumPlanes);
+
+	// Instances all around the camera, so most of them are culled
+	std::mt19937 generator(1U);
+	std::uniform_real_distribution<float> positionDistribution(-500.0f, 500.0f);
+	std::uniform_real_distribution<float> radiusDistribution(0.5f, 5.0f);
+	std::vector<BoundingSphere> spheres(sSphereCount);
+	for (BoundingSphere& sphere : spheres) {
+		sphere.Center = XMFLOAT3(positionDistribution(generator), positionDistribution(generator), positionDistribution(generator));
+		sphere.Radius = radiusDistribution(generator);
+	}
+	std::vector<std::uint8_t> visibilityFlags(sSphereCount);
+
+	std::uint32_t visibleCount{ 0U };
+	const double oneAtATimeTime{ TestUtils::MeasureMinimumMilliseconds(sRepetitionCount, [&]() {
+		visibleCount = 0U;
+		for (std::uint32_t i = 0U; i < sSphereCount; ++i) {
+			visibilityFlags[i] = static_cast<std::uint8_t>(FrustumCulling::IsSphereInsideFrustum(frustumPlanes, spheres[i]));
+			visibleCount += visibilityFlags[i];
+		}
+	}) };
+	const std::uint32_t oneAtATimeVisibleCount{ visibleCount };
+
+	const double groupedTime{ TestUtils::MeasureMinimumMilliseconds(sRepetitionCount, [&]() {
+		visibleCount = FrustumCulling::CullSpheres(frustumPlanes, spheres.data(), sSphereCount, visibilityFlags.data());
+	}) };
+
+	std::printf("%u spheres, %u visible (%u)\n", sSphereCount, visibleCount, oneAtATimeVisibleCount);
+	std::printf("IsSphereInsideFrustum %8.3f ms (%5.2f ns per sphere)\n", oneAtATimeTime, oneAtATimeTime * 1.0e6 / sSphereCount);
+	std::printf("CullSpheres           %8.3f ms (%5.2f ns per sphere)\n", groupedTime, groupedTime * 1.0e6 / sSphereCount);
+
+	return 0;
+}
@@ -0,0 +1,38 @@
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include <TestUtils.h>
+#include <Utils/HashUtils.h>
+
+// Throughput of HashUtils::HashData() for the sizes of the keys of shared resources:
+// small (built-in geometry parameters and file paths) and large (vertex and index buffers, file contents).
+namespace {
+	const std::uint64_t sTotalByteCount{ 1024UL * 1024UL * 1024UL };
+}
+
+int main() {
+	std::vector<std::uint8_t> data(64UL * 1024UL * 1024UL);
+	for (std::size_t i = 0UL; i < data.size(); ++i) {
+		data[i] = static_cast<std::uint8_t>(i * 2654435761U >> 13U);
+	}
+
+	for (const std::size_t size : { 16UL, 64UL, 1024UL, 64UL * 1024UL, 64UL * 1024UL * 1024UL }) {
+		const std::uint64_t repetitionCount{ sTotalByteCount / size };
+		std::uint64_t hash{ 0UL };
+		const double milliseconds{ TestUtils::MeasureMinimumMilliseconds(3U, [&data, &hash, size, repetitionCount]() {
+			for (std::uint64_t i = 0UL; i < repetitionCount; ++i) {
+				hash = HashUtils::HashData(data.data() + (i * 64UL) % (data.size() - size + 1UL), size, hash);
+			}
+		}) };
+
+		std::printf(
+			"%10zu bytes: %7.2f GB/s, %8.1f ns per hash (%016llx)\n",
+			size,
+			static_cast<double>(sTotalByteCount) / (milliseconds * 1.0e6),
+			milliseconds * 1.0e6 / static_cast<double>(repetitionCount),
+			static_cast<unsigned long long>(hash));
+	}
+
+	return 0;
+}
@@ -0,0 +1,59 @@
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <MeshTestUtils.h>
+#include <ModelManager/MeshOptimizer.h>
+#include <TestUtils.h>
+
+// Vertex cache efficiency (ACMR and ATVR, see MeshOptimizer::VertexCacheStatistics) of the models in
+// external/resources/models, in the order of the file and shuffled, before and after OptimizeMesh(),
+// with the time it takes.
+namespace {
+	void Run(const std::string& name, const GeometryGenerator::MeshData& sourceMeshData) {
+		const MeshOptimizer::VertexCacheStatistics statisticsBefore{
+			MeshOptimizer::AnalyzeVertexCache(
+				sourceMeshData.mIndices32.data(), 
+				sourceMeshData.mIndices32.size(), 
+				sourceMeshData.mVertices.size()) };
+
+		GeometryGenerator::MeshData meshData;
+		const double milliseconds{ TestUtils::MeasureMinimumMilliseconds(3U, [&meshData, &sourceMeshData]() {
+			// Vertex is not copy assignable
+			std::vector<GeometryGenerator::Vertex> vertices(sourceMeshData.mVertices);
+			meshData.mVertices.swap(vertices);
+			meshData.mIndices32 = sourceMeshData.mIndices32;
+			MeshOptimizer::OptimizeMesh(meshData);
+		}) };
+		const MeshOptimizer::VertexCacheStatistics statisticsAfter{
+			MeshOptimizer::AnalyzeVertexCache(meshData.mIndices32.data(), meshData.mIndices32.size(), meshData.mVertices.size()) };
+
+		std::printf(
+			"%-28s %7zu triangles | ACMR %.3f -> %.3f | ATVR %.3f -> %.3f | %8.2f ms\n",
+			name.c_str(),
+			sourceMeshData.mIndices32.size() / 3UL,
+			statisticsBefore.mAcmr,
+			statisticsAfter.mAcmr,
+			statisticsBefore.mAtvr,
+			statisticsAfter.mAtvr,
+			milliseconds);
+	}
+}
+
+int main() {
+	for (const std::string& modelFilePath : MeshTestUtils::GetModelFilePaths()) {
+		GeometryGenerator::MeshData meshData;
+		if (MeshTestUtils::ReadObjFile(modelFilePath, meshData) == false) {
+			std::printf("%s cannot be read\n", modelFilePath.c_str());
+			continue;
+		}
+
+		const std::string name{ modelFilePath.substr(modelFilePath.find_last_of("/\\") + 1UL) };
+		Run(name, meshData);
+		MeshTestUtils::ShuffleTriangles(meshData.mIndices32, 1U);
+		Run(name + " (shuffled)", meshData);
+	}
+
+	return 0;
+}
@@ -0,0 +1,55 @@
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <MeshTestUtils.h>
+#include <ModelManager/MeshOptimizer.h>
+#include <ModelManager/MeshSimplifier.h>
+#include <TestUtils.h>
+
+// Levels of detail that MeshSimplifier::GenerateLods() builds for the models in external/resources/models:
+// their triangle count, relative error and ACMR, and the time it takes to build them.
+int main() {
+	for (const std::string& modelFilePath : MeshTestUtils::GetModelFilePaths()) {
+		GeometryGenerator::MeshData sourceMeshData;
+		if (MeshTestUtils::ReadObjFile(modelFilePath, sourceMeshData) == false) {
+			std::printf("%s cannot be read\n", modelFilePath.c_str());
+			continue;
+		}
+		MeshOptimizer::OptimizeMesh(sourceMeshData);
+
+		GeometryGenerator::MeshData meshData;
+		std::vector<MeshLod> lods;
+		const double milliseconds{ TestUtils::MeasureMinimumMilliseconds(3U, [&meshData, &sourceMeshData, &lods]() {
+			// Vertex is not copy assignable
+			std::vector<GeometryGenerator::Vertex> vertices(sourceMeshData.mVertices);
+			meshData.mVertices.swap(vertices);
+			meshData.mIndices32 = sourceMeshData.mIndices32;
+			lods.clear();
+			MeshSimplifier::GenerateLods(meshData, lods);
+		}) };
+
+		std::printf(
+			"%s: %zu vertices, %zu levels of detail in %.2f ms\n",
+			modelFilePath.substr(modelFilePath.find_last_of("/\\") + 1UL).c_str(),
+			meshData.mVertices.size(),
+			lods.size(),
+			milliseconds);
+		for (std::size_t i = 0UL; i < lods.size(); ++i) {
+			const MeshOptimizer::VertexCacheStatistics statistics{
+				MeshOptimizer::AnalyzeVertexCache(
+					meshData.mIndices32.data() + lods[i].mFirstIndex,
+					lods[i].mIndexCount,
+					meshData.mVertices.size()) };
+			std::printf(
+				"  level %zu: %7u triangles, error %.4f, ACMR %.3f\n",
+				i,
+				lods[i].mIndexCount / 3U,
+				lods[i].mError,
+				statistics.mAcmr);
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,126 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <GeometryPass/MeshletCuller.h>
+#include <MeshTestUtils.h>
+#include <ModelManager/MeshletBuilder.h>
+#include <TestUtils.h>
+
+using namespace DirectX;
+
+// Time to build the meshlets of the models in external/resources/models and to cull them, and
+// the draw calls and triangles of a batch of instances seen from random eye positions, recorded
+// per instance (a root view and a DrawIndexedInstanced() per visible index range of each instance)
+// and per batch (like GeometryPassCmdListRecorder::RecordMeshletDrawCalls(): the merged index
+// ranges of all the instances drawn instanced, or the whole mesh if they need more than 16 draw calls).
+namespace {
+	const std::uint32_t sInstanceCount{ 64U };
+	const std::uint32_t sMaxMeshletDrawCallCount{ 16U };
+
+	void Run(const std::string& name, GeometryGenerator::MeshData& meshData) {
+		std::vector<Meshlet> meshlets;
+		const std::vector<std::uint32_t> sourceIndices{ meshData.mIndices32 };
+		const double buildMilliseconds{ TestUtils::MeasureMinimumMilliseconds(3U, [&meshData, &meshlets, &sourceIndices]() {
+			meshData.mIndices32 = sourceIndices;
+			MeshletBuilder::BuildMeshlets(meshData, meshData.mIndices32.size(), meshlets);
+		}) };
+		if (meshlets.empty()) {
+			std::printf("%-16s %7zu triangles | no meshlets\n", name.c_str(), sourceIndices.size() / 3UL);
+			return;
+		}
+
+		MeshletCuller::MeshletBounds meshletBounds;
+		MeshletCuller::InitMeshletBounds(meshlets.data(), meshlets.size(), meshletBounds);
+		float extent{ 0.0f };
+		for (const GeometryGenerator::Vertex& vertex : meshData.mVertices) {
+			extent = std::max<float>(extent, std::abs(vertex.mPosition.x));
+			extent = std::max<float>(extent, std::abs(vertex.mPosition.y));
+			extent = std::max<float>(extent, std::abs(vertex.mPosition.z));
+		}
+
+		// Only back face culling, with each instance seen from a different direction
+		// (like instances around the camera)
+		XMFLOAT4 frustumPlanes[6U];
+		for (XMFLOAT4& frustumPlane : frustumPlanes) {
+			frustumPlane = XMFLOAT4(0.0f, 0.0f, 0.0f, 1.0f);
+		}
+		std::mt19937 generator(3U);
+		std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+		std::vector<XMFLOAT3> eyePositions(sInstanceCount);
+		for (XMFLOAT3& eyePosition : eyePositions) {
+			eyePosition = XMFLOAT3(
+				distribution(generator) * extent * 3.0f,
+				distribution(generator) * extent * 3.0f,
+				distribution(generator) * extent * 3.0f);
+		}
+
+		std::vector<std::uint8_t> visibilityFlags(meshlets.size());
+		std::vector<MeshletCuller::IndexRange> indexRanges;
+		std::uint32_t perInstanceDrawCallCount{ 0U };
+		std::uint64_t perInstanceTriangleCount{ 0UL };
+		const double cullMilliseconds{ TestUtils::MeasureMinimumMilliseconds(5U, [&]() {
+			indexRanges.clear();
+			perInstanceDrawCallCount = 0U;
+			perInstanceTriangleCount = 0UL;
+			for (const XMFLOAT3& eyePosition : eyePositions) {
+				MeshletCuller::CullMeshlets(meshletBounds, frustumPlanes, eyePosition, visibilityFlags.data());
+				const std::size_t firstRange{ indexRanges.size() };
+				perInstanceDrawCallCount += MeshletCuller::AppendIndexRanges(meshletBounds, visibilityFlags.data(), indexRanges);
+				for (std::size_t i = firstRange; i < indexRanges.size(); ++i) {
+					perInstanceTriangleCount += indexRanges[i].mIndexCount / 3U;
+				}
+			}
+		}) };
+
+		const std::uint32_t mergedRangeCount{ MeshletCuller::MergeIndexRanges(0UL, indexRanges) };
+		std::uint32_t perBatchDrawCallCount{ 1U };
+		std::uint64_t perBatchTriangleCount{ sInstanceCount * (sourceIndices.size() / 3UL) };
+		if (mergedRangeCount <= sMaxMeshletDrawCallCount) {
+			perBatchDrawCallCount = mergedRangeCount;
+			perBatchTriangleCount = 0UL;
+			for (const MeshletCuller::IndexRange& indexRange : indexRanges) {
+				perBatchTriangleCount += static_cast<std::uint64_t>(sInstanceCount) * (indexRange.mIndexCount / 3U);
+			}
+		}
+
+		std::printf(
+			"%-16s %7zu triangles | %5zu meshlets | build %8.2f ms | cull %6.1f ns/meshlet\n"
+			"%-16s per instance: %5u draws, %3u root views, %9llu triangles | per batch: %2u draws, 1 root view, %9llu triangles\n",
+			name.c_str(),
+			sourceIndices.size() / 3UL,
+			meshlets.size(),
+			buildMilliseconds,
+			cullMilliseconds * 1.0e6 / static_cast<double>(meshlets.size() * sInstanceCount),
+			"",
+			perInstanceDrawCallCount,
+			sInstanceCount,
+			static_cast<unsigned long long>(perInstanceTriangleCount),
+			perBatchDrawCallCount,
+			static_cast<unsigned long long>(perBatchTriangleCount));
+	}
+}
+
+int main() {
+	std::printf("%u instances per batch\n", sInstanceCount);
+
+	GeometryGenerator::MeshData gridMeshData;
+	MeshTestUtils::CreateGrid(128U, 128U, gridMeshData);
+	Run("grid", gridMeshData);
+
+	for (const std::string& modelFilePath : MeshTestUtils::GetModelFilePaths()) {
+		GeometryGenerator::MeshData meshData;
+		if (MeshTestUtils::ReadObjFile(modelFilePath, meshData) == false) {
+			std::printf("%s cannot be read\n", modelFilePath.c_str());
+			continue;
+		}
+
+		Run(modelFilePath.substr(modelFilePath.find_last_of("/\\") + 1UL), meshData);
+	}
+
+	return 0;
+}
@@ -0,0 +1,95 @@
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <ResourceManager/BlockCompressor.h>
+#include <ResourceManager/MipGenerator.h>
+#include <TestUtils.h>
+#include <TextureTestUtils.h>
+
+// Time to generate all the mips of an image (in millions of source texels per second) with the box
+// and the Kaiser filters, for random images of several formats, and for the images of 
+// external/resources/textures as RGBA8 sRGB (like the textures the DDS loader completes) and as BC1.
+namespace {
+	void Run(
+		const char* name,
+		const std::uint8_t* source,
+		const std::uint32_t sliceCount,
+		const std::size_t sliceSize,
+		const std::uint32_t width,
+		const std::uint32_t height,
+		const DXGI_FORMAT format)
+	{
+		std::vector<const std::uint8_t*> sourceSlices;
+		for (std::uint32_t i = 0U; i < sliceCount; ++i) {
+			sourceSlices.push_back(source + i * sliceSize);
+		}
+		const std::uint32_t mipCount{ MipGenerator::GetFullMipCount(width, height) - 1U };
+		std::vector<std::uint8_t> mips(sliceCount * MipGenerator::GetMipsSize(width, height, format, mipCount));
+
+		double milliseconds[2U];
+		const MipGenerator::Filter filters[2U]{ MipGenerator::Filter::BOX, MipGenerator::Filter::KAISER };
+		for (std::uint32_t i = 0U; i < 2U; ++i) {
+			milliseconds[i] = TestUtils::MeasureMinimumMilliseconds(3U, [&]() {
+				MipGenerator::GenerateMips(sourceSlices.data(), sliceCount, width, height, format, filters[i], mipCount, mips.data());
+			});
+		}
+
+		const double texelCount{ static_cast<double>(width) * height * sliceCount };
+		std::printf(
+			"%-24s %4ux%-4u x%u | box %8.2f ms %7.1f Mtexels/s | kaiser %8.2f ms %7.1f Mtexels/s\n",
+			name,
+			width,
+			height,
+			sliceCount,
+			milliseconds[0U],
+			texelCount / (milliseconds[0U] * 1000.0),
+			milliseconds[1U],
+			texelCount / (milliseconds[1U] * 1000.0));
+	}
+
+	void RunRandomImage(
+		const char* name,
+		const std::uint32_t width,
+		const std::uint32_t height,
+		const std::uint32_t sliceCount,
+		const DXGI_FORMAT format,
+		const std::size_t sliceSize)
+	{
+		std::mt19937 generator(3U);
+		std::vector<std::uint8_t> source(sliceSize * sliceCount);
+		for (std::uint8_t& value : source) {
+			value = static_cast<std::uint8_t>(generator());
+		}
+
+		// Random bits are not valid floats
+		if (format == DXGI_FORMAT_R32G32B32A32_FLOAT) {
+			float* values{ reinterpret_cast<float*>(source.data()) };
+			for (std::size_t i = 0UL; i < source.size() / sizeof(float); ++i) {
+				values[i] = static_cast<float>(generator() % 1024U) / 1024.0f;
+			}
+		}
+
+		Run(name, source.data(), sliceCount, sliceSize, width, height, format);
+	}
+}
+
+int main() {
+	RunRandomImage("RGBA8", 2048U, 2048U, 1U, DXGI_FORMAT_R8G8B8A8_UNORM, 2048UL * 2048UL * 4UL);
+	RunRandomImage("RGBA8 sRGB", 2048U, 2048U, 1U, DXGI_FORMAT_R8G8B8A8_UNORM_SRGB, 2048UL * 2048UL * 4UL);
+	RunRandomImage("R8", 2048U, 2048U, 1U, DXGI_FORMAT_R8_UNORM, 2048UL * 2048UL);
+	RunRandomImage("RGBA32F cube map", 128U, 128U, 6U, DXGI_FORMAT_R32G32B32A32_FLOAT, 128UL * 128UL * 16UL);
+
+	for (const TextureTestUtils::Image& image : TextureTestUtils::ReadResourceImages(0U)) {
+		Run(image.mName.c_str(), image.mTexels.data(), 1U, image.mTexels.size(), image.mWidth, image.mHeight, DXGI_FORMAT_R8G8B8A8_UNORM_SRGB);
+
+		std::vector<std::uint8_t> blocks(BlockCompressor::GetCompressedSize(image.mWidth, image.mHeight, BlockCompressor::Format::BC1));
+		BlockCompressor::CompressImage(image.mTexels.data(), image.mWidth, image.mHeight, image.mWidth * 4UL, BlockCompressor::Format::BC1, blocks.data());
+		const std::string name{ image.mName + " (BC1)" };
+		Run(name.c_str(), blocks.data(), 1U, blocks.size(), image.mWidth, image.mHeight, DXGI_FORMAT_BC1_UNORM);
+	}
+
+	return 0;
+}
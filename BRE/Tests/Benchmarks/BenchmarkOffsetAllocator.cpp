@@ -0,0 +1,139 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <map>
+#include <random>
+#include <vector>
+
+#include <ResourceManager/OffsetAllocator.h>
+#include <TestUtils.h>
+
+// Churn of mesh sized ranges (64 to 64K elements) in a pool of 16M elements, like the vertex
+// and index buffer pools of VertexAndIndexBufferCreator: time per operation, allocations that
+// do not fit and fragmentation of OffsetAllocator (best fit), against a first fit free list.
+namespace {
+	const std::uint32_t sCapacity{ 16U << 20U };
+	const std::uint32_t sOperationCount{ 200000U };
+
+	// First fit over free ranges sorted by offset, with merging of neighbors
+	class FirstFitAllocator {
+	public:
+		explicit FirstFitAllocator(const std::uint32_t capacity) {
+			mFreeRanges.emplace(0U, capacity);
+			mFreeSize = capacity;
+		}
+
+		std::uint32_t Allocate(const std::uint32_t elementCount) noexcept {
+			for (std::map<std::uint32_t, std::uint32_t>::iterator it = mFreeRanges.begin(); it != mFreeRanges.end(); ++it) {
+				if (it->second < elementCount) {
+					continue;
+				}
+
+				const std::uint32_t offset{ it->first };
+				const std::uint32_t remainingCount{ it->second - elementCount };
+				mFreeRanges.erase(it);
+				if (remainingCount > 0U) {
+					mFreeRanges.emplace(offset + elementCount, remainingCount);
+				}
+				mFreeSize -= elementCount;
+
+				return offset;
+			}
+
+			return OffsetAllocator::sInvalidOffset;
+		}
+
+		void Free(std::uint32_t offset, std::uint32_t elementCount) noexcept {
+			mFreeSize += elementCount;
+			std::map<std::uint32_t, std::uint32_t>::iterator next = mFreeRanges.lower_bound(offset);
+			if (next != mFreeRanges.end() && offset + elementCount == next->first) {
+				elementCount += next->second;
+				next = mFreeRanges.erase(next);
+			}
+			if (next != mFreeRanges.begin()) {
+				std::map<std::uint32_t, std::uint32_t>::iterator previous = std::prev(next);
+				if (previous->first + previous->second == offset) {
+					previous->second += elementCount;
+					return;
+				}
+			}
+			mFreeRanges.emplace(offset, elementCount);
+		}
+
+		float GetFragmentation() const noexcept {
+			std::uint32_t largestFreeRangeSize{ 0U };
+			for (const std::pair<const std::uint32_t, std::uint32_t>& freeRange : mFreeRanges) {
+				largestFreeRangeSize = std::max<std::uint32_t>(largestFreeRangeSize, freeRange.second);
+			}
+
+			return mFreeSize == 0U ? 0.0f : 1.0f - static_cast<float>(largestFreeRangeSize) / static_cast<float>(mFreeSize);
+		}
+
+	private:
+		std::map<std::uint32_t, std::uint32_t> mFreeRanges;
+		std::uint32_t mFreeSize{ 0U };
+	};
+
+	struct Range {
+		std::uint32_t mOffset;
+		std::uint32_t mElementCount;
+	};
+
+	template<typename Allocator>
+	void Run(const char* name) {
+		Allocator allocator(sCapacity);
+		std::mt19937 generator(1U);
+		std::uniform_int_distribution<std::uint32_t> sizeDistribution(64U, 64U * 1024U);
+		std::vector<Range> ranges;
+		std::uint32_t failedAllocationCount{ 0U };
+		std::uint64_t allocatedSize{ 0UL };
+		double fragmentationSum{ 0.0 };
+		std::uint32_t fragmentationSampleCount{ 0U };
+		double milliseconds{ 0.0 };
+		for (std::uint32_t i = 0U; i < sOperationCount; ++i) {
+			// Keep the pool around 75% full
+			const bool allocates{ ranges.empty() || generator() % 100U < (allocatedSize < sCapacity * 3UL / 4UL ? 60U : 40U) };
+			TestUtils::Stopwatch stopwatch;
+			if (allocates) {
+				const std::uint32_t elementCount{ sizeDistribution(generator) };
+				const std::uint32_t offset{ allocator.Allocate(elementCount) };
+				milliseconds += stopwatch.GetElapsedMilliseconds();
+				if (offset == OffsetAllocator::sInvalidOffset) {
+					++failedAllocationCount;
+					continue;
+				}
+				ranges.push_back(Range{ offset, elementCount });
+				allocatedSize += elementCount;
+			} else {
+				const std::size_t rangeIndex{ generator() % ranges.size() };
+				const Range range{ ranges[rangeIndex] };
+				ranges[rangeIndex] = ranges.back();
+				ranges.pop_back();
+				allocator.Free(range.mOffset, range.mElementCount);
+				milliseconds += stopwatch.GetElapsedMilliseconds();
+				allocatedSize -= range.mElementCount;
+			}
+
+			if (i % 1000U == 0U) {
+				fragmentationSum += allocator.GetFragmentation();
+				++fragmentationSampleCount;
+			}
+		}
+
+		std::printf(
+			"%-10s %7.1f ns/operation | %5u failed allocations | average fragmentation %.3f\n",
+			name,
+			milliseconds * 1.0e6 / sOperationCount,
+			failedAllocationCount,
+			fragmentationSum / fragmentationSampleCount);
+	}
+}
+
+int main() {
+	std::printf("%u operations, pool of %u elements\n", sOperationCount, sCapacity);
+	Run<OffsetAllocator>("best fit");
+	Run<FirstFitAllocator>("first fit");
+
+	return 0;
+}
@@ -0,0 +1,145 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <istream>
+#include <streambuf>
+#include <string>
+#include <tbb/task_arena.h>
+#include <vector>
+
+#include <MeshTestUtils.h>
+#include <ResourceManager/DDSTextureParser.h>
+#include <TestUtils.h>
+#include <Utils/MemoryMappedFile.h>
+#include <Utils/ParallelFileLoader.h>
+
+// Time to map and parse the DDS files and the models of external/resources, one after the other
+// in the calling thread (MemoryMappedFile) and in parallel TBB tasks (ParallelFileLoader), as
+// TextureManager and ModelManager load them. DDS files are parsed (header and subresource layouts)
+// and their data is copied (as to an upload buffer), and models (OBJ) are parsed to mesh data.
+// Files are read once before measuring, so they are in the file cache and the numbers
+// measure mapping and parsing, not the disk.
+namespace {
+	const std::uint32_t sRepetitionCount{ 5U };
+
+	// Read only stream over the file data, so models are parsed without copying it
+	class MemoryStreamBuffer : public std::streambuf {
+	public:
+		MemoryStreamBuffer(const std::uint8_t* data, const std::size_t dataSize) {
+			char* begin{ const_cast<char*>(reinterpret_cast<const char*>(data)) };
+			setg(begin, begin, begin + dataSize);
+		}
+	};
+
+	// Returns the number of bytes of the parsed texture or model (0 if it cannot be parsed)
+	std::size_t ParseFile(const std::uint8_t* fileData, const std::size_t fileDataSize, std::vector<std::uint8_t>& uploadData) {
+		DDSTextureParser::TextureInfo textureInfo;
+		if (DDSTextureParser::ParseHeader(fileData, fileDataSize, textureInfo) == DDSTextureParser::Result::SUCCESS) {
+			std::vector<DDSTextureParser::SubresourceLayout> layouts(static_cast<std::size_t>(textureInfo.mMipCount) * textureInfo.mArraySize);
+			std::uint32_t skippedMipCount{ 0U };
+			std::uint32_t width{ 0U };
+			std::uint32_t height{ 0U };
+			std::uint32_t depth{ 0U };
+			if (DDSTextureParser::ComputeSubresourceLayouts(
+				textureInfo, 0UL, fileDataSize, layouts.data(), skippedMipCount, width, height, depth) != DDSTextureParser::Result::SUCCESS) {
+				return 0UL;
+			}
+
+			const std::size_t textureDataSize{ fileDataSize - textureInfo.mDataOffset };
+			uploadData.resize(textureDataSize);
+			std::memcpy(uploadData.data(), fileData + textureInfo.mDataOffset, textureDataSize);
+			return textureDataSize;
+		}
+
+		MemoryStreamBuffer streamBuffer(fileData, fileDataSize);
+		std::istream stream(&streamBuffer);
+		GeometryGenerator::MeshData meshData;
+		if (MeshTestUtils::ReadObj(stream, meshData) == false) {
+			return 0UL;
+		}
+
+		return sizeof(GeometryGenerator::Vertex) * meshData.mVertices.size() + sizeof(std::uint32_t) * meshData.mIndices32.size();
+	}
+
+	// Returns the size of the parsed data of all the files
+	std::size_t LoadSerially(const std::vector<std::string>& filePaths) {
+		std::vector<std::uint8_t> uploadData;
+		std::size_t parsedSize{ 0UL };
+		for (const std::string& filePath : filePaths) {
+			MemoryMappedFile file;
+			if (file.Open(filePath.c_str())) {
+				parsedSize += ParseFile(file.GetData(), file.GetSize(), uploadData);
+			}
+		}
+
+		return parsedSize;
+	}
+
+	std::size_t LoadInParallel(const std::vector<std::string>& filePaths) {
+		std::vector<std::size_t> parsedSizes(filePaths.size(), 0UL);
+		ParallelFileLoader loader;
+		loader.Load(filePaths, [&parsedSizes](const std::size_t fileIndex, const std::uint8_t* fileData, const std::size_t fileDataSize) {
+			std::vector<std::uint8_t> uploadData;
+			parsedSizes[fileIndex] = ParseFile(fileData, fileDataSize, uploadData);
+		});
+		loader.Wait();
+
+		std::size_t parsedSize{ 0UL };
+		for (const std::size_t fileParsedSize : parsedSizes) {
+			parsedSize += fileParsedSize;
+		}
+
+		return parsedSize;
+	}
+
+	void Run(const char* name, const std::vector<std::string>& filePaths) {
+		std::size_t fileSize{ 0UL };
+		for (const std::string& filePath : filePaths) {
+			MemoryMappedFile file;
+			if (file.Open(filePath.c_str()) == false) {
+				std::printf("%s cannot be opened\n", filePath.c_str());
+				return;
+			}
+			fileSize += file.GetSize();
+		}
+
+		// Warm up the file cache and check both loads parse the same data
+		const std::size_t parsedSize{ LoadSerially(filePaths) };
+		if (LoadInParallel(filePaths) != parsedSize) {
+			std::printf("%s: serial and parallel loads parsed different data\n", name);
+			return;
+		}
+
+		const double serialMilliseconds{ TestUtils::MeasureMinimumMilliseconds(sRepetitionCount, [&]() { LoadSerially(filePaths); }) };
+		const double parallelMilliseconds{ TestUtils::MeasureMinimumMilliseconds(sRepetitionCount, [&]() { LoadInParallel(filePaths); }) };
+
+		const double fileMegabytes{ fileSize / (1024.0 * 1024.0) };
+		std::printf(
+			"%-8s | %3zu files (%6.1f MB) | serial %8.2f ms, %7.1f MB/s, %7.1f files/s | parallel %8.2f ms, %7.1f MB/s, %7.1f files/s | %.2fx\n",
+			name,
+			filePaths.size(),
+			fileMegabytes,
+			serialMilliseconds,
+			fileMegabytes / (serialMilliseconds / 1000.0),
+			filePaths.size() / (serialMilliseconds / 1000.0),
+			parallelMilliseconds,
+			fileMegabytes / (parallelMilliseconds / 1000.0),
+			filePaths.size() / (parallelMilliseconds / 1000.0),
+			serialMilliseconds / parallelMilliseconds);
+	}
+}
+
+int main() {
+	std::printf("%d threads\n", tbb::this_task_arena::max_concurrency());
+
+	const std::vector<std::string> textureFilePaths{ TestUtils::GetFilePaths(TestUtils::GetResourcesPath() + "textures", ".dds") };
+	const std::vector<std::string> modelFilePaths{ MeshTestUtils::GetModelFilePaths() };
+	std::vector<std::string> filePaths{ textureFilePaths };
+	filePaths.insert(filePaths.end(), modelFilePaths.begin(), modelFilePaths.end());
+
+	Run("Textures", textureFilePaths);
+	Run("Models", modelFilePaths);
+	Run("All", filePaths);
+
+	return 0;
+}
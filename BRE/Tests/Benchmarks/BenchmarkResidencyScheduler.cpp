@@ -0,0 +1,78 @@
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include <ResourceManager/ResidencyScheduler.h>
+#include <TestUtils.h>
+
+// Time of ResidencyScheduler::MarkUsed() and ScheduleChanges() per frame for a scene of textures
+// placed on a line, seen by a camera that walks along it (the textures within 100 units are used),
+// and the evictions, the size made resident again and the frames over budget, for several budgets.
+// Textures are 0.25 to 8 MB, the GPU is 2 frames behind, and the idle frame counts
+// are the ones of SettingsManager (60 frames before eviction, 30 before demotion).
+namespace {
+	const std::uint32_t sFrameCount{ 2000U };
+	const std::uint64_t sFrameLatency{ 2UL };
+	const std::uint32_t sMinIdleFrameCount{ 60U };
+	const std::uint32_t sDemotionIdleFrameCount{ 30U };
+
+	void Run(const std::uint32_t textureCount, const std::uint64_t memoryBudget) {
+		ResidencyScheduler scheduler(memoryBudget, sMinIdleFrameCount, sDemotionIdleFrameCount);
+		std::mt19937 generator(3U);
+		std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+		std::vector<float> texturePositions(textureCount);
+		for (std::uint32_t i = 0U; i < textureCount; ++i) {
+			const std::uint64_t size{ (256UL * 1024UL) << (generator() % 6U) };
+			const std::uint32_t pageableId{ scheduler.AddPageable(size, ResidencyScheduler::Category::TEXTURE, 1UL) };
+			scheduler.SetEvictable(pageableId, true);
+			texturePositions[i] = distribution(generator) * 1000.0f;
+		}
+
+		ResidencyScheduler::Changes changes;
+		std::uint64_t usedCount{ 0UL };
+		std::uint32_t overBudgetFrameCount{ 0U };
+		double milliseconds{ 0.0 };
+		for (std::uint64_t frameIndex = 2UL; frameIndex < sFrameCount + 2UL; ++frameIndex) {
+			// The camera walks the line back and forth
+			const float cameraPosition{ 1000.0f * (0.5f - 0.5f * std::cos(frameIndex * 0.005f)) };
+
+			changes.mEvictedPageableIds.clear();
+			changes.mDemotedPageableIds.clear();
+			changes.mPromotedPageableIds.clear();
+			TestUtils::Stopwatch stopwatch;
+			scheduler.ScheduleChanges(frameIndex, frameIndex - sFrameLatency, changes);
+			for (std::uint32_t i = 0U; i < textureCount; ++i) {
+				if (std::abs(texturePositions[i] - cameraPosition) < 100.0f) {
+					scheduler.MarkUsed(i, frameIndex);
+					++usedCount;
+				}
+			}
+			milliseconds += stopwatch.GetElapsedMilliseconds();
+
+			overBudgetFrameCount += scheduler.GetResidentSize() > memoryBudget ? 1U : 0U;
+		}
+
+		const ResidencyScheduler::Statistics statistics{ scheduler.GetStatistics() };
+		std::printf(
+			"%6u textures | budget %5llu MB | %8.4f ms/frame | %6.0f used/frame | %7.3f evictions/frame | %7.2f MB/frame made resident | %4u frames over budget\n",
+			textureCount,
+			static_cast<unsigned long long>(memoryBudget / (1024UL * 1024UL)),
+			milliseconds / sFrameCount,
+			static_cast<double>(usedCount) / sFrameCount,
+			static_cast<double>(statistics.mEvictionCount) / sFrameCount,
+			static_cast<double>(statistics.mMadeResidentSize) / (1024.0 * 1024.0 * sFrameCount),
+			overBudgetFrameCount);
+	}
+}
+
+int main() {
+	for (const std::uint32_t textureCount : { 1000U, 10000U }) {
+		for (const std::uint64_t memoryBudget : { 256UL, 1024UL, 4096UL }) {
+			Run(textureCount, memoryBudget * 1024UL * 1024UL);
+		}
+	}
+
+	return 0;
+}
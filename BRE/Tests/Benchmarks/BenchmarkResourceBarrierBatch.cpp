@@ -0,0 +1,111 @@
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include <ResourceStateManager/ResourceBarrierBatch.h>
+#include <ResourceStateManager/ResourceStateTable.h>
+#include <TestUtils.h>
+
+// Compares recording the transitions of a frame straight into the state table (a barrier
+// per transition, like ResourceStateManager did before) against accumulating them in a
+// ResourceBarrierBatch per command list, which merges them and drops round trips.
+// The frame has sCommandListCount command lists with sTransitionsPerCommandList random
+// transitions of sResourceCount resources between a few states.
+namespace {
+	const std::uint32_t sResourceCount{ 64U };
+	const std::uint32_t sCommandListCount{ 32U };
+	const std::uint32_t sTransitionsPerCommandList{ 48U };
+	const std::uint32_t sFrameCount{ 200U };
+
+	// D3D12_RESOURCE_STATES values
+	const std::uint32_t sStates[]{ 0U, 4U, 8U, 128U };
+
+	struct Transition {
+		std::uint32_t mResourceIndex;
+		std::uint32_t mStateAfter;
+	};
+
+	struct Result {
+		double mMilliseconds{ 0.0 };
+		std::uint64_t mBarrierCount{ 0UL };
+	};
+
+	void AddResources(const std::vector<int>& resources, ResourceStateTable& stateTable) {
+		for (const int& resource : resources) {
+			stateTable.AddResource(&resource, 1U, sStates[0U]);
+		}
+	}
+
+	Result RunImmediate(const std::vector<int>& resources, const std::vector<Transition>& transitions) {
+		ResourceStateTable stateTable;
+		AddResources(resources, stateTable);
+		std::vector<ResourceStateTable::Barrier> barriers;
+		barriers.reserve(transitions.size());
+
+		Result result;
+		result.mMilliseconds = TestUtils::MeasureMinimumMilliseconds(5U, [&]() {
+			result.mBarrierCount = 0UL;
+			for (std::uint32_t frame = 0U; frame < sFrameCount; ++frame) {
+				for (const Transition& transition : transitions) {
+					stateTable.Transition(
+						&resources[transition.mResourceIndex],
+						ResourceStateTable::sAllSubresources,
+						transition.mStateAfter,
+						ResourceStateTable::sBarrierFlagNone,
+						barriers);
+				}
+				result.mBarrierCount += barriers.size();
+				barriers.clear();
+			}
+		});
+
+		return result;
+	}
+
+	Result RunBatched(const std::vector<int>& resources, const std::vector<Transition>& transitions) {
+		ResourceStateTable stateTable;
+		AddResources(resources, stateTable);
+		std::vector<ResourceStateTable::Barrier> barriers;
+		barriers.reserve(transitions.size());
+		ResourceBarrierBatch batch;
+
+		Result result;
+		result.mMilliseconds = TestUtils::MeasureMinimumMilliseconds(5U, [&]() {
+			result.mBarrierCount = 0UL;
+			for (std::uint32_t frame = 0U; frame < sFrameCount; ++frame) {
+				for (std::uint32_t i = 0U; i < sCommandListCount; ++i) {
+					for (std::uint32_t j = 0U; j < sTransitionsPerCommandList; ++j) {
+						const Transition& transition{ transitions[i * sTransitionsPerCommandList + j] };
+						batch.Transition(&resources[transition.mResourceIndex], transition.mStateAfter);
+					}
+					batch.Resolve(stateTable, barriers);
+				}
+				result.mBarrierCount += barriers.size();
+				barriers.clear();
+			}
+		});
+
+		return result;
+	}
+}
+
+int main() {
+	std::vector<int> resources(sResourceCount, 0);
+	std::vector<Transition> transitions;
+	std::mt19937 generator(11U);
+	for (std::uint32_t i = 0U; i < sCommandListCount * sTransitionsPerCommandList; ++i) {
+		Transition transition;
+		transition.mResourceIndex = static_cast<std::uint32_t>(generator() % sResourceCount);
+		transition.mStateAfter = sStates[generator() % 4U];
+		transitions.push_back(transition);
+	}
+
+	const Result immediateResult{ RunImmediate(resources, transitions) };
+	const Result batchedResult{ RunBatched(resources, transitions) };
+	std::printf("%u frames of %u transitions\n", sFrameCount, sCommandListCount * sTransitionsPerCommandList);
+	std::printf("Immediate %8.2f ms, %8llu barriers\n", immediateResult.mMilliseconds, static_cast<unsigned long long>(immediateResult.mBarrierCount));
+	std::printf("Batched   %8.2f ms, %8llu barriers\n", batchedResult.mMilliseconds, static_cast<unsigned long long>(batchedResult.mBarrierCount));
+
+	return 0;
+}
@@ -0,0 +1,75 @@
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <ResourceManager/RingBufferAllocator.h>
+#include <TestUtils.h>
+
+// Allocation throughput of RingBufferAllocator (one atomic compare and swap per allocation)
+// compared with the same linear allocator protected by a mutex, for several thread counts.
+namespace {
+	const std::uint32_t sAllocationCountPerThread{ 200000U };
+	const std::size_t sAllocationSize{ 256UL };
+
+	class LockedLinearAllocator {
+	public:
+		explicit LockedLinearAllocator(const std::size_t capacity) : mCapacity(capacity) {}
+
+		std::size_t Allocate(const std::size_t sizeInBytes) noexcept {
+			std::lock_guard<std::mutex> lock(mMutex);
+			if (mHead + sizeInBytes > mCapacity) {
+				mHead = 0UL;
+			}
+			const std::size_t offset{ mHead };
+			mHead += sizeInBytes;
+			return offset;
+		}
+
+	private:
+		std::mutex mMutex;
+		std::size_t mCapacity{ 0UL };
+		std::size_t mHead{ 0UL };
+	};
+
+	template<typename Allocator>
+	double MeasureAllocationsPerSecond(Allocator& allocator, const std::uint32_t threadCount) {
+		TestUtils::Stopwatch stopwatch;
+		std::vector<std::thread> threads;
+		for (std::uint32_t i = 0U; i < threadCount; ++i) {
+			threads.emplace_back([&allocator]() {
+				std::size_t offsetSum{ 0UL };
+				for (std::uint32_t j = 0U; j < sAllocationCountPerThread; ++j) {
+					offsetSum += allocator.Allocate(sAllocationSize);
+				}
+				if (offsetSum == 1UL) {
+					std::printf("Unexpected offset sum\n");
+				}
+			});
+		}
+		for (std::thread& thread : threads) {
+			thread.join();
+		}
+
+		return threadCount * sAllocationCountPerThread / (stopwatch.GetElapsedMilliseconds() / 1000.0);
+	}
+}
+
+int main() {
+	const std::uint32_t maxThreadCount{ std::max<std::uint32_t>(8U, std::thread::hardware_concurrency()) };
+	for (std::uint32_t threadCount = 1U; threadCount <= maxThreadCount; threadCount *= 2U) {
+		// The ring is big enough to not need releases during the benchmark
+		RingBufferAllocator ringBufferAllocator(threadCount * sAllocationCountPerThread * sAllocationSize);
+		LockedLinearAllocator lockedLinearAllocator(threadCount * sAllocationCountPerThread * sAllocationSize);
+
+		const double ringBufferAllocationsPerSecond{ MeasureAllocationsPerSecond(ringBufferAllocator, threadCount) };
+		const double lockedAllocationsPerSecond{ MeasureAllocationsPerSecond(lockedLinearAllocator, threadCount) };
+		std::printf("%2u threads: RingBufferAllocator %7.1f M allocations/s, mutex %7.1f M allocations/s\n",
+			threadCount,
+			ringBufferAllocationsPerSecond / 1.0e6,
+			lockedAllocationsPerSecond / 1.0e6);
+	}
+
+	return 0;
+}
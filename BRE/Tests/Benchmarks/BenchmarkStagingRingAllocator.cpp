@@ -0,0 +1,127 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <random>
+#include <vector>
+
+#include <ResourceManager/StagingRingAllocator.h>
+#include <TestUtils.h>
+
+// Allocation time of StagingRingAllocator and the number of times the CPU waits for the GPU
+// (the staging ring is full) when a stream of mip chains is uploaded like TransferManager::UploadTexture() 
+// does it: mips in groups that fit in the ring, and mips larger than the ring in slabs of rows.
+// The open batch is submitted every 8 textures, and the simulated GPU is 2 batches behind.
+// It is done for several ring capacities (TransferManager uses 64 MB).
+namespace {
+	const std::uint32_t sTextureCount{ 4096U };
+	const std::uint32_t sTexturesPerBatch{ 8U };
+	const std::uint32_t sBatchesInFlight{ 2U };
+	const std::uint64_t sPlacementAlignment{ 512UL };
+
+	struct Texture {
+		std::vector<std::uint64_t> mMipSizes;
+		std::uint64_t mRowPitch{ 0UL };
+	};
+
+	// Square RGBA8 textures (from 256 to 8192 texels, so the finest mips of the largest ones
+	// do not fit in the smaller rings) with full mip chains
+	std::vector<Texture> CreateTextures() {
+		std::mt19937 generator(3U);
+		std::vector<Texture> textures(sTextureCount);
+		for (Texture& texture : textures) {
+			const std::uint32_t sizeExponent{ generator() % 64U == 0U ? 13U : 8U + static_cast<std::uint32_t>(generator() % 4U) };
+			std::uint64_t dimension{ 1UL << sizeExponent };
+			texture.mRowPitch = dimension * 4UL;
+			while (dimension > 0UL) {
+				const std::uint64_t rowPitch{ ((dimension * 4UL + 255UL) / 256UL) * 256UL };
+				const std::uint64_t mipSize{ rowPitch * dimension };
+				texture.mMipSizes.push_back(((mipSize + sPlacementAlignment - 1UL) / sPlacementAlignment) * sPlacementAlignment);
+				dimension /= 2UL;
+			}
+		}
+
+		return textures;
+	}
+
+	void Run(const std::vector<Texture>& textures, const std::uint64_t capacity) {
+		StagingRingAllocator allocator(capacity);
+		std::deque<std::uint64_t> submittedFenceValues;
+		std::uint64_t lastFenceValue{ 0UL };
+		std::uint32_t allocationCount{ 0U };
+		std::uint32_t waitCount{ 0U };
+
+		const auto allocate = [&](const std::uint64_t size) {
+			++allocationCount;
+			while (allocator.Allocate(size, sPlacementAlignment) == StagingRingAllocator::sInvalidOffset) {
+				if (allocator.GetOpenBatchSize() > 0UL) {
+					allocator.CloseBatch(++lastFenceValue);
+					submittedFenceValues.push_back(lastFenceValue);
+				}
+				++waitCount;
+				allocator.ReleaseCompletedBatches(submittedFenceValues.front());
+				submittedFenceValues.pop_front();
+			}
+		};
+
+		TestUtils::Stopwatch stopwatch;
+		for (std::uint32_t i = 0U; i < textures.size(); ++i) {
+			const Texture& texture{ textures[i] };
+			std::uint64_t groupSize{ 0UL };
+			for (const std::uint64_t mipSize : texture.mMipSizes) {
+				if (mipSize > capacity) {
+					const std::uint64_t slabRowCount{ capacity / texture.mRowPitch };
+					for (std::uint64_t size = mipSize; size > 0UL; ) {
+						const std::uint64_t slabSize{ std::min<std::uint64_t>(size, slabRowCount * texture.mRowPitch) };
+						allocate(slabSize);
+						size -= slabSize;
+					}
+					continue;
+				}
+
+				if (groupSize + mipSize > capacity) {
+					allocate(groupSize);
+					groupSize = 0UL;
+				}
+				groupSize += mipSize;
+			}
+			if (groupSize > 0UL) {
+				allocate(groupSize);
+			}
+
+			if ((i + 1U) % sTexturesPerBatch == 0U) {
+				allocator.CloseBatch(++lastFenceValue);
+				submittedFenceValues.push_back(lastFenceValue);
+				if (submittedFenceValues.size() > sBatchesInFlight) {
+					allocator.ReleaseCompletedBatches(submittedFenceValues.front());
+					submittedFenceValues.pop_front();
+				}
+			}
+		}
+		const double milliseconds{ stopwatch.GetElapsedMilliseconds() };
+
+		std::printf(
+			"%4llu MB ring | %6u allocations | %5u waits | %6.1f ns/allocation\n",
+			static_cast<unsigned long long>(capacity / (1024UL * 1024UL)),
+			allocationCount,
+			waitCount,
+			milliseconds * 1.0e6 / allocationCount);
+	}
+}
+
+int main() {
+	const std::vector<Texture> textures{ CreateTextures() };
+	std::uint64_t totalSize{ 0UL };
+	for (const Texture& texture : textures) {
+		for (const std::uint64_t mipSize : texture.mMipSizes) {
+			totalSize += mipSize;
+		}
+	}
+	std::printf("%u textures, %llu MB\n", sTextureCount, static_cast<unsigned long long>(totalSize / (1024UL * 1024UL)));
+
+	for (const std::uint64_t capacity : { 16UL, 64UL, 256UL }) {
+		Run(textures, capacity * 1024UL * 1024UL);
+	}
+
+	return 0;
+}
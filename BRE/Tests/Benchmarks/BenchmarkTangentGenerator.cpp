@@ -0,0 +1,72 @@
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <tbb/task_arena.h>
+#include <vector>
+
+#include <MeshTestUtils.h>
+#include <ModelManager/TangentGenerator.h>
+#include <TestUtils.h>
+
+// Time to compute the tangents of a large sphere and of the models in external/resources/models,
+// with a single thread and with all of them, and with a new workspace and a reused one.
+namespace {
+	void Run(const std::string& name, const GeometryGenerator::MeshData& sourceMeshData) {
+		GeometryGenerator::MeshData meshData{ sourceMeshData };
+		tbb::task_arena singleThreadArena(1);
+		const double serialMilliseconds{ TestUtils::MeasureMinimumMilliseconds(3U, [&meshData, &singleThreadArena]() {
+			singleThreadArena.execute([&meshData]() {
+				TangentGenerator::Workspace workspace;
+				TangentGenerator::ComputeTangents(meshData, workspace);
+			});
+		}) };
+
+		const double parallelMilliseconds{ TestUtils::MeasureMinimumMilliseconds(3U, [&meshData]() {
+			TangentGenerator::Workspace workspace;
+			TangentGenerator::ComputeTangents(meshData, workspace);
+		}) };
+
+		TangentGenerator::Workspace reusedWorkspace;
+		const double reusedWorkspaceMilliseconds{ TestUtils::MeasureMinimumMilliseconds(3U, [&meshData, &reusedWorkspace]() {
+			TangentGenerator::ComputeTangents(meshData, reusedWorkspace);
+		}) };
+
+		std::printf(
+			"%-16s %8zu vertices %8zu triangles | 1 thread %8.2f ms | %u threads %8.2f ms | reused workspace %8.2f ms\n",
+			name.c_str(),
+			meshData.mVertices.size(),
+			meshData.mIndices32.size() / 3UL,
+			serialMilliseconds,
+			static_cast<std::uint32_t>(tbb::this_task_arena::max_concurrency()),
+			parallelMilliseconds,
+			reusedWorkspaceMilliseconds);
+	}
+}
+
+int main() {
+	GeometryGenerator::MeshData sphereMeshData;
+	MeshTestUtils::CreateSphere(2048U, 512U, sphereMeshData);
+	Run("sphere", sphereMeshData);
+
+	for (const std::string& modelFilePath : MeshTestUtils::GetModelFilePaths()) {
+		GeometryGenerator::MeshData meshData;
+		if (MeshTestUtils::ReadObjFile(modelFilePath, meshData) == false) {
+			std::printf("%s cannot be read\n", modelFilePath.c_str());
+			continue;
+		}
+
+		// Normals of the files are not always normalized
+		for (GeometryGenerator::Vertex& vertex : meshData.mVertices) {
+			const DirectX::XMFLOAT3& normal{ vertex.mNormal };
+			const float length{ std::sqrt(normal.x * normal.x + normal.y * normal.y + normal.z * normal.z) };
+			if (length > 0.0f) {
+				vertex.mNormal = DirectX::XMFLOAT3(normal.x / length, normal.y / length, normal.z / length);
+			}
+		}
+
+		Run(modelFilePath.substr(modelFilePath.find_last_of("/\\") + 1UL), meshData);
+	}
+
+	return 0;
+}
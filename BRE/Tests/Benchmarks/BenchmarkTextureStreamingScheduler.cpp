@@ -0,0 +1,96 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include <ResourceManager/TextureStreamingScheduler.h>
+#include <TestUtils.h>
+
+// Time of TextureStreamingScheduler::ScheduleChanges() for a scene of textures placed on a line,
+// seen by a camera that walks along it (textures near the camera need their finest mips), and
+// how many of the requested mips are resident, for several memory budgets.
+// Textures are 2048 x 2048 BC1 (2.7 MB with mips) with the last 6 mips pinned, and
+// the maximum load size per frame is the one of TextureStreamer (32 MB).
+namespace {
+	const std::uint32_t sFrameCount{ 2000U };
+	const std::uint64_t sMaxLoadSizePerSchedule{ 32UL * 1024UL * 1024UL };
+
+	std::vector<std::uint64_t> GetMipSizes() {
+		std::vector<std::uint64_t> mipSizes;
+		for (std::uint64_t dimension = 2048UL; dimension > 0UL; dimension /= 2UL) {
+			const std::uint64_t blockCount{ std::max<std::uint64_t>(1UL, dimension / 4UL) };
+			mipSizes.push_back(blockCount * blockCount * 8UL);
+		}
+
+		return mipSizes;
+	}
+
+	void Run(const std::uint32_t textureCount, const std::uint64_t memoryBudget) {
+		const std::vector<std::uint64_t> mipSizes{ GetMipSizes() };
+		const std::uint32_t mipCount{ static_cast<std::uint32_t>(mipSizes.size()) };
+		TextureStreamingScheduler scheduler(memoryBudget, sMaxLoadSizePerSchedule);
+		for (std::uint32_t i = 0U; i < textureCount; ++i) {
+			scheduler.AddTexture(mipSizes.data(), mipCount, 6U);
+		}
+
+		std::mt19937 generator(3U);
+		std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+		std::vector<float> texturePositions(textureCount);
+		for (float& texturePosition : texturePositions) {
+			texturePosition = distribution(generator) * 1000.0f;
+		}
+
+		std::vector<TextureStreamingScheduler::Change> changes;
+		std::uint64_t changeCount{ 0UL };
+		std::uint64_t requestCount{ 0UL };
+		std::uint64_t satisfiedRequestCount{ 0UL };
+		std::vector<std::uint32_t> requestedMips(textureCount);
+		double milliseconds{ 0.0 };
+		for (std::uint32_t frameIndex = 1U; frameIndex <= sFrameCount; ++frameIndex) {
+			// The camera walks the line back and forth, and it sees the textures within 100 units
+			const float cameraPosition{ 1000.0f * (0.5f - 0.5f * std::cos(frameIndex * 0.005f)) };
+			for (std::uint32_t i = 0U; i < textureCount; ++i) {
+				const float distance{ std::abs(texturePositions[i] - cameraPosition) };
+				requestedMips[i] = mipCount;
+				if (distance < 100.0f) {
+					const float coveredPixelCount{ 2048.0f * 2048.0f / std::max<float>(1.0f, distance * distance) };
+					requestedMips[i] = TextureStreamingScheduler::ComputeRequiredMip(2048U, 2048U, mipCount, coveredPixelCount);
+					scheduler.RequestMip(i, requestedMips[i], coveredPixelCount);
+				}
+			}
+
+			changes.clear();
+			TestUtils::Stopwatch stopwatch;
+			scheduler.ScheduleChanges(frameIndex, changes);
+			milliseconds += stopwatch.GetElapsedMilliseconds();
+			changeCount += changes.size();
+
+			for (std::uint32_t i = 0U; i < textureCount; ++i) {
+				if (requestedMips[i] < mipCount) {
+					++requestCount;
+					satisfiedRequestCount += scheduler.GetFirstResidentMip(i) <= requestedMips[i] ? 1UL : 0UL;
+				}
+			}
+		}
+
+		std::printf(
+			"%6u textures | budget %5llu MB | %8.4f ms/frame | %6.2f changes/frame | %5.1f%% of requests resident\n",
+			textureCount,
+			static_cast<unsigned long long>(memoryBudget / (1024UL * 1024UL)),
+			milliseconds / sFrameCount,
+			static_cast<double>(changeCount) / sFrameCount,
+			requestCount > 0UL ? 100.0 * satisfiedRequestCount / requestCount : 100.0);
+	}
+}
+
+int main() {
+	for (const std::uint32_t textureCount : { 1000U, 10000U }) {
+		for (const std::uint64_t memoryBudget : { 256UL, 1024UL, 4096UL }) {
+			Run(textureCount, memoryBudget * 1024UL * 1024UL);
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,115 @@
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include <ResourceManager/OffsetAllocator.h>
+#include <ResourceManager/TlsfAllocator.h>
+#include <TestUtils.h>
+
+// Churn of placed resources (mostly small buffers, some textures and a few large resources)
+// in a 1GB heap with 64KB granularity kept around 75% full: time per operation, allocations that
+// do not fit and fragmentation of TlsfAllocator, against OffsetAllocator (best fit in a map)
+// with sizes in granularity units.
+namespace {
+	const std::uint64_t sGranularity{ 64UL * 1024UL };
+	const std::uint64_t sCapacity{ 16384UL * sGranularity };
+	const std::uint32_t sOperationCount{ 1000000U };
+
+	struct Allocation {
+		std::uint32_t mHandle;
+		std::uint64_t mSize;
+	};
+
+	std::uint64_t GetRandomSize(std::mt19937_64& generator) {
+		const std::uint64_t sizeClass{ generator() % 100U };
+		if (sizeClass < 60U) {
+			return sGranularity * (generator() % 4UL + 1UL);
+		}
+		if (sizeClass < 95U) {
+			return sGranularity * (generator() % 64UL + 1UL);
+		}
+
+		return sGranularity * (generator() % 1024UL + 64UL);
+	}
+
+	// "allocate" returns the handle or an invalid handle, and "free" frees an allocation
+	template<typename AllocateFunction, typename FreeFunction, typename FragmentationFunction>
+	void Run(
+		const char* name,
+		const std::uint32_t invalidHandle,
+		AllocateFunction allocate,
+		FreeFunction free,
+		FragmentationFunction getFragmentation)
+	{
+		std::mt19937_64 generator(3UL);
+		std::vector<Allocation> allocations;
+		std::uint64_t usedSize{ 0UL };
+		std::uint32_t failedAllocationCount{ 0U };
+		double fragmentationSum{ 0.0 };
+		std::uint32_t fragmentationSampleCount{ 0U };
+		TestUtils::Stopwatch stopwatch;
+		for (std::uint32_t i = 0U; i < sOperationCount; ++i) {
+			if (allocations.empty() || generator() % 100U < (usedSize < sCapacity * 3UL / 4UL ? 55U : 45U)) {
+				const std::uint64_t size{ GetRandomSize(generator) };
+				const std::uint32_t handle{ allocate(size) };
+				if (handle == invalidHandle) {
+					++failedAllocationCount;
+					continue;
+				}
+				allocations.push_back(Allocation{ handle, size });
+				usedSize += size;
+			} else {
+				const std::size_t allocationIndex{ generator() % allocations.size() };
+				const Allocation allocation{ allocations[allocationIndex] };
+				allocations[allocationIndex] = allocations.back();
+				allocations.pop_back();
+				free(allocation);
+				usedSize -= allocation.mSize;
+			}
+
+			if (i % 1000U == 0U) {
+				fragmentationSum += getFragmentation();
+				++fragmentationSampleCount;
+			}
+		}
+		const double milliseconds{ stopwatch.GetElapsedMilliseconds() };
+
+		std::printf(
+			"%-16s %6.1f ns/operation | %5.2f%% failed allocations | average fragmentation %.3f\n",
+			name,
+			milliseconds * 1.0e6 / sOperationCount,
+			100.0 * failedAllocationCount / sOperationCount,
+			fragmentationSum / fragmentationSampleCount);
+	}
+}
+
+int main() {
+	std::printf("%u operations, heap of %llu MB\n", sOperationCount, static_cast<unsigned long long>(sCapacity >> 20UL));
+
+	TlsfAllocator tlsfAllocator(sCapacity, sGranularity);
+	Run(
+		"TLSF",
+		TlsfAllocator::sInvalidHandle,
+		[&tlsfAllocator](const std::uint64_t size) {
+			std::uint64_t offset{ 0UL };
+			return tlsfAllocator.Allocate(size, sGranularity, offset);
+		},
+		[&tlsfAllocator](const Allocation& allocation) { tlsfAllocator.Free(allocation.mHandle); },
+		[&tlsfAllocator]() { return tlsfAllocator.GetFragmentation(); });
+
+	// Handles are offsets in granularity units
+	OffsetAllocator offsetAllocator(static_cast<std::uint32_t>(sCapacity / sGranularity));
+	Run(
+		"OffsetAllocator",
+		OffsetAllocator::sInvalidOffset,
+		[&offsetAllocator](const std::uint64_t size) {
+			return offsetAllocator.Allocate(static_cast<std::uint32_t>(size / sGranularity));
+		},
+		[&offsetAllocator](const Allocation& allocation) {
+			offsetAllocator.Free(allocation.mHandle, static_cast<std::uint32_t>(allocation.mSize / sGranularity));
+		},
+		[&offsetAllocator]() { return offsetAllocator.GetFragmentation(); });
+
+	return 0;
+}
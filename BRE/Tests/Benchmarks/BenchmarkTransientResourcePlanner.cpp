@@ -0,0 +1,86 @@
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include <ResourceManager/TransientResourcePlanner.h>
+#include <TestUtils.h>
+
+using namespace TransientResourcePlanner;
+
+// Memory saved by aliasing the RenderManager render targets at several resolutions,
+// and time to plan the heap offsets of many transient resources.
+namespace {
+	const std::uint64_t sHeapAlignment{ 64UL * 1024UL };
+	const std::uint32_t sRepetitionCount{ 20U };
+
+	ResourceRequest GetRequest(
+		const std::uint64_t size,
+		const std::uint32_t firstUse,
+		const std::uint32_t lastUse) noexcept
+	{
+		ResourceRequest request;
+		request.mSize = (size + sHeapAlignment - 1UL) & ~(sHeapAlignment - 1UL);
+		request.mAlignment = sHeapAlignment;
+		request.mFirstUse = firstUse;
+		request.mLastUse = lastUse;
+		return request;
+	}
+
+	void PrintRenderManagerSavings(const std::uint64_t width, const std::uint64_t height) {
+		const std::uint64_t pixelCount{ width * height };
+		const ResourceRequest requests[]{
+			GetRequest(pixelCount * 8UL, 0U, 1U), // Normal smoothness
+			GetRequest(pixelCount * 4UL, 0U, 1U), // Base color metal mask
+			GetRequest(pixelCount * 4UL, 0U, 2U), // Depth buffer
+			GetRequest(pixelCount * 8UL, 1U, 3U), // Intermediate color buffer 1
+			GetRequest(pixelCount * 8UL, 3U, 4U), // Intermediate color buffer 2
+			GetRequest(pixelCount * 2UL, 1U, 1U), // Ambient accessibility buffer
+			GetRequest(pixelCount * 2UL, 1U, 1U), // Blur buffer
+		};
+		const std::uint32_t requestCount{ static_cast<std::uint32_t>(sizeof(requests) / sizeof(requests[0U])) };
+		std::uint64_t heapOffsets[requestCount];
+		const std::uint64_t heapSize{ PlanHeapOffsets(requests, requestCount, heapOffsets) };
+		const std::uint64_t nonAliasedHeapSize{ GetNonAliasedHeapSize(requests, requestCount) };
+
+		std::printf("%4llux%-4llu render targets: %7.1f MB aliased, %7.1f MB not aliased (%4.1f%% saved)\n",
+			static_cast<unsigned long long>(width),
+			static_cast<unsigned long long>(height),
+			heapSize / (1024.0 * 1024.0),
+			nonAliasedHeapSize / (1024.0 * 1024.0),
+			100.0 * (1.0 - static_cast<double>(heapSize) / nonAliasedHeapSize));
+	}
+}
+
+int main() {
+	PrintRenderManagerSavings(1920UL, 1080UL);
+	PrintRenderManagerSavings(2560UL, 1440UL);
+	PrintRenderManagerSavings(3840UL, 2160UL);
+
+	std::mt19937 generator(1U);
+	for (std::uint32_t requestCount = 16U; requestCount <= 1024U; requestCount *= 4U) {
+		std::vector<ResourceRequest> requests(requestCount);
+		const std::uint32_t positionCount{ requestCount / 2U };
+		for (ResourceRequest& request : requests) {
+			request.mSize = (1UL + generator() % 256U) * sHeapAlignment;
+			request.mAlignment = sHeapAlignment;
+			request.mFirstUse = generator() % positionCount;
+			request.mLastUse = request.mFirstUse + generator() % std::min<std::uint32_t>(8U, positionCount - request.mFirstUse);
+		}
+
+		std::vector<std::uint64_t> heapOffsets(requestCount);
+		std::uint64_t heapSize{ 0UL };
+		const double time{ TestUtils::MeasureMinimumMilliseconds(sRepetitionCount, [&]() {
+			heapSize = PlanHeapOffsets(requests.data(), requestCount, heapOffsets.data());
+		}) };
+		const std::uint64_t nonAliasedHeapSize{ GetNonAliasedHeapSize(requests.data(), requestCount) };
+
+		std::printf("%4u requests: planned in %8.3f ms, heap %8.1f MB (%4.1f%% of not aliased)\n",
+			requestCount,
+			time,
+			heapSize / (1024.0 * 1024.0),
+			100.0 * static_cast<double>(heapSize) / nonAliasedHeapSize);
+	}
+
+	return 0;
+}
@@ -0,0 +1,73 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <MeshTestUtils.h>
+#include <ModelManager/VertexCompressor.h>
+#include <TestUtils.h>
+
+// Vertex buffer size, encoding time and maximum errors of VertexCompressor for the
+// models in external/resources/models.
+namespace {
+	// Angle in degrees between two vectors. The dot product of small angles rounds to 1.0f in floats.
+	double GetAngle(const DirectX::XMFLOAT3& vector1, const DirectX::XMFLOAT3& vector2) {
+		const double crossX{ static_cast<double>(vector1.y) * vector2.z - static_cast<double>(vector1.z) * vector2.y };
+		const double crossY{ static_cast<double>(vector1.z) * vector2.x - static_cast<double>(vector1.x) * vector2.z };
+		const double crossZ{ static_cast<double>(vector1.x) * vector2.y - static_cast<double>(vector1.y) * vector2.x };
+		const double dot{
+			static_cast<double>(vector1.x) * vector2.x +
+			static_cast<double>(vector1.y) * vector2.y +
+			static_cast<double>(vector1.z) * vector2.z };
+
+		return std::atan2(std::sqrt(crossX * crossX + crossY * crossY + crossZ * crossZ), dot) * 180.0 / 3.14159265358979;
+	}
+}
+
+int main() {
+	for (const std::string& modelFilePath : MeshTestUtils::GetModelFilePaths()) {
+		GeometryGenerator::MeshData meshData;
+		if (MeshTestUtils::ReadObjFile(modelFilePath, meshData) == false) {
+			std::printf("%s cannot be read\n", modelFilePath.c_str());
+			continue;
+		}
+
+		const std::size_t vertexCount{ meshData.mVertices.size() };
+		std::vector<VertexCompressor::PackedVertex> packedVertices(vertexCount);
+		VertexCompressor::PositionQuantization positionQuantization;
+		const double milliseconds{ TestUtils::MeasureMinimumMilliseconds(10U, [&]() {
+			positionQuantization = VertexCompressor::ComputePositionQuantization(meshData.mVertices.data(), vertexCount);
+			VertexCompressor::EncodeVertices(meshData.mVertices.data(), vertexCount, positionQuantization, packedVertices.data());
+		}) };
+
+		float maxPositionError{ 0.0f };
+		double maxNormalAngle{ 0.0 };
+		for (std::size_t i = 0UL; i < vertexCount; ++i) {
+			const GeometryGenerator::Vertex& vertex{ meshData.mVertices[i] };
+			GeometryGenerator::Vertex decodedVertex;
+			VertexCompressor::DecodeVertex(packedVertices[i], positionQuantization, decodedVertex);
+			maxPositionError = std::max<float>(maxPositionError, std::fabs(decodedVertex.mPosition.x - vertex.mPosition.x));
+			maxPositionError = std::max<float>(maxPositionError, std::fabs(decodedVertex.mPosition.y - vertex.mPosition.y));
+			maxPositionError = std::max<float>(maxPositionError, std::fabs(decodedVertex.mPosition.z - vertex.mPosition.z));
+
+			if (vertex.mNormal.x != 0.0f || vertex.mNormal.y != 0.0f || vertex.mNormal.z != 0.0f) {
+				maxNormalAngle = std::max<double>(maxNormalAngle, GetAngle(decodedVertex.mNormal, vertex.mNormal));
+			}
+		}
+
+		std::printf(
+			"%-16s %6zu vertices | %8zu -> %7zu bytes | %.3f ms | position error %.2e (bounds %.2f) | normal error %.4f degrees\n",
+			modelFilePath.substr(modelFilePath.find_last_of("/\\") + 1UL).c_str(),
+			vertexCount,
+			vertexCount * sizeof(GeometryGenerator::Vertex),
+			vertexCount * sizeof(VertexCompressor::PackedVertex),
+			milliseconds,
+			maxPositionError,
+			positionQuantization.mScale,
+			maxNormalAngle);
+	}
+
+	return 0;
+}
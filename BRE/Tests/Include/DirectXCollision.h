@@ -0,0 +1,23 @@
+#pragma once
+
+#include <DirectXMath.h>
+
+// Stand-in of the DirectXCollision bounding volumes used by the portable modules
+// (see DirectXMath.h in this folder)
+namespace DirectX {
+	struct BoundingSphere {
+		XMFLOAT3 Center;
+		float Radius;
+
+		BoundingSphere() : Center(0.0f, 0.0f, 0.0f), Radius(1.0f) {}
+		BoundingSphere(const XMFLOAT3& center, const float radius) : Center(center), Radius(radius) {}
+	};
+
+	struct BoundingBox {
+		XMFLOAT3 Center;
+		XMFLOAT3 Extents;
+
+		BoundingBox() : Center(0.0f, 0.0f, 0.0f), Extents(1.0f, 1.0f, 1.0f) {}
+		BoundingBox(const XMFLOAT3& center, const XMFLOAT3& extents) : Center(center), Extents(extents) {}
+	};
+}
@@ -0,0 +1,252 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+// Scalar stand-in of the subset of DirectXMath used by the portable modules, so they can be
+// built and tested on platforms without the Windows SDK. It is only in the include path of
+// the tests on those platforms (see CMakeLists.txt). Windows builds use the real DirectXMath.
+// Results match DirectXMath, but its performance does not, so benchmark numbers of the
+// modules that use DirectXMath must be taken on Windows.
+#define XM_CALLCONV
+
+namespace DirectX {
+	struct XMFLOAT2 {
+		float x;
+		float y;
+
+		XMFLOAT2() = default;
+		constexpr XMFLOAT2(const float _x, const float _y) : x(_x), y(_y) {}
+	};
+
+	struct XMFLOAT3 {
+		float x;
+		float y;
+		float z;
+
+		XMFLOAT3() = default;
+		constexpr XMFLOAT3(const float _x, const float _y, const float _z) : x(_x), y(_y), z(_z) {}
+	};
+
+	struct XMFLOAT4 {
+		float x;
+		float y;
+		float z;
+		float w;
+
+		XMFLOAT4() = default;
+		constexpr XMFLOAT4(const float _x, const float _y, const float _z, const float _w) : x(_x), y(_y), z(_z), w(_w) {}
+	};
+
+	struct XMUINT4 {
+		std::uint32_t x;
+		std::uint32_t y;
+		std::uint32_t z;
+		std::uint32_t w;
+
+		XMUINT4() = default;
+		constexpr XMUINT4(const std::uint32_t _x, const std::uint32_t _y, const std::uint32_t _z, const std::uint32_t _w)
+			: x(_x), y(_y), z(_z), w(_w) {}
+	};
+
+	struct XMFLOAT4X4 {
+		float m[4][4];
+
+		XMFLOAT4X4() = default;
+		constexpr XMFLOAT4X4(
+			const float m00, const float m01, const float m02, const float m03,
+			const float m10, const float m11, const float m12, const float m13,
+			const float m20, const float m21, const float m22, const float m23,
+			const float m30, const float m31, const float m32, const float m33)
+			: m{ { m00, m01, m02, m03 },{ m10, m11, m12, m13 },{ m20, m21, m22, m23 },{ m30, m31, m32, m33 } } {}
+
+		float operator() (const std::size_t row, const std::size_t column) const noexcept { return m[row][column]; }
+		float& operator() (const std::size_t row, const std::size_t column) noexcept { return m[row][column]; }
+	};
+
+	struct XMVECTOR {
+		float v[4];
+	};
+
+	using FXMVECTOR = const XMVECTOR;
+	using GXMVECTOR = const XMVECTOR;
+	using HXMVECTOR = const XMVECTOR;
+	using CXMVECTOR = const XMVECTOR&;
+
+	struct XMMATRIX {
+		XMVECTOR r[4];
+
+		XMMATRIX() = default;
+		XMMATRIX(const XMVECTOR& r0, const XMVECTOR& r1, const XMVECTOR& r2, const XMVECTOR& r3) : r{ r0, r1, r2, r3 } {}
+	};
+
+	using FXMMATRIX = const XMMATRIX&;
+	using CXMMATRIX = const XMMATRIX&;
+
+	namespace Internal {
+		inline std::uint32_t AsUInt(const float value) noexcept {
+			std::uint32_t result;
+			std::memcpy(&result, &value, sizeof(result));
+			return result;
+		}
+
+		inline float AsFloat(const std::uint32_t value) noexcept {
+			float result;
+			std::memcpy(&result, &value, sizeof(result));
+			return result;
+		}
+	}
+
+	inline XMVECTOR XMVectorSet(const float x, const float y, const float z, const float w) noexcept {
+		return XMVECTOR{ { x, y, z, w } };
+	}
+
+	inline XMVECTOR XMVectorZero() noexcept { return XMVectorSet(0.0f, 0.0f, 0.0f, 0.0f); }
+	inline XMVECTOR XMVectorReplicate(const float value) noexcept { return XMVectorSet(value, value, value, value); }
+	inline XMVECTOR XMVectorTrueInt() noexcept { return XMVectorReplicate(Internal::AsFloat(0xFFFFFFFFU)); }
+
+	inline XMVECTOR XMVectorSplatX(FXMVECTOR v) noexcept { return XMVectorReplicate(v.v[0]); }
+	inline XMVECTOR XMVectorSplatY(FXMVECTOR v) noexcept { return XMVectorReplicate(v.v[1]); }
+	inline XMVECTOR XMVectorSplatZ(FXMVECTOR v) noexcept { return XMVectorReplicate(v.v[2]); }
+	inline XMVECTOR XMVectorSplatW(FXMVECTOR v) noexcept { return XMVectorReplicate(v.v[3]); }
+
+	inline float XMVectorGetX(FXMVECTOR v) noexcept { return v.v[0]; }
+	inline float XMVectorGetY(FXMVECTOR v) noexcept { return v.v[1]; }
+	inline float XMVectorGetZ(FXMVECTOR v) noexcept { return v.v[2]; }
+	inline float XMVectorGetW(FXMVECTOR v) noexcept { return v.v[3]; }
+
+	inline XMVECTOR XMLoadFloat3(const XMFLOAT3* source) noexcept {
+		return XMVectorSet(source->x, source->y, source->z, 0.0f);
+	}
+
+	inline XMVECTOR XMLoadFloat4(const XMFLOAT4* source) noexcept {
+		return XMVectorSet(source->x, source->y, source->z, source->w);
+	}
+
+	inline void XMStoreFloat3(XMFLOAT3* destination, FXMVECTOR v) noexcept {
+		*destination = XMFLOAT3(v.v[0], v.v[1], v.v[2]);
+	}
+
+	inline void XMStoreFloat4(XMFLOAT4* destination, FXMVECTOR v) noexcept {
+		*destination = XMFLOAT4(v.v[0], v.v[1], v.v[2], v.v[3]);
+	}
+
+	inline void XMStoreUInt4(XMUINT4* destination, FXMVECTOR v) noexcept {
+		*destination = XMUINT4(
+			Internal::AsUInt(v.v[0]),
+			Internal::AsUInt(v.v[1]),
+			Internal::AsUInt(v.v[2]),
+			Internal::AsUInt(v.v[3]));
+	}
+
+	inline XMVECTOR XMVectorAdd(FXMVECTOR a, FXMVECTOR b) noexcept {
+		return XMVectorSet(a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3]);
+	}
+
+	inline XMVECTOR XMVectorSubtract(FXMVECTOR a, FXMVECTOR b) noexcept {
+		return XMVectorSet(a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3]);
+	}
+
+	inline XMVECTOR XMVectorMultiply(FXMVECTOR a, FXMVECTOR b) noexcept {
+		return XMVectorSet(a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3]);
+	}
+
+	inline XMVECTOR XMVectorMultiplyAdd(FXMVECTOR a, FXMVECTOR b, FXMVECTOR c) noexcept {
+		return XMVectorAdd(XMVectorMultiply(a, b), c);
+	}
+
+	inline XMVECTOR XMVectorScale(FXMVECTOR v, const float scale) noexcept {
+		return XMVectorMultiply(v, XMVectorReplicate(scale));
+	}
+
+	inline XMVECTOR XMVectorNegate(FXMVECTOR v) noexcept {
+		return XMVectorSubtract(XMVectorZero(), v);
+	}
+
+	inline XMVECTOR XMVectorAndInt(FXMVECTOR a, FXMVECTOR b) noexcept {
+		XMVECTOR result;
+		for (std::uint32_t i = 0U; i < 4U; ++i) {
+			result.v[i] = Internal::AsFloat(Internal::AsUInt(a.v[i]) & Internal::AsUInt(b.v[i]));
+		}
+		return result;
+	}
+
+	inline XMVECTOR XMVectorGreaterOrEqual(FXMVECTOR a, FXMVECTOR b) noexcept {
+		XMVECTOR result;
+		for (std::uint32_t i = 0U; i < 4U; ++i) {
+			result.v[i] = Internal::AsFloat(a.v[i] >= b.v[i] ? 0xFFFFFFFFU : 0U);
+		}
+		return result;
+	}
+
+	inline bool XMVector4Less(FXMVECTOR a, FXMVECTOR b) noexcept {
+		return a.v[0] < b.v[0] && a.v[1] < b.v[1] && a.v[2] < b.v[2] && a.v[3] < b.v[3];
+	}
+
+	inline XMVECTOR XMVector3Dot(FXMVECTOR a, FXMVECTOR b) noexcept {
+		return XMVectorReplicate(a.v[0] * b.v[0] + a.v[1] * b.v[1] + a.v[2] * b.v[2]);
+	}
+
+	inline XMVECTOR XMVector3LengthSq(FXMVECTOR v) noexcept { return XMVector3Dot(v, v); }
+	inline XMVECTOR XMVector3Length(FXMVECTOR v) noexcept { return XMVectorReplicate(std::sqrt(XMVectorGetX(XMVector3LengthSq(v)))); }
+
+	inline XMVECTOR XMVector3Cross(FXMVECTOR a, FXMVECTOR b) noexcept {
+		return XMVectorSet(
+			a.v[1] * b.v[2] - a.v[2] * b.v[1],
+			a.v[2] * b.v[0] - a.v[0] * b.v[2],
+			a.v[0] * b.v[1] - a.v[1] * b.v[0],
+			0.0f);
+	}
+
+	inline XMVECTOR XMVector3Normalize(FXMVECTOR v) noexcept {
+		const float length{ XMVectorGetX(XMVector3Length(v)) };
+		return length > 0.0f ? XMVectorScale(v, 1.0f / length) : XMVectorZero();
+	}
+
+	inline XMVECTOR XMPlaneDotCoord(FXMVECTOR plane, FXMVECTOR point) noexcept {
+		return XMVectorReplicate(plane.v[0] * point.v[0] + plane.v[1] * point.v[1] + plane.v[2] * point.v[2] + plane.v[3]);
+	}
+
+	inline XMVECTOR XMPlaneNormalize(FXMVECTOR plane) noexcept {
+		const float length{ XMVectorGetX(XMVector3Length(plane)) };
+		return length > 0.0f ? XMVectorScale(plane, 1.0f / length) : XMVectorZero();
+	}
+
+	inline XMMATRIX XMLoadFloat4x4(const XMFLOAT4X4* source) noexcept {
+		XMMATRIX result;
+		for (std::uint32_t i = 0U; i < 4U; ++i) {
+			result.r[i] = XMVectorSet(source->m[i][0], source->m[i][1], source->m[i][2], source->m[i][3]);
+		}
+		return result;
+	}
+
+	inline void XMStoreFloat4x4(XMFLOAT4X4* destination, FXMMATRIX m) noexcept {
+		for (std::uint32_t i = 0U; i < 4U; ++i) {
+			for (std::uint32_t j = 0U; j < 4U; ++j) {
+				destination->m[i][j] = m.r[i].v[j];
+			}
+		}
+	}
+
+	inline XMMATRIX XMMatrixMultiply(FXMMATRIX a, CXMMATRIX b) noexcept {
+		XMMATRIX result;
+		for (std::uint32_t i = 0U; i < 4U; ++i) {
+			for (std::uint32_t j = 0U; j < 4U; ++j) {
+				result.r[i].v[j] = a.r[i].v[0] * b.r[0].v[j] + a.r[i].v[1] * b.r[1].v[j] +
+					a.r[i].v[2] * b.r[2].v[j] + a.r[i].v[3] * b.r[3].v[j];
+			}
+		}
+		return result;
+	}
+
+	inline XMMATRIX XMMatrixTranspose(FXMMATRIX m) noexcept {
+		XMMATRIX result;
+		for (std::uint32_t i = 0U; i < 4U; ++i) {
+			for (std::uint32_t j = 0U; j < 4U; ++j) {
+				result.r[i].v[j] = m.r[j].v[i];
+			}
+		}
+		return result;
+	}
+}
@@ -0,0 +1,233 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <GeometryGenerator/GeometryGenerator.h>
+#include <TestUtils.h>
+
+// Meshes for the tests and the benchmarks of the mesh processing modules (see ModelManager).
+// GeometryGenerator.cpp is not built by the tests, so only MeshData and Vertex members are used.
+namespace MeshTestUtils {
+	// Reads the positions, normals, texture coordinates and faces (triangulated as fans)
+	// of Wavefront OBJ data. Vertices with the same position, normal and texture coordinates are shared.
+	// Returns false if the data cannot be read or it has no faces.
+	inline bool ReadObj(std::istream& stream, GeometryGenerator::MeshData& meshData) {
+		std::vector<DirectX::XMFLOAT3> positions;
+		std::vector<DirectX::XMFLOAT3> normals;
+		std::vector<DirectX::XMFLOAT2> uvs;
+		std::map<std::tuple<int, int, int>, std::uint32_t> vertexIndexByCorner;
+		std::vector<std::uint32_t> faceVertexIndices;
+		std::string line;
+		while (std::getline(stream, line)) {
+			std::istringstream lineStream(line);
+			std::string keyword;
+			lineStream >> keyword;
+			if (keyword == "v") {
+				DirectX::XMFLOAT3 position{ 0.0f, 0.0f, 0.0f };
+				lineStream >> position.x >> position.y >> position.z;
+				positions.push_back(position);
+			} else if (keyword == "vn") {
+				DirectX::XMFLOAT3 normal{ 0.0f, 0.0f, 0.0f };
+				lineStream >> normal.x >> normal.y >> normal.z;
+				normals.push_back(normal);
+			} else if (keyword == "vt") {
+				DirectX::XMFLOAT2 uv{ 0.0f, 0.0f };
+				lineStream >> uv.x >> uv.y;
+				uvs.push_back(uv);
+			} else if (keyword == "f") {
+				faceVertexIndices.clear();
+				std::string corner;
+				while (lineStream >> corner) {
+					int positionIndex{ 0 };
+					int uvIndex{ 0 };
+					int normalIndex{ 0 };
+					if (corner.find("//") != std::string::npos) {
+						std::sscanf(corner.c_str(), "%d//%d", &positionIndex, &normalIndex);
+					} else {
+						std::sscanf(corner.c_str(), "%d/%d/%d", &positionIndex, &uvIndex, &normalIndex);
+					}
+					if (positionIndex <= 0 || static_cast<std::size_t>(positionIndex) > positions.size()) {
+						return false;
+					}
+
+					const std::tuple<int, int, int> key{ positionIndex, uvIndex, normalIndex };
+					const auto it = vertexIndexByCorner.find(key);
+					if (it != vertexIndexByCorner.end()) {
+						faceVertexIndices.push_back(it->second);
+						continue;
+					}
+
+					GeometryGenerator::Vertex vertex;
+					vertex.mPosition = positions[positionIndex - 1];
+					if (normalIndex > 0 && static_cast<std::size_t>(normalIndex) <= normals.size()) {
+						vertex.mNormal = normals[normalIndex - 1];
+					}
+					if (uvIndex > 0 && static_cast<std::size_t>(uvIndex) <= uvs.size()) {
+						vertex.mUV = uvs[uvIndex - 1];
+					}
+					const std::uint32_t vertexIndex{ static_cast<std::uint32_t>(meshData.mVertices.size()) };
+					meshData.mVertices.push_back(vertex);
+					vertexIndexByCorner[key] = vertexIndex;
+					faceVertexIndices.push_back(vertexIndex);
+				}
+
+				for (std::size_t i = 2UL; i < faceVertexIndices.size(); ++i) {
+					meshData.mIndices32.push_back(faceVertexIndices[0UL]);
+					meshData.mIndices32.push_back(faceVertexIndices[i - 1UL]);
+					meshData.mIndices32.push_back(faceVertexIndices[i]);
+				}
+			}
+		}
+
+		return meshData.mIndices32.empty() == false;
+	}
+
+	// Reads a Wavefront OBJ file (see ReadObj())
+	inline bool ReadObjFile(const std::string& filePath, GeometryGenerator::MeshData& meshData) {
+		std::ifstream file(filePath);
+		if (file.is_open() == false) {
+			return false;
+		}
+
+		return ReadObj(file, meshData);
+	}
+
+	// Paths of the models in external/resources/models
+	inline std::vector<std::string> GetModelFilePaths() {
+		return TestUtils::GetFilePaths(TestUtils::GetResourcesPath() + "models", ".obj");
+	}
+
+	// Grid of "cellCountX" x "cellCountZ" cells of size 1 in the XZ plane, facing +Y,
+	// with texture coordinates from 0 to 1
+	inline void CreateGrid(const std::uint32_t cellCountX, const std::uint32_t cellCountZ, GeometryGenerator::MeshData& meshData) {
+		meshData.mVertices.clear();
+		meshData.mIndices32.clear();
+		for (std::uint32_t z = 0U; z <= cellCountZ; ++z) {
+			for (std::uint32_t x = 0U; x <= cellCountX; ++x) {
+				GeometryGenerator::Vertex vertex;
+				vertex.mPosition = DirectX::XMFLOAT3(static_cast<float>(x), 0.0f, static_cast<float>(z));
+				vertex.mNormal = DirectX::XMFLOAT3(0.0f, 1.0f, 0.0f);
+				vertex.mUV = DirectX::XMFLOAT2(
+					static_cast<float>(x) / static_cast<float>(cellCountX),
+					static_cast<float>(z) / static_cast<float>(cellCountZ));
+				meshData.mVertices.push_back(vertex);
+			}
+		}
+
+		const std::uint32_t rowVertexCount{ cellCountX + 1U };
+		for (std::uint32_t z = 0U; z < cellCountZ; ++z) {
+			for (std::uint32_t x = 0U; x < cellCountX; ++x) {
+				const std::uint32_t vertex0{ z * rowVertexCount + x };
+				const std::uint32_t vertex1{ vertex0 + 1U };
+				const std::uint32_t vertex2{ vertex0 + rowVertexCount };
+				const std::uint32_t vertex3{ vertex2 + 1U };
+				meshData.mIndices32.insert(meshData.mIndices32.end(), { vertex0, vertex2, vertex1 });
+				meshData.mIndices32.insert(meshData.mIndices32.end(), { vertex1, vertex2, vertex3 });
+			}
+		}
+	}
+
+	// Unit sphere of "sliceCount" x "stackCount" quads around the Z axis, with U increasing with the
+	// longitude and V with the latitude. Vertices of the seam and the poles are not shared.
+	inline void CreateSphere(const std::uint32_t sliceCount, const std::uint32_t stackCount, GeometryGenerator::MeshData& meshData) {
+		const float pi{ 3.14159265358979f };
+		meshData.mVertices.clear();
+		meshData.mIndices32.clear();
+		for (std::uint32_t j = 0U; j <= stackCount; ++j) {
+			for (std::uint32_t i = 0U; i <= sliceCount; ++i) {
+				const float theta{ pi * static_cast<float>(j) / static_cast<float>(stackCount) };
+				const float phi{ 2.0f * pi * static_cast<float>(i) / static_cast<float>(sliceCount) };
+				GeometryGenerator::Vertex vertex;
+				vertex.mPosition = DirectX::XMFLOAT3(std::sin(theta) * std::cos(phi), std::sin(theta) * std::sin(phi), std::cos(theta));
+				vertex.mNormal = vertex.mPosition;
+				vertex.mUV = DirectX::XMFLOAT2(
+					static_cast<float>(i) / static_cast<float>(sliceCount),
+					static_cast<float>(j) / static_cast<float>(stackCount));
+				meshData.mVertices.push_back(vertex);
+			}
+		}
+
+		const std::uint32_t rowVertexCount{ sliceCount + 1U };
+		for (std::uint32_t j = 0U; j < stackCount; ++j) {
+			for (std::uint32_t i = 0U; i < sliceCount; ++i) {
+				const std::uint32_t vertex0{ j * rowVertexCount + i };
+				const std::uint32_t vertex1{ vertex0 + 1U };
+				const std::uint32_t vertex2{ vertex0 + rowVertexCount };
+				const std::uint32_t vertex3{ vertex2 + 1U };
+				meshData.mIndices32.insert(meshData.mIndices32.end(), { vertex0, vertex2, vertex1 });
+				meshData.mIndices32.insert(meshData.mIndices32.end(), { vertex1, vertex2, vertex3 });
+			}
+		}
+	}
+
+	// Shuffles the triangles (not the vertices inside them), to get the worst vertex cache order
+	inline void ShuffleTriangles(std::vector<std::uint32_t>& indices, const std::uint32_t seed) {
+		const std::size_t triangleCount{ indices.size() / 3UL };
+		std::vector<std::size_t> triangleOrder(triangleCount);
+		for (std::size_t i = 0UL; i < triangleCount; ++i) {
+			triangleOrder[i] = i;
+		}
+		std::shuffle(triangleOrder.begin(), triangleOrder.end(), std::mt19937(seed));
+
+		std::vector<std::uint32_t> shuffledIndices;
+		shuffledIndices.reserve(indices.size());
+		for (const std::size_t triangle : triangleOrder) {
+			shuffledIndices.insert(shuffledIndices.end(), indices.begin() + triangle * 3UL, indices.begin() + triangle * 3UL + 3UL);
+		}
+		indices.swap(shuffledIndices);
+	}
+
+	// Angle in degrees between two vectors. It uses doubles and atan2(), because the dot product
+	// of small angles (below 0.02 degrees) rounds to 1.0f in floats.
+	inline double GetAngle(const DirectX::XMFLOAT3& vector1, const DirectX::XMFLOAT3& vector2) {
+		const double crossX{ static_cast<double>(vector1.y) * vector2.z - static_cast<double>(vector1.z) * vector2.y };
+		const double crossY{ static_cast<double>(vector1.z) * vector2.x - static_cast<double>(vector1.x) * vector2.z };
+		const double crossZ{ static_cast<double>(vector1.x) * vector2.y - static_cast<double>(vector1.y) * vector2.x };
+		const double dot{ 
+			static_cast<double>(vector1.x) * vector2.x + 
+			static_cast<double>(vector1.y) * vector2.y + 
+			static_cast<double>(vector1.z) * vector2.z };
+
+		return std::atan2(std::sqrt(crossX * crossX + crossY * crossY + crossZ * crossZ), dot) * 180.0 / 3.14159265358979;
+	}
+
+	using TrianglePositions = std::array<float, 9U>;
+
+	// Positions of the triangles, with their vertices rotated to start with the smallest one and sorted,
+	// so meshes with the same triangles in different orders (or with reordered vertices) are equal.
+	inline std::vector<TrianglePositions> GetSortedTrianglePositions(
+		const std::vector<std::uint32_t>& indices,
+		const std::vector<GeometryGenerator::Vertex>& vertices)
+	{
+		std::vector<TrianglePositions> triangles;
+		triangles.reserve(indices.size() / 3UL);
+		for (std::size_t i = 0UL; i + 2UL < indices.size(); i += 3UL) {
+			std::array<std::array<float, 3U>, 3U> corners;
+			for (std::size_t j = 0UL; j < 3UL; ++j) {
+				const DirectX::XMFLOAT3& position{ vertices[indices[i + j]].mPosition };
+				corners[j] = { position.x, position.y, position.z };
+			}
+			std::rotate(corners.begin(), std::min_element(corners.begin(), corners.end()), corners.end());
+
+			TrianglePositions triangle;
+			for (std::size_t j = 0UL; j < 9UL; ++j) {
+				triangle[j] = corners[j / 3UL][j % 3UL];
+			}
+			triangles.push_back(triangle);
+		}
+		std::sort(triangles.begin(), triangles.end());
+
+		return triangles;
+	}
+}
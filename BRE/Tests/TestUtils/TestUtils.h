@@ -0,0 +1,97 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// Minimal helpers for the unit tests and the benchmarks of the portable modules.
+// A failed CHECK() reports its condition and the test goes on, so a run reports all the failures.
+// Test executables return the number of failures (see GetFailureCount()).
+#define CHECK(condition) \
+	TestUtils::Check(static_cast<bool>(condition), #condition, __FILE__, __LINE__)
+
+#define RUN_TEST(testFunction) \
+	TestUtils::RunTest(testFunction, #testFunction)
+
+namespace TestUtils {
+	inline std::uint32_t& GetFailureCountRef() noexcept {
+		static std::uint32_t failureCount{ 0U };
+		return failureCount;
+	}
+
+	inline std::uint32_t GetFailureCount() noexcept {
+		return GetFailureCountRef();
+	}
+
+	inline bool Check(const bool condition, const char* conditionString, const char* file, const int line) noexcept {
+		if (condition == false) {
+			++GetFailureCountRef();
+			std::fprintf(stderr, "%s(%d): CHECK(%s) failed\n", file, line, conditionString);
+		}
+
+		return condition;
+	}
+
+	template<typename TestFunction>
+	void RunTest(TestFunction testFunction, const char* testName) {
+		const std::uint32_t previousFailureCount{ GetFailureCount() };
+		testFunction();
+		std::printf("%s %s\n", GetFailureCount() == previousFailureCount ? "[PASSED]" : "[FAILED]", testName);
+	}
+
+	// Path of external/resources (with a trailing separator), defined by the build
+	inline std::string GetResourcesPath() noexcept {
+		return BRE_RESOURCES_PATH;
+	}
+
+	// Returns the sorted paths of the files in "directoryPath" and in its subdirectories
+	// whose extension is "extension" (for example, ".dds")
+	inline std::vector<std::string> GetFilePaths(const std::string& directoryPath, const std::string& extension) {
+		std::vector<std::string> filePaths;
+		for (const std::filesystem::directory_entry& entry : std::filesystem::recursive_directory_iterator(directoryPath)) {
+			if (entry.is_regular_file() && entry.path().extension() == extension) {
+				filePaths.push_back(entry.path().string());
+			}
+		}
+
+		std::sort(filePaths.begin(), filePaths.end());
+		return filePaths;
+	}
+
+	// Path of a temporary file for the tests that write files
+	inline std::string GetTemporaryFilePath(const std::string& fileName) {
+		return (std::filesystem::temp_directory_path() / fileName).string();
+	}
+
+	class Stopwatch {
+	public:
+		Stopwatch() : mStart(std::chrono::steady_clock::now()) {}
+
+		void Restart() noexcept { mStart = std::chrono::steady_clock::now(); }
+
+		double GetElapsedMilliseconds() const noexcept {
+			return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - mStart).count();
+		}
+
+	private:
+		std::chrono::steady_clock::time_point mStart;
+	};
+
+	// Runs "function" "repetitionCount" times and returns the minimum time in milliseconds,
+	// which is the least noisy measure of short benchmarks
+	template<typename Function>
+	double MeasureMinimumMilliseconds(const std::uint32_t repetitionCount, Function function) {
+		double minimumTime{ 1.0e30 };
+		for (std::uint32_t i = 0U; i < repetitionCount; ++i) {
+			Stopwatch stopwatch;
+			function();
+			minimumTime = std::min<double>(minimumTime, stopwatch.GetElapsedMilliseconds());
+		}
+
+		return minimumTime;
+	}
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <ResourceManager/BlockCompressor.h>
+#include <ResourceManager/DDSTextureParser.h>
+#include <TestUtils.h>
+#include <Utils/MemoryMappedFile.h>
+
+// Images for the tests and the benchmarks of the texture processing modules (BlockCompressor, MipGenerator).
+namespace TextureTestUtils {
+	// RGBA8 texels, row by row (4 * width bytes per row)
+	struct Image {
+		std::string mName;
+		std::uint32_t mWidth{ 0U };
+		std::uint32_t mHeight{ 0U };
+		std::vector<std::uint8_t> mTexels;
+	};
+
+	// Reads the first mip of the first array slice of a DDS file as RGBA8. Only RGBA8, BGRA8, BC1 and BC3
+	// files are read. The image is cropped to "maxDimension" x "maxDimension" texels (if it is not zero), 
+	// so tests of large textures are fast. Returns false if the file cannot be read.
+	inline bool ReadImage(const std::string& filePath, const std::uint32_t maxDimension, Image& image) {
+		MemoryMappedFile file;
+		if (file.Open(filePath.c_str()) == false) {
+			return false;
+		}
+
+		DDSTextureParser::TextureInfo textureInfo;
+		if (DDSTextureParser::ParseHeader(file.GetData(), file.GetSize(), textureInfo) != DDSTextureParser::Result::SUCCESS ||
+			textureInfo.mDimension != DDSTextureParser::Dimension::TEXTURE2D) {
+			return false;
+		}
+
+		std::vector<DDSTextureParser::SubresourceLayout> layouts(static_cast<std::size_t>(textureInfo.mMipCount) * textureInfo.mArraySize);
+		std::uint32_t skippedMipCount{ 0U };
+		std::uint32_t width{ 0U };
+		std::uint32_t height{ 0U };
+		std::uint32_t depth{ 0U };
+		if (DDSTextureParser::ComputeSubresourceLayouts(
+			textureInfo, 0UL, file.GetSize(), layouts.data(), skippedMipCount, width, height, depth) != DDSTextureParser::Result::SUCCESS) {
+			return false;
+		}
+
+		std::vector<std::uint8_t> texels(static_cast<std::size_t>(width) * height * 4UL);
+		const std::uint8_t* data{ file.GetData() + layouts[0U].mOffset };
+		switch (textureInfo.mFormat) {
+		case DXGI_FORMAT_R8G8B8A8_UNORM:
+		case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+		case DXGI_FORMAT_B8G8R8A8_UNORM:
+		case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+			for (std::uint32_t y = 0U; y < height; ++y) {
+				std::memcpy(&texels[y * width * 4UL], data + y * layouts[0U].mRowPitch, width * 4UL);
+			}
+			if (textureInfo.mFormat == DXGI_FORMAT_B8G8R8A8_UNORM || textureInfo.mFormat == DXGI_FORMAT_B8G8R8A8_UNORM_SRGB) {
+				for (std::size_t i = 0UL; i < texels.size(); i += 4UL) {
+					std::swap(texels[i], texels[i + 2UL]);
+				}
+			}
+			break;
+		case DXGI_FORMAT_BC1_UNORM:
+		case DXGI_FORMAT_BC1_UNORM_SRGB:
+			BlockCompressor::DecompressImage(data, width, height, BlockCompressor::Format::BC1, texels.data());
+			break;
+		case DXGI_FORMAT_BC3_UNORM:
+		case DXGI_FORMAT_BC3_UNORM_SRGB:
+			BlockCompressor::DecompressImage(data, width, height, BlockCompressor::Format::BC3, texels.data());
+			break;
+		default:
+			return false;
+		}
+
+		image.mName = filePath.substr(filePath.find_last_of("/\\") + 1UL);
+		image.mWidth = maxDimension == 0U ? width : std::min<std::uint32_t>(width, maxDimension);
+		image.mHeight = maxDimension == 0U ? height : std::min<std::uint32_t>(height, maxDimension);
+		image.mTexels.resize(static_cast<std::size_t>(image.mWidth) * image.mHeight * 4UL);
+		for (std::uint32_t y = 0U; y < image.mHeight; ++y) {
+			std::memcpy(&image.mTexels[y * image.mWidth * 4UL], &texels[y * width * 4UL], image.mWidth * 4UL);
+		}
+
+		return true;
+	}
+
+	// Images of the DDS files in external/resources/textures that ReadImage() can read
+	inline std::vector<Image> ReadResourceImages(const std::uint32_t maxDimension) {
+		std::vector<Image> images;
+		for (const std::string& filePath : TestUtils::GetFilePaths(TestUtils::GetResourcesPath() + "textures", ".dds")) {
+			Image image;
+			if (ReadImage(filePath, maxDimension, image)) {
+				images.push_back(image);
+			}
+		}
+
+		return images;
+	}
+}
@@ -0,0 +1,168 @@
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <ResourceManager/BlockCompressor.h>
+#include <TestUtils.h>
+#include <TextureTestUtils.h>
+
+namespace {
+	const BlockCompressor::Format sFormats[]{
+		BlockCompressor::Format::BC1,
+		BlockCompressor::Format::BC3,
+		BlockCompressor::Format::BC4,
+		BlockCompressor::Format::BC5,
+		BlockCompressor::Format::BC7 };
+
+	const char* GetFormatName(const BlockCompressor::Format format) {
+		const char* formatNames[]{ "BC1", "BC3", "BC4", "BC5", "BC7" };
+		return formatNames[static_cast<std::uint32_t>(format)];
+	}
+
+	// Minimum PSNR (in decibels) of the images of external/resources/textures. They are about 1 dB
+	// below the worst image (floor_normal.dds for BC1, BC3 and BC7, asphalt.dds for BC4 and BC5).
+	float GetMinPSNR(const BlockCompressor::Format format) {
+		const float minPSNRs[]{ 34.5f, 36.0f, 39.0f, 39.0f, 38.0f };
+		return minPSNRs[static_cast<std::uint32_t>(format)];
+	}
+
+	// Blocks built by hand from the format specifications
+	void TestDecompressSpecificationBlocks() {
+		std::uint8_t texels[64U];
+
+		// BC1 with 4 colors: red and blue endpoints, and texels 0 to 3 with indices 0 to 3
+		const std::uint8_t bc1Block[8U]{ 0x00U, 0xF8U, 0x1FU, 0x00U, 0xE4U, 0x00U, 0x00U, 0x00U };
+		BlockCompressor::DecompressBlock(bc1Block, BlockCompressor::Format::BC1, texels);
+		CHECK(texels[0U] == 255U && texels[2U] == 0U && texels[3U] == 255U);
+		CHECK(texels[4U] == 0U && texels[6U] == 255U);
+		CHECK(texels[8U] == 170U && texels[10U] == 85U);
+		CHECK(texels[12U] == 85U && texels[14U] == 170U);
+
+		// BC1 with 3 colors (first endpoint is not greater than the second one): index 3 is transparent black
+		const std::uint8_t bc1TransparentBlock[8U]{ 0x1FU, 0x00U, 0x00U, 0xF8U, 0xE4U, 0x00U, 0x00U, 0x00U };
+		BlockCompressor::DecompressBlock(bc1TransparentBlock, BlockCompressor::Format::BC1, texels);
+		CHECK(texels[8U] == 128U && texels[10U] == 128U);
+		CHECK(texels[12U] == 0U && texels[15U] == 0U);
+
+		// BC4 with 8 values (255 and 0), and texels 0 to 2 with indices 0 to 2: (6 * 255 + 1 * 0) / 7 = 219
+		const std::uint8_t bc4Block[8U]{ 255U, 0U, (0U | (1U << 3U) | (2U << 6U)), 0U, 0U, 0U, 0U, 0U };
+		BlockCompressor::DecompressBlock(bc4Block, BlockCompressor::Format::BC4, texels);
+		CHECK(texels[0U] == 255U && texels[4U] == 0U && texels[8U] == 219U);
+
+		// BC4 with 6 values (first endpoint is not greater than the second one): indices 6 and 7 are 0 and 255
+		const std::uint8_t bc4SixValuesBlock[8U]{ 0U, 255U, (6U | (7U << 3U)), 0U, 0U, 0U, 0U, 0U };
+		BlockCompressor::DecompressBlock(bc4SixValuesBlock, BlockCompressor::Format::BC4, texels);
+		CHECK(texels[0U] == 0U && texels[4U] == 255U);
+
+		// BC7 mode 6 with zero endpoints and p-bits is transparent black
+		std::uint8_t bc7Block[16U]{};
+		bc7Block[0U] = 0x40U;
+		BlockCompressor::DecompressBlock(bc7Block, BlockCompressor::Format::BC7, texels);
+		CHECK(texels[0U] == 0U && texels[3U] == 0U);
+
+		// BC7 mode 6 with all the bits of the endpoints and p-bits set is white
+		std::memset(bc7Block, 0xFF, sizeof(bc7Block));
+		bc7Block[0U] = 0xC0U;
+		BlockCompressor::DecompressBlock(bc7Block, BlockCompressor::Format::BC7, texels);
+		CHECK(texels[0U] == 255U && texels[1U] == 255U && texels[2U] == 255U && texels[3U] == 255U);
+	}
+
+	void TestConstantBlocks() {
+		std::mt19937 generator(3U);
+		for (const BlockCompressor::Format format : sFormats) {
+			float minPSNR{ INFINITY };
+			for (std::uint32_t i = 0U; i < 256U; ++i) {
+				std::uint8_t texels[64U];
+				const std::uint8_t color[4U]{
+					static_cast<std::uint8_t>(generator()),
+					static_cast<std::uint8_t>(generator()),
+					static_cast<std::uint8_t>(generator()),
+					255U };
+				for (std::uint32_t j = 0U; j < 16U; ++j) {
+					std::memcpy(texels + j * 4U, color, sizeof(color));
+				}
+
+				std::uint8_t block[16U];
+				std::uint8_t decompressedTexels[64U];
+				BlockCompressor::CompressBlock(texels, format, block);
+				BlockCompressor::DecompressBlock(block, format, decompressedTexels);
+				minPSNR = std::fmin(minPSNR, BlockCompressor::ComputePSNR(texels, decompressedTexels, 16UL, format));
+			}
+			CHECK(minPSNR > 35.0f);
+		}
+	}
+
+	// Images are compressed in parallel, and they must be the same as compressing their blocks one at a time.
+	// Blocks on the edges repeat the last column and row of the image.
+	void TestCompressImageMatchesBlocks() {
+		const std::uint32_t width{ 62U };
+		const std::uint32_t height{ 37U };
+		std::mt19937 generator(3U);
+		std::vector<std::uint8_t> texels(width * height * 4U);
+		for (std::uint8_t& texel : texels) {
+			texel = static_cast<std::uint8_t>(generator());
+		}
+
+		const std::uint32_t blockCountX{ (width + 3U) / 4U };
+		const std::uint32_t blockCountY{ (height + 3U) / 4U };
+		for (const BlockCompressor::Format format : sFormats) {
+			const std::size_t blockSize{ BlockCompressor::GetBlockSize(format) };
+			std::vector<std::uint8_t> blocks(BlockCompressor::GetCompressedSize(width, height, format));
+			CHECK(blocks.size() == blockCountX * blockCountY * blockSize);
+			BlockCompressor::CompressImage(texels.data(), width, height, width * 4UL, format, blocks.data());
+
+			bool areEqual{ true };
+			for (std::uint32_t blockY = 0U; blockY < blockCountY; ++blockY) {
+				for (std::uint32_t blockX = 0U; blockX < blockCountX; ++blockX) {
+					std::uint8_t blockTexels[64U];
+					for (std::uint32_t y = 0U; y < 4U; ++y) {
+						for (std::uint32_t x = 0U; x < 4U; ++x) {
+							const std::uint32_t imageX{ std::min<std::uint32_t>(blockX * 4U + x, width - 1U) };
+							const std::uint32_t imageY{ std::min<std::uint32_t>(blockY * 4U + y, height - 1U) };
+							std::memcpy(blockTexels + (y * 4U + x) * 4U, &texels[(imageY * width + imageX) * 4U], 4UL);
+						}
+					}
+
+					std::uint8_t block[16U];
+					BlockCompressor::CompressBlock(blockTexels, format, block);
+					areEqual &= std::memcmp(block, &blocks[(blockY * blockCountX + blockX) * blockSize], blockSize) == 0;
+				}
+			}
+			CHECK(areEqual);
+		}
+	}
+
+	// Each image of external/resources/textures (cropped to 512 x 512 texels) must have 
+	// a minimum PSNR after it is compressed and decompressed
+	void TestResourceImagesPSNR() {
+		const std::vector<TextureTestUtils::Image> images{ TextureTestUtils::ReadResourceImages(512U) };
+		CHECK(images.empty() == false);
+		for (const BlockCompressor::Format format : sFormats) {
+			for (const TextureTestUtils::Image& image : images) {
+				std::vector<std::uint8_t> blocks(BlockCompressor::GetCompressedSize(image.mWidth, image.mHeight, format));
+				std::vector<std::uint8_t> decompressedTexels(image.mTexels.size());
+				BlockCompressor::CompressImage(image.mTexels.data(), image.mWidth, image.mHeight, image.mWidth * 4UL, format, blocks.data());
+				BlockCompressor::DecompressImage(blocks.data(), image.mWidth, image.mHeight, format, decompressedTexels.data());
+
+				const float psnr{ BlockCompressor::ComputePSNR(
+					image.mTexels.data(), decompressedTexels.data(), image.mTexels.size() / 4UL, format) };
+				if (psnr < GetMinPSNR(format)) {
+					std::printf("%s %s: %.2f dB\n", image.mName.c_str(), GetFormatName(format), psnr);
+				}
+				CHECK(psnr >= GetMinPSNR(format));
+			}
+		}
+	}
+}
+
+int main() {
+	RUN_TEST(TestDecompressSpecificationBlocks);
+	RUN_TEST(TestConstantBlocks);
+	RUN_TEST(TestCompressImageMatchesBlocks);
+	RUN_TEST(TestResourceImagesPSNR);
+
+	return static_cast<int>(TestUtils::GetFailureCount());
+}
@@ -0,0 +1,140 @@
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <TestUtils.h>
+#include <Utils/BlockingQueue.h>
+#include <Utils/CompletionLatch.h>
+
+namespace {
+	void TestLatchCount() {
+		CompletionLatch latch;
+		CHECK(latch.GetCount() == 0U);
+
+		latch.Increment(3U);
+		latch.Increment(2U);
+		CHECK(latch.GetCount() == 5U);
+
+		// It must not block, the count was already reached
+		latch.Wait(5U);
+		latch.Wait(0U);
+
+		latch.Reset();
+		CHECK(latch.GetCount() == 0U);
+	}
+
+	void TestLatchWaitBlocksUntilCountIsReached() {
+		CompletionLatch latch;
+		std::atomic<bool> isWaitCompleted{ false };
+		std::thread waitingThread([&latch, &isWaitCompleted]() {
+			latch.Wait(3U);
+			isWaitCompleted = true;
+		});
+
+		latch.Increment(1U);
+		latch.Increment(1U);
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		CHECK(isWaitCompleted == false);
+
+		latch.Increment(1U);
+		waitingThread.join();
+		CHECK(isWaitCompleted);
+	}
+
+	void TestQueueOrder() {
+		BlockingQueue<std::uint32_t> queue;
+		CHECK(queue.IsEmpty());
+
+		std::uint32_t element{ 0U };
+		CHECK(queue.TryPop(element) == false);
+
+		for (std::uint32_t i = 0U; i < 10U; ++i) {
+			queue.Push(i);
+		}
+		CHECK(queue.IsEmpty() == false);
+
+		CHECK(queue.TryPop(element) && element == 0U);
+
+		// It pops at most the requested number of elements, in FIFO order
+		std::uint32_t elements[4U];
+		CHECK(queue.WaitAndPop(elements, 4U) == 4U);
+		CHECK(elements[0U] == 1U && elements[1U] == 2U && elements[2U] == 3U && elements[3U] == 4U);
+		CHECK(queue.WaitAndPop(elements, 4U) == 4U);
+		CHECK(elements[0U] == 5U && elements[3U] == 8U);
+		CHECK(queue.WaitAndPop(elements, 4U) == 1U);
+		CHECK(elements[0U] == 9U);
+		CHECK(queue.IsEmpty());
+	}
+
+	void TestQueueClose() {
+		BlockingQueue<std::uint32_t> queue;
+		std::atomic<std::uint32_t> poppedElementCount{ 0U };
+		std::thread consumerThread([&queue, &poppedElementCount]() {
+			std::uint32_t elements[8U];
+			std::uint32_t count{ 0U };
+			while ((count = queue.WaitAndPop(elements, 8U)) != 0U) {
+				poppedElementCount += count;
+			}
+		});
+
+		// The consumer sleeps until Close() wakes it up
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		CHECK(poppedElementCount == 0U);
+
+		// Elements pushed before Close() are still popped
+		queue.Push(1U);
+		queue.Push(2U);
+		queue.Close();
+		consumerThread.join();
+		CHECK(poppedElementCount == 2U);
+
+		std::uint32_t element{ 0U };
+		CHECK(queue.WaitAndPop(&element, 1U) == 0U);
+	}
+
+	// Same handoff than the passes (producers) and CommandListExecutor (consumer)
+	void TestProducerConsumerHandoff() {
+		const std::uint32_t roundCount{ 1000U };
+		const std::uint32_t commandListCount{ 7U };
+
+		BlockingQueue<std::uint32_t> queue;
+		CompletionLatch latch;
+		std::atomic<std::uint64_t> executedSum{ 0UL };
+		std::thread executorThread([&queue, &latch, &executedSum]() {
+			std::uint32_t commandLists[4U];
+			std::uint32_t count{ 0U };
+			while ((count = queue.WaitAndPop(commandLists, 4U)) != 0U) {
+				for (std::uint32_t i = 0U; i < count; ++i) {
+					executedSum += commandLists[i];
+				}
+				latch.Increment(count);
+			}
+		});
+
+		std::uint64_t expectedSum{ 0UL };
+		for (std::uint32_t round = 0U; round < roundCount; ++round) {
+			latch.Reset();
+			for (std::uint32_t i = 0U; i < commandListCount; ++i) {
+				queue.Push(i);
+				expectedSum += i;
+			}
+			latch.Wait(commandListCount);
+			CHECK(latch.GetCount() == commandListCount);
+		}
+
+		queue.Close();
+		executorThread.join();
+		CHECK(executedSum == expectedSum);
+	}
+}
+
+int main() {
+	RUN_TEST(TestLatchCount);
+	RUN_TEST(TestLatchWaitBlocksUntilCountIsReached);
+	RUN_TEST(TestQueueOrder);
+	RUN_TEST(TestQueueClose);
+	RUN_TEST(TestProducerConsumerHandoff);
+
+	return static_cast<int>(TestUtils::GetFailureCount());
+}
@@ -0,0 +1,339 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <MeshTestUtils.h>
+#include <ModelManager/CookedModel.h>
+#include <ModelManager/MeshletBuilder.h>
+#include <ModelManager/MeshSimplifier.h>
+#include <ModelManager/VertexCompressor.h>
+#include <TestUtils.h>
+#include <Utils/MemoryMappedFile.h>
+
+namespace {
+	// Cooked model data aligned to CookedModel::sDataAlignment bytes, as the one of memory mapped files.
+	// Empty data has a block, as CookedModel::Read() does not accept nullptr.
+	struct alignas(CookedModel::sDataAlignment) DataBlock {
+		std::uint8_t mBytes[CookedModel::sDataAlignment];
+	};
+
+	class CookedModelData {
+	public:
+		explicit CookedModelData(const std::size_t dataSize)
+			: mBlocks(std::max<std::size_t>(1UL, (dataSize + CookedModel::sDataAlignment - 1UL) / CookedModel::sDataAlignment))
+			, mSize(dataSize)
+		{
+		}
+
+		std::uint8_t* GetData() noexcept { return mBlocks[0UL].mBytes; }
+		std::size_t GetSize() const noexcept { return mSize; }
+
+		CookedModel::FileHeader& GetFileHeader() noexcept { return *reinterpret_cast<CookedModel::FileHeader*>(GetData()); }
+		CookedModel::MeshHeader& GetMeshHeader(const std::size_t meshIndex) noexcept {
+			return reinterpret_cast<CookedModel::MeshHeader*>(GetData() + sizeof(CookedModel::FileHeader))[meshIndex];
+		}
+
+	private:
+		std::vector<DataBlock> mBlocks;
+		std::size_t mSize;
+	};
+
+	// Mesh as ModelCooker cooks it: levels of detail and meshlets of the full detail level
+	struct CookedMesh {
+		GeometryGenerator::MeshData mMeshData;
+		std::vector<MeshLod> mLods;
+		std::vector<Meshlet> mMeshlets;
+	};
+
+	void CookMesh(CookedMesh& mesh) {
+		MeshSimplifier::GenerateLods(mesh.mMeshData, mesh.mLods);
+		MeshletBuilder::BuildMeshlets(mesh.mMeshData, mesh.mLods[0U].mIndexCount, mesh.mMeshlets);
+	}
+
+	// Writes the meshes to a temporary file and returns its data (empty if it cannot be written or read)
+	CookedModelData WriteMeshes(const std::vector<CookedMesh>& meshes) {
+		std::vector<GeometryGenerator::MeshData> meshDatas;
+		std::vector<std::vector<MeshLod>> meshLods;
+		std::vector<std::vector<Meshlet>> meshMeshlets;
+		for (const CookedMesh& mesh : meshes) {
+			meshDatas.push_back(mesh.mMeshData);
+			meshLods.push_back(mesh.mLods);
+			meshMeshlets.push_back(mesh.mMeshlets);
+		}
+
+		const std::string filePath{ TestUtils::GetTemporaryFilePath("CookedModelTests.brm") };
+		CookedModelData data(0UL);
+		if (CookedModel::Write(filePath.c_str(), meshDatas, meshLods, meshMeshlets)) {
+			MemoryMappedFile file;
+			if (file.Open(filePath.c_str())) {
+				data = CookedModelData(file.GetSize());
+				std::memcpy(data.GetData(), file.GetData(), file.GetSize());
+			}
+		}
+		std::remove(filePath.c_str());
+
+		return data;
+	}
+
+	// A grid with meshlets and levels of detail, and a small sphere without meshlets
+	std::vector<CookedMesh> GetMeshes() {
+		std::vector<CookedMesh> meshes(2UL);
+		MeshTestUtils::CreateGrid(64U, 64U, meshes[0UL].mMeshData);
+		MeshTestUtils::CreateSphere(8U, 8U, meshes[1UL].mMeshData);
+		for (CookedMesh& mesh : meshes) {
+			CookMesh(mesh);
+		}
+
+		return meshes;
+	}
+
+	bool IsEqual(const DirectX::XMFLOAT3& vector1, const DirectX::XMFLOAT3& vector2) noexcept {
+		return vector1.x == vector2.x && vector1.y == vector2.y && vector1.z == vector2.z;
+	}
+
+	// Checks that "meshView" has the data of "mesh"
+	void CheckMeshView(const CookedModel::MeshView& meshView, const CookedMesh& mesh) {
+		const GeometryGenerator::MeshData& meshData = mesh.mMeshData;
+		CHECK(meshView.mVertexCount == meshData.mVertices.size());
+		CHECK(meshView.mIndexCount == meshData.mIndices32.size());
+		CHECK(meshView.mLodCount == mesh.mLods.size());
+		CHECK(meshView.mMeshletCount == mesh.mMeshlets.size());
+		if (meshView.mVertexCount != meshData.mVertices.size() ||
+			meshView.mIndexCount != meshData.mIndices32.size() ||
+			meshView.mLodCount != mesh.mLods.size() ||
+			meshView.mMeshletCount != mesh.mMeshlets.size()) {
+			return;
+		}
+
+		// Vertices are compressed when they are cooked
+		const VertexCompressor::PositionQuantization positionQuantization{
+			VertexCompressor::ComputePositionQuantization(meshData.mVertices.data(), meshData.mVertices.size()) };
+		CHECK(std::memcmp(&meshView.mPositionQuantization, &positionQuantization, sizeof(VertexCompressor::PositionQuantization)) == 0);
+		std::vector<VertexCompressor::PackedVertex> packedVertices(meshData.mVertices.size());
+		VertexCompressor::EncodeVertices(meshData.mVertices.data(), meshData.mVertices.size(), positionQuantization, packedVertices.data());
+
+		bool areVerticesEqual{ true };
+		DirectX::XMFLOAT3 minPosition{ meshData.mVertices[0UL].mPosition };
+		DirectX::XMFLOAT3 maxPosition{ minPosition };
+		for (std::size_t i = 0UL; i < meshData.mVertices.size(); ++i) {
+			const GeometryGenerator::Vertex& vertex = meshData.mVertices[i];
+			areVerticesEqual &= std::memcmp(&meshView.mVertices[i], &packedVertices[i], sizeof(VertexCompressor::PackedVertex)) == 0;
+			minPosition.x = std::min<float>(minPosition.x, vertex.mPosition.x);
+			minPosition.y = std::min<float>(minPosition.y, vertex.mPosition.y);
+			minPosition.z = std::min<float>(minPosition.z, vertex.mPosition.z);
+			maxPosition.x = std::max<float>(maxPosition.x, vertex.mPosition.x);
+			maxPosition.y = std::max<float>(maxPosition.y, vertex.mPosition.y);
+			maxPosition.z = std::max<float>(maxPosition.z, vertex.mPosition.z);
+		}
+		CHECK(areVerticesEqual);
+		CHECK(std::memcmp(meshView.mIndices, meshData.mIndices32.data(), sizeof(std::uint32_t) * meshView.mIndexCount) == 0);
+
+		bool areLodsEqual{ true };
+		for (std::size_t i = 0UL; i < mesh.mLods.size(); ++i) {
+			areLodsEqual &=
+				meshView.mLods[i].mFirstIndex == mesh.mLods[i].mFirstIndex &&
+				meshView.mLods[i].mIndexCount == mesh.mLods[i].mIndexCount &&
+				meshView.mLods[i].mError == mesh.mLods[i].mError;
+		}
+		CHECK(areLodsEqual);
+
+		CHECK((meshView.mMeshlets == nullptr) == mesh.mMeshlets.empty());
+		CHECK(mesh.mMeshlets.empty() || std::memcmp(meshView.mMeshlets, mesh.mMeshlets.data(), sizeof(Meshlet) * meshView.mMeshletCount) == 0);
+
+		// Bounding box of the vertex positions
+		CHECK(IsEqual(meshView.mBoundingBoxCenter, DirectX::XMFLOAT3(
+			(minPosition.x + maxPosition.x) * 0.5f,
+			(minPosition.y + maxPosition.y) * 0.5f,
+			(minPosition.z + maxPosition.z) * 0.5f)));
+		CHECK(IsEqual(meshView.mBoundingBoxExtents, DirectX::XMFLOAT3(
+			(maxPosition.x - minPosition.x) * 0.5f,
+			(maxPosition.y - minPosition.y) * 0.5f,
+			(maxPosition.z - minPosition.z) * 0.5f)));
+	}
+
+	// Changes the data of a valid cooked model, and returns if it is read
+	template<typename Function>
+	bool IsReadAfterChange(Function changeData) {
+		CookedModelData data{ WriteMeshes(GetMeshes()) };
+		std::vector<CookedModel::MeshView> meshes;
+		if (CookedModel::Read(data.GetData(), data.GetSize(), meshes) == false) {
+			return false;
+		}
+
+		changeData(data);
+
+		// Rejected data does not fill the meshes
+		const bool isRead{ CookedModel::Read(data.GetData(), data.GetSize(), meshes) };
+		CHECK(isRead || meshes.empty());
+		return isRead;
+	}
+
+	void TestRoundTrip() {
+		const std::vector<CookedMesh> sourceMeshes{ GetMeshes() };
+		CHECK(sourceMeshes[0UL].mLods.size() > 1UL);
+		CHECK(sourceMeshes[0UL].mMeshlets.empty() == false);
+		CHECK(sourceMeshes[1UL].mMeshlets.empty());
+
+		CookedModelData data{ WriteMeshes(sourceMeshes) };
+		CHECK(data.GetSize() > 0UL);
+
+		std::vector<CookedModel::MeshView> meshes;
+		CHECK(CookedModel::Read(data.GetData(), data.GetSize(), meshes));
+		CHECK(meshes.size() == sourceMeshes.size());
+		for (std::size_t i = 0UL; i < meshes.size() && i < sourceMeshes.size(); ++i) {
+			CheckMeshView(meshes[i], sourceMeshes[i]);
+		}
+
+		// Unchanged data is read (so the rejections below are caused by the changes)
+		CHECK(IsReadAfterChange([](CookedModelData&) {}));
+	}
+
+	// Models of external/resources/models, loaded from their OBJ files
+	void TestResourceModelsRoundTrip() {
+		const std::vector<std::string> modelFilePaths{ MeshTestUtils::GetModelFilePaths() };
+		CHECK(modelFilePaths.empty() == false);
+		for (const std::string& modelFilePath : modelFilePaths) {
+			std::vector<CookedMesh> sourceMeshes(1UL);
+			CHECK(MeshTestUtils::ReadObjFile(modelFilePath, sourceMeshes[0UL].mMeshData));
+			if (sourceMeshes[0UL].mMeshData.mIndices32.empty()) {
+				continue;
+			}
+			CookMesh(sourceMeshes[0UL]);
+
+			CookedModelData data{ WriteMeshes(sourceMeshes) };
+			std::vector<CookedModel::MeshView> meshes;
+			CHECK(CookedModel::Read(data.GetData(), data.GetSize(), meshes));
+			CHECK(meshes.size() == 1UL);
+			if (meshes.size() == 1UL) {
+				CheckMeshView(meshes[0UL], sourceMeshes[0UL]);
+			}
+		}
+	}
+
+	void TestWrongFileHeaderIsRejected() {
+		CHECK(IsReadAfterChange([](CookedModelData& data) { data.GetFileHeader().mMagicNumber ^= 1U; }) == false);
+		CHECK(IsReadAfterChange([](CookedModelData& data) { data.GetFileHeader().mVersion = CookedModel::sVersion - 1U; }) == false);
+		CHECK(IsReadAfterChange([](CookedModelData& data) { data.GetFileHeader().mVersion = CookedModel::sVersion + 1U; }) == false);
+		CHECK(IsReadAfterChange([](CookedModelData& data) { data.GetFileHeader().mVertexSize -= 4U; }) == false);
+		CHECK(IsReadAfterChange([](CookedModelData& data) { data.GetFileHeader().mMeshCount = 0U; }) == false);
+
+		// More meshes than mesh headers in the file
+		CHECK(IsReadAfterChange([](CookedModelData& data) { data.GetFileHeader().mMeshCount = 0x10000000U; }) == false);
+	}
+
+	// Files truncated in the file header, in the mesh headers, and in the data of each mesh
+	void TestTruncatedFileIsRejected() {
+		const std::size_t meshHeadersEnd{ sizeof(CookedModel::FileHeader) + 2UL * sizeof(CookedModel::MeshHeader) };
+		const std::size_t dataSizes[]{ 0UL, sizeof(CookedModel::FileHeader) - 1UL, sizeof(CookedModel::FileHeader), meshHeadersEnd - 1UL };
+		for (const std::size_t dataSize : dataSizes) {
+			CHECK(IsReadAfterChange([dataSize](CookedModelData& data) {
+				CookedModelData truncatedData(dataSize);
+				std::memcpy(truncatedData.GetData(), data.GetData(), dataSize);
+				data = std::move(truncatedData);
+			}) == false);
+		}
+
+		// Each mesh data ends at the end of the file
+		for (std::size_t i = 0UL; i < 2UL; ++i) {
+			CHECK(IsReadAfterChange([i](CookedModelData& data) {
+				const CookedModel::MeshHeader& meshHeader = data.GetMeshHeader(i);
+				const std::size_t vertexDataEnd{ meshHeader.mVertexDataOffset + sizeof(VertexCompressor::PackedVertex) * meshHeader.mVertexCount };
+				CookedModelData truncatedData(vertexDataEnd - 1UL);
+				std::memcpy(truncatedData.GetData(), data.GetData(), truncatedData.GetSize());
+				data = std::move(truncatedData);
+			}) == false);
+		}
+		CHECK(IsReadAfterChange([](CookedModelData& data) {
+			CookedModelData truncatedData(data.GetSize() - 1UL);
+			std::memcpy(truncatedData.GetData(), data.GetData(), truncatedData.GetSize());
+			data = std::move(truncatedData);
+		}) == false);
+	}
+
+	// Vertex, index and meshlet data out of the file, or not aligned
+	void TestOutOfBoundsDataIsRejected() {
+		for (std::size_t i = 0UL; i < 2UL; ++i) {
+			CHECK(IsReadAfterChange([i](CookedModelData& data) { data.GetMeshHeader(i).mVertexDataOffset = data.GetSize() + 16UL; }) == false);
+			CHECK(IsReadAfterChange([i](CookedModelData& data) { data.GetMeshHeader(i).mIndexDataOffset = data.GetSize() + 16UL; }) == false);
+			CHECK(IsReadAfterChange([i](CookedModelData& data) { data.GetMeshHeader(i).mMeshletDataOffset = data.GetSize() + 16UL; }) == false);
+			CHECK(IsReadAfterChange([i](CookedModelData& data) { data.GetMeshHeader(i).mIndexDataOffset += 4UL; }) == false);
+			CHECK(IsReadAfterChange([i](CookedModelData& data) { data.GetMeshHeader(i).mVertexCount = 0xFFFFFFFFU; }) == false);
+			CHECK(IsReadAfterChange([i](CookedModelData& data) { data.GetMeshHeader(i).mIndexCount = 0xFFFFFFFFU; }) == false);
+			CHECK(IsReadAfterChange([i](CookedModelData& data) { data.GetMeshHeader(i).mMeshletCount = 0xFFFFFFFFU; }) == false);
+			CHECK(IsReadAfterChange([i](CookedModelData& data) { data.GetMeshHeader(i).mVertexCount = 0U; }) == false);
+			CHECK(IsReadAfterChange([i](CookedModelData& data) { data.GetMeshHeader(i).mIndexCount = 0U; }) == false);
+		}
+	}
+
+	// Indices out of the mesh vertices (they would read vertices of other meshes in the shared vertex buffer)
+	void TestOutOfBoundsIndexIsRejected() {
+		const auto getIndices = [](CookedModelData& data, const std::size_t meshIndex) {
+			return reinterpret_cast<std::uint32_t*>(data.GetData() + data.GetMeshHeader(meshIndex).mIndexDataOffset);
+		};
+		for (std::size_t i = 0UL; i < 2UL; ++i) {
+			CHECK(IsReadAfterChange([getIndices, i](CookedModelData& data) {
+				getIndices(data, i)[0U] = data.GetMeshHeader(i).mVertexCount;
+			}) == false);
+			CHECK(IsReadAfterChange([getIndices, i](CookedModelData& data) {
+				const CookedModel::MeshHeader& meshHeader = data.GetMeshHeader(i);
+				getIndices(data, i)[meshHeader.mIndexCount - 1U] = 0xFFFFFFFFU;
+			}) == false);
+		}
+
+		// The last vertex is a valid index
+		CHECK(IsReadAfterChange([getIndices](CookedModelData& data) {
+			getIndices(data, 0UL)[0U] = data.GetMeshHeader(0UL).mVertexCount - 1U;
+		}));
+	}
+
+	// Levels of detail out of the mesh indices, or with a wrong count
+	void TestOutOfBoundsLodIsRejected() {
+		CHECK(IsReadAfterChange([](CookedModelData& data) { data.GetMeshHeader(0UL).mLodCount = 0U; }) == false);
+		CHECK(IsReadAfterChange([](CookedModelData& data) { data.GetMeshHeader(0UL).mLodCount = sMaxMeshLodCount + 1U; }) == false);
+		CHECK(IsReadAfterChange([](CookedModelData& data) {
+			CookedModel::MeshHeader& meshHeader = data.GetMeshHeader(0UL);
+			meshHeader.mLods[meshHeader.mLodCount - 1U].mFirstIndex = meshHeader.mIndexCount + 3U;
+		}) == false);
+		CHECK(IsReadAfterChange([](CookedModelData& data) {
+			CookedModel::MeshHeader& meshHeader = data.GetMeshHeader(0UL);
+			meshHeader.mLods[meshHeader.mLodCount - 1U].mIndexCount += 3U;
+		}) == false);
+		CHECK(IsReadAfterChange([](CookedModelData& data) { data.GetMeshHeader(0UL).mLods[0U].mIndexCount = 0U; }) == false);
+	}
+
+	// Meshlets out of the full detail level of detail, or with partial triangles
+	void TestOutOfBoundsMeshletIsRejected() {
+		const auto getMeshlets = [](CookedModelData& data) {
+			return reinterpret_cast<Meshlet*>(data.GetData() + data.GetMeshHeader(0UL).mMeshletDataOffset);
+		};
+		CHECK(IsReadAfterChange([getMeshlets](CookedModelData& data) {
+			// The first index of the last meshlet is past the full detail level of detail
+			const CookedModel::MeshHeader& meshHeader = data.GetMeshHeader(0UL);
+			getMeshlets(data)[meshHeader.mMeshletCount - 1U].mFirstIndex = meshHeader.mLods[0U].mIndexCount + 3U;
+		}) == false);
+		CHECK(IsReadAfterChange([getMeshlets](CookedModelData& data) {
+			// The last meshlet ends in the next level of detail
+			const CookedModel::MeshHeader& meshHeader = data.GetMeshHeader(0UL);
+			getMeshlets(data)[meshHeader.mMeshletCount - 1U].mIndexCount += 3U;
+		}) == false);
+		CHECK(IsReadAfterChange([getMeshlets](CookedModelData& data) { getMeshlets(data)[0U].mIndexCount = 0U; }) == false);
+		CHECK(IsReadAfterChange([getMeshlets](CookedModelData& data) { getMeshlets(data)[0U].mIndexCount -= 1U; }) == false);
+	}
+}
+
+int main() {
+	RUN_TEST(TestRoundTrip);
+	RUN_TEST(TestResourceModelsRoundTrip);
+	RUN_TEST(TestWrongFileHeaderIsRejected);
+	RUN_TEST(TestTruncatedFileIsRejected);
+	RUN_TEST(TestOutOfBoundsDataIsRejected);
+	RUN_TEST(TestOutOfBoundsIndexIsRejected);
+	RUN_TEST(TestOutOfBoundsLodIsRejected);
+	RUN_TEST(TestOutOfBoundsMeshletIsRejected);
+
+	return static_cast<int>(TestUtils::GetFailureCount());
+}
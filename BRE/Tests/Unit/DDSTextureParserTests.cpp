@@ -0,0 +1,465 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <tbb/task_arena.h>
+#include <vector>
+
+#include <ResourceManager/DDSTextureParser.h>
+#include <ResourceManager/DDSTextureWriter.h>
+#include <TestUtils.h>
+#include <Utils/MemoryMappedFile.h>
+
+namespace {
+	// DDS_HEADER_DXT10 misc flag of cube maps (D3D11_RESOURCE_MISC_TEXTURECUBE)
+	const std::uint32_t sResourceMiscTextureCube{ 0x4U };
+
+	struct FileDescription {
+		std::uint32_t mWidth{ 1U };
+		std::uint32_t mHeight{ 1U };
+		std::uint32_t mDepth{ 1U };
+		std::uint32_t mMipCount{ 1U };
+
+		// If it is DXGI_FORMAT_UNKNOWN, then the file has no DX10 header, and it is 
+		// RGBA8 (if "mFourCC" is zero) or the "mFourCC" format
+		DXGI_FORMAT mFormat{ DXGI_FORMAT_UNKNOWN };
+		std::uint32_t mFourCC{ 0U };
+		DDSTextureParser::Dimension mDimension{ DDSTextureParser::Dimension::TEXTURE2D };
+		std::uint32_t mArraySize{ 1U };
+		bool mIsCubeMap{ false };
+	};
+
+	// Returns the file data of the headers, followed by "dataSize" zero bytes
+	std::vector<std::uint8_t> CreateFileData(const FileDescription& description, const std::size_t dataSize) {
+		const bool hasExtendedHeader{ description.mFormat != DXGI_FORMAT_UNKNOWN };
+		std::vector<std::uint8_t> fileData(
+			sizeof(std::uint32_t) + sizeof(DDS_HEADER) + (hasExtendedHeader ? sizeof(DDS_HEADER_DXT10) : 0UL) + dataSize, 0U);
+		const std::uint32_t magicNumber{ DDS_MAGIC };
+		std::memcpy(fileData.data(), &magicNumber, sizeof(std::uint32_t));
+
+		DDS_HEADER header;
+		std::memset(&header, 0, sizeof(DDS_HEADER));
+		header.size = sizeof(DDS_HEADER);
+		header.flags = DDS_HEIGHT | DDS_WIDTH;
+		header.width = description.mWidth;
+		header.height = description.mHeight;
+		header.depth = description.mDepth;
+		header.mipMapCount = description.mMipCount;
+		header.ddspf.size = sizeof(DDS_PIXELFORMAT);
+		if (description.mDepth > 1U) {
+			header.flags |= DDS_HEADER_FLAGS_VOLUME;
+		}
+
+		if (hasExtendedHeader) {
+			header.ddspf.flags = DDS_FOURCC;
+			header.ddspf.fourCC = MAKEFOURCC('D', 'X', '1', '0');
+
+			DDS_HEADER_DXT10 extendedHeader;
+			std::memset(&extendedHeader, 0, sizeof(DDS_HEADER_DXT10));
+			extendedHeader.dxgiFormat = description.mFormat;
+			extendedHeader.resourceDimension = static_cast<std::uint32_t>(description.mDimension);
+			extendedHeader.arraySize = description.mArraySize;
+			extendedHeader.miscFlag = description.mIsCubeMap ? sResourceMiscTextureCube : 0U;
+			std::memcpy(fileData.data() + sizeof(std::uint32_t) + sizeof(DDS_HEADER), &extendedHeader, sizeof(DDS_HEADER_DXT10));
+		} else {
+			if (description.mFourCC != 0U) {
+				header.ddspf.flags = DDS_FOURCC;
+				header.ddspf.fourCC = description.mFourCC;
+			} else {
+				header.ddspf.flags = DDS_RGB;
+				header.ddspf.RGBBitCount = 32U;
+				header.ddspf.RBitMask = 0x000000FFU;
+				header.ddspf.GBitMask = 0x0000FF00U;
+				header.ddspf.BBitMask = 0x00FF0000U;
+				header.ddspf.ABitMask = 0xFF000000U;
+			}
+
+			if (description.mIsCubeMap) {
+				header.caps2 = DDS_CUBEMAP | DDS_CUBEMAP_ALLFACES;
+			}
+		}
+		std::memcpy(fileData.data() + sizeof(std::uint32_t), &header, sizeof(DDS_HEADER));
+
+		return fileData;
+	}
+
+	// Layouts computed serially, a subresource after the other (like the original DDSTextureLoader)
+	void ComputeReferenceLayouts(
+		const DDSTextureParser::TextureInfo& textureInfo,
+		const std::size_t maxSize,
+		std::vector<DDSTextureParser::SubresourceLayout>& layouts,
+		std::uint32_t& skippedMipCount,
+		std::size_t& endOffset)
+	{
+		layouts.clear();
+		skippedMipCount = 0U;
+		std::size_t offset{ textureInfo.mDataOffset };
+		for (std::uint32_t j = 0U; j < textureInfo.mArraySize; ++j) {
+			std::size_t width{ textureInfo.mWidth };
+			std::size_t height{ textureInfo.mHeight };
+			std::size_t depth{ textureInfo.mDepth };
+			for (std::uint32_t i = 0U; i < textureInfo.mMipCount; ++i) {
+				std::size_t numBytes{ 0UL };
+				std::size_t rowBytes{ 0UL };
+				DDSTextureParser::GetSurfaceInfo(width, height, textureInfo.mFormat, &numBytes, &rowBytes, nullptr);
+				if (textureInfo.mMipCount <= 1U || maxSize == 0UL || (width <= maxSize && height <= maxSize && depth <= maxSize)) {
+					DDSTextureParser::SubresourceLayout layout;
+					layout.mOffset = offset;
+					layout.mRowPitch = rowBytes;
+					layout.mSlicePitch = numBytes;
+					layout.mSize = numBytes * depth;
+					layouts.push_back(layout);
+				} else if (j == 0U) {
+					++skippedMipCount;
+				}
+
+				offset += numBytes * depth;
+				width = std::max<std::size_t>(width >> 1UL, 1UL);
+				height = std::max<std::size_t>(height >> 1UL, 1UL);
+				depth = std::max<std::size_t>(depth >> 1UL, 1UL);
+			}
+		}
+		endOffset = offset;
+	}
+
+	bool AreEqual(const DDSTextureParser::SubresourceLayout& layout1, const DDSTextureParser::SubresourceLayout& layout2) {
+		return
+			layout1.mOffset == layout2.mOffset &&
+			layout1.mRowPitch == layout2.mRowPitch &&
+			layout1.mSlicePitch == layout2.mSlicePitch &&
+			layout1.mSize == layout2.mSize;
+	}
+
+	// Layouts must be the ones of the reference, with all the threads and with one thread (array slices
+	// are computed in parallel), and a file without the last byte must be END_OF_FILE.
+	void CheckLayouts(const std::uint8_t* fileData, const std::size_t fileSize, const std::size_t maxSize) {
+		DDSTextureParser::TextureInfo textureInfo;
+		CHECK(DDSTextureParser::ParseHeader(fileData, fileSize, textureInfo) == DDSTextureParser::Result::SUCCESS);
+
+		std::vector<DDSTextureParser::SubresourceLayout> referenceLayouts;
+		std::uint32_t referenceSkippedMipCount{ 0U };
+		std::size_t endOffset{ 0UL };
+		ComputeReferenceLayouts(textureInfo, maxSize, referenceLayouts, referenceSkippedMipCount, endOffset);
+		CHECK(endOffset <= fileSize);
+
+		const std::size_t layoutCount{ static_cast<std::size_t>(textureInfo.mMipCount) * textureInfo.mArraySize };
+		std::vector<DDSTextureParser::SubresourceLayout> layouts(layoutCount);
+		std::uint32_t skippedMipCount{ 0U };
+		std::uint32_t width{ 0U };
+		std::uint32_t height{ 0U };
+		std::uint32_t depth{ 0U };
+		CHECK(DDSTextureParser::ComputeSubresourceLayouts(
+			textureInfo, maxSize, fileSize, layouts.data(), skippedMipCount, width, height, depth) == DDSTextureParser::Result::SUCCESS);
+		CHECK(skippedMipCount == referenceSkippedMipCount);
+		CHECK(referenceLayouts.size() == (textureInfo.mMipCount - skippedMipCount) * textureInfo.mArraySize);
+		CHECK(width == std::max<std::uint32_t>(textureInfo.mWidth >> skippedMipCount, 1U));
+		CHECK(height == std::max<std::uint32_t>(textureInfo.mHeight >> skippedMipCount, 1U));
+		CHECK(depth == std::max<std::uint32_t>(textureInfo.mDepth >> skippedMipCount, 1U));
+
+		std::vector<DDSTextureParser::SubresourceLayout> serialLayouts(layoutCount);
+		tbb::task_arena singleThreadArena(1);
+		singleThreadArena.execute([&]() {
+			DDSTextureParser::ComputeSubresourceLayouts(
+				textureInfo, maxSize, fileSize, serialLayouts.data(), skippedMipCount, width, height, depth);
+		});
+
+		bool areEqual{ true };
+		for (std::size_t i = 0UL; i < referenceLayouts.size(); ++i) {
+			areEqual &= AreEqual(layouts[i], referenceLayouts[i]);
+			areEqual &= AreEqual(serialLayouts[i], referenceLayouts[i]);
+		}
+		CHECK(areEqual);
+
+		CHECK(DDSTextureParser::ComputeSubresourceLayouts(
+			textureInfo, maxSize, endOffset - 1UL, layouts.data(), skippedMipCount, width, height, depth) == DDSTextureParser::Result::END_OF_FILE);
+	}
+
+	// Returns the file data of "description" with its subresources
+	std::vector<std::uint8_t> CreateCompleteFileData(const FileDescription& description) {
+		const std::vector<std::uint8_t> headerData{ CreateFileData(description, 0UL) };
+		DDSTextureParser::TextureInfo textureInfo;
+		if (DDSTextureParser::ParseHeader(headerData.data(), headerData.size(), textureInfo) != DDSTextureParser::Result::SUCCESS) {
+			return std::vector<std::uint8_t>();
+		}
+
+		std::vector<DDSTextureParser::SubresourceLayout> layouts;
+		std::uint32_t skippedMipCount{ 0U };
+		std::size_t endOffset{ 0UL };
+		ComputeReferenceLayouts(textureInfo, 0UL, layouts, skippedMipCount, endOffset);
+
+		return CreateFileData(description, endOffset - textureInfo.mDataOffset);
+	}
+
+	void TestLegacyHeaders() {
+		FileDescription description;
+		description.mWidth = 256U;
+		description.mHeight = 128U;
+		description.mMipCount = 9U;
+		std::vector<std::uint8_t> fileData{ CreateCompleteFileData(description) };
+		DDSTextureParser::TextureInfo textureInfo;
+		CHECK(DDSTextureParser::ParseHeader(fileData.data(), fileData.size(), textureInfo) == DDSTextureParser::Result::SUCCESS);
+		CHECK(textureInfo.mFormat == DXGI_FORMAT_R8G8B8A8_UNORM);
+		CHECK(textureInfo.mDimension == DDSTextureParser::Dimension::TEXTURE2D);
+		CHECK(textureInfo.mWidth == 256U && textureInfo.mHeight == 128U && textureInfo.mDepth == 1U);
+		CHECK(textureInfo.mMipCount == 9U && textureInfo.mArraySize == 1U);
+		CHECK(textureInfo.mDataOffset == sizeof(std::uint32_t) + sizeof(DDS_HEADER));
+		CheckLayouts(fileData.data(), fileData.size(), 0UL);
+		CheckLayouts(fileData.data(), fileData.size(), 32UL);
+
+		description.mWidth = 512U;
+		description.mHeight = 512U;
+		description.mMipCount = 10U;
+		description.mFourCC = MAKEFOURCC('D', 'X', 'T', '1');
+		fileData = CreateCompleteFileData(description);
+		CHECK(DDSTextureParser::ParseHeader(fileData.data(), fileData.size(), textureInfo) == DDSTextureParser::Result::SUCCESS);
+		CHECK(textureInfo.mFormat == DXGI_FORMAT_BC1_UNORM);
+		CheckLayouts(fileData.data(), fileData.size(), 0UL);
+		CheckLayouts(fileData.data(), fileData.size(), 1UL);
+	}
+
+	void TestExtendedHeaders() {
+		FileDescription description;
+		description.mWidth = 64U;
+		description.mHeight = 32U;
+		description.mDepth = 16U;
+		description.mMipCount = 7U;
+		description.mFormat = DXGI_FORMAT_R16G16B16A16_FLOAT;
+		description.mDimension = DDSTextureParser::Dimension::TEXTURE3D;
+		std::vector<std::uint8_t> fileData{ CreateCompleteFileData(description) };
+		DDSTextureParser::TextureInfo textureInfo;
+		CHECK(DDSTextureParser::ParseHeader(fileData.data(), fileData.size(), textureInfo) == DDSTextureParser::Result::SUCCESS);
+		CHECK(textureInfo.mFormat == DXGI_FORMAT_R16G16B16A16_FLOAT);
+		CHECK(textureInfo.mDimension == DDSTextureParser::Dimension::TEXTURE3D);
+		CHECK(textureInfo.mDepth == 16U);
+		CHECK(textureInfo.mDataOffset == sizeof(std::uint32_t) + sizeof(DDS_HEADER) + sizeof(DDS_HEADER_DXT10));
+		CheckLayouts(fileData.data(), fileData.size(), 0UL);
+		CheckLayouts(fileData.data(), fileData.size(), 8UL);
+
+		// 1D texture array
+		description = FileDescription();
+		description.mWidth = 100U;
+		description.mMipCount = 7U;
+		description.mFormat = DXGI_FORMAT_R32_FLOAT;
+		description.mDimension = DDSTextureParser::Dimension::TEXTURE1D;
+		description.mArraySize = 17U;
+		fileData = CreateCompleteFileData(description);
+		CHECK(DDSTextureParser::ParseHeader(fileData.data(), fileData.size(), textureInfo) == DDSTextureParser::Result::SUCCESS);
+		CHECK(textureInfo.mDimension == DDSTextureParser::Dimension::TEXTURE1D);
+		CHECK(textureInfo.mArraySize == 17U);
+		CheckLayouts(fileData.data(), fileData.size(), 0UL);
+
+		// A single mip is never skipped, and block compressed mips smaller than a block use a block
+		description = FileDescription();
+		description.mWidth = 7U;
+		description.mHeight = 5U;
+		description.mFormat = DXGI_FORMAT_BC1_UNORM;
+		fileData = CreateCompleteFileData(description);
+		CheckLayouts(fileData.data(), fileData.size(), 1UL);
+	}
+
+	void TestCubeMapsAndArrays() {
+		// Legacy cube map: 6 array slices
+		FileDescription description;
+		description.mWidth = 128U;
+		description.mHeight = 128U;
+		description.mMipCount = 8U;
+		description.mFourCC = MAKEFOURCC('D', 'X', 'T', '5');
+		description.mIsCubeMap = true;
+		std::vector<std::uint8_t> fileData{ CreateCompleteFileData(description) };
+		DDSTextureParser::TextureInfo textureInfo;
+		CHECK(DDSTextureParser::ParseHeader(fileData.data(), fileData.size(), textureInfo) == DDSTextureParser::Result::SUCCESS);
+		CHECK(textureInfo.mIsCubeMap);
+		CHECK(textureInfo.mArraySize == 6U);
+		CHECK(textureInfo.mFormat == DXGI_FORMAT_BC3_UNORM);
+		CheckLayouts(fileData.data(), fileData.size(), 0UL);
+
+		// Array of 30 cube maps (extended header array size is the number of cubes)
+		description = FileDescription();
+		description.mWidth = 32U;
+		description.mHeight = 32U;
+		description.mMipCount = 6U;
+		description.mFormat = DXGI_FORMAT_R8G8B8A8_UNORM;
+		description.mArraySize = 30U;
+		description.mIsCubeMap = true;
+		fileData = CreateCompleteFileData(description);
+		CHECK(DDSTextureParser::ParseHeader(fileData.data(), fileData.size(), textureInfo) == DDSTextureParser::Result::SUCCESS);
+		CHECK(textureInfo.mIsCubeMap);
+		CHECK(textureInfo.mArraySize == 180U);
+		CheckLayouts(fileData.data(), fileData.size(), 0UL);
+		CheckLayouts(fileData.data(), fileData.size(), 16UL);
+
+		// Large array, so slices are computed in parallel
+		description = FileDescription();
+		description.mWidth = 64U;
+		description.mHeight = 64U;
+		description.mMipCount = 7U;
+		description.mFormat = DXGI_FORMAT_BC7_UNORM;
+		description.mArraySize = 2000U;
+		fileData = CreateCompleteFileData(description);
+		CHECK(DDSTextureParser::ParseHeader(fileData.data(), fileData.size(), textureInfo) == DDSTextureParser::Result::SUCCESS);
+		CHECK(textureInfo.mArraySize == 2000U);
+		CheckLayouts(fileData.data(), fileData.size(), 0UL);
+		CheckLayouts(fileData.data(), fileData.size(), 32UL);
+	}
+
+	void TestMalformedHeaders() {
+		FileDescription description;
+		description.mWidth = 64U;
+		description.mHeight = 64U;
+		description.mFormat = DXGI_FORMAT_R8G8B8A8_UNORM;
+		DDSTextureParser::TextureInfo textureInfo;
+
+		// Wrong magic number
+		std::vector<std::uint8_t> fileData{ CreateCompleteFileData(description) };
+		fileData[0U] = 'X';
+		CHECK(DDSTextureParser::ParseHeader(fileData.data(), fileData.size(), textureInfo) == DDSTextureParser::Result::INVALID_DATA);
+
+		// Truncated headers
+		fileData = CreateCompleteFileData(description);
+		CHECK(DDSTextureParser::ParseHeader(fileData.data(), sizeof(std::uint32_t) + sizeof(DDS_HEADER) - 1UL, textureInfo) != DDSTextureParser::Result::SUCCESS);
+		CHECK(DDSTextureParser::ParseHeader(fileData.data(), sizeof(std::uint32_t) + sizeof(DDS_HEADER) + 4UL, textureInfo) != DDSTextureParser::Result::SUCCESS);
+		CHECK(DDSTextureParser::ParseHeader(fileData.data(), 0UL, textureInfo) != DDSTextureParser::Result::SUCCESS);
+
+		// Wrong header size
+		fileData = CreateCompleteFileData(description);
+		fileData[sizeof(std::uint32_t)] = 0U;
+		CHECK(DDSTextureParser::ParseHeader(fileData.data(), fileData.size(), textureInfo) == DDSTextureParser::Result::INVALID_DATA);
+
+		// Array size of zero
+		description.mArraySize = 0U;
+		fileData = CreateFileData(description, 64UL * 64UL * 4UL);
+		CHECK(DDSTextureParser::ParseHeader(fileData.data(), fileData.size(), textureInfo) == DDSTextureParser::Result::INVALID_DATA);
+		description.mArraySize = 1U;
+
+		// 1D texture with a height
+		description.mDimension = DDSTextureParser::Dimension::TEXTURE1D;
+		description.mHeight = 4U;
+		fileData = CreateFileData(description, 64UL * 4UL * 4UL);
+		CHECK(DDSTextureParser::ParseHeader(fileData.data(), fileData.size(), textureInfo) == DDSTextureParser::Result::INVALID_DATA);
+		description.mDimension = DDSTextureParser::Dimension::TEXTURE2D;
+		description.mHeight = 64U;
+
+		// Unknown dimension
+		description.mDimension = static_cast<DDSTextureParser::Dimension>(7U);
+		fileData = CreateFileData(description, 64UL * 64UL * 4UL);
+		CHECK(DDSTextureParser::ParseHeader(fileData.data(), fileData.size(), textureInfo) != DDSTextureParser::Result::SUCCESS);
+		description.mDimension = DDSTextureParser::Dimension::TEXTURE2D;
+
+		// Unsupported format, too many mips, and too large dimensions and arrays
+		description.mFormat = DXGI_FORMAT_P8;
+		fileData = CreateFileData(description, 64UL * 64UL);
+		CHECK(DDSTextureParser::ParseHeader(fileData.data(), fileData.size(), textureInfo) == DDSTextureParser::Result::NOT_SUPPORTED);
+		description.mFormat = DXGI_FORMAT_R8G8B8A8_UNORM;
+
+		description.mMipCount = DDSTextureParser::sMaxMipCount + 1U;
+		fileData = CreateFileData(description, 64UL * 64UL * 4UL * 2UL);
+		CHECK(DDSTextureParser::ParseHeader(fileData.data(), fileData.size(), textureInfo) == DDSTextureParser::Result::NOT_SUPPORTED);
+		description.mMipCount = 1U;
+
+		// More mips than the full mip chain (7 mips for 64 x 64, 3 mips for 4 x 4, 5 mips for 4 x 2 x 16)
+		description.mMipCount = 8U;
+		fileData = CreateFileData(description, 64UL * 64UL * 4UL * 2UL);
+		CHECK(DDSTextureParser::ParseHeader(fileData.data(), fileData.size(), textureInfo) == DDSTextureParser::Result::INVALID_DATA);
+		description.mMipCount = 7U;
+		fileData = CreateFileData(description, 64UL * 64UL * 4UL * 2UL);
+		CHECK(DDSTextureParser::ParseHeader(fileData.data(), fileData.size(), textureInfo) == DDSTextureParser::Result::SUCCESS);
+		description.mWidth = 4U;
+		description.mHeight = 4U;
+		description.mMipCount = 10U;
+		fileData = CreateFileData(description, 4UL * 4UL * 4UL * 2UL);
+		CHECK(DDSTextureParser::ParseHeader(fileData.data(), fileData.size(), textureInfo) == DDSTextureParser::Result::INVALID_DATA);
+		description.mHeight = 2U;
+		description.mDepth = 16U;
+		description.mMipCount = 6U;
+		description.mDimension = DDSTextureParser::Dimension::TEXTURE3D;
+		fileData = CreateFileData(description, 4UL * 2UL * 16UL * 4UL * 2UL);
+		CHECK(DDSTextureParser::ParseHeader(fileData.data(), fileData.size(), textureInfo) == DDSTextureParser::Result::INVALID_DATA);
+		description.mMipCount = 5U;
+		fileData = CreateFileData(description, 4UL * 2UL * 16UL * 4UL * 2UL);
+		CHECK(DDSTextureParser::ParseHeader(fileData.data(), fileData.size(), textureInfo) == DDSTextureParser::Result::SUCCESS);
+		description.mDimension = DDSTextureParser::Dimension::TEXTURE2D;
+		description.mDepth = 1U;
+		description.mMipCount = 1U;
+
+		description.mWidth = DDSTextureParser::sMaxTexture2DDimension * 2U;
+		description.mHeight = 4U;
+		fileData = CreateFileData(description, 0UL);
+		CHECK(DDSTextureParser::ParseHeader(fileData.data(), fileData.size(), textureInfo) == DDSTextureParser::Result::NOT_SUPPORTED);
+		description.mWidth = 64U;
+		description.mHeight = 64U;
+
+		description.mArraySize = DDSTextureParser::sMaxArraySize + 1U;
+		fileData = CreateFileData(description, 0UL);
+		CHECK(DDSTextureParser::ParseHeader(fileData.data(), fileData.size(), textureInfo) == DDSTextureParser::Result::NOT_SUPPORTED);
+		description.mArraySize = 1U;
+
+		// Headers are valid, but subresources are not in the file
+		fileData = CreateFileData(description, 64UL * 64UL * 4UL - 1UL);
+		CHECK(DDSTextureParser::ParseHeader(fileData.data(), fileData.size(), textureInfo) == DDSTextureParser::Result::SUCCESS);
+		DDSTextureParser::SubresourceLayout layout;
+		std::uint32_t skippedMipCount{ 0U };
+		std::uint32_t width{ 0U };
+		std::uint32_t height{ 0U };
+		std::uint32_t depth{ 0U };
+		CHECK(DDSTextureParser::ComputeSubresourceLayouts(
+			textureInfo, 0UL, fileData.size(), &layout, skippedMipCount, width, height, depth) == DDSTextureParser::Result::END_OF_FILE);
+	}
+
+	// Files written by DDSTextureWriter are parsed back
+	void TestWrittenFiles() {
+		DDSTextureParser::TextureInfo textureInfo;
+		textureInfo.mDimension = DDSTextureParser::Dimension::TEXTURE2D;
+		textureInfo.mWidth = 64U;
+		textureInfo.mHeight = 64U;
+		textureInfo.mDepth = 1U;
+		textureInfo.mArraySize = 12U;
+		textureInfo.mMipCount = 7U;
+		textureInfo.mFormat = DXGI_FORMAT_BC1_UNORM;
+		textureInfo.mIsCubeMap = true;
+
+		std::vector<std::uint8_t> data(DDSTextureWriter::ComputeDataSize(textureInfo));
+		for (std::size_t i = 0UL; i < data.size(); ++i) {
+			data[i] = static_cast<std::uint8_t>(i * 7UL);
+		}
+		const std::string filePath{ TestUtils::GetTemporaryFilePath("DDSTextureParserTests.dds") };
+		CHECK(DDSTextureWriter::WriteFile(filePath.c_str(), textureInfo, data.data(), data.size()));
+
+		{
+			MemoryMappedFile file;
+			CHECK(file.Open(filePath.c_str()));
+			DDSTextureParser::TextureInfo parsedTextureInfo;
+			CHECK(DDSTextureParser::ParseHeader(file.GetData(), file.GetSize(), parsedTextureInfo) == DDSTextureParser::Result::SUCCESS);
+			CHECK(parsedTextureInfo.mIsCubeMap);
+			CHECK(parsedTextureInfo.mArraySize == 12U);
+			CHECK(parsedTextureInfo.mMipCount == 7U);
+			CHECK(parsedTextureInfo.mFormat == DXGI_FORMAT_BC1_UNORM);
+			CHECK(file.GetSize() == parsedTextureInfo.mDataOffset + data.size());
+			CHECK(std::memcmp(file.GetData() + parsedTextureInfo.mDataOffset, data.data(), data.size()) == 0);
+			CheckLayouts(file.GetData(), file.GetSize(), 0UL);
+		}
+		std::remove(filePath.c_str());
+	}
+
+	void TestResourceFiles() {
+		const std::vector<std::string> filePaths{ TestUtils::GetFilePaths(TestUtils::GetResourcesPath() + "textures", ".dds") };
+		CHECK(filePaths.empty() == false);
+		for (const std::string& filePath : filePaths) {
+			MemoryMappedFile file;
+			CHECK(file.Open(filePath.c_str()));
+			CheckLayouts(file.GetData(), file.GetSize(), 0UL);
+			CheckLayouts(file.GetData(), file.GetSize(), 256UL);
+		}
+	}
+}
+
+int main() {
+	RUN_TEST(TestLegacyHeaders);
+	RUN_TEST(TestExtendedHeaders);
+	RUN_TEST(TestCubeMapsAndArrays);
+	RUN_TEST(TestMalformedHeaders);
+	RUN_TEST(TestWrittenFiles);
+	RUN_TEST(TestResourceFiles);
+
+	return static_cast<int>(TestUtils::GetFailureCount());
+}
@@ -0,0 +1,202 @@
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <ResourceManager/DDSTextureParser.h>
+#include <ResourceManager/DDSTextureSubresources.h>
+#include <ResourceManager/DDSTextureWriter.h>
+#include <ResourceManager/MipGenerator.h>
+#include <TestUtils.h>
+
+namespace {
+	// Returns the file data of a 2D texture with a DX10 header and "mipMapCount" in its header,
+	// followed by the subresources of "textureInfo" (the texel of each byte is its offset)
+	std::vector<std::uint8_t> CreateFileData(
+		const DDSTextureParser::TextureInfo& textureInfo,
+		const std::uint32_t mipMapCount)
+	{
+		const std::size_t dataOffset{ sizeof(std::uint32_t) + sizeof(DDS_HEADER) + sizeof(DDS_HEADER_DXT10) };
+		std::vector<std::uint8_t> fileData(dataOffset + DDSTextureWriter::ComputeDataSize(textureInfo));
+		for (std::size_t i = dataOffset; i < fileData.size(); ++i) {
+			fileData[i] = static_cast<std::uint8_t>(i * 13UL);
+		}
+
+		const std::uint32_t magicNumber{ DDS_MAGIC };
+		std::memcpy(fileData.data(), &magicNumber, sizeof(std::uint32_t));
+
+		DDS_HEADER header;
+		std::memset(&header, 0, sizeof(DDS_HEADER));
+		header.size = sizeof(DDS_HEADER);
+		header.flags = DDS_HEIGHT | DDS_WIDTH;
+		header.width = textureInfo.mWidth;
+		header.height = textureInfo.mHeight;
+		header.depth = 1U;
+		header.mipMapCount = mipMapCount;
+		header.ddspf.size = sizeof(DDS_PIXELFORMAT);
+		header.ddspf.flags = DDS_FOURCC;
+		header.ddspf.fourCC = MAKEFOURCC('D', 'X', '1', '0');
+		std::memcpy(fileData.data() + sizeof(std::uint32_t), &header, sizeof(DDS_HEADER));
+
+		DDS_HEADER_DXT10 extendedHeader;
+		std::memset(&extendedHeader, 0, sizeof(DDS_HEADER_DXT10));
+		extendedHeader.dxgiFormat = textureInfo.mFormat;
+		extendedHeader.resourceDimension = static_cast<std::uint32_t>(DDSTextureParser::Dimension::TEXTURE2D);
+		extendedHeader.arraySize = textureInfo.mArraySize;
+		std::memcpy(fileData.data() + sizeof(std::uint32_t) + sizeof(DDS_HEADER), &extendedHeader, sizeof(DDS_HEADER_DXT10));
+
+		return fileData;
+	}
+
+	DDSTextureParser::TextureInfo GetTextureInfo(
+		const std::uint32_t width,
+		const std::uint32_t height,
+		const std::uint32_t mipCount,
+		const std::uint32_t arraySize,
+		const DXGI_FORMAT format)
+	{
+		DDSTextureParser::TextureInfo textureInfo;
+		textureInfo.mDimension = DDSTextureParser::Dimension::TEXTURE2D;
+		textureInfo.mWidth = width;
+		textureInfo.mHeight = height;
+		textureInfo.mDepth = 1U;
+		textureInfo.mArraySize = arraySize;
+		textureInfo.mMipCount = mipCount;
+		textureInfo.mFormat = format;
+
+		return textureInfo;
+	}
+
+	// Parses the file and computes its subresources, like DDSTextureLoader
+	DDSTextureParser::Result ComputeSubresources(
+		const std::vector<std::uint8_t>& fileData,
+		const std::size_t maxSize,
+		DDSTextureParser::TextureInfo& textureInfo,
+		DDSTextureSubresources::Subresources& subresources)
+	{
+		const DDSTextureParser::Result result{ DDSTextureParser::ParseHeader(fileData.data(), fileData.size(), textureInfo) };
+		if (result != DDSTextureParser::Result::SUCCESS) {
+			return result;
+		}
+
+		return DDSTextureSubresources::ComputeSubresources(fileData.data(), fileData.size(), textureInfo, maxSize, subresources);
+	}
+
+	// Subresources of the mips in the file point to the file, and they are the ones of the parser
+	void TestFullMipChain() {
+		const std::vector<std::uint8_t> fileData{ CreateFileData(GetTextureInfo(64U, 32U, 7U, 3U, DXGI_FORMAT_R8G8B8A8_UNORM), 7U) };
+		DDSTextureParser::TextureInfo textureInfo;
+		DDSTextureSubresources::Subresources subresources;
+		CHECK(ComputeSubresources(fileData, 0UL, textureInfo, subresources) == DDSTextureParser::Result::SUCCESS);
+		CHECK(subresources.mWidth == 64U && subresources.mHeight == 32U && subresources.mDepth == 1U);
+		CHECK(subresources.mMipCount == 7U);
+		CHECK(subresources.mGeneratedMipCount == 0U);
+		CHECK(subresources.mGeneratedMips.empty());
+		CHECK(subresources.mSubresources.size() == 7UL * 3UL);
+
+		std::vector<DDSTextureParser::SubresourceLayout> layouts(7UL * 3UL);
+		std::uint32_t skippedMipCount{ 0U };
+		std::uint32_t width{ 0U };
+		std::uint32_t height{ 0U };
+		std::uint32_t depth{ 0U };
+		DDSTextureParser::ComputeSubresourceLayouts(
+			textureInfo, 0UL, fileData.size(), layouts.data(), skippedMipCount, width, height, depth);
+		bool areEqual{ subresources.mSubresources.size() == layouts.size() };
+		for (std::size_t i = 0UL; areEqual && i < layouts.size(); ++i) {
+			const DDSTextureSubresources::SubresourceData& subresource = subresources.mSubresources[i];
+			areEqual =
+				subresource.mData == fileData.data() + layouts[i].mOffset &&
+				subresource.mRowPitch == layouts[i].mRowPitch &&
+				subresource.mSlicePitch == layouts[i].mSlicePitch;
+		}
+		CHECK(areEqual);
+
+		// Skipped mips are not generated again
+		CHECK(ComputeSubresources(fileData, 16UL, textureInfo, subresources) == DDSTextureParser::Result::SUCCESS);
+		CHECK(subresources.mWidth == 16U && subresources.mHeight == 8U);
+		CHECK(subresources.mMipCount == 5U);
+		CHECK(subresources.mGeneratedMipCount == 0U);
+		CHECK(subresources.mSubresources.size() == 5UL * 3UL);
+	}
+
+	// Missing mips are generated from the last mip of the file of each array slice
+	void TestPartialMipChain() {
+		const DDSTextureParser::TextureInfo partialTextureInfo{ GetTextureInfo(32U, 16U, 2U, 2U, DXGI_FORMAT_R8G8B8A8_UNORM) };
+		const std::vector<std::uint8_t> fileData{ CreateFileData(partialTextureInfo, 2U) };
+		DDSTextureParser::TextureInfo textureInfo;
+		DDSTextureSubresources::Subresources subresources;
+		CHECK(ComputeSubresources(fileData, 0UL, textureInfo, subresources) == DDSTextureParser::Result::SUCCESS);
+		CHECK(subresources.mMipCount == 6U);
+		CHECK(subresources.mGeneratedMipCount == 4U);
+		CHECK(subresources.mSubresources.size() == 6UL * 2UL);
+		if (subresources.mSubresources.size() != 6UL * 2UL) {
+			return;
+		}
+
+		// Mips of the file, and generated mips (8 x 4, 4 x 2, 2 x 1 and 1 x 1) after them
+		const std::size_t sliceSize{ DDSTextureWriter::ComputeDataSize(GetTextureInfo(32U, 16U, 2U, 1U, DXGI_FORMAT_R8G8B8A8_UNORM)) };
+		const std::uint8_t* slices[]{
+			fileData.data() + textureInfo.mDataOffset + 32UL * 16UL * 4UL,
+			fileData.data() + textureInfo.mDataOffset + sliceSize + 32UL * 16UL * 4UL };
+		const std::size_t sliceGeneratedMipsSize{ MipGenerator::GetMipsSize(16U, 8U, DXGI_FORMAT_R8G8B8A8_UNORM, 4U) };
+		std::vector<std::uint8_t> mips(sliceGeneratedMipsSize * 2UL);
+		MipGenerator::GenerateMips(slices, 2U, 16U, 8U, DXGI_FORMAT_R8G8B8A8_UNORM, MipGenerator::Filter::BOX, 4U, mips.data());
+		CHECK(subresources.mGeneratedMips == mips);
+
+		const std::size_t mipWidths[]{ 32UL, 16UL, 8UL, 4UL, 2UL, 1UL };
+		const std::size_t mipHeights[]{ 16UL, 8UL, 4UL, 2UL, 1UL, 1UL };
+		for (std::size_t j = 0UL; j < 2UL; ++j) {
+			const DDSTextureSubresources::SubresourceData* sliceSubresources{ &subresources.mSubresources[j * 6UL] };
+			CHECK(sliceSubresources[0UL].mData == fileData.data() + textureInfo.mDataOffset + j * sliceSize);
+			CHECK(sliceSubresources[1UL].mData == slices[j]);
+			CHECK(sliceSubresources[2UL].mData == subresources.mGeneratedMips.data() + j * sliceGeneratedMipsSize);
+			for (std::size_t i = 0UL; i < 6UL; ++i) {
+				CHECK(sliceSubresources[i].mRowPitch == mipWidths[i] * 4UL);
+				CHECK(sliceSubresources[i].mSlicePitch == mipWidths[i] * mipHeights[i] * 4UL);
+			}
+			for (std::size_t i = 3UL; i < 6UL; ++i) {
+				CHECK(sliceSubresources[i].mData == sliceSubresources[i - 1UL].mData + sliceSubresources[i - 1UL].mSlicePitch);
+			}
+		}
+
+		// Mips are not generated for formats that MipGenerator does not support
+		const std::vector<std::uint8_t> unsupportedFileData{
+			CreateFileData(GetTextureInfo(32U, 16U, 1U, 1U, DXGI_FORMAT_R16G16B16A16_FLOAT), 1U) };
+		CHECK(MipGenerator::IsFormatSupported(DXGI_FORMAT_R16G16B16A16_FLOAT) == false);
+		CHECK(ComputeSubresources(unsupportedFileData, 0UL, textureInfo, subresources) == DDSTextureParser::Result::SUCCESS);
+		CHECK(subresources.mMipCount == 1U);
+		CHECK(subresources.mGeneratedMipCount == 0U);
+	}
+
+	// Headers that claim more mips than the full mip chain (3 mips for 4 x 4) are rejected, and no mips are generated.
+	// Data of the file has the subresources of the claimed mips, so the mip count is the only wrong value.
+	void TestTooManyMipsAreRejected() {
+		const std::vector<std::uint8_t> fileData{ CreateFileData(GetTextureInfo(4U, 4U, 10U, 2U, DXGI_FORMAT_R8G8B8A8_UNORM), 10U) };
+		DDSTextureParser::TextureInfo textureInfo;
+		DDSTextureSubresources::Subresources subresources;
+		CHECK(ComputeSubresources(fileData, 0UL, textureInfo, subresources) == DDSTextureParser::Result::INVALID_DATA);
+		CHECK(subresources.mSubresources.empty());
+
+		// Texture information of the same header, not checked by the parser
+		textureInfo = GetTextureInfo(4U, 4U, 10U, 2U, DXGI_FORMAT_R8G8B8A8_UNORM);
+		textureInfo.mDataOffset = sizeof(std::uint32_t) + sizeof(DDS_HEADER) + sizeof(DDS_HEADER_DXT10);
+		CHECK(DDSTextureSubresources::ComputeSubresources(
+			fileData.data(), fileData.size(), textureInfo, 0UL, subresources) == DDSTextureParser::Result::INVALID_DATA);
+		CHECK(subresources.mSubresources.empty());
+		CHECK(subresources.mGeneratedMips.empty());
+
+		// The full mip chain is accepted
+		textureInfo.mMipCount = 3U;
+		CHECK(DDSTextureSubresources::ComputeSubresources(
+			fileData.data(), fileData.size(), textureInfo, 0UL, subresources) == DDSTextureParser::Result::SUCCESS);
+		CHECK(subresources.mMipCount == 3U);
+		CHECK(subresources.mGeneratedMipCount == 0U);
+	}
+}
+
+int main() {
+	RUN_TEST(TestFullMipChain);
+	RUN_TEST(TestPartialMipChain);
+	RUN_TEST(TestTooManyMipsAreRejected);
+
+	return static_cast<int>(TestUtils::GetFailureCount());
+}
@@ -0,0 +1,216 @@
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <DescriptorManager/DescriptorAllocator.h>
+#include <TestUtils.h>
+
+namespace {
+	const std::uint32_t sCapacity{ 4096U };
+
+	void TestRangesAreMerged() {
+		DescriptorAllocator allocator(sCapacity);
+		const std::uint32_t range1{ allocator.AllocateRange(10U) };
+		const std::uint32_t range2{ allocator.AllocateRange(20U) };
+		const std::uint32_t range3{ allocator.AllocateRange(30U) };
+		CHECK(range1 == 0U && range2 == 10U && range3 == 30U);
+
+		// Frees are deferred until their fence value is completed
+		allocator.FreeRange(range2, 20U, 1UL);
+		allocator.ReleaseCompletedFrees(0UL);
+		CHECK(allocator.GetFreeRangeCount() == 1U);
+		allocator.ReleaseCompletedFrees(1UL);
+		CHECK(allocator.GetFreeRangeCount() == 2U);
+
+		// Neighbors are merged into a single range
+		allocator.FreeRange(range1, 10U, 2UL);
+		allocator.FreeRange(range3, 30U, 2UL);
+		allocator.ReleaseCompletedFrees(2UL);
+		CHECK(allocator.GetFreeRangeCount() == 1U);
+		CHECK(allocator.GetLargestFreeRangeSize() == sCapacity);
+
+		CHECK(allocator.AllocateRange(sCapacity + 1U) == DescriptorAllocator::sInvalidIndex);
+		CHECK(allocator.AllocateRange(sCapacity) == 0U);
+	}
+
+	void TestSingleFreesAreDeferred() {
+		DescriptorAllocator allocator(sCapacity);
+		const std::uint32_t descriptorIndex{ allocator.Allocate() };
+		CHECK(descriptorIndex != DescriptorAllocator::sInvalidIndex);
+		const std::uint32_t freeListSize{ allocator.GetFreeListSize() };
+
+		allocator.Free(descriptorIndex, 5UL);
+		allocator.ReleaseCompletedFrees(4UL);
+		CHECK(allocator.GetFreeListSize() == freeListSize);
+		allocator.ReleaseCompletedFrees(5UL);
+		CHECK(allocator.GetFreeListSize() == freeListSize + 1U);
+	}
+
+	// Single descriptors freed beyond sMaxFreeListSize are merged with the free ranges,
+	// and the free list is returned to them when a range does not fit.
+	void TestSingleFreesAreCoalesced() {
+		DescriptorAllocator allocator(sCapacity);
+		std::vector<std::uint32_t> descriptorIndices;
+		std::uint32_t descriptorIndex{ 0U };
+		while ((descriptorIndex = allocator.Allocate()) != DescriptorAllocator::sInvalidIndex) {
+			descriptorIndices.push_back(descriptorIndex);
+		}
+		CHECK(descriptorIndices.size() == sCapacity);
+		CHECK(allocator.AllocateRange(1U) == DescriptorAllocator::sInvalidIndex);
+
+		for (const std::uint32_t index : descriptorIndices) {
+			allocator.Free(index, 1UL);
+		}
+		allocator.ReleaseCompletedFrees(1UL);
+		CHECK(allocator.GetFreeListSize() == DescriptorAllocator::sMaxFreeListSize);
+		CHECK(allocator.GetLargestFreeRangeSize() >= sCapacity / 2U);
+
+		// The whole heap as a single range, including the descriptors of the free list
+		CHECK(allocator.AllocateRange(sCapacity) == 0U);
+		CHECK(allocator.GetFreeListSize() == 0U);
+		CHECK(allocator.Allocate() == DescriptorAllocator::sInvalidIndex);
+	}
+
+	void TestMixedAllocationsDoNotOverlap() {
+		DescriptorAllocator allocator(sCapacity);
+		std::mt19937 generator(7U);
+		std::vector<std::uint8_t> isAllocated(sCapacity, 0U);
+
+		struct Allocation {
+			std::uint32_t mFirst;
+			std::uint32_t mCount;
+		};
+		std::vector<Allocation> allocations;
+
+		std::uint64_t fenceValue{ 1UL };
+		for (std::uint32_t i = 0U; i < 20000U; ++i) {
+			const std::uint32_t operation{ static_cast<std::uint32_t>(generator() % 4U) };
+			if (operation < 2U || allocations.empty()) {
+				const std::uint32_t count{ operation == 0U ? 1U : static_cast<std::uint32_t>(generator() % 32U) + 1U };
+				const std::uint32_t first{ count == 1U ? allocator.Allocate() : allocator.AllocateRange(count) };
+				if (first == DescriptorAllocator::sInvalidIndex) {
+					continue;
+				}
+
+				for (std::uint32_t j = 0U; j < count; ++j) {
+					CHECK(first + j < sCapacity);
+					CHECK(isAllocated[first + j] == 0U);
+					isAllocated[first + j] = 1U;
+				}
+				allocations.push_back(Allocation{ first, count });
+			} else {
+				const std::size_t allocationIndex{ generator() % allocations.size() };
+				const Allocation allocation{ allocations[allocationIndex] };
+				allocations[allocationIndex] = allocations.back();
+				allocations.pop_back();
+
+				for (std::uint32_t j = 0U; j < allocation.mCount; ++j) {
+					isAllocated[allocation.mFirst + j] = 0U;
+				}
+				if (allocation.mCount == 1U) {
+					allocator.Free(allocation.mFirst, fenceValue);
+				} else {
+					allocator.FreeRange(allocation.mFirst, allocation.mCount, fenceValue);
+				}
+			}
+
+			if (i % 64U == 0U) {
+				allocator.ReleaseCompletedFrees(fenceValue - 1UL);
+				++fenceValue;
+			}
+		}
+
+		for (const Allocation& allocation : allocations) {
+			if (allocation.mCount == 1U) {
+				allocator.Free(allocation.mFirst, fenceValue);
+			} else {
+				allocator.FreeRange(allocation.mFirst, allocation.mCount, fenceValue);
+			}
+		}
+		allocator.ReleaseCompletedFrees(fenceValue);
+
+		// Nothing is lost: the whole heap can be allocated again as a single range
+		CHECK(allocator.AllocateRange(sCapacity) == 0U);
+	}
+
+	void TestConcurrentSingleAllocations() {
+		const std::uint32_t threadCount{ 4U };
+		const std::uint32_t iterationCount{ 50000U };
+
+		DescriptorAllocator allocator(sCapacity);
+		std::unique_ptr<std::atomic<std::uint8_t>[]> isOwned(new std::atomic<std::uint8_t>[sCapacity]);
+		for (std::uint32_t i = 0U; i < sCapacity; ++i) {
+			isOwned[i] = 0U;
+		}
+
+		std::atomic<std::uint64_t> fenceValue{ 1UL };
+		std::atomic<bool> isTerminated{ false };
+		std::atomic<std::uint32_t> overlapCount{ 0U };
+		std::vector<std::thread> threads;
+		for (std::uint32_t i = 0U; i < threadCount; ++i) {
+			threads.emplace_back([&allocator, &isOwned, &fenceValue, &overlapCount]() {
+				std::vector<std::uint32_t> descriptorIndices;
+				for (std::uint32_t j = 0U; j < iterationCount; ++j) {
+					if (descriptorIndices.size() < 200UL) {
+						const std::uint32_t descriptorIndex{ allocator.Allocate() };
+						if (descriptorIndex != DescriptorAllocator::sInvalidIndex) {
+							if (isOwned[descriptorIndex].exchange(1U) != 0U) {
+								++overlapCount;
+							}
+							descriptorIndices.push_back(descriptorIndex);
+						}
+					} else {
+						for (const std::uint32_t descriptorIndex : descriptorIndices) {
+							isOwned[descriptorIndex] = 0U;
+							allocator.Free(descriptorIndex, fenceValue.load());
+						}
+						descriptorIndices.clear();
+					}
+				}
+
+				for (const std::uint32_t descriptorIndex : descriptorIndices) {
+					isOwned[descriptorIndex] = 0U;
+					allocator.Free(descriptorIndex, fenceValue.load());
+				}
+			});
+		}
+
+		// Like RenderManager, a single thread releases completed frees
+		std::thread releaseThread([&allocator, &fenceValue, &isTerminated]() {
+			while (isTerminated == false) {
+				const std::uint64_t completedFenceValue{ fenceValue.fetch_add(1UL) };
+				allocator.ReleaseCompletedFrees(completedFenceValue - 1UL);
+				std::this_thread::yield();
+			}
+		});
+
+		for (std::thread& thread : threads) {
+			thread.join();
+		}
+		isTerminated = true;
+		releaseThread.join();
+		CHECK(overlapCount == 0U);
+
+		allocator.ReleaseCompletedFrees(fenceValue.load());
+		std::set<std::uint32_t> descriptorIndices;
+		std::uint32_t descriptorIndex{ 0U };
+		while ((descriptorIndex = allocator.Allocate()) != DescriptorAllocator::sInvalidIndex) {
+			CHECK(descriptorIndices.insert(descriptorIndex).second);
+		}
+		CHECK(descriptorIndices.size() == sCapacity);
+	}
+}
+
+int main() {
+	RUN_TEST(TestRangesAreMerged);
+	RUN_TEST(TestSingleFreesAreDeferred);
+	RUN_TEST(TestSingleFreesAreCoalesced);
+	RUN_TEST(TestMixedAllocationsDoNotOverlap);
+	RUN_TEST(TestConcurrentSingleAllocations);
+
+	return static_cast<int>(TestUtils::GetFailureCount());
+}
@@ -0,0 +1,231 @@
+#include <cstdint>
+#include <vector>
+
+#include <RenderManager/FrameGraph.h>
+#include <TestUtils.h>
+
+namespace {
+	// Resource states as bit masks, like D3D12_RESOURCE_STATES
+	const std::uint32_t sPresent{ 0U };
+	const std::uint32_t sRenderTarget{ 0x4U };
+	const std::uint32_t sDepthWrite{ 0x10U };
+	const std::uint32_t sPixelShaderResource{ 0x80U };
+
+	bool HasTransition(
+		const std::vector<FrameGraph::Transition>& transitions,
+		const std::uint32_t resourceIndex,
+		const std::uint32_t stateBefore,
+		const std::uint32_t stateAfter) noexcept
+	{
+		for (const FrameGraph::Transition& transition : transitions) {
+			if (transition.mResourceIndex == resourceIndex &&
+				transition.mStateBefore == stateBefore &&
+				transition.mStateAfter == stateAfter)
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	// Same passes than RenderManager, plus a pass whose output is never used
+	void TestRenderManagerGraph() {
+		FrameGraph frameGraph;
+		const std::uint32_t geometryBuffer{ frameGraph.AddResource(sRenderTarget, false) };
+		const std::uint32_t depthBuffer{ frameGraph.AddResource(sDepthWrite, false) };
+		const std::uint32_t colorBuffer1{ frameGraph.AddResource(sRenderTarget, false) };
+		const std::uint32_t colorBuffer2{ frameGraph.AddResource(sPixelShaderResource, false) };
+		const std::uint32_t frameBuffer{ frameGraph.AddResource(sPresent, true) };
+		const std::uint32_t unusedBuffer{ frameGraph.AddResource(sRenderTarget, false) };
+
+		const std::uint32_t geometryPass{ frameGraph.AddPass(false) };
+		frameGraph.WriteResource(geometryPass, geometryBuffer, sRenderTarget);
+		frameGraph.WriteResource(geometryPass, depthBuffer, sDepthWrite);
+
+		const std::uint32_t unusedPass{ frameGraph.AddPass(false) };
+		frameGraph.ReadResource(unusedPass, geometryBuffer, sPixelShaderResource);
+		frameGraph.WriteResource(unusedPass, unusedBuffer, sRenderTarget);
+
+		const std::uint32_t lightingPass{ frameGraph.AddPass(false) };
+		frameGraph.ReadResource(lightingPass, geometryBuffer, sPixelShaderResource);
+		frameGraph.ReadResource(lightingPass, depthBuffer, sPixelShaderResource);
+		frameGraph.WriteResource(lightingPass, colorBuffer1, sRenderTarget);
+
+		const std::uint32_t skyBoxPass{ frameGraph.AddPass(false) };
+		frameGraph.WriteResource(skyBoxPass, depthBuffer, sDepthWrite);
+		frameGraph.WriteResource(skyBoxPass, colorBuffer1, sRenderTarget);
+
+		const std::uint32_t toneMappingPass{ frameGraph.AddPass(false) };
+		frameGraph.ReadResource(toneMappingPass, colorBuffer1, sPixelShaderResource);
+		frameGraph.WriteResource(toneMappingPass, colorBuffer2, sRenderTarget);
+
+		const std::uint32_t postProcessPass{ frameGraph.AddPass(false) };
+		frameGraph.ReadResource(postProcessPass, colorBuffer2, sPixelShaderResource);
+		frameGraph.WriteResource(postProcessPass, frameBuffer, sRenderTarget);
+
+		frameGraph.Compile();
+		CHECK(frameGraph.IsCompiled());
+
+		CHECK(frameGraph.IsPassCulled(unusedPass));
+		CHECK(frameGraph.GetTransitionsBeforePass(unusedPass).empty());
+		const std::vector<std::uint32_t> expectedExecutionOrder{ geometryPass, lightingPass, skyBoxPass, toneMappingPass, postProcessPass };
+		CHECK(frameGraph.GetExecutionOrder() == expectedExecutionOrder);
+
+		CHECK(frameGraph.GetTransitionsBeforePass(geometryPass).empty());
+		CHECK(frameGraph.GetTransitionsBeforePass(lightingPass).size() == 2UL);
+		CHECK(HasTransition(frameGraph.GetTransitionsBeforePass(lightingPass), geometryBuffer, sRenderTarget, sPixelShaderResource));
+		CHECK(HasTransition(frameGraph.GetTransitionsBeforePass(lightingPass), depthBuffer, sDepthWrite, sPixelShaderResource));
+		CHECK(frameGraph.GetTransitionsBeforePass(skyBoxPass).size() == 1UL);
+		CHECK(HasTransition(frameGraph.GetTransitionsBeforePass(skyBoxPass), depthBuffer, sPixelShaderResource, sDepthWrite));
+		CHECK(HasTransition(frameGraph.GetTransitionsBeforePass(toneMappingPass), colorBuffer1, sRenderTarget, sPixelShaderResource));
+		CHECK(HasTransition(frameGraph.GetTransitionsBeforePass(toneMappingPass), colorBuffer2, sPixelShaderResource, sRenderTarget));
+		CHECK(HasTransition(frameGraph.GetTransitionsBeforePass(postProcessPass), frameBuffer, sPresent, sRenderTarget));
+
+		// Resources go back to their initial states at the end of the frame
+		// (the second color buffer is already in its initial state)
+		const std::vector<FrameGraph::Transition>& finalTransitions = frameGraph.GetFinalTransitions();
+		CHECK(finalTransitions.size() == 3UL);
+		CHECK(HasTransition(finalTransitions, geometryBuffer, sPixelShaderResource, sRenderTarget));
+		CHECK(HasTransition(finalTransitions, colorBuffer1, sPixelShaderResource, sRenderTarget));
+		CHECK(HasTransition(finalTransitions, frameBuffer, sRenderTarget, sPresent));
+
+		// Lifetimes are positions in the execution order
+		CHECK(frameGraph.GetResourceLifetime(depthBuffer).mFirstPosition == 0U);
+		CHECK(frameGraph.GetResourceLifetime(depthBuffer).mLastPosition == 2U);
+		CHECK(frameGraph.GetResourceLifetime(colorBuffer2).mFirstPosition == 3U);
+		CHECK(frameGraph.GetResourceLifetime(colorBuffer2).mLastPosition == 4U);
+		CHECK(frameGraph.GetResourceLifetime(unusedBuffer).mFirstPosition == FrameGraph::sInvalidIndex);
+	}
+
+	// Passes declared before the passes whose output they read are executed after them
+	void TestOutOfOrderDeclaration() {
+		FrameGraph frameGraph;
+		const std::uint32_t colorBuffer{ frameGraph.AddResource(sRenderTarget, false) };
+		const std::uint32_t blurBuffer{ frameGraph.AddResource(sRenderTarget, false) };
+		const std::uint32_t frameBuffer{ frameGraph.AddResource(sPresent, true) };
+
+		const std::uint32_t presentPass{ frameGraph.AddPass(false) };
+		frameGraph.ReadResource(presentPass, blurBuffer, sPixelShaderResource);
+		frameGraph.WriteResource(presentPass, frameBuffer, sRenderTarget);
+
+		const std::uint32_t blurPass{ frameGraph.AddPass(false) };
+		frameGraph.ReadResource(blurPass, colorBuffer, sPixelShaderResource);
+		frameGraph.WriteResource(blurPass, blurBuffer, sRenderTarget);
+
+		const std::uint32_t colorPass{ frameGraph.AddPass(false) };
+		frameGraph.WriteResource(colorPass, colorBuffer, sRenderTarget);
+
+		frameGraph.Compile();
+
+		CHECK(frameGraph.IsPassCulled(colorPass) == false);
+		CHECK(frameGraph.IsPassCulled(blurPass) == false);
+		const std::vector<std::uint32_t> expectedExecutionOrder{ colorPass, blurPass, presentPass };
+		CHECK(frameGraph.GetExecutionOrder() == expectedExecutionOrder);
+
+		// Transitions follow the execution order
+		CHECK(frameGraph.GetTransitionsBeforePass(colorPass).empty());
+		CHECK(HasTransition(frameGraph.GetTransitionsBeforePass(blurPass), colorBuffer, sRenderTarget, sPixelShaderResource));
+		CHECK(frameGraph.GetResourceLifetime(colorBuffer).mFirstPosition == 0U);
+		CHECK(frameGraph.GetResourceLifetime(colorBuffer).mLastPosition == 1U);
+	}
+
+	// A pass that overwrites a resource is executed after the passes that read the previous content
+	void TestWriteAfterRead() {
+		FrameGraph frameGraph;
+		const std::uint32_t buffer{ frameGraph.AddResource(sRenderTarget, false) };
+		const std::uint32_t frameBuffer{ frameGraph.AddResource(sPresent, true) };
+
+		// Declared before the first writer, so it reads what the first writer writes
+		const std::uint32_t firstReaderPass{ frameGraph.AddPass(true) };
+		frameGraph.ReadResource(firstReaderPass, buffer, sPixelShaderResource);
+
+		const std::uint32_t firstWriterPass{ frameGraph.AddPass(false) };
+		frameGraph.WriteResource(firstWriterPass, buffer, sRenderTarget);
+
+		const std::uint32_t secondWriterPass{ frameGraph.AddPass(false) };
+		frameGraph.WriteResource(secondWriterPass, buffer, sRenderTarget);
+
+		const std::uint32_t secondReaderPass{ frameGraph.AddPass(false) };
+		frameGraph.ReadResource(secondReaderPass, buffer, sPixelShaderResource);
+		frameGraph.WriteResource(secondReaderPass, frameBuffer, sRenderTarget);
+
+		frameGraph.Compile();
+
+		const std::vector<std::uint32_t> expectedExecutionOrder{ firstWriterPass, firstReaderPass, secondWriterPass, secondReaderPass };
+		CHECK(frameGraph.GetExecutionOrder() == expectedExecutionOrder);
+		CHECK(HasTransition(frameGraph.GetTransitionsBeforePass(firstReaderPass), buffer, sRenderTarget, sPixelShaderResource));
+		CHECK(HasTransition(frameGraph.GetTransitionsBeforePass(secondWriterPass), buffer, sPixelShaderResource, sRenderTarget));
+	}
+
+	// Culled readers do not delay the writers of the resources they read
+	void TestCulledReader() {
+		FrameGraph frameGraph;
+		const std::uint32_t buffer{ frameGraph.AddResource(sRenderTarget, false) };
+		const std::uint32_t unusedBuffer{ frameGraph.AddResource(sRenderTarget, false) };
+		const std::uint32_t frameBuffer{ frameGraph.AddResource(sPresent, true) };
+
+		const std::uint32_t firstWriterPass{ frameGraph.AddPass(false) };
+		frameGraph.WriteResource(firstWriterPass, buffer, sRenderTarget);
+
+		const std::uint32_t unusedPass{ frameGraph.AddPass(false) };
+		frameGraph.ReadResource(unusedPass, buffer, sPixelShaderResource);
+		frameGraph.WriteResource(unusedPass, unusedBuffer, sRenderTarget);
+
+		const std::uint32_t secondWriterPass{ frameGraph.AddPass(false) };
+		frameGraph.WriteResource(secondWriterPass, buffer, sRenderTarget);
+		frameGraph.WriteResource(secondWriterPass, frameBuffer, sRenderTarget);
+
+		frameGraph.Compile();
+
+		CHECK(frameGraph.IsPassCulled(unusedPass));
+		const std::vector<std::uint32_t> expectedExecutionOrder{ firstWriterPass, secondWriterPass };
+		CHECK(frameGraph.GetExecutionOrder() == expectedExecutionOrder);
+	}
+
+	// Independent passes keep their declaration order, and passes with side effects are not culled
+	void TestIndependentPasses() {
+		FrameGraph frameGraph;
+		const std::uint32_t firstBuffer{ frameGraph.AddResource(sRenderTarget, true) };
+		const std::uint32_t secondBuffer{ frameGraph.AddResource(sRenderTarget, false) };
+
+		const std::uint32_t sideEffectPass{ frameGraph.AddPass(true) };
+		frameGraph.WriteResource(sideEffectPass, secondBuffer, sRenderTarget);
+
+		const std::uint32_t outputPass{ frameGraph.AddPass(false) };
+		frameGraph.WriteResource(outputPass, firstBuffer, sRenderTarget);
+
+		const std::uint32_t emptyPass{ frameGraph.AddPass(false) };
+
+		frameGraph.Compile();
+
+		CHECK(frameGraph.IsPassCulled(emptyPass));
+		const std::vector<std::uint32_t> expectedExecutionOrder{ sideEffectPass, outputPass };
+		CHECK(frameGraph.GetExecutionOrder() == expectedExecutionOrder);
+		CHECK(frameGraph.GetFinalTransitions().empty());
+	}
+
+	void TestClear() {
+		FrameGraph frameGraph;
+		const std::uint32_t buffer{ frameGraph.AddResource(sRenderTarget, true) };
+		const std::uint32_t pass{ frameGraph.AddPass(false) };
+		frameGraph.WriteResource(pass, buffer, sRenderTarget);
+		frameGraph.Compile();
+
+		frameGraph.Clear();
+		CHECK(frameGraph.IsCompiled() == false);
+		CHECK(frameGraph.GetPassCount() == 0U);
+		CHECK(frameGraph.GetResourceCount() == 0U);
+	}
+}
+
+int main() {
+	RUN_TEST(TestRenderManagerGraph);
+	RUN_TEST(TestOutOfOrderDeclaration);
+	RUN_TEST(TestWriteAfterRead);
+	RUN_TEST(TestCulledReader);
+	RUN_TEST(TestIndependentPasses);
+	RUN_TEST(TestClear);
+
+	return static_cast<int>(TestUtils::GetFailureCount());
+}
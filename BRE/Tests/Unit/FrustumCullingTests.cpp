@@ -0,0 +1,129 @@
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <MathUtils/FrustumCulling.h>
+#include <TestUtils.h>
+
+using namespace DirectX;
+
+namespace {
+	// Left handed perspective projection (like XMMatrixPerspectiveFovLH), with row vectors
+	XMFLOAT4X4 GetProjectionMatrix(
+		const float fieldOfViewY,
+		const float aspectRatio,
+		const float nearZ,
+		const float farZ) noexcept
+	{
+		const float height{ 1.0f / std::tan(0.5f * fieldOfViewY) };
+		const float width{ height / aspectRatio };
+		const float range{ farZ / (farZ - nearZ) };
+		return XMFLOAT4X4(
+			width, 0.0f, 0.0f, 0.0f,
+			0.0f, height, 0.0f, 0.0f,
+			0.0f, 0.0f, range, 1.0f,
+			0.0f, 0.0f, -range * nearZ, 0.0f);
+	}
+
+	// View matrix of a camera at "position" that looks to +z
+	XMFLOAT4X4 GetViewMatrix(const XMFLOAT3& position) noexcept {
+		return XMFLOAT4X4(
+			1.0f, 0.0f, 0.0f, 0.0f,
+			0.0f, 1.0f, 0.0f, 0.0f,
+			0.0f, 0.0f, 1.0f, 0.0f,
+			-position.x, -position.y, -position.z, 1.0f);
+	}
+
+	FrustumCulling::FrustumPlanes GetFrustumPlanes(const XMFLOAT3& cameraPosition) noexcept {
+		// 90 degrees field of view, square aspect ratio, near plane at 1 and far plane at 100
+		const XMFLOAT4X4 viewMatrix{ GetViewMatrix(cameraPosition) };
+		const XMFLOAT4X4 projectionMatrix{ GetProjectionMatrix(0.5f * 3.14159265f, 1.0f, 1.0f, 100.0f) };
+		FrustumCulling::FrustumPlanes frustumPlanes;
+		FrustumCulling::ExtractFrustumPlanes(viewMatrix, projectionMatrix, frustumPlanes);
+		return frustumPlanes;
+	}
+
+	void TestPlanesAreNormalized() {
+		const FrustumCulling::FrustumPlanes frustumPlanes{ GetFrustumPlanes(XMFLOAT3(0.0f, 0.0f, 0.0f)) };
+		for (const XMFLOAT4& plane : frustumPlanes.mPlanes) {
+			const float length{ std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z) };
+			CHECK(std::fabs(length - 1.0f) < 1.0e-4f);
+		}
+
+		// Near and far planes
+		const XMFLOAT4& nearPlane{ frustumPlanes.mPlanes[FrustumCulling::NEAR_PLANE] };
+		CHECK(std::fabs(nearPlane.z - 1.0f) < 1.0e-4f && std::fabs(nearPlane.w + 1.0f) < 1.0e-3f);
+		const XMFLOAT4& farPlane{ frustumPlanes.mPlanes[FrustumCulling::FAR_PLANE] };
+		CHECK(std::fabs(farPlane.z + 1.0f) < 1.0e-4f && std::fabs(farPlane.w - 100.0f) < 1.0e-2f);
+	}
+
+	void TestSphere() {
+		const FrustumCulling::FrustumPlanes frustumPlanes{ GetFrustumPlanes(XMFLOAT3(0.0f, 0.0f, 0.0f)) };
+
+		CHECK(FrustumCulling::IsSphereInsideFrustum(frustumPlanes, BoundingSphere(XMFLOAT3(0.0f, 0.0f, 10.0f), 1.0f)));
+
+		// Behind the camera, and intersecting the near plane
+		CHECK(FrustumCulling::IsSphereInsideFrustum(frustumPlanes, BoundingSphere(XMFLOAT3(0.0f, 0.0f, -10.0f), 1.0f)) == false);
+		CHECK(FrustumCulling::IsSphereInsideFrustum(frustumPlanes, BoundingSphere(XMFLOAT3(0.0f, 0.0f, 0.5f), 1.0f)));
+
+		// Beyond the far plane, and intersecting it
+		CHECK(FrustumCulling::IsSphereInsideFrustum(frustumPlanes, BoundingSphere(XMFLOAT3(0.0f, 0.0f, 102.0f), 1.0f)) == false);
+		CHECK(FrustumCulling::IsSphereInsideFrustum(frustumPlanes, BoundingSphere(XMFLOAT3(0.0f, 0.0f, 100.5f), 1.0f)));
+
+		// With a 90 degrees field of view, side planes are x = z and y = z (distance to the plane is (x - z) / sqrt(2))
+		CHECK(FrustumCulling::IsSphereInsideFrustum(frustumPlanes, BoundingSphere(XMFLOAT3(12.0f, 0.0f, 10.0f), 1.0f)) == false);
+		CHECK(FrustumCulling::IsSphereInsideFrustum(frustumPlanes, BoundingSphere(XMFLOAT3(11.0f, 0.0f, 10.0f), 1.0f)));
+		CHECK(FrustumCulling::IsSphereInsideFrustum(frustumPlanes, BoundingSphere(XMFLOAT3(-12.0f, 0.0f, 10.0f), 1.0f)) == false);
+		CHECK(FrustumCulling::IsSphereInsideFrustum(frustumPlanes, BoundingSphere(XMFLOAT3(0.0f, 12.0f, 10.0f), 1.0f)) == false);
+		CHECK(FrustumCulling::IsSphereInsideFrustum(frustumPlanes, BoundingSphere(XMFLOAT3(0.0f, -12.0f, 10.0f), 1.0f)) == false);
+	}
+
+	void TestCameraPosition() {
+		// Planes are in world space
+		const FrustumCulling::FrustumPlanes frustumPlanes{ GetFrustumPlanes(XMFLOAT3(50.0f, 0.0f, -10.0f)) };
+		CHECK(FrustumCulling::IsSphereInsideFrustum(frustumPlanes, BoundingSphere(XMFLOAT3(0.0f, 0.0f, 0.0f), 1.0f)) == false);
+		CHECK(FrustumCulling::IsSphereInsideFrustum(frustumPlanes, BoundingSphere(XMFLOAT3(50.0f, 0.0f, 0.0f), 1.0f)));
+	}
+
+	// CullSpheres() must give the same results than IsSphereInsideFrustum(), for sphere
+	// counts that are multiple of 4 or not
+	void TestCullSpheres() {
+		const FrustumCulling::FrustumPlanes frustumPlanes{ GetFrustumPlanes(XMFLOAT3(0.0f, 0.0f, 0.0f)) };
+
+		std::mt19937 generator(1U);
+		std::uniform_real_distribution<float> positionDistribution(-120.0f, 120.0f);
+		std::uniform_real_distribution<float> radiusDistribution(0.1f, 10.0f);
+
+		for (std::uint32_t sphereCount = 1U; sphereCount < 1000U; sphereCount += 37U) {
+			std::vector<BoundingSphere> spheres(sphereCount);
+			for (BoundingSphere& sphere : spheres) {
+				sphere.Center = XMFLOAT3(positionDistribution(generator), positionDistribution(generator), positionDistribution(generator));
+				sphere.Radius = radiusDistribution(generator);
+			}
+
+			std::vector<std::uint8_t> visibilityFlags(sphereCount, 2U);
+			const std::uint32_t visibleCount{ FrustumCulling::CullSpheres(frustumPlanes, spheres.data(), sphereCount, visibilityFlags.data()) };
+
+			std::uint32_t expectedVisibleCount{ 0U };
+			std::uint32_t mismatchCount{ 0U };
+			for (std::uint32_t i = 0U; i < sphereCount; ++i) {
+				const bool isVisible{ FrustumCulling::IsSphereInsideFrustum(frustumPlanes, spheres[i]) };
+				expectedVisibleCount += isVisible ? 1U : 0U;
+				mismatchCount += (visibilityFlags[i] == (isVisible ? 1U : 0U)) ? 0U : 1U;
+			}
+
+			CHECK(mismatchCount == 0U);
+			CHECK(visibleCount == expectedVisibleCount);
+		}
+	}
+}
+
+int main() {
+	RUN_TEST(TestPlanesAreNormalized);
+	RUN_TEST(TestSphere);
+	RUN_TEST(TestCameraPosition);
+	RUN_TEST(TestCullSpheres);
+
+	return static_cast<int>(TestUtils::GetFailureCount());
+}
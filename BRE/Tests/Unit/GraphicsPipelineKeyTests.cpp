@@ -0,0 +1,284 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <PSOManager/GraphicsPipelineKey.h>
+#include <PSOManager/PipelineKeyBuilder.h>
+#include <TestUtils.h>
+
+namespace {
+	// Content of a pipeline state. Its key data references it, so it must not be moved.
+	struct PipelineState {
+		PipelineState() {
+			for (std::uint32_t i = 0U; i < 5U; ++i) {
+				mShaderBytecodes[i].resize(1000UL + i * 100UL);
+				for (std::size_t j = 0UL; j < mShaderBytecodes[i].size(); ++j) {
+					mShaderBytecodes[i][j] = static_cast<std::uint8_t>(i * 31U + j * 7U);
+				}
+			}
+
+			mInputElements.push_back(D3D12_INPUT_ELEMENT_DESC{
+				"POSITION", 0U, DXGI_FORMAT_R32G32B32_FLOAT, 0U, 0U, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0U });
+			mInputElements.push_back(D3D12_INPUT_ELEMENT_DESC{
+				"TEXCOORD", 0U, DXGI_FORMAT_R32G32_FLOAT, 0U, 12U, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0U });
+
+			// Padding bytes have a value that is not zero, to check that they are ignored
+			std::memset(&mKeyData.mBlendDescriptor, 0xCD, sizeof(mKeyData.mBlendDescriptor));
+			std::memset(&mKeyData.mDepthStencilDescriptor, 0xCD, sizeof(mKeyData.mDepthStencilDescriptor));
+
+			mKeyData.mRootSignatureKey = 0x0123456789ABCDEFUL;
+			mKeyData.mBlendDescriptor.AlphaToCoverageEnable = 0;
+			mKeyData.mBlendDescriptor.IndependentBlendEnable = 0;
+			for (D3D12_RENDER_TARGET_BLEND_DESC& renderTargetBlend : mKeyData.mBlendDescriptor.RenderTarget) {
+				renderTargetBlend.BlendEnable = 0;
+				renderTargetBlend.LogicOpEnable = 0;
+				renderTargetBlend.SrcBlend = D3D12_BLEND_ONE;
+				renderTargetBlend.DestBlend = D3D12_BLEND_ZERO;
+				renderTargetBlend.BlendOp = D3D12_BLEND_OP_ADD;
+				renderTargetBlend.SrcBlendAlpha = D3D12_BLEND_ONE;
+				renderTargetBlend.DestBlendAlpha = D3D12_BLEND_ZERO;
+				renderTargetBlend.BlendOpAlpha = D3D12_BLEND_OP_ADD;
+				renderTargetBlend.LogicOp = D3D12_LOGIC_OP_NOOP;
+				renderTargetBlend.RenderTargetWriteMask = D3D12_COLOR_WRITE_ENABLE_ALL;
+			}
+
+			D3D12_RASTERIZER_DESC& rasterizer{ mKeyData.mRasterizerDescriptor };
+			rasterizer.FillMode = D3D12_FILL_MODE_SOLID;
+			rasterizer.CullMode = D3D12_CULL_MODE_BACK;
+			rasterizer.FrontCounterClockwise = 0;
+			rasterizer.DepthBias = 0;
+			rasterizer.DepthBiasClamp = 0.0f;
+			rasterizer.SlopeScaledDepthBias = 0.0f;
+			rasterizer.DepthClipEnable = 1;
+			rasterizer.MultisampleEnable = 0;
+			rasterizer.AntialiasedLineEnable = 0;
+			rasterizer.ForcedSampleCount = 0U;
+			rasterizer.ConservativeRaster = D3D12_CONSERVATIVE_RASTERIZATION_MODE_OFF;
+
+			D3D12_DEPTH_STENCIL_DESC& depthStencil{ mKeyData.mDepthStencilDescriptor };
+			depthStencil.DepthEnable = 1;
+			depthStencil.DepthWriteMask = D3D12_DEPTH_WRITE_MASK_ALL;
+			depthStencil.DepthFunc = D3D12_COMPARISON_FUNC_LESS;
+			depthStencil.StencilEnable = 0;
+			depthStencil.StencilReadMask = 0xFFU;
+			depthStencil.StencilWriteMask = 0xFFU;
+			const D3D12_DEPTH_STENCILOP_DESC stencilOperation{
+				D3D12_STENCIL_OP_KEEP, D3D12_STENCIL_OP_KEEP, D3D12_STENCIL_OP_KEEP, D3D12_COMPARISON_FUNC_ALWAYS };
+			depthStencil.FrontFace = stencilOperation;
+			depthStencil.BackFace = stencilOperation;
+
+			mKeyData.mNumRenderTargets = 2U;
+			mKeyData.mRenderTargetFormats[0U] = DXGI_FORMAT_R16G16B16A16_FLOAT;
+			mKeyData.mRenderTargetFormats[1U] = DXGI_FORMAT_R8G8B8A8_UNORM;
+			mKeyData.mDepthStencilFormat = DXGI_FORMAT_D32_FLOAT;
+
+			UpdateReferences();
+		}
+
+		PipelineState(const PipelineState& pipelineState)
+			: mInputElements(pipelineState.mInputElements)
+			, mKeyData(pipelineState.mKeyData)
+		{
+			for (std::uint32_t i = 0U; i < 5U; ++i) {
+				mShaderBytecodes[i] = pipelineState.mShaderBytecodes[i];
+			}
+			UpdateReferences();
+		}
+
+		const PipelineState& operator=(const PipelineState&) = delete;
+
+		// Input elements and shader bytecode are referenced by the key data
+		void UpdateReferences() {
+			mKeyData.mInputElements = mInputElements.data();
+			mKeyData.mInputElementCount = static_cast<std::uint32_t>(mInputElements.size());
+			D3D12_SHADER_BYTECODE* shaderBytecodes[]{
+				&mKeyData.mVertexShaderBytecode,
+				&mKeyData.mGeometryShaderBytecode,
+				&mKeyData.mDomainShaderBytecode,
+				&mKeyData.mHullShaderBytecode,
+				&mKeyData.mPixelShaderBytecode };
+			for (std::uint32_t i = 0U; i < 5U; ++i) {
+				shaderBytecodes[i]->pShaderBytecode = mShaderBytecodes[i].data();
+				shaderBytecodes[i]->BytecodeLength = mShaderBytecodes[i].size();
+			}
+		}
+
+		std::uint64_t GetKey() const {
+			return ComputeGraphicsPipelineKey(mKeyData);
+		}
+
+		// Vertex, geometry, domain, hull and pixel shaders
+		std::vector<std::uint8_t> mShaderBytecodes[5U];
+		std::vector<D3D12_INPUT_ELEMENT_DESC> mInputElements;
+		GraphicsPipelineKeyData mKeyData;
+	};
+
+	struct Change {
+		const char* mName;
+		std::function<void(PipelineState&)> mFunction;
+	};
+
+	// Values are appended in order, and their boundaries are part of the key
+	void TestKeyBuilder() {
+		PipelineKeyBuilder keyBuilder1;
+		PipelineKeyBuilder keyBuilder2;
+		keyBuilder1.AddString("AB");
+		keyBuilder1.AddString("C");
+		keyBuilder2.AddString("A");
+		keyBuilder2.AddString("BC");
+		CHECK(keyBuilder1.GetKey() != keyBuilder2.GetKey());
+
+		keyBuilder1.Clear();
+		keyBuilder2.Clear();
+		keyBuilder1.AddString(nullptr);
+		keyBuilder2.AddString("");
+		CHECK(keyBuilder1.GetKey() != keyBuilder2.GetKey());
+
+		keyBuilder1.Clear();
+		keyBuilder2.Clear();
+		keyBuilder1.AddValue(1U);
+		keyBuilder1.AddValue(2U);
+		keyBuilder2.AddValue(2U);
+		keyBuilder2.AddValue(1U);
+		CHECK(keyBuilder1.GetKey() != keyBuilder2.GetKey());
+
+		// Data is identified by its content, not by its address
+		const std::vector<std::uint8_t> data1(5000UL, 1U);
+		const std::vector<std::uint8_t> data2(data1);
+		keyBuilder1.Clear();
+		keyBuilder2.Clear();
+		keyBuilder1.AddData(data1.data(), data1.size());
+		keyBuilder2.AddData(data2.data(), data2.size());
+		CHECK(keyBuilder1.GetKey() == keyBuilder2.GetKey());
+		keyBuilder2.Clear();
+		keyBuilder2.AddData(data2.data(), data2.size() - 1UL);
+		CHECK(keyBuilder1.GetKey() != keyBuilder2.GetKey());
+	}
+
+	// Equal pipeline states in different memory have the same key, padding bytes are ignored,
+	// and the key is the same in every execution (if it changes, then the cached pipelines are
+	// not found, and PipelineCacheFile::sFormatVersion must be increased)
+	void TestKeyStability() {
+		const PipelineState pipelineState;
+		const std::uint64_t key{ pipelineState.GetKey() };
+		CHECK(key == pipelineState.GetKey());
+
+		const PipelineState copiedPipelineState(pipelineState);
+		CHECK(copiedPipelineState.mKeyData.mVertexShaderBytecode.pShaderBytecode !=
+			pipelineState.mKeyData.mVertexShaderBytecode.pShaderBytecode);
+		CHECK(copiedPipelineState.GetKey() == key);
+
+		PipelineState paddedPipelineState;
+		std::uint8_t* padding{ &paddedPipelineState.mKeyData.mBlendDescriptor.RenderTarget[0U].RenderTargetWriteMask + 1U };
+		std::memset(padding, 0xAB, sizeof(D3D12_RENDER_TARGET_BLEND_DESC) - offsetof(D3D12_RENDER_TARGET_BLEND_DESC, RenderTargetWriteMask) - 1UL);
+		std::memset(&paddedPipelineState.mKeyData.mDepthStencilDescriptor.StencilWriteMask + 1U, 0xAB, 2UL);
+		CHECK(paddedPipelineState.GetKey() == key);
+
+		// Semantic names are identified by their content
+		const std::string semanticName{ "POSITION" };
+		PipelineState namedPipelineState;
+		namedPipelineState.mInputElements[0U].SemanticName = semanticName.c_str();
+		CHECK(namedPipelineState.GetKey() == key);
+
+		// Key of the first execution
+		CHECK(key == 0x893F31698BEDCB76UL);
+	}
+
+	// Every member of the pipeline state changes the key
+	void TestKeySensitivity() {
+		const std::uint64_t key{ PipelineState().GetKey() };
+		const std::vector<Change> changes{
+			{ "root signature", [](PipelineState& s) { s.mKeyData.mRootSignatureKey ^= 1UL; } },
+			{ "input element count", [](PipelineState& s) { s.mInputElements.pop_back(); } },
+			{ "input element order", [](PipelineState& s) { std::swap(s.mInputElements[0U], s.mInputElements[1U]); } },
+			{ "SemanticName", [](PipelineState& s) { s.mInputElements[0U].SemanticName = "NORMAL"; } },
+			{ "SemanticName nullptr", [](PipelineState& s) { s.mInputElements[0U].SemanticName = nullptr; } },
+			{ "SemanticIndex", [](PipelineState& s) { s.mInputElements[0U].SemanticIndex = 1U; } },
+			{ "Format", [](PipelineState& s) { s.mInputElements[0U].Format = DXGI_FORMAT_R32G32B32A32_FLOAT; } },
+			{ "InputSlot", [](PipelineState& s) { s.mInputElements[0U].InputSlot = 1U; } },
+			{ "AlignedByteOffset", [](PipelineState& s) { s.mInputElements[1U].AlignedByteOffset = 16U; } },
+			{ "InputSlotClass", [](PipelineState& s) { s.mInputElements[1U].InputSlotClass = D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA; } },
+			{ "InstanceDataStepRate", [](PipelineState& s) { s.mInputElements[1U].InstanceDataStepRate = 1U; } },
+			{ "vertex shader", [](PipelineState& s) { s.mShaderBytecodes[0U].back() ^= 1U; } },
+			{ "geometry shader", [](PipelineState& s) { s.mShaderBytecodes[1U].back() ^= 1U; } },
+			{ "domain shader", [](PipelineState& s) { s.mShaderBytecodes[2U].back() ^= 1U; } },
+			{ "hull shader", [](PipelineState& s) { s.mShaderBytecodes[3U].back() ^= 1U; } },
+			{ "pixel shader", [](PipelineState& s) { s.mShaderBytecodes[4U].back() ^= 1U; } },
+			{ "shader length", [](PipelineState& s) { s.mShaderBytecodes[0U].pop_back(); } },
+			{ "shader stage", [](PipelineState& s) { std::swap(s.mShaderBytecodes[1U], s.mShaderBytecodes[2U]); } },
+			{ "no shader", [](PipelineState& s) { s.mShaderBytecodes[1U].clear(); } },
+			{ "AlphaToCoverageEnable", [](PipelineState& s) { s.mKeyData.mBlendDescriptor.AlphaToCoverageEnable = 1; } },
+			{ "IndependentBlendEnable", [](PipelineState& s) { s.mKeyData.mBlendDescriptor.IndependentBlendEnable = 1; } },
+			{ "BlendEnable", [](PipelineState& s) { s.mKeyData.mBlendDescriptor.RenderTarget[0U].BlendEnable = 1; } },
+			{ "LogicOpEnable", [](PipelineState& s) { s.mKeyData.mBlendDescriptor.RenderTarget[0U].LogicOpEnable = 1; } },
+			{ "SrcBlend", [](PipelineState& s) { s.mKeyData.mBlendDescriptor.RenderTarget[0U].SrcBlend = D3D12_BLEND_SRC_ALPHA; } },
+			{ "DestBlend", [](PipelineState& s) { s.mKeyData.mBlendDescriptor.RenderTarget[0U].DestBlend = D3D12_BLEND_INV_SRC_ALPHA; } },
+			{ "BlendOp", [](PipelineState& s) { s.mKeyData.mBlendDescriptor.RenderTarget[0U].BlendOp = D3D12_BLEND_OP_SUBTRACT; } },
+			{ "SrcBlendAlpha", [](PipelineState& s) { s.mKeyData.mBlendDescriptor.RenderTarget[0U].SrcBlendAlpha = D3D12_BLEND_SRC_ALPHA; } },
+			{ "DestBlendAlpha", [](PipelineState& s) { s.mKeyData.mBlendDescriptor.RenderTarget[0U].DestBlendAlpha = D3D12_BLEND_INV_SRC_ALPHA; } },
+			{ "BlendOpAlpha", [](PipelineState& s) { s.mKeyData.mBlendDescriptor.RenderTarget[0U].BlendOpAlpha = D3D12_BLEND_OP_SUBTRACT; } },
+			{ "LogicOp", [](PipelineState& s) { s.mKeyData.mBlendDescriptor.RenderTarget[0U].LogicOp = D3D12_LOGIC_OP_COPY; } },
+			{ "RenderTargetWriteMask", [](PipelineState& s) { s.mKeyData.mBlendDescriptor.RenderTarget[0U].RenderTargetWriteMask = D3D12_COLOR_WRITE_ENABLE_RED; } },
+			{ "last render target blend", [](PipelineState& s) { s.mKeyData.mBlendDescriptor.RenderTarget[7U].BlendEnable = 1; } },
+			{ "FillMode", [](PipelineState& s) { s.mKeyData.mRasterizerDescriptor.FillMode = D3D12_FILL_MODE_WIREFRAME; } },
+			{ "CullMode", [](PipelineState& s) { s.mKeyData.mRasterizerDescriptor.CullMode = D3D12_CULL_MODE_NONE; } },
+			{ "FrontCounterClockwise", [](PipelineState& s) { s.mKeyData.mRasterizerDescriptor.FrontCounterClockwise = 1; } },
+			{ "DepthBias", [](PipelineState& s) { s.mKeyData.mRasterizerDescriptor.DepthBias = 1; } },
+			{ "DepthBiasClamp", [](PipelineState& s) { s.mKeyData.mRasterizerDescriptor.DepthBiasClamp = 1.0f; } },
+			{ "SlopeScaledDepthBias", [](PipelineState& s) { s.mKeyData.mRasterizerDescriptor.SlopeScaledDepthBias = 1.0f; } },
+			{ "DepthClipEnable", [](PipelineState& s) { s.mKeyData.mRasterizerDescriptor.DepthClipEnable = 0; } },
+			{ "MultisampleEnable", [](PipelineState& s) { s.mKeyData.mRasterizerDescriptor.MultisampleEnable = 1; } },
+			{ "AntialiasedLineEnable", [](PipelineState& s) { s.mKeyData.mRasterizerDescriptor.AntialiasedLineEnable = 1; } },
+			{ "ForcedSampleCount", [](PipelineState& s) { s.mKeyData.mRasterizerDescriptor.ForcedSampleCount = 4U; } },
+			{ "ConservativeRaster", [](PipelineState& s) { s.mKeyData.mRasterizerDescriptor.ConservativeRaster = D3D12_CONSERVATIVE_RASTERIZATION_MODE_ON; } },
+			{ "DepthEnable", [](PipelineState& s) { s.mKeyData.mDepthStencilDescriptor.DepthEnable = 0; } },
+			{ "DepthWriteMask", [](PipelineState& s) { s.mKeyData.mDepthStencilDescriptor.DepthWriteMask = D3D12_DEPTH_WRITE_MASK_ZERO; } },
+			{ "DepthFunc", [](PipelineState& s) { s.mKeyData.mDepthStencilDescriptor.DepthFunc = D3D12_COMPARISON_FUNC_EQUAL; } },
+			{ "StencilEnable", [](PipelineState& s) { s.mKeyData.mDepthStencilDescriptor.StencilEnable = 1; } },
+			{ "StencilReadMask", [](PipelineState& s) { s.mKeyData.mDepthStencilDescriptor.StencilReadMask = 0x0FU; } },
+			{ "StencilWriteMask", [](PipelineState& s) { s.mKeyData.mDepthStencilDescriptor.StencilWriteMask = 0x0FU; } },
+			{ "FrontFace.StencilFailOp", [](PipelineState& s) { s.mKeyData.mDepthStencilDescriptor.FrontFace.StencilFailOp = D3D12_STENCIL_OP_ZERO; } },
+			{ "FrontFace.StencilDepthFailOp", [](PipelineState& s) { s.mKeyData.mDepthStencilDescriptor.FrontFace.StencilDepthFailOp = D3D12_STENCIL_OP_ZERO; } },
+			{ "FrontFace.StencilPassOp", [](PipelineState& s) { s.mKeyData.mDepthStencilDescriptor.FrontFace.StencilPassOp = D3D12_STENCIL_OP_REPLACE; } },
+			{ "FrontFace.StencilFunc", [](PipelineState& s) { s.mKeyData.mDepthStencilDescriptor.FrontFace.StencilFunc = D3D12_COMPARISON_FUNC_NEVER; } },
+			{ "BackFace.StencilFailOp", [](PipelineState& s) { s.mKeyData.mDepthStencilDescriptor.BackFace.StencilFailOp = D3D12_STENCIL_OP_ZERO; } },
+			{ "BackFace.StencilDepthFailOp", [](PipelineState& s) { s.mKeyData.mDepthStencilDescriptor.BackFace.StencilDepthFailOp = D3D12_STENCIL_OP_ZERO; } },
+			{ "BackFace.StencilPassOp", [](PipelineState& s) { s.mKeyData.mDepthStencilDescriptor.BackFace.StencilPassOp = D3D12_STENCIL_OP_REPLACE; } },
+			{ "BackFace.StencilFunc", [](PipelineState& s) { s.mKeyData.mDepthStencilDescriptor.BackFace.StencilFunc = D3D12_COMPARISON_FUNC_NEVER; } },
+			{ "NumRenderTargets", [](PipelineState& s) { s.mKeyData.mNumRenderTargets = 1U; } },
+			{ "RenderTargetFormats", [](PipelineState& s) { s.mKeyData.mRenderTargetFormats[1U] = DXGI_FORMAT_R8G8B8A8_UNORM_SRGB; } },
+			{ "last RenderTargetFormats", [](PipelineState& s) { s.mKeyData.mRenderTargetFormats[7U] = DXGI_FORMAT_R8G8B8A8_UNORM; } },
+			{ "DepthStencilFormat", [](PipelineState& s) { s.mKeyData.mDepthStencilFormat = DXGI_FORMAT_D32_FLOAT_S8X24_UINT; } },
+			{ "SampleDesc.Count", [](PipelineState& s) { s.mKeyData.mSampleDescriptor.Count = 4U; } },
+			{ "SampleDesc.Quality", [](PipelineState& s) { s.mKeyData.mSampleDescriptor.Quality = 1U; } },
+			{ "SampleMask", [](PipelineState& s) { s.mKeyData.mSampleMask = 1U; } },
+			{ "PrimitiveTopologyType", [](PipelineState& s) { s.mKeyData.mPrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_PATCH; } },
+		};
+
+		std::vector<std::uint64_t> changedKeys;
+		for (const Change& change : changes) {
+			PipelineState pipelineState;
+			change.mFunction(pipelineState);
+			pipelineState.UpdateReferences();
+			const std::uint64_t changedKey{ pipelineState.GetKey() };
+			TestUtils::Check(changedKey != key, change.mName, __FILE__, __LINE__);
+
+			for (const std::uint64_t otherKey : changedKeys) {
+				TestUtils::Check(changedKey != otherKey, change.mName, __FILE__, __LINE__);
+			}
+			changedKeys.push_back(changedKey);
+		}
+	}
+}
+
+int main() {
+	RUN_TEST(TestKeyBuilder);
+	RUN_TEST(TestKeyStability);
+	RUN_TEST(TestKeySensitivity);
+
+	return static_cast<int>(TestUtils::GetFailureCount());
+}
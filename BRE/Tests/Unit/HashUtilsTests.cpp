@@ -0,0 +1,67 @@
+#include <cstdint>
+#include <cstring>
+#include <set>
+#include <vector>
+
+#include <TestUtils.h>
+#include <Utils/HashUtils.h>
+
+namespace {
+	std::uint64_t HashString(const char* str, const std::uint64_t seed = 0UL) {
+		return HashUtils::HashData(str, std::strlen(str), seed);
+	}
+
+	// Reference values of xxHash64 with seed 0
+	void TestKnownValues() {
+		CHECK(HashString("") == 0xEF46DB3751D8E999UL);
+		CHECK(HashString("a") == 0xD24EC4F1A98C6E5BUL);
+		CHECK(HashString("abc") == 0x44BC2CF5AD770999UL);
+		CHECK(HashString("Nobody inspects the spammish repetition") == 0xFBCEA83C8A378BF1UL);
+	}
+
+	void TestSeedChangesHash() {
+		CHECK(HashString("abc", 1UL) != HashString("abc"));
+		CHECK(HashString("abc", 1UL) == HashString("abc", 1UL));
+	}
+
+	// The hash depends on the bytes, and not on their alignment, for every length
+	// up to and beyond a stripe (32 bytes)
+	void TestHashDoesNotDependOnAlignment() {
+		std::vector<std::uint8_t> data(256U);
+		for (std::size_t i = 0UL; i < data.size(); ++i) {
+			data[i] = static_cast<std::uint8_t>(i * 2654435761U >> 13U);
+		}
+
+		std::vector<std::uint8_t> unalignedData(data.size() + 7UL);
+		for (std::size_t offset = 1UL; offset < 8UL; ++offset) {
+			std::memcpy(unalignedData.data() + offset, data.data(), data.size());
+			for (std::size_t size = 0UL; size <= data.size(); ++size) {
+				CHECK(HashUtils::HashData(data.data(), size) == HashUtils::HashData(unalignedData.data() + offset, size));
+			}
+		}
+	}
+
+	// Every prefix and every single bit flip of a buffer has a different hash
+	void TestHashesAreDifferent() {
+		std::vector<std::uint8_t> data(128U, 0U);
+		std::set<std::uint64_t> hashes;
+		for (std::size_t size = 0UL; size <= data.size(); ++size) {
+			CHECK(hashes.insert(HashUtils::HashData(data.data(), size)).second);
+		}
+
+		for (std::size_t i = 0UL; i < data.size() * 8UL; ++i) {
+			data[i / 8UL] ^= static_cast<std::uint8_t>(1U << (i % 8UL));
+			CHECK(hashes.insert(HashUtils::HashData(data.data(), data.size())).second);
+			data[i / 8UL] ^= static_cast<std::uint8_t>(1U << (i % 8UL));
+		}
+	}
+}
+
+int main() {
+	RUN_TEST(TestKnownValues);
+	RUN_TEST(TestSeedChangesHash);
+	RUN_TEST(TestHashDoesNotDependOnAlignment);
+	RUN_TEST(TestHashesAreDifferent);
+
+	return static_cast<int>(TestUtils::GetFailureCount());
+}
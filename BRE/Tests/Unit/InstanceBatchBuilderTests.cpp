@@ -0,0 +1,185 @@
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <GeometryPass/InstanceBatchBuilder.h>
+#include <ModelManager/MeshLod.h>
+#include <TestUtils.h>
+
+namespace {
+	using InstanceBatch = InstanceBatchBuilder::InstanceBatch;
+
+	// Instances of several geometry data, with their visibility flags and levels of detail
+	struct Scene {
+		std::vector<std::uint32_t> mInstanceCounts;
+		std::vector<std::uint8_t> mVisibilityFlags;
+		std::vector<std::uint8_t> mLodIndices;
+	};
+
+	std::uint32_t PackVisibleInstances(
+		const Scene& scene,
+		std::vector<std::uint32_t>& packedInstanceIndices,
+		std::vector<InstanceBatch>& batches)
+	{
+		packedInstanceIndices.assign(scene.mVisibilityFlags.size(), 0xFFFFFFFFU);
+		return InstanceBatchBuilder::PackVisibleInstances(
+			scene.mVisibilityFlags.data(),
+			scene.mLodIndices.data(),
+			scene.mInstanceCounts.data(),
+			static_cast<std::uint32_t>(scene.mInstanceCounts.size()),
+			packedInstanceIndices.data(),
+			batches);
+	}
+
+	Scene CreateRandomScene(const std::uint32_t geometryDataCount, const float visibleRatio, const std::uint32_t seed) {
+		std::mt19937 generator(seed);
+		std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+		Scene scene;
+		for (std::uint32_t i = 0U; i < geometryDataCount; ++i) {
+			const std::uint32_t instanceCount{ static_cast<std::uint32_t>(generator() % 50U) };
+			scene.mInstanceCounts.push_back(instanceCount);
+			for (std::uint32_t j = 0U; j < instanceCount; ++j) {
+				scene.mVisibilityFlags.push_back(distribution(generator) < visibleRatio ? 1U : 0U);
+				scene.mLodIndices.push_back(static_cast<std::uint8_t>(generator() % sMaxMeshLodCount));
+			}
+		}
+
+		return scene;
+	}
+
+	// Index of the geometry data of each instance
+	std::vector<std::uint32_t> GetGeometryDataIndices(const Scene& scene) {
+		std::vector<std::uint32_t> geometryDataIndices;
+		for (std::uint32_t i = 0U; i < scene.mInstanceCounts.size(); ++i) {
+			geometryDataIndices.insert(geometryDataIndices.end(), scene.mInstanceCounts[i], i);
+		}
+
+		return geometryDataIndices;
+	}
+
+	void TestSingleGeometryData() {
+		Scene scene;
+		scene.mInstanceCounts = { 6U };
+		scene.mVisibilityFlags = { 1U, 0U, 1U, 1U, 1U, 0U };
+		scene.mLodIndices = { 2U, 0U, 0U, 2U, 1U, 3U };
+
+		std::vector<std::uint32_t> packedInstanceIndices;
+		std::vector<InstanceBatch> batches{ InstanceBatch{} };
+		CHECK(PackVisibleInstances(scene, packedInstanceIndices, batches) == 4U);
+
+		// A batch per level of detail with visible instances (batches are cleared first)
+		CHECK(batches.size() == 3UL);
+		if (batches.size() == 3UL) {
+			CHECK(batches[0UL].mGeometryDataIndex == 0U && batches[0UL].mLodIndex == 0U);
+			CHECK(batches[0UL].mFirstInstance == 0U && batches[0UL].mInstanceCount == 1U);
+			CHECK(batches[1UL].mGeometryDataIndex == 0U && batches[1UL].mLodIndex == 1U);
+			CHECK(batches[1UL].mFirstInstance == 1U && batches[1UL].mInstanceCount == 1U);
+			CHECK(batches[2UL].mGeometryDataIndex == 0U && batches[2UL].mLodIndex == 2U);
+			CHECK(batches[2UL].mFirstInstance == 2U && batches[2UL].mInstanceCount == 2U);
+		}
+
+		// Culled instances are not packed, and instances of the same level of detail keep their order
+		const std::vector<std::uint32_t> expectedIndices{ 2U, 4U, 0U, 3U };
+		CHECK(std::vector<std::uint32_t>(packedInstanceIndices.begin(), packedInstanceIndices.begin() + 4) == expectedIndices);
+	}
+
+	void TestSeveralGeometryData() {
+		Scene scene;
+		scene.mInstanceCounts = { 3U, 0U, 2U, 4U };
+		scene.mVisibilityFlags = { 1U, 1U, 1U, 0U, 0U, 1U, 1U, 1U, 1U };
+		scene.mLodIndices = { 1U, 0U, 1U, 0U, 0U, 3U, 3U, 0U, 3U };
+
+		std::vector<std::uint32_t> packedInstanceIndices;
+		std::vector<InstanceBatch> batches;
+		CHECK(PackVisibleInstances(scene, packedInstanceIndices, batches) == 7U);
+
+		// Geometry data without instances or without visible ones have no batches
+		const std::vector<InstanceBatch> expectedBatches{
+			{ 0U, 0U, 0U, 1U },
+			{ 0U, 1U, 1U, 2U },
+			{ 3U, 0U, 3U, 1U },
+			{ 3U, 3U, 4U, 3U },
+		};
+		CHECK(batches.size() == expectedBatches.size());
+		for (std::size_t i = 0UL; i < batches.size() && i < expectedBatches.size(); ++i) {
+			CHECK(batches[i].mGeometryDataIndex == expectedBatches[i].mGeometryDataIndex);
+			CHECK(batches[i].mLodIndex == expectedBatches[i].mLodIndex);
+			CHECK(batches[i].mFirstInstance == expectedBatches[i].mFirstInstance);
+			CHECK(batches[i].mInstanceCount == expectedBatches[i].mInstanceCount);
+		}
+
+		const std::vector<std::uint32_t> expectedIndices{ 1U, 0U, 2U, 7U, 5U, 6U, 8U };
+		CHECK(std::vector<std::uint32_t>(packedInstanceIndices.begin(), packedInstanceIndices.begin() + 7) == expectedIndices);
+	}
+
+	void TestAllCulledHasNoBatches() {
+		Scene scene{ CreateRandomScene(20U, 0.0f, 1U) };
+		std::vector<std::uint32_t> packedInstanceIndices;
+		std::vector<InstanceBatch> batches{ InstanceBatch{} };
+		CHECK(PackVisibleInstances(scene, packedInstanceIndices, batches) == 0U);
+		CHECK(batches.empty());
+
+		// Nothing is written to the packed instances
+		bool isUnchanged{ true };
+		for (const std::uint32_t instanceIndex : packedInstanceIndices) {
+			isUnchanged &= instanceIndex == 0xFFFFFFFFU;
+		}
+		CHECK(isUnchanged);
+	}
+
+	// Batches are sorted by geometry data and level of detail, they are contiguous, and each one
+	// has the visible instances of its geometry data and level of detail in their original order
+	void TestRandomScenes() {
+		for (std::uint32_t seed = 0U; seed < 20U; ++seed) {
+			const Scene scene{ CreateRandomScene(1U + seed * 5U, 0.1f + 0.04f * seed, seed) };
+			const std::vector<std::uint32_t> geometryDataIndices{ GetGeometryDataIndices(scene) };
+			std::vector<std::uint32_t> packedInstanceIndices;
+			std::vector<InstanceBatch> batches;
+			const std::uint32_t packedInstanceCount{ PackVisibleInstances(scene, packedInstanceIndices, batches) };
+
+			std::uint32_t visibleInstanceCount{ 0U };
+			for (const std::uint8_t visibilityFlag : scene.mVisibilityFlags) {
+				visibleInstanceCount += visibilityFlag != 0U ? 1U : 0U;
+			}
+			CHECK(packedInstanceCount == visibleInstanceCount);
+
+			bool areBatchesValid{ true };
+			std::uint32_t nextFirstInstance{ 0U };
+			for (std::size_t i = 0UL; i < batches.size(); ++i) {
+				const InstanceBatch& batch = batches[i];
+				areBatchesValid &= batch.mFirstInstance == nextFirstInstance && batch.mInstanceCount > 0U;
+				if (i > 0UL) {
+					const InstanceBatch& previousBatch = batches[i - 1UL];
+					areBatchesValid &=
+						previousBatch.mGeometryDataIndex < batch.mGeometryDataIndex ||
+						(previousBatch.mGeometryDataIndex == batch.mGeometryDataIndex && previousBatch.mLodIndex < batch.mLodIndex);
+				}
+				nextFirstInstance += batch.mInstanceCount;
+
+				std::vector<std::uint32_t> expectedIndices;
+				for (std::uint32_t j = 0U; j < scene.mVisibilityFlags.size(); ++j) {
+					if (scene.mVisibilityFlags[j] != 0U &&
+						scene.mLodIndices[j] == batch.mLodIndex &&
+						geometryDataIndices[j] == batch.mGeometryDataIndex) {
+						expectedIndices.push_back(j);
+					}
+				}
+				areBatchesValid &= std::vector<std::uint32_t>(
+					packedInstanceIndices.begin() + batch.mFirstInstance,
+					packedInstanceIndices.begin() + batch.mFirstInstance + batch.mInstanceCount) == expectedIndices;
+			}
+			CHECK(areBatchesValid);
+			CHECK(nextFirstInstance == packedInstanceCount);
+		}
+	}
+}
+
+int main() {
+	RUN_TEST(TestSingleGeometryData);
+	RUN_TEST(TestSeveralGeometryData);
+	RUN_TEST(TestAllCulledHasNoBatches);
+	RUN_TEST(TestRandomScenes);
+
+	return static_cast<int>(TestUtils::GetFailureCount());
+}
@@ -0,0 +1,134 @@
+#include <cstdint>
+#include <vector>
+
+#include <MeshTestUtils.h>
+#include <ModelManager/MeshOptimizer.h>
+#include <TestUtils.h>
+
+namespace {
+	// Every index must be at most the number of vertices referenced before it,
+	// and all the vertices must be referenced
+	bool IsInFetchOrder(const GeometryGenerator::MeshData& meshData) {
+		std::uint32_t nextVertexIndex{ 0U };
+		for (const std::uint32_t index : meshData.mIndices32) {
+			if (index > nextVertexIndex) {
+				return false;
+			}
+			if (index == nextVertexIndex) {
+				++nextVertexIndex;
+			}
+		}
+
+		return nextVertexIndex == meshData.mVertices.size();
+	}
+
+	void TestAnalyzeVertexCache() {
+		// Without shared vertices every vertex is transformed once per triangle
+		const std::vector<std::uint32_t> indices{ 0U, 1U, 2U, 3U, 4U, 5U };
+		MeshOptimizer::VertexCacheStatistics statistics{ 
+			MeshOptimizer::AnalyzeVertexCache(indices.data(), indices.size(), 6UL) };
+		CHECK(statistics.mTransformedVertexCount == 6U);
+		CHECK(statistics.mAcmr == 3.0f);
+		CHECK(statistics.mAtvr == 1.0f);
+
+		// A quad shares 2 vertices
+		const std::vector<std::uint32_t> quadIndices{ 0U, 1U, 2U, 2U, 1U, 3U };
+		statistics = MeshOptimizer::AnalyzeVertexCache(quadIndices.data(), quadIndices.size(), 4UL);
+		CHECK(statistics.mTransformedVertexCount == 4U);
+		CHECK(statistics.mAcmr == 2.0f);
+
+		// A cache of 3 vertices misses the first vertex again
+		const std::vector<std::uint32_t> fanIndices{ 0U, 1U, 2U, 3U, 4U, 0U };
+		statistics = MeshOptimizer::AnalyzeVertexCache(fanIndices.data(), fanIndices.size(), 5UL, 3U);
+		CHECK(statistics.mTransformedVertexCount == 6U);
+	}
+
+	void TestOptimizeVertexCacheOfShuffledGrid() {
+		GeometryGenerator::MeshData meshData;
+		MeshTestUtils::CreateGrid(64U, 64U, meshData);
+		MeshTestUtils::ShuffleTriangles(meshData.mIndices32, 3U);
+		const std::vector<MeshTestUtils::TrianglePositions> triangles{
+			MeshTestUtils::GetSortedTrianglePositions(meshData.mIndices32, meshData.mVertices) };
+		const MeshOptimizer::VertexCacheStatistics statisticsBefore{
+			MeshOptimizer::AnalyzeVertexCache(meshData.mIndices32.data(), meshData.mIndices32.size(), meshData.mVertices.size()) };
+
+		std::vector<std::uint32_t> optimizedIndices(meshData.mIndices32.size());
+		std::vector<std::size_t> clusterOffsets;
+		MeshOptimizer::OptimizeVertexCache(
+			meshData.mIndices32.data(),
+			meshData.mIndices32.size(),
+			meshData.mVertices.size(),
+			optimizedIndices.data(),
+			&clusterOffsets);
+		const MeshOptimizer::VertexCacheStatistics statisticsAfter{
+			MeshOptimizer::AnalyzeVertexCache(optimizedIndices.data(), optimizedIndices.size(), meshData.mVertices.size()) };
+
+		// A grid has about 2 triangles per vertex, so the best ACMR is about 0.5
+		CHECK(statisticsBefore.mAcmr > 2.0f);
+		CHECK(statisticsAfter.mAcmr < 0.8f);
+		CHECK(MeshTestUtils::GetSortedTrianglePositions(optimizedIndices, meshData.mVertices) == triangles);
+
+		CHECK(clusterOffsets.empty() == false);
+		CHECK(clusterOffsets[0UL] == 0UL);
+		for (std::size_t i = 1UL; i < clusterOffsets.size(); ++i) {
+			CHECK(clusterOffsets[i - 1UL] < clusterOffsets[i]);
+			CHECK(clusterOffsets[i] % 3UL == 0UL);
+			CHECK(clusterOffsets[i] < optimizedIndices.size());
+		}
+	}
+
+	void TestOptimizeVertexFetch() {
+		// Vertex 1 is not used, and vertices are used in reverse order
+		GeometryGenerator::MeshData meshData;
+		meshData.mVertices.resize(5UL);
+		for (std::size_t i = 0UL; i < meshData.mVertices.size(); ++i) {
+			meshData.mVertices[i].mPosition.x = static_cast<float>(i);
+		}
+		meshData.mIndices32 = { 4U, 3U, 2U, 2U, 3U, 0U };
+
+		MeshOptimizer::OptimizeVertexFetch(meshData);
+		CHECK(meshData.mVertices.size() == 4UL);
+		CHECK(IsInFetchOrder(meshData));
+		CHECK(meshData.mIndices32 == std::vector<std::uint32_t>({ 0U, 1U, 2U, 2U, 1U, 3U }));
+		CHECK(meshData.mVertices[0UL].mPosition.x == 4.0f);
+		CHECK(meshData.mVertices[3UL].mPosition.x == 0.0f);
+	}
+
+	// The optimized models keep their triangles, are in fetch order and their
+	// ACMR is not worse than the order of the file (or a shuffled order)
+	void TestOptimizeModels() {
+		const std::vector<std::string> modelFilePaths{ MeshTestUtils::GetModelFilePaths() };
+		CHECK(modelFilePaths.empty() == false);
+		for (const std::string& modelFilePath : modelFilePaths) {
+			for (std::uint32_t isShuffled = 0U; isShuffled < 2U; ++isShuffled) {
+				GeometryGenerator::MeshData meshData;
+				CHECK(MeshTestUtils::ReadObjFile(modelFilePath, meshData));
+				if (isShuffled != 0U) {
+					MeshTestUtils::ShuffleTriangles(meshData.mIndices32, 5U);
+				}
+
+				const std::vector<MeshTestUtils::TrianglePositions> triangles{
+					MeshTestUtils::GetSortedTrianglePositions(meshData.mIndices32, meshData.mVertices) };
+				const MeshOptimizer::VertexCacheStatistics statisticsBefore{
+					MeshOptimizer::AnalyzeVertexCache(meshData.mIndices32.data(), meshData.mIndices32.size(), meshData.mVertices.size()) };
+
+				MeshOptimizer::OptimizeMesh(meshData);
+				const MeshOptimizer::VertexCacheStatistics statisticsAfter{
+					MeshOptimizer::AnalyzeVertexCache(meshData.mIndices32.data(), meshData.mIndices32.size(), meshData.mVertices.size()) };
+
+				CHECK(MeshTestUtils::GetSortedTrianglePositions(meshData.mIndices32, meshData.mVertices) == triangles);
+				CHECK(IsInFetchOrder(meshData));
+				CHECK(statisticsAfter.mAcmr <= statisticsBefore.mAcmr * MeshOptimizer::sOverdrawThreshold);
+			}
+		}
+	}
+}
+
+int main() {
+	RUN_TEST(TestAnalyzeVertexCache);
+	RUN_TEST(TestOptimizeVertexCacheOfShuffledGrid);
+	RUN_TEST(TestOptimizeVertexFetch);
+	RUN_TEST(TestOptimizeModels);
+
+	return static_cast<int>(TestUtils::GetFailureCount());
+}
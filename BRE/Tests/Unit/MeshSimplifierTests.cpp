@@ -0,0 +1,163 @@
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include <GeometryPass/LodSelector.h>
+#include <MeshTestUtils.h>
+#include <ModelManager/MeshOptimizer.h>
+#include <ModelManager/MeshSimplifier.h>
+#include <TestUtils.h>
+
+namespace {
+	bool HasDegenerateTriangles(const std::uint32_t* indices, const std::size_t indexCount) {
+		for (std::size_t i = 0UL; i + 2UL < indexCount; i += 3UL) {
+			if (indices[i] == indices[i + 1UL] || indices[i + 1UL] == indices[i + 2UL] || indices[i] == indices[i + 2UL]) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	// A flat grid can be simplified without error until only its border vertices remain.
+	// Border vertices are never collapsed, and triangles must not flip.
+	void TestSimplifyFlatGrid() {
+		const std::uint32_t cellCount{ 40U };
+		GeometryGenerator::MeshData meshData;
+		MeshTestUtils::CreateGrid(cellCount, cellCount, meshData);
+
+		std::vector<std::uint32_t> simplifiedIndices;
+		const float error{
+			MeshSimplifier::Simplify(
+				meshData.mIndices32.data(),
+				meshData.mIndices32.size(),
+				meshData.mVertices.data(),
+				meshData.mVertices.size(),
+				0UL,
+				0.001f,
+				simplifiedIndices) };
+		CHECK(error <= 0.001f);
+		CHECK(simplifiedIndices.size() % 3UL == 0UL);
+		CHECK(simplifiedIndices.size() / 3UL <= 4UL * cellCount * 2UL);
+		CHECK(HasDegenerateTriangles(simplifiedIndices.data(), simplifiedIndices.size()) == false);
+
+		for (std::size_t i = 0UL; i < simplifiedIndices.size(); i += 3UL) {
+			const DirectX::XMFLOAT3& position0{ meshData.mVertices[simplifiedIndices[i]].mPosition };
+			const DirectX::XMFLOAT3& position1{ meshData.mVertices[simplifiedIndices[i + 1UL]].mPosition };
+			const DirectX::XMFLOAT3& position2{ meshData.mVertices[simplifiedIndices[i + 2UL]].mPosition };
+			const float normalY{
+				(position1.z - position0.z) * (position2.x - position0.x) -
+				(position1.x - position0.x) * (position2.z - position0.z) };
+			CHECK(normalY > 0.0f);
+		}
+
+		// Border vertices are kept
+		std::vector<std::uint8_t> isUsed(meshData.mVertices.size(), 0U);
+		for (const std::uint32_t index : simplifiedIndices) {
+			isUsed[index] = 1U;
+		}
+		CHECK(isUsed[0U] != 0U);
+		CHECK(isUsed[cellCount] != 0U);
+		CHECK(isUsed[cellCount * (cellCount + 1U)] != 0U);
+		CHECK(isUsed[meshData.mVertices.size() - 1UL] != 0U);
+	}
+
+	// Without allowed error, a curved mesh cannot be simplified
+	void TestSimplifyRespectsMaxError() {
+		const std::vector<std::string> modelFilePaths{ MeshTestUtils::GetModelFilePaths() };
+		for (const std::string& modelFilePath : modelFilePaths) {
+			if (modelFilePath.find("torusKnot") == std::string::npos) {
+				continue;
+			}
+
+			GeometryGenerator::MeshData meshData;
+			CHECK(MeshTestUtils::ReadObjFile(modelFilePath, meshData));
+			std::vector<std::uint32_t> simplifiedIndices;
+			const float error{
+				MeshSimplifier::Simplify(
+					meshData.mIndices32.data(),
+					meshData.mIndices32.size(),
+					meshData.mVertices.data(),
+					meshData.mVertices.size(),
+					0UL,
+					0.0f,
+					simplifiedIndices) };
+			CHECK(error == 0.0f);
+			CHECK(simplifiedIndices.size() >= meshData.mIndices32.size() * 9UL / 10UL);
+		}
+	}
+
+	void TestGenerateLodsOfModels() {
+		const std::vector<std::string> modelFilePaths{ MeshTestUtils::GetModelFilePaths() };
+		CHECK(modelFilePaths.empty() == false);
+		for (const std::string& modelFilePath : modelFilePaths) {
+			GeometryGenerator::MeshData meshData;
+			CHECK(MeshTestUtils::ReadObjFile(modelFilePath, meshData));
+			MeshOptimizer::OptimizeMesh(meshData);
+			const std::size_t indexCount{ meshData.mIndices32.size() };
+
+			std::vector<MeshLod> lods;
+			MeshSimplifier::GenerateLods(meshData, lods);
+			CHECK(lods.empty() == false);
+			CHECK(lods.size() <= sMaxMeshLodCount);
+			CHECK(lods[0UL].mFirstIndex == 0U);
+			CHECK(lods[0UL].mIndexCount == indexCount);
+			CHECK(lods[0UL].mError == 0.0f);
+			CHECK(lods.back().mFirstIndex + lods.back().mIndexCount == meshData.mIndices32.size());
+
+			for (std::size_t i = 0UL; i < lods.size(); ++i) {
+				const MeshLod& lod{ lods[i] };
+				CHECK(lod.mIndexCount % 3U == 0U);
+				CHECK(HasDegenerateTriangles(meshData.mIndices32.data() + lod.mFirstIndex, lod.mIndexCount) == false);
+				if (i > 0UL) {
+					CHECK(lod.mFirstIndex == lods[i - 1UL].mFirstIndex + lods[i - 1UL].mIndexCount);
+					CHECK(lod.mIndexCount < lods[i - 1UL].mIndexCount);
+					CHECK(lod.mError >= lods[i - 1UL].mError);
+					CHECK(lod.mError <= MeshSimplifier::sMaxLodError);
+					CHECK(lod.mIndexCount >= MeshSimplifier::sMinLodIndexCount);
+				}
+			}
+		}
+	}
+
+	void TestProjectedSphereRadius() {
+		// 90 degrees vertical field of view
+		const float projectionScaleY{ 1.0f / std::tan(0.7853982f) };
+		const DirectX::XMFLOAT3 eyePosition{ 0.0f, 0.0f, 0.0f };
+
+		// The eye is inside the sphere
+		CHECK(LodSelector::ComputeProjectedSphereRadius({ 0.0f, 0.0f, 0.5f }, 1.0f, eyePosition, projectionScaleY, 1080.0f) == FLT_MAX);
+
+		// It decreases with the distance, about 1 / distance when it is far
+		const float radius10{ LodSelector::ComputeProjectedSphereRadius({ 0.0f, 0.0f, 10.0f }, 1.0f, eyePosition, projectionScaleY, 1080.0f) };
+		const float radius100{ LodSelector::ComputeProjectedSphereRadius({ 0.0f, 0.0f, 100.0f }, 1.0f, eyePosition, projectionScaleY, 1080.0f) };
+		CHECK(radius10 > radius100);
+		CHECK(std::fabs(radius10 / radius100 - 10.0f) < 0.1f);
+		CHECK(std::fabs(radius100 - 5.4f) < 0.01f);
+	}
+
+	void TestSelectLod() {
+		MeshLod lods[3U];
+		lods[1U].mError = 0.01f;
+		lods[2U].mError = 0.1f;
+
+		// Screen space error is the relative error multiplied by the projected radius
+		CHECK(LodSelector::SelectLod(lods, 3U, 1000.0f) == 0U);
+		CHECK(LodSelector::SelectLod(lods, 3U, 100.0f) == 1U);
+		CHECK(LodSelector::SelectLod(lods, 3U, 10.0f) == 2U);
+		CHECK(LodSelector::SelectLod(lods, 3U, FLT_MAX) == 0U);
+		CHECK(LodSelector::SelectLod(lods, 1U, 1.0f) == 0U);
+		CHECK(LodSelector::SelectLod(lods, 3U, 100.0f, 0.5f) == 0U);
+	}
+}
+
+int main() {
+	RUN_TEST(TestSimplifyFlatGrid);
+	RUN_TEST(TestSimplifyRespectsMaxError);
+	RUN_TEST(TestGenerateLodsOfModels);
+	RUN_TEST(TestProjectedSphereRadius);
+	RUN_TEST(TestSelectLod);
+
+	return static_cast<int>(TestUtils::GetFailureCount());
+}
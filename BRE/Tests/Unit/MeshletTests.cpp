@@ -0,0 +1,332 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <GeometryPass/MeshletCuller.h>
+#include <MeshTestUtils.h>
+#include <ModelManager/MeshletBuilder.h>
+#include <ModelManager/MeshOptimizer.h>
+#include <TestUtils.h>
+
+using namespace DirectX;
+
+namespace {
+	using Triangle = std::array<std::uint32_t, 3U>;
+
+	// Triangles with their vertices rotated to start with the smallest index, so
+	// the same triangles in a different order are equal
+	std::multiset<Triangle> GetTriangles(const std::vector<std::uint32_t>& indices) {
+		std::multiset<Triangle> triangles;
+		for (std::size_t i = 0UL; i + 2UL < indices.size(); i += 3UL) {
+			Triangle triangle{ indices[i], indices[i + 1UL], indices[i + 2UL] };
+			std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+			triangles.insert(triangle);
+		}
+
+		return triangles;
+	}
+
+	// Meshes with at least MeshletBuilder::sMinTriangleCount triangles: a grid and the models
+	std::vector<GeometryGenerator::MeshData> GetMeshes() {
+		std::vector<GeometryGenerator::MeshData> meshes(1UL);
+		MeshTestUtils::CreateGrid(64U, 64U, meshes.back());
+		for (const std::string& modelFilePath : MeshTestUtils::GetModelFilePaths()) {
+			GeometryGenerator::MeshData meshData;
+			if (MeshTestUtils::ReadObjFile(modelFilePath, meshData) &&
+				meshData.mIndices32.size() / 3UL >= MeshletBuilder::sMinTriangleCount) {
+				meshes.push_back(std::move(meshData));
+			}
+		}
+
+		return meshes;
+	}
+
+	// Planes that do not cull anything, to test back face culling alone
+	void GetInfinitePlanes(XMFLOAT4* frustumPlanes) {
+		for (std::uint32_t i = 0U; i < 6U; ++i) {
+			frustumPlanes[i] = XMFLOAT4(0.0f, 0.0f, 0.0f, 1.0f);
+		}
+	}
+
+	void TestSmallMeshHasNoMeshlets() {
+		GeometryGenerator::MeshData meshData;
+		MeshTestUtils::CreateGrid(16U, 16U, meshData);
+		CHECK(meshData.mIndices32.size() / 3UL < MeshletBuilder::sMinTriangleCount);
+		const std::vector<std::uint32_t> indices{ meshData.mIndices32 };
+
+		std::vector<Meshlet> meshlets;
+		MeshletBuilder::BuildMeshlets(meshData, meshData.mIndices32.size(), meshlets);
+		CHECK(meshlets.empty());
+		CHECK(meshData.mIndices32 == indices);
+	}
+
+	// Meshlets are contiguous, they cover all the triangles (which are only reordered),
+	// they respect the limits and their spheres contain their vertices
+	void TestMeshletsPartitionTheMesh() {
+		for (GeometryGenerator::MeshData& meshData : GetMeshes()) {
+			const std::multiset<Triangle> trianglesBefore{ GetTriangles(meshData.mIndices32) };
+			std::vector<Meshlet> meshlets;
+			MeshletBuilder::BuildMeshlets(meshData, meshData.mIndices32.size(), meshlets);
+			CHECK(meshlets.empty() == false);
+			CHECK(GetTriangles(meshData.mIndices32) == trianglesBefore);
+
+			std::uint32_t nextFirstIndex{ 0U };
+			for (const Meshlet& meshlet : meshlets) {
+				CHECK(meshlet.mFirstIndex == nextFirstIndex);
+				CHECK(meshlet.mIndexCount % 3U == 0U && meshlet.mIndexCount > 0U);
+				CHECK(meshlet.mIndexCount / 3U <= sMaxMeshletTriangleCount);
+				nextFirstIndex += meshlet.mIndexCount;
+
+				const std::set<std::uint32_t> vertices(
+					meshData.mIndices32.begin() + meshlet.mFirstIndex,
+					meshData.mIndices32.begin() + meshlet.mFirstIndex + meshlet.mIndexCount);
+				CHECK(vertices.size() <= sMaxMeshletVertexCount);
+
+				bool isInsideSphere{ true };
+				for (const std::uint32_t vertex : vertices) {
+					const XMFLOAT3& position{ meshData.mVertices[vertex].mPosition };
+					const float x{ position.x - meshlet.mBoundingSphereCenter.x };
+					const float y{ position.y - meshlet.mBoundingSphereCenter.y };
+					const float z{ position.z - meshlet.mBoundingSphereCenter.z };
+					isInsideSphere &= std::sqrt(x * x + y * y + z * z) <= meshlet.mBoundingSphereRadius * 1.0001f + 1.0e-6f;
+				}
+				CHECK(isInsideSphere);
+			}
+			CHECK(nextFirstIndex == meshData.mIndices32.size());
+		}
+	}
+
+	// Meshlets of optimized meshes are optimized for the vertex cache again: each meshlet keeps its
+	// triangles, and the ACMR of the meshes is not worse than the one of the meshlets order
+	void TestMeshletVertexCacheOptimization() {
+		for (GeometryGenerator::MeshData& meshData : GetMeshes()) {
+			MeshOptimizer::OptimizeMesh(meshData);
+			std::vector<Meshlet> meshlets;
+			MeshletBuilder::BuildMeshlets(meshData, meshData.mIndices32.size(), meshlets);
+			const std::vector<std::uint32_t> meshletIndices{ meshData.mIndices32 };
+			const float meshletAcmr{
+				MeshOptimizer::AnalyzeVertexCache(meshData.mIndices32.data(), meshData.mIndices32.size(), meshData.mVertices.size()).mAcmr };
+
+			MeshOptimizer::OptimizeMeshletVertexCache(meshData.mIndices32.data(), meshData.mVertices.size(), meshlets.data(), meshlets.size());
+			const float optimizedAcmr{
+				MeshOptimizer::AnalyzeVertexCache(meshData.mIndices32.data(), meshData.mIndices32.size(), meshData.mVertices.size()).mAcmr };
+			CHECK(optimizedAcmr <= meshletAcmr);
+
+			bool areMeshletsKept{ true };
+			for (const Meshlet& meshlet : meshlets) {
+				const auto getMeshletTriangles = [&meshlet](const std::vector<std::uint32_t>& indices) {
+					return GetTriangles(std::vector<std::uint32_t>(
+						indices.begin() + meshlet.mFirstIndex, 
+						indices.begin() + meshlet.mFirstIndex + meshlet.mIndexCount));
+				};
+				areMeshletsKept &= getMeshletTriangles(meshData.mIndices32) == getMeshletTriangles(meshletIndices);
+			}
+			CHECK(areMeshletsKept);
+		}
+	}
+
+	// A meshlet is only culled if all its vertices are behind a frustum plane,
+	// or all its triangles are back facing
+	void TestCullingIsConservative() {
+		std::mt19937 generator(7U);
+		std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+		for (GeometryGenerator::MeshData& meshData : GetMeshes()) {
+			std::vector<Meshlet> meshlets;
+			MeshletBuilder::BuildMeshlets(meshData, meshData.mIndices32.size(), meshlets);
+			MeshletCuller::MeshletBounds meshletBounds;
+			MeshletCuller::InitMeshletBounds(meshlets.data(), meshlets.size(), meshletBounds);
+
+			float extent{ 0.0f };
+			for (const GeometryGenerator::Vertex& vertex : meshData.mVertices) {
+				extent = std::max<float>(extent, std::abs(vertex.mPosition.x));
+				extent = std::max<float>(extent, std::abs(vertex.mPosition.y));
+				extent = std::max<float>(extent, std::abs(vertex.mPosition.z));
+			}
+
+			std::vector<std::uint8_t> visibilityFlags(meshlets.size());
+			std::uint32_t wronglyCulledMeshletCount{ 0U };
+			std::uint32_t culledMeshletCount{ 0U };
+			for (std::uint32_t i = 0U; i < 50U; ++i) {
+				const XMFLOAT3 eyePosition(
+					distribution(generator) * extent * 3.0f,
+					distribution(generator) * extent * 3.0f,
+					distribution(generator) * extent * 3.0f);
+
+				// A box around a random point, or no frustum at all
+				const XMFLOAT3 center(
+					distribution(generator) * extent,
+					distribution(generator) * extent,
+					distribution(generator) * extent);
+				const float halfSize{ extent * 0.6f };
+				XMFLOAT4 frustumPlanes[6U]{
+					XMFLOAT4(1.0f, 0.0f, 0.0f, halfSize - center.x),
+					XMFLOAT4(-1.0f, 0.0f, 0.0f, halfSize + center.x),
+					XMFLOAT4(0.0f, 1.0f, 0.0f, halfSize - center.y),
+					XMFLOAT4(0.0f, -1.0f, 0.0f, halfSize + center.y),
+					XMFLOAT4(0.0f, 0.0f, 1.0f, halfSize - center.z),
+					XMFLOAT4(0.0f, 0.0f, -1.0f, halfSize + center.z) };
+				if (i % 2U == 1U) {
+					GetInfinitePlanes(frustumPlanes);
+				}
+
+				const std::uint32_t visibleMeshletCount{
+					MeshletCuller::CullMeshlets(meshletBounds, frustumPlanes, eyePosition, visibilityFlags.data()) };
+				CHECK(visibleMeshletCount == static_cast<std::uint32_t>(
+					std::count(visibilityFlags.begin(), visibilityFlags.end(), static_cast<std::uint8_t>(1U))));
+
+				for (std::size_t j = 0UL; j < meshlets.size(); ++j) {
+					if (visibilityFlags[j] != 0U) {
+						continue;
+					}
+					++culledMeshletCount;
+
+					const Meshlet& meshlet = meshlets[j];
+					const std::uint32_t* indices{ meshData.mIndices32.data() + meshlet.mFirstIndex };
+					bool isOutside{ false };
+					for (const XMFLOAT4& plane : frustumPlanes) {
+						bool isBehindPlane{ true };
+						for (std::uint32_t k = 0U; k < meshlet.mIndexCount; ++k) {
+							const XMFLOAT3& position{ meshData.mVertices[indices[k]].mPosition };
+							isBehindPlane &= plane.x * position.x + plane.y * position.y + plane.z * position.z + plane.w < 0.0f;
+						}
+						isOutside |= isBehindPlane;
+					}
+
+					bool isBackFacing{ true };
+					for (std::uint32_t k = 0U; k < meshlet.mIndexCount; k += 3U) {
+						const XMFLOAT3& position0{ meshData.mVertices[indices[k]].mPosition };
+						const XMFLOAT3& position1{ meshData.mVertices[indices[k + 1U]].mPosition };
+						const XMFLOAT3& position2{ meshData.mVertices[indices[k + 2U]].mPosition };
+						const XMVECTOR edge1 = XMVectorSubtract(XMLoadFloat3(&position1), XMLoadFloat3(&position0));
+						const XMVECTOR edge2 = XMVectorSubtract(XMLoadFloat3(&position2), XMLoadFloat3(&position0));
+						const XMVECTOR toEye = XMVectorSubtract(XMLoadFloat3(&eyePosition), XMLoadFloat3(&position0));
+						isBackFacing &= XMVectorGetX(XMVector3Dot(XMVector3Cross(edge1, edge2), toEye)) <= 0.0f;
+					}
+
+					if (isOutside == false && isBackFacing == false) {
+						++wronglyCulledMeshletCount;
+					}
+				}
+			}
+			CHECK(wronglyCulledMeshletCount == 0U);
+			CHECK(culledMeshletCount > 0U);
+		}
+	}
+
+	// The grid faces +Y, so all its meshlets are back facing from below and none is from above.
+	// The back face test is conservative by the meshlet radius, so the eye is far from the grid.
+	void TestBackFacingGridIsCulled() {
+		GeometryGenerator::MeshData meshData;
+		MeshTestUtils::CreateGrid(64U, 64U, meshData);
+		std::vector<Meshlet> meshlets;
+		MeshletBuilder::BuildMeshlets(meshData, meshData.mIndices32.size(), meshlets);
+		MeshletCuller::MeshletBounds meshletBounds;
+		MeshletCuller::InitMeshletBounds(meshlets.data(), meshlets.size(), meshletBounds);
+
+		XMFLOAT4 frustumPlanes[6U];
+		GetInfinitePlanes(frustumPlanes);
+		std::vector<std::uint8_t> visibilityFlags(meshlets.size());
+		const XMFLOAT3 eyeBelow(32.0f, -100.0f, 32.0f);
+		const XMFLOAT3 eyeAbove(32.0f, 100.0f, 32.0f);
+		CHECK(MeshletCuller::CullMeshlets(meshletBounds, frustumPlanes, eyeBelow, visibilityFlags.data()) == 0U);
+		CHECK(MeshletCuller::CullMeshlets(meshletBounds, frustumPlanes, eyeAbove, visibilityFlags.data()) == meshlets.size());
+	}
+
+	void TestAppendIndexRanges() {
+		std::vector<Meshlet> meshlets(5U);
+		for (std::uint32_t i = 0U; i < 5U; ++i) {
+			meshlets[i].mFirstIndex = i * 30U;
+			meshlets[i].mIndexCount = 30U;
+		}
+		MeshletCuller::MeshletBounds meshletBounds;
+		MeshletCuller::InitMeshletBounds(meshlets.data(), meshlets.size(), meshletBounds);
+
+		// Contiguous visible meshlets are merged
+		const std::uint8_t visibilityFlags[5U]{ 1U, 1U, 0U, 1U, 1U };
+		std::vector<MeshletCuller::IndexRange> indexRanges(1U);
+		CHECK(MeshletCuller::AppendIndexRanges(meshletBounds, visibilityFlags, indexRanges) == 2U);
+		CHECK(indexRanges.size() == 3U);
+		CHECK(indexRanges[1U].mFirstIndex == 0U && indexRanges[1U].mIndexCount == 60U);
+		CHECK(indexRanges[2U].mFirstIndex == 90U && indexRanges[2U].mIndexCount == 60U);
+
+		const std::uint8_t noVisibilityFlags[5U]{ 0U, 0U, 0U, 0U, 0U };
+		CHECK(MeshletCuller::AppendIndexRanges(meshletBounds, noVisibilityFlags, indexRanges) == 0U);
+		CHECK(indexRanges.size() == 3U);
+	}
+
+	void TestMergeIndexRanges() {
+		// Ranges before "firstRange" are not touched. The rest are sorted, and
+		// overlapping and contiguous ranges are merged
+		std::vector<MeshletCuller::IndexRange> indexRanges{
+			{ 1000U, 3U },
+			{ 90U, 30U },
+			{ 0U, 30U },
+			{ 300U, 30U },
+			{ 30U, 60U },
+			{ 0U, 60U },
+			{ 330U, 3U } };
+		CHECK(MeshletCuller::MergeIndexRanges(1UL, indexRanges) == 2U);
+		CHECK(indexRanges.size() == 3U);
+		CHECK(indexRanges[0U].mFirstIndex == 1000U && indexRanges[0U].mIndexCount == 3U);
+		CHECK(indexRanges[1U].mFirstIndex == 0U && indexRanges[1U].mIndexCount == 120U);
+		CHECK(indexRanges[2U].mFirstIndex == 300U && indexRanges[2U].mIndexCount == 33U);
+
+		// A range inside another one
+		indexRanges = { { 0U, 300U }, { 30U, 30U }, { 600U, 30U } };
+		CHECK(MeshletCuller::MergeIndexRanges(0UL, indexRanges) == 2U);
+		CHECK(indexRanges[0U].mFirstIndex == 0U && indexRanges[0U].mIndexCount == 300U);
+		CHECK(indexRanges[1U].mFirstIndex == 600U && indexRanges[1U].mIndexCount == 30U);
+
+		indexRanges.clear();
+		CHECK(MeshletCuller::MergeIndexRanges(0UL, indexRanges) == 0U);
+		CHECK(indexRanges.empty());
+	}
+
+	// The union of the visible meshlets of several instances covers the ones of each instance
+	void TestMergedRangesCoverEveryInstance() {
+		GeometryGenerator::MeshData meshData{ GetMeshes().back() };
+		std::vector<Meshlet> meshlets;
+		MeshletBuilder::BuildMeshlets(meshData, meshData.mIndices32.size(), meshlets);
+		MeshletCuller::MeshletBounds meshletBounds;
+		MeshletCuller::InitMeshletBounds(meshlets.data(), meshlets.size(), meshletBounds);
+
+		std::mt19937 generator(11U);
+		std::vector<std::uint8_t> isVisibleInAnyInstance(meshlets.size(), 0U);
+		std::vector<std::uint8_t> visibilityFlags(meshlets.size());
+		std::vector<MeshletCuller::IndexRange> indexRanges;
+		for (std::uint32_t i = 0U; i < 8U; ++i) {
+			for (std::size_t j = 0UL; j < meshlets.size(); ++j) {
+				visibilityFlags[j] = static_cast<std::uint8_t>(generator() % 4U == 0U ? 1U : 0U);
+				isVisibleInAnyInstance[j] |= visibilityFlags[j];
+			}
+			MeshletCuller::AppendIndexRanges(meshletBounds, visibilityFlags.data(), indexRanges);
+		}
+
+		MeshletCuller::MergeIndexRanges(0UL, indexRanges);
+		std::vector<MeshletCuller::IndexRange> expectedIndexRanges;
+		MeshletCuller::AppendIndexRanges(meshletBounds, isVisibleInAnyInstance.data(), expectedIndexRanges);
+		CHECK(indexRanges.size() == expectedIndexRanges.size());
+		for (std::size_t i = 0UL; i < std::min<std::size_t>(indexRanges.size(), expectedIndexRanges.size()); ++i) {
+			CHECK(indexRanges[i].mFirstIndex == expectedIndexRanges[i].mFirstIndex);
+			CHECK(indexRanges[i].mIndexCount == expectedIndexRanges[i].mIndexCount);
+		}
+	}
+}
+
+int main() {
+	RUN_TEST(TestSmallMeshHasNoMeshlets);
+	RUN_TEST(TestMeshletsPartitionTheMesh);
+	RUN_TEST(TestMeshletVertexCacheOptimization);
+	RUN_TEST(TestCullingIsConservative);
+	RUN_TEST(TestBackFacingGridIsCulled);
+	RUN_TEST(TestAppendIndexRanges);
+	RUN_TEST(TestMergeIndexRanges);
+	RUN_TEST(TestMergedRangesCoverEveryInstance);
+
+	return static_cast<int>(TestUtils::GetFailureCount());
+}
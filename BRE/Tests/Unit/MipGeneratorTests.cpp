@@ -0,0 +1,338 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <ResourceManager/BlockCompressor.h>
+#include <ResourceManager/MipGenerator.h>
+#include <TestUtils.h>
+#include <TextureTestUtils.h>
+
+namespace {
+	const double sPi{ 3.14159265358979323846 };
+
+	// Generates "mipCount" mips of "sliceCount" array slices of "sliceSize" bytes, one after the other in "source"
+	std::vector<std::uint8_t> GenerateMips(
+		const std::uint8_t* source,
+		const std::uint32_t sliceCount,
+		const std::size_t sliceSize,
+		const std::uint32_t width,
+		const std::uint32_t height,
+		const DXGI_FORMAT format,
+		const MipGenerator::Filter filter,
+		const std::uint32_t mipCount)
+	{
+		std::vector<const std::uint8_t*> sourceSlices;
+		for (std::uint32_t i = 0U; i < sliceCount; ++i) {
+			sourceSlices.push_back(source + i * sliceSize);
+		}
+
+		std::vector<std::uint8_t> mips(sliceCount * MipGenerator::GetMipsSize(width, height, format, mipCount));
+		MipGenerator::GenerateMips(sourceSlices.data(), sliceCount, width, height, format, filter, mipCount, mips.data());
+
+		return mips;
+	}
+
+	double SRGBToLinear(const double value) {
+		return value <= 0.04045 ? value / 12.92 : std::pow((value + 0.055) / 1.055, 2.4);
+	}
+
+	double LinearToSRGB(const double value) {
+		return value <= 0.0031308 ? value * 12.92 : 1.055 * std::pow(value, 1.0 / 2.4) - 0.055;
+	}
+
+	// Modified Bessel function of the first kind and order zero
+	double BesselI0(const double x) {
+		double sum{ 1.0 };
+		double term{ 1.0 };
+		for (std::uint32_t k = 1U; k < 50U; ++k) {
+			term *= (x * 0.5 / k) * (x * 0.5 / k);
+			sum += term;
+		}
+
+		return sum;
+	}
+
+	// Normalized weights of the source texels of destination texel "index", when "sourceSize" texels are filtered
+	// to "destinationSize" texels. Texels beyond the edges repeat the edge texels.
+	void ComputeReferenceWeights(
+		const MipGenerator::Filter filter,
+		const std::uint32_t sourceSize,
+		const std::uint32_t destinationSize,
+		const std::uint32_t index,
+		std::vector<std::pair<std::uint32_t, double>>& weights)
+	{
+		const double scale{ static_cast<double>(sourceSize) / destinationSize };
+		const double center{ (index + 0.5) * scale };
+		weights.clear();
+		double weightSum{ 0.0 };
+		for (std::int32_t i = -20; i < static_cast<std::int32_t>(sourceSize) + 20; ++i) {
+			double weight{ 0.0 };
+			if (filter == MipGenerator::Filter::BOX) {
+				weight = std::max<double>(0.0, std::min<double>(i + 1.0, center + scale * 0.5) - std::max<double>(i, center - scale * 0.5));
+			} else {
+				// Kaiser windowed sinc, with a radius of 3 destination texels and alpha 4
+				const double x{ (i + 0.5 - center) / scale };
+				if (std::abs(x) < 3.0) {
+					const double sinc{ x == 0.0 ? 1.0 : std::sin(sPi * x) / (sPi * x) };
+					const double t{ x / 3.0 };
+					weight = sinc * BesselI0(4.0 * std::sqrt(1.0 - t * t)) / BesselI0(4.0);
+				}
+			}
+
+			if (weight != 0.0) {
+				const std::int32_t clampedIndex{ std::min<std::int32_t>(std::max<std::int32_t>(i, 0), static_cast<std::int32_t>(sourceSize) - 1) };
+				weights.push_back(std::make_pair(static_cast<std::uint32_t>(clampedIndex), weight));
+				weightSum += weight;
+			}
+		}
+
+		for (std::pair<std::uint32_t, double>& weight : weights) {
+			weight.second /= weightSum;
+		}
+	}
+
+	void TestSizes() {
+		CHECK(MipGenerator::GetFullMipCount(512U, 512U) == 10U);
+		CHECK(MipGenerator::GetFullMipCount(261U, 205U) == 9U);
+		CHECK(MipGenerator::GetFullMipCount(8U, 2U) == 4U);
+		CHECK(MipGenerator::GetFullMipCount(1U, 1U) == 1U);
+
+		CHECK(MipGenerator::GetMipsSize(8U, 2U, DXGI_FORMAT_R8G8B8A8_UNORM, 3U) == (4UL + 2UL + 1UL) * 4UL);
+		CHECK(MipGenerator::GetMipsSize(16U, 16U, DXGI_FORMAT_BC1_UNORM, 4U) == 8UL * (4UL + 1UL + 1UL + 1UL));
+
+		CHECK(MipGenerator::IsFormatSupported(DXGI_FORMAT_R8G8B8A8_UNORM_SRGB));
+		CHECK(MipGenerator::IsFormatSupported(DXGI_FORMAT_BC5_UNORM));
+		CHECK(MipGenerator::IsFormatSupported(DXGI_FORMAT_R16_FLOAT) == false);
+		CHECK(MipGenerator::IsFormatSupported(DXGI_FORMAT_BC7_UNORM) == false);
+	}
+
+	// Constant images stay constant with both filters
+	void TestConstantImages() {
+		const std::uint32_t width{ 37U };
+		const std::uint32_t height{ 23U };
+		std::vector<std::uint8_t> texels(width * height * 4U);
+		for (std::size_t i = 0UL; i < texels.size(); i += 4UL) {
+			texels[i] = 200U;
+			texels[i + 1UL] = 13U;
+			texels[i + 2UL] = 77U;
+			texels[i + 3UL] = 128U;
+		}
+
+		for (const MipGenerator::Filter filter : { MipGenerator::Filter::BOX, MipGenerator::Filter::KAISER }) {
+			for (const DXGI_FORMAT format : { DXGI_FORMAT_R8G8B8A8_UNORM, DXGI_FORMAT_R8G8B8A8_UNORM_SRGB, DXGI_FORMAT_B8G8R8A8_UNORM }) {
+				const std::vector<std::uint8_t> mips{ GenerateMips(
+					texels.data(), 1U, texels.size(), width, height, format, filter, MipGenerator::GetFullMipCount(width, height) - 1U) };
+				bool isConstant{ true };
+				for (std::size_t i = 0UL; i < mips.size(); i += 4UL) {
+					isConstant &= mips[i] == 200U && mips[i + 1UL] == 13U && mips[i + 2UL] == 77U && mips[i + 3UL] == 128U;
+				}
+				CHECK(isConstant);
+			}
+		}
+	}
+
+	// Box filter of 2 x 2 texels are their rounded average
+	void TestBoxFilterAverages() {
+		std::uint8_t texels[16U];
+		for (std::uint32_t i = 0U; i < 16U; ++i) {
+			texels[i] = static_cast<std::uint8_t>(i * 16U);
+		}
+
+		const std::vector<std::uint8_t> mips{ GenerateMips(texels, 1U, sizeof(texels), 4U, 4U, DXGI_FORMAT_R8_UNORM, MipGenerator::Filter::BOX, 2U) };
+		CHECK(mips.size() == 5UL);
+		CHECK(mips[0U] == (0U + 16U + 64U + 80U + 2U) / 4U);
+		CHECK(mips[3U] == (160U + 176U + 224U + 240U + 2U) / 4U);
+		CHECK(mips[4U] == 120U);
+	}
+
+	// A black and white checkerboard is gray: 128 in linear formats, and 188 (linear 0.5) in sRGB formats.
+	// Alpha is never gamma corrected.
+	void TestGammaCorrection() {
+		std::vector<std::uint8_t> texels(8U * 8U * 4U);
+		for (std::uint32_t y = 0U; y < 8U; ++y) {
+			for (std::uint32_t x = 0U; x < 8U; ++x) {
+				const std::uint8_t value{ ((x + y) & 1U) != 0U ? std::uint8_t(255U) : std::uint8_t(0U) };
+				std::uint8_t* texel{ &texels[(y * 8U + x) * 4U] };
+				texel[0U] = value;
+				texel[1U] = value;
+				texel[2U] = value;
+				texel[3U] = value;
+			}
+		}
+
+		const std::vector<std::uint8_t> srgbMips{ GenerateMips(
+			texels.data(), 1U, texels.size(), 8U, 8U, DXGI_FORMAT_R8G8B8A8_UNORM_SRGB, MipGenerator::Filter::BOX, 1U) };
+		const std::vector<std::uint8_t> linearMips{ GenerateMips(
+			texels.data(), 1U, texels.size(), 8U, 8U, DXGI_FORMAT_R8G8B8A8_UNORM, MipGenerator::Filter::BOX, 1U) };
+		CHECK(srgbMips[0U] == 188U && srgbMips[3U] == 128U);
+		CHECK(linearMips[0U] == 128U && linearMips[3U] == 128U);
+
+		// Kaiser filter of a one texel checkerboard is gray too (far from the edges)
+		const std::uint32_t dimension{ 64U };
+		std::vector<std::uint8_t> checkerboard(dimension * dimension);
+		for (std::uint32_t y = 0U; y < dimension; ++y) {
+			for (std::uint32_t x = 0U; x < dimension; ++x) {
+				checkerboard[y * dimension + x] = ((x + y) & 1U) != 0U ? std::uint8_t(255U) : std::uint8_t(0U);
+			}
+		}
+		const std::vector<std::uint8_t> kaiserMips{ GenerateMips(
+			checkerboard.data(), 1U, checkerboard.size(), dimension, dimension, DXGI_FORMAT_R8_UNORM, MipGenerator::Filter::KAISER, 1U) };
+		std::int32_t maxDifference{ 0 };
+		for (std::uint32_t y = 4U; y < dimension / 2U - 4U; ++y) {
+			for (std::uint32_t x = 4U; x < dimension / 2U - 4U; ++x) {
+				maxDifference = std::max<std::int32_t>(maxDifference, std::abs(static_cast<std::int32_t>(kaiserMips[y * dimension / 2U + x]) - 128));
+			}
+		}
+		CHECK(maxDifference <= 1);
+	}
+
+	// sRGB averages of all the pairs of 8 bits values are rounded to the nearest sRGB value
+	void TestSRGBRounding() {
+		const std::uint32_t dimension{ 512U };
+		std::vector<std::uint8_t> texels(dimension * dimension * 4U);
+		for (std::uint32_t y = 0U; y < dimension; ++y) {
+			for (std::uint32_t x = 0U; x < dimension; ++x) {
+				// 2 x 2 blocks are (a, b, a, b), where a and b are the block coordinates
+				const std::uint8_t value{ static_cast<std::uint8_t>((x & 1U) != 0U ? (x / 2U) % 256U : (y / 2U) % 256U) };
+				std::uint8_t* texel{ &texels[(y * dimension + x) * 4U] };
+				texel[0U] = value;
+				texel[1U] = value;
+				texel[2U] = value;
+				texel[3U] = 255U;
+			}
+		}
+
+		const std::vector<std::uint8_t> mips{ GenerateMips(
+			texels.data(), 1U, texels.size(), dimension, dimension, DXGI_FORMAT_R8G8B8A8_UNORM_SRGB, MipGenerator::Filter::BOX, 1U) };
+		std::uint32_t mismatchCount{ 0U };
+		for (std::uint32_t y = 0U; y < dimension / 2U; ++y) {
+			for (std::uint32_t x = 0U; x < dimension / 2U; ++x) {
+				const double linearAverage{ (SRGBToLinear((y % 256U) / 255.0) + SRGBToLinear((x % 256U) / 255.0)) * 0.5 };
+				const double srgbAverage{ LinearToSRGB(linearAverage) * 255.0 };
+				const std::int32_t expectedValue{ static_cast<std::int32_t>(std::floor(srgbAverage + 0.5)) };
+				const std::int32_t difference{ std::abs(static_cast<std::int32_t>(mips[(y * dimension / 2U + x) * 4U]) - expectedValue) };
+
+				// Values that are halfway between two sRGB values can be rounded to any of them
+				const bool isHalfway{ std::abs(srgbAverage - std::floor(srgbAverage) - 0.5) <= 1.0e-4 };
+				if (difference > 1 || (difference == 1 && isHalfway == false)) {
+					++mismatchCount;
+				}
+			}
+		}
+		CHECK(mismatchCount == 0U);
+	}
+
+	// Filters of odd sizes match a double precision reference
+	void TestFiltersMatchReference() {
+		const std::uint32_t width{ 45U };
+		const std::uint32_t height{ 17U };
+		std::mt19937 generator(3U);
+		std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+		std::vector<float> texels(width * height);
+		for (float& texel : texels) {
+			texel = distribution(generator);
+		}
+
+		for (const MipGenerator::Filter filter : { MipGenerator::Filter::BOX, MipGenerator::Filter::KAISER }) {
+			const std::vector<std::uint8_t> mips{ GenerateMips(
+				reinterpret_cast<const std::uint8_t*>(texels.data()), 1U, texels.size() * sizeof(float), width, height, DXGI_FORMAT_R32_FLOAT, filter, 1U) };
+			const float* mipTexels{ reinterpret_cast<const float*>(mips.data()) };
+
+			const std::uint32_t mipWidth{ width / 2U };
+			const std::uint32_t mipHeight{ height / 2U };
+			std::vector<std::pair<std::uint32_t, double>> weightsX;
+			std::vector<std::pair<std::uint32_t, double>> weightsY;
+			double maxDifference{ 0.0 };
+			for (std::uint32_t y = 0U; y < mipHeight; ++y) {
+				ComputeReferenceWeights(filter, height, mipHeight, y, weightsY);
+				for (std::uint32_t x = 0U; x < mipWidth; ++x) {
+					ComputeReferenceWeights(filter, width, mipWidth, x, weightsX);
+					double value{ 0.0 };
+					for (const std::pair<std::uint32_t, double>& weightY : weightsY) {
+						for (const std::pair<std::uint32_t, double>& weightX : weightsX) {
+							value += weightY.second * weightX.second * texels[weightY.first * width + weightX.first];
+						}
+					}
+					maxDifference = std::max<double>(maxDifference, std::abs(value - mipTexels[y * mipWidth + x]));
+				}
+			}
+			CHECK(maxDifference < 1.0e-5);
+		}
+	}
+
+	// Each face of a cube map is filtered independently
+	void TestCubeMapFaces() {
+		const std::uint32_t dimension{ 16U };
+		const std::size_t faceSize{ dimension * dimension * 4UL };
+		std::vector<float> texels(6UL * faceSize);
+		for (std::uint32_t i = 0U; i < 6U; ++i) {
+			std::fill(texels.begin() + i * faceSize, texels.begin() + (i + 1UL) * faceSize, static_cast<float>(i + 1U));
+		}
+
+		const std::vector<std::uint8_t> mips{ GenerateMips(
+			reinterpret_cast<const std::uint8_t*>(texels.data()),
+			6U,
+			faceSize * sizeof(float),
+			dimension,
+			dimension,
+			DXGI_FORMAT_R32G32B32A32_FLOAT,
+			MipGenerator::Filter::KAISER,
+			4U) };
+		const float* mipTexels{ reinterpret_cast<const float*>(mips.data()) };
+		const std::size_t faceMipsSize{ MipGenerator::GetMipsSize(dimension, dimension, DXGI_FORMAT_R32G32B32A32_FLOAT, 4U) / sizeof(float) };
+		bool areFacesIndependent{ true };
+		for (std::uint32_t i = 0U; i < 6U; ++i) {
+			for (std::size_t j = 0UL; j < faceMipsSize; ++j) {
+				areFacesIndependent &= std::abs(mipTexels[i * faceMipsSize + j] - static_cast<float>(i + 1U)) < 1.0e-5f;
+			}
+		}
+		CHECK(areFacesIndependent);
+	}
+
+	// Mips of block compressed images are decompressed, filtered and compressed again, so they must be
+	// the compressed mips of the decompressed images. Images of external/resources/textures are
+	// compressed to BC1 (cropped to 256 x 256 texels).
+	void TestBlockCompressedMips() {
+		const std::vector<TextureTestUtils::Image> images{ TextureTestUtils::ReadResourceImages(256U) };
+		CHECK(images.empty() == false);
+		for (const TextureTestUtils::Image& image : images) {
+			if (image.mWidth % 8U != 0U || image.mHeight % 8U != 0U) {
+				continue;
+			}
+
+			std::vector<std::uint8_t> blocks(BlockCompressor::GetCompressedSize(image.mWidth, image.mHeight, BlockCompressor::Format::BC1));
+			BlockCompressor::CompressImage(image.mTexels.data(), image.mWidth, image.mHeight, image.mWidth * 4UL, BlockCompressor::Format::BC1, blocks.data());
+			std::vector<std::uint8_t> decompressedTexels(image.mTexels.size());
+			BlockCompressor::DecompressImage(blocks.data(), image.mWidth, image.mHeight, BlockCompressor::Format::BC1, decompressedTexels.data());
+
+			const std::vector<std::uint8_t> referenceMip{ GenerateMips(
+				decompressedTexels.data(), 1U, decompressedTexels.size(), image.mWidth, image.mHeight, DXGI_FORMAT_R8G8B8A8_UNORM, MipGenerator::Filter::BOX, 1U) };
+			const std::vector<std::uint8_t> mip{ GenerateMips(
+				blocks.data(), 1U, blocks.size(), image.mWidth, image.mHeight, DXGI_FORMAT_BC1_UNORM, MipGenerator::Filter::BOX, 1U) };
+			const std::uint32_t mipWidth{ image.mWidth / 2U };
+			const std::uint32_t mipHeight{ image.mHeight / 2U };
+			CHECK(mip.size() == BlockCompressor::GetCompressedSize(mipWidth, mipHeight, BlockCompressor::Format::BC1));
+
+			std::vector<std::uint8_t> referenceBlocks(mip.size());
+			BlockCompressor::CompressImage(referenceMip.data(), mipWidth, mipHeight, mipWidth * 4UL, BlockCompressor::Format::BC1, referenceBlocks.data());
+			CHECK(mip == referenceBlocks);
+		}
+	}
+}
+
+int main() {
+	RUN_TEST(TestSizes);
+	RUN_TEST(TestConstantImages);
+	RUN_TEST(TestBoxFilterAverages);
+	RUN_TEST(TestGammaCorrection);
+	RUN_TEST(TestSRGBRounding);
+	RUN_TEST(TestFiltersMatchReference);
+	RUN_TEST(TestCubeMapFaces);
+	RUN_TEST(TestBlockCompressedMips);
+
+	return static_cast<int>(TestUtils::GetFailureCount());
+}
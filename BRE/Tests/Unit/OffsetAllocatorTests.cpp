@@ -0,0 +1,173 @@
+#include <atomic>
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <ResourceManager/OffsetAllocator.h>
+#include <TestUtils.h>
+
+namespace {
+	struct Range {
+		std::uint32_t mOffset;
+		std::uint32_t mElementCount;
+	};
+
+	void TestBestFitAndMerge() {
+		OffsetAllocator allocator(100U);
+		const std::uint32_t range1{ allocator.Allocate(10U) };
+		const std::uint32_t range2{ allocator.Allocate(20U) };
+		const std::uint32_t range3{ allocator.Allocate(30U) };
+		CHECK(range1 == 0U && range2 == 10U && range3 == 30U);
+
+		allocator.Free(range2, 20U);
+		CHECK(allocator.GetFreeRangeCount() == 2U);
+		CHECK(allocator.GetFreeSize() == 60U);
+		CHECK(allocator.GetLargestFreeRangeSize() == 40U);
+
+		// Best fit: the hole of 20 elements, not the 40 elements at the end
+		const std::uint32_t range4{ allocator.Allocate(15U) };
+		CHECK(range4 == 10U);
+
+		allocator.Free(range4, 15U);
+		allocator.Free(range1, 10U);
+		allocator.Free(range3, 30U);
+		CHECK(allocator.GetFreeRangeCount() == 1U);
+		CHECK(allocator.GetFreeSize() == 100U);
+		CHECK(allocator.GetLargestFreeRangeSize() == 100U);
+		CHECK(allocator.GetFragmentation() == 0.0f);
+
+		CHECK(allocator.Allocate(101U) == OffsetAllocator::sInvalidOffset);
+		CHECK(allocator.Allocate(100U) == 0U);
+		CHECK(allocator.Allocate(1U) == OffsetAllocator::sInvalidOffset);
+	}
+
+	void TestFragmentation() {
+		OffsetAllocator allocator(100U);
+		std::vector<std::uint32_t> offsets;
+		for (std::uint32_t i = 0U; i < 10U; ++i) {
+			offsets.push_back(allocator.Allocate(10U));
+		}
+
+		// 5 free ranges of 10 elements
+		for (std::uint32_t i = 0U; i < 10U; i += 2U) {
+			allocator.Free(offsets[i], 10U);
+		}
+		CHECK(allocator.GetFreeRangeCount() == 5U);
+		CHECK(allocator.GetFreeSize() == 50U);
+		CHECK(allocator.GetLargestFreeRangeSize() == 10U);
+		CHECK(allocator.GetFragmentation() > 0.79f && allocator.GetFragmentation() < 0.81f);
+		CHECK(allocator.Allocate(11U) == OffsetAllocator::sInvalidOffset);
+	}
+
+	// Random allocations and frees never overlap, and freeing everything
+	// merges all the free ranges into one
+	void TestRandomRangesDoNotOverlap() {
+		const std::uint32_t capacity{ 1U << 20U };
+		OffsetAllocator allocator(capacity);
+		std::mt19937 generator(1U);
+		std::uniform_int_distribution<std::uint32_t> sizeDistribution(1U, 4096U);
+		std::vector<std::uint8_t> isAllocated(capacity, 0U);
+		std::vector<Range> ranges;
+		std::uint32_t overlapCount{ 0U };
+		std::uint64_t allocatedSize{ 0UL };
+		for (std::uint32_t i = 0U; i < 50000U; ++i) {
+			if (ranges.empty() || generator() % 100U < 55U) {
+				const std::uint32_t elementCount{ sizeDistribution(generator) };
+				const std::uint32_t offset{ allocator.Allocate(elementCount) };
+				if (offset == OffsetAllocator::sInvalidOffset) {
+					CHECK(allocator.GetLargestFreeRangeSize() < elementCount);
+					continue;
+				}
+
+				CHECK(offset + elementCount <= capacity);
+				for (std::uint32_t j = offset; j < offset + elementCount; ++j) {
+					overlapCount += isAllocated[j];
+					isAllocated[j] = 1U;
+				}
+				ranges.push_back(Range{ offset, elementCount });
+				allocatedSize += elementCount;
+			} else {
+				const std::size_t rangeIndex{ generator() % ranges.size() };
+				const Range range{ ranges[rangeIndex] };
+				ranges[rangeIndex] = ranges.back();
+				ranges.pop_back();
+				for (std::uint32_t j = range.mOffset; j < range.mOffset + range.mElementCount; ++j) {
+					isAllocated[j] = 0U;
+				}
+				allocator.Free(range.mOffset, range.mElementCount);
+				allocatedSize -= range.mElementCount;
+			}
+		}
+		CHECK(overlapCount == 0U);
+		CHECK(allocator.GetFreeSize() + allocatedSize == capacity);
+
+		for (const Range& range : ranges) {
+			allocator.Free(range.mOffset, range.mElementCount);
+		}
+		CHECK(allocator.GetFreeRangeCount() == 1U);
+		CHECK(allocator.GetFreeSize() == capacity);
+	}
+
+	// Like loading threads that create vertex and index buffers at the same time
+	void TestConcurrentAllocations() {
+		const std::uint32_t capacity{ 1U << 20U };
+		const std::uint32_t threadCount{ 4U };
+		OffsetAllocator allocator(capacity);
+		std::vector<std::atomic<std::uint8_t>> isAllocated(capacity);
+		std::atomic<std::uint32_t> overlapCount{ 0U };
+		std::vector<std::thread> threads;
+		for (std::uint32_t i = 0U; i < threadCount; ++i) {
+			threads.emplace_back([&allocator, &isAllocated, &overlapCount, i]() {
+				std::mt19937 generator(i);
+				std::vector<Range> ranges;
+				for (std::uint32_t j = 0U; j < 20000U; ++j) {
+					if (ranges.size() < 32U) {
+						const std::uint32_t elementCount{ static_cast<std::uint32_t>(generator() % 1024U) + 1U };
+						const std::uint32_t offset{ allocator.Allocate(elementCount) };
+						if (offset == OffsetAllocator::sInvalidOffset) {
+							continue;
+						}
+						for (std::uint32_t k = offset; k < offset + elementCount; ++k) {
+							if (isAllocated[k].exchange(1U) != 0U) {
+								++overlapCount;
+							}
+						}
+						ranges.push_back(Range{ offset, elementCount });
+					} else {
+						for (const Range& range : ranges) {
+							for (std::uint32_t k = range.mOffset; k < range.mOffset + range.mElementCount; ++k) {
+								isAllocated[k] = 0U;
+							}
+							allocator.Free(range.mOffset, range.mElementCount);
+						}
+						ranges.clear();
+					}
+				}
+
+				for (const Range& range : ranges) {
+					for (std::uint32_t k = range.mOffset; k < range.mOffset + range.mElementCount; ++k) {
+						isAllocated[k] = 0U;
+					}
+					allocator.Free(range.mOffset, range.mElementCount);
+				}
+			});
+		}
+		for (std::thread& thread : threads) {
+			thread.join();
+		}
+
+		CHECK(overlapCount == 0U);
+		CHECK(allocator.GetFreeRangeCount() == 1U);
+		CHECK(allocator.GetFreeSize() == capacity);
+	}
+}
+
+int main() {
+	RUN_TEST(TestBestFitAndMerge);
+	RUN_TEST(TestFragmentation);
+	RUN_TEST(TestRandomRangesDoNotOverlap);
+	RUN_TEST(TestConcurrentAllocations);
+
+	return static_cast<int>(TestUtils::GetFailureCount());
+}
@@ -0,0 +1,153 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <PSOManager/PipelineCacheFile.h>
+#include <TestUtils.h>
+
+namespace {
+	const std::uint64_t sDeviceKey{ 0x0123456789ABCDEFUL };
+
+	std::vector<std::uint8_t> CreateData(const std::size_t dataSize) {
+		std::vector<std::uint8_t> data(dataSize);
+		for (std::size_t i = 0UL; i < dataSize; ++i) {
+			data[i] = static_cast<std::uint8_t>(i * 31UL + 7UL);
+		}
+
+		return data;
+	}
+
+	std::vector<std::uint8_t> ReadFileBytes(const std::string& filePath) {
+		std::ifstream file(filePath, std::ios::binary);
+		return std::vector<std::uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	}
+
+	void WriteFileBytes(const std::string& filePath, const std::vector<std::uint8_t>& bytes) {
+		std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+		file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+	}
+
+	// Writes a valid cache file, changes its bytes, and returns if it is read
+	template<typename Function>
+	bool IsReadAfterChange(const std::string& filePath, Function changeBytes) {
+		const std::vector<std::uint8_t> sourceData{ CreateData(1000UL) };
+		if (PipelineCacheFile::WriteFile(filePath.c_str(), sDeviceKey, sourceData.data(), sourceData.size()) == false) {
+			return true;
+		}
+
+		std::vector<std::uint8_t> bytes{ ReadFileBytes(filePath) };
+		changeBytes(bytes);
+		WriteFileBytes(filePath, bytes);
+
+		// Rejected files do not change the data
+		std::vector<std::uint8_t> data{ 1U, 2U, 3U };
+		const bool isRead{ PipelineCacheFile::ReadFile(filePath.c_str(), sDeviceKey, data) };
+		CHECK(isRead || data == std::vector<std::uint8_t>({ 1U, 2U, 3U }));
+		return isRead;
+	}
+
+	void TestRoundTrip() {
+		const std::string filePath{ TestUtils::GetTemporaryFilePath("PipelineCacheFileTests.bin") };
+		const std::size_t dataSizes[]{ 0UL, 1UL, 1000UL, 1000000UL };
+		for (const std::size_t dataSize : dataSizes) {
+			const std::vector<std::uint8_t> sourceData{ CreateData(dataSize) };
+			CHECK(PipelineCacheFile::WriteFile(filePath.c_str(), sDeviceKey, sourceData.data(), sourceData.size()));
+			CHECK(ReadFileBytes(filePath).size() == PipelineCacheFile::GetHeaderSize() + dataSize);
+
+			std::vector<std::uint8_t> data;
+			CHECK(PipelineCacheFile::ReadFile(filePath.c_str(), sDeviceKey, data));
+			CHECK(data == sourceData);
+		}
+
+		// Unchanged bytes are read (so the rejections below are caused by the changes)
+		CHECK(IsReadAfterChange(filePath, [](std::vector<std::uint8_t>&) {}));
+
+		std::remove(filePath.c_str());
+	}
+
+	void TestMissingFileIsRejected() {
+		const std::string filePath{ TestUtils::GetTemporaryFilePath("PipelineCacheFileTests.missing") };
+		std::remove(filePath.c_str());
+		std::vector<std::uint8_t> data;
+		CHECK(PipelineCacheFile::ReadFile(filePath.c_str(), sDeviceKey, data) == false);
+
+		// A file that cannot be written does not exist
+		const std::string invalidFilePath{ filePath + "/PipelineCacheFileTests.bin" };
+		const std::vector<std::uint8_t> sourceData{ CreateData(10UL) };
+		CHECK(PipelineCacheFile::WriteFile(invalidFilePath.c_str(), sDeviceKey, sourceData.data(), sourceData.size()) == false);
+	}
+
+	// Files truncated in the header, at the end of the header, or in the data, and with extra bytes
+	void TestTruncatedFileIsRejected() {
+		const std::string filePath{ TestUtils::GetTemporaryFilePath("PipelineCacheFileTests.bin") };
+		const std::size_t headerSize{ PipelineCacheFile::GetHeaderSize() };
+		const std::size_t fileSizes[]{ 0UL, 4UL, headerSize - 1UL, headerSize, headerSize + 999UL };
+		for (const std::size_t fileSize : fileSizes) {
+			CHECK(IsReadAfterChange(filePath, [fileSize](std::vector<std::uint8_t>& bytes) { bytes.resize(fileSize); }) == false);
+		}
+		CHECK(IsReadAfterChange(filePath, [](std::vector<std::uint8_t>& bytes) { bytes.push_back(0U); }) == false);
+
+		std::remove(filePath.c_str());
+	}
+
+	// A changed bit in the data, or in the data size or hash of the header
+	void TestCorruptedFileIsRejected() {
+		const std::string filePath{ TestUtils::GetTemporaryFilePath("PipelineCacheFileTests.bin") };
+		const std::size_t headerSize{ PipelineCacheFile::GetHeaderSize() };
+		const std::size_t byteIndices[]{ headerSize, headerSize + 500UL, headerSize + 999UL, 16UL, 24UL, 31UL };
+		for (const std::size_t byteIndex : byteIndices) {
+			CHECK(IsReadAfterChange(filePath, [byteIndex](std::vector<std::uint8_t>& bytes) { bytes[byteIndex] ^= 0x10U; }) == false);
+		}
+
+		// Magic number
+		CHECK(IsReadAfterChange(filePath, [](std::vector<std::uint8_t>& bytes) { bytes[0U] = 'X'; }) == false);
+
+		std::remove(filePath.c_str());
+	}
+
+	// A file of another format version (older or newer)
+	void TestWrongVersionIsRejected() {
+		const std::string filePath{ TestUtils::GetTemporaryFilePath("PipelineCacheFileTests.bin") };
+		for (const std::uint32_t formatVersion : { PipelineCacheFile::sFormatVersion - 1U, PipelineCacheFile::sFormatVersion + 1U }) {
+			CHECK(IsReadAfterChange(filePath, [formatVersion](std::vector<std::uint8_t>& bytes) {
+				for (std::uint32_t i = 0U; i < 4U; ++i) {
+					bytes[4U + i] = static_cast<std::uint8_t>(formatVersion >> (i * 8U));
+				}
+			}) == false);
+		}
+
+		std::remove(filePath.c_str());
+	}
+
+	// A file written by another adapter or driver version (see PSOManager)
+	void TestWrongAdapterIsRejected() {
+		const std::string filePath{ TestUtils::GetTemporaryFilePath("PipelineCacheFileTests.bin") };
+		const std::vector<std::uint8_t> sourceData{ CreateData(1000UL) };
+		CHECK(PipelineCacheFile::WriteFile(filePath.c_str(), sDeviceKey, sourceData.data(), sourceData.size()));
+
+		std::vector<std::uint8_t> data;
+		CHECK(PipelineCacheFile::ReadFile(filePath.c_str(), sDeviceKey + 1UL, data) == false);
+		CHECK(PipelineCacheFile::ReadFile(filePath.c_str(), 0UL, data) == false);
+		CHECK(data.empty());
+
+		// The device key is stored after the magic number and the version
+		CHECK(IsReadAfterChange(filePath, [](std::vector<std::uint8_t>& bytes) { bytes[8U] ^= 1U; }) == false);
+
+		std::remove(filePath.c_str());
+	}
+}
+
+int main() {
+	RUN_TEST(TestRoundTrip);
+	RUN_TEST(TestMissingFileIsRejected);
+	RUN_TEST(TestTruncatedFileIsRejected);
+	RUN_TEST(TestCorruptedFileIsRejected);
+	RUN_TEST(TestWrongVersionIsRejected);
+	RUN_TEST(TestWrongAdapterIsRejected);
+
+	return static_cast<int>(TestUtils::GetFailureCount());
+}
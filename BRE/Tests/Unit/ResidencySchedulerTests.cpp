@@ -0,0 +1,277 @@
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <ResourceManager/ResidencyScheduler.h>
+#include <TestUtils.h>
+
+namespace {
+	using Category = ResidencyScheduler::Category;
+
+	std::uint32_t AddEvictablePageable(
+		ResidencyScheduler& scheduler,
+		const std::uint64_t size,
+		const Category category,
+		const std::uint64_t frameIndex)
+	{
+		const std::uint32_t pageableId{ scheduler.AddPageable(size, category, frameIndex) };
+		scheduler.SetEvictable(pageableId, true);
+		return pageableId;
+	}
+
+	// New pageables are resident and they are not evicted until they are evictable,
+	// even if the resident size exceeds the budget
+	void TestNewPageablesAreNotEvictable() {
+		ResidencyScheduler scheduler(100UL, 0U, 1000U);
+		const std::uint32_t pageableId1{ scheduler.AddPageable(100UL, Category::TEXTURE, 1UL) };
+		const std::uint32_t pageableId2{ scheduler.AddPageable(100UL, Category::BUFFER, 1UL) };
+		CHECK(scheduler.GetResidentSize() == 200UL);
+
+		ResidencyScheduler::Changes changes;
+		scheduler.ScheduleChanges(10UL, 9UL, changes);
+		CHECK(changes.mEvictedPageableIds.empty());
+		CHECK(scheduler.IsResident(pageableId1) && scheduler.IsResident(pageableId2));
+
+		// Evictable again and then not evictable (like a resource kept resident after it was marked)
+		scheduler.SetEvictable(pageableId1, true);
+		scheduler.SetEvictable(pageableId1, false);
+		scheduler.ScheduleChanges(11UL, 10UL, changes);
+		CHECK(changes.mEvictedPageableIds.empty());
+
+		scheduler.SetEvictable(pageableId2, true);
+		scheduler.ScheduleChanges(12UL, 11UL, changes);
+		CHECK(changes.mEvictedPageableIds.size() == 1UL && changes.mEvictedPageableIds[0U] == pageableId2);
+		CHECK(scheduler.GetResidentSize() == 100UL);
+	}
+
+	// Least recently used pageables are evicted first, and only until the resident size fits
+	void TestLeastRecentlyUsedAreEvicted() {
+		ResidencyScheduler scheduler(300UL, 0U, 1000U);
+		const std::uint32_t pageableId1{ AddEvictablePageable(scheduler, 100UL, Category::TEXTURE, 1UL) };
+		const std::uint32_t pageableId2{ AddEvictablePageable(scheduler, 100UL, Category::TEXTURE, 1UL) };
+		const std::uint32_t pageableId3{ AddEvictablePageable(scheduler, 100UL, Category::BUFFER, 1UL) };
+		scheduler.AddPageable(100UL, Category::RENDER_TARGET, 2UL);
+		CHECK(scheduler.MarkUsed(pageableId1, 3UL) == false);
+		CHECK(scheduler.MarkUsed(pageableId3, 3UL) == false);
+
+		ResidencyScheduler::Changes changes;
+		scheduler.ScheduleChanges(4UL, 3UL, changes);
+		CHECK(changes.mEvictedPageableIds.size() == 1UL && changes.mEvictedPageableIds[0U] == pageableId2);
+		CHECK(scheduler.IsResident(pageableId2) == false);
+		CHECK(scheduler.GetResidentSize() == 300UL);
+
+		// It must be made resident when it is used again
+		CHECK(scheduler.MarkUsed(pageableId2, 4UL));
+		CHECK(scheduler.MarkUsed(pageableId2, 4UL) == false);
+		CHECK(scheduler.IsResident(pageableId2));
+		CHECK(scheduler.GetResidentSize() == 400UL);
+
+		// Ties are broken by identifier
+		scheduler.SetMemoryBudget(200UL);
+		changes = ResidencyScheduler::Changes();
+		scheduler.ScheduleChanges(5UL, 4UL, changes);
+		CHECK(changes.mEvictedPageableIds.size() == 2UL);
+		CHECK(changes.mEvictedPageableIds[0U] == pageableId1 && changes.mEvictedPageableIds[1U] == pageableId3);
+		CHECK(scheduler.GetResidentSize() == 200UL);
+	}
+
+	// Pageables used in frames that the GPU did not complete, or in the last
+	// "minIdleFrameCount" frames, are not evicted
+	void TestRecentlyUsedAreNotEvicted() {
+		ResidencyScheduler scheduler(0UL, 0U, 1000U);
+		const std::uint32_t pageableId{ AddEvictablePageable(scheduler, 100UL, Category::TEXTURE, 1UL) };
+		scheduler.MarkUsed(pageableId, 4UL);
+
+		ResidencyScheduler::Changes changes;
+		scheduler.ScheduleChanges(5UL, 3UL, changes);
+		CHECK(changes.mEvictedPageableIds.empty());
+		scheduler.ScheduleChanges(5UL, 4UL, changes);
+		CHECK(changes.mEvictedPageableIds.size() == 1UL);
+
+		ResidencyScheduler idleScheduler(0UL, 3U, 1000U);
+		AddEvictablePageable(idleScheduler, 10UL, Category::TEXTURE, 1UL);
+		changes = ResidencyScheduler::Changes();
+		idleScheduler.ScheduleChanges(3UL, 2UL, changes);
+		CHECK(changes.mEvictedPageableIds.empty());
+		idleScheduler.ScheduleChanges(4UL, 3UL, changes);
+		CHECK(changes.mEvictedPageableIds.empty());
+		idleScheduler.ScheduleChanges(5UL, 4UL, changes);
+		CHECK(changes.mEvictedPageableIds.size() == 1UL);
+	}
+
+	// Upload pageables are reported, but they do not count against the budget and they are never evicted
+	void TestUploadPageablesAreNotBudgeted() {
+		ResidencyScheduler scheduler(0UL, 0U, 1U);
+		const std::uint32_t pageableId{ AddEvictablePageable(scheduler, 1000UL, Category::UPLOAD, 1UL) };
+		CHECK(scheduler.GetResidentSize() == 0UL);
+
+		ResidencyScheduler::Changes changes;
+		scheduler.ScheduleChanges(10UL, 9UL, changes);
+		CHECK(changes.mEvictedPageableIds.empty() && changes.mDemotedPageableIds.empty());
+		CHECK(scheduler.IsResident(pageableId) && scheduler.IsDemoted(pageableId) == false);
+
+		const ResidencyScheduler::Statistics statistics{ scheduler.GetStatistics() };
+		const ResidencyScheduler::CategoryStatistics& uploadStatistics{
+			statistics.mCategories[static_cast<std::uint32_t>(Category::UPLOAD)] };
+		CHECK(uploadStatistics.mPageableCount == 1U && uploadStatistics.mResidentSize == 1000UL);
+		CHECK(statistics.mResidentSize == 0UL);
+	}
+
+	// Idle evictable pageables are demoted, and they are promoted when they are used again,
+	// or when they are not evictable anymore
+	void TestDemotionAndPromotion() {
+		ResidencyScheduler scheduler(1000UL, 0U, 2U);
+		const std::uint32_t pageableId1{ AddEvictablePageable(scheduler, 10UL, Category::TEXTURE, 1UL) };
+		const std::uint32_t pageableId2{ AddEvictablePageable(scheduler, 20UL, Category::TEXTURE, 1UL) };
+		const std::uint32_t pageableId3{ scheduler.AddPageable(5UL, Category::TEXTURE, 1UL) };
+
+		ResidencyScheduler::Changes changes;
+		scheduler.ScheduleChanges(3UL, 2UL, changes);
+		CHECK(changes.mDemotedPageableIds.empty());
+
+		scheduler.MarkUsed(pageableId2, 3UL);
+		scheduler.ScheduleChanges(4UL, 3UL, changes);
+		CHECK(changes.mDemotedPageableIds.size() == 1UL && changes.mDemotedPageableIds[0U] == pageableId1);
+		CHECK(scheduler.IsDemoted(pageableId1) && scheduler.IsDemoted(pageableId3) == false);
+		CHECK(scheduler.GetStatistics().mCategories[0U].mDemotedSize == 10UL);
+
+		changes = ResidencyScheduler::Changes();
+		scheduler.MarkUsed(pageableId1, 4UL);
+		CHECK(scheduler.IsDemoted(pageableId1) == false);
+		scheduler.ScheduleChanges(5UL, 4UL, changes);
+		CHECK(changes.mPromotedPageableIds.size() == 1UL && changes.mPromotedPageableIds[0U] == pageableId1);
+		CHECK(changes.mDemotedPageableIds.empty());
+
+		changes = ResidencyScheduler::Changes();
+		scheduler.ScheduleChanges(6UL, 5UL, changes);
+		CHECK(changes.mDemotedPageableIds.size() == 1UL && changes.mDemotedPageableIds[0U] == pageableId2);
+		scheduler.SetEvictable(pageableId2, false);
+		CHECK(scheduler.IsDemoted(pageableId2) == false);
+
+		// Removed pageables are not reported as promoted
+		scheduler.RemovePageable(pageableId2);
+		changes = ResidencyScheduler::Changes();
+		scheduler.ScheduleChanges(7UL, 6UL, changes);
+		CHECK(changes.mPromotedPageableIds.empty());
+		CHECK(changes.mDemotedPageableIds.size() == 1UL && changes.mDemotedPageableIds[0U] == pageableId1);
+		CHECK(scheduler.GetStatistics().mCategories[0U].mDemotedSize == 10UL);
+	}
+
+	// Statistics follow additions, removals, evictions and uses, and identifiers are reused
+	void TestStatisticsAndRemoval() {
+		ResidencyScheduler scheduler(100UL, 0U, 1000U);
+		const std::uint32_t pageableId1{ AddEvictablePageable(scheduler, 100UL, Category::TEXTURE, 1UL) };
+		const std::uint32_t pageableId2{ AddEvictablePageable(scheduler, 100UL, Category::TEXTURE, 2UL) };
+		const std::uint32_t pageableId3{ scheduler.AddPageable(50UL, Category::RENDER_TARGET, 2UL) };
+
+		ResidencyScheduler::Changes changes;
+		scheduler.ScheduleChanges(3UL, 2UL, changes);
+		CHECK(changes.mEvictedPageableIds.size() == 2UL);
+		scheduler.MarkUsed(pageableId2, 3UL);
+
+		ResidencyScheduler::Statistics statistics{ scheduler.GetStatistics() };
+		const ResidencyScheduler::CategoryStatistics& textureStatistics{ statistics.mCategories[0U] };
+		CHECK(textureStatistics.mPageableCount == 2U && textureStatistics.mResidentPageableCount == 1U);
+		CHECK(textureStatistics.mSize == 200UL && textureStatistics.mResidentSize == 100UL);
+		CHECK(statistics.mResidentSize == 150UL && statistics.mMemoryBudget == 100UL);
+		CHECK(statistics.mEvictionCount == 2UL && statistics.mEvictedSize == 200UL);
+		CHECK(statistics.mMakeResidentCount == 1UL && statistics.mMadeResidentSize == 100UL);
+
+		// An evicted pageable and a resident one
+		scheduler.RemovePageable(pageableId1);
+		scheduler.RemovePageable(pageableId3);
+		statistics = scheduler.GetStatistics();
+		CHECK(statistics.mCategories[0U].mSize == 100UL && statistics.mCategories[0U].mPageableCount == 1U);
+		CHECK(statistics.mCategories[static_cast<std::uint32_t>(Category::RENDER_TARGET)].mPageableCount == 0U);
+		CHECK(scheduler.GetResidentSize() == 100UL);
+
+		const std::uint32_t pageableId4{ scheduler.AddPageable(10UL, Category::BUFFER, 4UL) };
+		CHECK(pageableId4 == pageableId1 || pageableId4 == pageableId3);
+		CHECK(scheduler.IsResident(pageableId4) && scheduler.IsDemoted(pageableId4) == false);
+	}
+
+	// Random uses and budgets: the resident size only exceeds the budget if no more pageables
+	// can be evicted, in-flight pageables are never evicted, and statistics match the pageables
+	void TestRandomFramesKeepInvariants() {
+		const std::uint32_t pageableCount{ 500U };
+		const std::uint32_t minIdleFrameCount{ 2U };
+		ResidencyScheduler scheduler(0UL, minIdleFrameCount, 5U);
+		std::mt19937 generator(3U);
+		std::vector<std::uint64_t> sizes(pageableCount);
+		std::vector<std::uint64_t> lastUsedFrames(pageableCount, 1UL);
+		std::vector<bool> isEvictable(pageableCount, false);
+		std::uint64_t totalSize{ 0UL };
+		for (std::uint32_t i = 0U; i < pageableCount; ++i) {
+			sizes[i] = 1UL + generator() % 1000U;
+			totalSize += sizes[i];
+			CHECK(scheduler.AddPageable(sizes[i], static_cast<Category>(i % 3U), 1UL) == i);
+		}
+
+		const std::uint64_t frameLatency{ 2UL };
+		ResidencyScheduler::Changes changes;
+		bool areInvariantsKept{ true };
+		for (std::uint64_t frameIndex = 2UL; frameIndex < 300UL; ++frameIndex) {
+			const std::uint64_t completedFrameIndex{ frameIndex - frameLatency };
+			scheduler.SetMemoryBudget((generator() % 200U) * 1000UL);
+			changes = ResidencyScheduler::Changes();
+			scheduler.ScheduleChanges(frameIndex, completedFrameIndex, changes);
+
+			for (const std::uint32_t pageableId : changes.mEvictedPageableIds) {
+				areInvariantsKept &= isEvictable[pageableId];
+				areInvariantsKept &= lastUsedFrames[pageableId] <= completedFrameIndex;
+				areInvariantsKept &= lastUsedFrames[pageableId] + minIdleFrameCount < frameIndex;
+			}
+
+			// If it is over budget, then every resident pageable must be protected
+			if (scheduler.GetResidentSize() > scheduler.GetMemoryBudget()) {
+				for (std::uint32_t i = 0U; i < pageableCount; ++i) {
+					if (scheduler.IsResident(i) && isEvictable[i]) {
+						areInvariantsKept &=
+							lastUsedFrames[i] > completedFrameIndex || lastUsedFrames[i] + minIdleFrameCount >= frameIndex;
+					}
+				}
+			}
+
+			for (std::uint32_t i = 0U; i < pageableCount; ++i) {
+				if (generator() % 8U == 0U) {
+					isEvictable[i] = generator() % 4U != 0U;
+					scheduler.SetEvictable(i, isEvictable[i]);
+				}
+				if (generator() % 3U == 0U) {
+					const bool wasResident{ scheduler.IsResident(i) };
+					areInvariantsKept &= scheduler.MarkUsed(i, frameIndex) == (wasResident == false);
+					lastUsedFrames[i] = frameIndex;
+				}
+			}
+		}
+		CHECK(areInvariantsKept);
+
+		std::uint64_t residentSize{ 0UL };
+		for (std::uint32_t i = 0U; i < pageableCount; ++i) {
+			residentSize += scheduler.IsResident(i) ? sizes[i] : 0UL;
+		}
+		CHECK(scheduler.GetResidentSize() == residentSize);
+
+		const ResidencyScheduler::Statistics statistics{ scheduler.GetStatistics() };
+		std::uint64_t categoryResidentSize{ 0UL };
+		for (const ResidencyScheduler::CategoryStatistics& categoryStatistics : statistics.mCategories) {
+			categoryResidentSize += categoryStatistics.mResidentSize;
+		}
+		CHECK(categoryResidentSize == residentSize);
+
+		// Everything was resident, and then evicted and made resident again
+		CHECK(totalSize - statistics.mEvictedSize + statistics.mMadeResidentSize == residentSize);
+	}
+}
+
+int main() {
+	RUN_TEST(TestNewPageablesAreNotEvictable);
+	RUN_TEST(TestLeastRecentlyUsedAreEvicted);
+	RUN_TEST(TestRecentlyUsedAreNotEvicted);
+	RUN_TEST(TestUploadPageablesAreNotBudgeted);
+	RUN_TEST(TestDemotionAndPromotion);
+	RUN_TEST(TestStatisticsAndRemoval);
+	RUN_TEST(TestRandomFramesKeepInvariants);
+
+	return static_cast<int>(TestUtils::GetFailureCount());
+}
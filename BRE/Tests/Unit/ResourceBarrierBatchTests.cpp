@@ -0,0 +1,171 @@
+#include <cstdint>
+#include <vector>
+
+#include <ResourceStateManager/ResourceBarrierBatch.h>
+#include <ResourceStateManager/ResourceStateTable.h>
+#include <TestUtils.h>
+
+namespace {
+	using Barrier = ResourceStateTable::Barrier;
+
+	// D3D12_RESOURCE_STATES values
+	const std::uint32_t sStateCommon{ 0U };
+	const std::uint32_t sStateRenderTarget{ 4U };
+	const std::uint32_t sStateUnorderedAccess{ 8U };
+	const std::uint32_t sStateDepthWrite{ 16U };
+	const std::uint32_t sStatePixelShaderResource{ 128U };
+
+	void TestTableSubresourceStates() {
+		int resource{ 0 };
+		ResourceStateTable stateTable;
+		stateTable.AddResource(&resource, 4U, sStateCommon);
+		CHECK(stateTable.HasResource(&resource));
+		CHECK(stateTable.GetState(&resource) == sStateCommon);
+
+		// Subresources already in the state do not get barriers
+		std::vector<Barrier> barriers;
+		CHECK(stateTable.Transition(&resource, 2U, sStateRenderTarget, ResourceStateTable::sBarrierFlagNone, barriers) == 1U);
+		CHECK(stateTable.Transition(&resource, 2U, sStateRenderTarget, ResourceStateTable::sBarrierFlagNone, barriers) == 0U);
+		CHECK(barriers.size() == 1UL);
+		CHECK(barriers[0U].mSubresource == 2U);
+		CHECK(barriers[0U].mStateBefore == sStateCommon && barriers[0U].mStateAfter == sStateRenderTarget);
+		CHECK(stateTable.GetState(&resource, 2U) == sStateRenderTarget);
+		CHECK(stateTable.GetState(&resource, 1U) == sStateCommon);
+
+		// A transition of all the subresources from different states needs a barrier per subresource
+		barriers.clear();
+		CHECK(stateTable.Transition(
+			&resource, 
+			ResourceStateTable::sAllSubresources, 
+			sStatePixelShaderResource, 
+			ResourceStateTable::sBarrierFlagNone, 
+			barriers) == 4U);
+		CHECK(stateTable.GetState(&resource) == sStatePixelShaderResource);
+
+		// Once they are in the same state, a single barrier is enough
+		barriers.clear();
+		CHECK(stateTable.Transition(
+			&resource,
+			ResourceStateTable::sAllSubresources,
+			sStateCommon,
+			ResourceStateTable::sBarrierFlagNone,
+			barriers) == 1U);
+		CHECK(barriers[0U].mSubresource == ResourceStateTable::sAllSubresources);
+
+		stateTable.RemoveResource(&resource);
+		CHECK(stateTable.HasResource(&resource) == false);
+	}
+
+	void TestBatchDropsRoundTrips() {
+		int resource{ 0 };
+		ResourceStateTable stateTable;
+		stateTable.AddResource(&resource, 1U, sStateCommon);
+
+		ResourceBarrierBatch batch;
+		std::vector<Barrier> barriers;
+		batch.Transition(&resource, sStateRenderTarget);
+		batch.Transition(&resource, sStateCommon);
+		CHECK(batch.Resolve(stateTable, barriers) == 0U);
+		CHECK(barriers.empty());
+		CHECK(batch.IsEmpty());
+		CHECK(stateTable.GetState(&resource) == sStateCommon);
+	}
+
+	void TestBatchMergesConsecutiveTransitions() {
+		int resource{ 0 };
+		ResourceStateTable stateTable;
+		stateTable.AddResource(&resource, 1U, sStateCommon);
+
+		ResourceBarrierBatch batch;
+		std::vector<Barrier> barriers;
+		batch.Transition(&resource, sStateRenderTarget);
+		batch.Transition(&resource, sStateUnorderedAccess);
+		CHECK(batch.Resolve(stateTable, barriers) == 1U);
+		CHECK(barriers[0U].mStateBefore == sStateCommon);
+		CHECK(barriers[0U].mStateAfter == sStateUnorderedAccess);
+		CHECK(stateTable.GetState(&resource) == sStateUnorderedAccess);
+	}
+
+	void TestBatchSubresources() {
+		int resource{ 0 };
+		ResourceStateTable stateTable;
+		stateTable.AddResource(&resource, 4U, sStateCommon);
+
+		ResourceBarrierBatch batch;
+		std::vector<Barrier> barriers;
+		batch.Transition(&resource, sStateRenderTarget, 1U);
+		batch.Transition(&resource, sStateRenderTarget, 2U);
+		CHECK(batch.Resolve(stateTable, barriers) == 2U);
+		CHECK(stateTable.GetState(&resource, 1U) == sStateRenderTarget);
+		CHECK(stateTable.GetState(&resource, 0U) == sStateCommon);
+
+		// Only the subresources that are not in the state yet
+		barriers.clear();
+		batch.Transition(&resource, sStateRenderTarget);
+		CHECK(batch.Resolve(stateTable, barriers) == 2U);
+		CHECK(barriers[0U].mSubresource == 0U && barriers[1U].mSubresource == 3U);
+		CHECK(stateTable.GetState(&resource) == sStateRenderTarget);
+
+		// A transition of all the subresources replaces the previous transitions of a subresource
+		barriers.clear();
+		batch.Transition(&resource, sStateUnorderedAccess, 1U);
+		batch.Transition(&resource, sStateDepthWrite);
+		CHECK(batch.Resolve(stateTable, barriers) == 1U);
+		CHECK(barriers[0U].mSubresource == ResourceStateTable::sAllSubresources);
+		CHECK(barriers[0U].mStateBefore == sStateRenderTarget);
+	}
+
+	void TestBatchSplitTransitions() {
+		int resource1{ 0 };
+		int resource2{ 0 };
+		ResourceStateTable stateTable;
+		stateTable.AddResource(&resource1, 1U, sStateCommon);
+		stateTable.AddResource(&resource2, 1U, sStateRenderTarget);
+
+		ResourceBarrierBatch batch;
+		std::vector<Barrier> barriers;
+		batch.BeginTransition(&resource2, sStatePixelShaderResource);
+		CHECK(batch.Resolve(stateTable, barriers) == 1U);
+		CHECK(barriers[0U].mFlags == ResourceStateTable::sBarrierFlagBeginOnly);
+		CHECK(stateTable.GetPendingSplitTransitionCount() == 1U);
+
+		barriers.clear();
+		batch.EndTransition(&resource2, sStatePixelShaderResource);
+		batch.Transition(&resource1, sStateCommon);
+		CHECK(batch.Resolve(stateTable, barriers) == 1U);
+		CHECK(barriers[0U].mFlags == ResourceStateTable::sBarrierFlagEndOnly);
+		CHECK(barriers[0U].mStateBefore == sStateRenderTarget);
+		CHECK(barriers[0U].mStateAfter == sStatePixelShaderResource);
+		CHECK(stateTable.GetPendingSplitTransitionCount() == 0U);
+	}
+
+	void TestBatchAliasingBarrierIsNotReordered() {
+		int resource{ 0 };
+		ResourceStateTable stateTable;
+		stateTable.AddResource(&resource, 1U, sStateCommon);
+
+		// Transitions before and after an aliasing barrier are not merged
+		ResourceBarrierBatch batch;
+		std::vector<Barrier> barriers;
+		batch.Transition(&resource, sStateRenderTarget);
+		batch.AddAliasingBarrier(nullptr, &resource);
+		batch.Transition(&resource, sStateUnorderedAccess);
+		CHECK(batch.Resolve(stateTable, barriers) == 3U);
+		CHECK(barriers[0U].mType == ResourceStateTable::TRANSITION_BARRIER);
+		CHECK(barriers[1U].mType == ResourceStateTable::ALIASING_BARRIER);
+		CHECK(barriers[1U].mResource == nullptr && barriers[1U].mResourceAfter == &resource);
+		CHECK(barriers[2U].mType == ResourceStateTable::TRANSITION_BARRIER);
+		CHECK(barriers[2U].mStateBefore == sStateRenderTarget);
+	}
+}
+
+int main() {
+	RUN_TEST(TestTableSubresourceStates);
+	RUN_TEST(TestBatchDropsRoundTrips);
+	RUN_TEST(TestBatchMergesConsecutiveTransitions);
+	RUN_TEST(TestBatchSubresources);
+	RUN_TEST(TestBatchSplitTransitions);
+	RUN_TEST(TestBatchAliasingBarrierIsNotReordered);
+
+	return static_cast<int>(TestUtils::GetFailureCount());
+}
@@ -0,0 +1,172 @@
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <ResourceManager/RingBufferAllocator.h>
+#include <TestUtils.h>
+
+namespace {
+	void TestAlignedSize() {
+		CHECK(RingBufferAllocator::GetAlignedSize(1UL) == 256UL);
+		CHECK(RingBufferAllocator::GetAlignedSize(256UL) == 256UL);
+		CHECK(RingBufferAllocator::GetAlignedSize(257UL) == 512UL);
+	}
+
+	void TestAllocateAndRelease() {
+		RingBufferAllocator allocator(4096UL);
+		CHECK(allocator.GetCapacity() == 4096UL);
+
+		CHECK(allocator.Allocate(100UL) == 0UL);
+		CHECK(allocator.Allocate(300UL) == 256UL);
+		CHECK(allocator.GetUsedSize() == 768UL);
+		allocator.FinishFrame(1UL);
+
+		CHECK(allocator.Allocate(1024UL) == 768UL);
+		allocator.FinishFrame(2UL);
+
+		// Frames are released in order, when their fence value is completed
+		allocator.ReleaseCompletedFrames(0UL);
+		CHECK(allocator.GetUsedSize() == 1792UL);
+		allocator.ReleaseCompletedFrames(1UL);
+		CHECK(allocator.GetUsedSize() == 1024UL);
+		allocator.ReleaseCompletedFrames(2UL);
+		CHECK(allocator.GetUsedSize() == 0UL);
+	}
+
+	// Allocations are contiguous. When an allocation does not fit at the end of the ring, the bytes
+	// up to the end are wasted until its frame is released, and it is placed at the beginning.
+	void TestWrapAround() {
+		RingBufferAllocator allocator(4096UL);
+		CHECK(allocator.Allocate(3072UL) == 0UL);
+		allocator.FinishFrame(1UL);
+		allocator.ReleaseCompletedFrames(1UL);
+
+		CHECK(allocator.Allocate(512UL) == 3072UL);
+		CHECK(allocator.Allocate(1024UL) == 0UL);
+		CHECK(allocator.GetUsedSize() == 2048UL);
+		allocator.FinishFrame(2UL);
+		allocator.ReleaseCompletedFrames(2UL);
+		CHECK(allocator.GetUsedSize() == 0UL);
+	}
+
+	// Allocations that do not fit in the free memory fail without claiming memory,
+	// and they succeed when the frames that use it are released
+	void TestFullRingFails() {
+		RingBufferAllocator allocator(4096UL);
+		CHECK(allocator.Allocate(2048UL) == 0UL);
+		allocator.FinishFrame(1UL);
+		CHECK(allocator.Allocate(1536UL) == 2048UL);
+		allocator.FinishFrame(2UL);
+
+		CHECK(allocator.Allocate(1024UL) == RingBufferAllocator::sInvalidOffset);
+		CHECK(allocator.GetUsedSize() == 3584UL);
+		CHECK(allocator.Allocate(512UL) == 3584UL);
+		CHECK(allocator.Allocate(1UL) == RingBufferAllocator::sInvalidOffset);
+		CHECK(allocator.GetUsedSize() == 4096UL);
+		allocator.FinishFrame(3UL);
+
+		// It does not fit at the end of the ring, nor at the beginning while frame 1 is in flight
+		allocator.ReleaseCompletedFrames(0UL);
+		CHECK(allocator.Allocate(256UL) == RingBufferAllocator::sInvalidOffset);
+		allocator.ReleaseCompletedFrames(1UL);
+		CHECK(allocator.Allocate(2048UL) == 0UL);
+		CHECK(allocator.Allocate(256UL) == RingBufferAllocator::sInvalidOffset);
+		allocator.FinishFrame(4UL);
+
+		allocator.ReleaseCompletedFrames(4UL);
+		CHECK(allocator.GetUsedSize() == 0UL);
+		CHECK(allocator.Allocate(2048UL) == 2048UL);
+	}
+
+	// Threads allocate at the same time and fill their allocations with their own tag. Allocations
+	// of a frame must not overlap, and memory of frames in flight must not be reused.
+	void TestMultithreadedStress() {
+		// About 120 KB are allocated per frame
+		const std::size_t capacity{ 512UL * 1024UL };
+		const std::uint32_t threadCount{ 8U };
+		const std::uint32_t allocationCountPerThread{ 16U };
+		const std::uint32_t frameCount{ 500U };
+		const std::uint64_t framesInFlightCount{ 3UL };
+
+		RingBufferAllocator allocator(capacity);
+		std::vector<std::uint8_t> memory(capacity);
+
+		struct Allocation {
+			std::size_t mOffset{ 0UL };
+			std::size_t mSize{ 0UL };
+			std::uint8_t mTag{ 0U };
+		};
+		std::vector<std::vector<Allocation>> frameAllocations(frameCount);
+
+		std::uint32_t corruptedAllocationCount{ 0U };
+		std::atomic<std::uint32_t> invalidOffsetCount{ 0U };
+		for (std::uint32_t frame = 0U; frame < frameCount; ++frame) {
+			std::vector<std::vector<Allocation>> threadAllocations(threadCount);
+			std::vector<std::thread> threads;
+			for (std::uint32_t threadIndex = 0U; threadIndex < threadCount; ++threadIndex) {
+				threads.emplace_back([&, threadIndex]() {
+					for (std::uint32_t i = 0U; i < allocationCountPerThread; ++i) {
+						Allocation allocation;
+						allocation.mSize = 1UL + (threadIndex * 977U + i * 131U + frame * 13U) % 1500U;
+						allocation.mOffset = allocator.Allocate(allocation.mSize);
+						allocation.mTag = static_cast<std::uint8_t>(frame * threadCount + threadIndex);
+						if (allocation.mOffset % RingBufferAllocator::sAlignment != 0UL ||
+							allocation.mOffset + allocation.mSize > capacity)
+						{
+							++invalidOffsetCount;
+							continue;
+						}
+
+						std::memset(memory.data() + allocation.mOffset, allocation.mTag, allocation.mSize);
+						threadAllocations[threadIndex].push_back(allocation);
+					}
+				});
+			}
+			for (std::thread& thread : threads) {
+				thread.join();
+			}
+
+			for (const std::vector<Allocation>& allocations : threadAllocations) {
+				frameAllocations[frame].insert(frameAllocations[frame].end(), allocations.begin(), allocations.end());
+			}
+
+			allocator.FinishFrame(frame + 1UL);
+
+			// Memory of the frames in flight (including this one) must be intact
+			const std::uint32_t firstFrameInFlight{ frame + 1U > framesInFlightCount ? frame + 1U - static_cast<std::uint32_t>(framesInFlightCount) : 0U };
+			for (std::uint32_t frameInFlight = firstFrameInFlight; frameInFlight <= frame; ++frameInFlight) {
+				for (const Allocation& allocation : frameAllocations[frameInFlight]) {
+					for (std::size_t i = 0UL; i < allocation.mSize; ++i) {
+						if (memory[allocation.mOffset + i] != allocation.mTag) {
+							++corruptedAllocationCount;
+							break;
+						}
+					}
+				}
+			}
+
+			// The GPU completes frames with some latency
+			if (frame + 1UL > framesInFlightCount - 1UL) {
+				allocator.ReleaseCompletedFrames(frame + 1UL - (framesInFlightCount - 1UL));
+			}
+		}
+
+		CHECK(invalidOffsetCount == 0U);
+		CHECK(corruptedAllocationCount == 0U);
+
+		allocator.ReleaseCompletedFrames(frameCount);
+		CHECK(allocator.GetUsedSize() == 0UL);
+	}
+}
+
+int main() {
+	RUN_TEST(TestAlignedSize);
+	RUN_TEST(TestAllocateAndRelease);
+	RUN_TEST(TestWrapAround);
+	RUN_TEST(TestFullRingFails);
+	RUN_TEST(TestMultithreadedStress);
+
+	return static_cast<int>(TestUtils::GetFailureCount());
+}
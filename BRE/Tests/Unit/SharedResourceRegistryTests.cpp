@@ -0,0 +1,112 @@
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <ResourceManager/SharedResourceRegistry.h>
+#include <TestUtils.h>
+
+namespace {
+	using Registry = SharedResourceRegistry<std::uint32_t>;
+
+	void TestAcquireRegisterAndRelease() {
+		Registry registry;
+		std::uint32_t resource{ 0U };
+		CHECK(registry.Acquire(1UL, resource) == false);
+
+		resource = 5U;
+		CHECK(registry.Register(1UL, resource));
+		std::uint32_t acquiredResource{ 0U };
+		CHECK(registry.Acquire(1UL, acquiredResource) && acquiredResource == 5U);
+
+		// A second registration (a thread that lost the race) gets the registered resource
+		std::uint32_t otherResource{ 7U };
+		CHECK(registry.Register(1UL, otherResource) == false);
+		CHECK(otherResource == 5U);
+
+		Registry::Statistics statistics{ registry.GetStatistics() };
+		CHECK(statistics.mHitCount == 1UL);
+		CHECK(statistics.mMissCount == 1UL);
+		CHECK(statistics.mResourceCount == 1U);
+		CHECK(statistics.mReferenceCount == 3U);
+
+		std::uint32_t releasedResource{ 0U };
+		CHECK(registry.Release(1UL, releasedResource) == 2U);
+		CHECK(registry.Release(1UL, releasedResource) == 1U);
+		CHECK(registry.Release(1UL, releasedResource) == 0U);
+		CHECK(releasedResource == 5U);
+
+		statistics = registry.GetStatistics();
+		CHECK(statistics.mResourceCount == 0U);
+		CHECK(statistics.mReferenceCount == 0U);
+		CHECK(registry.Acquire(1UL, resource) == false);
+	}
+
+	void TestClearKeepsCounters() {
+		Registry registry;
+		std::uint32_t resource{ 1U };
+		registry.Register(1UL, resource);
+		registry.Acquire(1UL, resource);
+		registry.Clear();
+
+		const Registry::Statistics statistics{ registry.GetStatistics() };
+		CHECK(statistics.mHitCount == 1UL);
+		CHECK(statistics.mResourceCount == 0U);
+		CHECK(statistics.mReferenceCount == 0U);
+		CHECK(registry.Acquire(1UL, resource) == false);
+	}
+
+	// Threads acquire or create the same resources. Every thread gets the registered
+	// resource, and releasing all the references unregisters all of them.
+	void TestConcurrentAcquireOrCreate() {
+		const std::uint32_t threadCount{ 8U };
+		const std::uint32_t resourceCount{ 1000U };
+		Registry registry;
+		std::atomic<std::uint32_t> wrongResourceCount{ 0U };
+		std::atomic<std::uint32_t> lostRaceCount{ 0U };
+		std::vector<std::thread> threads;
+		for (std::uint32_t i = 0U; i < threadCount; ++i) {
+			threads.emplace_back([&registry, &wrongResourceCount, &lostRaceCount]() {
+				for (std::uint32_t j = 0U; j < resourceCount; ++j) {
+					std::uint32_t resource{ 0U };
+					if (registry.Acquire(j, resource) == false) {
+						resource = j;
+						if (registry.Register(j, resource) == false) {
+							++lostRaceCount;
+						}
+					}
+					if (resource != j) {
+						++wrongResourceCount;
+					}
+				}
+			});
+		}
+		for (std::thread& thread : threads) {
+			thread.join();
+		}
+		CHECK(wrongResourceCount == 0U);
+
+		Registry::Statistics statistics{ registry.GetStatistics() };
+		CHECK(statistics.mResourceCount == resourceCount);
+		CHECK(statistics.mReferenceCount == threadCount * resourceCount);
+		CHECK(statistics.mMissCount == resourceCount + lostRaceCount);
+
+		for (std::uint32_t j = 0U; j < resourceCount; ++j) {
+			std::uint32_t resource{ 0U };
+			for (std::uint32_t i = 0U; i < threadCount; ++i) {
+				CHECK(registry.Release(j, resource) == threadCount - i - 1U);
+			}
+		}
+		statistics = registry.GetStatistics();
+		CHECK(statistics.mResourceCount == 0U);
+		CHECK(statistics.mReferenceCount == 0U);
+	}
+}
+
+int main() {
+	RUN_TEST(TestAcquireRegisterAndRelease);
+	RUN_TEST(TestClearKeepsCounters);
+	RUN_TEST(TestConcurrentAcquireOrCreate);
+
+	return static_cast<int>(TestUtils::GetFailureCount());
+}
@@ -0,0 +1,156 @@
+#include <cstdint>
+#include <deque>
+#include <random>
+#include <vector>
+
+#include <ResourceManager/StagingRingAllocator.h>
+#include <TestUtils.h>
+
+namespace {
+	void TestAllocateAndRelease() {
+		StagingRingAllocator allocator(4096UL);
+		CHECK(allocator.GetCapacity() == 4096UL);
+
+		CHECK(allocator.Allocate(100UL, 16UL) == 0UL);
+		CHECK(allocator.Allocate(300UL, 512UL) == 512UL);
+		CHECK(allocator.GetUsedSize() == 812UL);
+		CHECK(allocator.GetOpenBatchSize() == 812UL);
+		allocator.CloseBatch(1UL);
+		CHECK(allocator.GetOpenBatchSize() == 0UL);
+
+		CHECK(allocator.Allocate(1024UL, 1024UL) == 1024UL);
+		allocator.CloseBatch(2UL);
+		CHECK(allocator.GetPendingBatchCount() == 2U);
+		CHECK(allocator.GetOldestBatchFenceValue() == 1UL);
+
+		// Batches are released in order, when their fence value is completed
+		allocator.ReleaseCompletedBatches(0UL);
+		CHECK(allocator.GetUsedSize() == 2048UL);
+		allocator.ReleaseCompletedBatches(1UL);
+		CHECK(allocator.GetUsedSize() == 1236UL);
+		CHECK(allocator.GetOldestBatchFenceValue() == 2UL);
+		allocator.ReleaseCompletedBatches(2UL);
+		CHECK(allocator.GetUsedSize() == 0UL);
+		CHECK(allocator.GetPendingBatchCount() == 0U);
+	}
+
+	// When an allocation does not fit before the end of the ring, the bytes up to the end 
+	// are wasted until its batch is released, and it is placed at the beginning.
+	// It fails while the GPU can still read the memory it needs.
+	void TestWrapAround() {
+		StagingRingAllocator allocator(1024UL);
+		CHECK(allocator.Allocate(600UL, 256UL) == 0UL);
+		allocator.CloseBatch(1UL);
+
+		CHECK(allocator.Allocate(200UL, 256UL) == 768UL);
+		CHECK(allocator.Allocate(500UL, 256UL) == StagingRingAllocator::sInvalidOffset);
+		allocator.CloseBatch(2UL);
+
+		allocator.ReleaseCompletedBatches(1UL);
+		CHECK(allocator.Allocate(500UL, 256UL) == 0UL);
+		// Second batch (with its alignment padding), wasted bytes at the end, and the new allocation
+		CHECK(allocator.GetUsedSize() == 368UL + 56UL + 500UL);
+		allocator.CloseBatch(3UL);
+		allocator.ReleaseCompletedBatches(3UL);
+		CHECK(allocator.GetUsedSize() == 0UL);
+
+		// An empty ring starts at the beginning, so the whole capacity can be allocated
+		CHECK(allocator.Allocate(1024UL, 256UL) == 0UL);
+	}
+
+	// Random uploads with a simulated GPU that completes batches in order. Allocations must
+	// be aligned, must not overlap the memory of batches the GPU did not complete, and 
+	// they must succeed after waiting for the oldest batch (like TransferManager).
+	void TestRandomUploads() {
+		struct Allocation {
+			std::uint64_t mOffset{ 0UL };
+			std::uint64_t mSize{ 0UL };
+			std::uint64_t mFenceValue{ 0UL };
+		};
+
+		const std::uint64_t capacity{ 1024UL * 1024UL };
+		StagingRingAllocator allocator(capacity);
+		std::vector<Allocation> liveAllocations;
+		std::deque<std::uint64_t> submittedFenceValues;
+		std::uint64_t lastFenceValue{ 0UL };
+		std::uint64_t completedFenceValue{ 0UL };
+
+		const auto closeBatch = [&]() {
+			allocator.CloseBatch(++lastFenceValue);
+			submittedFenceValues.push_back(lastFenceValue);
+			for (Allocation& allocation : liveAllocations) {
+				if (allocation.mFenceValue == 0UL) {
+					allocation.mFenceValue = lastFenceValue;
+				}
+			}
+		};
+		const auto completeBatches = [&](const std::uint64_t fenceValue) {
+			while (submittedFenceValues.empty() == false && submittedFenceValues.front() <= fenceValue) {
+				completedFenceValue = submittedFenceValues.front();
+				submittedFenceValues.pop_front();
+			}
+			allocator.ReleaseCompletedBatches(completedFenceValue);
+
+			std::vector<Allocation> pendingAllocations;
+			for (const Allocation& allocation : liveAllocations) {
+				if (allocation.mFenceValue == 0UL || allocation.mFenceValue > completedFenceValue) {
+					pendingAllocations.push_back(allocation);
+				}
+			}
+			liveAllocations.swap(pendingAllocations);
+		};
+
+		std::mt19937_64 generator(3U);
+		std::uint32_t waitCount{ 0U };
+		bool isValid{ true };
+		for (std::uint32_t i = 0U; i < 200000U; ++i) {
+			const std::uint32_t operation{ static_cast<std::uint32_t>(generator() % 10U) };
+			if (operation < 7U) {
+				const std::uint64_t maxSize{ generator() % 8U == 0U ? capacity / 2UL : 4096UL };
+				const std::uint64_t size{ 1UL + generator() % maxSize };
+				const std::uint64_t alignment{ 1UL << (generator() % 10U) };
+				std::uint64_t offset{ allocator.Allocate(size, alignment) };
+				while (offset == StagingRingAllocator::sInvalidOffset) {
+					if (allocator.GetOpenBatchSize() > 0UL) {
+						closeBatch();
+					}
+					isValid &= allocator.GetPendingBatchCount() > 0U;
+					completeBatches(allocator.GetOldestBatchFenceValue());
+					++waitCount;
+					offset = allocator.Allocate(size, alignment);
+				}
+
+				isValid &= offset % alignment == 0UL && offset + size <= capacity;
+				for (const Allocation& allocation : liveAllocations) {
+					isValid &= offset + size <= allocation.mOffset || allocation.mOffset + allocation.mSize <= offset;
+				}
+				isValid &= allocator.GetUsedSize() <= capacity;
+				liveAllocations.push_back(Allocation{ offset, size, 0UL });
+			} else if (operation < 9U) {
+				closeBatch();
+				isValid &= allocator.GetOpenBatchSize() == 0UL;
+			} else {
+				// The GPU completes up to 2 batches
+				const std::size_t completedBatchCount{ static_cast<std::size_t>(generator() % 3U) };
+				if (completedBatchCount > 0UL && submittedFenceValues.size() >= completedBatchCount) {
+					completeBatches(submittedFenceValues[completedBatchCount - 1UL]);
+				}
+			}
+		}
+		CHECK(isValid);
+		CHECK(waitCount > 0U);
+
+		closeBatch();
+		completeBatches(lastFenceValue);
+		CHECK(allocator.GetUsedSize() == 0UL);
+		CHECK(allocator.GetPendingBatchCount() == 0U);
+	}
+}
+
+int main() {
+	RUN_TEST(TestAllocateAndRelease);
+	RUN_TEST(TestWrapAround);
+	RUN_TEST(TestRandomUploads);
+
+	return static_cast<int>(TestUtils::GetFailureCount());
+}
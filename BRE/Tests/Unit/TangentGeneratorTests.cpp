@@ -0,0 +1,148 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <tbb/task_arena.h>
+#include <vector>
+
+#include <MeshTestUtils.h>
+#include <ModelManager/TangentGenerator.h>
+#include <TestUtils.h>
+
+namespace {
+	float Dot(const DirectX::XMFLOAT3& vector1, const DirectX::XMFLOAT3& vector2) {
+		return vector1.x * vector2.x + vector1.y * vector2.y + vector1.z * vector2.z;
+	}
+
+	// Tangents must be unit vectors perpendicular to the normals
+	bool AreTangentsOrthonormal(const GeometryGenerator::MeshData& meshData) {
+		for (const GeometryGenerator::Vertex& vertex : meshData.mVertices) {
+			if (std::abs(Dot(vertex.mTangent, vertex.mNormal)) > 1.0e-5f ||
+				std::abs(std::sqrt(Dot(vertex.mTangent, vertex.mTangent)) - 1.0f) > 1.0e-5f) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	// Tangents of a sphere are the analytic direction of increasing longitude,
+	// except at the poles and the seam, where they only see one side
+	void TestSphereMatchesAnalyticTangents() {
+		GeometryGenerator::MeshData meshData;
+		MeshTestUtils::CreateSphere(64U, 32U, meshData);
+		TangentGenerator::Workspace workspace;
+		TangentGenerator::ComputeTangents(meshData, workspace);
+		CHECK(AreTangentsOrthonormal(meshData));
+
+		double maxAngle{ 0.0 };
+		for (const GeometryGenerator::Vertex& vertex : meshData.mVertices) {
+			if (std::abs(vertex.mPosition.z) > 0.99f || vertex.mUV.x == 0.0f || vertex.mUV.x == 1.0f) {
+				continue;
+			}
+
+			const float longitude{ std::atan2(vertex.mPosition.y, vertex.mPosition.x) };
+			const DirectX::XMFLOAT3 expectedTangent(-std::sin(longitude), std::cos(longitude), 0.0f);
+			maxAngle = std::max<double>(maxAngle, MeshTestUtils::GetAngle(vertex.mTangent, expectedTangent));
+		}
+		CHECK(maxAngle < 0.5);
+	}
+
+	// A plane with rotated and mirrored texture coordinates has the same tangent everywhere
+	void TestPlaneWithRotatedMirroredUVs() {
+		const std::uint32_t cellCount{ 20U };
+		const float cosine{ std::cos(0.3f) };
+		const float sine{ std::sin(0.3f) };
+		GeometryGenerator::MeshData meshData;
+		MeshTestUtils::CreateGrid(cellCount, cellCount, meshData);
+		for (GeometryGenerator::Vertex& vertex : meshData.mVertices) {
+			const float x{ vertex.mPosition.x };
+			const float z{ vertex.mPosition.z };
+			vertex.mUV = DirectX::XMFLOAT2(-(cosine * x + sine * z) * 0.1f, (-sine * x + cosine * z) * 0.1f);
+		}
+
+		TangentGenerator::Workspace workspace;
+		TangentGenerator::ComputeTangents(meshData, workspace);
+		const DirectX::XMFLOAT3 expectedTangent(-cosine, 0.0f, -sine);
+		double maxAngle{ 0.0 };
+		for (const GeometryGenerator::Vertex& vertex : meshData.mVertices) {
+			maxAngle = std::max<double>(maxAngle, MeshTestUtils::GetAngle(vertex.mTangent, expectedTangent));
+		}
+		CHECK(maxAngle < 0.01);
+	}
+
+	// Without a texture coordinates mapping, tangents are any vector perpendicular to the normal
+	void TestMeshWithoutUVs() {
+		GeometryGenerator::MeshData meshData;
+		MeshTestUtils::CreateSphere(16U, 8U, meshData);
+		for (GeometryGenerator::Vertex& vertex : meshData.mVertices) {
+			vertex.mUV = DirectX::XMFLOAT2(0.0f, 0.0f);
+		}
+
+		TangentGenerator::Workspace workspace;
+		TangentGenerator::ComputeTangents(meshData, workspace);
+		CHECK(AreTangentsOrthonormal(meshData));
+	}
+
+	// Models without normals (like floor.obj) are skipped
+	void TestModelTangentsAreOrthonormal() {
+		TangentGenerator::Workspace workspace;
+		for (const std::string& modelFilePath : MeshTestUtils::GetModelFilePaths()) {
+			GeometryGenerator::MeshData meshData;
+			CHECK(MeshTestUtils::ReadObjFile(modelFilePath, meshData));
+			bool hasNormals{ true };
+			for (GeometryGenerator::Vertex& vertex : meshData.mVertices) {
+				const float length{ std::sqrt(Dot(vertex.mNormal, vertex.mNormal)) };
+				hasNormals &= length > 0.0f;
+				vertex.mNormal = DirectX::XMFLOAT3(vertex.mNormal.x / length, vertex.mNormal.y / length, vertex.mNormal.z / length);
+			}
+			if (hasNormals == false) {
+				continue;
+			}
+
+			TangentGenerator::ComputeTangents(meshData, workspace);
+			CHECK(AreTangentsOrthonormal(meshData));
+		}
+	}
+
+	// Results are the same with one thread and with all of them, and a reused
+	// workspace is not reallocated
+	void TestResultsDoNotDependOnThreadCount() {
+		GeometryGenerator::MeshData sourceMeshData;
+		MeshTestUtils::CreateSphere(512U, 256U, sourceMeshData);
+		GeometryGenerator::MeshData serialMeshData{ sourceMeshData };
+		GeometryGenerator::MeshData parallelMeshData{ sourceMeshData };
+
+		TangentGenerator::Workspace serialWorkspace;
+		tbb::task_arena singleThreadArena(1);
+		singleThreadArena.execute([&serialMeshData, &serialWorkspace]() {
+			TangentGenerator::ComputeTangents(serialMeshData, serialWorkspace);
+		});
+
+		TangentGenerator::Workspace workspace;
+		TangentGenerator::ComputeTangents(parallelMeshData, workspace);
+		const DirectX::XMFLOAT3* cornerTangents{ workspace.mCornerTangents.data() };
+		GeometryGenerator::MeshData reusedWorkspaceMeshData{ sourceMeshData };
+		TangentGenerator::ComputeTangents(reusedWorkspaceMeshData, workspace);
+		CHECK(workspace.mCornerTangents.data() == cornerTangents);
+
+		bool areEqual{ true };
+		for (std::size_t i = 0UL; i < sourceMeshData.mVertices.size(); ++i) {
+			const DirectX::XMFLOAT3& tangent{ serialMeshData.mVertices[i].mTangent };
+			areEqual &= std::memcmp(&tangent, &parallelMeshData.mVertices[i].mTangent, sizeof(tangent)) == 0;
+			areEqual &= std::memcmp(&tangent, &reusedWorkspaceMeshData.mVertices[i].mTangent, sizeof(tangent)) == 0;
+		}
+		CHECK(areEqual);
+	}
+}
+
+int main() {
+	RUN_TEST(TestSphereMatchesAnalyticTangents);
+	RUN_TEST(TestPlaneWithRotatedMirroredUVs);
+	RUN_TEST(TestMeshWithoutUVs);
+	RUN_TEST(TestModelTangentsAreOrthonormal);
+	RUN_TEST(TestResultsDoNotDependOnThreadCount);
+
+	return static_cast<int>(TestUtils::GetFailureCount());
+}
@@ -0,0 +1,311 @@
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <ResourceManager/TextureStreamingScheduler.h>
+#include <TestUtils.h>
+
+namespace {
+	// Sizes of the mips of a 1024 x 1024 RGBA8 texture (11 mips)
+	std::vector<std::uint64_t> GetMipSizes() {
+		std::vector<std::uint64_t> mipSizes;
+		for (std::uint64_t dimension = 1024UL; dimension > 0UL; dimension /= 2UL) {
+			mipSizes.push_back(dimension * dimension * 4UL);
+		}
+
+		return mipSizes;
+	}
+
+	void TestComputeRequiredMip() {
+		const std::uint32_t mipCount{ static_cast<std::uint32_t>(GetMipSizes().size()) };
+		CHECK(TextureStreamingScheduler::ComputeRequiredMip(1024U, 1024U, mipCount, 1024.0f * 1024.0f) == 0U);
+		CHECK(TextureStreamingScheduler::ComputeRequiredMip(1024U, 1024U, mipCount, 512.0f * 512.0f) == 1U);
+		CHECK(TextureStreamingScheduler::ComputeRequiredMip(1024U, 1024U, mipCount, 300.0f * 300.0f) == 1U);
+		CHECK(TextureStreamingScheduler::ComputeRequiredMip(1024U, 1024U, mipCount, 1.0f) == 10U);
+		CHECK(TextureStreamingScheduler::ComputeRequiredMip(1024U, 1024U, mipCount, 1.0e30f) == 0U);
+
+		// Not visible textures only need the coarsest mip
+		CHECK(TextureStreamingScheduler::ComputeRequiredMip(1024U, 1024U, mipCount, 0.0f) == mipCount - 1U);
+
+		// The mip is clamped to the mip count
+		CHECK(TextureStreamingScheduler::ComputeRequiredMip(1024U, 1024U, 4U, 1.0f) == 3U);
+	}
+
+	void TestPinnedMipsAreResident() {
+		const std::vector<std::uint64_t> mipSizes{ GetMipSizes() };
+		const std::uint32_t mipCount{ static_cast<std::uint32_t>(mipSizes.size()) };
+		TextureStreamingScheduler scheduler(0UL, 1UL);
+		CHECK(scheduler.AddTexture(mipSizes.data(), mipCount, 4U) == 0U);
+		CHECK(scheduler.AddTexture(mipSizes.data(), mipCount, mipCount) == 1U);
+		CHECK(scheduler.GetTextureCount() == 2U);
+		CHECK(scheduler.GetFirstResidentMip(0U) == mipCount - 4U);
+		CHECK(scheduler.GetFirstResidentMip(1U) == 0U);
+
+		std::uint64_t residentSize{ 0UL };
+		for (std::uint32_t i = 0U; i < mipCount; ++i) {
+			residentSize += mipSizes[i] + (i >= mipCount - 4U ? mipSizes[i] : 0UL);
+		}
+		CHECK(scheduler.GetResidentSize() == residentSize);
+
+		// Pinned mips are never evicted, even if they do not fit in the budget
+		std::vector<TextureStreamingScheduler::Change> changes;
+		scheduler.RequestMip(0U, 0U, 1.0f);
+		scheduler.ScheduleChanges(1UL, changes);
+		CHECK(changes.empty());
+		CHECK(scheduler.GetResidentSize() == residentSize);
+	}
+
+	void TestRequestedMipsAreLoaded() {
+		const std::vector<std::uint64_t> mipSizes{ GetMipSizes() };
+		const std::uint32_t mipCount{ static_cast<std::uint32_t>(mipSizes.size()) };
+		TextureStreamingScheduler scheduler(64UL * 1024UL * 1024UL, 64UL * 1024UL * 1024UL);
+		scheduler.AddTexture(mipSizes.data(), mipCount, 4U);
+
+		// The finest requested mip is kept
+		std::vector<TextureStreamingScheduler::Change> changes;
+		scheduler.RequestMip(0U, 3U, 1.0f);
+		scheduler.RequestMip(0U, 1U, 1.0f);
+		scheduler.RequestMip(0U, 2U, 1.0f);
+		scheduler.ScheduleChanges(1UL, changes);
+		CHECK(changes.size() == 1UL);
+		CHECK(changes[0U].mTextureId == 0U);
+		CHECK(changes[0U].mPreviousFirstResidentMip == mipCount - 4U);
+		CHECK(changes[0U].mFirstResidentMip == 1U);
+
+		// Resident mips do not change if they are not needed and they fit in the budget
+		changes.clear();
+		scheduler.ScheduleChanges(2UL, changes);
+		CHECK(changes.empty());
+		CHECK(scheduler.GetFirstResidentMip(0U) == 1U);
+	}
+
+	// Loads are limited per call, textures with greater priority load first, 
+	// and mips are loaded from the coarsest one
+	void TestMaxLoadSizeAndPriority() {
+		const std::vector<std::uint64_t> mipSizes{ GetMipSizes() };
+		const std::uint32_t mipCount{ static_cast<std::uint32_t>(mipSizes.size()) };
+		TextureStreamingScheduler scheduler(64UL * 1024UL * 1024UL, mipSizes[1U] + mipSizes[2U] + mipSizes[3U]);
+		scheduler.AddTexture(mipSizes.data(), mipCount, mipCount - 4U);
+		scheduler.AddTexture(mipSizes.data(), mipCount, mipCount - 4U);
+
+		std::vector<TextureStreamingScheduler::Change> changes;
+		scheduler.RequestMip(0U, 0U, 1.0f);
+		scheduler.RequestMip(1U, 0U, 2.0f);
+		scheduler.ScheduleChanges(1UL, changes);
+		CHECK(scheduler.GetFirstResidentMip(0U) == 4U);
+		CHECK(scheduler.GetFirstResidentMip(1U) == 1U);
+
+		changes.clear();
+		scheduler.RequestMip(0U, 0U, 1.0f);
+		scheduler.RequestMip(1U, 0U, 2.0f);
+		scheduler.ScheduleChanges(2UL, changes);
+		CHECK(scheduler.GetFirstResidentMip(0U) == 4U);
+		CHECK(scheduler.GetFirstResidentMip(1U) == 0U);
+
+		// Mip 0 is larger than the maximum load size, so it was loaded alone
+		changes.clear();
+		scheduler.RequestMip(0U, 0U, 1.0f);
+		scheduler.RequestMip(1U, 0U, 2.0f);
+		scheduler.ScheduleChanges(3UL, changes);
+		CHECK(scheduler.GetFirstResidentMip(0U) == 1U);
+		CHECK(changes.size() == 1UL);
+	}
+
+	// Mips needed in the current frame are not evicted to load others, 
+	// and the least recently needed mips are evicted first
+	void TestLeastRecentlyNeededMipsAreEvicted() {
+		const std::vector<std::uint64_t> mipSizes{ GetMipSizes() };
+		const std::uint32_t mipCount{ static_cast<std::uint32_t>(mipSizes.size()) };
+		std::uint64_t pinnedSize{ 0UL };
+		for (std::uint32_t i = 4U; i < mipCount; ++i) {
+			pinnedSize += mipSizes[i];
+		}
+
+		// Mips 1 to 3 of a texture fit in the budget
+		TextureStreamingScheduler scheduler(mipSizes[1U] + mipSizes[2U] + mipSizes[3U] + pinnedSize * 2UL, 1024UL * 1024UL * 1024UL);
+		scheduler.AddTexture(mipSizes.data(), mipCount, mipCount - 4U);
+		scheduler.AddTexture(mipSizes.data(), mipCount, mipCount - 4U);
+
+		std::vector<TextureStreamingScheduler::Change> changes;
+		scheduler.RequestMip(0U, 1U, 2.0f);
+		scheduler.RequestMip(1U, 1U, 1.0f);
+		scheduler.ScheduleChanges(1UL, changes);
+		CHECK(scheduler.GetFirstResidentMip(0U) == 1U);
+		CHECK(scheduler.GetFirstResidentMip(1U) == 4U);
+
+		// Texture 0 is not needed anymore, so its mips are evicted for texture 1
+		changes.clear();
+		scheduler.RequestMip(1U, 1U, 1.0f);
+		scheduler.ScheduleChanges(2UL, changes);
+		CHECK(scheduler.GetFirstResidentMip(1U) == 1U);
+		CHECK(scheduler.GetFirstResidentMip(0U) == 4U);
+		CHECK(changes.size() == 2UL);
+		CHECK(scheduler.GetResidentSize() <= scheduler.GetMemoryBudget());
+	}
+
+	// A reduced budget evicts mips in the next call, even if they are needed
+	void TestReducedBudget() {
+		const std::vector<std::uint64_t> mipSizes{ GetMipSizes() };
+		const std::uint32_t mipCount{ static_cast<std::uint32_t>(mipSizes.size()) };
+		TextureStreamingScheduler scheduler(64UL * 1024UL * 1024UL, 64UL * 1024UL * 1024UL);
+		scheduler.AddTexture(mipSizes.data(), mipCount, 4U);
+
+		std::vector<TextureStreamingScheduler::Change> changes;
+		scheduler.RequestMip(0U, 0U, 1.0f);
+		scheduler.ScheduleChanges(1UL, changes);
+		CHECK(scheduler.GetFirstResidentMip(0U) == 0U);
+
+		scheduler.SetMemoryBudget(mipSizes[2U] * 2UL);
+		CHECK(scheduler.GetMemoryBudget() == mipSizes[2U] * 2UL);
+		changes.clear();
+		scheduler.RequestMip(0U, 0U, 1.0f);
+		scheduler.ScheduleChanges(2UL, changes);
+		CHECK(scheduler.GetFirstResidentMip(0U) == 2U);
+		CHECK(scheduler.GetResidentSize() <= scheduler.GetMemoryBudget());
+	}
+
+	// Sizes of the mips of a "dimension" x "dimension" BC1 texture (8 bytes per 4 x 4 block)
+	std::vector<std::uint64_t> GetBlockCompressedMipSizes(const std::uint64_t dimension) {
+		std::vector<std::uint64_t> mipSizes;
+		for (std::uint64_t mipDimension = dimension; ; mipDimension /= 2UL) {
+			const std::uint64_t blockCount{ (mipDimension + 3UL) / 4UL };
+			mipSizes.push_back(blockCount * blockCount * 8UL);
+			if (mipDimension == 1UL) {
+				break;
+			}
+		}
+
+		return mipSizes;
+	}
+
+	void TestComputeAlignedMipMaskAndPinnedMipCount() {
+		// 1600, 800, 400, 200, 100, 50, 25, 12, 6, 3 and 1 texels wide mips
+		CHECK(TextureStreamingScheduler::ComputeAlignedMipMask(1600U, 1600U, 11U, 4U) == 0x9FU);
+		CHECK(TextureStreamingScheduler::ComputeAlignedMipMask(1600U, 1600U, 11U, 1U) == 0x7FFU);
+		CHECK(TextureStreamingScheduler::ComputeAlignedMipMask(1600U, 800U, 11U, 4U) == 0xFU);
+
+		// The mip tail starts at the first aligned mip that is not greater than the mip tail dimension
+		CHECK(TextureStreamingScheduler::ComputePinnedMipCount(1600U, 1600U, 11U, 64U, 0x9FU) == 4U);
+		CHECK(TextureStreamingScheduler::ComputePinnedMipCount(1600U, 1600U, 11U, 64U, 0x7FFU) == 6U);
+		CHECK(TextureStreamingScheduler::ComputePinnedMipCount(1024U, 1024U, 11U, 64U, TextureStreamingScheduler::sAllMipsMask) == 7U);
+
+		// 2032, 1016, 508, 254, 127, 63, ... texels wide mips: the coarsest aligned mip is larger than the mip tail
+		const std::uint32_t mipMask{ TextureStreamingScheduler::ComputeAlignedMipMask(2032U, 2032U, 11U, 4U) };
+		CHECK(mipMask == 0x7U);
+		CHECK(TextureStreamingScheduler::ComputePinnedMipCount(2032U, 2032U, 11U, 64U, mipMask) == 9U);
+
+		// Textures without aligned mips (1602 and 801 texels wide mips) are not streamed
+		CHECK(TextureStreamingScheduler::ComputeAlignedMipMask(1602U, 1602U, 2U, 4U) == 0U);
+		CHECK(TextureStreamingScheduler::ComputePinnedMipCount(1602U, 1602U, 2U, 64U, 0U) == 2U);
+	}
+
+	// First resident mips of a 1600 x 1600 BC1 texture must have whole blocks, so mips 5 and 6
+	// (50 and 25 texels wide) are loaded and evicted with the previous aligned mip
+	void TestBlockCompressedMipChain() {
+		const std::vector<std::uint64_t> mipSizes{ GetBlockCompressedMipSizes(1600UL) };
+		const std::uint32_t mipCount{ static_cast<std::uint32_t>(mipSizes.size()) };
+		CHECK(mipCount == 11U);
+		const std::uint32_t mipMask{ TextureStreamingScheduler::ComputeAlignedMipMask(1600U, 1600U, mipCount, 4U) };
+		const std::uint32_t pinnedMipCount{ TextureStreamingScheduler::ComputePinnedMipCount(1600U, 1600U, mipCount, 64U, mipMask) };
+		const auto isAligned = [mipMask](const std::uint32_t mip) { return ((mipMask >> mip) & 1U) != 0U; };
+
+		TextureStreamingScheduler scheduler(64UL * 1024UL * 1024UL, mipSizes[3U]);
+		scheduler.AddTexture(mipSizes.data(), mipCount, pinnedMipCount, mipMask);
+		CHECK(scheduler.GetFirstResidentMip(0U) == 7U);
+
+		// Mip 6 is requested, so mips 4 to 6 are loaded together
+		std::vector<TextureStreamingScheduler::Change> changes;
+		scheduler.RequestMip(0U, 6U, 1.0f);
+		scheduler.ScheduleChanges(1UL, changes);
+		CHECK(changes.size() == 1UL);
+		CHECK(scheduler.GetFirstResidentMip(0U) == 4U);
+
+		// Mips are loaded gradually, and each first resident mip is aligned
+		bool areAligned{ true };
+		for (std::uint64_t frameIndex = 2UL; frameIndex < 10UL; ++frameIndex) {
+			changes.clear();
+			scheduler.RequestMip(0U, 0U, 1.0f);
+			scheduler.ScheduleChanges(frameIndex, changes);
+			for (const TextureStreamingScheduler::Change& change : changes) {
+				areAligned &= isAligned(change.mFirstResidentMip);
+			}
+		}
+		CHECK(areAligned);
+		CHECK(scheduler.GetFirstResidentMip(0U) == 0U);
+
+		// Mips 4 to 6 do not fit in the reduced budget, so they are evicted together
+		std::uint64_t residentSize{ 0UL };
+		for (std::uint32_t i = 7U; i < mipCount; ++i) {
+			residentSize += mipSizes[i];
+		}
+		scheduler.SetMemoryBudget(residentSize + mipSizes[5U] + mipSizes[6U]);
+		changes.clear();
+		scheduler.ScheduleChanges(10UL, changes);
+		CHECK(scheduler.GetFirstResidentMip(0U) == 7U);
+		CHECK(scheduler.GetResidentSize() == residentSize);
+	}
+
+	// Random requests and budget changes. Changes must chain, and resident mips 
+	// must fit in the budget (or be pinned).
+	void TestRandomRequests() {
+		const std::vector<std::uint64_t> mipSizes{ GetMipSizes() };
+		const std::uint32_t mipCount{ static_cast<std::uint32_t>(mipSizes.size()) };
+		const std::uint32_t textureCount{ 40U };
+		TextureStreamingScheduler scheduler(8UL * 1024UL * 1024UL, 6UL * 1024UL * 1024UL);
+		for (std::uint32_t i = 0U; i < textureCount; ++i) {
+			scheduler.AddTexture(mipSizes.data(), mipCount, 4U);
+		}
+		const std::uint64_t pinnedSize{ scheduler.GetResidentSize() };
+
+		std::mt19937 generator(3U);
+		std::vector<std::uint32_t> firstResidentMips(textureCount, mipCount - 4U);
+		std::vector<TextureStreamingScheduler::Change> changes;
+		bool isValid{ true };
+		std::uint64_t changeCount{ 0UL };
+		for (std::uint64_t frameIndex = 1UL; frameIndex < 20000UL; ++frameIndex) {
+			for (std::uint32_t i = 0U; i < 5U; ++i) {
+				const std::uint32_t textureId{ static_cast<std::uint32_t>((frameIndex / 200UL * 7UL + i * 3UL) % textureCount) };
+				scheduler.RequestMip(textureId, generator() % 4U, static_cast<float>(generator() % 1000U));
+			}
+			if (frameIndex == 10000UL) {
+				scheduler.SetMemoryBudget(4UL * 1024UL * 1024UL);
+			}
+
+			changes.clear();
+			scheduler.ScheduleChanges(frameIndex, changes);
+			for (const TextureStreamingScheduler::Change& change : changes) {
+				isValid &= firstResidentMips[change.mTextureId] == change.mPreviousFirstResidentMip;
+				isValid &= change.mFirstResidentMip <= mipCount - 4U;
+				firstResidentMips[change.mTextureId] = change.mFirstResidentMip;
+			}
+			changeCount += changes.size();
+
+			std::uint64_t residentSize{ 0UL };
+			for (std::uint32_t i = 0U; i < textureCount; ++i) {
+				isValid &= firstResidentMips[i] == scheduler.GetFirstResidentMip(i);
+				for (std::uint32_t mip = firstResidentMips[i]; mip < mipCount; ++mip) {
+					residentSize += mipSizes[mip];
+				}
+			}
+			isValid &= residentSize == scheduler.GetResidentSize();
+			isValid &= residentSize <= std::max<std::uint64_t>(scheduler.GetMemoryBudget(), pinnedSize);
+		}
+		CHECK(isValid);
+		CHECK(changeCount > 0UL);
+	}
+}
+
+int main() {
+	RUN_TEST(TestComputeRequiredMip);
+	RUN_TEST(TestPinnedMipsAreResident);
+	RUN_TEST(TestRequestedMipsAreLoaded);
+	RUN_TEST(TestMaxLoadSizeAndPriority);
+	RUN_TEST(TestLeastRecentlyNeededMipsAreEvicted);
+	RUN_TEST(TestReducedBudget);
+	RUN_TEST(TestRandomRequests);
+	RUN_TEST(TestComputeAlignedMipMaskAndPinnedMipCount);
+	RUN_TEST(TestBlockCompressedMipChain);
+
+	return static_cast<int>(TestUtils::GetFailureCount());
+}
@@ -0,0 +1,167 @@
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <random>
+#include <vector>
+
+#include <ResourceManager/TlsfAllocator.h>
+#include <TestUtils.h>
+
+namespace {
+	const std::uint64_t sGranularity{ 64UL * 1024UL };
+
+	struct Allocation {
+		std::uint32_t mHandle;
+		std::uint64_t mOffset;
+		std::uint64_t mSize;
+	};
+
+	void TestPlacementAndMerge() {
+		TlsfAllocator allocator(64UL * sGranularity, sGranularity);
+		std::uint64_t offset{ 0UL };
+		const std::uint32_t handle1{ allocator.Allocate(1UL, sGranularity, offset) };
+		CHECK(offset == 0UL);
+		CHECK(allocator.GetUsedSize() == sGranularity);
+		const std::uint32_t handle2{ allocator.Allocate(3UL * sGranularity, sGranularity, offset) };
+		CHECK(offset == sGranularity);
+		const std::uint32_t handle3{ allocator.Allocate(4UL * sGranularity, 4UL * sGranularity, offset) };
+		CHECK(offset == 4UL * sGranularity);
+		CHECK(allocator.GetAllocationCount() == 3U);
+
+		allocator.Free(handle2);
+		const std::uint32_t handle4{ allocator.Allocate(2UL * sGranularity, sGranularity, offset) };
+		CHECK(offset == sGranularity);
+
+		allocator.Free(handle1);
+		allocator.Free(handle3);
+		allocator.Free(handle4);
+		TlsfAllocator::Statistics statistics{ allocator.GetStatistics() };
+		CHECK(statistics.mFreeBlockCount == 1U);
+		CHECK(statistics.mLargestFreeBlockSize == 64UL * sGranularity);
+		CHECK(statistics.mUsedSize == 0UL);
+		CHECK(statistics.mPeakUsedSize == 8UL * sGranularity);
+
+		CHECK(allocator.Allocate(65UL * sGranularity, sGranularity, offset) == TlsfAllocator::sInvalidHandle);
+		const std::uint32_t wholeHandle{ allocator.Allocate(64UL * sGranularity, sGranularity, offset) };
+		CHECK(wholeHandle != TlsfAllocator::sInvalidHandle && offset == 0UL);
+		CHECK(allocator.Allocate(1UL, sGranularity, offset) == TlsfAllocator::sInvalidHandle);
+		allocator.Free(wholeHandle);
+		CHECK(allocator.GetFragmentation() == 0.0f);
+	}
+
+	// Alignments larger than the granularity (like 4MB MSAA textures in 64KB heaps)
+	// leave a free block before the allocation, which is merged back when it is freed
+	void TestLargeAlignment() {
+		TlsfAllocator allocator(256UL * sGranularity, sGranularity);
+		std::uint64_t offset{ 0UL };
+		const std::uint32_t handle1{ allocator.Allocate(sGranularity, sGranularity, offset) };
+		const std::uint32_t handle2{ allocator.Allocate(sGranularity, 64UL * sGranularity, offset) };
+		CHECK(offset == 64UL * sGranularity);
+		CHECK(allocator.GetStatistics().mFreeBlockCount == 2U);
+
+		allocator.Free(handle1);
+		allocator.Free(handle2);
+		CHECK(allocator.GetStatistics().mFreeBlockCount == 1U);
+	}
+
+	// Randomized allocations and frees with mixed sizes and alignments: allocations never overlap,
+	// they are aligned, statistics match the live allocations, and freeing everything
+	// coalesces the heap into a single free block.
+	// Allocations can only fail if there is no free block of twice their size plus their
+	// alignment padding, because the searched size is rounded up to the next size class.
+	void TestRandomStress() {
+		const std::uint64_t capacity{ 4096UL * sGranularity };
+		TlsfAllocator allocator(capacity, sGranularity);
+		std::mt19937_64 generator(3UL);
+		std::vector<Allocation> allocations;
+		std::map<std::uint64_t, std::uint64_t> sizeByOffset;
+		std::uint64_t usedSize{ 0UL };
+		std::uint32_t overlapCount{ 0U };
+		std::uint32_t misalignedCount{ 0U };
+		std::uint32_t wronglyFailedAllocationCount{ 0U };
+		for (std::uint32_t i = 0U; i < 200000U; ++i) {
+			const bool allocates{ allocations.empty() || generator() % 100U < (usedSize < capacity * 3UL / 4UL ? 55U : 45U) };
+			if (allocates) {
+				// Mostly small buffers, some textures and a few large resources
+				const std::uint64_t sizeClass{ generator() % 100U };
+				std::uint64_t size{ 0UL };
+				if (sizeClass < 60U) {
+					size = generator() % (4UL * sGranularity) + 1UL;
+				} else if (sizeClass < 95U) {
+					size = sGranularity * (generator() % 64UL + 1UL);
+				} else {
+					size = sGranularity * (generator() % 512UL + 64UL);
+				}
+				const std::uint64_t alignment{ generator() % 10U == 0U ? 64UL * sGranularity : sGranularity };
+
+				std::uint64_t offset{ 0UL };
+				const std::uint32_t handle{ allocator.Allocate(size, alignment, offset) };
+				size = (size + sGranularity - 1UL) & ~(sGranularity - 1UL);
+				if (handle == TlsfAllocator::sInvalidHandle) {
+					const std::uint64_t largestFreeBlockSize{ allocator.GetStatistics().mLargestFreeBlockSize };
+					if (largestFreeBlockSize >= 2UL * (size + alignment - sGranularity)) {
+						++wronglyFailedAllocationCount;
+					}
+					continue;
+				}
+
+				misalignedCount += offset % alignment != 0UL ? 1U : 0U;
+				const std::map<std::uint64_t, std::uint64_t>::const_iterator next = sizeByOffset.lower_bound(offset);
+				if (next != sizeByOffset.end() && next->first < offset + size) {
+					++overlapCount;
+				}
+				if (next != sizeByOffset.begin() && std::prev(next)->first + std::prev(next)->second > offset) {
+					++overlapCount;
+				}
+				CHECK(offset + size <= capacity);
+
+				sizeByOffset[offset] = size;
+				allocations.push_back(Allocation{ handle, offset, size });
+				usedSize += size;
+			} else {
+				const std::size_t allocationIndex{ generator() % allocations.size() };
+				const Allocation allocation{ allocations[allocationIndex] };
+				allocations[allocationIndex] = allocations.back();
+				allocations.pop_back();
+				sizeByOffset.erase(allocation.mOffset);
+				allocator.Free(allocation.mHandle);
+				usedSize -= allocation.mSize;
+			}
+
+			// The largest free block matches the largest gap between live allocations
+			if (i % 10000U == 0U) {
+				std::uint64_t largestGap{ 0UL };
+				std::uint64_t previousEnd{ 0UL };
+				for (const std::pair<const std::uint64_t, std::uint64_t>& offsetAndSize : sizeByOffset) {
+					largestGap = std::max<std::uint64_t>(largestGap, offsetAndSize.first - previousEnd);
+					previousEnd = offsetAndSize.first + offsetAndSize.second;
+				}
+				largestGap = std::max<std::uint64_t>(largestGap, capacity - previousEnd);
+				CHECK(allocator.GetStatistics().mLargestFreeBlockSize == largestGap);
+			}
+		}
+		CHECK(overlapCount == 0U);
+		CHECK(misalignedCount == 0U);
+		CHECK(allocator.GetUsedSize() == usedSize);
+		CHECK(allocator.GetAllocationCount() == allocations.size());
+		CHECK(wronglyFailedAllocationCount == 0U);
+
+		for (const Allocation& allocation : allocations) {
+			allocator.Free(allocation.mHandle);
+		}
+		const TlsfAllocator::Statistics statistics{ allocator.GetStatistics() };
+		CHECK(statistics.mFreeBlockCount == 1U);
+		CHECK(statistics.mLargestFreeBlockSize == capacity);
+		CHECK(statistics.mUsedSize == 0UL);
+		CHECK(statistics.mAllocationCount == 0U);
+	}
+}
+
+int main() {
+	RUN_TEST(TestPlacementAndMerge);
+	RUN_TEST(TestLargeAlignment);
+	RUN_TEST(TestRandomStress);
+
+	return static_cast<int>(TestUtils::GetFailureCount());
+}
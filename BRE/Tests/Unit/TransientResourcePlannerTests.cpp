@@ -0,0 +1,170 @@
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <ResourceManager/TransientResourcePlanner.h>
+#include <TestUtils.h>
+
+using namespace TransientResourcePlanner;
+
+namespace {
+	const std::uint64_t sHeapAlignment{ 64UL * 1024UL };
+
+	ResourceRequest GetRequest(
+		const std::uint64_t size,
+		const std::uint64_t alignment,
+		const std::uint32_t firstUse,
+		const std::uint32_t lastUse) noexcept
+	{
+		ResourceRequest request;
+		request.mSize = size;
+		request.mAlignment = alignment;
+		request.mFirstUse = firstUse;
+		request.mLastUse = lastUse;
+		return request;
+	}
+
+	// Returns the number of placements that break a rule: resources with overlapping lifetimes
+	// that overlap in memory, misaligned offsets, or resources that do not fit in the heap
+	std::uint32_t GetInvalidPlacementCount(
+		const std::vector<ResourceRequest>& requests,
+		const std::vector<std::uint64_t>& heapOffsets,
+		const std::uint64_t heapSize) noexcept
+	{
+		std::uint32_t invalidPlacementCount{ 0U };
+		for (std::size_t i = 0UL; i < requests.size(); ++i) {
+			if (heapOffsets[i] % requests[i].mAlignment != 0UL || heapOffsets[i] + requests[i].mSize > heapSize) {
+				++invalidPlacementCount;
+			}
+
+			for (std::size_t j = i + 1UL; j < requests.size(); ++j) {
+				const bool isMemoryOverlapping{
+					heapOffsets[i] < heapOffsets[j] + requests[j].mSize &&
+					heapOffsets[j] < heapOffsets[i] + requests[i].mSize };
+				if (isMemoryOverlapping && AreLifetimesOverlapping(requests[i], requests[j])) {
+					++invalidPlacementCount;
+				}
+			}
+		}
+
+		return invalidPlacementCount;
+	}
+
+	void TestLifetimes() {
+		CHECK(AreLifetimesOverlapping(GetRequest(1UL, 1UL, 0U, 2U), GetRequest(1UL, 1UL, 2U, 4U)));
+		CHECK(AreLifetimesOverlapping(GetRequest(1UL, 1UL, 1U, 1U), GetRequest(1UL, 1UL, 0U, 4U)));
+		CHECK(AreLifetimesOverlapping(GetRequest(1UL, 1UL, 0U, 4U), GetRequest(1UL, 1UL, 1U, 1U)));
+		CHECK(AreLifetimesOverlapping(GetRequest(1UL, 1UL, 0U, 1U), GetRequest(1UL, 1UL, 2U, 4U)) == false);
+		CHECK(AreLifetimesOverlapping(GetRequest(1UL, 1UL, 3U, 4U), GetRequest(1UL, 1UL, 0U, 2U)) == false);
+	}
+
+	void TestDisjointLifetimesShareMemory() {
+		const std::vector<ResourceRequest> requests{
+			GetRequest(100UL * sHeapAlignment, sHeapAlignment, 0U, 0U),
+			GetRequest(100UL * sHeapAlignment, sHeapAlignment, 1U, 1U),
+			GetRequest(50UL * sHeapAlignment, sHeapAlignment, 2U, 3U),
+		};
+		std::vector<std::uint64_t> heapOffsets(requests.size());
+		const std::uint64_t heapSize{ PlanHeapOffsets(requests.data(), 3U, heapOffsets.data()) };
+
+		CHECK(heapSize == 100UL * sHeapAlignment);
+		CHECK(heapOffsets[0U] == 0UL && heapOffsets[1U] == 0UL && heapOffsets[2U] == 0UL);
+		CHECK(GetNonAliasedHeapSize(requests.data(), 3U) == 250UL * sHeapAlignment);
+	}
+
+	void TestOverlappingLifetimesDoNotShareMemory() {
+		const std::vector<ResourceRequest> requests{
+			GetRequest(10UL * sHeapAlignment, sHeapAlignment, 0U, 2U),
+			GetRequest(30UL * sHeapAlignment, sHeapAlignment, 1U, 3U),
+			GetRequest(20UL * sHeapAlignment, sHeapAlignment, 2U, 2U),
+		};
+		std::vector<std::uint64_t> heapOffsets(requests.size());
+		const std::uint64_t heapSize{ PlanHeapOffsets(requests.data(), 3U, heapOffsets.data()) };
+
+		CHECK(heapSize == 60UL * sHeapAlignment);
+		CHECK(GetInvalidPlacementCount(requests, heapOffsets, heapSize) == 0U);
+
+		// Bigger resources are placed first
+		CHECK(heapOffsets[1U] == 0UL);
+	}
+
+	void TestAlignment() {
+		const std::uint64_t bigAlignment{ 4UL * 1024UL * 1024UL };
+		const std::vector<ResourceRequest> requests{
+			GetRequest(sHeapAlignment, sHeapAlignment, 0U, 1U),
+			GetRequest(sHeapAlignment, bigAlignment, 0U, 1U),
+		};
+		std::vector<std::uint64_t> heapOffsets(requests.size());
+		const std::uint64_t heapSize{ PlanHeapOffsets(requests.data(), 2U, heapOffsets.data()) };
+
+		CHECK(GetInvalidPlacementCount(requests, heapOffsets, heapSize) == 0U);
+		CHECK(heapSize <= bigAlignment + sHeapAlignment);
+	}
+
+	// Render targets of RenderManager at 3840x2160, with their frame graph lifetimes
+	void TestRenderManagerResources() {
+		const std::uint64_t pixelCount{ 3840UL * 2160UL };
+		const std::vector<ResourceRequest> requests{
+			GetRequest(pixelCount * 8UL, sHeapAlignment, 0U, 1U), // Normal smoothness
+			GetRequest(pixelCount * 4UL, sHeapAlignment, 0U, 1U), // Base color metal mask
+			GetRequest(pixelCount * 4UL, sHeapAlignment, 0U, 2U), // Depth buffer
+			GetRequest(pixelCount * 8UL, sHeapAlignment, 1U, 3U), // Intermediate color buffer 1
+			GetRequest(pixelCount * 8UL, sHeapAlignment, 3U, 4U), // Intermediate color buffer 2
+			GetRequest(pixelCount * 2UL, sHeapAlignment, 1U, 1U), // Ambient accessibility buffer
+			GetRequest(pixelCount * 2UL, sHeapAlignment, 1U, 1U), // Blur buffer
+		};
+		std::vector<std::uint64_t> heapOffsets(requests.size());
+		const std::uint32_t requestCount{ static_cast<std::uint32_t>(requests.size()) };
+		const std::uint64_t heapSize{ PlanHeapOffsets(requests.data(), requestCount, heapOffsets.data()) };
+
+		CHECK(GetInvalidPlacementCount(requests, heapOffsets, heapSize) == 0U);
+		CHECK(heapSize < GetNonAliasedHeapSize(requests.data(), requestCount));
+	}
+
+	// Random requests must be placed without conflicts, and the heap size must be between
+	// the peak of live memory and the non aliased size
+	void TestRandomRequests() {
+		std::mt19937 generator(7U);
+		for (std::uint32_t iteration = 0U; iteration < 500U; ++iteration) {
+			const std::uint32_t requestCount{ 1U + static_cast<std::uint32_t>(generator() % 40U) };
+			const std::uint32_t positionCount{ 1U + static_cast<std::uint32_t>(generator() % 12U) };
+			std::vector<ResourceRequest> requests(requestCount);
+			for (ResourceRequest& request : requests) {
+				request.mSize = (1UL + generator() % 64U) * sHeapAlignment;
+				request.mAlignment = (generator() % 8U == 0U) ? 64UL * sHeapAlignment : sHeapAlignment;
+				request.mFirstUse = generator() % positionCount;
+				request.mLastUse = request.mFirstUse + generator() % (positionCount - request.mFirstUse);
+			}
+
+			std::vector<std::uint64_t> heapOffsets(requestCount);
+			const std::uint64_t heapSize{ PlanHeapOffsets(requests.data(), requestCount, heapOffsets.data()) };
+			CHECK(GetInvalidPlacementCount(requests, heapOffsets, heapSize) == 0U);
+
+			std::uint64_t peakLiveSize{ 0UL };
+			for (std::uint32_t position = 0U; position < positionCount; ++position) {
+				std::uint64_t liveSize{ 0UL };
+				for (const ResourceRequest& request : requests) {
+					if (request.mFirstUse <= position && position <= request.mLastUse) {
+						liveSize += request.mSize;
+					}
+				}
+				peakLiveSize = std::max<std::uint64_t>(peakLiveSize, liveSize);
+			}
+
+			CHECK(heapSize >= peakLiveSize);
+			CHECK(heapSize <= GetNonAliasedHeapSize(requests.data(), requestCount) + 64UL * sHeapAlignment * requestCount);
+		}
+	}
+}
+
+int main() {
+	RUN_TEST(TestLifetimes);
+	RUN_TEST(TestDisjointLifetimesShareMemory);
+	RUN_TEST(TestOverlappingLifetimesDoNotShareMemory);
+	RUN_TEST(TestAlignment);
+	RUN_TEST(TestRenderManagerResources);
+	RUN_TEST(TestRandomRequests);
+
+	return static_cast<int>(TestUtils::GetFailureCount());
+}
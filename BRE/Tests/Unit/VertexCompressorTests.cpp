@@ -0,0 +1,138 @@
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <MeshTestUtils.h>
+#include <ModelManager/VertexCompressor.h>
+#include <TestUtils.h>
+
+namespace {
+	float Dot(const DirectX::XMFLOAT3& vector1, const DirectX::XMFLOAT3& vector2) {
+		return vector1.x * vector2.x + vector1.y * vector2.y + vector1.z * vector2.z;
+	}
+
+	// Every finite half float is converted back to the same bits
+	void TestHalfRoundTrip() {
+		for (std::uint32_t i = 0U; i <= 0xFFFFU; ++i) {
+			const std::uint16_t half{ static_cast<std::uint16_t>(i) };
+			const bool isNan{ (half & 0x7C00U) == 0x7C00U && (half & 0x3FFU) != 0U };
+			if (isNan) {
+				CHECK(std::isnan(VertexCompressor::HalfToFloat(half)));
+				continue;
+			}
+
+			CHECK(VertexCompressor::FloatToHalf(VertexCompressor::HalfToFloat(half)) == half);
+		}
+	}
+
+	void TestFloatToHalfRounding() {
+		CHECK(VertexCompressor::FloatToHalf(0.0f) == 0x0000U);
+		CHECK(VertexCompressor::FloatToHalf(-0.0f) == 0x8000U);
+		CHECK(VertexCompressor::FloatToHalf(1.0f) == 0x3C00U);
+		CHECK(VertexCompressor::FloatToHalf(-2.0f) == 0xC000U);
+		CHECK(VertexCompressor::FloatToHalf(65504.0f) == 0x7BFFU);
+
+		// Out of range values are infinity
+		CHECK(VertexCompressor::FloatToHalf(65536.0f) == 0x7C00U);
+		CHECK(VertexCompressor::FloatToHalf(-1.0e10f) == 0xFC00U);
+		CHECK(VertexCompressor::FloatToHalf(INFINITY) == 0x7C00U);
+
+		// Halfway between 1.0f and the next half float (1 + 2^-10) rounds to even (1.0f),
+		// and halfway between 1 + 2^-10 and 1 + 2^-9 rounds to 1 + 2^-9
+		CHECK(VertexCompressor::FloatToHalf(1.0f + std::ldexp(1.0f, -11)) == 0x3C00U);
+		CHECK(VertexCompressor::FloatToHalf(1.0f + 3.0f * std::ldexp(1.0f, -11)) == 0x3C02U);
+
+		// Smallest subnormal, and half of it rounds to zero (even)
+		CHECK(VertexCompressor::FloatToHalf(std::ldexp(1.0f, -24)) == 0x0001U);
+		CHECK(VertexCompressor::FloatToHalf(std::ldexp(1.0f, -25)) == 0x0000U);
+	}
+
+	// Octahedral encoding with 16 bits per component has an error below 0.01 degrees
+	void TestOctahedralError() {
+		std::mt19937 generator(3U);
+		std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+		for (std::uint32_t i = 0U; i < 100000U; ++i) {
+			const DirectX::XMFLOAT3 vector{ distribution(generator), distribution(generator), distribution(generator) };
+			if (Dot(vector, vector) < 1.0e-6f) {
+				continue;
+			}
+
+			std::int16_t encodedVector[2U];
+			VertexCompressor::EncodeOctahedral(vector, encodedVector);
+			const DirectX::XMFLOAT3 decodedVector{ VertexCompressor::DecodeOctahedral(encodedVector) };
+			CHECK(std::fabs(Dot(decodedVector, decodedVector) - 1.0f) < 1.0e-5f);
+			CHECK(MeshTestUtils::GetAngle(decodedVector, vector) < 0.01);
+		}
+
+		// Axes are exact
+		const DirectX::XMFLOAT3 axes[]{ 
+			{ 1.0f, 0.0f, 0.0f }, { -1.0f, 0.0f, 0.0f }, 
+			{ 0.0f, 1.0f, 0.0f }, { 0.0f, -1.0f, 0.0f }, 
+			{ 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, -1.0f } };
+		for (const DirectX::XMFLOAT3& axis : axes) {
+			std::int16_t encodedVector[2U];
+			VertexCompressor::EncodeOctahedral(axis, encodedVector);
+			CHECK(Dot(VertexCompressor::DecodeOctahedral(encodedVector), axis) == 1.0f);
+		}
+
+		// Zero vector
+		std::int16_t encodedVector[2U];
+		VertexCompressor::EncodeOctahedral(DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f), encodedVector);
+		const DirectX::XMFLOAT3 decodedVector{ VertexCompressor::DecodeOctahedral(encodedVector) };
+		CHECK(decodedVector.x == 0.0f && decodedVector.y == 0.0f && decodedVector.z == 1.0f);
+	}
+
+	// Positions of the models are within (largest bounding box dimension / 65535 / 2) after encoding
+	void TestEncodeModels() {
+		const std::vector<std::string> modelFilePaths{ MeshTestUtils::GetModelFilePaths() };
+		CHECK(modelFilePaths.empty() == false);
+		for (const std::string& modelFilePath : modelFilePaths) {
+			GeometryGenerator::MeshData meshData;
+			CHECK(MeshTestUtils::ReadObjFile(modelFilePath, meshData));
+			const std::size_t vertexCount{ meshData.mVertices.size() };
+			for (GeometryGenerator::Vertex& vertex : meshData.mVertices) {
+				vertex.mTangent = DirectX::XMFLOAT3(vertex.mNormal.y, vertex.mNormal.z, vertex.mNormal.x);
+			}
+
+			const VertexCompressor::PositionQuantization positionQuantization{
+				VertexCompressor::ComputePositionQuantization(meshData.mVertices.data(), vertexCount) };
+			std::vector<VertexCompressor::PackedVertex> packedVertices(vertexCount);
+			VertexCompressor::EncodeVertices(meshData.mVertices.data(), vertexCount, positionQuantization, packedVertices.data());
+
+			// Rounding of the float operations (a few ulps of the largest coordinate) is added to the quantization error
+			const float maxCoordinate{
+				std::max<float>(
+					std::max<float>(std::fabs(positionQuantization.mOffset.x), std::fabs(positionQuantization.mOffset.y)),
+					std::fabs(positionQuantization.mOffset.z)) + positionQuantization.mScale };
+			const float maxPositionError{ positionQuantization.mScale / 65535.0f * 0.5f + maxCoordinate * 4.0f * FLT_EPSILON };
+			for (std::size_t i = 0UL; i < vertexCount; ++i) {
+				const GeometryGenerator::Vertex& vertex{ meshData.mVertices[i] };
+				GeometryGenerator::Vertex decodedVertex;
+				VertexCompressor::DecodeVertex(packedVertices[i], positionQuantization, decodedVertex);
+
+				CHECK(packedVertices[i].mPosition[3U] == 0xFFFFU);
+				CHECK(std::fabs(decodedVertex.mPosition.x - vertex.mPosition.x) <= maxPositionError);
+				CHECK(std::fabs(decodedVertex.mPosition.y - vertex.mPosition.y) <= maxPositionError);
+				CHECK(std::fabs(decodedVertex.mPosition.z - vertex.mPosition.z) <= maxPositionError);
+				if (Dot(vertex.mNormal, vertex.mNormal) > 0.0f) {
+					CHECK(MeshTestUtils::GetAngle(decodedVertex.mNormal, vertex.mNormal) < 0.01);
+					CHECK(MeshTestUtils::GetAngle(decodedVertex.mTangent, vertex.mTangent) < 0.01);
+				}
+				CHECK(decodedVertex.mUV.x == VertexCompressor::HalfToFloat(VertexCompressor::FloatToHalf(vertex.mUV.x)));
+				CHECK(decodedVertex.mUV.y == VertexCompressor::HalfToFloat(VertexCompressor::FloatToHalf(vertex.mUV.y)));
+			}
+		}
+	}
+}
+
+int main() {
+	RUN_TEST(TestHalfRoundTrip);
+	RUN_TEST(TestFloatToHalfRounding);
+	RUN_TEST(TestOctahedralError);
+	RUN_TEST(TestEncodeModels);
+
+	return static_cast<int>(TestUtils::GetFailureCount());
+}
@@ -0,0 +1,276 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <ResourceManager/BlockCompressor.h>
+#include <ResourceManager/DDSTextureParser.h>
+#include <ResourceManager/DDSTextureWriter.h>
+#include <ResourceManager/MipGenerator.h>
+#include <Utils/MemoryMappedFile.h>
+
+// Offline tool to compress uncompressed DDS textures (8 bits per channel) to block compressed DDS textures
+// with a full mip chain (filtered with a Kaiser filter, see MipGenerator), that ResourceManager loads
+// with 4 to 8 times less memory than the source textures.
+// If the format is not specified, then it is selected with the file name: BC5 for normal maps (*_normal.dds),
+// BC4 for height maps (*_height.dds), and BC1 (or BC3 if it is not opaque) for other textures.
+// Usage: TextureCooker <input .dds file> <output .dds file> [bc1|bc3|bc4|bc5|bc7]
+namespace {
+	struct FormatName {
+		const char* mName;
+		BlockCompressor::Format mFormat;
+	};
+
+	const FormatName sFormatNames[]{
+		{ "bc1", BlockCompressor::Format::BC1 },
+		{ "bc3", BlockCompressor::Format::BC3 },
+		{ "bc4", BlockCompressor::Format::BC4 },
+		{ "bc5", BlockCompressor::Format::BC5 },
+		{ "bc7", BlockCompressor::Format::BC7 },
+	};
+
+	const char* GetFormatName(const BlockCompressor::Format format) noexcept {
+		for (const FormatName& formatName : sFormatNames) {
+			if (formatName.mFormat == format) {
+				return formatName.mName;
+			}
+		}
+
+		return "";
+	}
+
+	// Converts the texels of a subresource to RGBA8. It returns false if the format is not supported.
+	bool ConvertToRGBA8(
+		const std::uint8_t* data,
+		const DDSTextureParser::SubresourceLayout& layout,
+		const std::uint32_t width,
+		const std::uint32_t height,
+		const DXGI_FORMAT format,
+		std::vector<std::uint8_t>& texels) noexcept
+	{
+		texels.resize(static_cast<std::size_t>(width) * height * 4UL);
+		for (std::uint32_t y = 0U; y < height; ++y) {
+			const std::uint8_t* row{ data + layout.mOffset + y * layout.mRowPitch };
+			std::uint8_t* texelRow{ texels.data() + static_cast<std::size_t>(y) * width * 4UL };
+			for (std::uint32_t x = 0U; x < width; ++x) {
+				std::uint8_t* texel{ texelRow + x * 4U };
+				switch (format) {
+				case DXGI_FORMAT_R8G8B8A8_UNORM:
+				case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+					std::memcpy(texel, row + x * 4U, 4UL);
+					break;
+				case DXGI_FORMAT_B8G8R8A8_UNORM:
+				case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+				case DXGI_FORMAT_B8G8R8X8_UNORM:
+				case DXGI_FORMAT_B8G8R8X8_UNORM_SRGB:
+					texel[0U] = row[x * 4U + 2U];
+					texel[1U] = row[x * 4U + 1U];
+					texel[2U] = row[x * 4U];
+					texel[3U] = (format == DXGI_FORMAT_B8G8R8X8_UNORM || format == DXGI_FORMAT_B8G8R8X8_UNORM_SRGB) ? 255U : row[x * 4U + 3U];
+					break;
+				case DXGI_FORMAT_R8_UNORM:
+					texel[0U] = row[x];
+					texel[1U] = row[x];
+					texel[2U] = row[x];
+					texel[3U] = 255U;
+					break;
+				default:
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	bool IsSRGB(const DXGI_FORMAT format) noexcept {
+		return
+			format == DXGI_FORMAT_R8G8B8A8_UNORM_SRGB ||
+			format == DXGI_FORMAT_B8G8R8A8_UNORM_SRGB ||
+			format == DXGI_FORMAT_B8G8R8X8_UNORM_SRGB;
+	}
+
+	BlockCompressor::Format SelectFormat(const char* filePath, const std::vector<std::uint8_t>& texels) noexcept {
+		const std::string path(filePath);
+		if (path.find("_normal") != std::string::npos) {
+			return BlockCompressor::Format::BC5;
+		}
+
+		if (path.find("_height") != std::string::npos) {
+			return BlockCompressor::Format::BC4;
+		}
+
+		for (std::size_t i = 3UL; i < texels.size(); i += 4UL) {
+			if (texels[i] != 255U) {
+				return BlockCompressor::Format::BC3;
+			}
+		}
+
+		return BlockCompressor::Format::BC1;
+	}
+}
+
+int main(int argc, char* argv[]) {
+	if (argc != 3 && argc != 4) {
+		std::fprintf(stderr, "Usage: TextureCooker <input .dds file> <output .dds file> [bc1|bc3|bc4|bc5|bc7]\n");
+		return 1;
+	}
+
+	const char* inputFilePath{ argv[1] };
+	const char* outputFilePath{ argv[2] };
+
+	MemoryMappedFile file;
+	if (file.Open(inputFilePath) == false) {
+		std::fprintf(stderr, "%s cannot be opened\n", inputFilePath);
+		return 1;
+	}
+
+	DDSTextureParser::TextureInfo inputInfo;
+	if (DDSTextureParser::ParseHeader(file.GetData(), file.GetSize(), inputInfo) != DDSTextureParser::Result::SUCCESS ||
+		inputInfo.mDimension != DDSTextureParser::Dimension::TEXTURE2D)
+	{
+		std::fprintf(stderr, "%s is not a supported 2D DDS texture\n", inputFilePath);
+		return 1;
+	}
+
+	// Block compressed textures must have whole blocks in their first mip
+	if (inputInfo.mWidth % BlockCompressor::sBlockDimension != 0U || inputInfo.mHeight % BlockCompressor::sBlockDimension != 0U) {
+		std::fprintf(stderr, "%s dimensions (%u x %u) are not multiples of 4\n", inputFilePath, inputInfo.mWidth, inputInfo.mHeight);
+		return 1;
+	}
+
+	std::vector<DDSTextureParser::SubresourceLayout> inputLayouts(inputInfo.mMipCount * inputInfo.mArraySize);
+	std::uint32_t skippedMipCount{ 0U };
+	std::uint32_t width{ 0U };
+	std::uint32_t height{ 0U };
+	std::uint32_t depth{ 0U };
+	if (DDSTextureParser::ComputeSubresourceLayouts(
+		inputInfo, 0UL, file.GetSize(), inputLayouts.data(), skippedMipCount, width, height, depth) != DDSTextureParser::Result::SUCCESS)
+	{
+		std::fprintf(stderr, "%s data is not valid\n", inputFilePath);
+		return 1;
+	}
+
+	// First mips of the array slices. Source mips are not used, as mips are generated again.
+	std::vector<std::vector<std::uint8_t>> slices(inputInfo.mArraySize);
+	for (std::uint32_t i = 0U; i < inputInfo.mArraySize; ++i) {
+		if (ConvertToRGBA8(
+			file.GetData(),
+			inputLayouts[i * inputInfo.mMipCount],
+			inputInfo.mWidth,
+			inputInfo.mHeight,
+			inputInfo.mFormat,
+			slices[i]) == false)
+		{
+			std::fprintf(stderr, "%s format (%u) is not supported: it must have 8 bits per channel\n", inputFilePath, inputInfo.mFormat);
+			return 1;
+		}
+	}
+
+	BlockCompressor::Format format{ SelectFormat(inputFilePath, slices[0U]) };
+	if (argc == 4) {
+		bool isValidFormat{ false };
+		for (const FormatName& formatName : sFormatNames) {
+			if (std::strcmp(argv[3], formatName.mName) == 0) {
+				format = formatName.mFormat;
+				isValidFormat = true;
+			}
+		}
+
+		if (isValidFormat == false) {
+			std::fprintf(stderr, "%s is not a supported format\n", argv[3]);
+			return 1;
+		}
+	}
+
+	DDSTextureParser::TextureInfo outputInfo{ inputInfo };
+	outputInfo.mFormat = BlockCompressor::GetDXGIFormat(format, IsSRGB(inputInfo.mFormat));
+	outputInfo.mMipCount = MipGenerator::GetFullMipCount(inputInfo.mWidth, inputInfo.mHeight);
+
+	// Mips are filtered in linear space if the texture is sRGB
+	const DXGI_FORMAT texelFormat{ IsSRGB(inputInfo.mFormat) ? DXGI_FORMAT_R8G8B8A8_UNORM_SRGB : DXGI_FORMAT_R8G8B8A8_UNORM };
+	std::vector<const std::uint8_t*> firstMips(inputInfo.mArraySize);
+	for (std::uint32_t i = 0U; i < inputInfo.mArraySize; ++i) {
+		firstMips[i] = slices[i].data();
+	}
+	const std::size_t sliceMipsSize{
+		MipGenerator::GetMipsSize(inputInfo.mWidth, inputInfo.mHeight, texelFormat, outputInfo.mMipCount - 1U) };
+	std::vector<std::uint8_t> mips(sliceMipsSize * inputInfo.mArraySize);
+	MipGenerator::GenerateMips(
+		firstMips.data(),
+		inputInfo.mArraySize,
+		inputInfo.mWidth,
+		inputInfo.mHeight,
+		texelFormat,
+		MipGenerator::Filter::KAISER,
+		outputInfo.mMipCount - 1U,
+		mips.data());
+
+	std::vector<std::uint8_t> outputData;
+	outputData.reserve(DDSTextureWriter::ComputeDataSize(outputInfo));
+
+	std::vector<std::uint8_t> decompressedTexels;
+	std::vector<std::uint8_t> blocks;
+	float firstMipPSNR{ 0.0f };
+	float minPSNR{ std::numeric_limits<float>::infinity() };
+	std::size_t texelCount{ 0UL };
+	double compressionSeconds{ 0.0 };
+	for (std::uint32_t i = 0U; i < inputInfo.mArraySize; ++i) {
+		const std::uint8_t* mipTexels{ slices[i].data() };
+		const std::uint8_t* generatedMipTexels{ mips.data() + i * sliceMipsSize };
+		std::uint32_t mipWidth{ inputInfo.mWidth };
+		std::uint32_t mipHeight{ inputInfo.mHeight };
+		for (std::uint32_t mip = 0U; mip < outputInfo.mMipCount; ++mip) {
+			if (mip > 0U) {
+				mipTexels = generatedMipTexels;
+				generatedMipTexels += static_cast<std::size_t>(mipWidth) * mipHeight * 4UL;
+			}
+
+			blocks.resize(BlockCompressor::GetCompressedSize(mipWidth, mipHeight, format));
+
+			const std::chrono::high_resolution_clock::time_point startTime{ std::chrono::high_resolution_clock::now() };
+			BlockCompressor::CompressImage(mipTexels, mipWidth, mipHeight, mipWidth * 4UL, format, blocks.data());
+			compressionSeconds += std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - startTime).count();
+			texelCount += static_cast<std::size_t>(mipWidth) * mipHeight;
+
+			decompressedTexels.resize(static_cast<std::size_t>(mipWidth) * mipHeight * 4UL);
+			BlockCompressor::DecompressImage(blocks.data(), mipWidth, mipHeight, format, decompressedTexels.data());
+			const float psnr{
+				BlockCompressor::ComputePSNR(mipTexels, decompressedTexels.data(), static_cast<std::size_t>(mipWidth) * mipHeight, format) };
+			if (i == 0U && mip == 0U) {
+				firstMipPSNR = psnr;
+			}
+			minPSNR = std::min<float>(minPSNR, psnr);
+
+			outputData.insert(outputData.end(), blocks.begin(), blocks.end());
+
+			mipWidth = std::max<std::uint32_t>(mipWidth / 2U, 1U);
+			mipHeight = std::max<std::uint32_t>(mipHeight / 2U, 1U);
+		}
+	}
+
+	if (DDSTextureWriter::WriteFile(outputFilePath, outputInfo, outputData.data(), outputData.size()) == false) {
+		std::fprintf(stderr, "%s cannot be written\n", outputFilePath);
+		return 1;
+	}
+
+	std::printf(
+		"%s -> %s: %s, %u x %u, %u array slices, %u mips, %zu -> %zu bytes, PSNR %.2f dB (minimum of all mips %.2f dB), %.1f Mtexels/s\n",
+		inputFilePath,
+		outputFilePath,
+		GetFormatName(format),
+		outputInfo.mWidth,
+		outputInfo.mHeight,
+		outputInfo.mArraySize,
+		outputInfo.mMipCount,
+		file.GetSize(),
+		outputData.size(),
+		firstMipPSNR,
+		minPSNR,
+		static_cast<double>(texelCount) / compressionSeconds / 1e6);
+
+	return 0;
+}
@@ -28,18 +28,19 @@ void ToneMappingPass::Init(
 	ASSERT(IsDataValid());
 }
 
-void ToneMappingPass::Execute() noexcept {
+std::uint32_t ToneMappingPass::Execute() const noexcept {
 	ASSERT(IsDataValid());
 
-	ExecuteBeginTask();
+	// Check resource states:
+	// - Input color buffer must be in pixel shader resource state
+	// - Output color buffer must be in render target state
+	// RenderManager frame graph transitioned them before this pass.
+	ASSERT(ResourceStateManager::GetResourceState(*mInputColorBuffer) == D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+	ASSERT(ResourceStateManager::GetResourceState(*mOutputColorBuffer) == D3D12_RESOURCE_STATE_RENDER_TARGET);
 
-	CommandListExecutor::Get().ResetExecutedCommandListCount();
 	mCommandListRecorder->RecordAndPushCommandLists();
 
-	// Wait until all previous tasks command lists are executed
-	while (CommandListExecutor::Get().GetExecutedCommandListCount() < 1) {
-		Sleep(0U);
-	}
+	return 1U;
 }
 
 bool ToneMappingPass::IsDataValid() const noexcept {
@@ -49,26 +50,4 @@ bool ToneMappingPass::IsDataValid() const noexcept {
 		mOutputColorBuffer != nullptr;
 
 	return b;
-}
-
-void ToneMappingPass::ExecuteBeginTask() noexcept {
-	ASSERT(IsDataValid());
-
-	// Check resource states:
-	// - Input color buffer was used as render target in previous pass
-	// - Output color buffer was used as pixel shader resource in previous pass
-	ASSERT(ResourceStateManager::GetResourceState(*mInputColorBuffer) == D3D12_RESOURCE_STATE_RENDER_TARGET);
-	ASSERT(ResourceStateManager::GetResourceState(*mOutputColorBuffer) == D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
-
-	ID3D12GraphicsCommandList& commandList = mCommandListPerFrame.ResetWithNextCommandAllocator(nullptr);
-
-	CD3DX12_RESOURCE_BARRIER barriers[]
-	{
-		ResourceStateManager::ChangeResourceStateAndGetBarrier(*mInputColorBuffer, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE),
-		ResourceStateManager::ChangeResourceStateAndGetBarrier(*mOutputColorBuffer, D3D12_RESOURCE_STATE_RENDER_TARGET),
-	};
-	commandList.ResourceBarrier(_countof(barriers), barriers);
-
-	CHECK_HR(commandList.Close());
-	CommandListExecutor::Get().ExecuteCommandListAndWaitForCompletion(commandList);
 }
\ No newline at end of file
@@ -2,7 +2,6 @@
 
 #include <memory>
 
-#include <CommandManager\CommandListPerFrame.h>
 #include <ToneMappingPass\ToneMappingCmdListRecorder.h>
 
 struct D3D12_CPU_DESCRIPTOR_HANDLE;
@@ -22,17 +21,15 @@ public:
 		ID3D12Resource& outputColorBuffer,
 		const D3D12_CPU_DESCRIPTOR_HANDLE& renderTargetView) noexcept;
 
+	// Returns the number of command lists pushed to CommandListExecutor.
+	// It does not wait for them to be executed.
 	// Preconditions:
 	// - Init() must be called before
-	void Execute() noexcept;
+	std::uint32_t Execute() const noexcept;
 
 private:
 	bool IsDataValid() const noexcept;
 
-	void ExecuteBeginTask() noexcept;
-
-	CommandListPerFrame mCommandListPerFrame;
-	
 	ID3D12Resource* mInputColorBuffer{ nullptr };
 	ID3D12Resource* mOutputColorBuffer{ nullptr };
 
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+
+// Thread safe FIFO queue whose consumers sleep (instead of polling)
+// until there are elements to pop or the queue is closed.
+template<typename T>
+class BlockingQueue {
+public:
+	BlockingQueue() = default;
+	~BlockingQueue() = default;
+	BlockingQueue(const BlockingQueue&) = delete;
+	const BlockingQueue& operator=(const BlockingQueue&) = delete;
+	BlockingQueue(BlockingQueue&&) = delete;
+	BlockingQueue& operator=(BlockingQueue&&) = delete;
+
+	void Push(const T& element) noexcept {
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mElements.push_back(element);
+		}
+		mConditionVariable.notify_one();
+	}
+
+	// Returns false if the queue is empty
+	bool TryPop(T& element) noexcept {
+		std::lock_guard<std::mutex> lock(mMutex);
+		if (mElements.empty()) {
+			return false;
+		}
+
+		element = mElements.front();
+		mElements.pop_front();
+		return true;
+	}
+
+	// Blocks until there is at least one element or the queue is closed,
+	// and then pops at most "maxElementCount" elements into "elements".
+	// Returns the number of popped elements. It is zero only if
+	// the queue was closed and it is empty.
+	// Preconditions:
+	// - "elements" must not be nullptr
+	// - "maxElementCount" must be greater than zero
+	std::uint32_t WaitAndPop(T* elements, const std::uint32_t maxElementCount) noexcept {
+		std::unique_lock<std::mutex> lock(mMutex);
+		mConditionVariable.wait(lock, [this]() { return mElements.empty() == false || mIsClosed; });
+
+		std::uint32_t poppedElementCount{ 0U };
+		while (poppedElementCount < maxElementCount && mElements.empty() == false) {
+			elements[poppedElementCount++] = mElements.front();
+			mElements.pop_front();
+		}
+
+		return poppedElementCount;
+	}
+
+	// Wakes up all the waiting consumers. Elements already in the queue
+	// can still be popped, but WaitAndPop() does not block anymore.
+	void Close() noexcept {
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mIsClosed = true;
+		}
+		mConditionVariable.notify_all();
+	}
+
+	bool IsEmpty() const noexcept {
+		std::lock_guard<std::mutex> lock(mMutex);
+		return mElements.empty();
+	}
+
+private:
+	mutable std::mutex mMutex;
+	std::condition_variable mConditionVariable;
+	std::deque<T> mElements;
+	bool mIsClosed{ false };
+};
@@ -0,0 +1,24 @@
+#include "CompletionLatch.h"
+
+void CompletionLatch::Reset() noexcept {
+	std::lock_guard<std::mutex> lock(mMutex);
+	mCount = 0U;
+}
+
+void CompletionLatch::Increment(const std::uint32_t count) noexcept {
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mCount += count;
+	}
+	mConditionVariable.notify_all();
+}
+
+std::uint32_t CompletionLatch::GetCount() const noexcept {
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mCount;
+}
+
+void CompletionLatch::Wait(const std::uint32_t count) const noexcept {
+	std::unique_lock<std::mutex> lock(mMutex);
+	mConditionVariable.wait(lock, [this, count]() { return mCount >= count; });
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+// Counter of completed work that threads can block on.
+// Producers call Increment() when they complete work, and consumers
+// call Wait() to sleep until a given amount of work was completed,
+// instead of polling the counter.
+class CompletionLatch {
+public:
+	CompletionLatch() = default;
+	~CompletionLatch() = default;
+	CompletionLatch(const CompletionLatch&) = delete;
+	const CompletionLatch& operator=(const CompletionLatch&) = delete;
+	CompletionLatch(CompletionLatch&&) = delete;
+	CompletionLatch& operator=(CompletionLatch&&) = delete;
+
+	void Reset() noexcept;
+
+	// Adds "count" to the counter and wakes up waiting threads
+	void Increment(const std::uint32_t count) noexcept;
+
+	std::uint32_t GetCount() const noexcept;
+
+	// Blocks until the counter is greater or equal than "count"
+	void Wait(const std::uint32_t count) const noexcept;
+
+private:
+	mutable std::mutex mMutex;
+	mutable std::condition_variable mConditionVariable;
+	std::uint32_t mCount{ 0U };
+};
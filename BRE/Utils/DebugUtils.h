@@ -1,10 +1,13 @@
 #pragma once
 
 #include <cassert>
-#include <comdef.h>
 #include <string>
 
+#ifdef _WIN32
+#include <comdef.h>
+
 #include <Utils\StringUtils.h>
+#endif
 
 #if defined(DEBUG) || defined(_DEBUG)
 #define ASSERT(condition) \
@@ -13,7 +16,9 @@
 #define ASSERT(condition) (condition)
 #endif
 
-#ifndef CHECK_HR
+// CHECK_HR is only needed by the modules that use Windows and DirectX APIs. ASSERT is also
+// available on other platforms, so portable modules can be built with the tests (see Tests folder)
+#if defined(_WIN32) && !defined(CHECK_HR)
 #define CHECK_HR(x) \
 { \
     const HRESULT __hr__ = (x);                                               \
@@ -1,7 +1,45 @@
 #include "HashUtils.h"
 
+#include <cstring>
+
 #include "DebugUtils.h"
 
+namespace {
+	const std::uint64_t sPrime1{ 0x9E3779B185EBCA87UL };
+	const std::uint64_t sPrime2{ 0xC2B2AE3D27D4EB4FUL };
+	const std::uint64_t sPrime3{ 0x165667B19E3779F9UL };
+	const std::uint64_t sPrime4{ 0x85EBCA77C2B2AE63UL };
+	const std::uint64_t sPrime5{ 0x27D4EB2F165667C5UL };
+
+	std::uint64_t RotateLeft(const std::uint64_t value, const std::uint32_t bitCount) noexcept {
+		return (value << bitCount) | (value >> (64U - bitCount));
+	}
+
+	// Data is read as little endian (like all our target platforms)
+	std::uint64_t Read64(const std::uint8_t* data) noexcept {
+		std::uint64_t value;
+		std::memcpy(&value, data, sizeof(std::uint64_t));
+		return value;
+	}
+
+	std::uint32_t Read32(const std::uint8_t* data) noexcept {
+		std::uint32_t value;
+		std::memcpy(&value, data, sizeof(std::uint32_t));
+		return value;
+	}
+
+	std::uint64_t Round(std::uint64_t accumulator, const std::uint64_t input) noexcept {
+		accumulator += input * sPrime2;
+		accumulator = RotateLeft(accumulator, 31U);
+		return accumulator * sPrime1;
+	}
+
+	std::uint64_t MergeRound(std::uint64_t accumulator, const std::uint64_t value) noexcept {
+		accumulator ^= Round(0UL, value);
+		return accumulator * sPrime1 + sPrime4;
+	}
+}
+
 namespace HashUtils {
 	std::size_t HashCString(const char* str) noexcept {
 		ASSERT(str != nullptr);
@@ -13,4 +51,61 @@ namespace HashUtils {
 
 		return hashValue;
 	}
+
+	std::uint64_t HashData(const void* data, const std::size_t dataSize, const std::uint64_t seed) noexcept {
+		ASSERT(data != nullptr || dataSize == 0UL);
+
+		const std::uint8_t* bytes{ static_cast<const std::uint8_t*>(data) };
+		const std::uint8_t* const end{ bytes + dataSize };
+		std::uint64_t hash;
+
+		// 4 independent accumulators for each 32 bytes stripe
+		if (dataSize >= 32UL) {
+			std::uint64_t accumulators[4U]{ seed + sPrime1 + sPrime2, seed + sPrime2, seed, seed - sPrime1 };
+			const std::uint8_t* const lastStripe{ end - 32UL };
+			do {
+				for (std::uint32_t i = 0U; i < 4U; ++i) {
+					accumulators[i] = Round(accumulators[i], Read64(bytes + i * 8U));
+				}
+				bytes += 32UL;
+			} while (bytes <= lastStripe);
+
+			hash = 
+				RotateLeft(accumulators[0U], 1U) + 
+				RotateLeft(accumulators[1U], 7U) + 
+				RotateLeft(accumulators[2U], 12U) + 
+				RotateLeft(accumulators[3U], 18U);
+			for (std::uint32_t i = 0U; i < 4U; ++i) {
+				hash = MergeRound(hash, accumulators[i]);
+			}
+		} else {
+			hash = seed + sPrime5;
+		}
+
+		hash += static_cast<std::uint64_t>(dataSize);
+
+		// Remaining bytes
+		for (; bytes + 8UL <= end; bytes += 8UL) {
+			hash ^= Round(0UL, Read64(bytes));
+			hash = RotateLeft(hash, 27U) * sPrime1 + sPrime4;
+		}
+		if (bytes + 4UL <= end) {
+			hash ^= static_cast<std::uint64_t>(Read32(bytes)) * sPrime1;
+			hash = RotateLeft(hash, 23U) * sPrime2 + sPrime3;
+			bytes += 4UL;
+		}
+		for (; bytes < end; ++bytes) {
+			hash ^= static_cast<std::uint64_t>(*bytes) * sPrime5;
+			hash = RotateLeft(hash, 11U) * sPrime1;
+		}
+
+		// Final mix, so all the input bits affect all the output bits
+		hash ^= hash >> 33U;
+		hash *= sPrime2;
+		hash ^= hash >> 29U;
+		hash *= sPrime3;
+		hash ^= hash >> 32U;
+
+		return hash;
+	}
 }
@@ -1,7 +1,15 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 
 namespace HashUtils {
 	std::size_t HashCString(const char* str) noexcept;
+
+	// Fast 64 bits hash of "dataSize" bytes (xxHash64), to identify data by its content.
+	// A different "seed" gives a different hash for the same data, so it can be used
+	// to combine hashes or to hash the same data for different purposes.
+	// Preconditions:
+	// - "data" must not be nullptr if "dataSize" is greater than zero
+	std::uint64_t HashData(const void* data, const std::size_t dataSize, const std::uint64_t seed = 0UL) noexcept;
 }
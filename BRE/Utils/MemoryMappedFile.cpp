@@ -0,0 +1,114 @@
+#include "MemoryMappedFile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <Utils/DebugUtils.h>
+
+MemoryMappedFile::~MemoryMappedFile() {
+	Close();
+}
+
+#ifdef _WIN32
+bool MemoryMappedFile::Open(const char* filePath) noexcept {
+	ASSERT(filePath != nullptr);
+	ASSERT(IsOpen() == false);
+
+	const HANDLE fileHandle = CreateFileA(
+		filePath,
+		GENERIC_READ,
+		FILE_SHARE_READ,
+		nullptr,
+		OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+		nullptr);
+	if (fileHandle == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+	mFileHandle = fileHandle;
+
+	LARGE_INTEGER fileSize;
+	if (GetFileSizeEx(fileHandle, &fileSize) == FALSE || fileSize.QuadPart == 0LL) {
+		Close();
+		return false;
+	}
+
+	mFileMappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0U, 0U, nullptr);
+	if (mFileMappingHandle == nullptr) {
+		Close();
+		return false;
+	}
+
+	mData = static_cast<const std::uint8_t*>(MapViewOfFile(mFileMappingHandle, FILE_MAP_READ, 0U, 0U, 0U));
+	if (mData == nullptr) {
+		Close();
+		return false;
+	}
+	mSize = static_cast<std::size_t>(fileSize.QuadPart);
+
+	return true;
+}
+
+void MemoryMappedFile::Close() noexcept {
+	if (mData != nullptr) {
+		UnmapViewOfFile(mData);
+		mData = nullptr;
+	}
+
+	if (mFileMappingHandle != nullptr) {
+		CloseHandle(mFileMappingHandle);
+		mFileMappingHandle = nullptr;
+	}
+
+	if (mFileHandle != nullptr) {
+		CloseHandle(mFileHandle);
+		mFileHandle = nullptr;
+	}
+
+	mSize = 0UL;
+}
+#else
+bool MemoryMappedFile::Open(const char* filePath) noexcept {
+	ASSERT(filePath != nullptr);
+	ASSERT(IsOpen() == false);
+
+	const int fileDescriptor{ open(filePath, O_RDONLY) };
+	if (fileDescriptor < 0) {
+		return false;
+	}
+
+	struct stat fileStatus;
+	if (fstat(fileDescriptor, &fileStatus) != 0 || fileStatus.st_size == 0) {
+		close(fileDescriptor);
+		return false;
+	}
+
+	// The mapping keeps its own reference to the file
+	const std::size_t fileSize{ static_cast<std::size_t>(fileStatus.st_size) };
+	void* data{ mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0) };
+	close(fileDescriptor);
+	if (data == MAP_FAILED) {
+		return false;
+	}
+
+	mData = static_cast<const std::uint8_t*>(data);
+	mSize = fileSize;
+
+	return true;
+}
+
+void MemoryMappedFile::Close() noexcept {
+	if (mData != nullptr) {
+		munmap(const_cast<std::uint8_t*>(mData), mSize);
+		mData = nullptr;
+	}
+
+	mSize = 0UL;
+}
+#endif
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Read only view of a whole file, mapped in memory.
+// Data is paged in by the operating system when it is accessed, so
+// it can be parsed or copied to upload buffers without an intermediate copy.
+// Steps:
+// - Call Open()
+// - Use GetData() and GetSize()
+// - Call Close() or destroy the instance
+class MemoryMappedFile {
+public:
+	MemoryMappedFile() = default;
+	~MemoryMappedFile();
+	MemoryMappedFile(const MemoryMappedFile&) = delete;
+	const MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+	MemoryMappedFile(MemoryMappedFile&&) = delete;
+	MemoryMappedFile& operator=(MemoryMappedFile&&) = delete;
+
+	// Returns false if the file cannot be opened or mapped (empty files cannot be mapped)
+	// Preconditions:
+	// - "filePath" must not be nullptr
+	// - File must not be already open
+	bool Open(const char* filePath) noexcept;
+
+	void Close() noexcept;
+
+	__forceinline bool IsOpen() const noexcept { return mData != nullptr; }
+	__forceinline const std::uint8_t* GetData() const noexcept { return mData; }
+	__forceinline std::size_t GetSize() const noexcept { return mSize; }
+
+private:
+	const std::uint8_t* mData{ nullptr };
+	std::size_t mSize{ 0UL };
+
+#ifdef _WIN32
+	void* mFileHandle{ nullptr };
+	void* mFileMappingHandle{ nullptr };
+#endif
+};
@@ -0,0 +1,28 @@
+#include "ParallelFileLoader.h"
+
+#include <Utils/DebugUtils.h>
+#include <Utils/MemoryMappedFile.h>
+
+ParallelFileLoader::~ParallelFileLoader() {
+	Wait();
+}
+
+void ParallelFileLoader::Load(const std::vector<std::string>& filePaths, const ProcessFunction& processFunction) noexcept {
+	const std::size_t fileCount{ filePaths.size() };
+	for (std::size_t i = 0UL; i < fileCount; ++i) {
+		const std::string filePath{ filePaths[i] };
+		mTaskGroup.run([this, i, filePath, processFunction]() {
+			MemoryMappedFile file;
+			const bool result{ file.Open(filePath.c_str()) };
+			ASSERT(result);
+			if (result) {
+				mReadByteCount += file.GetSize();
+				processFunction(i, file.GetData(), file.GetSize());
+			}
+		});
+	}
+}
+
+void ParallelFileLoader::Wait() noexcept {
+	mTaskGroup.wait();
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <tbb/task_group.h>
+#include <vector>
+
+// To read and process files concurrently in TBB tasks.
+// Each file is mapped in memory and processed (parsed, uploaded, etc) by the same task, 
+// so files are loaded in parallel and the caller can do other work meanwhile.
+// Steps:
+// - Call Load() once or several times
+// - Do other work
+// - Call Wait() before using the processed data
+class ParallelFileLoader {
+public:
+	// Called by a TBB worker thread for each file that was read.
+	// "fileData" is only valid during the call (file is unmapped after it).
+	using ProcessFunction = std::function<void(
+		const std::size_t fileIndex, 
+		const std::uint8_t* fileData, 
+		const std::size_t fileDataSize)>;
+
+	ParallelFileLoader() = default;
+	~ParallelFileLoader();
+	ParallelFileLoader(const ParallelFileLoader&) = delete;
+	const ParallelFileLoader& operator=(const ParallelFileLoader&) = delete;
+	ParallelFileLoader(ParallelFileLoader&&) = delete;
+	ParallelFileLoader& operator=(ParallelFileLoader&&) = delete;
+
+	// Spawns a task per file and returns immediately.
+	// "fileIndex" is the index of the file in "filePaths".
+	// Preconditions:
+	// - "processFunction" must be thread safe
+	// - Files must exist
+	void Load(const std::vector<std::string>& filePaths, const ProcessFunction& processFunction) noexcept;
+
+	// Waits until all the files are read and processed
+	void Wait() noexcept;
+
+	// Returns the number of bytes read since the loader was created
+	__forceinline std::uint64_t GetReadByteCount() const noexcept { return mReadByteCount; }
+
+private:
+	tbb::task_group mTaskGroup;
+	std::atomic<std::uint64_t> mReadByteCount{ 0UL };
+};